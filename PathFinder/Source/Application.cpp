@@ -2,6 +2,8 @@
 
 #include "../resource.h"
 
+#include <Foundation/StringUtils.hpp>
+
 #include <choreograph/Choreograph.h>
 #include <windows.h>
 #include <tchar.h>
@@ -38,9 +40,9 @@ namespace PathFinder
         mUIEntryPoint->CreateMandatoryViewControllers();
 
         // Temporary to load demo Scene until proper UI is implemented
-        mMeshLoader = std::make_unique<MeshLoader>(mCmdLineParser->ExecutableFolderPath() / "MediaResources/Models/");
+        mMeshLoader = std::make_unique<MeshLoader>(mCmdLineParser->ExecutableFolderPath() / "MediaResources/Models/", mRenderEngine->Jobs());
         mMaterialLoader = std::make_unique<MaterialLoader>(mCmdLineParser->ExecutableFolderPath(), mRenderEngine->AssetStorage(), mRenderEngine->ResourceProducer());
-        LoadDemoScene();
+        LoadScene();
     }
 
     void Application::RunMessageLoop()
@@ -148,8 +150,14 @@ namespace PathFinder
         mSettingsController->SetEnabled(!interactingWithUI);
         mSettingsController->ApplyVolatileSettings();
 
-        mScene->GPUStorage().UploadInstances();
-        mScene->RemapEntityIDs();
+        // LODs are picked before instance table is written, since table entries reference their index ranges
+        mLODSelector.SelectLODs(*mScene, mRenderEngine->RenderSurface().RenderDimensions().Height, mRenderEngine->Jobs());
+        mScene->GPUStorage().UploadInstances(mRenderEngine->Jobs());
+
+        if (mScene->GPUStorage().AreMaterialDescriptorsOutdated())
+        {
+            mScene->GPUStorage().UploadMaterials();
+        }
 
         // Top RT needs to be rebuilt every frame
         mRenderEngine->AddTopRayTracingAccelerationStructure(&mScene->GPUStorage().TopAccelerationStructure());
@@ -160,6 +168,13 @@ namespace PathFinder
         };
 
         mGlobalConstants.PipelineRTResolutionInverse = 1.0f / mGlobalConstants.PipelineRTResolution;
+
+        mGlobalConstants.PipelineRenderResolution = {
+            mRenderEngine->RenderSurface().RenderDimensions().Width,
+            mRenderEngine->RenderSurface().RenderDimensions().Height
+        };
+
+        mGlobalConstants.PipelineRTUVScale = mRenderEngine->RenderSurface().UVScale();
         mGlobalConstants.AnisotropicClampSamplerIdx = mRenderEngine->ResourceStorage()->GetSamplerDescriptor(PathFinder::SamplerNames::AnisotropicClamp)->IndexInHeapRange();
         mGlobalConstants.LinearClampSamplerIdx = mRenderEngine->ResourceStorage()->GetSamplerDescriptor(PathFinder::SamplerNames::LinearClamp)->IndexInHeapRange();
         mGlobalConstants.PointClampSamplerIdx = mRenderEngine->ResourceStorage()->GetSamplerDescriptor(PathFinder::SamplerNames::PointClamp)->IndexInHeapRange();
@@ -176,6 +191,7 @@ namespace PathFinder
         mPerFrameConstants.IsGradientDebugEnabled = settings.IsDenoiserGradientDebugRenderingEnabled;
         mPerFrameConstants.IsMotionDebugEnabled = settings.IsDenoiserMotionDebugRenderingEnabled;
         mPerFrameConstants.IsDenoiserAntilagEnabled = settings.IsDenoiserAntilagEnabled;
+        mPerFrameConstants.IsRenderResolutionChanged = mRenderEngine->RenderSurface().IsRenderDimensionsChanged();
 
         mRenderEngine->SetGlobalRootConstants(mGlobalConstants);
         mRenderEngine->SetFrameRootConstants(mPerFrameConstants);
@@ -185,9 +201,39 @@ namespace PathFinder
     {
     }
 
-    void Application::LoadDemoScene()
+    void Application::LoadScene()
     {
-        // This function is temporary until proper scene UI and serialization is implemented 
+        const std::filesystem::path& sceneFilePath = mCmdLineParser->SceneFilePath();
+
+        bool isLoadedFromFile = !sceneFilePath.empty() &&
+            mScene->Deserialize(sceneFilePath, *mMaterialLoader) == SceneFile::LoadResult::Loaded;
+
+        if (!isLoadedFromFile)
+        {
+            BuildDemoScene();
+
+            // Missing or outdated file is replaced, so next launch skips mesh import.
+            // Scene is usable either way, failure only means meshes are imported again next time.
+            if (!sceneFilePath.empty() && !mScene->Serialize(sceneFilePath))
+            {
+                OutputDebugStringA(StringFormat("Failed to write scene file '%s'\n", sceneFilePath.string().c_str()).c_str());
+            }
+        }
+
+        mScene->GPUStorage().UploadMeshes();
+        mScene->BuildMeshBVHs(mRenderEngine->Jobs());
+        mScene->GPUStorage().UploadMaterials();
+
+        // Build bottom AS only once. A production-level application would build every frame
+        for (const PathFinder::BottomRTAS& bottomRTAS : mScene->GPUStorage().BottomAccelerationStructures())
+        {
+            mRenderEngine->AddBottomRayTracingAccelerationStructure(&bottomRTAS);
+        }
+    }
+
+    void Application::BuildDemoScene()
+    {
+        // This function is temporary until proper scene UI is implemented 
         //
         
 
@@ -246,78 +292,79 @@ namespace PathFinder
         {
             for (float z = -100; z < 100; z += 20)
             {
-                PathFinder::MeshInstance& planeInstance = mScene->AddMeshInstance({ &plane, &concrete19Material });
+                PathFinder::MeshInstance planeInstance{ &plane, &concrete19Material };
                 Geometry::Transformation t;
                 t.Translation = glm::vec3{ x, -3.50207, z };
                 planeInstance.SetTransformation(t);
+                mScene->AddMeshInstance(std::move(planeInstance));
             }
         }
 
         PathFinder::Mesh& cube = mScene->AddMesh(std::move(mMeshLoader->Load("cube.obj").back()));
-        PathFinder::MeshInstance& cubeInstance = mScene->AddMeshInstance({ &cube, &metalMaterial });
+        PathFinder::EntityID cubeInstance = mScene->AddMeshInstance({ &cube, &metalMaterial });
 
         PathFinder::Mesh& sphereType1 = mScene->AddMesh(std::move(mMeshLoader->Load("sphere1.obj").back()));
-        PathFinder::MeshInstance& sphereType1Instance0 = mScene->AddMeshInstance({ &sphereType1, &marbleTilesMaterial });
+        PathFinder::EntityID sphereType1Instance0 = mScene->AddMeshInstance({ &sphereType1, &marbleTilesMaterial });
 
         PathFinder::Mesh& sphereType2 = mScene->AddMesh(std::move(mMeshLoader->Load("sphere2.obj").back()));
-        PathFinder::MeshInstance& sphereType2Instance0 = mScene->AddMeshInstance({ &sphereType2, &marbleTilesMaterial });
+        PathFinder::EntityID sphereType2Instance0 = mScene->AddMeshInstance({ &sphereType2, &marbleTilesMaterial });
 
         PathFinder::Mesh& sphereType3 = mScene->AddMesh(std::move(mMeshLoader->Load("sphere3.obj").back()));
-        PathFinder::MeshInstance& sphereType3Instance0 = mScene->AddMeshInstance({ &sphereType3, &grimyMetalMaterial });
-        PathFinder::MeshInstance& sphereType3Instance1 = mScene->AddMeshInstance({ &sphereType3, &redPlasticMaterial });
-        PathFinder::MeshInstance& sphereType3Instance2 = mScene->AddMeshInstance({ &sphereType3, &marble006Material });
-        PathFinder::MeshInstance& sphereType3Instance3 = mScene->AddMeshInstance({ &sphereType3, &charcoalMaterial });
-        PathFinder::MeshInstance& sphereType3Instance4 = mScene->AddMeshInstance({ &sphereType3, &concrete19Material });
-        PathFinder::MeshInstance& sphereType3Instance5 = mScene->AddMeshInstance({ &sphereType3, &metalMaterial });
-
-        Geometry::Transformation t = cubeInstance.Transformation();
+        PathFinder::EntityID sphereType3Instance0 = mScene->AddMeshInstance({ &sphereType3, &grimyMetalMaterial });
+        PathFinder::EntityID sphereType3Instance1 = mScene->AddMeshInstance({ &sphereType3, &redPlasticMaterial });
+        PathFinder::EntityID sphereType3Instance2 = mScene->AddMeshInstance({ &sphereType3, &marble006Material });
+        PathFinder::EntityID sphereType3Instance3 = mScene->AddMeshInstance({ &sphereType3, &charcoalMaterial });
+        PathFinder::EntityID sphereType3Instance4 = mScene->AddMeshInstance({ &sphereType3, &concrete19Material });
+        PathFinder::EntityID sphereType3Instance5 = mScene->AddMeshInstance({ &sphereType3, &metalMaterial });
+
+        Geometry::Transformation t = mScene->GetMeshInstance(cubeInstance)->Transformation();
         t.Rotation = glm::angleAxis(glm::radians(45.0f), glm::normalize(glm::vec3(1.0, 0.0, 1.0)));
         t.Translation = glm::vec3{ -4.88, 3.25, -3.42 };
         t.Scale = glm::vec3{ 0/*2.0f*/ };
-        cubeInstance.SetTransformation(t);
+        mScene->GetMeshInstance(cubeInstance)->SetTransformation(t);
 
         //t.Scale = glm::vec3{ 0.1f }; // Large version
         //t.Translation = glm::vec3{ 0.0, -2, -4.0 }; // Large version
         t.Scale = glm::vec3{ 0.11f };
         t.Translation = glm::vec3{ -6.0, 8.0, -4.0 };
-        sphereType1Instance0.SetTransformation(t);
+        mScene->GetMeshInstance(sphereType1Instance0)->SetTransformation(t);
 
         // Small sphere
         t.Scale = glm::vec3{ 0/*0.21f*/ };
         t.Translation = glm::vec3{ 6.0, -14.0, -9.0 };
-        sphereType2Instance0.SetTransformation(t);
+        mScene->GetMeshInstance(sphereType2Instance0)->SetTransformation(t);
 
         // Normal spheres
         t.Scale = glm::vec3{ 0.12 };
         t.Translation = glm::vec3{ 9.0, 2.0, -17.5 };
-        sphereType3Instance0.SetTransformation(t);
+        mScene->GetMeshInstance(sphereType3Instance0)->SetTransformation(t);
 
         t.Scale = glm::vec3{ 0.085 };
         t.Translation = glm::vec3{ 8.88, 1.2, 0.1 };
-        sphereType3Instance1.SetTransformation(t);
+        mScene->GetMeshInstance(sphereType3Instance1)->SetTransformation(t);
 
         t.Scale = glm::vec3{ 0.15 };
         t.Translation = glm::vec3{ 3.88, 3, -23.77 };
-        sphereType3Instance2.SetTransformation(t);
+        mScene->GetMeshInstance(sphereType3Instance2)->SetTransformation(t);
 
         t.Scale = glm::vec3{ 0.1 };
         t.Translation = glm::vec3{ -13.2, 1.5, -18.6 }; 
-        sphereType3Instance3.SetTransformation(t);
+        mScene->GetMeshInstance(sphereType3Instance3)->SetTransformation(t);
 
         t.Scale = glm::vec3{ 0.09 };
         t.Translation = glm::vec3{ -4.07, 1.25, -19.25 };
-        sphereType3Instance4.SetTransformation(t);
+        mScene->GetMeshInstance(sphereType3Instance4)->SetTransformation(t);
 
         t.Scale = glm::vec3{ 0.1 };
         t.Translation = glm::vec3{ 12.47, 1.7, -9.26 };
-        sphereType3Instance5.SetTransformation(t);
+        mScene->GetMeshInstance(sphereType3Instance5)->SetTransformation(t);
 
         Foundation::Color light0Color{ 255.0 / 255, 241.0 / 255, 224.1 / 255 };
         Foundation::Color light1Color{ 64.0 / 255, 156.0 / 255, 255.0 / 255 };
         Foundation::Color light2Color{ 255.0 / 255, 147.0 / 255, 41.0 / 255 };
         Foundation::Color light3Color{ 250.0 / 255, 110.0 / 255, 100.0 / 255 };
 
-        auto light0 = mScene->EmplaceRectangularLight();
+        PathFinder::FlatLight* light0 = mScene->GetFlatLight(mScene->EmplaceRectangularLight());
         light0->SetWidth(7);
         light0->SetHeight(4);
         light0->SetNormal(glm::vec3{ 0.0, -1.0, 0.0 });
@@ -356,15 +403,6 @@ namespace PathFinder
 
         //sceneManipulatorVC->CameraVM.SetCamera(&mScene->MainCamera());
         //sceneManipulatorVC->EntityVM.SetScene(&scene);
-
-        mScene->GPUStorage().UploadMeshes();
-        mScene->GPUStorage().UploadMaterials();
-
-        // Build bottom AS only once. A production-level application would build every frame
-        for (const PathFinder::BottomRTAS& bottomRTAS : mScene->GPUStorage().BottomAccelerationStructures())
-        {
-            mRenderEngine->AddBottomRayTracingAccelerationStructure(&bottomRTAS);
-        }
     }
 
 }
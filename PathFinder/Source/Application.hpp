@@ -42,6 +42,7 @@
 
 #include <Scene/MeshLoader.hpp>
 #include <Scene/MaterialLoader.hpp>
+#include <Scene/MeshLODSelector.hpp>
 
 namespace PathFinder
 {
@@ -59,7 +60,8 @@ namespace PathFinder
         void InjectRenderPasses();
         void PerformPreRenderActions();
         void PerformPostRenderActions();
-        void LoadDemoScene();
+        void LoadScene();
+        void BuildDemoScene();
 
         HWND mWindowHandle;
         WNDCLASSEX mWindowClass;
@@ -103,6 +105,7 @@ namespace PathFinder
 
         GlobalRootConstants mGlobalConstants;
         PerFrameRootConstants mPerFrameConstants;
+        MeshLODSelector mLODSelector;
 
         // Temporary to load demo scene
         std::unique_ptr<MeshLoader> mMeshLoader;
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Foundation
+{
+    namespace HashUtils
+    {
+        // 64-bit finalizer of MurmurHash3, spreads every input bit over the whole value
+        inline uint64_t Mix(uint64_t value)
+        {
+            value ^= value >> 33;
+            value *= 0xff51afd7ed558ccdull;
+            value ^= value >> 33;
+            value *= 0xc4ceb9fe1a85ec53ull;
+            value ^= value >> 33;
+            return value;
+        }
+
+        // Order dependent: combining the same values in a different order gives a different hash
+        inline uint64_t Combine(uint64_t seed, uint64_t value)
+        {
+            return Mix(seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+        }
+    }
+}
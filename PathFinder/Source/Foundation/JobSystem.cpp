@@ -0,0 +1,311 @@
+#include "JobSystem.hpp"
+
+#include <optional>
+#include <algorithm>
+
+namespace Foundation
+{
+
+    namespace
+    {
+        // Queue index of the current thread inside a job system that owns it
+        thread_local const JobSystem* tOwningJobSystem = nullptr;
+        thread_local uint64_t tQueueIndex = 0;
+    }
+
+    JobSystem::JobSystem(uint64_t workerThreadCount)
+    {
+        for (uint64_t queueIndex = 0; queueIndex <= workerThreadCount; ++queueIndex)
+        {
+            mQueues.emplace_back(std::make_unique<WorkQueue>());
+            mScratchAllocators.emplace_back(std::make_unique<ScratchAllocator>());
+        }
+
+        for (uint64_t workerIndex = 0; workerIndex < workerThreadCount; ++workerIndex)
+        {
+            mWorkerThreads.emplace_back(&JobSystem::WorkerThreadLoop, this, workerIndex + 1);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        mIsShuttingDown.store(true);
+        WakeUpSleepingThreads(true);
+
+        for (std::thread& thread : mWorkerThreads)
+        {
+            thread.join();
+        }
+    }
+
+    void JobSystem::Execute(TaskGraph& graph)
+    {
+        // Tasks are allowed to execute nested graphs. In that case current thread keeps its queue
+        // and helps with any available work while waiting for the nested graph to finish.
+        bool isNestedExecution = tOwningJobSystem == this;
+        uint64_t queueIndex = isNestedExecution ? tQueueIndex : CallingThreadQueueIndex;
+
+        if (!isNestedExecution)
+        {
+            bool wasExecuting = mIsExecuting.exchange(true);
+            assert_format(!wasExecuting, "Job system executes one top level graph at a time");
+
+            // Workers are idle between executions, so it's safe to reset their memory from here
+            for (auto& allocator : mScratchAllocators)
+            {
+                allocator->Reset();
+            }
+
+            tOwningJobSystem = this;
+            tQueueIndex = CallingThreadQueueIndex;
+        }
+
+        graph.PrepareForExecution();
+
+        assert_format(!isNestedExecution || std::none_of(graph.mTasks.begin(), graph.mTasks.end(),
+            [](const TaskGraph::Task& task) { return task.ThreadAffinity == TaskGraph::Affinity::CallingThread; }),
+            "Nested graphs cannot contain calling thread tasks");
+
+        for (TaskGraph::TaskID rootTaskId : graph.mRootTasks)
+        {
+            Enqueue({ &graph, rootTaskId }, queueIndex);
+        }
+
+        bool canTakeCallingThreadTasks = queueIndex == CallingThreadQueueIndex;
+
+        while (!graph.IsFinished())
+        {
+            QueuedTask task;
+
+            if ((canTakeCallingThreadTasks && TryPopCallingThreadTask(task)) ||
+                TryPop(queueIndex, task) ||
+                TrySteal(queueIndex, task))
+            {
+                Run(task, queueIndex);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{ mSleepMutex };
+            mSleepingThreadCount.fetch_add(1);
+
+            mWakeUpCondition.wait(lock, [this, &graph, canTakeCallingThreadTasks]
+            {
+                return graph.IsFinished() || 
+                    mQueuedTaskCount.load() > 0 || 
+                    (canTakeCallingThreadTasks && mQueuedCallingThreadTaskCount.load() > 0);
+            });
+
+            mSleepingThreadCount.fetch_sub(1);
+        }
+
+        if (!isNestedExecution)
+        {
+            tOwningJobSystem = nullptr;
+            mIsExecuting.store(false);
+        }
+    }
+
+    ScratchAllocator& JobSystem::ThreadScratchAllocator()
+    {
+        assert_format(tOwningJobSystem == this, "Scratch memory is only available to tasks executed by this job system");
+        return *mScratchAllocators[tQueueIndex];
+    }
+
+    uint64_t JobSystem::DefaultWorkerThreadCount()
+    {
+        // Leave one hardware thread for the thread that submits graphs
+        return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    void JobSystem::WorkerThreadLoop(uint64_t queueIndex)
+    {
+        tOwningJobSystem = this;
+        tQueueIndex = queueIndex;
+
+        while (true)
+        {
+            QueuedTask task;
+
+            if (TryPop(queueIndex, task) || TrySteal(queueIndex, task))
+            {
+                Run(task, queueIndex);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{ mSleepMutex };
+            mSleepingThreadCount.fetch_add(1);
+
+            mWakeUpCondition.wait(lock, [this]
+            {
+                return mQueuedTaskCount.load() > 0 || mIsShuttingDown.load();
+            });
+
+            mSleepingThreadCount.fetch_sub(1);
+
+            if (mIsShuttingDown.load() && mQueuedTaskCount.load() == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    void JobSystem::Enqueue(const QueuedTask& task, uint64_t queueIndex)
+    {
+        bool isCallingThreadTask = task.Graph->mTasks[task.ID].ThreadAffinity == TaskGraph::Affinity::CallingThread;
+
+        if (isCallingThreadTask)
+        {
+            {
+                std::lock_guard<std::mutex> lock{ mCallingThreadQueue.Mutex };
+                mCallingThreadQueue.Tasks.push_back(task);
+            }
+
+            mQueuedCallingThreadTaskCount.fetch_add(1);
+        }
+        else
+        {
+            WorkQueue& queue = *mQueues[queueIndex];
+
+            {
+                std::lock_guard<std::mutex> lock{ queue.Mutex };
+                queue.Tasks.push_back(task);
+            }
+
+            mQueuedTaskCount.fetch_add(1);
+        }
+
+        // Any thread can pick up regular task, but only one specific thread can take calling thread task
+        WakeUpSleepingThreads(isCallingThreadTask);
+    }
+
+    void JobSystem::Run(QueuedTask task, uint64_t queueIndex)
+    {
+        while (true)
+        {
+            TaskGraph* graph = task.Graph;
+            const TaskGraph::Task& graphTask = graph->mTasks[task.ID];
+
+            graphTask.Work();
+
+            std::optional<QueuedTask> inlineContinuation;
+
+            for (TaskGraph::TaskID continuationId : graphTask.Continuations)
+            {
+                if (!graph->NotifyDependencyCompletion(continuationId))
+                {
+                    continue;
+                }
+
+                bool canRunOnThisThread =
+                    graph->mTasks[continuationId].ThreadAffinity == TaskGraph::Affinity::AnyThread ||
+                    queueIndex == CallingThreadQueueIndex;
+
+                if (!inlineContinuation && canRunOnThisThread)
+                {
+                    inlineContinuation = QueuedTask{ graph, continuationId };
+                }
+                else
+                {
+                    Enqueue({ graph, continuationId }, queueIndex);
+                }
+            }
+
+            // Graph may be destroyed by the calling thread right after the last task is finished,
+            // so it must not be accessed after this point
+            if (graph->NotifyTaskCompletion())
+            {
+                // Completion happens once per execution, so wake up unconditionally
+                {
+                    std::lock_guard<std::mutex> lock{ mSleepMutex };
+                }
+
+                mWakeUpCondition.notify_all();
+            }
+
+            if (!inlineContinuation)
+            {
+                return;
+            }
+
+            task = *inlineContinuation;
+        }
+    }
+
+    void JobSystem::WakeUpSleepingThreads(bool wakeUpAll)
+    {
+        // Sleeping count is incremented under the mutex before wait predicate is checked,
+        // so if it is observed to be zero here, any future sleeper will see the updated task counters
+        if (mSleepingThreadCount.load() == 0 && !mIsShuttingDown.load())
+        {
+            return;
+        }
+
+        {
+            // Prevent notification from slipping in between predicate check and actual wait
+            std::lock_guard<std::mutex> lock{ mSleepMutex };
+        }
+
+        if (wakeUpAll)
+        {
+            mWakeUpCondition.notify_all();
+        }
+        else
+        {
+            mWakeUpCondition.notify_one();
+        }
+    }
+
+    bool JobSystem::TryPop(uint64_t queueIndex, QueuedTask& task)
+    {
+        WorkQueue& queue = *mQueues[queueIndex];
+        std::lock_guard<std::mutex> lock{ queue.Mutex };
+
+        if (queue.Tasks.empty())
+        {
+            return false;
+        }
+
+        // Most recently pushed task is most likely to have its data in cache
+        task = queue.Tasks.back();
+        queue.Tasks.pop_back();
+        mQueuedTaskCount.fetch_sub(1);
+
+        return true;
+    }
+
+    bool JobSystem::TrySteal(uint64_t thiefQueueIndex, QueuedTask& task)
+    {
+        for (uint64_t offset = 1; offset < mQueues.size(); ++offset)
+        {
+            WorkQueue& queue = *mQueues[(thiefQueueIndex + offset) % mQueues.size()];
+            std::lock_guard<std::mutex> lock{ queue.Mutex };
+
+            if (!queue.Tasks.empty())
+            {
+                task = queue.Tasks.front();
+                queue.Tasks.pop_front();
+                mQueuedTaskCount.fetch_sub(1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool JobSystem::TryPopCallingThreadTask(QueuedTask& task)
+    {
+        std::lock_guard<std::mutex> lock{ mCallingThreadQueue.Mutex };
+
+        if (mCallingThreadQueue.Tasks.empty())
+        {
+            return false;
+        }
+
+        task = mCallingThreadQueue.Tasks.front();
+        mCallingThreadQueue.Tasks.pop_front();
+        mQueuedCallingThreadTaskCount.fetch_sub(1);
+
+        return true;
+    }
+
+}
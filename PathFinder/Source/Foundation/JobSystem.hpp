@@ -0,0 +1,81 @@
+#pragma once
+
+#include "TaskGraph.hpp"
+#include "ScratchAllocator.hpp"
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace Foundation
+{
+    // Fixed pool of worker threads executing task graphs.
+    // Each thread owns a queue: it takes work from the back of its own queue and steals from the front of others.
+    // Task completion pushes ready continuations directly, the first of them is executed
+    // by the same thread right away, so dependent chains don't pay for a trip through the queues.
+
+    class JobSystem
+    {
+    public:
+        JobSystem(uint64_t workerThreadCount = DefaultWorkerThreadCount());
+        ~JobSystem();
+
+        // Blocks until every task of the graph is finished. Calling thread participates in execution.
+        // Can be called from inside of a running task to fan out work, but such nested graph cannot
+        // contain calling thread tasks.
+        void Execute(TaskGraph& graph);
+
+        // Scratch memory of the current thread. It stays valid until the next graph execution starts.
+        ScratchAllocator& ThreadScratchAllocator();
+
+        static uint64_t DefaultWorkerThreadCount();
+
+    private:
+        struct QueuedTask
+        {
+            TaskGraph* Graph = nullptr;
+            TaskGraph::TaskID ID = 0;
+        };
+
+        struct WorkQueue
+        {
+            std::mutex Mutex;
+            std::deque<QueuedTask> Tasks;
+        };
+
+        static const uint64_t CallingThreadQueueIndex = 0;
+
+        void WorkerThreadLoop(uint64_t queueIndex);
+        void Enqueue(const QueuedTask& task, uint64_t queueIndex);
+        void Run(QueuedTask task, uint64_t queueIndex);
+        void WakeUpSleepingThreads(bool wakeUpAll);
+
+        bool TryPop(uint64_t queueIndex, QueuedTask& task);
+        bool TrySteal(uint64_t thiefQueueIndex, QueuedTask& task);
+        bool TryPopCallingThreadTask(QueuedTask& task);
+
+        std::vector<std::thread> mWorkerThreads;
+
+        // Queue and scratch allocator at index 0 belong to a thread calling Execute()
+        std::vector<std::unique_ptr<WorkQueue>> mQueues;
+        std::vector<std::unique_ptr<ScratchAllocator>> mScratchAllocators;
+
+        // Tasks that can only be executed by a thread calling Execute(), never stolen
+        WorkQueue mCallingThreadQueue;
+
+        std::mutex mSleepMutex;
+        std::condition_variable mWakeUpCondition;
+        std::atomic<uint64_t> mQueuedTaskCount{ 0 };
+        std::atomic<uint64_t> mQueuedCallingThreadTaskCount{ 0 };
+        std::atomic<uint64_t> mSleepingThreadCount{ 0 };
+        std::atomic<bool> mIsShuttingDown{ false };
+        std::atomic<bool> mIsExecuting{ false };
+
+    public:
+        inline auto WorkerThreadCount() const { return mWorkerThreads.size(); }
+    };
+
+}
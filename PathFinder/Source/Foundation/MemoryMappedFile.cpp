@@ -0,0 +1,132 @@
+#include "MemoryMappedFile.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Foundation
+{
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& that)
+    {
+        *this = std::move(that);
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        Close();
+    }
+
+    MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& that)
+    {
+        if (this == &that)
+        {
+            return *this;
+        }
+
+        Close();
+
+        std::swap(mData, that.mData);
+        std::swap(mSize, that.mSize);
+
+#ifdef _WIN32
+        std::swap(mFileHandle, that.mFileHandle);
+        std::swap(mMappingHandle, that.mMappingHandle);
+#else
+        std::swap(mFileDescriptor, that.mFileDescriptor);
+#endif
+
+        return *this;
+    }
+
+    bool MemoryMappedFile::Open(const std::filesystem::path& path)
+    {
+        Close();
+
+#ifdef _WIN32
+        mFileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (mFileHandle == INVALID_HANDLE_VALUE)
+        {
+            mFileHandle = nullptr;
+            return false;
+        }
+
+        LARGE_INTEGER fileSize{};
+
+        // Zero sized files can't be mapped
+        if (!GetFileSizeEx(mFileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            Close();
+            return false;
+        }
+
+        mMappingHandle = CreateFileMappingW(mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!mMappingHandle)
+        {
+            Close();
+            return false;
+        }
+
+        mData = static_cast<const uint8_t*>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+        mSize = fileSize.QuadPart;
+#else
+        mFileDescriptor = open(path.c_str(), O_RDONLY);
+
+        if (mFileDescriptor < 0)
+        {
+            return false;
+        }
+
+        struct stat fileStatus{};
+
+        // Zero sized files can't be mapped
+        if (fstat(mFileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0)
+        {
+            Close();
+            return false;
+        }
+
+        void* data = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, mFileDescriptor, 0);
+        mData = data != MAP_FAILED ? static_cast<const uint8_t*>(data) : nullptr;
+        mSize = fileStatus.st_size;
+#endif
+
+        if (!mData)
+        {
+            Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void MemoryMappedFile::Close()
+    {
+#ifdef _WIN32
+        if (mData) UnmapViewOfFile(mData);
+        if (mMappingHandle) CloseHandle(mMappingHandle);
+        if (mFileHandle) CloseHandle(mFileHandle);
+
+        mMappingHandle = nullptr;
+        mFileHandle = nullptr;
+#else
+        if (mData) munmap(const_cast<uint8_t*>(mData), mSize);
+        if (mFileDescriptor >= 0) close(mFileDescriptor);
+
+        mFileDescriptor = -1;
+#endif
+
+        mData = nullptr;
+        mSize = 0;
+    }
+
+}
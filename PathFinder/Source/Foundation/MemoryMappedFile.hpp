@@ -0,0 +1,43 @@
+#pragma once
+
+#include <filesystem>
+#include <cstdint>
+
+namespace Foundation
+{
+    // Read-only view of a whole file mapped into address space.
+    // Pages are loaded by the OS on first access, so opening is cheap regardless of file size.
+
+    class MemoryMappedFile
+    {
+    public:
+        MemoryMappedFile() = default;
+        MemoryMappedFile(MemoryMappedFile&& that);
+        MemoryMappedFile(const MemoryMappedFile& that) = delete;
+        ~MemoryMappedFile();
+
+        MemoryMappedFile& operator=(MemoryMappedFile&& that);
+        MemoryMappedFile& operator=(const MemoryMappedFile& that) = delete;
+
+        // Returns false if file doesn't exist, is empty or can't be mapped
+        bool Open(const std::filesystem::path& path);
+        void Close();
+
+    private:
+        const uint8_t* mData = nullptr;
+        uint64_t mSize = 0;
+
+#ifdef _WIN32
+        void* mFileHandle = nullptr;
+        void* mMappingHandle = nullptr;
+#else
+        int mFileDescriptor = -1;
+#endif
+
+    public:
+        inline const uint8_t* Data() const { return mData; }
+        inline uint64_t Size() const { return mSize; }
+        inline bool IsOpen() const { return mData != nullptr; }
+    };
+
+}
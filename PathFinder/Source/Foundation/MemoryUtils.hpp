@@ -1,5 +1,11 @@
 #pragma once
 
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace Foundation
 {
     namespace MemoryUtils
@@ -8,5 +14,22 @@ namespace Foundation
         {
             return (memorySize + alignment - 1) & ~(alignment - 1);
         }
+
+        // Returns 64 for 0
+        inline uint64_t CountLeadingZeros(uint64_t value)
+        {
+#ifdef _MSC_VER
+            unsigned long index = 0;
+            return _BitScanReverse64(&index, value) ? 63 - index : 64;
+#else
+            return value ? __builtin_clzll(value) : 64;
+#endif
+        }
+
+        // Index of the highest set bit, value must not be 0
+        inline uint64_t MostSignificantBit(uint64_t value)
+        {
+            return 63 - CountLeadingZeros(value);
+        }
     }
 }
@@ -0,0 +1,55 @@
+#include "ScratchAllocator.hpp"
+#include "MemoryUtils.hpp"
+
+#include <algorithm>
+
+namespace Foundation
+{
+
+    ScratchAllocator::ScratchAllocator(uint64_t pageSize)
+        : mPageSize{ pageSize } {}
+
+    void* ScratchAllocator::Allocate(uint64_t size, uint64_t alignment)
+    {
+        if (mPages.empty())
+        {
+            AllocatePage(size + alignment);
+        }
+
+        // Align actual address, not the offset, since page memory is only aligned to max_align_t
+        uint64_t pageStart = reinterpret_cast<uint64_t>(mPages.back().Memory.get());
+        uint64_t alignedOffset = MemoryUtils::Align(pageStart + mCurrentPageOffset, alignment) - pageStart;
+
+        if (alignedOffset + size > mPages.back().Size)
+        {
+            AllocatePage(size + alignment);
+            pageStart = reinterpret_cast<uint64_t>(mPages.back().Memory.get());
+            alignedOffset = MemoryUtils::Align(pageStart, alignment) - pageStart;
+        }
+
+        mCurrentPageOffset = alignedOffset + size;
+        mAllocatedBytes += size;
+
+        return mPages.back().Memory.get() + alignedOffset;
+    }
+
+    void ScratchAllocator::Reset()
+    {
+        if (mPages.size() > 1)
+        {
+            mPages.erase(mPages.begin() + 1, mPages.end());
+        }
+
+        mCurrentPageOffset = 0;
+        mAllocatedBytes = 0;
+    }
+
+    void ScratchAllocator::AllocatePage(uint64_t minimumSize)
+    {
+        Page& page = mPages.emplace_back();
+        page.Size = std::max(mPageSize, minimumSize);
+        page.Memory = std::make_unique<uint8_t[]>(page.Size);
+        mCurrentPageOffset = 0;
+    }
+
+}
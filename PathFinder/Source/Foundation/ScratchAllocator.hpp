@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <new>
+
+namespace Foundation
+{
+    // Linear allocator for short-lived per-thread data.
+    // Memory is never freed individually, only all at once on Reset().
+
+    class ScratchAllocator
+    {
+    public:
+        ScratchAllocator(uint64_t pageSize = 64 * 1024);
+
+        void* Allocate(uint64_t size, uint64_t alignment = alignof(std::max_align_t));
+
+        template <class T, class... Args>
+        T* New(Args&&... args);
+
+        template <class T>
+        T* NewArray(uint64_t count);
+
+        // Keep first page to avoid heap traffic in steady state
+        void Reset();
+
+    private:
+        struct Page
+        {
+            std::unique_ptr<uint8_t[]> Memory;
+            uint64_t Size = 0;
+        };
+
+        void AllocatePage(uint64_t minimumSize);
+
+        uint64_t mPageSize = 0;
+        uint64_t mCurrentPageOffset = 0;
+        uint64_t mAllocatedBytes = 0;
+        std::vector<Page> mPages;
+
+    public:
+        inline auto AllocatedBytes() const { return mAllocatedBytes; }
+        inline auto PageCount() const { return mPages.size(); }
+    };
+
+    template <class T, class... Args>
+    T* ScratchAllocator::New(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Destructors are never called for scratch memory");
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template <class T>
+    T* ScratchAllocator::NewArray(uint64_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Destructors are never called for scratch memory");
+        T* array = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            new (array + i) T{};
+        }
+
+        return array;
+    }
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <limits>
+
+namespace Foundation
+{
+
+    struct SlotMapHandle
+    {
+        static const uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        uint32_t Index = InvalidIndex;
+        uint32_t Generation = 0;
+
+        inline bool IsValid() const { return Index != InvalidIndex; }
+        inline bool operator==(const SlotMapHandle& other) const { return Index == other.Index && Generation == other.Generation; }
+        inline bool operator!=(const SlotMapHandle& other) const { return !(*this == other); }
+    };
+
+    // Values are packed densely in insertion order and iterated linearly.
+    // Handles point to slots that stay at the same index for the whole lifetime of a value,
+    // while values themselves move: removal fills the gap with the last value.
+    // Slot generation is bumped on removal, so handles of removed values never resolve
+    // to values inserted into the same slot later.
+    //
+    // Pointers and references to values are invalidated by insertion and removal, handles are not.
+
+    template <class T>
+    class SlotMap
+    {
+    public:
+        using Handle = SlotMapHandle;
+
+        template <class... Args>
+        Handle Emplace(Args&&... args);
+
+        // Returns false if handle doesn't point to a value
+        bool Remove(const Handle& handle);
+
+        void Clear();
+        void Reserve(uint64_t capacity);
+
+        bool Contains(const Handle& handle) const;
+        T* Get(const Handle& handle);
+        const T* Get(const Handle& handle) const;
+
+        // Handle of a value currently occupying the slot
+        std::optional<Handle> HandleAtSlot(uint32_t slotIndex) const;
+
+        // Handle of a value at a position of dense array
+        Handle HandleAt(uint64_t denseIndex) const;
+
+    private:
+        static const uint32_t FreeSlot = std::numeric_limits<uint32_t>::max();
+
+        struct Slot
+        {
+            uint32_t DenseIndex = FreeSlot;
+            uint32_t Generation = 0;
+        };
+
+        std::vector<T> mValues;
+        std::vector<uint32_t> mSlotIndices;
+        std::vector<Slot> mSlots;
+        std::vector<uint32_t> mFreeSlotIndices;
+
+    public:
+        inline auto begin() { return mValues.begin(); }
+        inline auto end() { return mValues.end(); }
+        inline auto begin() const { return mValues.begin(); }
+        inline auto end() const { return mValues.end(); }
+        inline auto size() const { return mValues.size(); }
+        inline bool empty() const { return mValues.empty(); }
+        inline T& operator[](uint64_t denseIndex) { return mValues[denseIndex]; }
+        inline const T& operator[](uint64_t denseIndex) const { return mValues[denseIndex]; }
+        inline const auto& Values() const { return mValues; }
+        inline auto SlotCount() const { return mSlots.size(); }
+    };
+
+}
+
+#include "SlotMap.inl"
@@ -0,0 +1,129 @@
+namespace Foundation
+{
+
+    template <class T>
+    template <class... Args>
+    SlotMapHandle SlotMap<T>::Emplace(Args&&... args)
+    {
+        uint32_t slotIndex = 0;
+
+        if (mFreeSlotIndices.empty())
+        {
+            assert_format(mSlots.size() < FreeSlot, "Slot map is full");
+
+            slotIndex = uint32_t(mSlots.size());
+            mSlots.emplace_back();
+        }
+        else
+        {
+            slotIndex = mFreeSlotIndices.back();
+            mFreeSlotIndices.pop_back();
+        }
+
+        Slot& slot = mSlots[slotIndex];
+        slot.DenseIndex = uint32_t(mValues.size());
+
+        mValues.emplace_back(std::forward<Args>(args)...);
+        mSlotIndices.push_back(slotIndex);
+
+        return Handle{ slotIndex, slot.Generation };
+    }
+
+    template <class T>
+    bool SlotMap<T>::Remove(const Handle& handle)
+    {
+        if (!Contains(handle))
+        {
+            return false;
+        }
+
+        Slot& slot = mSlots[handle.Index];
+        uint32_t lastDenseIndex = uint32_t(mValues.size() - 1);
+
+        // Last value fills the gap, so values stay packed
+        if (slot.DenseIndex != lastDenseIndex)
+        {
+            mValues[slot.DenseIndex] = std::move(mValues[lastDenseIndex]);
+            mSlotIndices[slot.DenseIndex] = mSlotIndices[lastDenseIndex];
+            mSlots[mSlotIndices[slot.DenseIndex]].DenseIndex = slot.DenseIndex;
+        }
+
+        mValues.pop_back();
+        mSlotIndices.pop_back();
+
+        slot.DenseIndex = FreeSlot;
+        ++slot.Generation;
+        mFreeSlotIndices.push_back(handle.Index);
+
+        return true;
+    }
+
+    template <class T>
+    void SlotMap<T>::Clear()
+    {
+        mValues.clear();
+        mSlotIndices.clear();
+        mFreeSlotIndices.clear();
+
+        // Generations survive clearing, so old handles stay invalid
+        for (uint32_t slotIndex = 0; slotIndex < mSlots.size(); ++slotIndex)
+        {
+            Slot& slot = mSlots[slotIndex];
+
+            if (slot.DenseIndex != FreeSlot)
+            {
+                slot.DenseIndex = FreeSlot;
+                ++slot.Generation;
+            }
+
+            mFreeSlotIndices.push_back(uint32_t(mSlots.size()) - slotIndex - 1);
+        }
+    }
+
+    template <class T>
+    void SlotMap<T>::Reserve(uint64_t capacity)
+    {
+        mValues.reserve(capacity);
+        mSlotIndices.reserve(capacity);
+        mSlots.reserve(capacity);
+    }
+
+    template <class T>
+    bool SlotMap<T>::Contains(const Handle& handle) const
+    {
+        return handle.Index < mSlots.size() &&
+            mSlots[handle.Index].DenseIndex != FreeSlot &&
+            mSlots[handle.Index].Generation == handle.Generation;
+    }
+
+    template <class T>
+    T* SlotMap<T>::Get(const Handle& handle)
+    {
+        return Contains(handle) ? &mValues[mSlots[handle.Index].DenseIndex] : nullptr;
+    }
+
+    template <class T>
+    const T* SlotMap<T>::Get(const Handle& handle) const
+    {
+        return Contains(handle) ? &mValues[mSlots[handle.Index].DenseIndex] : nullptr;
+    }
+
+    template <class T>
+    std::optional<SlotMapHandle> SlotMap<T>::HandleAtSlot(uint32_t slotIndex) const
+    {
+        if (slotIndex >= mSlots.size() || mSlots[slotIndex].DenseIndex == FreeSlot)
+        {
+            return std::nullopt;
+        }
+
+        return Handle{ slotIndex, mSlots[slotIndex].Generation };
+    }
+
+    template <class T>
+    SlotMapHandle SlotMap<T>::HandleAt(uint64_t denseIndex) const
+    {
+        uint32_t slotIndex = mSlotIndices[denseIndex];
+        return Handle{ slotIndex, mSlots[slotIndex].Generation };
+    }
+
+}
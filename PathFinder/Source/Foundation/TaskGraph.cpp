@@ -0,0 +1,116 @@
+#include "TaskGraph.hpp"
+
+namespace Foundation
+{
+
+    TaskGraph::TaskID TaskGraph::AddTask(const std::string& name, const Job& job, Affinity affinity)
+    {
+        Task& task = mTasks.emplace_back();
+        task.Name = name;
+        task.Work = job;
+        task.ThreadAffinity = affinity;
+        mIsValidated = false;
+        return mTasks.size() - 1;
+    }
+
+    void TaskGraph::AddDependency(TaskID task, TaskID dependency)
+    {
+        assert_format(task < mTasks.size() && dependency < mTasks.size(), "Task doesn't belong to the graph");
+        assert_format(task != dependency, "Task cannot depend on itself");
+
+        mTasks[dependency].Continuations.push_back(task);
+        mTasks[task].DependencyCount++;
+        mIsValidated = false;
+    }
+
+    void TaskGraph::Clear()
+    {
+        assert_format(IsFinished(), "Cannot clear graph that is being executed");
+
+        mTasks.clear();
+        mRootTasks.clear();
+        mIsValidated = false;
+    }
+
+    void TaskGraph::PrepareForExecution()
+    {
+        assert_format(IsFinished(), "Graph is already being executed");
+
+        if (!mIsValidated)
+        {
+            ValidateAcyclicity();
+
+            mRootTasks.clear();
+
+            for (TaskID taskId = 0; taskId < mTasks.size(); ++taskId)
+            {
+                if (mTasks[taskId].DependencyCount == 0)
+                {
+                    mRootTasks.push_back(taskId);
+                }
+            }
+
+            if (mCounterCapacity < mTasks.size())
+            {
+                mUnfinishedDependencyCounters = std::make_unique<std::atomic<uint64_t>[]>(mTasks.size());
+                mCounterCapacity = mTasks.size();
+            }
+
+            mIsValidated = true;
+        }
+
+        for (TaskID taskId = 0; taskId < mTasks.size(); ++taskId)
+        {
+            mUnfinishedDependencyCounters[taskId].store(mTasks[taskId].DependencyCount, std::memory_order_relaxed);
+        }
+
+        mUnfinishedTaskCount.store(mTasks.size(), std::memory_order_release);
+    }
+
+    void TaskGraph::ValidateAcyclicity() const
+    {
+        // Kahn's algorithm: if not every task can be visited, there is a cycle
+        std::vector<uint64_t> dependencyCounts(mTasks.size());
+        std::vector<TaskID> readyTasks;
+
+        for (TaskID taskId = 0; taskId < mTasks.size(); ++taskId)
+        {
+            dependencyCounts[taskId] = mTasks[taskId].DependencyCount;
+
+            if (dependencyCounts[taskId] == 0)
+            {
+                readyTasks.push_back(taskId);
+            }
+        }
+
+        uint64_t visitedTaskCount = 0;
+
+        while (!readyTasks.empty())
+        {
+            TaskID taskId = readyTasks.back();
+            readyTasks.pop_back();
+            ++visitedTaskCount;
+
+            for (TaskID continuation : mTasks[taskId].Continuations)
+            {
+                if (--dependencyCounts[continuation] == 0)
+                {
+                    readyTasks.push_back(continuation);
+                }
+            }
+        }
+
+        assert_format(visitedTaskCount == mTasks.size(), "Task graph contains a cycle");
+    }
+
+    bool TaskGraph::NotifyDependencyCompletion(TaskID continuation)
+    {
+        return mUnfinishedDependencyCounters[continuation].fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    bool TaskGraph::NotifyTaskCompletion()
+    {
+        return mUnfinishedTaskCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <functional>
+
+namespace Foundation
+{
+    // Static description of work and dependencies between pieces of that work.
+    // Graph is built once and can be executed by JobSystem any amount of times.
+
+    class TaskGraph
+    {
+    public:
+        using TaskID = uint64_t;
+        using Job = std::function<void()>;
+
+        enum class Affinity : uint8_t
+        {
+            // Task can be picked up by any worker
+            AnyThread,
+            // Task is executed on a thread that submitted the graph for execution,
+            // which is required by external code that is not prepared to be called from other threads
+            CallingThread
+        };
+
+        TaskID AddTask(const std::string& name, const Job& job, Affinity affinity = Affinity::AnyThread);
+
+        // Task will not start until dependency is finished
+        void AddDependency(TaskID task, TaskID dependency);
+
+        void Clear();
+
+    private:
+        friend class JobSystem;
+
+        struct Task
+        {
+            std::string Name;
+            Job Work;
+            Affinity ThreadAffinity = Affinity::AnyThread;
+
+            // Tasks to be notified about completion of this task
+            std::vector<TaskID> Continuations;
+            uint64_t DependencyCount = 0;
+        };
+
+        void PrepareForExecution();
+        void ValidateAcyclicity() const;
+
+        // Returns true if continuation became ready for execution
+        bool NotifyDependencyCompletion(TaskID continuation);
+
+        // Returns true if it was the last task of the graph
+        bool NotifyTaskCompletion();
+
+        std::vector<Task> mTasks;
+        std::vector<TaskID> mRootTasks;
+        std::unique_ptr<std::atomic<uint64_t>[]> mUnfinishedDependencyCounters;
+        uint64_t mCounterCapacity = 0;
+        std::atomic<uint64_t> mUnfinishedTaskCount{ 0 };
+        bool mIsValidated = false;
+
+    public:
+        inline const auto& Tasks() const { return mTasks; }
+        inline bool IsFinished() const { return mUnfinishedTaskCount.load(std::memory_order_acquire) == 0; }
+    };
+
+}
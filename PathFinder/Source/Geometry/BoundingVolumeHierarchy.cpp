@@ -0,0 +1,265 @@
+#include "BoundingVolumeHierarchy.hpp"
+
+#include <numeric>
+#include <algorithm>
+
+namespace Geometry
+{
+
+    void BoundingVolumeHierarchy::Build(const std::vector<AxisAlignedBox3D>& primitiveBounds, Foundation::JobSystem* jobSystem)
+    {
+        Build(primitiveBounds, BuildSettings{}, jobSystem);
+    }
+
+    void BoundingVolumeHierarchy::Build(const std::vector<AxisAlignedBox3D>& primitiveBounds, const BuildSettings& settings, Foundation::JobSystem* jobSystem)
+    {
+        mNodes.clear();
+        mPrimitiveIndices.clear();
+
+        if (primitiveBounds.empty())
+        {
+            return;
+        }
+
+        assert_format(primitiveBounds.size() < std::numeric_limits<uint32_t>::max() / 2, "Too many primitives for a hierarchy");
+        assert_format(settings.BinCount >= 2 && settings.MaxLeafSize >= 1, "Invalid hierarchy build settings");
+
+        uint32_t primitiveCount = uint32_t(primitiveBounds.size());
+
+        BuildContext context;
+        context.PrimitiveBounds = &primitiveBounds;
+        context.Settings = settings;
+        context.JobSystem = jobSystem;
+        context.Centroids.resize(primitiveCount);
+
+        for (uint32_t i = 0; i < primitiveCount; ++i)
+        {
+            context.Centroids[i] = (primitiveBounds[i].Min + primitiveBounds[i].Max) * 0.5f;
+        }
+
+        mPrimitiveIndices.resize(primitiveCount);
+        std::iota(mPrimitiveIndices.begin(), mPrimitiveIndices.end(), 0);
+
+        // Binary tree with N leaves at most has 2N - 1 nodes, so children are reserved without locks
+        mNodes.resize(2 * primitiveCount - 1);
+        context.NodeCount.store(1);
+
+        BuildRange root{ 0, 0, primitiveCount, 0 };
+
+        if (jobSystem)
+        {
+            Foundation::TaskGraph buildGraph;
+            buildGraph.AddTask("Build BVH", [this, &context, root] { BuildSubtree(context, root); });
+            jobSystem->Execute(buildGraph);
+        }
+        else
+        {
+            BuildSubtree(context, root);
+        }
+
+        mNodes.resize(context.NodeCount.load());
+        mNodes.shrink_to_fit();
+    }
+
+    void BoundingVolumeHierarchy::BuildSubtree(BuildContext& context, BuildRange range)
+    {
+        AxisAlignedBox3D bounds = AxisAlignedBox3D::MaximumReversed();
+
+        for (uint32_t i = range.First; i < range.First + range.Count; ++i)
+        {
+            const AxisAlignedBox3D& primitiveBounds = (*context.PrimitiveBounds)[mPrimitiveIndices[i]];
+            bounds.Min = glm::min(bounds.Min, primitiveBounds.Min);
+            bounds.Max = glm::max(bounds.Max, primitiveBounds.Max);
+        }
+
+        Node& node = mNodes[range.NodeIndex];
+        node.Bounds = bounds;
+
+        uint32_t firstChildPrimitiveCount = Split(context, range, bounds);
+
+        if (firstChildPrimitiveCount == 0)
+        {
+            node.FirstChildOrPrimitive = range.First;
+            node.PrimitiveCount = range.Count;
+            return;
+        }
+
+        uint32_t firstChildIndex = context.NodeCount.fetch_add(2);
+        node.FirstChildOrPrimitive = firstChildIndex;
+        node.PrimitiveCount = 0;
+
+        BuildRange firstChild{ firstChildIndex, range.First, firstChildPrimitiveCount, range.Depth + 1 };
+        BuildRange secondChild{ firstChildIndex + 1, range.First + firstChildPrimitiveCount, range.Count - firstChildPrimitiveCount, range.Depth + 1 };
+
+        // Children own disjoint ranges of primitive indices and nodes, so they can be built concurrently
+        bool isWorthParallelizing = context.JobSystem &&
+            firstChild.Count >= context.Settings.MinParallelSubtreeSize &&
+            secondChild.Count >= context.Settings.MinParallelSubtreeSize;
+
+        if (isWorthParallelizing)
+        {
+            Foundation::TaskGraph subtreeGraph;
+            subtreeGraph.AddTask("Build BVH Subtree", [this, &context, firstChild] { BuildSubtree(context, firstChild); });
+            subtreeGraph.AddTask("Build BVH Subtree", [this, &context, secondChild] { BuildSubtree(context, secondChild); });
+            context.JobSystem->Execute(subtreeGraph);
+        }
+        else
+        {
+            BuildSubtree(context, firstChild);
+            BuildSubtree(context, secondChild);
+        }
+    }
+
+    uint32_t BoundingVolumeHierarchy::Split(BuildContext& context, const BuildRange& range, const AxisAlignedBox3D& bounds)
+    {
+        const BuildSettings& settings = context.Settings;
+
+        if (range.Count <= 1)
+        {
+            return 0;
+        }
+
+        glm::vec3 centroidMin{ std::numeric_limits<float>::max() };
+        glm::vec3 centroidMax{ std::numeric_limits<float>::lowest() };
+
+        for (uint32_t i = range.First; i < range.First + range.Count; ++i)
+        {
+            centroidMin = glm::min(centroidMin, context.Centroids[mPrimitiveIndices[i]]);
+            centroidMax = glm::max(centroidMax, context.Centroids[mPrimitiveIndices[i]]);
+        }
+
+        glm::vec3 centroidExtent = centroidMax - centroidMin;
+        auto rangeBegin = mPrimitiveIndices.begin() + range.First;
+        auto rangeEnd = rangeBegin + range.Count;
+
+        if (range.Depth >= MaxSAHDepth)
+        {
+            int axis = centroidExtent.x > centroidExtent.y ? (centroidExtent.x > centroidExtent.z ? 0 : 2) : (centroidExtent.y > centroidExtent.z ? 1 : 2);
+
+            std::nth_element(rangeBegin, rangeBegin + range.Count / 2, rangeEnd, [&context, axis](uint32_t a, uint32_t b)
+            {
+                return context.Centroids[a][axis] < context.Centroids[b][axis];
+            });
+
+            return range.Count / 2;
+        }
+
+        struct Bin
+        {
+            AxisAlignedBox3D Bounds = AxisAlignedBox3D::MaximumReversed();
+            uint32_t PrimitiveCount = 0;
+        };
+
+        std::vector<Bin> bins(settings.BinCount);
+        std::vector<float> rightCosts(settings.BinCount);
+
+        float bestCost = std::numeric_limits<float>::max();
+        int bestAxis = -1;
+        uint32_t bestBin = 0;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            // All centroids lie on a plane perpendicular to the axis, nothing to split
+            if (centroidExtent[axis] <= 0.0f)
+            {
+                continue;
+            }
+
+            std::fill(bins.begin(), bins.end(), Bin{});
+            float binScale = settings.BinCount / centroidExtent[axis];
+
+            for (uint32_t i = range.First; i < range.First + range.Count; ++i)
+            {
+                uint32_t primitiveIndex = mPrimitiveIndices[i];
+                uint32_t binIndex = std::min(settings.BinCount - 1, uint32_t((context.Centroids[primitiveIndex][axis] - centroidMin[axis]) * binScale));
+                Bin& bin = bins[binIndex];
+                bin.Bounds.Min = glm::min(bin.Bounds.Min, (*context.PrimitiveBounds)[primitiveIndex].Min);
+                bin.Bounds.Max = glm::max(bin.Bounds.Max, (*context.PrimitiveBounds)[primitiveIndex].Max);
+                ++bin.PrimitiveCount;
+            }
+
+            // Sweep from the right to collect costs of right sides, then from the left to combine them
+            AxisAlignedBox3D accumulatedBounds = AxisAlignedBox3D::MaximumReversed();
+            uint32_t accumulatedCount = 0;
+
+            for (uint32_t binIndex = settings.BinCount - 1; binIndex > 0; --binIndex)
+            {
+                accumulatedBounds.Min = glm::min(accumulatedBounds.Min, bins[binIndex].Bounds.Min);
+                accumulatedBounds.Max = glm::max(accumulatedBounds.Max, bins[binIndex].Bounds.Max);
+                accumulatedCount += bins[binIndex].PrimitiveCount;
+                rightCosts[binIndex] = accumulatedCount > 0 ? SurfaceArea(accumulatedBounds) * accumulatedCount : -1.0f;
+            }
+
+            accumulatedBounds = AxisAlignedBox3D::MaximumReversed();
+            accumulatedCount = 0;
+
+            // Split after bin with the index goes between it and the next one
+            for (uint32_t binIndex = 0; binIndex < settings.BinCount - 1; ++binIndex)
+            {
+                accumulatedBounds.Min = glm::min(accumulatedBounds.Min, bins[binIndex].Bounds.Min);
+                accumulatedBounds.Max = glm::max(accumulatedBounds.Max, bins[binIndex].Bounds.Max);
+                accumulatedCount += bins[binIndex].PrimitiveCount;
+
+                if (accumulatedCount == 0 || rightCosts[binIndex + 1] < 0.0f)
+                {
+                    continue;
+                }
+
+                float cost = SurfaceArea(accumulatedBounds) * accumulatedCount + rightCosts[binIndex + 1];
+
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = binIndex;
+                }
+            }
+        }
+
+        // Primitives are indistinguishable by centroids, any halves are as good as others
+        if (bestAxis < 0)
+        {
+            return range.Count > settings.MaxLeafSize ? range.Count / 2 : 0;
+        }
+
+        float parentArea = SurfaceArea(bounds);
+        float splitCost = settings.TraversalCost + settings.IntersectionCost * (parentArea > 0.0f ? bestCost / parentArea : range.Count);
+        float leafCost = settings.IntersectionCost * range.Count;
+
+        if (splitCost >= leafCost && range.Count <= settings.MaxLeafSize)
+        {
+            return 0;
+        }
+
+        float binScale = settings.BinCount / centroidExtent[bestAxis];
+
+        auto secondHalfBegin = std::partition(rangeBegin, rangeEnd, [&](uint32_t primitiveIndex)
+        {
+            uint32_t binIndex = std::min(settings.BinCount - 1, uint32_t((context.Centroids[primitiveIndex][bestAxis] - centroidMin[bestAxis]) * binScale));
+            return binIndex <= bestBin;
+        });
+
+        return uint32_t(secondHalfBegin - rangeBegin);
+    }
+
+    std::optional<float> BoundingVolumeHierarchy::IntersectBounds(
+        const AxisAlignedBox3D& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance)
+    {
+        glm::vec3 t0 = (box.Min - origin) * inverseDirection;
+        glm::vec3 t1 = (box.Max - origin) * inverseDirection;
+        glm::vec3 tNear = glm::min(t0, t1);
+        glm::vec3 tFar = glm::max(t0, t1);
+
+        float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+
+        return entry <= exit ? std::optional<float>{ entry } : std::nullopt;
+    }
+
+    float BoundingVolumeHierarchy::SurfaceArea(const AxisAlignedBox3D& box)
+    {
+        glm::vec3 extent = glm::max(box.Max - box.Min, glm::vec3{ 0.0f });
+        return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
+
+}
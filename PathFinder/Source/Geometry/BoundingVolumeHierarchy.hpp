@@ -0,0 +1,115 @@
+#pragma once
+
+#include "AxisAlignedBox3D.hpp"
+#include "Ray3D.hpp"
+
+#include <Foundation/JobSystem.hpp>
+
+#include <vector>
+#include <optional>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace Geometry
+{
+
+    /// Binary tree of bounding boxes over abstract primitives, built with binned surface area heuristic.
+    /// Builder only sees primitive bounds, so the same hierarchy serves triangles of a mesh
+    /// as well as instances of a scene, and it can be verified without a device.
+    ///
+    /// Large subtrees are built in parallel when a job system is provided.
+    class BoundingVolumeHierarchy
+    {
+    public:
+        struct Node
+        {
+            AxisAlignedBox3D Bounds;
+
+            // First of two adjacent children for inner nodes, first entry of PrimitiveIndices() for leaves
+            uint32_t FirstChildOrPrimitive = 0;
+
+            // Zero for inner nodes
+            uint32_t PrimitiveCount = 0;
+
+            inline bool IsLeaf() const { return PrimitiveCount > 0; }
+        };
+
+        struct BuildSettings
+        {
+            // Candidate split planes per axis are placed between bins of primitive centroids
+            uint32_t BinCount = 16;
+
+            // Smaller ranges become leaves when splitting them is not worth it by SAH
+            uint32_t MaxLeafSize = 8;
+
+            // Relative costs of visiting a node and testing a primitive
+            float TraversalCost = 1.0f;
+            float IntersectionCost = 1.0f;
+
+            // Subtrees with fewer primitives are built by a single task
+            uint32_t MinParallelSubtreeSize = 8192;
+        };
+
+        struct RayHit
+        {
+            uint32_t PrimitiveIndex = 0;
+            float Distance = 0.0f;
+        };
+
+        void Build(const std::vector<AxisAlignedBox3D>& primitiveBounds, Foundation::JobSystem* jobSystem = nullptr);
+        void Build(const std::vector<AxisAlignedBox3D>& primitiveBounds, const BuildSettings& settings, Foundation::JobSystem* jobSystem = nullptr);
+
+        // Finds closest primitive hit by the ray within max distance.
+        // Nodes are visited front to back and the closest hit so far prunes the rest of them.
+        // Test has signature bool(uint32_t primitiveIndex, float& distance).
+        template <class PrimitiveTest>
+        std::optional<RayHit> CastRay(const Ray3D& ray, float maxDistance, const PrimitiveTest& test) const;
+
+    private:
+        struct BuildRange
+        {
+            uint32_t NodeIndex = 0;
+            uint32_t First = 0;
+            uint32_t Count = 0;
+            uint32_t Depth = 0;
+        };
+
+        // Past this depth splits are made at object median, which keeps the tree depth
+        // and therefore the traversal stack bounded for any input
+        static const uint32_t MaxSAHDepth = 64;
+        static const uint32_t MaxDepth = MaxSAHDepth + 32;
+
+        struct BuildContext
+        {
+            const std::vector<AxisAlignedBox3D>* PrimitiveBounds = nullptr;
+            std::vector<glm::vec3> Centroids;
+            BuildSettings Settings;
+            Foundation::JobSystem* JobSystem = nullptr;
+            std::atomic<uint32_t> NodeCount{ 0 };
+        };
+
+        void BuildSubtree(BuildContext& context, BuildRange range);
+
+        // Returns a count of primitives going to the first child, 0 if range should stay a leaf
+        uint32_t Split(BuildContext& context, const BuildRange& range, const AxisAlignedBox3D& bounds);
+
+        // Entry distance into the box or nullopt if it's missed or farther than max distance
+        static std::optional<float> IntersectBounds(
+            const AxisAlignedBox3D& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance);
+
+        static float SurfaceArea(const AxisAlignedBox3D& box);
+
+        std::vector<Node> mNodes;
+        std::vector<uint32_t> mPrimitiveIndices;
+
+    public:
+        inline const auto& Nodes() const { return mNodes; }
+        inline const auto& PrimitiveIndices() const { return mPrimitiveIndices; }
+        inline bool IsEmpty() const { return mNodes.empty(); }
+        inline const AxisAlignedBox3D& Bounds() const { return mNodes.front().Bounds; }
+    };
+
+}
+
+#include "BoundingVolumeHierarchy.inl"
@@ -0,0 +1,75 @@
+namespace Geometry
+{
+
+    template <class PrimitiveTest>
+    std::optional<BoundingVolumeHierarchy::RayHit> BoundingVolumeHierarchy::CastRay(const Ray3D& ray, float maxDistance, const PrimitiveTest& test) const
+    {
+        if (mNodes.empty())
+        {
+            return std::nullopt;
+        }
+
+        glm::vec3 inverseDirection = glm::vec3(1.0f) / ray.direction;
+
+        std::optional<RayHit> closestHit;
+        float closestDistance = maxDistance;
+
+        if (!IntersectBounds(mNodes[0].Bounds, ray.origin, inverseDirection, closestDistance))
+        {
+            return std::nullopt;
+        }
+
+        struct StackEntry { uint32_t NodeIndex; float Distance; };
+        StackEntry stack[MaxDepth + 1];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = { 0, 0.0f };
+
+        while (stackSize > 0)
+        {
+            StackEntry entry = stack[--stackSize];
+
+            // Node may have become farther than a hit found after it was pushed
+            if (entry.Distance > closestDistance)
+            {
+                continue;
+            }
+
+            const Node& node = mNodes[entry.NodeIndex];
+
+            if (node.IsLeaf())
+            {
+                for (uint32_t i = node.FirstChildOrPrimitive; i < node.FirstChildOrPrimitive + node.PrimitiveCount; ++i)
+                {
+                    float distance = closestDistance;
+                    uint32_t primitiveIndex = mPrimitiveIndices[i];
+
+                    if (test(primitiveIndex, distance) && distance >= 0.0f && distance <= closestDistance)
+                    {
+                        closestDistance = distance;
+                        closestHit = RayHit{ primitiveIndex, distance };
+                    }
+                }
+
+                continue;
+            }
+
+            uint32_t nearChild = node.FirstChildOrPrimitive;
+            uint32_t farChild = node.FirstChildOrPrimitive + 1;
+            std::optional<float> nearDistance = IntersectBounds(mNodes[nearChild].Bounds, ray.origin, inverseDirection, closestDistance);
+            std::optional<float> farDistance = IntersectBounds(mNodes[farChild].Bounds, ray.origin, inverseDirection, closestDistance);
+
+            if (nearDistance && farDistance && *farDistance < *nearDistance)
+            {
+                std::swap(nearChild, farChild);
+                std::swap(nearDistance, farDistance);
+            }
+
+            // Farther child is pushed first, so the nearer one is visited first
+            if (farDistance) stack[stackSize++] = { farChild, *farDistance };
+            if (nearDistance) stack[stackSize++] = { nearChild, *nearDistance };
+        }
+
+        return closestHit;
+    }
+
+}
@@ -0,0 +1,397 @@
+#include "CollisionBatch.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define COLLISION_BATCH_SSE 1
+#include <immintrin.h>
+#endif
+
+// MSVC accepts AVX intrinsics without /arch:AVX, availability is checked at runtime
+#if (defined(_MSC_VER) && defined(_M_X64)) || defined(__AVX__)
+#define COLLISION_BATCH_AVX 1
+#endif
+
+#if defined(_MSC_VER) && defined(COLLISION_BATCH_AVX)
+#include <intrin.h>
+#endif
+
+namespace Geometry
+{
+
+    namespace
+    {
+
+        // Lane operations must map to single IEEE operations everywhere.
+        // Min and Max follow minps/maxps rules: second operand is returned when comparison fails.
+
+        struct ScalarLanes
+        {
+            struct Float { float Lanes[CollisionBatch::PacketWidth]; };
+            struct Mask { bool Lanes[CollisionBatch::PacketWidth]; };
+
+            template <class Result, class Op>
+            static Result Apply(const Float& a, const Float& b, const Op& op)
+            {
+                Result result;
+                for (uint64_t lane = 0; lane < CollisionBatch::PacketWidth; ++lane) result.Lanes[lane] = op(a.Lanes[lane], b.Lanes[lane]);
+                return result;
+            }
+
+            static Float Load(const float* values) { Float result; std::copy_n(values, CollisionBatch::PacketWidth, result.Lanes); return result; }
+            static Float Broadcast(float value) { Float result; std::fill_n(result.Lanes, CollisionBatch::PacketWidth, value); return result; }
+            static void Store(float* values, const Float& a) { std::copy_n(a.Lanes, CollisionBatch::PacketWidth, values); }
+
+            static Float Add(const Float& a, const Float& b) { return Apply<Float>(a, b, [](float x, float y) { return x + y; }); }
+            static Float Sub(const Float& a, const Float& b) { return Apply<Float>(a, b, [](float x, float y) { return x - y; }); }
+            static Float Mul(const Float& a, const Float& b) { return Apply<Float>(a, b, [](float x, float y) { return x * y; }); }
+            static Float Div(const Float& a, const Float& b) { return Apply<Float>(a, b, [](float x, float y) { return x / y; }); }
+            static Float Min(const Float& a, const Float& b) { return Apply<Float>(a, b, [](float x, float y) { return x < y ? x : y; }); }
+            static Float Max(const Float& a, const Float& b) { return Apply<Float>(a, b, [](float x, float y) { return x > y ? x : y; }); }
+            static Mask Less(const Float& a, const Float& b) { return Apply<Mask>(a, b, [](float x, float y) { return x < y; }); }
+            static Mask LessEqual(const Float& a, const Float& b) { return Apply<Mask>(a, b, [](float x, float y) { return x <= y; }); }
+
+            static Mask And(const Mask& a, const Mask& b)
+            {
+                Mask result;
+                for (uint64_t lane = 0; lane < CollisionBatch::PacketWidth; ++lane) result.Lanes[lane] = a.Lanes[lane] && b.Lanes[lane];
+                return result;
+            }
+
+            static Mask Or(const Mask& a, const Mask& b)
+            {
+                Mask result;
+                for (uint64_t lane = 0; lane < CollisionBatch::PacketWidth; ++lane) result.Lanes[lane] = a.Lanes[lane] || b.Lanes[lane];
+                return result;
+            }
+
+            static Float Select(const Mask& mask, const Float& a, const Float& b)
+            {
+                Float result;
+                for (uint64_t lane = 0; lane < CollisionBatch::PacketWidth; ++lane) result.Lanes[lane] = mask.Lanes[lane] ? a.Lanes[lane] : b.Lanes[lane];
+                return result;
+            }
+
+            static uint32_t MoveMask(const Mask& mask)
+            {
+                uint32_t bits = 0;
+                for (uint64_t lane = 0; lane < CollisionBatch::PacketWidth; ++lane) bits |= uint32_t(mask.Lanes[lane]) << lane;
+                return bits;
+            }
+
+            static void Finish() {}
+        };
+
+#ifdef COLLISION_BATCH_SSE
+
+        // 8 lanes as two 4-wide halves
+        struct SSELanes
+        {
+            struct Float { __m128 Low; __m128 High; };
+            using Mask = Float;
+
+            static Float Load(const float* values) { return { _mm_load_ps(values), _mm_load_ps(values + 4) }; }
+            static Float Broadcast(float value) { return { _mm_set1_ps(value), _mm_set1_ps(value) }; }
+            static void Store(float* values, const Float& a) { _mm_store_ps(values, a.Low); _mm_store_ps(values + 4, a.High); }
+
+            static Float Add(const Float& a, const Float& b) { return { _mm_add_ps(a.Low, b.Low), _mm_add_ps(a.High, b.High) }; }
+            static Float Sub(const Float& a, const Float& b) { return { _mm_sub_ps(a.Low, b.Low), _mm_sub_ps(a.High, b.High) }; }
+            static Float Mul(const Float& a, const Float& b) { return { _mm_mul_ps(a.Low, b.Low), _mm_mul_ps(a.High, b.High) }; }
+            static Float Div(const Float& a, const Float& b) { return { _mm_div_ps(a.Low, b.Low), _mm_div_ps(a.High, b.High) }; }
+            static Float Min(const Float& a, const Float& b) { return { _mm_min_ps(a.Low, b.Low), _mm_min_ps(a.High, b.High) }; }
+            static Float Max(const Float& a, const Float& b) { return { _mm_max_ps(a.Low, b.Low), _mm_max_ps(a.High, b.High) }; }
+            static Mask Less(const Float& a, const Float& b) { return { _mm_cmplt_ps(a.Low, b.Low), _mm_cmplt_ps(a.High, b.High) }; }
+            static Mask LessEqual(const Float& a, const Float& b) { return { _mm_cmple_ps(a.Low, b.Low), _mm_cmple_ps(a.High, b.High) }; }
+            static Mask And(const Mask& a, const Mask& b) { return { _mm_and_ps(a.Low, b.Low), _mm_and_ps(a.High, b.High) }; }
+            static Mask Or(const Mask& a, const Mask& b) { return { _mm_or_ps(a.Low, b.Low), _mm_or_ps(a.High, b.High) }; }
+
+            static Float Select(const Mask& mask, const Float& a, const Float& b)
+            {
+                return {
+                    _mm_or_ps(_mm_and_ps(mask.Low, a.Low), _mm_andnot_ps(mask.Low, b.Low)),
+                    _mm_or_ps(_mm_and_ps(mask.High, a.High), _mm_andnot_ps(mask.High, b.High))
+                };
+            }
+
+            static uint32_t MoveMask(const Mask& mask) { return uint32_t(_mm_movemask_ps(mask.Low)) | (uint32_t(_mm_movemask_ps(mask.High)) << 4); }
+
+            static void Finish() {}
+        };
+
+#endif
+
+#ifdef COLLISION_BATCH_AVX
+
+        struct AVXLanes
+        {
+            using Float = __m256;
+            using Mask = __m256;
+
+            static Float Load(const float* values) { return _mm256_load_ps(values); }
+            static Float Broadcast(float value) { return _mm256_set1_ps(value); }
+            static void Store(float* values, Float a) { _mm256_store_ps(values, a); }
+
+            static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+            static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+            static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+            static Float Div(Float a, Float b) { return _mm256_div_ps(a, b); }
+            static Float Min(Float a, Float b) { return _mm256_min_ps(a, b); }
+            static Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+            static Mask Less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+            static Mask LessEqual(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+            static Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+            static Mask Or(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+            static Float Select(Mask mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+            static uint32_t MoveMask(Mask mask) { return uint32_t(_mm256_movemask_ps(mask)); }
+
+            // Avoids AVX to SSE transition penalties in code that follows
+            static void Finish() { _mm256_zeroupper(); }
+        };
+
+#endif
+
+        uint32_t ValidLanesMask(uint64_t packetIndex, uint64_t itemCount)
+        {
+            uint64_t laneCount = std::min(itemCount - packetIndex * CollisionBatch::PacketWidth, CollisionBatch::PacketWidth);
+            return (1u << laneCount) - 1;
+        }
+
+        template <class L>
+        void Slab(
+            const typename L::Float (&origin)[3], const typename L::Float (&inverseDirection)[3],
+            const typename L::Float (&min)[3], const typename L::Float (&max)[3],
+            uint32_t validLanes, CollisionBatch::PacketHits& hits)
+        {
+            using Float = typename L::Float;
+
+            Float t1 = L::Mul(L::Sub(min[0], origin[0]), inverseDirection[0]);
+            Float t2 = L::Mul(L::Sub(max[0], origin[0]), inverseDirection[0]);
+            Float t3 = L::Mul(L::Sub(min[1], origin[1]), inverseDirection[1]);
+            Float t4 = L::Mul(L::Sub(max[1], origin[1]), inverseDirection[1]);
+            Float t5 = L::Mul(L::Sub(min[2], origin[2]), inverseDirection[2]);
+            Float t6 = L::Mul(L::Sub(max[2], origin[2]), inverseDirection[2]);
+
+            Float tmin = L::Max(L::Max(L::Min(t1, t2), L::Min(t3, t4)), L::Min(t5, t6));
+            Float tmax = L::Min(L::Min(L::Max(t1, t2), L::Max(t3, t4)), L::Max(t5, t6));
+
+            // Box is either behind the ray or missed by it
+            auto miss = L::Or(L::Less(tmax, L::Broadcast(0.0f)), L::Less(tmax, tmin));
+
+            L::Store(hits.Distances, L::Select(miss, tmax, tmin));
+            hits.Mask = ~L::MoveMask(miss) & validLanes;
+        }
+
+        template <class L>
+        void RayAABBKernel(const Ray3D& ray, const CollisionBatch::AABBPacket* boxes, uint64_t boxCount, CollisionBatch::PacketHits* hits)
+        {
+            using Float = typename L::Float;
+
+            glm::vec3 inverseDirection = glm::vec3(1.0f) / ray.direction;
+
+            Float origin[3] = { L::Broadcast(ray.origin.x), L::Broadcast(ray.origin.y), L::Broadcast(ray.origin.z) };
+            Float invDir[3] = { L::Broadcast(inverseDirection.x), L::Broadcast(inverseDirection.y), L::Broadcast(inverseDirection.z) };
+
+            for (uint64_t packetIdx = 0; packetIdx < CollisionBatch::PacketCount(boxCount); ++packetIdx)
+            {
+                const CollisionBatch::AABBPacket& packet = boxes[packetIdx];
+                Float min[3] = { L::Load(packet.MinX), L::Load(packet.MinY), L::Load(packet.MinZ) };
+                Float max[3] = { L::Load(packet.MaxX), L::Load(packet.MaxY), L::Load(packet.MaxZ) };
+
+                Slab<L>(origin, invDir, min, max, ValidLanesMask(packetIdx, boxCount), hits[packetIdx]);
+            }
+
+            L::Finish();
+        }
+
+        template <class L>
+        void RaysAABBKernel(const CollisionBatch::RayPacket* rays, uint64_t rayCount, const AxisAlignedBox3D& box, CollisionBatch::PacketHits* hits)
+        {
+            using Float = typename L::Float;
+
+            Float one = L::Broadcast(1.0f);
+            Float min[3] = { L::Broadcast(box.Min.x), L::Broadcast(box.Min.y), L::Broadcast(box.Min.z) };
+            Float max[3] = { L::Broadcast(box.Max.x), L::Broadcast(box.Max.y), L::Broadcast(box.Max.z) };
+
+            for (uint64_t packetIdx = 0; packetIdx < CollisionBatch::PacketCount(rayCount); ++packetIdx)
+            {
+                const CollisionBatch::RayPacket& packet = rays[packetIdx];
+                Float origin[3] = { L::Load(packet.OriginX), L::Load(packet.OriginY), L::Load(packet.OriginZ) };
+                Float invDir[3] = {
+                    L::Div(one, L::Load(packet.DirectionX)),
+                    L::Div(one, L::Load(packet.DirectionY)),
+                    L::Div(one, L::Load(packet.DirectionZ))
+                };
+
+                Slab<L>(origin, invDir, min, max, ValidLanesMask(packetIdx, rayCount), hits[packetIdx]);
+            }
+
+            L::Finish();
+        }
+
+        // Moller-Trumbore ray-triangle test
+        template <class L>
+        void RayTriangleKernel(const Ray3D& ray, const CollisionBatch::TrianglePacket* triangles, uint64_t triangleCount, CollisionBatch::PacketHits* hits)
+        {
+            using Float = typename L::Float;
+
+            Float zero = L::Broadcast(0.0f);
+            Float one = L::Broadcast(1.0f);
+            Float ox = L::Broadcast(ray.origin.x), oy = L::Broadcast(ray.origin.y), oz = L::Broadcast(ray.origin.z);
+            Float dx = L::Broadcast(ray.direction.x), dy = L::Broadcast(ray.direction.y), dz = L::Broadcast(ray.direction.z);
+
+            for (uint64_t packetIdx = 0; packetIdx < CollisionBatch::PacketCount(triangleCount); ++packetIdx)
+            {
+                const CollisionBatch::TrianglePacket& packet = triangles[packetIdx];
+                Float e1x = L::Load(packet.ABX), e1y = L::Load(packet.ABY), e1z = L::Load(packet.ABZ);
+                Float e2x = L::Load(packet.ACX), e2y = L::Load(packet.ACY), e2z = L::Load(packet.ACZ);
+
+                Float px = L::Sub(L::Mul(dy, e2z), L::Mul(dz, e2y));
+                Float py = L::Sub(L::Mul(dz, e2x), L::Mul(dx, e2z));
+                Float pz = L::Sub(L::Mul(dx, e2y), L::Mul(dy, e2x));
+                Float det = L::Add(L::Add(L::Mul(e1x, px), L::Mul(e1y, py)), L::Mul(e1z, pz));
+                Float invDet = L::Div(one, det);
+
+                Float tx = L::Sub(ox, L::Load(packet.AX));
+                Float ty = L::Sub(oy, L::Load(packet.AY));
+                Float tz = L::Sub(oz, L::Load(packet.AZ));
+                Float u = L::Mul(L::Add(L::Add(L::Mul(tx, px), L::Mul(ty, py)), L::Mul(tz, pz)), invDet);
+
+                Float qx = L::Sub(L::Mul(ty, e1z), L::Mul(tz, e1y));
+                Float qy = L::Sub(L::Mul(tz, e1x), L::Mul(tx, e1z));
+                Float qz = L::Sub(L::Mul(tx, e1y), L::Mul(ty, e1x));
+                Float v = L::Mul(L::Add(L::Add(L::Mul(dx, qx), L::Mul(dy, qy)), L::Mul(dz, qz)), invDet);
+                Float t = L::Mul(L::Add(L::Add(L::Mul(e2x, qx), L::Mul(e2y, qy)), L::Mul(e2z, qz)), invDet);
+
+                // Negative determinant means the ray looks at the front face (normal is AC x AB)
+                auto hit = L::And(
+                    L::And(L::Less(det, zero), L::LessEqual(zero, t)),
+                    L::And(L::And(L::LessEqual(zero, u), L::LessEqual(zero, v)), L::LessEqual(L::Add(u, v), one)));
+
+                L::Store(hits[packetIdx].Distances, t);
+                hits[packetIdx].Mask = L::MoveMask(hit) & ValidLanesMask(packetIdx, triangleCount);
+            }
+
+            L::Finish();
+        }
+
+        // Calls func with lanes type of the instruction set
+        template <class Func>
+        void Dispatch(CollisionBatch::InstructionSet instructionSet, const Func& func)
+        {
+            switch (instructionSet)
+            {
+#ifdef COLLISION_BATCH_AVX
+            case CollisionBatch::InstructionSet::AVX: func(AVXLanes{}); return;
+#endif
+#ifdef COLLISION_BATCH_SSE
+            case CollisionBatch::InstructionSet::SSE: func(SSELanes{}); return;
+#endif
+            case CollisionBatch::InstructionSet::Scalar: func(ScalarLanes{}); return;
+            default: assert_format(false, "Instruction set is not available in this build"); return;
+            }
+        }
+
+        template <class Packet, class Item>
+        std::vector<Packet> Pack(const Item* items, uint64_t count)
+        {
+            std::vector<Packet> packets(CollisionBatch::PacketCount(count));
+
+            for (uint64_t itemIdx = 0; itemIdx < count; ++itemIdx)
+            {
+                packets[itemIdx / CollisionBatch::PacketWidth].Set(itemIdx % CollisionBatch::PacketWidth, items[itemIdx]);
+            }
+
+            return packets;
+        }
+
+    }
+
+    void CollisionBatch::AABBPacket::Set(uint64_t lane, const AxisAlignedBox3D& box)
+    {
+        MinX[lane] = box.Min.x; MinY[lane] = box.Min.y; MinZ[lane] = box.Min.z;
+        MaxX[lane] = box.Max.x; MaxY[lane] = box.Max.y; MaxZ[lane] = box.Max.z;
+    }
+
+    void CollisionBatch::TrianglePacket::Set(uint64_t lane, const Triangle3D& triangle)
+    {
+        glm::vec3 ab = triangle.b - triangle.a;
+        glm::vec3 ac = triangle.c - triangle.a;
+
+        AX[lane] = triangle.a.x; AY[lane] = triangle.a.y; AZ[lane] = triangle.a.z;
+        ABX[lane] = ab.x; ABY[lane] = ab.y; ABZ[lane] = ab.z;
+        ACX[lane] = ac.x; ACY[lane] = ac.y; ACZ[lane] = ac.z;
+    }
+
+    void CollisionBatch::RayPacket::Set(uint64_t lane, const Ray3D& ray)
+    {
+        OriginX[lane] = ray.origin.x; OriginY[lane] = ray.origin.y; OriginZ[lane] = ray.origin.z;
+        DirectionX[lane] = ray.direction.x; DirectionY[lane] = ray.direction.y; DirectionZ[lane] = ray.direction.z;
+    }
+
+    CollisionBatch::InstructionSet CollisionBatch::SupportedInstructionSet()
+    {
+        static const InstructionSet instructionSet = []
+        {
+#if defined(COLLISION_BATCH_AVX) && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 1);
+
+            bool cpuSupportsAVX = (info[2] & (1 << 28)) != 0;
+            bool osSavesYMM = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+            if (cpuSupportsAVX && osSavesYMM)
+            {
+                return InstructionSet::AVX;
+            }
+#elif defined(COLLISION_BATCH_AVX)
+            return InstructionSet::AVX;
+#endif
+
+#ifdef COLLISION_BATCH_SSE
+            return InstructionSet::SSE;
+#else
+            return InstructionSet::Scalar;
+#endif
+        }();
+
+        return instructionSet;
+    }
+
+    uint64_t CollisionBatch::PacketCount(uint64_t itemCount)
+    {
+        return (itemCount + PacketWidth - 1) / PacketWidth;
+    }
+
+    std::vector<CollisionBatch::AABBPacket> CollisionBatch::MakePackets(const AxisAlignedBox3D* boxes, uint64_t count)
+    {
+        return Pack<AABBPacket>(boxes, count);
+    }
+
+    std::vector<CollisionBatch::TrianglePacket> CollisionBatch::MakePackets(const Triangle3D* triangles, uint64_t count)
+    {
+        return Pack<TrianglePacket>(triangles, count);
+    }
+
+    std::vector<CollisionBatch::RayPacket> CollisionBatch::MakePackets(const Ray3D* rays, uint64_t count)
+    {
+        return Pack<RayPacket>(rays, count);
+    }
+
+    void CollisionBatch::RayAABB(const Ray3D& ray, const AABBPacket* boxes, uint64_t boxCount, PacketHits* hits, InstructionSet instructionSet)
+    {
+        Dispatch(instructionSet, [&](auto lanes) { RayAABBKernel<decltype(lanes)>(ray, boxes, boxCount, hits); });
+    }
+
+    void CollisionBatch::RayTriangle(const Ray3D& ray, const TrianglePacket* triangles, uint64_t triangleCount, PacketHits* hits, InstructionSet instructionSet)
+    {
+        Dispatch(instructionSet, [&](auto lanes) { RayTriangleKernel<decltype(lanes)>(ray, triangles, triangleCount, hits); });
+    }
+
+    void CollisionBatch::RayAABB(const RayPacket* rays, uint64_t rayCount, const AxisAlignedBox3D& box, PacketHits* hits, InstructionSet instructionSet)
+    {
+        Dispatch(instructionSet, [&](auto lanes) { RaysAABBKernel<decltype(lanes)>(rays, rayCount, box, hits); });
+    }
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "AxisAlignedBox3D.hpp"
+#include "Ray3D.hpp"
+#include "Triangle3D.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Geometry
+{
+
+    /// Batched counterparts of Collision queries.
+    /// Primitives are stored in structure-of-arrays packets of 8 lanes and tested
+    /// 8 at a time with AVX, SSE or plain scalar code. All instruction sets execute
+    /// the same sequence of IEEE operations, so their results are bit-identical.
+    ///
+    /// Lanes of the last packet past the item count are never reported as hits.
+    class CollisionBatch
+    {
+    public:
+        enum class InstructionSet
+        {
+            Scalar, SSE, AVX
+        };
+
+        static const uint64_t PacketWidth = 8;
+
+        struct alignas(32) AABBPacket
+        {
+            float MinX[PacketWidth] = {};
+            float MinY[PacketWidth] = {};
+            float MinZ[PacketWidth] = {};
+            float MaxX[PacketWidth] = {};
+            float MaxY[PacketWidth] = {};
+            float MaxZ[PacketWidth] = {};
+
+            void Set(uint64_t lane, const AxisAlignedBox3D& box);
+        };
+
+        // Triangles are stored as vertex A and edges AB, AC
+        struct alignas(32) TrianglePacket
+        {
+            float AX[PacketWidth] = {};
+            float AY[PacketWidth] = {};
+            float AZ[PacketWidth] = {};
+            float ABX[PacketWidth] = {};
+            float ABY[PacketWidth] = {};
+            float ABZ[PacketWidth] = {};
+            float ACX[PacketWidth] = {};
+            float ACY[PacketWidth] = {};
+            float ACZ[PacketWidth] = {};
+
+            void Set(uint64_t lane, const Triangle3D& triangle);
+        };
+
+        struct alignas(32) RayPacket
+        {
+            float OriginX[PacketWidth] = {};
+            float OriginY[PacketWidth] = {};
+            float OriginZ[PacketWidth] = {};
+            float DirectionX[PacketWidth] = {};
+            float DirectionY[PacketWidth] = {};
+            float DirectionZ[PacketWidth] = {};
+
+            void Set(uint64_t lane, const Ray3D& ray);
+        };
+
+        struct alignas(32) PacketHits
+        {
+            // Same meaning as distance output of scalar Collision functions
+            float Distances[PacketWidth] = {};
+
+            // Bit N is set when lane N hits
+            uint32_t Mask = 0;
+        };
+
+        // Best instruction set supported by both the build and the CPU
+        static InstructionSet SupportedInstructionSet();
+
+        static uint64_t PacketCount(uint64_t itemCount);
+
+        static std::vector<AABBPacket> MakePackets(const AxisAlignedBox3D* boxes, uint64_t count);
+        static std::vector<TrianglePacket> MakePackets(const Triangle3D* triangles, uint64_t count);
+        static std::vector<RayPacket> MakePackets(const Ray3D* rays, uint64_t count);
+
+        // One ray against boxes, slab test with Collision::RayAABB semantics
+        static void RayAABB(
+            const Ray3D& ray, const AABBPacket* boxes, uint64_t boxCount, PacketHits* hits,
+            InstructionSet instructionSet = SupportedInstructionSet());
+
+        // One ray against triangles. Only triangles facing the ray are hit, as in Collision::RayTriangle.
+        static void RayTriangle(
+            const Ray3D& ray, const TrianglePacket* triangles, uint64_t triangleCount, PacketHits* hits,
+            InstructionSet instructionSet = SupportedInstructionSet());
+
+        // Many rays against one box
+        static void RayAABB(
+            const RayPacket* rays, uint64_t rayCount, const AxisAlignedBox3D& box, PacketHits* hits,
+            InstructionSet instructionSet = SupportedInstructionSet());
+    };
+
+}
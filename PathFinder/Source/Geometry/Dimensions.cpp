@@ -18,12 +18,12 @@ namespace Geometry
         return std::max(std::max(Height, Width), Depth);
     }
 
-    bool Dimensions::operator!=(const Dimensions& rhs)
+    bool Dimensions::operator!=(const Dimensions& rhs) const
     {
         return !(*this == rhs); 
     }
 
-    bool Dimensions::operator==(const Dimensions &rhs)
+    bool Dimensions::operator==(const Dimensions &rhs) const
     {
         return Width == rhs.Width && Height == rhs.Height && Depth == rhs.Depth;
     }
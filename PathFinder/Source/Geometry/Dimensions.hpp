@@ -15,8 +15,8 @@ namespace Geometry
 
         uint64_t LargestDimension() const;
 
-        bool operator==(const Dimensions &rhs);
-        bool operator!=(const Dimensions &rhs);
+        bool operator==(const Dimensions &rhs) const;
+        bool operator!=(const Dimensions &rhs) const;
 
         Dimensions XMultiplied(float m) const;
         Dimensions XYMultiplied(float m) const;
@@ -25,7 +25,20 @@ namespace Geometry {
 
     glm::mat4 Transformation::ModelMatrix() const 
     {
-        return glm::translate(Translation) * glm::mat4_cast(Rotation) * glm::scale(Scale);
+        // Translate * rotate * scale composed without matrix products, which leave negative zeros
+        // that depend on signs of components. Adding zero makes all zero elements positive,
+        // so batched composition can reproduce the matrix bit for bit.
+        glm::mat4 rotation = glm::mat4_cast(Rotation);
+        glm::mat4 model{ 1.0f };
+
+        for (int column = 0; column < 3; ++column)
+        {
+            model[column] = glm::vec4{ glm::vec3{ rotation[column] } * Scale[column] + 0.0f, 0.0f };
+        }
+
+        model[3] = glm::vec4{ Translation + 0.0f, 1.0f };
+
+        return model;
     }
 
     glm::mat4 Transformation::ScaleMatrix() const
@@ -0,0 +1,242 @@
+#include "TransformationBatch.hpp"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define TRANSFORMATION_BATCH_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace Geometry
+{
+
+    namespace
+    {
+
+        float* MatrixAt(const TransformationBatch::MatrixOutput& output, uint64_t outputIndex)
+        {
+            return reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(output.First) + outputIndex * output.Stride);
+        }
+
+    }
+
+    TransformationBatch::InstructionSet TransformationBatch::SupportedInstructionSet()
+    {
+#ifdef TRANSFORMATION_BATCH_SSE
+        return InstructionSet::SSE;
+#else
+        return InstructionSet::Scalar;
+#endif
+    }
+
+    void TransformationBatch::Resize(uint64_t count)
+    {
+        uint64_t oldCount = mCount;
+
+        mCount = count;
+        mPackets.resize((count + LaneCount - 1) / LaneCount);
+
+        for (uint64_t index = oldCount; index < count; ++index)
+        {
+            Set(index, Transformation{});
+        }
+    }
+
+    void TransformationBatch::Set(uint64_t index, const Transformation& transformation)
+    {
+        Packet& packet = mPackets[index / LaneCount];
+        uint64_t lane = index % LaneCount;
+
+        packet.TranslationX[lane] = transformation.Translation.x;
+        packet.TranslationY[lane] = transformation.Translation.y;
+        packet.TranslationZ[lane] = transformation.Translation.z;
+        packet.RotationX[lane] = transformation.Rotation.x;
+        packet.RotationY[lane] = transformation.Rotation.y;
+        packet.RotationZ[lane] = transformation.Rotation.z;
+        packet.RotationW[lane] = transformation.Rotation.w;
+        packet.ScaleX[lane] = transformation.Scale.x;
+        packet.ScaleY[lane] = transformation.Scale.y;
+        packet.ScaleZ[lane] = transformation.Scale.z;
+    }
+
+    Transformation TransformationBatch::Get(uint64_t index) const
+    {
+        const Packet& packet = mPackets[index / LaneCount];
+        uint64_t lane = index % LaneCount;
+
+        return Transformation{
+            glm::vec3{ packet.ScaleX[lane], packet.ScaleY[lane], packet.ScaleZ[lane] },
+            glm::vec3{ packet.TranslationX[lane], packet.TranslationY[lane], packet.TranslationZ[lane] },
+            glm::quat{ packet.RotationW[lane], packet.RotationX[lane], packet.RotationY[lane], packet.RotationZ[lane] }
+        };
+    }
+
+    void TransformationBatch::ComposeMatrices(
+        uint64_t first, uint64_t count, const MatrixOutput& modelMatrices, const MatrixOutput& normalMatrices, InstructionSet instructionSet) const
+    {
+        assert_format(first + count <= Count(), "Transformation range is out of bounds");
+
+        uint64_t composedCount = 0;
+
+#ifdef TRANSFORMATION_BATCH_SSE
+        if (instructionSet == InstructionSet::SSE)
+        {
+            // Lanes before the first whole packet
+            for (; composedCount < count && (first + composedCount) % LaneCount != 0; ++composedCount)
+            {
+                ComposeScalar(first + composedCount, modelMatrices, normalMatrices, composedCount);
+            }
+
+            for (; composedCount + LaneCount <= count; composedCount += LaneCount)
+            {
+                ComposeSSE((first + composedCount) / LaneCount, modelMatrices, normalMatrices, composedCount);
+            }
+        }
+#else
+        assert_format(instructionSet == InstructionSet::Scalar, "Instruction set is not available in this build");
+#endif
+
+        // Lanes after the last whole packet
+        for (; composedCount < count; ++composedCount)
+        {
+            ComposeScalar(first + composedCount, modelMatrices, normalMatrices, composedCount);
+        }
+    }
+
+    void TransformationBatch::ComposeScalar(uint64_t index, const MatrixOutput& modelMatrices, const MatrixOutput& normalMatrices, uint64_t outputIndex) const
+    {
+        const Packet& packet = mPackets[index / LaneCount];
+        uint64_t lane = index % LaneCount;
+
+        float x = packet.RotationX[lane], y = packet.RotationY[lane], z = packet.RotationZ[lane], w = packet.RotationW[lane];
+        float t[3] = { packet.TranslationX[lane], packet.TranslationY[lane], packet.TranslationZ[lane] };
+        float s[3] = { packet.ScaleX[lane], packet.ScaleY[lane], packet.ScaleZ[lane] };
+
+        float xx = x * x, yy = y * y, zz = z * z;
+        float xy = x * y, xz = x * z, yz = y * z;
+        float wx = w * x, wy = w * y, wz = w * z;
+
+        // Columns of rotation matrix, same expressions as glm::mat4_cast
+        float r[3][3] = {
+            { 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy) },
+            { 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx) },
+            { 2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy) }
+        };
+
+        if (modelMatrices.First)
+        {
+            float* m = MatrixAt(modelMatrices, outputIndex);
+
+            // Adding zero turns negative zeros into positive ones, as Transformation::ModelMatrix() does
+            for (int column = 0; column < 3; ++column)
+            {
+                m[column * 4 + 0] = r[column][0] * s[column] + 0.0f;
+                m[column * 4 + 1] = r[column][1] * s[column] + 0.0f;
+                m[column * 4 + 2] = r[column][2] * s[column] + 0.0f;
+                m[column * 4 + 3] = 0.0f;
+            }
+
+            m[12] = t[0] + 0.0f; m[13] = t[1] + 0.0f; m[14] = t[2] + 0.0f; m[15] = 1.0f;
+        }
+
+        if (normalMatrices.First)
+        {
+            float* n = MatrixAt(normalMatrices, outputIndex);
+
+            // Transposed inverse of T * R * S is T^-T * R * S^-1:
+            // rotation columns divided by scale and negated translation in the bottom row
+            for (int column = 0; column < 3; ++column)
+            {
+                float inverseScale = 1.0f / s[column];
+                float translationProjection = (r[column][0] * t[0] + r[column][1] * t[1]) + r[column][2] * t[2];
+
+                n[column * 4 + 0] = r[column][0] * inverseScale;
+                n[column * 4 + 1] = r[column][1] * inverseScale;
+                n[column * 4 + 2] = r[column][2] * inverseScale;
+                n[column * 4 + 3] = -(translationProjection * inverseScale);
+            }
+
+            n[12] = 0.0f; n[13] = 0.0f; n[14] = 0.0f; n[15] = 1.0f;
+        }
+    }
+
+    void TransformationBatch::ComposeSSE(uint64_t packetIndex, const MatrixOutput& modelMatrices, const MatrixOutput& normalMatrices, uint64_t outputIndex) const
+    {
+#ifdef TRANSFORMATION_BATCH_SSE
+        const Packet& packet = mPackets[packetIndex];
+
+        __m128 x = _mm_load_ps(packet.RotationX);
+        __m128 y = _mm_load_ps(packet.RotationY);
+        __m128 z = _mm_load_ps(packet.RotationZ);
+        __m128 w = _mm_load_ps(packet.RotationW);
+        __m128 t[3] = { _mm_load_ps(packet.TranslationX), _mm_load_ps(packet.TranslationY), _mm_load_ps(packet.TranslationZ) };
+        __m128 s[3] = { _mm_load_ps(packet.ScaleX), _mm_load_ps(packet.ScaleY), _mm_load_ps(packet.ScaleZ) };
+
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 two = _mm_set1_ps(2.0f);
+        __m128 zero = _mm_setzero_ps();
+        __m128 signBit = _mm_set1_ps(-0.0f);
+
+        __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+        __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+        __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+        __m128 r[3][3] = {
+            { _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), _mm_mul_ps(two, _mm_add_ps(xy, wz)), _mm_mul_ps(two, _mm_sub_ps(xz, wy)) },
+            { _mm_mul_ps(two, _mm_sub_ps(xy, wz)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), _mm_mul_ps(two, _mm_add_ps(yz, wx)) },
+            { _mm_mul_ps(two, _mm_add_ps(xz, wy)), _mm_mul_ps(two, _mm_sub_ps(yz, wx)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))) }
+        };
+
+        // Registers hold one matrix element of 4 transformations.
+        // Transposition turns them into matrix columns of each transformation.
+        if (modelMatrices.First)
+        {
+            __m128 columns[4][4];
+
+            for (int column = 0; column < 3; ++column)
+            {
+                columns[column][0] = _mm_add_ps(_mm_mul_ps(r[column][0], s[column]), zero);
+                columns[column][1] = _mm_add_ps(_mm_mul_ps(r[column][1], s[column]), zero);
+                columns[column][2] = _mm_add_ps(_mm_mul_ps(r[column][2], s[column]), zero);
+                columns[column][3] = zero;
+                _MM_TRANSPOSE4_PS(columns[column][0], columns[column][1], columns[column][2], columns[column][3]);
+            }
+
+            columns[3][0] = _mm_add_ps(t[0], zero); columns[3][1] = _mm_add_ps(t[1], zero); columns[3][2] = _mm_add_ps(t[2], zero); columns[3][3] = one;
+            _MM_TRANSPOSE4_PS(columns[3][0], columns[3][1], columns[3][2], columns[3][3]);
+
+            for (uint64_t lane = 0; lane < LaneCount; ++lane)
+            {
+                float* m = MatrixAt(modelMatrices, outputIndex + lane);
+                for (int column = 0; column < 4; ++column) _mm_storeu_ps(m + column * 4, columns[column][lane]);
+            }
+        }
+
+        if (normalMatrices.First)
+        {
+            __m128 columns[3][4];
+
+            for (int column = 0; column < 3; ++column)
+            {
+                __m128 inverseScale = _mm_div_ps(one, s[column]);
+                __m128 translationProjection = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(r[column][0], t[0]), _mm_mul_ps(r[column][1], t[1])), _mm_mul_ps(r[column][2], t[2]));
+
+                columns[column][0] = _mm_mul_ps(r[column][0], inverseScale);
+                columns[column][1] = _mm_mul_ps(r[column][1], inverseScale);
+                columns[column][2] = _mm_mul_ps(r[column][2], inverseScale);
+                columns[column][3] = _mm_xor_ps(_mm_mul_ps(translationProjection, inverseScale), signBit);
+                _MM_TRANSPOSE4_PS(columns[column][0], columns[column][1], columns[column][2], columns[column][3]);
+            }
+
+            __m128 lastColumn = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+            for (uint64_t lane = 0; lane < LaneCount; ++lane)
+            {
+                float* n = MatrixAt(normalMatrices, outputIndex + lane);
+                for (int column = 0; column < 3; ++column) _mm_storeu_ps(n + column * 4, columns[column][lane]);
+                _mm_storeu_ps(n + 12, lastColumn);
+            }
+        }
+#endif
+    }
+
+}
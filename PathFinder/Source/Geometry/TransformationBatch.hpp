@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Transformation.hpp"
+
+#include <glm/mat4x4.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace Geometry
+{
+
+    /// Transformations stored as structure-of-arrays packets of translation, rotation and scale components.
+    /// Model and normal matrices are composed 4 transformations at a time with SSE and can be written
+    /// straight into fields of an array of structures, such as a mapped GPU table, without
+    /// intermediate matrix arrays. Every instruction set executes the same sequence of IEEE operations.
+    class TransformationBatch
+    {
+    public:
+        enum class InstructionSet
+        {
+            Scalar, SSE
+        };
+
+        static const uint64_t LaneCount = 4;
+
+        struct MatrixOutput
+        {
+            // Matrix of the first transformation of a range, null if matrices are not needed
+            glm::mat4* First = nullptr;
+
+            // Distance in bytes between matrices of consecutive transformations
+            uint64_t Stride = sizeof(glm::mat4);
+        };
+
+        struct alignas(16) Packet
+        {
+            float TranslationX[LaneCount];
+            float TranslationY[LaneCount];
+            float TranslationZ[LaneCount];
+            float RotationX[LaneCount];
+            float RotationY[LaneCount];
+            float RotationZ[LaneCount];
+            float RotationW[LaneCount];
+            float ScaleX[LaneCount];
+            float ScaleY[LaneCount];
+            float ScaleZ[LaneCount];
+        };
+
+        static InstructionSet SupportedInstructionSet();
+
+        void Resize(uint64_t count);
+        void Set(uint64_t index, const Transformation& transformation);
+        Transformation Get(uint64_t index) const;
+
+        // Model matrix is bit-identical to Transformation::ModelMatrix().
+        // Normal matrix is derived from components instead of a general matrix inversion, so it matches
+        // Transformation::NormalMatrix() only up to rounding, within ~3e-5 relative error per element.
+        // Disjoint ranges can be composed concurrently.
+        void ComposeMatrices(
+            uint64_t first, uint64_t count, const MatrixOutput& modelMatrices, const MatrixOutput& normalMatrices,
+            InstructionSet instructionSet = SupportedInstructionSet()) const;
+
+    private:
+        void ComposeScalar(uint64_t index, const MatrixOutput& modelMatrices, const MatrixOutput& normalMatrices, uint64_t outputIndex) const;
+        void ComposeSSE(uint64_t packetIndex, const MatrixOutput& modelMatrices, const MatrixOutput& normalMatrices, uint64_t outputIndex) const;
+
+        // Components of one transformation share a packet, so setting it writes to adjacent cache lines instead of ten arrays
+        std::vector<Packet> mPackets;
+        uint64_t mCount = 0;
+
+    public:
+        inline uint64_t Count() const { return mCount; }
+    };
+
+}
@@ -70,7 +70,7 @@ namespace HAL
         mList->ResourceBarrier((UINT)collection.BarrierCount(), collection.D3DBarriers());
     }
 
-    void CopyCommandListBase::CopyResource(const Resource& source, Resource& destination)
+    void CopyCommandListBase::CopyResource(const Resource& source, const Resource& destination)
     {
         mList->CopyResource(destination.D3DResource(), source.D3DResource());
     }
@@ -68,7 +68,7 @@ namespace HAL
 
         void InsertBarrier(const ResourceBarrier& barrier);
         void InsertBarriers(const ResourceBarrierCollection& collection);
-        void CopyResource(const Resource& source, Resource& destination);
+        void CopyResource(const Resource& source, const Resource& destination);
 
         void CopyBufferRegion(
             const Buffer& source, const Buffer& destination,
@@ -52,6 +52,7 @@ namespace HAL
 
     public:
         inline ID3D12DescriptorHeap* D3DHeap() const { return mHeap.Get(); }
+        inline auto IncrementSize() const { return mIncrementSize; }
     };
 
 
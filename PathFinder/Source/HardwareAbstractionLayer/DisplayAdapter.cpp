@@ -7,6 +7,21 @@ namespace HAL
     DisplayAdapter::DisplayAdapter(const Microsoft::WRL::ComPtr<IDXGIAdapter1>& adapter) 
         : mAdapter(adapter) 
     {
+        DXGI_ADAPTER_DESC1 desc{};
+        ThrowIfFailed(mAdapter->GetDesc1(&desc));
+
+        mVendorID = desc.VendorId;
+        mDeviceID = desc.DeviceId;
+        mDedicatedVideoMemory = desc.DedicatedVideoMemory;
+
+        // User mode driver version, the only reliable way to get it through DXGI
+        LARGE_INTEGER driverVersion{};
+
+        if (SUCCEEDED(mAdapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion)))
+        {
+            mDriverVersion = driverVersion.QuadPart;
+        }
+
         RefetchDisplaysIfNeeded();
     }
 
@@ -19,10 +19,18 @@ namespace HAL
         Microsoft::WRL::ComPtr<IDXGIFactory4> mDXGIFactory;
         Microsoft::WRL::ComPtr<IDXGIAdapter1> mAdapter;
         std::vector<Display> mConnectedDisplays;
+        uint32_t mVendorID = 0;
+        uint32_t mDeviceID = 0;
+        uint64_t mDriverVersion = 0;
+        uint64_t mDedicatedVideoMemory = 0;
 
     public:
         inline const auto D3DAdapter() const { return mAdapter.Get(); }
         inline const auto& Displays() const { return mConnectedDisplays; }
+        inline auto VendorID() const { return mVendorID; }
+        inline auto DeviceID() const { return mDeviceID; }
+        inline auto DriverVersion() const { return mDriverVersion; }
+        inline auto DedicatedVideoMemory() const { return mDedicatedVideoMemory; }
     };
 }
 
@@ -24,9 +24,157 @@ namespace HAL
         mDebugName = name;
     }
 
+    void PipelineState::SetCachedBlob(const void* blob, uint64_t size)
+    {
+        mCachedBlob.pCachedBlob = blob;
+        mCachedBlob.CachedBlobSizeInBytes = size;
+    }
+
+    std::vector<uint8_t> PipelineState::CachedBlob() const
+    {
+        assert_format(mState, "State must be compiled to retrieve its blob");
+
+        Microsoft::WRL::ComPtr<ID3DBlob> blob;
+        ThrowIfFailed(mState->GetCachedBlob(&blob));
+
+        const uint8_t* blobData = static_cast<const uint8_t*>(blob->GetBufferPointer());
+        return { blobData, blobData + blob->GetBufferSize() };
+    }
+
+    void PipelineState::AppendRootSignatureDescription(std::vector<uint8_t>& bytes) const
+    {
+        // Serialized signature describes its layout regardless of where signature object lives
+        ID3DBlob* signatureBlob = mRootSignature ? mRootSignature->SerializedSignature() : nullptr;
+        assert_format(!mRootSignature || signatureBlob, "Root signature must be compiled before pipeline state description is serialized");
+
+        if (signatureBlob)
+        {
+            AppendBytes(bytes, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize());
+        }
+    }
+
+    void PipelineState::AppendBytes(std::vector<uint8_t>& bytes, const void* data, uint64_t size)
+    {
+        const uint8_t* begin = static_cast<const uint8_t*>(data);
+        bytes.insert(bytes.end(), begin, begin + size);
+    }
+
 
 
     void GraphicsPipelineState::Compile()
+    {
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = D3DDescription();
+
+        CreateStateWithCachedBlobFallback([this, &desc](const D3D12_CACHED_PIPELINE_STATE& cachedBlob)
+        {
+            desc.CachedPSO = cachedBlob;
+            return mDevice->D3DDevice()->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&mState));
+        });
+
+        mState->SetName(StringToWString(mDebugName).c_str());
+    }
+
+    std::vector<uint8_t> GraphicsPipelineState::SerializeDescription() const
+    {
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = D3DDescription();
+        std::vector<uint8_t> bytes;
+
+        // Description structures contain padding and pointers, so only their values are appended.
+        // Shader bytecode is referenced by pointer and is hashed separately through ShaderBinaries().
+        AppendRootSignatureDescription(bytes);
+
+        const D3D12_BLEND_DESC& blend = desc.BlendState;
+        AppendValue(bytes, blend.AlphaToCoverageEnable);
+        AppendValue(bytes, blend.IndependentBlendEnable);
+
+        for (const D3D12_RENDER_TARGET_BLEND_DESC& rtBlend : blend.RenderTarget)
+        {
+            AppendValue(bytes, rtBlend.BlendEnable);
+            AppendValue(bytes, rtBlend.LogicOpEnable);
+            AppendValue(bytes, rtBlend.SrcBlend);
+            AppendValue(bytes, rtBlend.DestBlend);
+            AppendValue(bytes, rtBlend.BlendOp);
+            AppendValue(bytes, rtBlend.SrcBlendAlpha);
+            AppendValue(bytes, rtBlend.DestBlendAlpha);
+            AppendValue(bytes, rtBlend.BlendOpAlpha);
+            AppendValue(bytes, rtBlend.LogicOp);
+            AppendValue(bytes, rtBlend.RenderTargetWriteMask);
+        }
+
+        const D3D12_RASTERIZER_DESC& rasterizer = desc.RasterizerState;
+        AppendValue(bytes, rasterizer.FillMode);
+        AppendValue(bytes, rasterizer.CullMode);
+        AppendValue(bytes, rasterizer.FrontCounterClockwise);
+        AppendValue(bytes, rasterizer.DepthBias);
+        AppendValue(bytes, rasterizer.DepthBiasClamp);
+        AppendValue(bytes, rasterizer.SlopeScaledDepthBias);
+        AppendValue(bytes, rasterizer.DepthClipEnable);
+        AppendValue(bytes, rasterizer.MultisampleEnable);
+        AppendValue(bytes, rasterizer.AntialiasedLineEnable);
+        AppendValue(bytes, rasterizer.ForcedSampleCount);
+        AppendValue(bytes, rasterizer.ConservativeRaster);
+
+        auto appendStencilOp = [&bytes](const D3D12_DEPTH_STENCILOP_DESC& op)
+        {
+            AppendValue(bytes, op.StencilFailOp);
+            AppendValue(bytes, op.StencilDepthFailOp);
+            AppendValue(bytes, op.StencilPassOp);
+            AppendValue(bytes, op.StencilFunc);
+        };
+
+        const D3D12_DEPTH_STENCIL_DESC& depthStencil = desc.DepthStencilState;
+        AppendValue(bytes, depthStencil.DepthEnable);
+        AppendValue(bytes, depthStencil.DepthWriteMask);
+        AppendValue(bytes, depthStencil.DepthFunc);
+        AppendValue(bytes, depthStencil.StencilEnable);
+        AppendValue(bytes, depthStencil.StencilReadMask);
+        AppendValue(bytes, depthStencil.StencilWriteMask);
+        appendStencilOp(depthStencil.FrontFace);
+        appendStencilOp(depthStencil.BackFace);
+
+        AppendValue(bytes, desc.InputLayout.NumElements);
+
+        for (uint32_t elementIdx = 0; elementIdx < desc.InputLayout.NumElements; ++elementIdx)
+        {
+            const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[elementIdx];
+            std::string semanticName = element.SemanticName;
+
+            AppendValue(bytes, semanticName.size());
+            AppendBytes(bytes, semanticName.data(), semanticName.size());
+            AppendValue(bytes, element.SemanticIndex);
+            AppendValue(bytes, element.Format);
+            AppendValue(bytes, element.InputSlot);
+            AppendValue(bytes, element.AlignedByteOffset);
+            AppendValue(bytes, element.InputSlotClass);
+            AppendValue(bytes, element.InstanceDataStepRate);
+        }
+
+        AppendValue(bytes, desc.IBStripCutValue);
+        AppendValue(bytes, desc.PrimitiveTopologyType);
+        AppendValue(bytes, desc.NumRenderTargets);
+
+        for (DXGI_FORMAT format : desc.RTVFormats)
+        {
+            AppendValue(bytes, format);
+        }
+
+        AppendValue(bytes, desc.DSVFormat);
+        AppendValue(bytes, desc.SampleDesc.Count);
+        AppendValue(bytes, desc.SampleDesc.Quality);
+        AppendValue(bytes, desc.SampleMask);
+        AppendValue(bytes, desc.NodeMask);
+        AppendValue(bytes, desc.Flags);
+
+        return bytes;
+    }
+
+    std::vector<D3D12_SHADER_BYTECODE> GraphicsPipelineState::ShaderBinaries() const
+    {
+        auto bytecode = [](const Shader* shader) { return shader ? shader->D3DBytecode() : D3D12_SHADER_BYTECODE{}; };
+        return { bytecode(mVertexShader), bytecode(mHullShader), bytecode(mDomainShader), bytecode(mGeometryShader), bytecode(mPixelShader) };
+    }
+
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC GraphicsPipelineState::D3DDescription() const
     {
         D3D12_GRAPHICS_PIPELINE_STATE_DESC desc{};
 
@@ -66,9 +214,7 @@ namespace HAL
 #if defined(DEBUG) || defined(_DEBUG) 
         //desc.Flags = D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG;
 #endif
-        ThrowIfFailed(mDevice->D3DDevice()->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&mState)));
-
-        mState->SetName(StringToWString(mDebugName).c_str());
+        return desc;
     }
 
     GraphicsPipelineState GraphicsPipelineState::Clone() const
@@ -91,6 +237,37 @@ namespace HAL
 
 
     void ComputePipelineState::Compile()
+    {
+        D3D12_COMPUTE_PIPELINE_STATE_DESC desc = D3DDescription();
+
+        CreateStateWithCachedBlobFallback([this, &desc](const D3D12_CACHED_PIPELINE_STATE& cachedBlob)
+        {
+            desc.CachedPSO = cachedBlob;
+            return mDevice->D3DDevice()->CreateComputePipelineState(&desc, IID_PPV_ARGS(&mState));
+        });
+
+        mState->SetName(StringToWString(mDebugName).c_str());
+    }
+
+    std::vector<uint8_t> ComputePipelineState::SerializeDescription() const
+    {
+        D3D12_COMPUTE_PIPELINE_STATE_DESC desc = D3DDescription();
+        std::vector<uint8_t> bytes;
+
+        // Compute shader bytecode is hashed separately through ShaderBinaries()
+        AppendRootSignatureDescription(bytes);
+        AppendValue(bytes, desc.NodeMask);
+        AppendValue(bytes, desc.Flags);
+
+        return bytes;
+    }
+
+    std::vector<D3D12_SHADER_BYTECODE> ComputePipelineState::ShaderBinaries() const
+    {
+        return { mComputeShader->D3DBytecode() };
+    }
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC ComputePipelineState::D3DDescription() const
     {
         D3D12_COMPUTE_PIPELINE_STATE_DESC desc{};
 
@@ -101,9 +278,7 @@ namespace HAL
 #if defined(DEBUG) || defined(_DEBUG) 
         //desc.Flags = D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG;
 #endif
-        ThrowIfFailed(mDevice->D3DDevice()->CreateComputePipelineState(&desc, IID_PPV_ARGS(&mState)));
-
-        mState->SetName(StringToWString(mDebugName).c_str());
+        return desc;
     }
 
     ComputePipelineState ComputePipelineState::Clone() const
@@ -476,7 +651,9 @@ namespace HAL
 
     void RayTracingPipelineState::BuildShaderTable()
     {
-        mShaderTable.Clear();
+        // Records are rebuilt in the same order on every compilation, so after
+        // shader reload only identifiers that actually changed are patched
+        mShaderTable.BeginUpdate();
 
         mShaderTable.SetRayGenerationShader(GetShaderIdentifier(mRayGenerationExport->ExportName()), mRayGenerationShader.LocalRootSignature);
 
@@ -497,6 +674,8 @@ namespace HAL
 
             mShaderTable.AddRayTracingHitGroupShaders(GetShaderIdentifier(hitGroup.ExportName()), hgShaders.LocalRootSignature);
         }
+
+        mShaderTable.EndUpdate();
     }
 
 }
@@ -16,8 +16,11 @@
 #include "RayTracingPipelineConfig.hpp"
 #include "RayTracingShaderConfig.hpp"
 #include "ShaderTable.hpp"
+#include "Utils.h"
 
 #include <variant>
+#include <type_traits>
+#include <vector>
 #include <unordered_map>
 
 namespace HAL
@@ -33,15 +36,44 @@ namespace HAL
         virtual void Compile() = 0;
         virtual void SetDebugName(const std::string& name) override;
 
+        // Flat representation of everything that affects compilation except shader binaries.
+        // Root signature must be compiled beforehand.
+        virtual std::vector<uint8_t> SerializeDescription() const = 0;
+
+        // Shader binaries in a fixed stage order, missing stages are represented by empty bytecode
+        virtual std::vector<D3D12_SHADER_BYTECODE> ShaderBinaries() const = 0;
+
+        // Blob produced by a previous compilation of an identical state, possibly by another process.
+        // Used by the next Compile() call only and must stay alive until then.
+        void SetCachedBlob(const void* blob, uint64_t size);
+
+        // Driver-specific representation of compiled state that can be persisted between runs
+        std::vector<uint8_t> CachedBlob() const;
+
     protected:
+        // Creates state using cached blob, if any, and falls back to regular compilation
+        // if driver rejects the blob, which is expected after driver updates
+        template <class CreateFunction>
+        void CreateStateWithCachedBlobFallback(const CreateFunction& createState);
+
+        void AppendRootSignatureDescription(std::vector<uint8_t>& bytes) const;
+        static void AppendBytes(std::vector<uint8_t>& bytes, const void* data, uint64_t size);
+
+        // Scalars only: structures may contain padding with undefined contents
+        template <class T>
+        static void AppendValue(std::vector<uint8_t>& bytes, T value);
+
         Microsoft::WRL::ComPtr<ID3D12PipelineState> mState;
         const RootSignature* mRootSignature = nullptr;
         const Device* mDevice;
         std::string mDebugName;
+        D3D12_CACHED_PIPELINE_STATE mCachedBlob{};
+        bool mIsCompiledFromCachedBlob = false;
 
     public:
         inline ID3D12PipelineState* D3DCompiledState() const { return mState.Get(); }
         inline const RootSignature* GetRootSignature() const { return mRootSignature; }
+        inline bool IsCompiledFromCachedBlob() const { return mIsCompiledFromCachedBlob; }
 
         inline void SetRootSignature(const RootSignature* signature) { mRootSignature = signature; }
     };
@@ -58,6 +90,8 @@ namespace HAL
 
         void Compile() override;
         void ReplaceShader(const Shader* oldShader, const Shader* newShader) override;
+        std::vector<uint8_t> SerializeDescription() const override;
+        std::vector<D3D12_SHADER_BYTECODE> ShaderBinaries() const override;
 
         GraphicsPipelineState Clone() const;
 
@@ -103,11 +137,13 @@ namespace HAL
         inline const PrimitiveTopology& GetPrimitiveTopology() const { return mPrimitiveTopology; }
 
     private:
-        const Shader* mVertexShader;
-        const Shader* mPixelShader;
-        const Shader* mDomainShader;
-        const Shader* mHullShader;
-        const Shader* mGeometryShader;
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC D3DDescription() const;
+
+        const Shader* mVertexShader = nullptr;
+        const Shader* mPixelShader = nullptr;
+        const Shader* mDomainShader = nullptr;
+        const Shader* mHullShader = nullptr;
+        const Shader* mGeometryShader = nullptr;
         BlendState mBlendState;
         RasterizerState mRasterizerState;
         DepthStencilState mDepthStencilState;
@@ -125,17 +161,47 @@ namespace HAL
 
         virtual void Compile() override;
         void ReplaceShader(const HAL::Shader* oldShader, const HAL::Shader* newShader) override;
+        std::vector<uint8_t> SerializeDescription() const override;
+        std::vector<D3D12_SHADER_BYTECODE> ShaderBinaries() const override;
 
         inline void SetComputeShader(const Shader* computeShader) { mComputeShader = computeShader; }
 
         ComputePipelineState Clone() const;
 
     private:
-        const Shader* mComputeShader;
+        D3D12_COMPUTE_PIPELINE_STATE_DESC D3DDescription() const;
+
+        const Shader* mComputeShader = nullptr;
     };
 
 
 
+    template <class T>
+    void PipelineState::AppendValue(std::vector<uint8_t>& bytes, T value)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Only scalar values can be appended");
+        AppendBytes(bytes, &value, sizeof(value));
+    }
+
+    template <class CreateFunction>
+    void PipelineState::CreateStateWithCachedBlobFallback(const CreateFunction& createState)
+    {
+        HRESULT result = createState(mCachedBlob);
+        mIsCompiledFromCachedBlob = SUCCEEDED(result) && mCachedBlob.pCachedBlob != nullptr;
+
+        if (FAILED(result) && mCachedBlob.pCachedBlob != nullptr)
+        {
+            result = createState(D3D12_CACHED_PIPELINE_STATE{});
+        }
+
+        ThrowIfFailed(result);
+
+        // Blob memory is not owned by the state
+        mCachedBlob = {};
+    }
+
+
+
     class RayTracingPipelineState : public GraphicAPIObject
     {
     public:
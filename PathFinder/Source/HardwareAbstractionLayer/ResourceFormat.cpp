@@ -67,6 +67,13 @@ namespace HAL
         return mipDimensions;
     }
 
+    bool TextureProperties::operator==(const TextureProperties& other) const
+    {
+        return Format == other.Format && Kind == other.Kind && Dimensions == other.Dimensions &&
+            OptimizedClearValue == other.OptimizedClearValue && InitialStateMask == other.InitialStateMask &&
+            ExpectedStateMask == other.ExpectedStateMask && MipCount == other.MipCount;
+    }
+
 
 
     ResourceFormat::ResourceFormat(const Device* device, const TextureProperties& textureProperties)
@@ -225,6 +232,8 @@ namespace HAL
         case ColorFormat::RGBA8_Usigned_Norm:   return DXGI_FORMAT_R8G8B8A8_UNORM;
         case ColorFormat::RGBA16_Unsigned_Norm: return DXGI_FORMAT_R16G16B16A16_UNORM;
 
+        case ColorFormat::RGBA16_Signed_Norm: return DXGI_FORMAT_R16G16B16A16_SNORM;
+
         case ColorFormat::BGRA8_Unsigned_Norm: return DXGI_FORMAT_B8G8R8A8_UNORM;
 
         case ColorFormat::R8_Signed:         return DXGI_FORMAT_R8_SINT;
@@ -335,6 +344,8 @@ namespace HAL
         case DXGI_FORMAT_R8G8B8A8_UNORM: return ColorFormat::RGBA8_Usigned_Norm;
         case DXGI_FORMAT_R16G16B16A16_UNORM: return ColorFormat::RGBA16_Unsigned_Norm;
 
+        case DXGI_FORMAT_R16G16B16A16_SNORM: return ColorFormat::RGBA16_Signed_Norm;
+
         case DXGI_FORMAT_R8_SINT: return ColorFormat::R8_Signed;
         case DXGI_FORMAT_R8G8_SINT: return ColorFormat::RG8_Signed;
         case DXGI_FORMAT_R8G8B8A8_SINT: return ColorFormat::RGBA8_Signed;
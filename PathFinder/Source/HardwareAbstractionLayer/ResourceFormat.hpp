@@ -23,6 +23,8 @@ namespace HAL
     {
         float Depth;
         uint8_t Stencil;
+
+        inline bool operator==(const DepthStencilClearValue& other) const { return Depth == other.Depth && Stencil == other.Stencil; }
     };
 
     using ClearValue = std::variant<ColorClearValue, DepthStencilClearValue>;
@@ -38,6 +40,8 @@ namespace HAL
     {
         R8_Unsigned_Norm, RG8_Usigned_Norm, RGBA8_Usigned_Norm, RGBA16_Unsigned_Norm,
 
+        RGBA16_Signed_Norm,
+
         BGRA8_Unsigned_Norm,
 
         R8_Signed, RG8_Signed, RGBA8_Signed,
@@ -108,6 +112,8 @@ namespace HAL
             ResourceState initialStateMask, uint32_t mipCount = 1);
 
         Geometry::Dimensions MipSize(uint8_t mip) const;
+
+        bool operator==(const TextureProperties& other) const;
     };
 
 
@@ -121,6 +127,11 @@ namespace HAL
 
         BufferProperties() = delete;
 
+        inline bool operator==(const BufferProperties& other) const
+        {
+            return Size == other.Size && Stride == other.Stride && InitialStateMask == other.InitialStateMask && ExpectedStateMask == other.ExpectedStateMask;
+        }
+
         template <class Element = uint8_t>
         static BufferProperties Create(uint64_t capacity, uint64_t elementAlignment = 1, ResourceState initialStates = ResourceState::Common, ResourceState expectedStates = ResourceState::Common);
     };
@@ -2,6 +2,7 @@
 #include "Utils.h"
 
 #include <Foundation/StringUtils.hpp>
+#include <Foundation/MemoryUtils.hpp>
 
 
 namespace HAL
@@ -40,6 +41,7 @@ namespace HAL
     {
         RootSignature newSignature = *this;
         newSignature.mSignature = nullptr;
+        newSignature.mSerializedSignature = nullptr;
         return newSignature;
     }
 
@@ -67,13 +69,13 @@ namespace HAL
         mDesc.NumStaticSamplers = (UINT)mD3DStaticSamplers.size();
         mDesc.pStaticSamplers = mD3DStaticSamplers.data();
 
-        Microsoft::WRL::ComPtr<ID3DBlob> signatureBlob;
+        // Keep serialized signature around, it uniquely identifies signature layout
         Microsoft::WRL::ComPtr<ID3DBlob> errors;
-        ThrowIfFailed(D3D12SerializeRootSignature(&mDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errors));
+        ThrowIfFailed(D3D12SerializeRootSignature(&mDesc, D3D_ROOT_SIGNATURE_VERSION_1, &mSerializedSignature, &errors));
 
         if (errors) OutputDebugStringA((char*)errors->GetBufferPointer());
 
-        ThrowIfFailed(mDevice->D3DDevice()->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(), IID_PPV_ARGS(&mSignature)));
+        ThrowIfFailed(mDevice->D3DDevice()->CreateRootSignature(0, mSerializedSignature->GetBufferPointer(), mSerializedSignature->GetBufferSize(), IID_PPV_ARGS(&mSignature)));
     
         mSignature->SetName(StringToWString(mDebugName).c_str());
     }
@@ -83,6 +85,28 @@ namespace HAL
         return mDescriptorTableParameters.size() + mDescriptorParameters.size() + mConstantParameters.size();
     }
 
+    uint64_t RootSignature::LocalRootArgumentsSizeInBytes() const
+    {
+        // Arguments follow parameter order. Constants are tightly packed 4-byte values,
+        // while descriptor handles and GPU addresses are 8 bytes and must be aligned accordingly.
+        uint64_t size = 0;
+
+        for (const D3D12_ROOT_PARAMETER& d3dParameter : mD3DParameters)
+        {
+            if (d3dParameter.ParameterType == D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS)
+            {
+                size += d3dParameter.Constants.Num32BitValues * sizeof(uint32_t);
+            }
+            else
+            {
+                size = Foundation::MemoryUtils::Align(size, sizeof(D3D12_GPU_VIRTUAL_ADDRESS));
+                size += sizeof(D3D12_GPU_VIRTUAL_ADDRESS);
+            }
+        }
+
+        return size;
+    }
+
     std::optional<RootSignature::ParameterIndex> RootSignature::GetParameterIndex(const RootParameter::LocationInSignature& location) const
     {
         auto it = mParameterIndices.find(location);
@@ -34,6 +34,9 @@ namespace HAL
         void Compile();
         uint16_t ParameterCount() const;
 
+        // Size of arguments in a shader record when signature is used as a local one
+        uint64_t LocalRootArgumentsSizeInBytes() const;
+
         std::optional<ParameterIndex> GetParameterIndex(const RootParameter::LocationInSignature& location) const;
 
         virtual void SetDebugName(const std::string& name) override;
@@ -56,11 +59,13 @@ namespace HAL
 
         D3D12_ROOT_SIGNATURE_DESC mDesc{};
         Microsoft::WRL::ComPtr<ID3D12RootSignature> mSignature;
+        Microsoft::WRL::ComPtr<ID3DBlob> mSerializedSignature;
         const Device* mDevice;
         std::string mDebugName;
 
     public:
         inline ID3D12RootSignature* D3DSignature() const { return mSignature.Get(); }
+        inline ID3DBlob* SerializedSignature() const { return mSerializedSignature.Get(); }
     };
 
 }
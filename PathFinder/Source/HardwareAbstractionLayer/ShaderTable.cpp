@@ -1,7 +1,5 @@
 #include "ShaderTable.hpp"
 
-#include <Foundation/MemoryUtils.hpp>
-
 #include <d3d12.h>
 #include <limits>
 
@@ -11,188 +9,101 @@
 namespace HAL
 {
 
-    ShaderTable::ShaderRecord::ShaderRecord(const ShaderIdentifier& id, const RootSignature* signature, uint64_t size)
-        : ID{ id }, Signature{ signature }, SizeInBytes{ size } {}
+    static_assert(ShaderTableBuilder::ShaderIdentifierSize == D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES, "Shader identifier size mismatch");
+    static_assert(ShaderTableBuilder::RecordAlignment == D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT, "Shader record alignment mismatch");
+    static_assert(ShaderTableBuilder::RegionAlignment == D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT, "Shader table alignment mismatch");
+    static_assert(ShaderTableBuilder::MaxRecordStride == D3D12_RAYTRACING_MAX_SHADER_RECORD_STRIDE, "Shader record stride mismatch");
 
-    void ShaderTable::SetRayGenerationShader(const ShaderIdentifier& id, const RootSignature* localRootSignature)
+    void ShaderTable::BeginUpdate()
     {
-        uint64_t recordSize = sizeof(ShaderIdentifier);
-
-        // Local root signature is optional
-        if (localRootSignature)
-        {
-            // TODO: Implement correct root signature size calculation inside RootSignature itself
-            //mTableSize += localRootSignature->ParameterCount() * sizeof(D3D12_GPU_VIRTUAL_ADDRESS);
-        }
-
-        recordSize = Foundation::MemoryUtils::Align(recordSize, D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT);
+        mBuilder.BeginUpdate();
+    }
 
-        mRayGenShaderRecord = { id, localRootSignature, recordSize };
+    void ShaderTable::SetRayGenerationShader(const ShaderIdentifier& id, const RootSignature* localRootSignature)
+    {
+        mBuilder.AddRecord(ShaderTableBuilder::RecordType::RayGeneration, id.RawData, LocalRootArgumentsSize(localRootSignature));
     }
 
     void ShaderTable::AddRayMissShader(const ShaderIdentifier& id, const RootSignature* localRootSignature)
     {
-        uint64_t recordSize = sizeof(ShaderIdentifier);
-
-        // Local root signature is optional
-        if (localRootSignature)
-        {
-            // TODO: Implement correct root signature size calculation inside RootSignature itself
-            //mTableSize += localRootSignature->ParameterCount() * sizeof(D3D12_GPU_VIRTUAL_ADDRESS);
-        }
-
-        recordSize = Foundation::MemoryUtils::Align(recordSize, D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT);
-
-        mRayMissShaderRecords.emplace_back(id, localRootSignature, recordSize);
-
-        // We need to keep track of the largest shader record for it's stage, because DXR can only 
-        // traverse table shaders of one type with a constant step (stride).
-        // For example, if we have 3 miss shader records of size 40, 30 and 64 bytes, then the
-        // stride should be 64 and all records must be aligned to 64 bytes when uploaded to GPU memory.
-        // Each stage can have it's own stride though.
-        mRayMissRecordStride = std::max(mRayMissRecordStride, recordSize);
+        mBuilder.AddRecord(ShaderTableBuilder::RecordType::Miss, id.RawData, LocalRootArgumentsSize(localRootSignature));
     }
 
     void ShaderTable::AddCallableShader(const ShaderIdentifier& id, const RootSignature* localRootSignature)
     {
-        uint64_t recordSize = sizeof(ShaderIdentifier);
-
-        // Local root signature is optional
-        if (localRootSignature)
-        {
-            // TODO: Implement correct root signature size calculation inside RootSignature itself
-            //mTableSize += localRootSignature->ParameterCount() * sizeof(D3D12_GPU_VIRTUAL_ADDRESS);
-        }
-
-        recordSize = Foundation::MemoryUtils::Align(recordSize, D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT);
-        mCallableShaderRecords.emplace_back(id, localRootSignature, recordSize);
-        mCallableRecordStride = std::max(mCallableRecordStride, recordSize);
+        mBuilder.AddRecord(ShaderTableBuilder::RecordType::Callable, id.RawData, LocalRootArgumentsSize(localRootSignature));
     }
 
     void ShaderTable::AddRayTracingHitGroupShaders(const ShaderIdentifier& hitGroupId, const RootSignature* localRootSignature)
     {
-        uint64_t recordSize = sizeof(ShaderIdentifier);
-
-        if (localRootSignature)
-        {
-            // TODO: Implement correct root signature size calculation inside RootSignature itself
-            //mTableSize += localRootSignature->ParameterCount() * sizeof(D3D12_GPU_VIRTUAL_ADDRESS);
-        }
-
-        recordSize = Foundation::MemoryUtils::Align(recordSize, D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT);
-
-        mRayHitGroupRecords.emplace_back(hitGroupId, localRootSignature, recordSize);
-        mRayHitGroupRecordStride = std::max(mRayHitGroupRecordStride, recordSize);
+        mBuilder.AddRecord(ShaderTableBuilder::RecordType::HitGroup, hitGroupId.RawData, LocalRootArgumentsSize(localRootSignature));
     }
 
-    RayDispatchInfo ShaderTable::UploadToGPUMemory(uint8_t* uploadGPUMemory, const Buffer* gpuTableBuffer)
+    bool ShaderTable::EndUpdate()
     {
-        D3D12_DISPATCH_RAYS_DESC addresses{};
-
-        uint64_t recordAddressOffset = 0;
-
-        assert_format(mRayGenShaderRecord, "Ray Generation shader is mandatory");
-
-        InsertNullRecordsWhereRequired();
-
-        // Upload ray generation table range
-        auto rayGenTableStartFinalAddress = gpuTableBuffer->GPUVirtualAddress() + recordAddressOffset;
-        auto rayGenTableStartUploadAddress = uploadGPUMemory + recordAddressOffset;
-
-        addresses.RayGenerationShaderRecord = { rayGenTableStartFinalAddress, mRayGenShaderRecord->SizeInBytes };
-
-        memcpy(rayGenTableStartUploadAddress, mRayGenShaderRecord->ID.RawData.data(), sizeof(mRayGenShaderRecord->ID.RawData));
-
-        // Move address to Miss Table start and make sure it is aligned properly
-        recordAddressOffset += mRayGenShaderRecord->SizeInBytes;
-        recordAddressOffset = Foundation::MemoryUtils::Align(recordAddressOffset, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
+        return mBuilder.EndUpdate();
+    }
 
-        if (!mRayMissShaderRecords.empty())
-        {
-            // Upload miss shaders table region
-            uint64_t missShaderRegionSize = mRayMissShaderRecords.size() * mRayMissRecordStride;
-            auto missTableStartFinalAddress = gpuTableBuffer->GPUVirtualAddress() + recordAddressOffset;
-            addresses.MissShaderTable = { missTableStartFinalAddress, missShaderRegionSize, mRayMissRecordStride };
-        }
+    void ShaderTable::SetHitGroupLocalRootArguments(uint64_t hitGroupIndex, const void* arguments, uint64_t size)
+    {
+        mBuilder.SetLocalRootArguments(ShaderTableBuilder::RecordType::HitGroup, hitGroupIndex, arguments, size);
+    }
 
-        for (const ShaderRecord& missRecord : mRayMissShaderRecords)
-        {
-            auto missTableUploadAddress = uploadGPUMemory + recordAddressOffset;
-            memcpy(missTableUploadAddress, missRecord.ID.RawData.data(), sizeof(missRecord.ID.RawData));
-            recordAddressOffset += mRayMissRecordStride;
-        }
+    void ShaderTable::UploadToGPUMemory(uint8_t* uploadGPUMemory) const
+    {
+        assert_format(mBuilder.HasLayout(), "Shader table was never built");
 
-        // We're done with miss shaders, address has moved past the last miss shader.
-        // Now make sure it is properly aligned for Hit Group table records start
-        recordAddressOffset = Foundation::MemoryUtils::Align(recordAddressOffset, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
+        memcpy(uploadGPUMemory, mBuilder.Image().data(), mBuilder.Image().size());
+    }
 
-        if (!mRayHitGroupRecords.empty())
-        {
-            // Upload hit groups table region
-            uint64_t hitGroupRegionSize = mRayHitGroupRecords.size() * mRayHitGroupRecordStride;
-            auto hitGroupTableStartFinalAddress = gpuTableBuffer->GPUVirtualAddress() + recordAddressOffset;
-            addresses.HitGroupTable = { hitGroupTableStartFinalAddress, hitGroupRegionSize, mRayHitGroupRecordStride };
-        }
+    std::vector<ShaderTableBuilder::Patch> ShaderTable::ConsumePatches()
+    {
+        return mBuilder.ConsumePatches();
+    }
 
-        for (const ShaderRecord& hitGroupRecord : mRayHitGroupRecords)
+    void ShaderTable::UploadPatchesToGPUMemory(uint8_t* uploadGPUMemory, const std::vector<ShaderTableBuilder::Patch>& patches) const
+    {
+        for (const ShaderTableBuilder::Patch& patch : patches)
         {
-            auto hitGroupTableUploadAddress = uploadGPUMemory + recordAddressOffset;
-            memcpy(hitGroupTableUploadAddress, hitGroupRecord.ID.RawData.data(), sizeof(hitGroupRecord.ID.RawData));
-            recordAddressOffset += mRayHitGroupRecordStride;
+            memcpy(uploadGPUMemory + patch.Offset, mBuilder.Image().data() + patch.Offset, patch.Size);
         }
+    }
 
-        // We're done with hit groups, address has moved past the last hit group shader.
-        // Alight it for callable table records start address
-        recordAddressOffset = Foundation::MemoryUtils::Align(recordAddressOffset, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
+    RayDispatchInfo ShaderTable::GetDispatchInfo(const Buffer* gpuTableBuffer) const
+    {
+        assert_format(mBuilder.HasLayout(), "Shader table was never built");
 
-        if (!mCallableShaderRecords.empty())
-        {
-            uint64_t callableShadersRegionSize = mCallableShaderRecords.size() * mCallableRecordStride;
-            auto callableTableStartFinalAddress = gpuTableBuffer->GPUVirtualAddress() + recordAddressOffset;
-            addresses.CallableShaderTable = { callableTableStartFinalAddress, callableShadersRegionSize, mCallableRecordStride };
-        }
+        const ShaderTableBuilder::Layout& layout = mBuilder.GetLayout();
+        D3D12_GPU_VIRTUAL_ADDRESS tableAddress = gpuTableBuffer->GPUVirtualAddress();
 
-        for (const ShaderRecord& callableRecord : mCallableShaderRecords)
-        {
-            auto callableTableUploadAddress = uploadGPUMemory + recordAddressOffset;
-            memcpy(callableTableUploadAddress, callableRecord.ID.RawData.data(), sizeof(callableRecord.ID.RawData));
-            recordAddressOffset += mCallableRecordStride;
-        }
+        const ShaderTableBuilder::Region& rayGenRegion = layout.RegionOf(ShaderTableBuilder::RecordType::RayGeneration);
+        const ShaderTableBuilder::Region& missRegion = layout.RegionOf(ShaderTableBuilder::RecordType::Miss);
+        const ShaderTableBuilder::Region& hitGroupRegion = layout.RegionOf(ShaderTableBuilder::RecordType::HitGroup);
+        const ShaderTableBuilder::Region& callableRegion = layout.RegionOf(ShaderTableBuilder::RecordType::Callable);
 
-        mGPUTable = gpuTableBuffer;
+        D3D12_DISPATCH_RAYS_DESC addresses{};
+        addresses.RayGenerationShaderRecord = { tableAddress + rayGenRegion.Offset, rayGenRegion.Stride };
+        addresses.MissShaderTable = { tableAddress + missRegion.Offset, missRegion.SizeInBytes(), missRegion.Stride };
+        addresses.HitGroupTable = { tableAddress + hitGroupRegion.Offset, hitGroupRegion.SizeInBytes(), hitGroupRegion.Stride };
+        addresses.CallableShaderTable = { tableAddress + callableRegion.Offset, callableRegion.SizeInBytes(), callableRegion.Stride };
 
         return RayDispatchInfo{ addresses };
     }
 
     void ShaderTable::Clear()
     {
-        mRayGenShaderRecord = std::nullopt;
-        mRayMissShaderRecords.clear();
-        mRayHitGroupRecords.clear();
-        mCallableShaderRecords.clear();
-        mRayMissRecordStride = D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT;
-        mRayHitGroupRecordStride = D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT;
-        mCallableRecordStride = D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT;
-        mGPUTable = nullptr;
+        mBuilder.Clear();
     }
 
     ShaderTable::MemoryRequirements ShaderTable::GetMemoryRequirements() const
     {
-        // Shader tables must be aligned
-        // Reserve at least 1 slot for each record type 
-        auto tableSize = Foundation::MemoryUtils::Align(mRayGenShaderRecord->SizeInBytes, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT) +
-            Foundation::MemoryUtils::Align(mRayMissRecordStride * std::max(mRayMissShaderRecords.size(), (size_t)1), D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT) +
-            Foundation::MemoryUtils::Align(mCallableRecordStride * std::max(mCallableShaderRecords.size(), (size_t)1), D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT) +
-            Foundation::MemoryUtils::Align(mRayHitGroupRecordStride * std::max(mRayHitGroupRecords.size(), (size_t)1), D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
-
-        return { tableSize };
+        return { mBuilder.GetLayout().TableSizeInBytes };
     }
 
-    void ShaderTable::InsertNullRecordsWhereRequired()
+    uint64_t ShaderTable::LocalRootArgumentsSize(const RootSignature* localRootSignature) const
     {
-        if (mRayMissShaderRecords.empty()) AddRayMissShader(ShaderIdentifier(), nullptr);
-        if (mCallableShaderRecords.empty()) AddCallableShader(ShaderIdentifier(), nullptr);
-        if (mRayHitGroupRecords.empty()) AddRayTracingHitGroupShaders(ShaderIdentifier(), nullptr);
+        // Local root signature is optional
+        return localRootSignature ? localRootSignature->LocalRootArgumentsSizeInBytes() : 0;
     }
 
 }
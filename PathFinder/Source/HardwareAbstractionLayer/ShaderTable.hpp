@@ -11,6 +11,7 @@
 #include "RayDispatchInfo.hpp"
 #include "Buffer.hpp"
 #include "RayTracingHitGroupExport.hpp"
+#include "ShaderTableBuilder.hpp"
 
 namespace HAL
 {
@@ -25,40 +26,38 @@ namespace HAL
             uint64_t TableSizeInBytes;
         };
 
+        // Shaders must be re-added between BeginUpdate() and EndUpdate() in the same order
+        // every time the table is rebuilt, which lets unchanged records keep their memory
+        void BeginUpdate();
         void SetRayGenerationShader(const ShaderIdentifier& id, const RootSignature* localRootSignature = nullptr);
         void AddRayMissShader(const ShaderIdentifier& id, const RootSignature* localRootSignature = nullptr);
         void AddCallableShader(const ShaderIdentifier& id, const RootSignature* localRootSignature = nullptr);
         void AddRayTracingHitGroupShaders(const ShaderIdentifier& hitGroupId, const RootSignature* localRootSignature = nullptr);
+        bool EndUpdate();
 
-        RayDispatchInfo UploadToGPUMemory(uint8_t* uploadGPUMemory, const Buffer* gpuTableBuffer);
-        void Clear();
+        void SetHitGroupLocalRootArguments(uint64_t hitGroupIndex, const void* arguments, uint64_t size);
 
-        MemoryRequirements GetMemoryRequirements() const;
+        // Writes the whole table
+        void UploadToGPUMemory(uint8_t* uploadGPUMemory) const;
 
-    private:
-        struct ShaderRecord
-        {
-            ShaderRecord(const ShaderIdentifier& id, const RootSignature* signature, uint64_t size);
+        // Byte ranges changed since last call
+        std::vector<ShaderTableBuilder::Patch> ConsumePatches();
 
-            ShaderIdentifier ID;
-            const RootSignature* Signature;
-            uint64_t SizeInBytes; 
-        };
+        // Writes only patched ranges, memory outside of them is left untouched
+        void UploadPatchesToGPUMemory(uint8_t* uploadGPUMemory, const std::vector<ShaderTableBuilder::Patch>& patches) const;
 
-        void InsertNullRecordsWhereRequired();
+        RayDispatchInfo GetDispatchInfo(const Buffer* gpuTableBuffer) const;
+        void Clear();
 
-        const Buffer* mGPUTable = nullptr;
+        MemoryRequirements GetMemoryRequirements() const;
+
+    private:
+        uint64_t LocalRootArgumentsSize(const RootSignature* localRootSignature) const;
 
-        std::optional<ShaderRecord> mRayGenShaderRecord;
-        std::vector<ShaderRecord> mRayMissShaderRecords;
-        std::vector<ShaderRecord> mCallableShaderRecords;
-        std::vector<ShaderRecord> mRayHitGroupRecords;
+        ShaderTableBuilder mBuilder;
 
-        // Shader table stride (maximum record size) for each RT shader type
-        uint64_t mRayMissRecordStride = D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT;
-        uint64_t mRayHitGroupRecordStride = D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT;
-        uint64_t mCallableRecordStride = D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT;
+    public:
+        inline const auto& Builder() const { return mBuilder; }
     };
 
 }
-
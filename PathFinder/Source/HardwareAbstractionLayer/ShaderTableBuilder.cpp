@@ -0,0 +1,247 @@
+#include "ShaderTableBuilder.hpp"
+
+#include <Foundation/MemoryUtils.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace HAL
+{
+
+    void ShaderTableBuilder::BeginUpdate()
+    {
+        assert_format(!mIsUpdating, "Shader table update is already in progress");
+
+        for (uint64_t typeIndex = 0; typeIndex < RecordTypeCount; ++typeIndex)
+        {
+            mPreviousRecords[typeIndex] = std::move(mRecords[typeIndex]);
+            mRecords[typeIndex].clear();
+        }
+
+        mIsUpdating = true;
+    }
+
+    uint64_t ShaderTableBuilder::AddRecord(RecordType type, const ShaderIdentifierBytes& identifier, uint64_t localRootArgumentsSize)
+    {
+        assert_format(mIsUpdating, "Records can only be added between BeginUpdate() and EndUpdate()");
+        assert_format(ShaderIdentifierSize + localRootArgumentsSize <= MaxRecordStride, "Shader record exceeds maximum record size");
+
+        RecordList& records = mRecords[(uint64_t)type];
+        const RecordList& previousRecords = mPreviousRecords[(uint64_t)type];
+        uint64_t recordIndex = records.size();
+
+        Record& record = records.emplace_back();
+        record.Identifier = identifier;
+
+        // Arguments are usually set once per record and are not supposed to be lost on shader reload
+        if (recordIndex < previousRecords.size() && previousRecords[recordIndex].LocalRootArguments.size() == localRootArgumentsSize)
+        {
+            record.LocalRootArguments = previousRecords[recordIndex].LocalRootArguments;
+        }
+        else
+        {
+            record.LocalRootArguments.resize(localRootArgumentsSize, 0);
+        }
+
+        return recordIndex;
+    }
+
+    bool ShaderTableBuilder::EndUpdate()
+    {
+        assert_format(mIsUpdating, "EndUpdate() called without matching BeginUpdate()");
+        assert_format(mRecords[(uint64_t)RecordType::RayGeneration].size() == 1, "Shader table requires exactly one ray generation record");
+
+        Layout newLayout = ComputeLayout();
+        std::vector<uint8_t> newImage(newLayout.TableSizeInBytes, 0);
+
+        for (uint64_t typeIndex = 0; typeIndex < RecordTypeCount; ++typeIndex)
+        {
+            const Region& region = newLayout.Regions[typeIndex];
+            const RecordList& records = mRecords[typeIndex];
+
+            for (uint64_t recordIndex = 0; recordIndex < records.size(); ++recordIndex)
+            {
+                WriteRecord(newImage, region.Offset + recordIndex * region.Stride, records[recordIndex]);
+            }
+        }
+
+        bool isLayoutChanged = !mHasLayout || !(newLayout == mLayout);
+
+        if (isLayoutChanged)
+        {
+            // Every offset is different, so previous patches are meaningless
+            mPendingPatches.clear();
+            mPendingPatches.push_back({ 0, newLayout.TableSizeInBytes });
+        }
+        else
+        {
+            for (const Region& region : newLayout.Regions)
+            {
+                for (uint64_t recordIndex = 0; recordIndex < region.RecordCount; ++recordIndex)
+                {
+                    DiffRecord(newImage, region.Offset + recordIndex * region.Stride, region.Stride);
+                }
+            }
+        }
+
+        mLayout = newLayout;
+        mImage = std::move(newImage);
+        mHasLayout = true;
+        mIsUpdating = false;
+
+        for (RecordList& previousRecords : mPreviousRecords)
+        {
+            previousRecords.clear();
+        }
+
+        return isLayoutChanged;
+    }
+
+    void ShaderTableBuilder::SetLocalRootArguments(RecordType type, uint64_t recordIndex, const void* arguments, uint64_t size)
+    {
+        RecordList& records = mRecords[(uint64_t)type];
+
+        assert_format(recordIndex < records.size(), "Shader record index is out of bounds");
+
+        Record& record = records[recordIndex];
+
+        assert_format(size <= record.LocalRootArguments.size(), "Local root arguments exceed size reserved for the record");
+
+        std::memcpy(record.LocalRootArguments.data(), arguments, size);
+
+        // Structure update will diff the whole record anyway
+        if (mIsUpdating || !mHasLayout)
+        {
+            return;
+        }
+
+        uint64_t argumentsOffset = RecordOffset(type, recordIndex) + ShaderIdentifierSize;
+
+        if (std::memcmp(mImage.data() + argumentsOffset, arguments, size) != 0)
+        {
+            std::memcpy(mImage.data() + argumentsOffset, arguments, size);
+            mPendingPatches.push_back({ argumentsOffset, size });
+        }
+    }
+
+    std::vector<ShaderTableBuilder::Patch> ShaderTableBuilder::ConsumePatches()
+    {
+        std::vector<Patch> patches = std::move(mPendingPatches);
+        mPendingPatches.clear();
+
+        if (patches.empty())
+        {
+            return patches;
+        }
+
+        std::sort(patches.begin(), patches.end(), [](const Patch& a, const Patch& b) { return a.Offset < b.Offset; });
+
+        // Merge overlapping and adjacent ranges to minimize copy count
+        uint64_t lastMergedIndex = 0;
+
+        for (uint64_t patchIndex = 1; patchIndex < patches.size(); ++patchIndex)
+        {
+            Patch& merged = patches[lastMergedIndex];
+            const Patch& patch = patches[patchIndex];
+
+            if (patch.Offset <= merged.Offset + merged.Size)
+            {
+                merged.Size = std::max(merged.Offset + merged.Size, patch.Offset + patch.Size) - merged.Offset;
+            }
+            else
+            {
+                patches[++lastMergedIndex] = patch;
+            }
+        }
+
+        patches.resize(lastMergedIndex + 1);
+
+        return patches;
+    }
+
+    void ShaderTableBuilder::Clear()
+    {
+        for (uint64_t typeIndex = 0; typeIndex < RecordTypeCount; ++typeIndex)
+        {
+            mRecords[typeIndex].clear();
+            mPreviousRecords[typeIndex].clear();
+        }
+
+        mLayout = {};
+        mImage.clear();
+        mPendingPatches.clear();
+        mIsUpdating = false;
+        mHasLayout = false;
+    }
+
+    uint64_t ShaderTableBuilder::RecordCount(RecordType type) const
+    {
+        return mRecords[(uint64_t)type].size();
+    }
+
+    ShaderTableBuilder::Layout ShaderTableBuilder::ComputeLayout() const
+    {
+        Layout layout{};
+        uint64_t offset = 0;
+
+        for (uint64_t typeIndex = 0; typeIndex < RecordTypeCount; ++typeIndex)
+        {
+            const RecordList& records = mRecords[typeIndex];
+            Region& region = layout.Regions[typeIndex];
+
+            // DXR traverses records of one type with a constant step, so stride
+            // is defined by the largest record. Each type can have its own stride though.
+            region.Stride = RecordAlignment;
+
+            for (const Record& record : records)
+            {
+                uint64_t recordSize = Foundation::MemoryUtils::Align(ShaderIdentifierSize + record.LocalRootArguments.size(), RecordAlignment);
+                region.Stride = std::max(region.Stride, recordSize);
+            }
+
+            // Reserve a null record for each missing record type
+            region.RecordCount = std::max<uint64_t>(records.size(), 1);
+            region.Offset = Foundation::MemoryUtils::Align(offset, RegionAlignment);
+
+            offset = region.Offset + region.SizeInBytes();
+        }
+
+        layout.TableSizeInBytes = Foundation::MemoryUtils::Align(offset, RegionAlignment);
+
+        return layout;
+    }
+
+    void ShaderTableBuilder::WriteRecord(std::vector<uint8_t>& image, uint64_t recordOffset, const Record& record) const
+    {
+        std::memcpy(image.data() + recordOffset, record.Identifier.data(), ShaderIdentifierSize);
+
+        if (!record.LocalRootArguments.empty())
+        {
+            std::memcpy(image.data() + recordOffset + ShaderIdentifierSize, record.LocalRootArguments.data(), record.LocalRootArguments.size());
+        }
+    }
+
+    void ShaderTableBuilder::DiffRecord(const std::vector<uint8_t>& newImage, uint64_t recordOffset, uint64_t recordSize)
+    {
+        // Identifiers change on every shader reload while arguments usually don't, so diff them separately
+        if (std::memcmp(mImage.data() + recordOffset, newImage.data() + recordOffset, ShaderIdentifierSize) != 0)
+        {
+            mPendingPatches.push_back({ recordOffset, ShaderIdentifierSize });
+        }
+
+        uint64_t argumentsOffset = recordOffset + ShaderIdentifierSize;
+        uint64_t argumentsSize = recordSize - ShaderIdentifierSize;
+
+        if (argumentsSize > 0 && std::memcmp(mImage.data() + argumentsOffset, newImage.data() + argumentsOffset, argumentsSize) != 0)
+        {
+            mPendingPatches.push_back({ argumentsOffset, argumentsSize });
+        }
+    }
+
+    uint64_t ShaderTableBuilder::RecordOffset(RecordType type, uint64_t recordIndex) const
+    {
+        const Region& region = mLayout.RegionOf(type);
+        return region.Offset + recordIndex * region.Stride;
+    }
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace HAL
+{
+    // Device independent part of a shader table: record layout and CPU image of table memory.
+    // Strides and region offsets are computed once per table structure change, not per upload.
+    // Every structure or argument update is diffed against current image and produces
+    // a list of dirty byte ranges, so only changed identifiers and records need to reach GPU memory.
+
+    class ShaderTableBuilder
+    {
+    public:
+        // Regions are laid out in table memory in this order
+        enum class RecordType : uint8_t
+        {
+            RayGeneration, Miss, HitGroup, Callable
+        };
+
+        static const uint64_t RecordTypeCount = 4;
+
+        // Mirrors of D3D12 constants, kept here to not depend on API headers
+        static const uint64_t ShaderIdentifierSize = 32;
+        static const uint64_t RecordAlignment = 32;
+        static const uint64_t RegionAlignment = 64;
+        static const uint64_t MaxRecordStride = 4096;
+
+        using ShaderIdentifierBytes = std::array<uint8_t, ShaderIdentifierSize>;
+
+        struct Region
+        {
+            uint64_t Offset = 0;
+            uint64_t Stride = 0;
+            uint64_t RecordCount = 0;
+
+            inline uint64_t SizeInBytes() const { return Stride * RecordCount; }
+            inline bool operator==(const Region& other) const { return Offset == other.Offset && Stride == other.Stride && RecordCount == other.RecordCount; }
+        };
+
+        struct Layout
+        {
+            std::array<Region, RecordTypeCount> Regions;
+            uint64_t TableSizeInBytes = 0;
+
+            inline const Region& RegionOf(RecordType type) const { return Regions[(uint64_t)type]; }
+            inline bool operator==(const Layout& other) const { return Regions == other.Regions && TableSizeInBytes == other.TableSizeInBytes; }
+        };
+
+        // Byte range of table memory that must be re-uploaded
+        struct Patch
+        {
+            uint64_t Offset = 0;
+            uint64_t Size = 0;
+        };
+
+        // Starts a new table structure. Records are expected to be added in the same order
+        // as before, so that previous version of each record can be found by its type and index.
+        void BeginUpdate();
+
+        // Returns index of the record among records of the same type.
+        // Local root arguments of a previous record at the same position are preserved if their size is unchanged.
+        uint64_t AddRecord(RecordType type, const ShaderIdentifierBytes& identifier, uint64_t localRootArgumentsSize = 0);
+
+        // Finalizes structure, recomputes layout and generates patches against previous image.
+        // Returns true if layout has changed, in which case the whole table is patched.
+        bool EndUpdate();
+
+        // Can be called at any time after the record was added. Arguments are copied right after shader identifier.
+        void SetLocalRootArguments(RecordType type, uint64_t recordIndex, const void* arguments, uint64_t size);
+
+        // Returns sorted and coalesced patches accumulated since last call
+        std::vector<Patch> ConsumePatches();
+
+        void Clear();
+
+        uint64_t RecordCount(RecordType type) const;
+
+    private:
+        struct Record
+        {
+            ShaderIdentifierBytes Identifier{};
+            std::vector<uint8_t> LocalRootArguments;
+        };
+
+        using RecordList = std::vector<Record>;
+
+        Layout ComputeLayout() const;
+        void WriteRecord(std::vector<uint8_t>& image, uint64_t recordOffset, const Record& record) const;
+        void DiffRecord(const std::vector<uint8_t>& newImage, uint64_t recordOffset, uint64_t recordSize);
+        uint64_t RecordOffset(RecordType type, uint64_t recordIndex) const;
+
+        std::array<RecordList, RecordTypeCount> mRecords;
+        std::array<RecordList, RecordTypeCount> mPreviousRecords;
+
+        Layout mLayout;
+        std::vector<uint8_t> mImage;
+        std::vector<Patch> mPendingPatches;
+        bool mIsUpdating = false;
+        bool mHasLayout = false;
+
+    public:
+        inline const auto& GetLayout() const { return mLayout; }
+        inline const auto& Image() const { return mImage; }
+        inline bool HasLayout() const { return mHasLayout; }
+    };
+
+}
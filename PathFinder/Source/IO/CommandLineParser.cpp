@@ -1,5 +1,6 @@
 #include "CommandLineParser.hpp"
 
+#include <algorithm>
 
 
 namespace PathFinder
@@ -49,6 +50,67 @@ namespace PathFinder
         {
             mDisableMemoryAliasing = true;
         }
+
+        if (strcmp(argv, "-no_pso_cache") == 0)
+        {
+            mDisablePipelineStateCache = true;
+        }
+
+        // -frames_in_flight=N, where N is in [1, 4]
+        const char* framesInFlightArg = "-frames_in_flight=";
+
+        if (strncmp(argv, framesInFlightArg, strlen(framesInFlightArg)) == 0)
+        {
+            mFramesInFlight = std::clamp(atoi(argv + strlen(framesInFlightArg)), 1, 4);
+        }
+
+        // -memory_budget_mb=N, overrides budget derived from adapter's dedicated video memory
+        const char* memoryBudgetArg = "-memory_budget_mb=";
+
+        if (strncmp(argv, memoryBudgetArg, strlen(memoryBudgetArg)) == 0)
+        {
+            mMemoryBudgetMB = std::max(atoll(argv + strlen(memoryBudgetArg)), 0ll);
+        }
+
+        // -defragmentation_budget_mb=N, amount of memory moved per frame to compact resource heaps, 0 disables defragmentation
+        const char* defragmentationBudgetArg = "-defragmentation_budget_mb=";
+
+        if (strncmp(argv, defragmentationBudgetArg, strlen(defragmentationBudgetArg)) == 0)
+        {
+            mDefragmentationBudgetMB = std::max(atoll(argv + strlen(defragmentationBudgetArg)), 0ll);
+        }
+
+        // -upload_budget_mb=N, amount of scene texture data uploaded per frame, the rest is postponed to next frames
+        const char* uploadBudgetArg = "-upload_budget_mb=";
+
+        if (strncmp(argv, uploadBudgetArg, strlen(uploadBudgetArg)) == 0)
+        {
+            mUploadBudgetMB = std::max(atoll(argv + strlen(uploadBudgetArg)), 0ll);
+        }
+
+        // -dynamic_resolution_target_ms=N, GPU frame time render scale is adjusted to, 0 disables dynamic resolution
+        const char* dynamicResolutionTargetArg = "-dynamic_resolution_target_ms=";
+
+        if (strncmp(argv, dynamicResolutionTargetArg, strlen(dynamicResolutionTargetArg)) == 0)
+        {
+            mDynamicResolutionTargetMS = std::max((float)atof(argv + strlen(dynamicResolutionTargetArg)), 0.0f);
+        }
+
+        // -min_render_scale_percent=N, where N is in [25, 100], lower bound of dynamic resolution scale
+        const char* minRenderScaleArg = "-min_render_scale_percent=";
+
+        if (strncmp(argv, minRenderScaleArg, strlen(minRenderScaleArg)) == 0)
+        {
+            mMinRenderScale = std::clamp(atoi(argv + strlen(minRenderScaleArg)), 25, 100) / 100.0f;
+        }
+
+        // -scene_file=PATH, scene is loaded from the file, relative paths start at executable folder
+        const char* sceneFileArg = "-scene_file=";
+
+        if (strncmp(argv, sceneFileArg, strlen(sceneFileArg)) == 0)
+        {
+            mSceneFilePath = mExecutableFolder / std::filesystem::path{ argv + strlen(sceneFileArg) };
+        }
     }
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <cstdint>
 
 namespace PathFinder 
 {
@@ -14,12 +15,20 @@ namespace PathFinder
         void ParseArgument(char* argv);
 
         std::filesystem::path mExecutableFolder;
+        std::filesystem::path mSceneFilePath;
         bool mBuildDebugShaders = false;
         bool mUseShadersInProjectFolder = false;
         bool mDebugLayerEnabled = false;
         bool mAftermathEnabled = false;
         bool mUseWARPDevice = false;
         bool mDisableMemoryAliasing = false;
+        bool mDisablePipelineStateCache = false;
+        uint8_t mFramesInFlight = 2;
+        uint64_t mMemoryBudgetMB = 0;
+        uint64_t mDefragmentationBudgetMB = 0;
+        uint64_t mUploadBudgetMB = 64;
+        float mDynamicResolutionTargetMS = 0.0f;
+        float mMinRenderScale = 0.5f;
 
     public:
         inline auto ShouldEnableDebugLayer() const { return mDebugLayerEnabled; }
@@ -28,7 +37,15 @@ namespace PathFinder
         inline auto ShouldEnableAftermath() const { return mAftermathEnabled; }
         inline auto ShouldUseWARPDevice() const { return mUseWARPDevice; }
         inline auto DisableMemoryAliasing() const { return mDisableMemoryAliasing; }
+        inline auto DisablePipelineStateCache() const { return mDisablePipelineStateCache; }
+        inline auto FramesInFlight() const { return mFramesInFlight; }
+        inline auto MemoryBudgetMB() const { return mMemoryBudgetMB; }
+        inline auto DefragmentationBudgetMB() const { return mDefragmentationBudgetMB; }
+        inline auto UploadBudgetMB() const { return mUploadBudgetMB; }
+        inline auto DynamicResolutionTargetMS() const { return mDynamicResolutionTargetMS; }
+        inline auto MinRenderScale() const { return mMinRenderScale; }
         inline const auto& ExecutableFolderPath() const { return mExecutableFolder; }
+        inline const auto& SceneFilePath() const { return mSceneFilePath; }
     };
 
 }
@@ -10,19 +10,25 @@ namespace Memory
         ResourceStateTracker* stateTracker,
         SegregatedPoolsResourceAllocator* resourceAllocator, 
         PoolDescriptorAllocator* descriptorAllocator, 
-        CopyRequestManager* copyRequestManager)
+        CopyRequestManager* copyRequestManager,
+        FrameUploadAllocator* frameUploadAllocator,
+        std::optional<MemoryCategory> memoryCategory)
         :
-        GPUResource(accessStrategy, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager),
+        GPUResource(accessStrategy, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager, frameUploadAllocator),
         mRequstedStride{ properties.Stride },
         mProperties{ properties }
     {
         if (accessStrategy == GPUResource::AccessStrategy::Automatic)
         {
-            mBufferPtr = resourceAllocator->AllocateBuffer(properties);
+            mBufferPtr = resourceAllocator->AllocateBuffer(properties, std::nullopt, memoryCategory);
             mGetterBufferPtr = mBufferPtr.get();
 
             if (mStateTracker) 
                 mStateTracker->StartTrakingResource(mBufferPtr.get());
+
+            // Only buffers written exclusively from CPU can be moved safely
+            if (memoryCategory == MemoryCategory::VertexIndex)
+                MakeMovable();
         }
     }
 
@@ -32,11 +38,12 @@ namespace Memory
         SegregatedPoolsResourceAllocator* resourceAllocator, 
         PoolDescriptorAllocator* descriptorAllocator, 
         CopyRequestManager* copyRequestManager,
+        FrameUploadAllocator* frameUploadAllocator,
         const HAL::Device& device, 
         const HAL::Heap& mainResourceExplicitHeap, 
         uint64_t explicitHeapOffset)
         :
-        GPUResource(AccessStrategy::Automatic, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager),
+        GPUResource(AccessStrategy::Automatic, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager, frameUploadAllocator),
         mRequstedStride{ properties.Stride },
         mProperties{ properties }
     {
@@ -55,6 +62,57 @@ namespace Memory
     {
         if (mStateTracker && mBufferPtr) 
             mStateTracker->StopTrakingResource(mBufferPtr.get());
+
+        if (mBufferPtr)
+            mCopyRequestManager->CancelUploads(mBufferPtr.get());
+
+        if (mRelocatedBufferPtr)
+        {
+            mCopyRequestManager->CancelRelocation(mRelocatedBufferPtr.get());
+
+            if (mStateTracker)
+                mStateTracker->StopTrakingResource(mRelocatedBufferPtr.get());
+        }
+    }
+
+    void Buffer::RequestWrite()
+    {
+        bool isRegionWriteRequested = mRegionUploadFrameNumber == mFrameNumber;
+
+        // Full write overrides any partial write requested earlier in the same frame
+        mRegionUploadFrameNumber = std::numeric_limits<uint64_t>::max();
+        GPUResource::RequestWrite();
+
+        // Upload memory is already there, only the copy of the whole buffer is missing
+        if (isRegionWriteRequested)
+        {
+            RequestUploadCopies();
+        }
+    }
+
+    void Buffer::RequestRegionWrite(uint64_t byteOffset, uint64_t byteCount)
+    {
+        assert_format(byteOffset + byteCount <= mProperties.Size, "Write region is out of buffer bounds");
+
+        bool isWriteRequested = CurrentFrameUploadBuffer() != nullptr;
+        bool isRegionWriteRequested = mRegionUploadFrameNumber == mFrameNumber;
+
+        // Whole buffer is going to be uploaded anyway
+        if (isWriteRequested && !isRegionWriteRequested)
+        {
+            return;
+        }
+
+        if (!isWriteRequested)
+        {
+            mRegionUploadFrameNumber = mFrameNumber;
+            GPUResource::RequestWrite();
+        }
+
+        if (mAccessStrategy != GPUResource::AccessStrategy::DirectUpload)
+        {
+            mCopyRequestManager->RequestBufferUpload(CurrentFrameUploadBuffer(), CurrentFrameUploadOffset() + byteOffset, HALBuffer(), byteOffset, byteCount);
+        }
     }
 
     const HAL::CBDescriptor* Buffer::GetCBDescriptor() const
@@ -125,6 +183,71 @@ namespace Memory
             mGetterBufferPtr = newCurrentBuffer;
     }
 
+    void Buffer::EndFrame(uint64_t frameNumber)
+    {
+        GPUResource::EndFrame(frameNumber);
+
+        if (mRelocatedBufferPtr && frameNumber >= mRelocationFrameNumber)
+            CompleteRelocation();
+    }
+
+    void Buffer::MakeMovable()
+    {
+        mResourceAllocator->MakeMovable(mBufferPtr.get(), mProperties, [this](SegregatedPoolsResourceAllocator::BufferPtr newBuffer)
+        {
+            return BeginRelocation(std::move(newBuffer));
+        });
+    }
+
+    bool Buffer::BeginRelocation(SegregatedPoolsResourceAllocator::BufferPtr newBuffer)
+    {
+        if (mRelocatedBufferPtr || mLastWriteRequestFrameNumber == mFrameNumber)
+            return false;
+
+        mRelocatedBufferPtr = std::move(newBuffer);
+        mRelocationFrameNumber = mFrameNumber;
+        mRelocatedBufferPtr->SetDebugName(mDebugName);
+
+        if (mStateTracker)
+            mStateTracker->StartTrakingResource(mRelocatedBufferPtr.get());
+
+        mCopyRequestManager->RequestRelocation(mBufferPtr.get(), mRelocatedBufferPtr.get());
+
+        return true;
+    }
+
+    void Buffer::CompleteRelocation()
+    {
+        // Content was changed after the copy had been made, so the copy is discarded and the move is retried later
+        if (mLastWriteRequestFrameNumber >= mRelocationFrameNumber)
+        {
+            if (mStateTracker)
+                mStateTracker->StopTrakingResource(mRelocatedBufferPtr.get());
+
+            mRelocatedBufferPtr = nullptr;
+            MakeMovable();
+            return;
+        }
+
+        if (mStateTracker)
+            mStateTracker->StopTrakingResource(mBufferPtr.get());
+
+        // Old buffer goes through allocator's deferred deallocation, 
+        // so frames in flight that still reference it can finish safely
+        std::swap(mBufferPtr, mRelocatedBufferPtr);
+        mRelocatedBufferPtr = nullptr;
+        mGetterBufferPtr = mBufferPtr.get();
+
+        // Frames in flight may still read old descriptors, so they are released through 
+        // descriptor allocator's deferred deallocation and new ones are created on demand
+        mSRDescriptor = nullptr;
+        mUADescriptor = nullptr;
+        mCBDescriptor = nullptr;
+        ++mDescriptorGeneration;
+
+        MakeMovable();
+    }
+
     uint64_t Buffer::ResourceSizeInBytes() const
     {
         return mProperties.Size;
@@ -140,23 +263,20 @@ namespace Memory
         }
     }
 
-    CopyRequestManager::CopyCommand Buffer::GetUploadCommands()
+    void Buffer::RequestUploadCopies()
     {
-        return[&](HAL::CopyCommandListBase& cmdList)
+        // Regions are requested one by one as they are written
+        if (mRegionUploadFrameNumber == mFrameNumber)
         {
-            if (mAccessStrategy != GPUResource::AccessStrategy::DirectUpload)
-            {
-                cmdList.CopyBufferRegion(*CurrentFrameUploadBuffer(), *HALBuffer(), 0, HALBuffer()->ElementCapacity(), 0);
-            }
-        };
+            return;
+        }
+
+        mCopyRequestManager->RequestBufferUpload(CurrentFrameUploadBuffer(), CurrentFrameUploadOffset(), HALBuffer(), 0, HALBuffer()->ElementCapacity());
     }
 
-    CopyRequestManager::CopyCommand Buffer::GetReadbackCommands()
+    void Buffer::RequestReadbackCopies()
     {
-        return[&](HAL::CopyCommandListBase& cmdList)
-        {
-            cmdList.CopyBufferRegion(*HALBuffer(), *CurrentFrameReadbackBuffer(), 0, HALBuffer()->ElementCapacity(), 0);
-        };
+        mCopyRequestManager->RequestBufferReadback(HALBuffer(), CurrentFrameReadbackBuffer(), HALBuffer()->ElementCapacity());
     }
 
 }
@@ -4,6 +4,9 @@
 
 #include <HardwareAbstractionLayer/Buffer.hpp>
 
+#include <vector>
+#include <limits>
+
 namespace Memory
 {
 
@@ -16,7 +19,9 @@ namespace Memory
             ResourceStateTracker* stateTracker,
             SegregatedPoolsResourceAllocator* resourceAllocator, 
             PoolDescriptorAllocator* descriptorAllocator,
-            CopyRequestManager* copyRequestManager
+            CopyRequestManager* copyRequestManager,
+            FrameUploadAllocator* frameUploadAllocator,
+            std::optional<MemoryCategory> memoryCategory
         );
 
         Buffer(
@@ -25,6 +30,7 @@ namespace Memory
             SegregatedPoolsResourceAllocator* resourceAllocator,
             PoolDescriptorAllocator* descriptorAllocator,
             CopyRequestManager* copyRequestManager,
+            FrameUploadAllocator* frameUploadAllocator,
             const HAL::Device& device,
             const HAL::Heap& mainResourceExplicitHeap,
             uint64_t explicitHeapOffset
@@ -42,21 +48,40 @@ namespace Memory
         const HAL::Buffer* HALBuffer() const;
         const HAL::Resource* HALResource() const override;
 
+        void RequestWrite() override;
+
+        // Only requested byte ranges are copied from upload memory, the rest of buffer content is preserved.
+        // Has no additional effect if the whole buffer write is already requested in current frame.
+        void RequestRegionWrite(uint64_t byteOffset, uint64_t byteCount);
+
         void BeginFrame(uint64_t frameNumber) override;
+        void EndFrame(uint64_t frameNumber) override;
 
     protected:
         uint64_t ResourceSizeInBytes() const override;
         void ApplyDebugName() override;
-        CopyRequestManager::CopyCommand GetUploadCommands() override;
-        CopyRequestManager::CopyCommand GetReadbackCommands() override;
+        void RequestUploadCopies() override;
+        void RequestReadbackCopies() override;
 
     private:
+        void MakeMovable();
+        bool BeginRelocation(SegregatedPoolsResourceAllocator::BufferPtr newBuffer);
+        void CompleteRelocation();
+
         uint64_t mRequstedStride = 1;
         HAL::BufferProperties mProperties;
 
         SegregatedPoolsResourceAllocator::BufferPtr mBufferPtr;
         HAL::Buffer* mGetterBufferPtr = nullptr;
 
+        // Copy of the buffer at a new memory location made by defragmentation.
+        // Replaces the current buffer once the copy is executed.
+        SegregatedPoolsResourceAllocator::BufferPtr mRelocatedBufferPtr;
+        uint64_t mRelocationFrameNumber = 0;
+
+        // Frame in which only regions of the buffer are uploaded
+        uint64_t mRegionUploadFrameNumber = std::numeric_limits<uint64_t>::max();
+
         // Cached values, to be mutated from getters
         mutable uint64_t mCBDescriptorRequestFrameNumber = 0;
         mutable uint64_t mSRDescriptorRequestFrameNumber = 0;
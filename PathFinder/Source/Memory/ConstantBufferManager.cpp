@@ -0,0 +1,207 @@
+#include "ConstantBufferManager.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Memory
+{
+
+    ConstantBufferManager::ConstantBufferManager(UploadMemory* uploadMemory)
+        : mUploadMemory{ uploadMemory }, mPersistentPools{ Alignment, PersistentPageSlotCount } {}
+
+    ConstantBufferManager::StreamID ConstantBufferManager::CreateStream()
+    {
+        mStreams.emplace_back();
+        return mStreams.size() - 1;
+    }
+
+    HAL::GPUAddress ConstantBufferManager::Upload(StreamID streamID, const void* data, uint64_t sizeInBytes)
+    {
+        assert_format(sizeInBytes > 0 && sizeInBytes <= MaxConstantBufferSize, "Constant buffer size must be in (0; 64 KB] range");
+        assert_format(streamID < mStreams.size(), "Constant buffer stream does not exist");
+
+        Stream& stream = mStreams[streamID];
+
+        // Update indices restart every frame, so N-th update is compared to N-th update of previous frame
+        if (stream.FrameNumber != mFrameNumber)
+        {
+            stream.FrameNumber = mFrameNumber;
+            stream.UpdateCount = 0;
+        }
+
+        uint64_t versionIndex = stream.UpdateCount++;
+
+        if (versionIndex >= stream.Versions.size())
+        {
+            stream.Versions.resize(versionIndex + 1);
+        }
+
+        Version& version = stream.Versions[versionIndex];
+        mUpdateCount.fetch_add(1, std::memory_order_relaxed);
+
+        bool isRepeated = version.Data.size() == sizeInBytes && memcmp(version.Data.data(), data, sizeInBytes) == 0;
+
+        if (isRepeated && version.PersistentMemory)
+        {
+            mSkippedUpdateCount.fetch_add(1, std::memory_order_relaxed);
+            mSkippedBytes.fetch_add(sizeInBytes, std::memory_order_relaxed);
+            return version.GPUAddress;
+        }
+
+        // Frame memory of previous frames is recycled, repeated data has to outlive it.
+        // Either kind of memory is a fallback for the other, data still has to reach GPU when one is exhausted.
+        std::optional<HAL::GPUAddress> address = isRepeated ? 
+            UploadToPersistentMemory(version, data, sizeInBytes) : UploadToFrameMemory(version, data, sizeInBytes);
+
+        if (!address)
+        {
+            address = isRepeated ?
+                UploadToFrameMemory(version, data, sizeInBytes) : UploadToPersistentMemory(version, data, sizeInBytes);
+        }
+
+        assert_format(address, "Out of constant buffer upload memory, more memory is prepared for the next frame");
+
+        return address.value_or(0);
+    }
+
+    void ConstantBufferManager::BeginFrame(uint64_t frameNumber)
+    {
+        mFrameNumber = frameNumber;
+
+        mLastFrameStatistics.UpdateCount = mUpdateCount.exchange(0, std::memory_order_relaxed);
+        mLastFrameStatistics.UploadedBytes = mUploadedBytes.exchange(0, std::memory_order_relaxed);
+        mLastFrameStatistics.SkippedUpdateCount = mSkippedUpdateCount.exchange(0, std::memory_order_relaxed);
+        mLastFrameStatistics.SkippedBytes = mSkippedBytes.exchange(0, std::memory_order_relaxed);
+
+        CreatePersistentPages();
+    }
+
+    void ConstantBufferManager::EndFrame(uint64_t frameNumber)
+    {
+        std::lock_guard lock{ mPersistentMemoryMutex };
+
+        auto firstPendingIt = std::partition(mPendingReleases.begin(), mPendingReleases.end(),
+            [frameNumber](const PendingRelease& release) { return release.FrameNumber <= frameNumber; });
+
+        for (auto releaseIt = mPendingReleases.begin(); releaseIt != firstPendingIt; ++releaseIt)
+        {
+            mPersistentPools.Deallocate(releaseIt->Allocation);
+        }
+
+        mPendingReleases.erase(mPendingReleases.begin(), firstPendingIt);
+    }
+
+    std::optional<HAL::GPUAddress> ConstantBufferManager::UploadToFrameMemory(Version& version, const void* data, uint64_t sizeInBytes)
+    {
+        std::optional<UploadMemory::Range> allocation = mUploadMemory->AllocateFrameMemory(sizeInBytes, Alignment);
+
+        if (!allocation)
+        {
+            return std::nullopt;
+        }
+
+        if (version.PersistentMemory)
+        {
+            std::lock_guard lock{ mPersistentMemoryMutex };
+            ReleasePersistentMemory(version);
+        }
+
+        memcpy(allocation->CPUAddress, data, sizeInBytes);
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        version.Data.assign(bytes, bytes + sizeInBytes);
+        version.GPUAddress = allocation->GPUAddress;
+
+        mUploadedBytes.fetch_add(sizeInBytes, std::memory_order_relaxed);
+
+        return version.GPUAddress;
+    }
+
+    std::optional<HAL::GPUAddress> ConstantBufferManager::UploadToPersistentMemory(Version& version, const void* data, uint64_t sizeInBytes)
+    {
+        std::lock_guard lock{ mPersistentMemoryMutex };
+
+        PersistentPools::Allocation allocation = mPersistentPools.Allocate(sizeInBytes);
+        PersistentPools::Bucket& bucket = mPersistentPools.GetBucket(allocation.BucketIndex);
+        PersistentPages& pages = bucket.UserData;
+
+        // Slot sizes are multiples of the alignment and pages hold whole slots, so slots never straddle pages
+        uint64_t pageSize = bucket.SlotSize() * PersistentPageSlotCount;
+        uint64_t pageIndex = allocation.Slot.MemoryOffset / pageSize;
+        uint64_t offsetInPage = allocation.Slot.MemoryOffset - pageIndex * pageSize;
+
+        // Pool keeps the slots it has grown, which tells BeginFrame() how many pages the bucket needs
+        if (pageIndex >= pages.size())
+        {
+            mPersistentPools.Deallocate(allocation);
+            return std::nullopt;
+        }
+
+        ReleasePersistentMemory(version);
+
+        PersistentAllocation persistentMemory{
+            allocation,
+            pages[pageIndex].CPUAddress + offsetInPage,
+            pages[pageIndex].GPUAddress + offsetInPage
+        };
+
+        memcpy(persistentMemory.CPUAddress, data, sizeInBytes);
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        version.Data.assign(bytes, bytes + sizeInBytes);
+        version.GPUAddress = persistentMemory.GPUAddress;
+        version.PersistentMemory = persistentMemory;
+
+        mUploadedBytes.fetch_add(sizeInBytes, std::memory_order_relaxed);
+
+        return version.GPUAddress;
+    }
+
+    void ConstantBufferManager::ReleasePersistentMemory(Version& version)
+    {
+        if (!version.PersistentMemory)
+        {
+            return;
+        }
+
+        // Frames up to the current one may still read the memory on GPU
+        mPendingReleases.push_back(PendingRelease{ version.PersistentMemory->Allocation, mFrameNumber });
+        version.PersistentMemory = std::nullopt;
+    }
+
+    void ConstantBufferManager::CreatePersistentPages()
+    {
+        std::lock_guard lock{ mPersistentMemoryMutex };
+
+        for (uint64_t bucketIndex = 0; bucketIndex < mPersistentPools.BucketCount(); ++bucketIndex)
+        {
+            PersistentPools::Bucket& bucket = mPersistentPools.GetBucket(bucketIndex);
+            PersistentPages& pages = bucket.UserData;
+            uint64_t slotCount = bucket.Slots().SlotCount();
+
+            if (slotCount == 0)
+            {
+                continue;
+            }
+
+            // Buckets in use keep a spare page, so that the pool can grow once during a frame without waiting for a page
+            uint64_t requiredPageCount = (slotCount + PersistentPageSlotCount - 1) / PersistentPageSlotCount + 1;
+            uint64_t pageSize = bucket.SlotSize() * PersistentPageSlotCount;
+
+            while (pages.size() < requiredPageCount)
+            {
+                std::optional<UploadMemory::Range> page = mUploadMemory->CreatePersistentPage(pageSize, bucket.SlotSize());
+
+                // Updates keep falling back to frame memory until a page can be created
+                if (!page)
+                {
+                    break;
+                }
+
+                assert_format(page->GPUAddress % Alignment == 0, "Persistent constant buffer pages must be aligned to constant buffer placement alignment");
+                pages.push_back(*page);
+            }
+        }
+    }
+
+}
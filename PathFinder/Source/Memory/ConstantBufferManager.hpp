@@ -0,0 +1,139 @@
+#pragma once
+
+#include "SegregatedPools.hpp"
+
+#include <HardwareAbstractionLayer/Types.hpp>
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <optional>
+
+namespace Memory
+{
+
+    /// Places data of root constant buffers into upload memory.
+    ///
+    /// Constants are grouped into streams, one per owner, e.g. a render pass.
+    /// Every update of a stream within a frame is compared with the update of the same index
+    /// in the previous frame of that stream. Data that changed is sub-allocated from frame upload memory.
+    /// Data that repeats is moved into persistent upload memory once and bound from there
+    /// in the following frames without any uploads, until it changes again.
+    ///
+    /// Streams must be created single threaded, different streams can be updated in parallel.
+    /// Persistent pages are only created on the main thread in BeginFrame().
+    /// Updates that need a page which does not exist yet are served from the other kind of memory.
+    class ConstantBufferManager
+    {
+    public:
+        using StreamID = uint64_t;
+
+        /// Source of mapped upload memory. Manager only decides where constants are placed,
+        /// which keeps placement and lifetime logic independent from the device.
+        class UploadMemory
+        {
+        public:
+            struct Range
+            {
+                uint8_t* CPUAddress = nullptr;
+                HAL::GPUAddress GPUAddress = 0;
+            };
+
+            virtual ~UploadMemory() = default;
+
+            // Memory valid until the frame it was allocated in completes on GPU. Can be called from any thread.
+            virtual std::optional<Range> AllocateFrameMemory(uint64_t sizeInBytes, uint64_t alignment) = 0;
+
+            // Page aligned to at least constant buffer alignment that lives as long as the memory source.
+            // Only called from the main thread.
+            virtual std::optional<Range> CreatePersistentPage(uint64_t pageSize, uint64_t slotSize) = 0;
+        };
+
+        struct Statistics
+        {
+            uint64_t UpdateCount = 0;
+            uint64_t UploadedBytes = 0;
+
+            // Updates that were byte-identical to previous frame and bound persistent memory
+            uint64_t SkippedUpdateCount = 0;
+            uint64_t SkippedBytes = 0;
+        };
+
+        // Placement alignment of root constant buffers
+        static const uint64_t Alignment = 256;
+
+        // Constant buffers are limited to 4096 16-byte vectors
+        static const uint64_t MaxConstantBufferSize = 65536;
+
+        ConstantBufferManager(UploadMemory* uploadMemory);
+
+        StreamID CreateStream();
+
+        // Returns GPU address of constant buffer with the data, valid until the end of current frame
+        HAL::GPUAddress Upload(StreamID streamID, const void* data, uint64_t sizeInBytes);
+
+        void BeginFrame(uint64_t frameNumber);
+        void EndFrame(uint64_t frameNumber);
+
+    private:
+        using PersistentPages = std::vector<UploadMemory::Range>;
+        using PersistentPools = SegregatedPools<PersistentPages>;
+
+        // Persistent memory of each size class is allocated in pages of this many slots
+        static const uint64_t PersistentPageSlotCount = 32;
+
+        struct PersistentAllocation
+        {
+            PersistentPools::Allocation Allocation;
+            uint8_t* CPUAddress = nullptr;
+            HAL::GPUAddress GPUAddress = 0;
+        };
+
+        struct Version
+        {
+            std::vector<uint8_t> Data;
+            HAL::GPUAddress GPUAddress = 0;
+            std::optional<PersistentAllocation> PersistentMemory;
+        };
+
+        struct Stream
+        {
+            std::vector<Version> Versions;
+            uint64_t FrameNumber = 0;
+            uint64_t UpdateCount = 0;
+        };
+
+        struct PendingRelease
+        {
+            PersistentPools::Allocation Allocation;
+            uint64_t FrameNumber = 0;
+        };
+
+        std::optional<HAL::GPUAddress> UploadToFrameMemory(Version& version, const void* data, uint64_t sizeInBytes);
+        std::optional<HAL::GPUAddress> UploadToPersistentMemory(Version& version, const void* data, uint64_t sizeInBytes);
+        // Persistent memory mutex must be held
+        void ReleasePersistentMemory(Version& version);
+        void CreatePersistentPages();
+
+        UploadMemory* mUploadMemory;
+        uint64_t mFrameNumber = 0;
+
+        std::vector<Stream> mStreams;
+
+        // Persistent memory is only touched when data switches between changing and repeating
+        std::mutex mPersistentMemoryMutex;
+        PersistentPools mPersistentPools;
+        std::vector<PendingRelease> mPendingReleases;
+
+        std::atomic<uint64_t> mUpdateCount{ 0 };
+        std::atomic<uint64_t> mUploadedBytes{ 0 };
+        std::atomic<uint64_t> mSkippedUpdateCount{ 0 };
+        std::atomic<uint64_t> mSkippedBytes{ 0 };
+        Statistics mLastFrameStatistics;
+
+    public:
+        // Totals of the previous frame
+        inline const Statistics& LastFrameStatistics() const { return mLastFrameStatistics; }
+    };
+
+}
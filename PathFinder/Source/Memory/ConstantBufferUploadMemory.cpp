@@ -0,0 +1,41 @@
+#include "ConstantBufferUploadMemory.hpp"
+
+#include <Foundation/StringUtils.hpp>
+
+namespace Memory
+{
+
+    ConstantBufferUploadMemory::ConstantBufferUploadMemory(FrameUploadAllocator* frameUploadAllocator, SegregatedPoolsResourceAllocator* resourceAllocator)
+        : mFrameUploadAllocator{ frameUploadAllocator }, mResourceAllocator{ resourceAllocator } {}
+
+    std::optional<ConstantBufferUploadMemory::Range> ConstantBufferUploadMemory::AllocateFrameMemory(uint64_t sizeInBytes, uint64_t alignment)
+    {
+        std::optional<FrameUploadAllocator::Allocation> allocation = mFrameUploadAllocator->Allocate(sizeInBytes, alignment);
+
+        if (!allocation)
+        {
+            return std::nullopt;
+        }
+
+        return Range{ allocation->CPUAddress, allocation->GPUAddress };
+    }
+
+    std::optional<ConstantBufferUploadMemory::Range> ConstantBufferUploadMemory::CreatePersistentPage(uint64_t pageSize, uint64_t slotSize)
+    {
+        auto properties = HAL::BufferProperties::Create<uint8_t>(pageSize);
+        SegregatedPoolsResourceAllocator::BufferPtr page = mResourceAllocator->AllocateBuffer(properties, HAL::CPUAccessibleHeapType::Upload, MemoryCategory::Upload);
+        uint8_t* mappedPage = page ? page->Map() : nullptr;
+
+        if (!mappedPage)
+        {
+            return std::nullopt;
+        }
+
+        page->SetDebugName(StringFormat("Persistent Constants Page %d [%d Byte Slots]", mPersistentPages.size(), slotSize));
+
+        Range range{ mappedPage, page->GPUVirtualAddress() };
+        mPersistentPages.push_back(std::move(page));
+        return range;
+    }
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "ConstantBufferManager.hpp"
+#include "FrameUploadAllocator.hpp"
+#include "SegregatedPoolsResourceAllocator.hpp"
+
+#include <vector>
+
+namespace Memory
+{
+
+    // Upload memory of constant buffer manager backed by frame upload allocator
+    // and persistently mapped upload buffers of the resource allocator.
+    class ConstantBufferUploadMemory : public ConstantBufferManager::UploadMemory
+    {
+    public:
+        ConstantBufferUploadMemory(FrameUploadAllocator* frameUploadAllocator, SegregatedPoolsResourceAllocator* resourceAllocator);
+
+        std::optional<Range> AllocateFrameMemory(uint64_t sizeInBytes, uint64_t alignment) override;
+        std::optional<Range> CreatePersistentPage(uint64_t pageSize, uint64_t slotSize) override;
+
+    private:
+        FrameUploadAllocator* mFrameUploadAllocator;
+        SegregatedPoolsResourceAllocator* mResourceAllocator;
+        std::vector<SegregatedPoolsResourceAllocator::BufferPtr> mPersistentPages;
+    };
+
+}
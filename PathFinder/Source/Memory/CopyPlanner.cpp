@@ -0,0 +1,139 @@
+#include "CopyPlanner.hpp"
+
+#include <algorithm>
+
+namespace Memory
+{
+
+    void CopyPlanner::BuildPlan(const std::vector<CopyRegion>& regions, uint64_t byteBudget, Plan& plan)
+    {
+        plan.Copies.clear();
+        plan.Deferred.clear();
+        plan.SubmittedBytes = 0;
+        plan.RequestedRegionCount = regions.size();
+
+        mSortedRegions = regions;
+
+        // Budget is spent in request order, so deferred copies are the first to go next frame
+        std::stable_sort(mSortedRegions.begin(), mSortedRegions.end(), [](const CopyRegion& a, const CopyRegion& b)
+        {
+            return a.Sequence < b.Sequence;
+        });
+
+        SelectCopies(byteBudget, plan);
+        MergeCopies(plan);
+    }
+
+    void CopyPlanner::SelectCopies(uint64_t byteBudget, Plan& plan)
+    {
+        mSubmittedRegions.clear();
+        mLastUndeferrableSequences.clear();
+
+        for (const CopyRegion& region : mSortedRegions)
+        {
+            if (!region.IsDeferrable)
+            {
+                mLastUndeferrableSequences[region.Destination] = region.Sequence;
+            }
+        }
+
+        // Deferring a copy that is followed by an undeferrable one to the same destination would reorder them
+        auto mustSubmit = [this](const CopyRegion& region)
+        {
+            auto it = mLastUndeferrableSequences.find(region.Destination);
+            return !region.IsDeferrable || (it != mLastUndeferrableSequences.end() && region.Sequence < it->second);
+        };
+
+        for (const CopyRegion& region : mSortedRegions)
+        {
+            if (mustSubmit(region))
+            {
+                mSubmittedRegions.push_back(region);
+                plan.SubmittedBytes += region.Size;
+            }
+        }
+
+        bool isDeferring = false;
+        bool isDeferrableCopySubmitted = false;
+
+        for (const CopyRegion& region : mSortedRegions)
+        {
+            if (mustSubmit(region))
+            {
+                continue;
+            }
+
+            // Once a copy is deferred every later one is deferred too,
+            // which keeps request order of copies to the same destination
+            isDeferring = isDeferring || (isDeferrableCopySubmitted && plan.SubmittedBytes + region.Size > byteBudget);
+
+            if (isDeferring)
+            {
+                plan.Deferred.push_back(region);
+                continue;
+            }
+
+            mSubmittedRegions.push_back(region);
+            plan.SubmittedBytes += region.Size;
+            isDeferrableCopySubmitted = true;
+        }
+    }
+
+    void CopyPlanner::MergeCopies(Plan& plan)
+    {
+        std::stable_sort(mSubmittedRegions.begin(), mSubmittedRegions.end(), [](const CopyRegion& a, const CopyRegion& b)
+        {
+            return a.Destination != b.Destination ? a.Destination < b.Destination : a.Sequence < b.Sequence;
+        });
+
+        auto runBegin = mSubmittedRegions.begin();
+
+        while (runBegin != mSubmittedRegions.end())
+        {
+            // Copies reading the same staging bytes can be freely reordered among themselves
+            auto runEnd = std::find_if(runBegin + 1, mSubmittedRegions.end(), [&runBegin](const CopyRegion& region)
+            {
+                return region.Destination != runBegin->Destination || !HaveSameDataLayout(*runBegin, region);
+            });
+
+            std::sort(runBegin, runEnd, [](const CopyRegion& a, const CopyRegion& b)
+            {
+                return a.DestinationOffset != b.DestinationOffset ? a.DestinationOffset < b.DestinationOffset : a.Size > b.Size;
+            });
+
+            plan.Copies.push_back(*runBegin);
+
+            for (auto it = runBegin + 1; it != runEnd; ++it)
+            {
+                CopyRegion& merged = plan.Copies.back();
+                uint64_t mergedEnd = merged.DestinationOffset + merged.Size;
+                uint64_t regionEnd = it->DestinationOffset + it->Size;
+
+                if (merged.Kind == CopyKind::BufferRegion && it->DestinationOffset <= mergedEnd)
+                {
+                    merged.Size = std::max(mergedEnd, regionEnd) - merged.DestinationOffset;
+                    merged.Sequence = std::min(merged.Sequence, it->Sequence);
+                }
+                else if (merged.Kind != CopyKind::BufferRegion && it->DestinationOffset == merged.DestinationOffset && it->Size == merged.Size)
+                {
+                    // Same resource copied twice from the same memory
+                    continue;
+                }
+                else
+                {
+                    plan.Copies.push_back(*it);
+                }
+            }
+
+            runBegin = runEnd;
+        }
+    }
+
+    bool CopyPlanner::HaveSameDataLayout(const CopyRegion& a, const CopyRegion& b)
+    {
+        // Equal offset deltas mean that overlapping destination bytes are read from the same source bytes
+        return a.Kind == b.Kind && a.Source == b.Source &&
+            a.SourceOffset - a.DestinationOffset == b.SourceOffset - b.DestinationOffset;
+    }
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+namespace HAL
+{
+    class Resource;
+}
+
+namespace Memory
+{
+    // Turns copy requests of a frame into a minimal list of copy commands.
+    // Planner only compares resource pointers and never dereferences them,
+    // so plans can be built and verified without a device.
+    //
+    // Copies are grouped by destination. Buffer regions that read the same staging memory
+    // and are contiguous or overlapping in both source and destination are merged into one copy.
+    // Copies from different sources to one destination keep their request order.
+
+    class CopyPlanner
+    {
+    public:
+        enum class CopyKind : uint8_t
+        {
+            BufferRegion, BufferToTexture, TextureToBuffer, WholeResource
+        };
+
+        struct CopyRegion
+        {
+            CopyKind Kind = CopyKind::BufferRegion;
+            const HAL::Resource* Source = nullptr;
+            const HAL::Resource* Destination = nullptr;
+
+            // Texture copies use source or destination offset as the placement of the whole resource footprint
+            uint64_t SourceOffset = 0;
+            uint64_t DestinationOffset = 0;
+            uint64_t Size = 0;
+
+            // Deferrable copies read staging memory that outlives the frame they were requested in
+            // and can be postponed when frame budget is exhausted
+            bool IsDeferrable = false;
+
+            // Request order, copies are never reordered against older copies to the same destination
+            uint64_t Sequence = 0;
+        };
+
+        struct Plan
+        {
+            std::vector<CopyRegion> Copies;
+            std::vector<CopyRegion> Deferred;
+
+            uint64_t SubmittedBytes = 0;
+            uint64_t RequestedRegionCount = 0;
+        };
+
+        // Copies that can't be deferred are always submitted and consume budget first,
+        // together with deferrable copies they would otherwise overtake on the same destination.
+        // Deferrable copies are then submitted in request order until budget is exhausted,
+        // but at least one of them is submitted each frame so that oversized copies make progress.
+        void BuildPlan(const std::vector<CopyRegion>& regions, uint64_t byteBudget, Plan& plan);
+
+    private:
+        void SelectCopies(uint64_t byteBudget, Plan& plan);
+        void MergeCopies(Plan& plan);
+
+        static bool HaveSameDataLayout(const CopyRegion& a, const CopyRegion& b);
+
+        // Scratch state reused between plans
+        std::vector<CopyRegion> mSortedRegions;
+        std::vector<CopyRegion> mSubmittedRegions;
+        std::unordered_map<const HAL::Resource*, uint64_t> mLastUndeferrableSequences;
+    };
+
+}
@@ -1,23 +1,86 @@
 #include "CopyRequestManager.hpp"
 
+#include <algorithm>
 
 
 namespace Memory
 {
 
-    void CopyRequestManager::RequestUpload(const HAL::Resource* resource, const CopyCommand& copyCommand)
+    CopyRequestManager::CopyRequestManager(uint64_t uploadBudgetInBytes)
+        : mUploadBudget{ uploadBudgetInBytes } {}
+
+    void CopyRequestManager::RequestBufferUpload(const HAL::Buffer* source, uint64_t sourceOffset, const HAL::Buffer* destination, uint64_t destinationOffset, uint64_t size)
+    {
+        RequestUpload(CopyRegion{ CopyKind::BufferRegion, source, destination, sourceOffset, destinationOffset, size, false });
+    }
+
+    void CopyRequestManager::RequestTextureUpload(const HAL::Buffer* source, uint64_t sourceOffset, const HAL::Texture* destination, uint64_t size, bool isDeferrable)
+    {
+        RequestUpload(CopyRegion{ CopyKind::BufferToTexture, source, destination, sourceOffset, 0, size, isDeferrable });
+    }
+
+    void CopyRequestManager::RequestBufferReadback(const HAL::Buffer* source, const HAL::Buffer* destination, uint64_t size)
+    {
+        mReadbackRequests.emplace_back(CopyRegion{ CopyKind::BufferRegion, source, destination, 0, 0, size });
+    }
+
+    void CopyRequestManager::RequestTextureReadback(const HAL::Texture* source, const HAL::Buffer* destination, uint64_t size)
     {
-        mUploadRequests.emplace_back(CopyRequest{ resource, copyCommand });
+        mReadbackRequests.emplace_back(CopyRegion{ CopyKind::TextureToBuffer, source, destination, 0, 0, size });
     }
 
-    void CopyRequestManager::RequestReadback(const HAL::Resource* resource, const CopyCommand& copyCommand)
+    void CopyRequestManager::RequestRelocation(const HAL::Resource* source, const HAL::Resource* destination)
     {
-        mReadbackRequests.emplace_back(CopyRequest{ resource, copyCommand });
+        mRelocationRequests.emplace_back(RelocationRequest{ source, destination });
+    }
+
+    void CopyRequestManager::CancelRelocation(const HAL::Resource* destination)
+    {
+        mRelocationRequests.erase(
+            std::remove_if(mRelocationRequests.begin(), mRelocationRequests.end(),
+                [destination](const RelocationRequest& request) { return request.Destination == destination; }),
+            mRelocationRequests.end());
+    }
+
+    void CopyRequestManager::CancelUploads(const HAL::Resource* destination)
+    {
+        mUploadRequests.erase(
+            std::remove_if(mUploadRequests.begin(), mUploadRequests.end(),
+                [destination](const CopyRegion& request) { return request.Destination == destination; }),
+            mUploadRequests.end());
+
+        mDeferredUploadDestinations.erase(destination);
+    }
+
+    bool CopyRequestManager::IsUploadDeferred(const HAL::Resource* destination) const
+    {
+        return mDeferredUploadDestinations.find(destination) != mDeferredUploadDestinations.end();
+    }
+
+    const CopyPlanner::Plan& CopyRequestManager::PlanUploads()
+    {
+        mPlanner.BuildPlan(mUploadRequests, mUploadBudget, mUploadPlan);
+        mPlannedUploadSequence = mUploadSequence;
+        return mUploadPlan;
     }
 
     void CopyRequestManager::FlushUploadRequests()
     {
-        mUploadRequests.clear();
+        // Requests made after the plan was built are kept as well
+        auto firstUnplannedRequest = std::find_if(mUploadRequests.begin(), mUploadRequests.end(),
+            [this](const CopyRegion& request) { return request.Sequence >= mPlannedUploadSequence; });
+
+        mUploadPlan.Deferred.insert(mUploadPlan.Deferred.end(), firstUnplannedRequest, mUploadRequests.end());
+        mUploadRequests = mUploadPlan.Deferred;
+        mDeferredUploadDestinations.clear();
+
+        for (const CopyRegion& request : mUploadRequests)
+        {
+            mDeferredUploadDestinations.insert(request.Destination);
+        }
+
+        mUploadPlan.Copies.clear();
+        mUploadPlan.Deferred.clear();
     }
 
     void CopyRequestManager::FlushReadbackRequests()
@@ -25,11 +88,25 @@ namespace Memory
         mReadbackRequests.clear();
     }
 
+    void CopyRequestManager::FlushRelocationRequests()
+    {
+        mRelocationRequests.clear();
+    }
+
     void CopyRequestManager::FlushAllRequests()
     {
-        FlushUploadRequests();
+        mUploadRequests.clear();
+        mUploadPlan.Copies.clear();
+        mUploadPlan.Deferred.clear();
+        mDeferredUploadDestinations.clear();
         FlushReadbackRequests();
+        FlushRelocationRequests();
     }
 
-}
+    void CopyRequestManager::RequestUpload(const CopyRegion& region)
+    {
+        mUploadRequests.push_back(region);
+        mUploadRequests.back().Sequence = mUploadSequence++;
+    }
 
+}
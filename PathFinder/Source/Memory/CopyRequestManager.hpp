@@ -1,9 +1,13 @@
 #pragma once
 
-#include <functional>
+#include "CopyPlanner.hpp"
 
-#include <HardwareAbstractionLayer/CommandList.hpp>
-#include <HardwareAbstractionLayer/Resource.hpp>
+#include <HardwareAbstractionLayer/Buffer.hpp>
+#include <HardwareAbstractionLayer/Texture.hpp>
+
+#include <vector>
+#include <unordered_set>
+#include <limits>
 
 namespace Memory
 {
@@ -11,28 +15,65 @@ namespace Memory
     class CopyRequestManager
     {
     public:
-        using CopyCommand = std::function<void(HAL::CopyCommandListBase&)>;
+        using CopyKind = CopyPlanner::CopyKind;
+        using CopyRegion = CopyPlanner::CopyRegion;
 
-        struct CopyRequest
+        struct RelocationRequest
         {
-            const HAL::Resource* Resource = nullptr;
-            CopyCommand Command;
+            const HAL::Resource* Source = nullptr;
+            const HAL::Resource* Destination = nullptr;
         };
 
-        void RequestUpload(const HAL::Resource* resource, const CopyCommand& copyCommand);
-        void RequestReadback(const HAL::Resource* resource, const CopyCommand& copyCommand);
+        // Deferrable uploads can be postponed to later frames when upload budget is exhausted
+        CopyRequestManager(uint64_t uploadBudgetInBytes = std::numeric_limits<uint64_t>::max());
+
+        void RequestBufferUpload(const HAL::Buffer* source, uint64_t sourceOffset, const HAL::Buffer* destination, uint64_t destinationOffset, uint64_t size);
+        void RequestTextureUpload(const HAL::Buffer* source, uint64_t sourceOffset, const HAL::Texture* destination, uint64_t size, bool isDeferrable);
+        void RequestBufferReadback(const HAL::Buffer* source, const HAL::Buffer* destination, uint64_t size);
+        void RequestTextureReadback(const HAL::Texture* source, const HAL::Buffer* destination, uint64_t size);
+
+        // Copy of resource content to its new location in memory.
+        // Destination is left in the states source was in at the time of the copy.
+        void RequestRelocation(const HAL::Resource* source, const HAL::Resource* destination);
+        void CancelRelocation(const HAL::Resource* destination);
+
+        // Drops uploads to a resource that is about to be destroyed, including deferred ones
+        void CancelUploads(const HAL::Resource* destination);
+
+        // Staging memory of deferred uploads must be kept alive until upload is submitted
+        bool IsUploadDeferred(const HAL::Resource* destination) const;
 
+        // Sorts and merges upload requests and selects ones that fit into frame upload budget
+        const CopyPlanner::Plan& PlanUploads();
+
+        // Removes uploads submitted by the last plan, deferred uploads stay queued for the next one
         void FlushUploadRequests();
         void FlushReadbackRequests();
+        void FlushRelocationRequests();
+
+        // Discards every request, deferred uploads included
         void FlushAllRequests();
 
     private:
-        std::vector<CopyRequest> mUploadRequests;
-        std::vector<CopyRequest> mReadbackRequests;
+        void RequestUpload(const CopyRegion& region);
+
+        CopyPlanner mPlanner;
+        CopyPlanner::Plan mUploadPlan;
+        uint64_t mUploadBudget = 0;
+        uint64_t mUploadSequence = 0;
+        uint64_t mPlannedUploadSequence = 0;
+
+        std::vector<CopyRegion> mUploadRequests;
+        std::vector<CopyRegion> mReadbackRequests;
+        std::vector<RelocationRequest> mRelocationRequests;
+        std::unordered_set<const HAL::Resource*> mDeferredUploadDestinations;
 
     public:
         inline const auto& UploadRequests() const { return mUploadRequests; }
         inline const auto& ReadbackRequests() const { return mReadbackRequests; }
+        inline const auto& RelocationRequests() const { return mRelocationRequests; }
+        inline const auto& LastUploadPlan() const { return mUploadPlan; }
+        inline auto UploadBudget() const { return mUploadBudget; }
     };
 
 }
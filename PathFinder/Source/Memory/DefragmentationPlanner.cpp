@@ -0,0 +1,164 @@
+#include "DefragmentationPlanner.hpp"
+
+#include <algorithm>
+
+namespace Memory
+{
+
+    DefragmentationPlanner::Plan DefragmentationPlanner::BuildPlan(const std::vector<PoolState>& pools, const std::vector<MovableBlock>& blocks, uint64_t byteBudget)
+    {
+        Plan plan{};
+        uint64_t remainingBudget = byteBudget;
+
+        mPoolBlocks.clear();
+
+        for (const MovableBlock& block : blocks)
+        {
+            mPoolBlocks.push_back(&block);
+        }
+
+        // Input order of blocks must not affect the plan
+        std::sort(mPoolBlocks.begin(), mPoolBlocks.end(), [](const MovableBlock* a, const MovableBlock* b)
+        {
+            return a->PoolIndex != b->PoolIndex ? a->PoolIndex < b->PoolIndex : a->Slot < b->Slot;
+        });
+
+        auto poolBlocksBegin = mPoolBlocks.begin();
+
+        for (uint64_t poolIndex = 0; poolIndex < pools.size(); ++poolIndex)
+        {
+            const PoolState& pool = pools[poolIndex];
+
+            assert_format(pool.SlotsPerHeap > 0, "Pool must have at least one slot per heap");
+
+            mOccupancy.assign(pool.SlotCount, SlotOccupancy::Immovable);
+            mBlockIDs.assign(pool.SlotCount, 0);
+
+            for (uint64_t slot : pool.FreeSlots)
+            {
+                assert_format(slot < pool.SlotCount, "Free slot is out of pool bounds");
+                mOccupancy[slot] = SlotOccupancy::Free;
+            }
+
+            for (; poolBlocksBegin != mPoolBlocks.end() && (*poolBlocksBegin)->PoolIndex == poolIndex; ++poolBlocksBegin)
+            {
+                const MovableBlock* block = *poolBlocksBegin;
+
+                assert_format(block->Slot < pool.SlotCount, "Movable block is out of pool bounds");
+                assert_format(mOccupancy[block->Slot] == SlotOccupancy::Immovable, "Movable block occupies a free slot or is listed twice");
+
+                mOccupancy[block->Slot] = SlotOccupancy::Movable;
+                mBlockIDs[block->Slot] = block->ID;
+            }
+
+            PlanPool(poolIndex, pool, remainingBudget, plan);
+        }
+
+        assert_format(poolBlocksBegin == mPoolBlocks.end(), "Movable block references a pool that does not exist");
+
+        plan.MovedBytes = byteBudget - remainingBudget;
+
+        return plan;
+    }
+
+    uint64_t DefragmentationPlanner::TrailingFreeHeapCount(const PoolState& pool)
+    {
+        DefragmentationPlanner planner;
+        planner.mOccupancy.assign(pool.SlotCount, SlotOccupancy::Immovable);
+
+        for (uint64_t slot : pool.FreeSlots)
+        {
+            planner.mOccupancy[slot] = SlotOccupancy::Free;
+        }
+
+        return planner.CountTrailingFreeHeaps(pool.SlotCount / pool.SlotsPerHeap, pool.SlotsPerHeap);
+    }
+
+    void DefragmentationPlanner::PlanPool(uint64_t poolIndex, const PoolState& pool, uint64_t& remainingBudget, Plan& plan)
+    {
+        uint64_t heapCount = pool.SlotCount / pool.SlotsPerHeap;
+        uint64_t destinationSlot = 0;
+
+        for (uint64_t heap = heapCount; heap-- > 0;)
+        {
+            uint64_t firstSlot = heap * pool.SlotsPerHeap;
+            uint64_t lastSlot = firstSlot + pool.SlotsPerHeap;
+
+            bool hasImmovableSlots = std::any_of(mOccupancy.begin() + firstSlot, mOccupancy.begin() + lastSlot,
+                [](SlotOccupancy occupancy) { return occupancy == SlotOccupancy::Immovable; });
+
+            // Heaps can only be released from the end of a pool,
+            // so nothing below a heap that cannot be evacuated is worth moving
+            if (hasImmovableSlots)
+            {
+                break;
+            }
+
+            uint64_t movableCount = std::count(mOccupancy.begin() + firstSlot, mOccupancy.begin() + lastSlot, SlotOccupancy::Movable);
+
+            // A partially evacuated heap frees nothing, so a heap is either planned in full or not at all
+            if (movableCount * pool.SlotSize > remainingBudget)
+            {
+                break;
+            }
+
+            // Moving inside the same heap or upwards does not free anything
+            mDestinationSlots.clear();
+
+            for (uint64_t slot = destinationSlot; slot < firstSlot && mDestinationSlots.size() < movableCount; ++slot)
+            {
+                if (mOccupancy[slot] == SlotOccupancy::Free)
+                {
+                    mDestinationSlots.push_back(slot);
+                }
+            }
+
+            if (mDestinationSlots.size() < movableCount)
+            {
+                break;
+            }
+
+            auto destinationIt = mDestinationSlots.begin();
+
+            for (uint64_t slot = lastSlot; slot-- > firstSlot;)
+            {
+                if (mOccupancy[slot] != SlotOccupancy::Movable)
+                {
+                    continue;
+                }
+
+                plan.Moves.push_back({ mBlockIDs[slot], poolIndex, slot, *destinationIt });
+                remainingBudget -= pool.SlotSize;
+
+                // Moved block can't be planned again, so its new slot is immovable for the rest of the plan
+                mOccupancy[*destinationIt] = SlotOccupancy::Immovable;
+                mOccupancy[slot] = SlotOccupancy::Free;
+
+                destinationSlot = *destinationIt + 1;
+                ++destinationIt;
+            }
+        }
+
+        plan.ReleasableHeapCount += CountTrailingFreeHeaps(heapCount, pool.SlotsPerHeap);
+    }
+
+    uint64_t DefragmentationPlanner::CountTrailingFreeHeaps(uint64_t heapCount, uint64_t slotsPerHeap) const
+    {
+        uint64_t freeHeapCount = 0;
+
+        for (uint64_t heap = heapCount; heap-- > 0;)
+        {
+            auto heapBegin = mOccupancy.begin() + heap * slotsPerHeap;
+
+            if (!std::all_of(heapBegin, heapBegin + slotsPerHeap, [](SlotOccupancy occupancy) { return occupancy == SlotOccupancy::Free; }))
+            {
+                break;
+            }
+
+            ++freeHeapCount;
+        }
+
+        return freeHeapCount;
+    }
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace Memory
+{
+    // Decides which allocations to move where to compact pools of equally sized slots.
+    // Planner works on slot indices only and has no knowledge of heaps or resources,
+    // so the same input always produces the same plan and can be verified without a device.
+    //
+    // Allocations are moved from the end of a pool towards free slots at its beginning,
+    // which makes trailing heaps empty and lets the allocator release them.
+    // Heaps containing allocations that cannot be moved are never evacuated,
+    // since moving the rest of their allocations would not free any memory.
+
+    class DefragmentationPlanner
+    {
+    public:
+        struct PoolState
+        {
+            uint64_t SlotSize = 0;
+            uint64_t SlotCount = 0;
+            uint64_t SlotsPerHeap = 1;
+
+            // Every slot that is neither free nor occupied by a movable block is considered immovable
+            std::vector<uint64_t> FreeSlots;
+        };
+
+        struct MovableBlock
+        {
+            uint64_t ID = 0;
+            uint64_t PoolIndex = 0;
+            uint64_t Slot = 0;
+        };
+
+        struct Move
+        {
+            uint64_t BlockID = 0;
+            uint64_t PoolIndex = 0;
+            uint64_t SourceSlot = 0;
+            uint64_t DestinationSlot = 0;
+        };
+
+        struct Plan
+        {
+            std::vector<Move> Moves;
+            uint64_t MovedBytes = 0;
+
+            // Heaps at the end of pools that will be completely free once every move is done
+            uint64_t ReleasableHeapCount = 0;
+        };
+
+        // Moves are planned pool by pool in the order pools are provided until byte budget is exhausted.
+        // Each move is accounted with the full slot size. Budget is only spent on heaps that can be evacuated completely.
+        Plan BuildPlan(const std::vector<PoolState>& pools, const std::vector<MovableBlock>& blocks, uint64_t byteBudget);
+
+        // Heaps at the end of a pool that can be released right away
+        static uint64_t TrailingFreeHeapCount(const PoolState& pool);
+
+    private:
+        enum class SlotOccupancy : uint8_t
+        {
+            Free, Immovable, Movable
+        };
+
+        void PlanPool(uint64_t poolIndex, const PoolState& pool, uint64_t& remainingBudget, Plan& plan);
+
+        // Heap count is rounded down: a partially grown last heap does not exist yet
+        uint64_t CountTrailingFreeHeaps(uint64_t heapCount, uint64_t slotsPerHeap) const;
+
+        // Scratch state reused between pools and plans
+        std::vector<SlotOccupancy> mOccupancy;
+        std::vector<uint64_t> mBlockIDs;
+        std::vector<const MovableBlock*> mPoolBlocks;
+        std::vector<uint64_t> mDestinationSlots;
+    };
+
+}
@@ -0,0 +1,87 @@
+#include "FrameUploadAllocator.hpp"
+
+#include <Foundation/StringUtils.hpp>
+
+#include <algorithm>
+
+namespace Memory
+{
+
+    FrameUploadAllocator::FrameUploadAllocator(SegregatedPoolsResourceAllocator* resourceAllocator, uint8_t simultaneousFramesInFlight, uint64_t pageSize)
+        : mResourceAllocator{ resourceAllocator }, mPageSize{ pageSize }, mRingFrameTracker{ simultaneousFramesInFlight }
+    {
+        for (uint8_t frameIdx = 0; frameIdx < simultaneousFramesInFlight; ++frameIdx)
+        {
+            mFrames.emplace_back(pageSize);
+        }
+
+        mRingFrameTracker.SetDeallocationCallback([this](const Ring::FrameTailAttributes& frameAttributes)
+        {
+            // Frame is completed on GPU, its pages can be written again
+            auto frameIndex = frameAttributes.Tail - frameAttributes.Size;
+            mFrames[frameIndex].Allocator.Reset();
+        });
+    }
+
+    std::optional<FrameUploadAllocator::Allocation> FrameUploadAllocator::Allocate(uint64_t sizeInBytes, uint64_t alignment)
+    {
+        FramePages& frame = mFrames[mCurrentFrameIndex];
+        std::optional<PagedLinearAllocator::Range> range = frame.Allocator.Allocate(sizeInBytes, alignment);
+
+        if (!range)
+        {
+            RequestPageCount(frame.Allocator.RequestedPageCount());
+            return std::nullopt;
+        }
+
+        HAL::Buffer* page = frame.Pages[range->PageIndex].get();
+
+        return Allocation{ frame.MappedPages[range->PageIndex] + range->OffsetInPage, page->GPUVirtualAddress() + range->OffsetInPage, range->OffsetInPage, page };
+    }
+
+    void FrameUploadAllocator::BeginFrame(uint64_t frameNumber)
+    {
+        mLastFrameUsedBytes = mFrames[mCurrentFrameIndex].Allocator.UsedBytes();
+        mCurrentFrameIndex = mRingFrameTracker.Allocate(1);
+        mRingFrameTracker.FinishCurrentFrame(frameNumber);
+
+        CreatePages(mFrames[mCurrentFrameIndex], mRequiredPageCount.load(std::memory_order_relaxed));
+    }
+
+    void FrameUploadAllocator::EndFrame(uint64_t frameNumber)
+    {
+        mRingFrameTracker.ReleaseCompletedFrames(frameNumber);
+    }
+
+    void FrameUploadAllocator::RequestPageCount(uint64_t pageCount)
+    {
+        pageCount = std::min(pageCount, MaxPagesPerFrame);
+        uint64_t requiredPageCount = mRequiredPageCount.load(std::memory_order_relaxed);
+
+        while (requiredPageCount < pageCount && 
+            !mRequiredPageCount.compare_exchange_weak(requiredPageCount, pageCount, std::memory_order_relaxed)) {}
+    }
+
+    void FrameUploadAllocator::CreatePages(FramePages& frame, uint64_t requiredPageCount)
+    {
+        // Pages are kept between frames, so this only happens until upload volume stabilizes
+        for (uint64_t pageIndex = frame.Allocator.PageCount(); pageIndex < requiredPageCount; ++pageIndex)
+        {
+            auto properties = HAL::BufferProperties::Create<uint8_t>(mPageSize);
+            SegregatedPoolsResourceAllocator::BufferPtr page = mResourceAllocator->AllocateBuffer(properties, HAL::CPUAccessibleHeapType::Upload, MemoryCategory::Upload);
+            uint8_t* mappedPage = page ? page->Map() : nullptr;
+
+            // Frame keeps working with the pages it has, allocations that don't fit fall back to dedicated upload buffers
+            if (!mappedPage)
+            {
+                return;
+            }
+
+            page->SetDebugName(StringFormat("Frame Upload Page %d", pageIndex));
+            frame.Pages[pageIndex] = std::move(page);
+            frame.MappedPages[pageIndex] = mappedPage;
+            frame.Allocator.SetPageCount(pageIndex + 1);
+        }
+    }
+
+}
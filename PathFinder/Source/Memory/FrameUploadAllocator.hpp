@@ -0,0 +1,86 @@
+#pragma once
+
+#include "SegregatedPoolsResourceAllocator.hpp"
+#include "PagedLinearAllocator.hpp"
+#include "Ring.hpp"
+
+#include <HardwareAbstractionLayer/Buffer.hpp>
+
+#include <atomic>
+#include <array>
+#include <deque>
+#include <optional>
+
+namespace Memory
+{
+
+    // Linear allocator of upload memory that lives for one frame.
+    // Each frame in flight owns a set of large persistently mapped upload pages
+    // that are sub-allocated by bumping an atomic cursor and reclaimed as a whole
+    // once the frame completes on GPU, instead of allocating and releasing 
+    // an upload buffer per resource write.
+    //
+    // Allocate() is lock free and can be called from any thread.
+    // Resource allocator is not thread safe, so pages are only created on the main thread in BeginFrame().
+    // When a frame runs out of pages allocations fail, and the demand is remembered so that 
+    // enough pages are prepared the next time the frame's memory is reused.
+
+    class FrameUploadAllocator
+    {
+    public:
+        struct Allocation
+        {
+            uint8_t* CPUAddress = nullptr;
+            HAL::GPUAddress GPUAddress = 0;
+
+            // Offset inside of the page buffer, for copy commands
+            uint64_t Offset = 0;
+            HAL::Buffer* Buffer = nullptr;
+        };
+
+        static const uint64_t MaxPagesPerFrame = 64;
+
+        FrameUploadAllocator(SegregatedPoolsResourceAllocator* resourceAllocator, uint8_t simultaneousFramesInFlight, uint64_t pageSize = 4 * 1024 * 1024);
+
+        // Alignment must be a power of two that divides page size.
+        // Allocations that don't fit into a page or into pages prepared for the frame are not served.
+        std::optional<Allocation> Allocate(uint64_t sizeInBytes, uint64_t alignment = 256);
+
+        void BeginFrame(uint64_t frameNumber);
+        void EndFrame(uint64_t frameNumber);
+
+    private:
+        struct FramePages
+        {
+            FramePages(uint64_t pageSize) : Allocator{ pageSize } {}
+
+            std::array<SegregatedPoolsResourceAllocator::BufferPtr, MaxPagesPerFrame> Pages;
+            std::array<uint8_t*, MaxPagesPerFrame> MappedPages{};
+
+            // Page count only changes between frames, on the main thread
+            PagedLinearAllocator Allocator;
+        };
+
+        void RequestPageCount(uint64_t pageCount);
+        void CreatePages(FramePages& frame, uint64_t requiredPageCount);
+
+        SegregatedPoolsResourceAllocator* mResourceAllocator = nullptr;
+        uint64_t mPageSize = 0;
+
+        Ring mRingFrameTracker;
+        uint64_t mCurrentFrameIndex = 0;
+
+        // Frames hold atomics and cannot be relocated
+        std::deque<FramePages> mFrames;
+
+        // Largest page count any frame needed, pages of every frame are grown to it
+        std::atomic<uint64_t> mRequiredPageCount{ 1 };
+
+        uint64_t mLastFrameUsedBytes = 0;
+
+    public:
+        inline auto PageSize() const { return mPageSize; }
+        inline auto LastFrameUsedBytes() const { return mLastFrameUsedBytes; }
+    };
+
+}
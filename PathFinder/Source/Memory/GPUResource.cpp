@@ -8,13 +8,16 @@ namespace Memory
         ResourceStateTracker* stateTracker,
         SegregatedPoolsResourceAllocator* resourceAllocator,
         PoolDescriptorAllocator* descriptorAllocator,
-        CopyRequestManager* copyRequestManager)
+        CopyRequestManager* copyRequestManager,
+        FrameUploadAllocator* frameUploadAllocator)
         :
         mAccessStrategy{ accessStrategy },
         mStateTracker{ accessStrategy == AccessStrategy::Automatic ? stateTracker : nullptr },
         mResourceAllocator{ resourceAllocator },
         mDescriptorAllocator{ descriptorAllocator },
-        mCopyRequestManager{ copyRequestManager } {}
+        mCopyRequestManager{ copyRequestManager },
+        // Direct upload resources are their own upload buffers and can't live in shared pages
+        mFrameUploadAllocator{ accessStrategy == AccessStrategy::Automatic ? frameUploadAllocator : nullptr } {}
 
     GPUResource::~GPUResource() {}
 
@@ -22,17 +25,28 @@ namespace Memory
     {
         assert_format(mAccessStrategy != AccessStrategy::DirectReadback, "DirectReadback resource does not support CPU writes");
 
+        mLastWriteRequestFrameNumber = mFrameNumber;
+
         // Upload is already requested in current frame
-        if (!mUploadBuffers.empty() && mUploadBuffers.back().second == mFrameNumber)
+        if (CurrentFrameUploadBuffer())
         {
             return;
         }
 
-        AllocateNewUploadBuffer();
+        mFrameUploadMemory = mFrameUploadAllocator && !mIsUploadDeferrable ? 
+            mFrameUploadAllocator->Allocate(ResourceSizeInBytes(), UploadMemoryAlignment()) : std::nullopt;
+
+        mFrameUploadMemoryFrameNumber = mFrameNumber;
+
+        // Resources that don't fit into a frame upload page get a dedicated upload buffer
+        if (!mFrameUploadMemory)
+        {
+            AllocateNewUploadBuffer();
+        }
 
         if (mAccessStrategy != AccessStrategy::DirectUpload)
         {
-            mCopyRequestManager->RequestUpload(HALResource(), GetUploadCommands());
+            RequestUploadCopies();
         }
     }
 
@@ -50,7 +64,7 @@ namespace Memory
 
         if (mAccessStrategy != AccessStrategy::DirectReadback)
         {
-            mCopyRequestManager->RequestReadback(HALResource(), GetReadbackCommands());
+            RequestReadbackCopies();
         }
     }
 
@@ -111,8 +125,11 @@ namespace Memory
 
     void GPUResource::EndFrame(uint64_t frameNumber)
     {
+        // Upload buffers of deferred uploads are still to be copied from
+        bool isUploadDeferred = mIsUploadDeferrable && !mUploadBuffers.empty() && mCopyRequestManager->IsUploadDeferred(HALResource());
+
         // Release upload buffers for completed frames
-        while (!mUploadBuffers.empty() && mUploadBuffers.front().second <= frameNumber)
+        while (!isUploadDeferred && !mUploadBuffers.empty() && mUploadBuffers.front().second <= frameNumber)
         {
             mCompletedUploadBuffer = std::move(mUploadBuffers.front().first);
             mUploadBuffers.pop();
@@ -139,12 +156,22 @@ namespace Memory
 
     HAL::Buffer* GPUResource::CurrentFrameUploadBuffer()
     {
+        if (IsFrameUploadMemoryCurrent())
+        {
+            return mFrameUploadMemory->Buffer;
+        }
+
         return !mUploadBuffers.empty() && mUploadBuffers.back().second == mFrameNumber ? 
             mUploadBuffers.back().first.get() : nullptr;
     }
 
     const HAL::Buffer* GPUResource::CurrentFrameUploadBuffer() const
     {
+        if (IsFrameUploadMemoryCurrent())
+        {
+            return mFrameUploadMemory->Buffer;
+        }
+
         return !mUploadBuffers.empty() && mUploadBuffers.back().second == mFrameNumber ?
             mUploadBuffers.back().first.get() : nullptr;
     }
@@ -161,10 +188,25 @@ namespace Memory
             mReadbackBuffers.back().first.get() : nullptr;
     }
 
+    uint64_t GPUResource::CurrentFrameUploadOffset() const
+    {
+        return IsFrameUploadMemoryCurrent() ? mFrameUploadMemory->Offset : 0;
+    }
+
+    bool GPUResource::IsFrameUploadMemoryCurrent() const
+    {
+        return mFrameUploadMemory && mFrameUploadMemoryFrameNumber == mFrameNumber;
+    }
+
     void GPUResource::ApplyDebugName()
     {
     }
 
+    uint64_t GPUResource::UploadMemoryAlignment() const
+    {
+        return 256;
+    }
+
     void GPUResource::AllocateNewUploadBuffer()
     {
         auto properties = HAL::BufferProperties::Create<uint8_t>(ResourceSizeInBytes());
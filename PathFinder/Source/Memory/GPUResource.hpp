@@ -4,6 +4,7 @@
 #include "ResourceStateTracker.hpp"
 #include "PoolDescriptorAllocator.hpp"
 #include "CopyRequestManager.hpp"
+#include "FrameUploadAllocator.hpp"
 
 #include <HardwareAbstractionLayer/Resource.hpp>
 #include <HardwareAbstractionLayer/CommandList.hpp>
@@ -28,7 +29,8 @@ namespace Memory
             ResourceStateTracker* stateTracker,
             SegregatedPoolsResourceAllocator* resourceAllocator,
             PoolDescriptorAllocator* descriptorAllocator,
-            CopyRequestManager* copyRequestManager);
+            CopyRequestManager* copyRequestManager,
+            FrameUploadAllocator* frameUploadAllocator);
 
         GPUResource(const GPUResource& that) = delete;
         GPUResource(GPUResource&& that) = default;
@@ -49,7 +51,7 @@ namespace Memory
         template <class T = uint8_t>
         void Write(const T* data, uint64_t startIndex, uint64_t objectCount, uint64_t objectAlignment = 1);
 
-        void RequestWrite();
+        virtual void RequestWrite();
         void RequestRead();
         void RequestNewState(HAL::ResourceState newState);
         void RequestNewSubresourceStates(const ResourceStateTracker::SubresourceStateList& newStates);
@@ -67,29 +69,52 @@ namespace Memory
         const HAL::Buffer* CurrentFrameUploadBuffer() const;
         const HAL::Buffer* CurrentFrameReadbackBuffer() const;
 
+        // Upload memory can be a region of a shared frame upload page
+        uint64_t CurrentFrameUploadOffset() const;
+
         virtual void ApplyDebugName();
         virtual uint64_t ResourceSizeInBytes() const = 0;
-        virtual CopyRequestManager::CopyCommand GetUploadCommands() = 0;
-        virtual CopyRequestManager::CopyCommand GetReadbackCommands() = 0;
+        virtual uint64_t UploadMemoryAlignment() const;
+
+        // Describe copies between current frame upload/readback memory and the resource to copy request manager
+        virtual void RequestUploadCopies() = 0;
+        virtual void RequestReadbackCopies() = 0;
 
         AccessStrategy mAccessStrategy = AccessStrategy::Automatic;
         ResourceStateTracker* mStateTracker;
         SegregatedPoolsResourceAllocator* mResourceAllocator;
         PoolDescriptorAllocator* mDescriptorAllocator;
         CopyRequestManager* mCopyRequestManager;
+        FrameUploadAllocator* mFrameUploadAllocator;
 
         std::queue<BufferFrameNumberPair> mUploadBuffers;
         std::queue<BufferFrameNumberPair> mReadbackBuffers;
 
         std::string mDebugName;
         uint64_t mFrameNumber = 0; 
+        uint64_t mLastWriteRequestFrameNumber = 0;
+        uint64_t mDescriptorGeneration = 0;
+
+        // Uploads of deferrable resources may be postponed by copy request manager,
+        // so they always get dedicated upload buffers that live until the upload is submitted
+        bool mIsUploadDeferrable = false;
 
     private:
         void AllocateNewUploadBuffer();
         void AllocateNewReadbackBuffer();
+        bool IsFrameUploadMemoryCurrent() const;
+
+        // Sub-allocated upload memory of the frame it was requested in, released with the frame
+        std::optional<FrameUploadAllocator::Allocation> mFrameUploadMemory;
+        uint64_t mFrameUploadMemoryFrameNumber = 0;
 
         SegregatedPoolsResourceAllocator::BufferPtr mCompletedReadbackBuffer;
         SegregatedPoolsResourceAllocator::BufferPtr mCompletedUploadBuffer;
+
+    public:
+        // Incremented every time descriptors are recreated, which happens when resource is relocated.
+        // Users storing descriptor indices in GPU memory must rewrite them when generation changes.
+        inline auto DescriptorGeneration() const { return mDescriptorGeneration; }
     };
 
 }
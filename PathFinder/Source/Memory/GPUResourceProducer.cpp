@@ -8,19 +8,21 @@ namespace Memory
         SegregatedPoolsResourceAllocator* resourceAllocator, 
         ResourceStateTracker* stateTracker, 
         PoolDescriptorAllocator* descriptorAllocator,
-        CopyRequestManager* copyRequestManager)
+        CopyRequestManager* copyRequestManager,
+        FrameUploadAllocator* frameUploadAllocator)
         : 
         mDevice{ device },
         mResourceAllocator{ resourceAllocator }, 
         mStateTracker{ stateTracker }, 
         mDescriptorAllocator{ descriptorAllocator },
-        mCopyRequestManager{ copyRequestManager } {}
+        mCopyRequestManager{ copyRequestManager },
+        mFrameUploadAllocator{ frameUploadAllocator } {}
 
-    GPUResourceProducer::TexturePtr GPUResourceProducer::NewTexture(const HAL::TextureProperties& properties)
+    GPUResourceProducer::TexturePtr GPUResourceProducer::NewTexture(const HAL::TextureProperties& properties, std::optional<MemoryCategory> memoryCategory)
     {
         CheckFrameValidity();
 
-        Texture* texture = new Texture{ properties, mStateTracker, mResourceAllocator, mDescriptorAllocator, mCopyRequestManager };
+        Texture* texture = new Texture{ properties, mStateTracker, mResourceAllocator, mDescriptorAllocator, mCopyRequestManager, mFrameUploadAllocator, memoryCategory };
         auto [iter, success] = mAllocatedResources.insert(texture);
         texture->BeginFrame(mFrameNumber);
 
@@ -39,7 +41,7 @@ namespace Memory
 
         Texture* texture = new Texture{
             properties, mStateTracker, mResourceAllocator, mDescriptorAllocator, 
-            mCopyRequestManager, *mDevice, explicitHeap, heapOffset
+            mCopyRequestManager, mFrameUploadAllocator, *mDevice, explicitHeap, heapOffset
         };
 
         auto [iter, success] = mAllocatedResources.insert(texture);
@@ -58,7 +60,7 @@ namespace Memory
     {
         CheckFrameValidity();
 
-        Texture* texture = new Texture{ mStateTracker, mResourceAllocator, mDescriptorAllocator, mCopyRequestManager, existingTexture };
+        Texture* texture = new Texture{ mStateTracker, mResourceAllocator, mDescriptorAllocator, mCopyRequestManager, mFrameUploadAllocator, existingTexture };
         auto [iter, success] = mAllocatedResources.insert(texture);
         texture->BeginFrame(mFrameNumber);
 
@@ -71,11 +73,12 @@ namespace Memory
         return TexturePtr{ texture, deallocationCallback };
     }
 
-    GPUResourceProducer::BufferPtr GPUResourceProducer::NewBuffer(const HAL::BufferProperties& properties, GPUResource::AccessStrategy accessStrategy)
+    GPUResourceProducer::BufferPtr GPUResourceProducer::NewBuffer(
+        const HAL::BufferProperties& properties, GPUResource::AccessStrategy accessStrategy, std::optional<MemoryCategory> memoryCategory)
     {
         CheckFrameValidity();
 
-        Buffer* buffer = new Buffer{ properties, accessStrategy, mStateTracker, mResourceAllocator, mDescriptorAllocator, mCopyRequestManager };
+        Buffer* buffer = new Buffer{ properties, accessStrategy, mStateTracker, mResourceAllocator, mDescriptorAllocator, mCopyRequestManager, mFrameUploadAllocator, memoryCategory };
         auto [iter, success] = mAllocatedResources.insert(buffer);
         buffer->BeginFrame(mFrameNumber);
 
@@ -94,7 +97,7 @@ namespace Memory
 
         Buffer* buffer = new Buffer{
             properties, mStateTracker, mResourceAllocator,
-            mDescriptorAllocator, mCopyRequestManager, *mDevice, explicitHeap, heapOffset
+            mDescriptorAllocator, mCopyRequestManager, mFrameUploadAllocator, *mDevice, explicitHeap, heapOffset
         };
 
         auto [iter, success] = mAllocatedResources.insert(buffer);
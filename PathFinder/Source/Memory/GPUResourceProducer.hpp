@@ -4,6 +4,7 @@
 #include "ResourceStateTracker.hpp"
 #include "PoolDescriptorAllocator.hpp"
 #include "CopyRequestManager.hpp"
+#include "FrameUploadAllocator.hpp"
 #include "Buffer.hpp"
 #include "Texture.hpp"
 
@@ -23,11 +24,17 @@ namespace Memory
             SegregatedPoolsResourceAllocator* resourceAllocator,
             ResourceStateTracker* stateTracker,
             PoolDescriptorAllocator* descriptorAllocator,
-            CopyRequestManager* copyRequestManager
+            CopyRequestManager* copyRequestManager,
+            FrameUploadAllocator* frameUploadAllocator
         );
 
-        BufferPtr NewBuffer(const HAL::BufferProperties& properties, GPUResource::AccessStrategy accessStrategy = GPUResource::AccessStrategy::Automatic);
-        TexturePtr NewTexture(const HAL::TextureProperties& properties);
+        // Memory category is used for accounting only and is deduced from resource type when omitted
+        BufferPtr NewBuffer(
+            const HAL::BufferProperties& properties, 
+            GPUResource::AccessStrategy accessStrategy = GPUResource::AccessStrategy::Automatic,
+            std::optional<MemoryCategory> memoryCategory = std::nullopt);
+
+        TexturePtr NewTexture(const HAL::TextureProperties& properties, std::optional<MemoryCategory> memoryCategory = std::nullopt);
 
         BufferPtr NewBuffer(const HAL::BufferProperties& properties, const HAL::Heap& explicitHeap, uint64_t heapOffset);
         TexturePtr NewTexture(const HAL::TextureProperties& properties, const HAL::Heap& explicitHeap, uint64_t heapOffset);
@@ -48,6 +55,7 @@ namespace Memory
         ResourceStateTracker* mStateTracker = nullptr;
         PoolDescriptorAllocator* mDescriptorAllocator = nullptr;
         CopyRequestManager* mCopyRequestManager = nullptr;
+        FrameUploadAllocator* mFrameUploadAllocator = nullptr;
         std::unordered_set<GPUResource*> mAllocatedResources;
     };
 
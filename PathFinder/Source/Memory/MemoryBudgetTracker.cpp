@@ -0,0 +1,310 @@
+#include "MemoryBudgetTracker.hpp"
+
+#include <algorithm>
+
+namespace Memory
+{
+
+    float MemoryBudgetTracker::HeapStatistics::Fragmentation() const
+    {
+        if (ReservedBytes == 0 || UsedBytes >= ReservedBytes)
+        {
+            return 0.0f;
+        }
+
+        return float(ReservedBytes - UsedBytes) / ReservedBytes;
+    }
+
+    void MemoryBudgetTracker::ReportHeapCreation(MemoryHeapKind heap, uint64_t sizeInBytes)
+    {
+        std::optional<Snapshot> overBudgetSnapshot;
+
+        {
+            std::lock_guard<std::mutex> lock{ mMutex };
+
+            HeapStatistics& stats = Heap(heap);
+            stats.ReservedBytes += sizeInBytes;
+            stats.HeapCount += 1;
+            UpdatePeaks(stats);
+            overBudgetSnapshot = CheckBudget();
+        }
+
+        NotifyOverBudget(overBudgetSnapshot);
+    }
+
+    void MemoryBudgetTracker::ReportHeapDestruction(MemoryHeapKind heap, uint64_t sizeInBytes)
+    {
+        std::lock_guard<std::mutex> lock{ mMutex };
+
+        HeapStatistics& stats = Heap(heap);
+
+        assert_format(stats.ReservedBytes >= sizeInBytes && stats.HeapCount > 0, "Destroyed heap was never reported");
+
+        stats.ReservedBytes -= sizeInBytes;
+        stats.HeapCount -= 1;
+
+        // Memory only goes down, budget can't be exceeded here
+        CheckBudget();
+    }
+
+    void MemoryBudgetTracker::ReportAllocation(MemoryHeapKind heap, MemoryCategory category, uint64_t requestedBytes, uint64_t reservedBytes)
+    {
+        std::lock_guard<std::mutex> lock{ mMutex };
+
+        HeapStatistics& heapStats = Heap(heap);
+        heapStats.UsedBytes += reservedBytes;
+        heapStats.WastedBytes += WastedBytes(requestedBytes, reservedBytes);
+        heapStats.AllocationCount += 1;
+        UpdatePeaks(heapStats);
+
+        CategoryStatistics& categoryStats = Category(category);
+        categoryStats.CurrentBytes += requestedBytes;
+        categoryStats.AllocationCount += 1;
+        categoryStats.PeakBytes = std::max(categoryStats.PeakBytes, categoryStats.CurrentBytes);
+    }
+
+    void MemoryBudgetTracker::ReportDeallocation(MemoryHeapKind heap, MemoryCategory category, uint64_t requestedBytes, uint64_t reservedBytes)
+    {
+        std::lock_guard<std::mutex> lock{ mMutex };
+
+        HeapStatistics& heapStats = Heap(heap);
+        CategoryStatistics& categoryStats = Category(category);
+
+        assert_format(heapStats.UsedBytes >= reservedBytes && heapStats.AllocationCount > 0 &&
+            categoryStats.CurrentBytes >= requestedBytes && categoryStats.AllocationCount > 0,
+            "Deallocation does not match any reported allocation");
+
+        heapStats.UsedBytes -= reservedBytes;
+        heapStats.WastedBytes -= WastedBytes(requestedBytes, reservedBytes);
+        heapStats.AllocationCount -= 1;
+
+        categoryStats.CurrentBytes -= requestedBytes;
+        categoryStats.AllocationCount -= 1;
+    }
+
+    void MemoryBudgetTracker::ReportTransientMemory(uint64_t heapCount, uint64_t heapBytes, uint64_t resourceCount, uint64_t resourceBytes)
+    {
+        std::optional<Snapshot> overBudgetSnapshot;
+
+        {
+            std::lock_guard<std::mutex> lock{ mMutex };
+
+            // Aliased heaps are fully occupied by definition, their efficiency is expressed by aliased bytes instead
+            HeapStatistics& heapStats = Heap(MemoryHeapKind::TransientAliased);
+            heapStats.ReservedBytes = heapBytes;
+            heapStats.UsedBytes = heapBytes;
+            heapStats.HeapCount = heapCount;
+            heapStats.AllocationCount = resourceCount;
+            UpdatePeaks(heapStats);
+
+            CategoryStatistics& categoryStats = Category(MemoryCategory::TransientRenderTarget);
+            categoryStats.CurrentBytes = categoryStats.CurrentBytes - mTransientResourceBytes + resourceBytes;
+            categoryStats.AllocationCount = categoryStats.AllocationCount - mTransientResourceCount + resourceCount;
+            categoryStats.PeakBytes = std::max(categoryStats.PeakBytes, categoryStats.CurrentBytes);
+
+            mTransientResourceBytes = resourceBytes;
+            mTransientResourceCount = resourceCount;
+            mAliasedBytes = resourceBytes > heapBytes ? resourceBytes - heapBytes : 0;
+
+            overBudgetSnapshot = CheckBudget();
+        }
+
+        NotifyOverBudget(overBudgetSnapshot);
+    }
+
+    void MemoryBudgetTracker::SetBudget(uint64_t budgetInBytes)
+    {
+        std::optional<Snapshot> overBudgetSnapshot;
+
+        {
+            std::lock_guard<std::mutex> lock{ mMutex };
+            mBudget = budgetInBytes;
+            overBudgetSnapshot = CheckBudget();
+        }
+
+        NotifyOverBudget(overBudgetSnapshot);
+    }
+
+    void MemoryBudgetTracker::SetOverBudgetCallback(const OverBudgetCallback& callback)
+    {
+        std::lock_guard<std::mutex> lock{ mMutex };
+        mOverBudgetCallback = callback;
+    }
+
+    void MemoryBudgetTracker::ResetPeaks()
+    {
+        std::lock_guard<std::mutex> lock{ mMutex };
+
+        for (HeapStatistics& heap : mHeaps)
+        {
+            heap.PeakReservedBytes = heap.ReservedBytes;
+            heap.PeakUsedBytes = heap.UsedBytes;
+        }
+
+        for (CategoryStatistics& category : mCategories)
+        {
+            category.PeakBytes = category.CurrentBytes;
+        }
+    }
+
+    void MemoryBudgetTracker::BeginFrame(uint64_t frameNumber)
+    {
+        std::lock_guard<std::mutex> lock{ mMutex };
+        mLastFrameSnapshot = MakeSnapshot();
+        mFrameNumber = frameNumber;
+    }
+
+    MemoryBudgetTracker::Snapshot MemoryBudgetTracker::CurrentSnapshot() const
+    {
+        std::lock_guard<std::mutex> lock{ mMutex };
+        return MakeSnapshot();
+    }
+
+    MemoryBudgetTracker::Snapshot MemoryBudgetTracker::LastFrameSnapshot() const
+    {
+        std::lock_guard<std::mutex> lock{ mMutex };
+        return mLastFrameSnapshot;
+    }
+
+    uint64_t MemoryBudgetTracker::Budget() const
+    {
+        std::lock_guard<std::mutex> lock{ mMutex };
+        return mBudget;
+    }
+
+    bool MemoryBudgetTracker::IsOverBudget() const
+    {
+        std::lock_guard<std::mutex> lock{ mMutex };
+        return mIsOverBudget;
+    }
+
+    MemoryBudgetTracker::Snapshot MemoryBudgetTracker::MakeSnapshot() const
+    {
+        Snapshot snapshot{};
+        snapshot.FrameNumber = mFrameNumber;
+        snapshot.Heaps = mHeaps;
+        snapshot.Categories = mCategories;
+        snapshot.AliasedBytes = mAliasedBytes;
+        snapshot.BudgetBytes = mBudget;
+        snapshot.IsOverBudget = mIsOverBudget;
+
+        for (uint64_t heapIndex = 0; heapIndex < HeapKindCount; ++heapIndex)
+        {
+            const HeapStatistics& heap = mHeaps[heapIndex];
+
+            snapshot.TotalReservedBytes += heap.ReservedBytes;
+            snapshot.TotalUsedBytes += heap.UsedBytes;
+            snapshot.TotalWastedBytes += heap.WastedBytes;
+
+            if (IsLocalHeap(MemoryHeapKind(heapIndex)))
+            {
+                snapshot.LocalReservedBytes += heap.ReservedBytes;
+            }
+        }
+
+        return snapshot;
+    }
+
+    const char* MemoryBudgetTracker::CategoryName(MemoryCategory category)
+    {
+        switch (category)
+        {
+        case MemoryCategory::TransientRenderTarget: return "Transient Render Targets";
+        case MemoryCategory::SceneTexture: return "Scene Textures";
+        case MemoryCategory::VertexIndex: return "Vertices & Indices";
+        case MemoryCategory::Upload: return "Upload";
+        case MemoryCategory::Readback: return "Readback";
+        case MemoryCategory::Descriptor: return "Descriptors";
+        default: return "Other";
+        }
+    }
+
+    const char* MemoryBudgetTracker::HeapKindName(MemoryHeapKind heap)
+    {
+        switch (heap)
+        {
+        case MemoryHeapKind::Upload: return "Upload";
+        case MemoryHeapKind::Readback: return "Readback";
+        case MemoryHeapKind::DefaultUniversalOrBuffer: return "Default Universal/Buffer";
+        case MemoryHeapKind::DefaultRTDS: return "Default RT/DS";
+        case MemoryHeapKind::DefaultNonRTDS: return "Default Non RT/DS";
+        case MemoryHeapKind::TransientAliased: return "Transient Aliased";
+        default: return "Descriptor";
+        }
+    }
+
+    bool MemoryBudgetTracker::IsLocalHeap(MemoryHeapKind heap)
+    {
+        // CPU accessible heaps live in system memory on discrete adapters
+        // and descriptor heaps are negligible in size
+        return heap != MemoryHeapKind::Upload && heap != MemoryHeapKind::Readback && heap != MemoryHeapKind::Descriptor;
+    }
+
+    MemoryBudgetTracker::HeapStatistics& MemoryBudgetTracker::Heap(MemoryHeapKind kind)
+    {
+        return mHeaps[(uint64_t)kind];
+    }
+
+    MemoryBudgetTracker::CategoryStatistics& MemoryBudgetTracker::Category(MemoryCategory category)
+    {
+        return mCategories[(uint64_t)category];
+    }
+
+    uint64_t MemoryBudgetTracker::WastedBytes(uint64_t requestedBytes, uint64_t reservedBytes)
+    {
+        // Resources may be placed in memory smaller than their size reported by the driver
+        // when allocator rounds sizes imprecisely, which is not counted as waste
+        return reservedBytes > requestedBytes ? reservedBytes - requestedBytes : 0;
+    }
+
+    void MemoryBudgetTracker::UpdatePeaks(HeapStatistics& heap)
+    {
+        heap.PeakReservedBytes = std::max(heap.PeakReservedBytes, heap.ReservedBytes);
+        heap.PeakUsedBytes = std::max(heap.PeakUsedBytes, heap.UsedBytes);
+    }
+
+    std::optional<MemoryBudgetTracker::Snapshot> MemoryBudgetTracker::CheckBudget()
+    {
+        uint64_t localReservedBytes = 0;
+
+        for (uint64_t heapIndex = 0; heapIndex < HeapKindCount; ++heapIndex)
+        {
+            if (IsLocalHeap(MemoryHeapKind(heapIndex)))
+            {
+                localReservedBytes += mHeaps[heapIndex].ReservedBytes;
+            }
+        }
+
+        bool wasOverBudget = mIsOverBudget;
+        mIsOverBudget = localReservedBytes > mBudget;
+
+        if (mIsOverBudget && !wasOverBudget && mOverBudgetCallback)
+        {
+            return MakeSnapshot();
+        }
+
+        return std::nullopt;
+    }
+
+    void MemoryBudgetTracker::NotifyOverBudget(const std::optional<Snapshot>& snapshot) const
+    {
+        if (!snapshot)
+        {
+            return;
+        }
+
+        OverBudgetCallback callback;
+
+        {
+            std::lock_guard<std::mutex> lock{ mMutex };
+            callback = mOverBudgetCallback;
+        }
+
+        // Callback may query the tracker, so it's invoked without holding the lock
+        if (callback)
+        {
+            callback(*snapshot);
+        }
+    }
+
+}
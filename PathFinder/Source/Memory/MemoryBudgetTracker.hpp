@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <limits>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace Memory
+{
+
+    enum class MemoryCategory : uint8_t
+    {
+        // Render graph resources, aliased or not
+        TransientRenderTarget,
+        SceneTexture,
+        VertexIndex,
+        Upload,
+        Readback,
+        Descriptor,
+        Other
+    };
+
+    // Mirrors heap families of resource allocators
+    enum class MemoryHeapKind : uint8_t
+    {
+        Upload,
+        Readback,
+        DefaultUniversalOrBuffer,
+        DefaultRTDS,
+        DefaultNonRTDS,
+        TransientAliased,
+        Descriptor
+    };
+
+    // Accounting of GPU memory reserved in heaps and used by allocations.
+    // Tracker has no knowledge of the device: allocators report heap and allocation events,
+    // so the same accounting can be driven by synthetic allocation traces.
+    // Thread safe: allocations are reported from render pass recording threads as well.
+
+    class MemoryBudgetTracker
+    {
+    public:
+        static const uint64_t CategoryCount = 7;
+        static const uint64_t HeapKindCount = 7;
+
+        struct HeapStatistics
+        {
+            uint64_t ReservedBytes = 0;
+            uint64_t PeakReservedBytes = 0;
+
+            // Memory set aside for allocations, including size rounding
+            uint64_t UsedBytes = 0;
+            uint64_t PeakUsedBytes = 0;
+
+            // Part of used memory lost to rounding allocations up to slot sizes
+            uint64_t WastedBytes = 0;
+
+            uint64_t HeapCount = 0;
+            uint64_t AllocationCount = 0;
+
+            // Share of reserved memory not occupied by any allocation
+            float Fragmentation() const;
+        };
+
+        struct CategoryStatistics
+        {
+            uint64_t CurrentBytes = 0;
+            uint64_t PeakBytes = 0;
+            uint64_t AllocationCount = 0;
+        };
+
+        struct Snapshot
+        {
+            uint64_t FrameNumber = 0;
+
+            std::array<HeapStatistics, HeapKindCount> Heaps;
+            std::array<CategoryStatistics, CategoryCount> Categories;
+
+            uint64_t TotalReservedBytes = 0;
+            uint64_t TotalUsedBytes = 0;
+            uint64_t TotalWastedBytes = 0;
+
+            // Reserved memory of heaps residing in video memory, which is what budget is compared against
+            uint64_t LocalReservedBytes = 0;
+
+            // Memory saved by placing transient resources with disjoint lifetimes at the same heap locations
+            uint64_t AliasedBytes = 0;
+
+            uint64_t BudgetBytes = std::numeric_limits<uint64_t>::max();
+            bool IsOverBudget = false;
+
+            inline const HeapStatistics& Heap(MemoryHeapKind kind) const { return Heaps[(uint64_t)kind]; }
+            inline const CategoryStatistics& Category(MemoryCategory category) const { return Categories[(uint64_t)category]; }
+        };
+
+        using OverBudgetCallback = std::function<void(const Snapshot&)>;
+
+        void ReportHeapCreation(MemoryHeapKind heap, uint64_t sizeInBytes);
+        void ReportHeapDestruction(MemoryHeapKind heap, uint64_t sizeInBytes);
+
+        // Requested size is what the user asked for, reserved size is what allocator actually set aside
+        void ReportAllocation(MemoryHeapKind heap, MemoryCategory category, uint64_t requestedBytes, uint64_t reservedBytes);
+        void ReportDeallocation(MemoryHeapKind heap, MemoryCategory category, uint64_t requestedBytes, uint64_t reservedBytes);
+
+        // Transient resources share heaps through aliasing and are always reallocated as a whole,
+        // so they are reported in bulk, replacing previously reported values
+        void ReportTransientMemory(uint64_t heapCount, uint64_t heapBytes, uint64_t resourceCount, uint64_t resourceBytes);
+
+        // Callback is invoked once when local memory exceeds the budget
+        // and rearmed after memory usage goes back under it.
+        // It's called on the reporting thread outside of the tracker lock.
+        void SetBudget(uint64_t budgetInBytes);
+        void SetOverBudgetCallback(const OverBudgetCallback& callback);
+
+        void ResetPeaks();
+
+        // Captures statistics of the previous frame
+        void BeginFrame(uint64_t frameNumber);
+
+        Snapshot CurrentSnapshot() const;
+        Snapshot LastFrameSnapshot() const;
+        uint64_t Budget() const;
+        bool IsOverBudget() const;
+
+        static const char* CategoryName(MemoryCategory category);
+        static const char* HeapKindName(MemoryHeapKind heap);
+        static bool IsLocalHeap(MemoryHeapKind heap);
+
+    private:
+        HeapStatistics& Heap(MemoryHeapKind kind);
+        CategoryStatistics& Category(MemoryCategory category);
+        static uint64_t WastedBytes(uint64_t requestedBytes, uint64_t reservedBytes);
+
+        void UpdatePeaks(HeapStatistics& heap);
+
+        // Functions below expect the lock to be held
+        Snapshot MakeSnapshot() const;
+
+        // Returns a snapshot for the callback when budget is exceeded for the first time
+        std::optional<Snapshot> CheckBudget();
+
+        // Expects the lock to be released
+        void NotifyOverBudget(const std::optional<Snapshot>& snapshot) const;
+
+        std::array<HeapStatistics, HeapKindCount> mHeaps;
+        std::array<CategoryStatistics, CategoryCount> mCategories;
+
+        uint64_t mAliasedBytes = 0;
+        uint64_t mTransientResourceCount = 0;
+        uint64_t mTransientResourceBytes = 0;
+        uint64_t mBudget = std::numeric_limits<uint64_t>::max();
+        uint64_t mFrameNumber = 0;
+        bool mIsOverBudget = false;
+
+        OverBudgetCallback mOverBudgetCallback;
+        Snapshot mLastFrameSnapshot;
+        mutable std::mutex mMutex;
+    };
+
+}
@@ -0,0 +1,68 @@
+#include "PagedLinearAllocator.hpp"
+
+#include <Foundation/MemoryUtils.hpp>
+
+namespace Memory
+{
+
+    PagedLinearAllocator::PagedLinearAllocator(uint64_t pageSize)
+        : mPageSize{ pageSize } {}
+
+    std::optional<PagedLinearAllocator::Range> PagedLinearAllocator::Allocate(uint64_t sizeInBytes, uint64_t alignment)
+    {
+        assert_format(alignment > 0 && (alignment & (alignment - 1)) == 0 && mPageSize % alignment == 0, "Alignment must be a power of two dividing page size");
+
+        if (sizeInBytes == 0 || sizeInBytes > mPageSize)
+        {
+            return std::nullopt;
+        }
+
+        uint64_t cursor = mCursor.load(std::memory_order_relaxed);
+        uint64_t rangeStart = 0;
+        uint64_t pageIndex = 0;
+
+        do
+        {
+            rangeStart = Foundation::MemoryUtils::Align(cursor, alignment);
+            pageIndex = PageIndexOfRange(rangeStart, sizeInBytes);
+
+            if (pageIndex >= mPageCount)
+            {
+                uint64_t requestedPageCount = mRequestedPageCount.load(std::memory_order_relaxed);
+
+                while (requestedPageCount < pageIndex + 1 &&
+                    !mRequestedPageCount.compare_exchange_weak(requestedPageCount, pageIndex + 1, std::memory_order_relaxed)) {}
+
+                return std::nullopt;
+            }
+        }
+        while (!mCursor.compare_exchange_weak(cursor, rangeStart + sizeInBytes, std::memory_order_relaxed));
+
+        return Range{ pageIndex, rangeStart - pageIndex * mPageSize };
+    }
+
+    void PagedLinearAllocator::SetPageCount(uint64_t pageCount)
+    {
+        mPageCount = pageCount;
+    }
+
+    void PagedLinearAllocator::Reset()
+    {
+        mCursor.store(0, std::memory_order_relaxed);
+        mRequestedPageCount.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t PagedLinearAllocator::PageIndexOfRange(uint64_t& rangeStart, uint64_t size) const
+    {
+        uint64_t firstPage = rangeStart / mPageSize;
+        uint64_t lastPage = (rangeStart + size - 1) / mPageSize;
+
+        if (firstPage != lastPage)
+        {
+            rangeStart = lastPage * mPageSize;
+        }
+
+        return lastPage;
+    }
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace Memory
+{
+
+    // Lock free bump allocator over a sequence of equally sized pages.
+    // Only hands out offsets, memory behind the pages is owned by the user.
+    // Ranges never straddle pages: when the rest of a page is too small, the cursor skips to the next one.
+    //
+    // Allocate() can be called from any thread.
+    // SetPageCount() and Reset() must not run concurrently with allocations.
+
+    class PagedLinearAllocator
+    {
+    public:
+        struct Range
+        {
+            uint64_t PageIndex = 0;
+            uint64_t OffsetInPage = 0;
+        };
+
+        PagedLinearAllocator(uint64_t pageSize);
+
+        // Alignment must be a power of two that divides page size.
+        // When a range does not fit into available pages allocation fails
+        // and the page count that would have served it is remembered.
+        std::optional<Range> Allocate(uint64_t sizeInBytes, uint64_t alignment);
+
+        void SetPageCount(uint64_t pageCount);
+        void Reset();
+
+    private:
+        uint64_t PageIndexOfRange(uint64_t& rangeStart, uint64_t size) const;
+
+        uint64_t mPageSize = 0;
+        uint64_t mPageCount = 0;
+        std::atomic<uint64_t> mCursor{ 0 };
+        std::atomic<uint64_t> mRequestedPageCount{ 0 };
+
+    public:
+        inline auto PageSize() const { return mPageSize; }
+        inline auto PageCount() const { return mPageCount; }
+        inline auto UsedBytes() const { return mCursor.load(std::memory_order_relaxed); }
+        inline auto RequestedPageCount() const { return mRequestedPageCount.load(std::memory_order_relaxed); }
+    };
+
+}
@@ -1,11 +1,18 @@
 #pragma once
 
 #include <cstdint>
-#include <list>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <optional>
 
 namespace Memory
 {
 
+    /// Hands out equally sized slots of an abstract memory range.
+    /// Slots live in a contiguous array and free ones are chained into an intrusive 
+    /// index based list, so allocation and deallocation never touch the system heap.
+    /// Free slots are reused in the order they were freed.
     template <class SlotUserData = void>
     class Pool
     {
@@ -25,23 +32,65 @@ namespace Memory
 
         using SlotType = Slot<SlotUserData>;
 
+        struct Statistics
+        {
+            uint64_t SlotCount = 0;
+            uint64_t AllocatedSlotCount = 0;
+            uint64_t PeakAllocatedSlotCount = 0;
+            uint64_t GrowCount = 0;
+
+            // Share of slots currently in use
+            float Occupancy() const;
+        };
+
         Pool(uint64_t slotSize, uint64_t onGrowSlotCount);
 
         SlotType Allocate();
         void Deallocate(const SlotType& slot);
 
+        // Takes a particular free slot, if it is free
+        std::optional<SlotType> Allocate(uint64_t memoryOffset);
+
+        // Shrinks pool by whole groups of slots at its end that are all free.
+        // Returns how many groups were released.
+        uint64_t ReleaseTrailingFreeSlots(uint64_t slotsPerGroup);
+
+        bool IsFree(uint64_t memoryOffset) const;
+
+        template <class Func>
+        void ForEachFreeSlot(const Func& func) const;
+
     private:
+        static const uint64_t InvalidIndex = std::numeric_limits<uint64_t>::max();
+
+        struct SlotRecord
+        {
+            SlotType Slot;
+            uint64_t PreviousFreeIndex = InvalidIndex;
+            uint64_t NextFreeIndex = InvalidIndex;
+            bool IsFree = false;
+        };
+
         void Grow();
+        void PushFree(uint64_t index);
+        void Unlink(uint64_t index);
+        uint64_t SlotIndex(uint64_t memoryOffset) const;
+
+        std::vector<SlotRecord> mSlots;
+        uint64_t mFirstFreeIndex = InvalidIndex;
+        uint64_t mLastFreeIndex = InvalidIndex;
 
         uint64_t mGrowSlotCount = 0;
-        uint64_t mAllocatedSize = 0;
         uint64_t mSlotSize = 0;
-        std::list<SlotType> mFreeSlots;
+        Statistics mStatistics;
 
     public:
         inline auto SlotSize() const { return mSlotSize; }
+        inline auto SlotCount() const { return mSlots.size(); }
+        inline auto FreeSlotCount() const { return mSlots.size() - mStatistics.AllocatedSlotCount; }
+        inline const auto& Stats() const { return mStatistics; }
     };
 
 }
 
-#include "Pool.inl"
\ No newline at end of file
+#include "Pool.inl"
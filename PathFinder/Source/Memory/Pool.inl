@@ -1,6 +1,12 @@
 namespace Memory
 {
 
+    template <class SlotUserData>
+    float Pool<SlotUserData>::Statistics::Occupancy() const
+    {
+        return SlotCount > 0 ? float(AllocatedSlotCount) / SlotCount : 0.0f;
+    }
+
     template <class SlotUserData>
     Pool<SlotUserData>::Pool(uint64_t slotSize, uint64_t onGrowSlotCount)
         : mSlotSize{ slotSize }, mGrowSlotCount{ onGrowSlotCount } {}
@@ -8,30 +14,170 @@ namespace Memory
     template <class SlotUserData>
     void Pool<SlotUserData>::Grow()
     {
-        for (auto i = 0u; i < mGrowSlotCount; ++i)
+        uint64_t firstNewIndex = mSlots.size();
+
+        // One resize per growth, vector's geometric capacity keeps it amortized
+        mSlots.resize(firstNewIndex + mGrowSlotCount);
+
+        for (uint64_t index = firstNewIndex; index < mSlots.size(); ++index)
+        {
+            mSlots[index].Slot.MemoryOffset = index * mSlotSize;
+            PushFree(index);
+        }
+
+        mStatistics.SlotCount = mSlots.size();
+        mStatistics.GrowCount += 1;
+    }
+
+    template <class SlotUserData>
+    void Pool<SlotUserData>::PushFree(uint64_t index)
+    {
+        SlotRecord& record = mSlots[index];
+        record.IsFree = true;
+        record.PreviousFreeIndex = mLastFreeIndex;
+        record.NextFreeIndex = InvalidIndex;
+
+        if (mLastFreeIndex != InvalidIndex)
         {
-            mFreeSlots.emplace_back(SlotType{ mAllocatedSize });
-            mAllocatedSize += mSlotSize;
+            mSlots[mLastFreeIndex].NextFreeIndex = index;
         }
+        else
+        {
+            mFirstFreeIndex = index;
+        }
+
+        mLastFreeIndex = index;
+    }
+
+    template <class SlotUserData>
+    void Pool<SlotUserData>::Unlink(uint64_t index)
+    {
+        SlotRecord& record = mSlots[index];
+
+        if (record.PreviousFreeIndex != InvalidIndex)
+        {
+            mSlots[record.PreviousFreeIndex].NextFreeIndex = record.NextFreeIndex;
+        }
+        else
+        {
+            mFirstFreeIndex = record.NextFreeIndex;
+        }
+
+        if (record.NextFreeIndex != InvalidIndex)
+        {
+            mSlots[record.NextFreeIndex].PreviousFreeIndex = record.PreviousFreeIndex;
+        }
+        else
+        {
+            mLastFreeIndex = record.PreviousFreeIndex;
+        }
+
+        record.PreviousFreeIndex = InvalidIndex;
+        record.NextFreeIndex = InvalidIndex;
+        record.IsFree = false;
+    }
+
+    template <class SlotUserData>
+    uint64_t Pool<SlotUserData>::SlotIndex(uint64_t memoryOffset) const
+    {
+        return memoryOffset / mSlotSize;
     }
 
     template <class SlotUserData>
     void Pool<SlotUserData>::Deallocate(const Pool<SlotUserData>::SlotType& slot)
     {
-        mFreeSlots.push_back(slot);
+        uint64_t index = SlotIndex(slot.MemoryOffset);
+
+#if defined(DEBUG) || defined(_DEBUG)
+        assert_format(index < mSlots.size() && slot.MemoryOffset % mSlotSize == 0, "Slot does not belong to this pool");
+        assert_format(!mSlots[index].IsFree, "Slot is deallocated twice");
+#endif
+
+        // User data travels with the slot and is handed out again on reuse
+        mSlots[index].Slot = slot;
+        PushFree(index);
+        mStatistics.AllocatedSlotCount -= 1;
     }
 
     template <class SlotUserData>
     typename Pool<SlotUserData>::SlotType Pool<SlotUserData>::Allocate()
     {
-        if (mFreeSlots.empty())
+        if (mFirstFreeIndex == InvalidIndex)
         {
             Grow();
         }
 
-        Slot<SlotUserData> slot = mFreeSlots.front();
-        mFreeSlots.pop_front();
-        return slot;
+        uint64_t index = mFirstFreeIndex;
+        Unlink(index);
+
+        mStatistics.AllocatedSlotCount += 1;
+        mStatistics.PeakAllocatedSlotCount = std::max(mStatistics.PeakAllocatedSlotCount, mStatistics.AllocatedSlotCount);
+
+        return mSlots[index].Slot;
+    }
+
+    template <class SlotUserData>
+    std::optional<typename Pool<SlotUserData>::SlotType> Pool<SlotUserData>::Allocate(uint64_t memoryOffset)
+    {
+        if (!IsFree(memoryOffset))
+        {
+            return std::nullopt;
+        }
+
+        uint64_t index = SlotIndex(memoryOffset);
+        Unlink(index);
+
+        mStatistics.AllocatedSlotCount += 1;
+        mStatistics.PeakAllocatedSlotCount = std::max(mStatistics.PeakAllocatedSlotCount, mStatistics.AllocatedSlotCount);
+
+        return mSlots[index].Slot;
+    }
+
+    template <class SlotUserData>
+    uint64_t Pool<SlotUserData>::ReleaseTrailingFreeSlots(uint64_t slotsPerGroup)
+    {
+        uint64_t releasedGroupCount = 0;
+
+        while (slotsPerGroup > 0 && mSlots.size() >= slotsPerGroup)
+        {
+            uint64_t groupStart = mSlots.size() - slotsPerGroup;
+
+            for (uint64_t index = groupStart; index < mSlots.size(); ++index)
+            {
+                if (!mSlots[index].IsFree)
+                {
+                    return releasedGroupCount;
+                }
+            }
+
+            for (uint64_t index = groupStart; index < mSlots.size(); ++index)
+            {
+                Unlink(index);
+            }
+
+            mSlots.resize(groupStart);
+            mStatistics.SlotCount = mSlots.size();
+            ++releasedGroupCount;
+        }
+
+        return releasedGroupCount;
+    }
+
+    template <class SlotUserData>
+    bool Pool<SlotUserData>::IsFree(uint64_t memoryOffset) const
+    {
+        uint64_t index = SlotIndex(memoryOffset);
+        return memoryOffset % mSlotSize == 0 && index < mSlots.size() && mSlots[index].IsFree;
+    }
+
+    template <class SlotUserData>
+    template <class Func>
+    void Pool<SlotUserData>::ForEachFreeSlot(const Func& func) const
+    {
+        for (uint64_t index = mFirstFreeIndex; index != InvalidIndex; index = mSlots[index].NextFreeIndex)
+        {
+            func(mSlots[index].Slot);
+        }
     }
 
 }
@@ -3,8 +3,9 @@
 namespace Memory
 {
 
-    PoolDescriptorAllocator::PoolDescriptorAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight)
-        : mCBSRUADescriptorHeap{ device, mDescriptorRangeCapacity, mDescriptorRangeCapacity, mDescriptorRangeCapacity },
+    PoolDescriptorAllocator::PoolDescriptorAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight, MemoryBudgetTracker* budgetTracker)
+        : mBudgetTracker{ budgetTracker },
+        mCBSRUADescriptorHeap{ device, mDescriptorRangeCapacity, mDescriptorRangeCapacity, mDescriptorRangeCapacity },
         mRTDescriptorHeap{ device, mDescriptorRangeCapacity },
         mDSDescriptorHeap{ device, mDescriptorRangeCapacity },
         mSamplerDescriptorHeap{ device, mDescriptorRangeCapacity },
@@ -26,6 +27,15 @@ namespace Memory
         });
 
         mPendingDeallocations.resize(simultaneousFramesInFlight);
+
+        if (mBudgetTracker)
+        {
+            // CB/SR/UA heap consists of 3 ranges
+            mBudgetTracker->ReportHeapCreation(MemoryHeapKind::Descriptor, 3 * mDescriptorRangeCapacity * mCBSRUADescriptorHeap.IncrementSize());
+            mBudgetTracker->ReportHeapCreation(MemoryHeapKind::Descriptor, mDescriptorRangeCapacity * mRTDescriptorHeap.IncrementSize());
+            mBudgetTracker->ReportHeapCreation(MemoryHeapKind::Descriptor, mDescriptorRangeCapacity * mDSDescriptorHeap.IncrementSize());
+            mBudgetTracker->ReportHeapCreation(MemoryHeapKind::Descriptor, mDescriptorRangeCapacity * mSamplerDescriptorHeap.IncrementSize());
+        }
     }
 
     PoolDescriptorAllocator::RTDescriptorPtr PoolDescriptorAllocator::AllocateRTDescriptor(const HAL::Texture& texture, uint8_t mipLevel, std::optional<HAL::ColorFormat> shaderVisibleFormat)
@@ -33,6 +43,7 @@ namespace Memory
         ValidateRTFormatsCompatibility(texture.Format(), shaderVisibleFormat);
 
         auto slot = mRTPool.Allocate();
+        ReportAllocation(&mRTPool);
         auto descriptor = mRTDescriptorHeap.EmplaceRTDescriptor(slot.MemoryOffset, texture, mipLevel, shaderVisibleFormat);
         auto& allocation = mAllocatedRTDescriptors.emplace_back(descriptor, slot);
         auto deallocationCallback = [this, &allocation](HAL::RTDescriptor* descriptor) {
@@ -47,6 +58,7 @@ namespace Memory
         assert_format(std::holds_alternative<HAL::DepthStencilFormat>(texture.Format()), "Texture is not of depth-stencil format");
 
         auto slot = mDSPool.Allocate();
+        ReportAllocation(&mDSPool);
         auto descriptor = mDSDescriptorHeap.EmplaceDSDescriptor(slot.MemoryOffset, texture);
         auto& allocation = mAllocatedDSDescriptors.emplace_back(descriptor, slot);
         auto deallocationCallback = [this, &allocation](HAL::DSDescriptor* descriptor) {
@@ -61,6 +73,7 @@ namespace Memory
         ValidateSRUAFormatsCompatibility(texture.Format(), shaderVisibleFormat);
 
         auto slot = mSRPool.Allocate();
+        ReportAllocation(&mSRPool);
         auto descriptor = mCBSRUADescriptorHeap.EmplaceSRDescriptor(slot.MemoryOffset, texture, shaderVisibleFormat);
         auto& allocation = mAllocatedSRDescriptors.emplace_back(descriptor, slot);
         auto deallocationCallback = [this, &allocation](HAL::SRDescriptor* descriptor) {
@@ -75,6 +88,7 @@ namespace Memory
         ValidateSRUAFormatsCompatibility(texture.Format(), shaderVisibleFormat);
 
         auto slot = mUAPool.Allocate();
+        ReportAllocation(&mUAPool);
         auto descriptor = mCBSRUADescriptorHeap.EmplaceUADescriptor(slot.MemoryOffset, texture, mipLevel, shaderVisibleFormat);
         auto& allocation = mAllocatedUADescriptors.emplace_back(descriptor, slot);
         auto deallocationCallback = [this, &allocation](HAL::UADescriptor* descriptor) {
@@ -87,6 +101,7 @@ namespace Memory
     PoolDescriptorAllocator::SRDescriptorPtr PoolDescriptorAllocator::AllocateSRDescriptor(const HAL::Buffer& buffer, uint64_t stride)
     {
         auto slot = mSRPool.Allocate();
+        ReportAllocation(&mSRPool);
         auto descriptor = mCBSRUADescriptorHeap.EmplaceSRDescriptor(slot.MemoryOffset, buffer, stride);
         auto& allocation = mAllocatedSRDescriptors.emplace_back(descriptor, slot);
         auto deallocationCallback = [this, &allocation](HAL::SRDescriptor* descriptor) {
@@ -99,6 +114,7 @@ namespace Memory
     PoolDescriptorAllocator::UADescriptorPtr PoolDescriptorAllocator::AllocateUADescriptor(const HAL::Buffer& buffer, uint64_t stride)
     {
         auto slot = mUAPool.Allocate();
+        ReportAllocation(&mUAPool);
         auto descriptor = mCBSRUADescriptorHeap.EmplaceUADescriptor(slot.MemoryOffset, buffer, stride);
         auto& allocation = mAllocatedUADescriptors.emplace_back(descriptor, slot);
         auto deallocationCallback = [this, &allocation](HAL::UADescriptor* descriptor) {
@@ -111,6 +127,7 @@ namespace Memory
     PoolDescriptorAllocator::CBDescriptorPtr PoolDescriptorAllocator::AllocateCBDescriptor(const HAL::Buffer& buffer, uint64_t stride)
     {
         auto slot = mCBPool.Allocate();
+        ReportAllocation(&mCBPool);
         auto descriptor = mCBSRUADescriptorHeap.EmplaceCBDescriptor(slot.MemoryOffset, buffer, stride);
         auto& allocation = mAllocatedCBDescriptors.emplace_back(descriptor, slot);
         auto deallocationCallback = [this, &allocation](HAL::CBDescriptor* descriptor) {
@@ -123,6 +140,7 @@ namespace Memory
     PoolDescriptorAllocator::SamplerDescriptorPtr PoolDescriptorAllocator::AllocateSamplerDescriptor(const HAL::Sampler& sampler)
     {
         auto slot = mSamplerPool.Allocate();
+        ReportAllocation(&mSamplerPool);
         auto descriptor = mSamplerDescriptorHeap.EmplaceSamplerDescriptor(slot.MemoryOffset, sampler);
         auto& allocation = mAllocatedSamplerDescriptors.emplace_back(descriptor, slot);
         auto deallocationCallback = [this, &allocation](HAL::SamplerDescriptor* descriptor) {
@@ -148,10 +166,33 @@ namespace Memory
         for (Deallocation& deallocation : mPendingDeallocations[frameIndex])
         {
             deallocation.PoolPtr->Deallocate(deallocation.Slot);
+
+            if (mBudgetTracker)
+            {
+                uint64_t descriptorSize = DescriptorSize(deallocation.PoolPtr);
+                mBudgetTracker->ReportDeallocation(MemoryHeapKind::Descriptor, MemoryCategory::Descriptor, descriptorSize, descriptorSize);
+            }
         }
         mPendingDeallocations[frameIndex].clear();
     }
 
+    void PoolDescriptorAllocator::ReportAllocation(const Pool<>* pool)
+    {
+        if (mBudgetTracker)
+        {
+            uint64_t descriptorSize = DescriptorSize(pool);
+            mBudgetTracker->ReportAllocation(MemoryHeapKind::Descriptor, MemoryCategory::Descriptor, descriptorSize, descriptorSize);
+        }
+    }
+
+    uint64_t PoolDescriptorAllocator::DescriptorSize(const Pool<>* pool) const
+    {
+        if (pool == &mRTPool) return mRTDescriptorHeap.IncrementSize();
+        if (pool == &mDSPool) return mDSDescriptorHeap.IncrementSize();
+        if (pool == &mSamplerPool) return mSamplerDescriptorHeap.IncrementSize();
+        return mCBSRUADescriptorHeap.IncrementSize();
+    }
+
     void PoolDescriptorAllocator::ValidateRTFormatsCompatibility(
         HAL::FormatVariant textureFormat, std::optional<HAL::ColorFormat> shaderVisibleFormat)
     {
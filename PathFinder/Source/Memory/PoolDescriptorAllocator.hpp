@@ -2,6 +2,7 @@
 
 #include "Pool.hpp"
 #include "Ring.hpp"
+#include "MemoryBudgetTracker.hpp"
 
 #include <HardwareAbstractionLayer/DescriptorHeap.hpp>
 #include <HardwareAbstractionLayer/Buffer.hpp>
@@ -17,7 +18,7 @@ namespace Memory
     class PoolDescriptorAllocator
     {
     public:
-        PoolDescriptorAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight);
+        PoolDescriptorAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight, MemoryBudgetTracker* budgetTracker);
 
         template <class DescriptorT>
         using DescriptorPtr = std::unique_ptr<DescriptorT, std::function<void(DescriptorT*)>>;
@@ -64,11 +65,14 @@ namespace Memory
         };
 
         void ExecutePendingDeallocations(uint64_t frameIndex);
+        void ReportAllocation(const Pool<>* pool);
+        uint64_t DescriptorSize(const Pool<>* pool) const;
         void ValidateRTFormatsCompatibility(HAL::FormatVariant textureFormat, std::optional<HAL::ColorFormat> shaderVisibleFormat);
         void ValidateSRUAFormatsCompatibility(HAL::FormatVariant textureFormat, std::optional<HAL::ColorFormat> shaderVisibleFormat);
 
         uint64_t mDescriptorRangeCapacity = 1000;
         uint64_t mCurrentFrameIndex = 0;
+        MemoryBudgetTracker* mBudgetTracker = nullptr;
 
         HAL::CBSRUADescriptorHeap mCBSRUADescriptorHeap;
         HAL::RTDescriptorHeap mRTDescriptorHeap;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Pool.hpp"
+#include "SizeClassMap.hpp"
 
 #include <vector>
 
@@ -10,6 +11,15 @@ namespace Memory
     template <class BucketUserData = void, class SlotUserData = void>
     class SegregatedPools;
 
+    // Live allocations of a bucket. Waste is the memory lost to rounding requests up to slot size.
+    struct SegregatedPoolsBucketStatistics
+    {
+        uint64_t AllocationCount = 0;
+        uint64_t RequestedBytes = 0;
+        uint64_t WastedBytes = 0;
+        uint64_t PeakWastedBytes = 0;
+    };
+
     template <
         class BucketUserData, // User data to associate with each bucket
         class SlotUserData // User data to associate with each individual slot in a bucket
@@ -17,6 +27,8 @@ namespace Memory
     struct SegregatedPoolsBucket
     {
     public:
+        using Statistics = SegregatedPoolsBucketStatistics;
+
         SegregatedPoolsBucket(uint64_t slotSize, uint64_t onGrowSlotCount);
 
         BucketUserData UserData;
@@ -27,9 +39,12 @@ namespace Memory
         Pool<SlotUserData> mSlots;
         uint64_t mSlotSize = 1;
         uint64_t mBucketIndex = 0;
+        Statistics mStatistics;
 
     public:
         inline auto SlotSize() const { return mSlotSize; }
+        inline const auto& Slots() const { return mSlots; }
+        inline const auto& Stats() const { return mStatistics; }
     };
 
 
@@ -39,11 +54,13 @@ namespace Memory
     {
         uint64_t BucketIndex;
         typename Pool<SlotUserData>::SlotType Slot;
+        uint64_t RequestedSize = 0;
     };
 
 
     /// Maintains a list of buckets each represented by a Pool
-    /// and segregated by Pool's element (slot) size
+    /// and segregated by Pool's element (slot) size.
+    /// Slot sizes are multiples of minimum slot size, see SizeClassMap for how they are distributed.
     template <class BucketUserData, class SlotUserData>
     class SegregatedPools
     {
@@ -51,22 +68,29 @@ namespace Memory
         using Allocation = SegregatedPoolsAllocation<BucketUserData, SlotUserData>;
         using Bucket = SegregatedPoolsBucket<BucketUserData, SlotUserData>;
 
-        SegregatedPools(uint64_t minimumBucketSlotSize, uint64_t bucketGrowSlotCount);
+        SegregatedPools(uint64_t minimumBucketSlotSize, uint64_t bucketGrowSlotCount, uint64_t subBucketCount = 1);
 
         uint64_t SlotSizeInBucket(uint64_t bucketIndex) const;
         Bucket& GetBucket(uint64_t index);
+        const Bucket& GetBucket(uint64_t index) const;
 
         Allocation Allocate(uint64_t allocationSize);
         void Deallocate(const Allocation& allocation);
 
+        // Takes a particular free slot of a bucket, used to relocate existing allocations
+        std::optional<Allocation> AllocateInBucket(uint64_t bucketIndex, uint64_t memoryOffset, uint64_t allocationSize);
+        uint64_t ReleaseTrailingFreeSlots(uint64_t bucketIndex, uint64_t slotsPerGroup);
+
     private:
-        uint64_t CeilToClosestPowerOf2(uint64_t value);
-        uint32_t CalculateBucketIndex(uint64_t allocationSize);
+        void ReportAllocation(Bucket& bucket, uint64_t allocationSize);
 
         std::vector<Bucket> mBuckets;
+        SizeClassMap mSizeClasses;
 
-        uint64_t mMinimumBucketSlotSize = 4096;
         uint64_t mGrowSlotCount = 0;
+
+    public:
+        inline auto BucketCount() const { return mBuckets.size(); }
     };
 
 }
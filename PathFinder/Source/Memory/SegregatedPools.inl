@@ -1,5 +1,4 @@
-#include <cmath>
-
+#include <algorithm>
 
 namespace Memory
 {
@@ -12,73 +11,99 @@ namespace Memory
 
 
     template <class BucketUserData, class SlotUserData>
-    SegregatedPools<BucketUserData, SlotUserData>::SegregatedPools(uint64_t minimumBucketSlotSize, uint64_t bucketGrowSlotCount)
-        : mMinimumBucketSlotSize{ minimumBucketSlotSize }, mGrowSlotCount{ bucketGrowSlotCount } {}
+    SegregatedPools<BucketUserData, SlotUserData>::SegregatedPools(uint64_t minimumBucketSlotSize, uint64_t bucketGrowSlotCount, uint64_t subBucketCount)
+        : mSizeClasses{ minimumBucketSlotSize, subBucketCount }, mGrowSlotCount{ bucketGrowSlotCount } {}
 
     template <class BucketUserData, class SlotUserData>
-    uint32_t SegregatedPools<BucketUserData, SlotUserData>::CalculateBucketIndex(uint64_t allocationSize)
+    uint64_t SegregatedPools<BucketUserData, SlotUserData>::SlotSizeInBucket(uint64_t bucketIndex) const
     {
-        auto valueLog = std::log2f((float)allocationSize);
-        return std::ceil(valueLog);
+        return mBuckets[bucketIndex].mSlotSize;
     }
 
     template <class BucketUserData, class SlotUserData>
-    uint64_t SegregatedPools<BucketUserData, SlotUserData>::CeilToClosestPowerOf2(uint64_t value)
+    typename SegregatedPools<BucketUserData, SlotUserData>::Bucket& 
+        SegregatedPools<BucketUserData, SlotUserData>::GetBucket(uint64_t index)
     {
-        auto valueLog = std::log2f((float)value);
-        auto newPowerOf2 = std::ceil(value);
-        return std::powf(2.0f, newPowerOf2);
+        return mBuckets[index];
     }
 
     template <class BucketUserData, class SlotUserData>
-    uint64_t SegregatedPools<BucketUserData, SlotUserData>::SlotSizeInBucket(uint64_t bucketIndex) const
+    const typename SegregatedPools<BucketUserData, SlotUserData>::Bucket&
+        SegregatedPools<BucketUserData, SlotUserData>::GetBucket(uint64_t index) const
     {
-        return mBuckets[bucketIndex].mSlotSize;
+        return mBuckets[index];
     }
 
     template <class BucketUserData, class SlotUserData>
-    typename SegregatedPools<BucketUserData, SlotUserData>::Bucket& 
-        SegregatedPools<BucketUserData, SlotUserData>::GetBucket(uint64_t index)
+    typename SegregatedPools<BucketUserData, SlotUserData>::Allocation
+        SegregatedPools<BucketUserData, SlotUserData>::Allocate(uint64_t allocationSize)
     {
-        return mBuckets[index];
+        uint64_t bucketIndex = mSizeClasses.ClassIndex(allocationSize);
+
+        // Create missing pools if existing pools do not satisfy allocation memory requirement
+        while (bucketIndex >= mBuckets.size())
+        {
+            uint64_t newBucketIndex = mBuckets.size();
+            uint64_t slotSize = mSizeClasses.ClassSize(newBucketIndex);
+            auto& bucket = mBuckets.emplace_back(slotSize, mGrowSlotCount);
+            bucket.mBucketIndex = newBucketIndex;
+            bucket.mSlotSize = slotSize;
+        }
+
+        Bucket& bucket = mBuckets[bucketIndex];
+        ReportAllocation(bucket, allocationSize);
+
+        return { bucketIndex, bucket.mSlots.Allocate(), allocationSize };
     }
 
     template <class BucketUserData, class SlotUserData>
-    typename SegregatedPools<BucketUserData, SlotUserData>::Allocation
-        SegregatedPools<BucketUserData, SlotUserData>::Allocate(uint64_t allocationSize)
+    std::optional<typename SegregatedPools<BucketUserData, SlotUserData>::Allocation>
+        SegregatedPools<BucketUserData, SlotUserData>::AllocateInBucket(uint64_t bucketIndex, uint64_t memoryOffset, uint64_t allocationSize)
     {
-        assert_format(allocationSize >= mMinimumBucketSlotSize,
-            "Requested allocation is smaller than the minimum provided to allocator at construction");
+        Bucket& bucket = mBuckets[bucketIndex];
 
-        auto bucketIndex = CalculateBucketIndex(allocationSize);
+        assert_format(allocationSize <= bucket.mSlotSize, "Allocation does not fit into bucket's slots");
 
-        // Create missing pools if existing pools do not satisfy allocation memory requirement
-        if (bucketIndex >= mBuckets.size())
+        std::optional<typename Pool<SlotUserData>::SlotType> slot = bucket.mSlots.Allocate(memoryOffset);
+
+        if (!slot)
         {
-            auto numberOfBucketsToAdd = (bucketIndex + 1) - mBuckets.size();
-          
-            for (auto i = 0; i < numberOfBucketsToAdd; ++i)
-            {
-                uint64_t newBucketIndex = mBuckets.size();
-                uint64_t slotSize = std::powf(2.0f, newBucketIndex);
-                auto& bucket = mBuckets.emplace_back(slotSize, mGrowSlotCount);
-                bucket.mBucketIndex = newBucketIndex;
-                bucket.mSlotSize = slotSize;
-
-                if (newBucketIndex > 50)
-                {
-                    printf("");
-                }
-            }
+            return std::nullopt;
         }
 
-        return { bucketIndex, mBuckets[bucketIndex].mSlots.Allocate() };
+        ReportAllocation(bucket, allocationSize);
+
+        return Allocation{ bucketIndex, *slot, allocationSize };
+    }
+
+    template <class BucketUserData, class SlotUserData>
+    uint64_t SegregatedPools<BucketUserData, SlotUserData>::ReleaseTrailingFreeSlots(uint64_t bucketIndex, uint64_t slotsPerGroup)
+    {
+        return mBuckets[bucketIndex].mSlots.ReleaseTrailingFreeSlots(slotsPerGroup);
     }
 
     template <class BucketUserData, class SlotUserData>
     void SegregatedPools<BucketUserData, SlotUserData>::Deallocate(const SegregatedPools<BucketUserData, SlotUserData>::Allocation& allocation)
     {
-        mBuckets[allocation.BucketIndex].mSlots.Deallocate(allocation.Slot);
+        Bucket& bucket = mBuckets[allocation.BucketIndex];
+        typename Bucket::Statistics& stats = bucket.mStatistics;
+
+        stats.AllocationCount -= 1;
+        stats.RequestedBytes -= allocation.RequestedSize;
+        stats.WastedBytes -= bucket.mSlotSize - allocation.RequestedSize;
+
+        bucket.mSlots.Deallocate(allocation.Slot);
+    }
+
+    template <class BucketUserData, class SlotUserData>
+    void SegregatedPools<BucketUserData, SlotUserData>::ReportAllocation(Bucket& bucket, uint64_t allocationSize)
+    {
+        typename Bucket::Statistics& stats = bucket.mStatistics;
+
+        stats.AllocationCount += 1;
+        stats.RequestedBytes += allocationSize;
+        stats.WastedBytes += bucket.mSlotSize - allocationSize;
+        stats.PeakWastedBytes = std::max(stats.PeakWastedBytes, stats.WastedBytes);
     }
 
 }
@@ -3,17 +3,18 @@
 namespace Memory
 {
 
-    SegregatedPoolsResourceAllocator::SegregatedPoolsResourceAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight)
+    SegregatedPoolsResourceAllocator::SegregatedPoolsResourceAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight, MemoryBudgetTracker* budgetTracker)
         : mDevice{ device }, 
+        mBudgetTracker{ budgetTracker },
         mRingFrameTracker{ simultaneousFramesInFlight },
         mSimultaneousFramesInFlight{ simultaneousFramesInFlight },
-        mUploadPools{ mMinimumSlotSize, mOnGrowSlotCount },
-        mReadbackPools{ mMinimumSlotSize, mOnGrowSlotCount },
-        mDefaultUniversalOrBufferPools{ mMinimumSlotSize, mOnGrowSlotCount },
-        mDefaultRTDSPools{ mMinimumSlotSize, mOnGrowSlotCount },
-        mDefaultNonRTDSPools{ mMinimumSlotSize, mOnGrowSlotCount }
+        mMinimumSlotSize{ device->MinimumHeapSize() / mOnGrowSlotCount },
+        mUploadPools{ mMinimumSlotSize, mOnGrowSlotCount, mSubBucketCount },
+        mReadbackPools{ mMinimumSlotSize, mOnGrowSlotCount, mSubBucketCount },
+        mDefaultUniversalOrBufferPools{ mMinimumSlotSize, mOnGrowSlotCount, mSubBucketCount },
+        mDefaultRTDSPools{ mMinimumSlotSize, mOnGrowSlotCount, mSubBucketCount },
+        mDefaultNonRTDSPools{ mMinimumSlotSize, mOnGrowSlotCount, mSubBucketCount }
     {
-        mMinimumSlotSize = device->MinimumHeapSize() / mOnGrowSlotCount;
         mPendingDeallocations.resize(simultaneousFramesInFlight);
 
         mRingFrameTracker.SetDeallocationCallback([this](const Ring::FrameTailAttributes& frameAttributes)
@@ -23,66 +24,186 @@ namespace Memory
         });
     }
 
-    SegregatedPoolsResourceAllocator::BufferPtr SegregatedPoolsResourceAllocator::AllocateBuffer(const HAL::BufferProperties& properties, std::optional<HAL::CPUAccessibleHeapType> heapType)
+    SegregatedPoolsResourceAllocator::BufferPtr SegregatedPoolsResourceAllocator::AllocateBuffer(
+        const HAL::BufferProperties& properties, std::optional<HAL::CPUAccessibleHeapType> heapType, std::optional<MemoryCategory> category)
     {
         HAL::ResourceFormat format{ mDevice, properties };
         Allocation allocation = FindOrAllocateMostFittingFreeSlot(format.ResourceSizeInBytes(), format, heapType);
         PoolsAllocation& poolAllocation = allocation.PoolAllocation;
 
-        auto offsetInHeap = AdjustMemoryOffsetToPointInsideHeap(allocation);
+        MemoryCategory deducedCategory = MemoryCategory::Other;
 
-        // If CPU accessible buffer is requested
         if (heapType)
         {
-            // We can search for existing one
-            if (!poolAllocation.Slot.UserData.Buffer)
-            {
-                // We need CPU accessible buffers to match slot size so that they can be reused properly
-                HAL::BufferProperties cpuAccessibleBufferProperties{ allocation.PoolsPtr->SlotSizeInBucket(poolAllocation.BucketIndex) };
+            deducedCategory = *heapType == HAL::CPUAccessibleHeapType::Upload ? MemoryCategory::Upload : MemoryCategory::Readback;
+        }
 
-                // Allocate buffer with slot size, not requested size, to make it more generic and suitable for later reuse in other allocations
-                poolAllocation.Slot.UserData.Buffer = new HAL::Buffer{ *mDevice, cpuAccessibleBufferProperties, *allocation.HeapPtr, offsetInHeap };
-            }
+        // The design decision is to recreate buffers in default memory due to different state requirements unlike upload/readback 
+        if (!heapType)
+        {
+            return PlaceDefaultMemoryBuffer(allocation, properties, format.ResourceSizeInBytes(), category.value_or(deducedCategory));
+        }
 
-            auto deallocationCallback = [this, poolAllocation, poolsThatProducedAllocation = allocation.PoolsPtr](HAL::Buffer* buffer)
-            {
-                // Do not pass cpu accessible resource for deallocation. We can reuse it later.
-                mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ buffer, poolAllocation, poolsThatProducedAllocation, true });
-            };
+        AccountingInfo accounting = ReportAllocation(allocation, format.ResourceSizeInBytes(), category.value_or(deducedCategory));
+        auto offsetInHeap = AdjustMemoryOffsetToPointInsideHeap(allocation);
 
-            // Create unique_ptr with already existing buffer ptr that's being reused
-            return BufferPtr{ poolAllocation.Slot.UserData.Buffer, deallocationCallback };
-        }
-        else
+        // We can search for existing one
+        if (!poolAllocation.Slot.UserData.Buffer)
         {
-            auto deallocationCallback = [this, poolAllocation, poolsThatProducedAllocation = allocation.PoolsPtr](HAL::Buffer* buffer)
-            {
-                mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ buffer, poolAllocation, poolsThatProducedAllocation, false });
-            };
-
-            HAL::Buffer* buffer = new HAL::Buffer{ *mDevice, properties, *allocation.HeapPtr, offsetInHeap };
+            // We need CPU accessible buffers to match slot size so that they can be reused properly
+            HAL::BufferProperties cpuAccessibleBufferProperties{ allocation.PoolsPtr->SlotSizeInBucket(poolAllocation.BucketIndex) };
 
-            // The design decision is to recreate buffers in default memory due to different state requirements unlike upload/readback 
-            return BufferPtr{ buffer, deallocationCallback };
+            // Allocate buffer with slot size, not requested size, to make it more generic and suitable for later reuse in other allocations
+            poolAllocation.Slot.UserData.Buffer = new HAL::Buffer{ *mDevice, cpuAccessibleBufferProperties, *allocation.HeapPtr, offsetInHeap };
         }
+
+        auto deallocationCallback = [this, poolAllocation, accounting, poolsThatProducedAllocation = allocation.PoolsPtr](HAL::Buffer* buffer)
+        {
+            // Do not pass cpu accessible resource for deallocation. We can reuse it later.
+            mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ buffer, poolAllocation, poolsThatProducedAllocation, true, accounting });
+        };
+
+        // Create unique_ptr with already existing buffer ptr that's being reused
+        return BufferPtr{ poolAllocation.Slot.UserData.Buffer, deallocationCallback };
     }
 
-    SegregatedPoolsResourceAllocator::TexturePtr SegregatedPoolsResourceAllocator::AllocateTexture(const HAL::TextureProperties& properties)
+    SegregatedPoolsResourceAllocator::TexturePtr SegregatedPoolsResourceAllocator::AllocateTexture(const HAL::TextureProperties& properties, std::optional<MemoryCategory> category)
     {
         HAL::ResourceFormat format{ mDevice, properties };
         Allocation allocation = FindOrAllocateMostFittingFreeSlot(format.ResourceSizeInBytes(), format, std::nullopt);
-        PoolsAllocation& poolAllocation = allocation.PoolAllocation;
 
-        auto offsetInHeap = AdjustMemoryOffsetToPointInsideHeap(allocation);
+        return PlaceTexture(allocation, properties, format.ResourceSizeInBytes(), category.value_or(MemoryCategory::SceneTexture));
+    }
+
+    void SegregatedPoolsResourceAllocator::MakeMovable(const HAL::Texture* texture, const HAL::TextureProperties& properties, const TextureRelocationHandler& handler)
+    {
+        auto placementIt = mDefaultMemoryPlacements.find(texture);
+        assert_format(placementIt != mDefaultMemoryPlacements.end(), "Texture was not allocated by this allocator");
 
-        auto deallocationCallback = [this, poolAllocation, poolsThatProducedAllocation = allocation.PoolsPtr](HAL::Texture* texture)
+        Placement& placement = placementIt->second;
+        placement.IsRelocating = false;
+        placement.Relocate = [this, properties, handler, accounting = placement.Accounting](const Allocation& newAllocation)
         {
-            mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ texture, poolAllocation, poolsThatProducedAllocation, false });
+            return handler(PlaceTexture(newAllocation, properties, accounting.RequestedBytes, accounting.Category));
         };
+    }
 
-        HAL::Texture* texture = new HAL::Texture{ *mDevice, *allocation.HeapPtr, offsetInHeap, properties };
+    void SegregatedPoolsResourceAllocator::MakeMovable(const HAL::Buffer* buffer, const HAL::BufferProperties& properties, const BufferRelocationHandler& handler)
+    {
+        auto placementIt = mDefaultMemoryPlacements.find(buffer);
+        assert_format(placementIt != mDefaultMemoryPlacements.end(), "Buffer was not allocated in default memory by this allocator");
 
-        return TexturePtr{ texture, deallocationCallback };
+        Placement& placement = placementIt->second;
+        placement.IsRelocating = false;
+        placement.Relocate = [this, properties, handler, accounting = placement.Accounting](const Allocation& newAllocation)
+        {
+            return handler(PlaceDefaultMemoryBuffer(newAllocation, properties, accounting.RequestedBytes, accounting.Category));
+        };
+    }
+
+    void SegregatedPoolsResourceAllocator::Defragment(uint64_t byteBudget)
+    {
+        for (const DefaultMemoryPools& pools : AllDefaultMemoryPools())
+        {
+            ReleaseUnusedHeaps(pools);
+        }
+
+        if (byteBudget == 0)
+        {
+            return;
+        }
+
+        mPlannedPoolStates.clear();
+        mPlannedBlocks.clear();
+        mPlannedBuckets.clear();
+        mPlannedResources.clear();
+
+        // Every bucket of every default memory pool family is a separate pool for the planner
+        for (const DefaultMemoryPools& pools : AllDefaultMemoryPools())
+        {
+            for (uint64_t bucketIndex = 0; bucketIndex < pools.PoolsPtr->BucketCount(); ++bucketIndex)
+            {
+                const Pool<SlotUserData>& slots = pools.PoolsPtr->GetBucket(bucketIndex).Slots();
+
+                if (slots.SlotCount() == 0)
+                {
+                    continue;
+                }
+
+                DefragmentationPlanner::PoolState& state = mPlannedPoolStates.emplace_back();
+                state.SlotSize = slots.SlotSize();
+                state.SlotCount = slots.SlotCount();
+                state.SlotsPerHeap = mOnGrowSlotCount;
+
+                slots.ForEachFreeSlot([&state, &slots](const Pool<SlotUserData>::SlotType& freeSlot)
+                {
+                    state.FreeSlots.push_back(freeSlot.MemoryOffset / slots.SlotSize());
+                });
+
+                mPlannedBuckets.push_back({ pools, bucketIndex });
+            }
+        }
+
+        for (auto& [resource, placement] : mDefaultMemoryPlacements)
+        {
+            if (!placement.Relocate || placement.IsRelocating)
+            {
+                continue;
+            }
+
+            auto bucketIt = std::find_if(mPlannedBuckets.begin(), mPlannedBuckets.end(), [&placement](const PlannedBucket& bucket)
+            {
+                return bucket.Family.PoolsPtr == placement.PoolsPtr && bucket.BucketIndex == placement.PoolAllocation.BucketIndex;
+            });
+
+            uint64_t slotSize = placement.PoolsPtr->SlotSizeInBucket(placement.PoolAllocation.BucketIndex);
+
+            mPlannedBlocks.push_back({ mPlannedResources.size(), uint64_t(bucketIt - mPlannedBuckets.begin()), placement.PoolAllocation.Slot.MemoryOffset / slotSize });
+            mPlannedResources.push_back(resource);
+        }
+
+        DefragmentationPlanner::Plan plan = mDefragmentationPlanner.BuildPlan(mPlannedPoolStates, mPlannedBlocks, byteBudget);
+
+        for (const DefragmentationPlanner::Move& move : plan.Moves)
+        {
+            const PlannedBucket& bucket = mPlannedBuckets[move.PoolIndex];
+            uint64_t slotSize = mPlannedPoolStates[move.PoolIndex].SlotSize;
+
+            // Placement map is node based, so the reference survives insertion of the new resource
+            Placement& placement = mDefaultMemoryPlacements.find(mPlannedResources[move.BlockID])->second;
+
+            std::optional<PoolsAllocation> destination = bucket.Family.PoolsPtr->AllocateInBucket(
+                bucket.BucketIndex, move.DestinationSlot * slotSize, placement.PoolAllocation.RequestedSize);
+
+            assert_format(destination, "Planned destination slot is not free");
+            placement.IsRelocating = placement.Relocate(AllocationInExistingHeap(*destination, bucket.Family));
+
+            if (placement.IsRelocating)
+            {
+                mDefragmentationStatistics.MoveCount += 1;
+                mDefragmentationStatistics.MovedBytes += slotSize;
+            }
+        }
+    }
+
+    void SegregatedPoolsResourceAllocator::EnumerateSizeClasses(const SizeClassStatisticsCallback& callback) const
+    {
+        std::array<std::pair<const Pools*, MemoryHeapKind>, 5> allPools{ {
+            { &mUploadPools, MemoryHeapKind::Upload },
+            { &mReadbackPools, MemoryHeapKind::Readback },
+            { &mDefaultUniversalOrBufferPools, MemoryHeapKind::DefaultUniversalOrBuffer },
+            { &mDefaultRTDSPools, MemoryHeapKind::DefaultRTDS },
+            { &mDefaultNonRTDSPools, MemoryHeapKind::DefaultNonRTDS }
+        } };
+
+        for (auto [pools, heapKind] : allPools)
+        {
+            for (uint64_t bucketIndex = 0; bucketIndex < pools->BucketCount(); ++bucketIndex)
+            {
+                const PoolsBucket& bucket = pools->GetBucket(bucketIndex);
+                callback(heapKind, bucket.SlotSize(), bucket.Stats());
+            }
+        }
     }
 
     void SegregatedPoolsResourceAllocator::BeginFrame(uint64_t frameNumber)
@@ -104,6 +225,7 @@ namespace Memory
 
         Pools* pools = nullptr;
         std::vector<HeapList>* heapLists = nullptr;
+        MemoryHeapKind heapKind = MemoryHeapKind::DefaultUniversalOrBuffer;
 
         if (cpuHeapType)
         {
@@ -112,11 +234,13 @@ namespace Memory
             case HAL::CPUAccessibleHeapType::Upload:
                 pools = &mUploadPools;
                 heapLists = &mUploadHeapLists;
+                heapKind = MemoryHeapKind::Upload;
                 break;
 
             case HAL::CPUAccessibleHeapType::Readback:
                 pools = &mReadbackPools;
                 heapLists = &mReadbackHeapLists;
+                heapKind = MemoryHeapKind::Readback;
                 break;
             }
         }
@@ -128,16 +252,19 @@ namespace Memory
             case HAL::HeapAliasingGroup::Buffers:
                 pools = &mDefaultUniversalOrBufferPools;
                 heapLists = &mDefaultUniversalOrBufferHeapLists;
+                heapKind = MemoryHeapKind::DefaultUniversalOrBuffer;
                 break;
 
             case HAL::HeapAliasingGroup::RTDSTextures:
                 pools = &mDefaultRTDSPools;
                 heapLists = &mDefaultRTDSHeapLists;
+                heapKind = MemoryHeapKind::DefaultRTDS;
                 break;
 
             case HAL::HeapAliasingGroup::NonRTDSTextures:
                 pools = &mDefaultNonRTDSPools;
                 heapLists = &mDefaultNonRTDSHeapLists;
+                heapKind = MemoryHeapKind::DefaultNonRTDS;
                 break;
             }
         }
@@ -171,6 +298,8 @@ namespace Memory
         {
             auto newHeapSize = mOnGrowSlotCount * bucket.SlotSize();
             heapsList.emplace_back(*mDevice, newHeapSize, resourceFormat.ResourceAliasingGroup(), cpuHeapType);
+
+            if (mBudgetTracker) mBudgetTracker->ReportHeapCreation(heapKind, newHeapSize);
         }
 
         // Heap definitely exists at this point but its index is not recorded in the slot,
@@ -180,7 +309,106 @@ namespace Memory
             allocation.Slot.UserData.HeapIndex = heapsList.size() - 1;
         }
 
-        return { allocation, pools, &heapsList[*allocation.Slot.UserData.HeapIndex] };
+        return { allocation, pools, &heapsList[*allocation.Slot.UserData.HeapIndex], heapKind };
+    }
+
+    SegregatedPoolsResourceAllocator::TexturePtr SegregatedPoolsResourceAllocator::PlaceTexture(
+        const Allocation& allocation, const HAL::TextureProperties& properties, uint64_t requestedBytes, MemoryCategory category)
+    {
+        const PoolsAllocation& poolAllocation = allocation.PoolAllocation;
+
+        auto offsetInHeap = AdjustMemoryOffsetToPointInsideHeap(allocation);
+        AccountingInfo accounting = ReportAllocation(allocation, requestedBytes, category);
+
+        auto deallocationCallback = [this, poolAllocation, accounting, poolsThatProducedAllocation = allocation.PoolsPtr](HAL::Texture* texture)
+        {
+            mDefaultMemoryPlacements.erase(texture);
+            mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ texture, poolAllocation, poolsThatProducedAllocation, false, accounting });
+        };
+
+        HAL::Texture* texture = new HAL::Texture{ *mDevice, *allocation.HeapPtr, offsetInHeap, properties };
+        TrackPlacement(texture, allocation, accounting);
+
+        return TexturePtr{ texture, deallocationCallback };
+    }
+
+    SegregatedPoolsResourceAllocator::BufferPtr SegregatedPoolsResourceAllocator::PlaceDefaultMemoryBuffer(
+        const Allocation& allocation, const HAL::BufferProperties& properties, uint64_t requestedBytes, MemoryCategory category)
+    {
+        const PoolsAllocation& poolAllocation = allocation.PoolAllocation;
+
+        auto offsetInHeap = AdjustMemoryOffsetToPointInsideHeap(allocation);
+        AccountingInfo accounting = ReportAllocation(allocation, requestedBytes, category);
+
+        auto deallocationCallback = [this, poolAllocation, accounting, poolsThatProducedAllocation = allocation.PoolsPtr](HAL::Buffer* buffer)
+        {
+            mDefaultMemoryPlacements.erase(buffer);
+            mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ buffer, poolAllocation, poolsThatProducedAllocation, false, accounting });
+        };
+
+        HAL::Buffer* buffer = new HAL::Buffer{ *mDevice, properties, *allocation.HeapPtr, offsetInHeap };
+        TrackPlacement(buffer, allocation, accounting);
+
+        return BufferPtr{ buffer, deallocationCallback };
+    }
+
+    void SegregatedPoolsResourceAllocator::TrackPlacement(const HAL::Resource* resource, const Allocation& allocation, const AccountingInfo& accounting)
+    {
+        Placement& placement = mDefaultMemoryPlacements[resource];
+        placement.PoolAllocation = allocation.PoolAllocation;
+        placement.PoolsPtr = allocation.PoolsPtr;
+        placement.Accounting = accounting;
+    }
+
+    SegregatedPoolsResourceAllocator::Allocation SegregatedPoolsResourceAllocator::AllocationInExistingHeap(
+        const PoolsAllocation& poolAllocation, const DefaultMemoryPools& pools)
+    {
+        PoolsBucket& bucket = pools.PoolsPtr->GetBucket(poolAllocation.BucketIndex);
+        HeapList& heaps = pools.HeapLists->at(*bucket.UserData.HeapListIndex);
+
+        // Heaps are created in order of pool growth, one per OnGrowSlotCount slots
+        uint64_t bytesPerHeap = mOnGrowSlotCount * bucket.SlotSize();
+        uint64_t heapIndex = poolAllocation.Slot.MemoryOffset / bytesPerHeap;
+
+        assert_format(heapIndex < heaps.size(), "Slot is not backed by a heap");
+
+        Allocation allocation{ poolAllocation, pools.PoolsPtr, &heaps[heapIndex], pools.HeapKind };
+        allocation.PoolAllocation.Slot.UserData.HeapIndex = heapIndex;
+
+        return allocation;
+    }
+
+    void SegregatedPoolsResourceAllocator::ReleaseUnusedHeaps(const DefaultMemoryPools& pools)
+    {
+        for (uint64_t bucketIndex = 0; bucketIndex < pools.PoolsPtr->BucketCount(); ++bucketIndex)
+        {
+            PoolsBucket& bucket = pools.PoolsPtr->GetBucket(bucketIndex);
+
+            if (!bucket.UserData.HeapListIndex)
+            {
+                continue;
+            }
+
+            HeapList& heaps = pools.HeapLists->at(*bucket.UserData.HeapListIndex);
+            uint64_t releasedHeapCount = pools.PoolsPtr->ReleaseTrailingFreeSlots(bucketIndex, mOnGrowSlotCount);
+
+            for (uint64_t i = 0; i < releasedHeapCount; ++i)
+            {
+                if (mBudgetTracker) mBudgetTracker->ReportHeapDestruction(pools.HeapKind, mOnGrowSlotCount * bucket.SlotSize());
+                heaps.pop_back();
+            }
+
+            mDefragmentationStatistics.ReleasedHeapCount += releasedHeapCount;
+        }
+    }
+
+    std::array<SegregatedPoolsResourceAllocator::DefaultMemoryPools, 3> SegregatedPoolsResourceAllocator::AllDefaultMemoryPools()
+    {
+        return { {
+            { &mDefaultUniversalOrBufferPools, &mDefaultUniversalOrBufferHeapLists, MemoryHeapKind::DefaultUniversalOrBuffer },
+            { &mDefaultRTDSPools, &mDefaultRTDSHeapLists, MemoryHeapKind::DefaultRTDS },
+            { &mDefaultNonRTDSPools, &mDefaultNonRTDSHeapLists, MemoryHeapKind::DefaultNonRTDS }
+        } };
     }
 
     uint64_t SegregatedPoolsResourceAllocator::AdjustMemoryOffsetToPointInsideHeap(const SegregatedPoolsResourceAllocator::Allocation& allocation)
@@ -194,10 +422,25 @@ namespace Memory
         return localOffset;
     }
 
+    SegregatedPoolsResourceAllocator::AccountingInfo SegregatedPoolsResourceAllocator::ReportAllocation(
+        const Allocation& allocation, uint64_t requestedBytes, MemoryCategory category)
+    {
+        // Whole slot is occupied regardless of requested size
+        uint64_t reservedBytes = allocation.PoolsPtr->SlotSizeInBucket(allocation.PoolAllocation.BucketIndex);
+        AccountingInfo accounting{ allocation.HeapKind, category, requestedBytes, reservedBytes };
+
+        if (mBudgetTracker) mBudgetTracker->ReportAllocation(accounting.HeapKind, accounting.Category, accounting.RequestedBytes, accounting.ReservedBytes);
+
+        return accounting;
+    }
+
     void SegregatedPoolsResourceAllocator::ExecutePendingDeallocations(uint64_t frameIndex)
     {
         for (Deallocation& deallocation : mPendingDeallocations[frameIndex])
         {
+            const AccountingInfo& accounting = deallocation.Accounting;
+            if (mBudgetTracker) mBudgetTracker->ReportDeallocation(accounting.HeapKind, accounting.Category, accounting.RequestedBytes, accounting.ReservedBytes);
+
             if (!deallocation.ResourceWillBeReused)
             {
                 delete deallocation.Resource;
@@ -2,13 +2,18 @@
 
 #include "SegregatedPools.hpp"
 #include "Ring.hpp"
+#include "MemoryBudgetTracker.hpp"
+#include "DefragmentationPlanner.hpp"
 
 #include <HardwareAbstractionLayer/Device.hpp>
 #include <HardwareAbstractionLayer/Heap.hpp>
 #include <HardwareAbstractionLayer/Buffer.hpp>
 #include <HardwareAbstractionLayer/Texture.hpp>
 
+#include <robinhood/robin_hood.h>
+
 #include <memory>
+#include <array>
 #include <vector>
 
 namespace Memory
@@ -20,10 +25,43 @@ namespace Memory
         using BufferPtr = std::unique_ptr<HAL::Buffer, std::function<void(HAL::Buffer*)>>;
         using TexturePtr = std::unique_ptr<HAL::Texture, std::function<void(HAL::Texture*)>>;
 
-        SegregatedPoolsResourceAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight);
+        // Handlers receive a resource with the same properties placed at a new location.
+        // Owner is expected to copy the content, switch to the new resource and release the old one when the copy is done.
+        // Returning false declines the move, in which case the new resource should be dropped.
+        using TextureRelocationHandler = std::function<bool(TexturePtr)>;
+        using BufferRelocationHandler = std::function<bool(BufferPtr)>;
+
+        struct DefragmentationStatistics
+        {
+            uint64_t MoveCount = 0;
+            uint64_t MovedBytes = 0;
+            uint64_t ReleasedHeapCount = 0;
+        };
+
+        using SizeClassStatistics = SegregatedPoolsBucketStatistics;
+        using SizeClassStatisticsCallback = std::function<void(MemoryHeapKind heap, uint64_t slotSize, const SizeClassStatistics& statistics)>;
+
+        SegregatedPoolsResourceAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight, MemoryBudgetTracker* budgetTracker);
+
+        // Category is deduced from heap and resource type when not provided
+        BufferPtr AllocateBuffer(
+            const HAL::BufferProperties& properties, 
+            std::optional<HAL::CPUAccessibleHeapType> heapType = std::nullopt, 
+            std::optional<MemoryCategory> category = std::nullopt);
+
+        TexturePtr AllocateTexture(const HAL::TextureProperties& properties, std::optional<MemoryCategory> category = std::nullopt);
 
-        BufferPtr AllocateBuffer(const HAL::BufferProperties& properties, std::optional<HAL::CPUAccessibleHeapType> heapType = std::nullopt);
-        TexturePtr AllocateTexture(const HAL::TextureProperties& properties);
+        // Allows defragmentation to move a default memory resource produced by this allocator.
+        // Properties must be the ones resource was allocated with.
+        void MakeMovable(const HAL::Texture* texture, const HAL::TextureProperties& properties, const TextureRelocationHandler& handler);
+        void MakeMovable(const HAL::Buffer* buffer, const HAL::BufferProperties& properties, const BufferRelocationHandler& handler);
+
+        // Releases default memory heaps left empty at the end of pools and starts moving
+        // up to byteBudget bytes of movable resources so that more heaps become empty later
+        void Defragment(uint64_t byteBudget);
+
+        // Visits every size class of every pool with statistics of its live allocations
+        void EnumerateSizeClasses(const SizeClassStatisticsCallback& callback) const;
 
         void BeginFrame(uint64_t frameNumber);
         void EndFrame(uint64_t frameNumber);
@@ -58,6 +96,16 @@ namespace Memory
             PoolsAllocation PoolAllocation; 
             Pools* PoolsPtr;
             HAL::Heap* HeapPtr;
+            MemoryHeapKind HeapKind;
+        };
+
+        // What was reported to budget tracker, to be reported back on deallocation
+        struct AccountingInfo
+        {
+            MemoryHeapKind HeapKind = MemoryHeapKind::DefaultUniversalOrBuffer;
+            MemoryCategory Category = MemoryCategory::Other;
+            uint64_t RequestedBytes = 0;
+            uint64_t ReservedBytes = 0;
         };
 
         struct Deallocation
@@ -66,6 +114,32 @@ namespace Memory
             PoolsAllocation Allocation;
             Pools* PoolsThatProducedAllocation;
             bool ResourceWillBeReused = false;
+            AccountingInfo Accounting;
+        };
+
+        // Default memory resources, tracked so that they can be found and moved by defragmentation
+        struct Placement
+        {
+            PoolsAllocation PoolAllocation;
+            Pools* PoolsPtr = nullptr;
+            AccountingInfo Accounting;
+
+            // Places a copy of the resource at a new location and hands it to the owner
+            std::function<bool(const Allocation&)> Relocate;
+            bool IsRelocating = false;
+        };
+
+        struct DefaultMemoryPools
+        {
+            Pools* PoolsPtr = nullptr;
+            std::vector<HeapList>* HeapLists = nullptr;
+            MemoryHeapKind HeapKind = MemoryHeapKind::DefaultUniversalOrBuffer;
+        };
+
+        struct PlannedBucket
+        {
+            DefaultMemoryPools Family;
+            uint64_t BucketIndex = 0;
         };
 
         Allocation FindOrAllocateMostFittingFreeSlot(
@@ -73,21 +147,34 @@ namespace Memory
             const HAL::ResourceFormat& resourceFormat, 
             std::optional<HAL::CPUAccessibleHeapType> cpuHeapType);
 
+        TexturePtr PlaceTexture(const Allocation& allocation, const HAL::TextureProperties& properties, uint64_t requestedBytes, MemoryCategory category);
+        BufferPtr PlaceDefaultMemoryBuffer(const Allocation& allocation, const HAL::BufferProperties& properties, uint64_t requestedBytes, MemoryCategory category);
+        void TrackPlacement(const HAL::Resource* resource, const Allocation& allocation, const AccountingInfo& accounting);
+        Allocation AllocationInExistingHeap(const PoolsAllocation& poolAllocation, const DefaultMemoryPools& pools);
+        void ReleaseUnusedHeaps(const DefaultMemoryPools& pools);
+        std::array<DefaultMemoryPools, 3> AllDefaultMemoryPools();
+
         uint64_t AdjustMemoryOffsetToPointInsideHeap(const SegregatedPoolsResourceAllocator::Allocation& allocation);
+        AccountingInfo ReportAllocation(const Allocation& allocation, uint64_t requestedBytes, MemoryCategory category);
         void ExecutePendingDeallocations(uint64_t frameIndex);
 
         const HAL::Device* mDevice = nullptr;
+        MemoryBudgetTracker* mBudgetTracker = nullptr;
 
         Ring mRingFrameTracker;
 
         uint8_t mSimultaneousFramesInFlight;
         uint64_t mCurrentFrameIndex = 0;
 
-        // Minimum allocation size
+        // Amount of slots to allocate at once when out of allocated memory.
+        // Declared before slot size which is derived from it.
+        uint32_t mOnGrowSlotCount = 1; 
+
+        // Minimum allocation size, derived from device's minimum heap size before pools are constructed
         uint64_t mMinimumSlotSize = 65536;
 
-        // Amount of slots to allocate at once when out of allocated memory
-        uint32_t mOnGrowSlotCount = 1; 
+        // Linear size classes per power of two, bounds memory lost to slot size rounding to 25%
+        uint64_t mSubBucketCount = 4;
 
         // Buffer only upload heaps
         Pools mUploadPools;
@@ -111,6 +198,18 @@ namespace Memory
         std::vector<HeapList> mDefaultNonRTDSHeapLists;
         
         std::vector<std::vector<Deallocation>> mPendingDeallocations;
+
+        robin_hood::unordered_node_map<const HAL::Resource*, Placement> mDefaultMemoryPlacements;
+
+        DefragmentationPlanner mDefragmentationPlanner;
+        DefragmentationStatistics mDefragmentationStatistics;
+        std::vector<DefragmentationPlanner::PoolState> mPlannedPoolStates;
+        std::vector<DefragmentationPlanner::MovableBlock> mPlannedBlocks;
+        std::vector<PlannedBucket> mPlannedBuckets;
+        std::vector<const HAL::Resource*> mPlannedResources;
+
+    public:
+        inline const auto& DefragmentationStats() const { return mDefragmentationStatistics; }
     };
 
 }
@@ -0,0 +1,78 @@
+#include "SizeClassMap.hpp"
+
+#include <Foundation/MemoryUtils.hpp>
+
+namespace Memory
+{
+
+    SizeClassMap::SizeClassMap(uint64_t granularity, uint64_t subClassCount)
+        : mGranularity{ granularity }, mSubClassCount{ subClassCount }
+    {
+        assert_format(granularity > 0, "Granularity cannot be 0");
+        assert_format(subClassCount > 0 && (subClassCount & (subClassCount - 1)) == 0, "Sub class count must be a power of two");
+
+        mSubClassCountLog2 = Foundation::MemoryUtils::MostSignificantBit(subClassCount);
+    }
+
+    uint64_t SizeClassMap::ClassIndex(uint64_t allocationSize) const
+    {
+        assert_format(allocationSize <= MaxAllocationSize(), "Allocation size does not fit any size class");
+
+        uint64_t granules = GranuleCount(allocationSize);
+
+        // Granule counts below sub class count are represented exactly
+        if (granules < mSubClassCount)
+        {
+            return granules - 1;
+        }
+
+        // Round up to the next multiple of the step of granule's power of two range.
+        // Rounding can carry over into the next range, which is handled by recomputing the exponent.
+        uint64_t stepLog2 = Foundation::MemoryUtils::MostSignificantBit(granules) - mSubClassCountLog2;
+        uint64_t stepMask = (uint64_t(1) << stepLog2) - 1;
+        uint64_t rounded = ((granules - 1) | stepMask) + 1;
+
+        stepLog2 = Foundation::MemoryUtils::MostSignificantBit(rounded) - mSubClassCountLog2;
+
+        // Mantissa is in [SubClassCount, 2 * SubClassCount)
+        uint64_t mantissa = rounded >> stepLog2;
+
+        return stepLog2 * mSubClassCount + mantissa - 1;
+    }
+
+    uint64_t SizeClassMap::ClassSize(uint64_t classIndex) const
+    {
+        uint64_t classNumber = classIndex + 1;
+
+        if (classNumber < mSubClassCount)
+        {
+            return classNumber * mGranularity;
+        }
+
+        uint64_t stepLog2 = (classNumber >> mSubClassCountLog2) - 1;
+        uint64_t mantissa = classNumber - stepLog2 * mSubClassCount;
+
+        return (mantissa << stepLog2) * mGranularity;
+    }
+
+    uint64_t SizeClassMap::MaxAllocationSize() const
+    {
+        // Largest class whose size in bytes is representable
+        uint64_t maxGranules = ~uint64_t(0) / mGranularity;
+
+        if (maxGranules < mSubClassCount)
+        {
+            return maxGranules * mGranularity;
+        }
+
+        uint64_t stepLog2 = Foundation::MemoryUtils::MostSignificantBit(maxGranules) - mSubClassCountLog2;
+        return (maxGranules >> stepLog2 << stepLog2) * mGranularity;
+    }
+
+    uint64_t SizeClassMap::GranuleCount(uint64_t allocationSize) const
+    {
+        // Zero sized requests still occupy a granule
+        return allocationSize == 0 ? 1 : (allocationSize - 1) / mGranularity + 1;
+    }
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Memory
+{
+
+    // Maps allocation sizes to size classes using integer math only.
+    // Sizes are measured in granules and every power of two range of granules 
+    // is split into a number of linear sub classes, so that rounding an allocation 
+    // up to its class wastes at most 1 / SubClassCount of it instead of up to a half.
+    // With one sub class per range classes are plain powers of two.
+    //
+    // Example for 4 sub classes, in granules: 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 14, 16, 20, 24, ...
+
+    class SizeClassMap
+    {
+    public:
+        // Sub class count must be a power of two
+        SizeClassMap(uint64_t granularity, uint64_t subClassCount);
+
+        uint64_t ClassIndex(uint64_t allocationSize) const;
+        uint64_t ClassSize(uint64_t classIndex) const;
+
+        // Largest size that can be mapped without class size overflowing 64 bits
+        uint64_t MaxAllocationSize() const;
+
+    private:
+        uint64_t GranuleCount(uint64_t allocationSize) const;
+
+        uint64_t mGranularity = 1;
+        uint64_t mSubClassCount = 1;
+        uint64_t mSubClassCountLog2 = 0;
+
+    public:
+        inline auto Granularity() const { return mGranularity; }
+        inline auto SubClassCount() const { return mSubClassCount; }
+    };
+
+}
@@ -9,14 +9,24 @@ namespace Memory
         ResourceStateTracker* stateTracker,
         SegregatedPoolsResourceAllocator* resourceAllocator, 
         PoolDescriptorAllocator* descriptorAllocator,
-        CopyRequestManager* copyRequestManager)
+        CopyRequestManager* copyRequestManager,
+        FrameUploadAllocator* frameUploadAllocator,
+        std::optional<MemoryCategory> memoryCategory)
         :
-        GPUResource(AccessStrategy::Automatic, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager),
-        mTexturePtr{ resourceAllocator->AllocateTexture(properties) },
+        GPUResource(AccessStrategy::Automatic, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager, frameUploadAllocator),
+        mTexturePtr{ resourceAllocator->AllocateTexture(properties, memoryCategory) },
         mProperties{ properties }
     {
         if (mStateTracker) mStateTracker->StartTrakingResource(mTexturePtr.get());
         ReserveDiscriptorArrays(properties.MipCount);
+
+        // Only textures written exclusively from CPU can be moved safely.
+        // Their content is also not expected in the same frame it's loaded in, so upload can wait.
+        if (memoryCategory == MemoryCategory::SceneTexture)
+        {
+            mIsUploadDeferrable = true;
+            MakeMovable();
+        }
     }
 
     Texture::Texture(
@@ -25,11 +35,12 @@ namespace Memory
         SegregatedPoolsResourceAllocator* resourceAllocator, 
         PoolDescriptorAllocator* descriptorAllocator, 
         CopyRequestManager* copyRequestManager,
+        FrameUploadAllocator* frameUploadAllocator,
         const HAL::Device& device, 
         const HAL::Heap& mainResourceExplicitHeap, 
         uint64_t explicitHeapOffset)
         :
-        GPUResource(AccessStrategy::Automatic, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager),
+        GPUResource(AccessStrategy::Automatic, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager, frameUploadAllocator),
         mProperties{ properties }
     {
         mTexturePtr = SegregatedPoolsResourceAllocator::TexturePtr{
@@ -46,9 +57,10 @@ namespace Memory
         SegregatedPoolsResourceAllocator* resourceAllocator, 
         PoolDescriptorAllocator* descriptorAllocator, 
         CopyRequestManager* copyRequestManager,
+        FrameUploadAllocator* frameUploadAllocator,
         HAL::Texture* existingTexture)
         :
-        GPUResource(AccessStrategy::Automatic, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager),
+        GPUResource(AccessStrategy::Automatic, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager, frameUploadAllocator),
         mProperties{
             existingTexture->Format(), existingTexture->Kind(),
             existingTexture->Dimensions(), existingTexture->OptimizedClearValue(),
@@ -63,6 +75,13 @@ namespace Memory
     Texture::~Texture()
     {
         if (mStateTracker) mStateTracker->StopTrakingResource(mTexturePtr.get());
+        mCopyRequestManager->CancelUploads(mTexturePtr.get());
+
+        if (mRelocatedTexturePtr)
+        {
+            mCopyRequestManager->CancelRelocation(mRelocatedTexturePtr.get());
+            if (mStateTracker) mStateTracker->StopTrakingResource(mRelocatedTexturePtr.get());
+        }
     }
 
     const HAL::RTDescriptor* Texture::GetRTDescriptor(uint8_t mipLevel) const
@@ -115,6 +134,81 @@ namespace Memory
         return mTexturePtr.get();
     }
 
+    void Texture::EndFrame(uint64_t frameNumber)
+    {
+        GPUResource::EndFrame(frameNumber);
+
+        if (mRelocatedTexturePtr && frameNumber >= mRelocationFrameNumber)
+        {
+            CompleteRelocation();
+        }
+    }
+
+    void Texture::MakeMovable()
+    {
+        mResourceAllocator->MakeMovable(mTexturePtr.get(), mProperties, [this](SegregatedPoolsResourceAllocator::TexturePtr newTexture)
+        {
+            return BeginRelocation(std::move(newTexture));
+        });
+    }
+
+    bool Texture::BeginRelocation(SegregatedPoolsResourceAllocator::TexturePtr newTexture)
+    {
+        // Deferred upload targets current texture and would be lost by the copy
+        if (mRelocatedTexturePtr || mLastWriteRequestFrameNumber == mFrameNumber || mCopyRequestManager->IsUploadDeferred(mTexturePtr.get()))
+        {
+            return false;
+        }
+
+        mRelocatedTexturePtr = std::move(newTexture);
+        mRelocationFrameNumber = mFrameNumber;
+        mRelocatedTexturePtr->SetDebugName(mDebugName);
+
+        if (mStateTracker) mStateTracker->StartTrakingResource(mRelocatedTexturePtr.get());
+
+        mCopyRequestManager->RequestRelocation(mTexturePtr.get(), mRelocatedTexturePtr.get());
+
+        return true;
+    }
+
+    void Texture::CompleteRelocation()
+    {
+        // Content was changed after the copy had been made, so the copy is discarded and the move is retried later
+        if (mLastWriteRequestFrameNumber >= mRelocationFrameNumber)
+        {
+            if (mStateTracker) mStateTracker->StopTrakingResource(mRelocatedTexturePtr.get());
+            mRelocatedTexturePtr = nullptr;
+            MakeMovable();
+            return;
+        }
+
+        if (mStateTracker) mStateTracker->StopTrakingResource(mTexturePtr.get());
+
+        // Old texture goes through allocator's deferred deallocation, 
+        // so frames in flight that still reference it can finish safely
+        std::swap(mTexturePtr, mRelocatedTexturePtr);
+        mRelocatedTexturePtr = nullptr;
+
+        // Frames in flight may still read old descriptors, so they are released through 
+        // descriptor allocator's deferred deallocation and new ones are created on demand
+        mSRDescriptor = nullptr;
+        mDSDescriptor = nullptr;
+
+        for (PoolDescriptorAllocator::UADescriptorPtr& uaDescriptor : mUADescriptors)
+        {
+            uaDescriptor = nullptr;
+        }
+
+        for (PoolDescriptorAllocator::RTDescriptorPtr& rtDescriptor : mRTDescriptors)
+        {
+            rtDescriptor = nullptr;
+        }
+
+        ++mDescriptorGeneration;
+
+        MakeMovable();
+    }
+
     uint64_t Texture::ResourceSizeInBytes() const
     {
         return mTexturePtr->TotalMemory();
@@ -130,30 +224,20 @@ namespace Memory
         }
     }
 
-    CopyRequestManager::CopyCommand Texture::GetUploadCommands()
+    uint64_t Texture::UploadMemoryAlignment() const
     {
-        return [&](HAL::CopyCommandListBase& cmdList)
-        {
-            HAL::ResourceFootprint footprint{ *HALTexture() };
-
-            for (const HAL::SubresourceFootprint& subresourceFootprint : footprint.SubresourceFootprints())
-            {
-                cmdList.CopyBufferToTexture(*CurrentFrameUploadBuffer(), *HALTexture(), subresourceFootprint);
-            }
-        };
+        // Placed subresource footprints have to start at this alignment
+        return D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
     }
 
-    CopyRequestManager::CopyCommand Texture::GetReadbackCommands()
+    void Texture::RequestUploadCopies()
     {
-        return [&](HAL::CopyCommandListBase& cmdList)
-        {
-            HAL::ResourceFootprint textureFootprint{ *HALTexture() };
+        mCopyRequestManager->RequestTextureUpload(CurrentFrameUploadBuffer(), CurrentFrameUploadOffset(), HALTexture(), ResourceSizeInBytes(), mIsUploadDeferrable);
+    }
 
-            for (const HAL::SubresourceFootprint& subresourceFootprint : textureFootprint.SubresourceFootprints())
-            {
-                cmdList.CopyTextureToBuffer(*HALTexture(), *CurrentFrameReadbackBuffer(), subresourceFootprint);
-            }
-        };
+    void Texture::RequestReadbackCopies()
+    {
+        mCopyRequestManager->RequestTextureReadback(HALTexture(), CurrentFrameReadbackBuffer(), ResourceSizeInBytes());
     }
 
     void Texture::ReserveDiscriptorArrays(uint8_t mipCount)
@@ -17,7 +17,9 @@ namespace Memory
             ResourceStateTracker* stateTracker,
             SegregatedPoolsResourceAllocator* resourceAllocator,
             PoolDescriptorAllocator* descriptorAllocator,
-            CopyRequestManager* copyRequestManager);
+            CopyRequestManager* copyRequestManager,
+            FrameUploadAllocator* frameUploadAllocator,
+            std::optional<MemoryCategory> memoryCategory);
 
         Texture(
             const HAL::TextureProperties& properties,
@@ -25,6 +27,7 @@ namespace Memory
             SegregatedPoolsResourceAllocator* resourceAllocator,
             PoolDescriptorAllocator* descriptorAllocator,
             CopyRequestManager* copyRequestManager,
+            FrameUploadAllocator* frameUploadAllocator,
             const HAL::Device& device,
             const HAL::Heap& mainResourceExplicitHeap,
             uint64_t explicitHeapOffset);
@@ -34,6 +37,7 @@ namespace Memory
             SegregatedPoolsResourceAllocator* resourceAllocator,
             PoolDescriptorAllocator* descriptorAllocator,
             CopyRequestManager* copyRequestManager,
+            FrameUploadAllocator* frameUploadAllocator,
             HAL::Texture* existingTexture);
 
         ~Texture();
@@ -46,17 +50,29 @@ namespace Memory
         const HAL::Texture* HALTexture() const;
         const HAL::Resource* HALResource() const override;
 
+        void EndFrame(uint64_t frameNumber) override;
+
     protected:
         uint64_t ResourceSizeInBytes() const override;
+        uint64_t UploadMemoryAlignment() const override;
         void ApplyDebugName() override;
-        CopyRequestManager::CopyCommand GetUploadCommands() override;
-        CopyRequestManager::CopyCommand GetReadbackCommands() override;
+        void RequestUploadCopies() override;
+        void RequestReadbackCopies() override;
         void ReserveDiscriptorArrays(uint8_t mipCount);
 
     private:
+        void MakeMovable();
+        bool BeginRelocation(SegregatedPoolsResourceAllocator::TexturePtr newTexture);
+        void CompleteRelocation();
+
         SegregatedPoolsResourceAllocator::TexturePtr mTexturePtr;
         HAL::TextureProperties mProperties;
 
+        // Copy of the texture at a new memory location made by defragmentation.
+        // Replaces the current texture once the copy is executed.
+        SegregatedPoolsResourceAllocator::TexturePtr mRelocatedTexturePtr;
+        uint64_t mRelocationFrameNumber = 0;
+
         mutable PoolDescriptorAllocator::DSDescriptorPtr mDSDescriptor;
         mutable PoolDescriptorAllocator::SRDescriptorPtr mSRDescriptor;
         mutable std::vector<PoolDescriptorAllocator::RTDescriptorPtr> mRTDescriptors;
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+
+namespace Memory
+{
+
+    /// Keeps resources that are no longer used so that later requests with identical
+    /// properties receive them back instead of creating new ones.
+    /// Pool only moves resource handles around and never inspects them,
+    /// so its behaviour can be verified without a device.
+    ///
+    /// Resources are looked up by properties hash, but handed out only when their full
+    /// properties compare equal, so a hash collision can't return a resource of a wrong kind.
+    ///
+    /// Resources unused for more than a maximum number of frames are destroyed.
+    /// When pooled memory exceeds its limit least recently released resources are destroyed first,
+    /// but never before a minimum number of frames passes, so frames in flight can still use them.
+    template <class Resource, class Properties>
+    class TransientResourcePool
+    {
+    public:
+        struct Statistics
+        {
+            uint64_t CreationCount = 0;
+            uint64_t ReuseCount = 0;
+            uint64_t EvictionCount = 0;
+        };
+
+        TransientResourcePool(uint64_t minUnusedFrameCount, uint64_t maxUnusedFrameCount);
+
+        // Hands out the most recently released resource with matching properties or creates a new one
+        template <class Creator>
+        Resource AcquireOrCreate(uint64_t propertiesHash, const Properties& properties, const Creator& creator);
+
+        void Release(uint64_t propertiesHash, const Properties& properties, Resource&& resource, uint64_t sizeInBytes);
+
+        // Destroys resources that stayed unused for too long or don't fit into the memory limit
+        void BeginFrame(uint64_t frameNumber);
+
+        void SetPooledBytesLimit(uint64_t limit);
+
+    private:
+        struct Entry
+        {
+            uint64_t PropertiesHash = 0;
+            Properties ResourceProperties;
+            uint64_t SizeInBytes = 0;
+            uint64_t ReleaseFrameNumber = 0;
+            Resource PooledResource;
+        };
+
+        void EvictOldest();
+
+        uint64_t mMinUnusedFrameCount = 0;
+        uint64_t mMaxUnusedFrameCount = 0;
+        uint64_t mPooledBytesLimit = std::numeric_limits<uint64_t>::max();
+        uint64_t mPooledBytes = 0;
+        uint64_t mFrameNumber = 0;
+        Statistics mStatistics;
+
+        // Ordered by release frame, oldest entries first
+        std::vector<Entry> mEntries;
+
+    public:
+        inline const auto& GetStatistics() const { return mStatistics; }
+        inline auto PooledBytes() const { return mPooledBytes; }
+        inline auto PooledResourceCount() const { return mEntries.size(); }
+
+        template <class Func>
+        void ForEachPooledResource(const Func& func) const;
+    };
+
+}
+
+#include "TransientResourcePool.inl"
@@ -0,0 +1,84 @@
+namespace Memory
+{
+
+    template <class Resource, class Properties>
+    TransientResourcePool<Resource, Properties>::TransientResourcePool(uint64_t minUnusedFrameCount, uint64_t maxUnusedFrameCount)
+        : mMinUnusedFrameCount{ minUnusedFrameCount }, mMaxUnusedFrameCount{ std::max(minUnusedFrameCount, maxUnusedFrameCount) } {}
+
+    template <class Resource, class Properties>
+    template <class Creator>
+    Resource TransientResourcePool<Resource, Properties>::AcquireOrCreate(uint64_t propertiesHash, const Properties& properties, const Creator& creator)
+    {
+        // Most recently released resources are the least likely to be evicted soon
+        for (auto entryIt = mEntries.rbegin(); entryIt != mEntries.rend(); ++entryIt)
+        {
+            // Hash comparison rejects most entries cheaply
+            if (entryIt->PropertiesHash != propertiesHash || !(entryIt->ResourceProperties == properties))
+            {
+                continue;
+            }
+
+            Resource resource = std::move(entryIt->PooledResource);
+            mPooledBytes -= entryIt->SizeInBytes;
+            mEntries.erase(std::next(entryIt).base());
+            mStatistics.ReuseCount += 1;
+            return resource;
+        }
+
+        mStatistics.CreationCount += 1;
+        return creator();
+    }
+
+    template <class Resource, class Properties>
+    void TransientResourcePool<Resource, Properties>::Release(uint64_t propertiesHash, const Properties& properties, Resource&& resource, uint64_t sizeInBytes)
+    {
+        mEntries.push_back(Entry{ propertiesHash, properties, sizeInBytes, mFrameNumber, std::move(resource) });
+        mPooledBytes += sizeInBytes;
+    }
+
+    template <class Resource, class Properties>
+    void TransientResourcePool<Resource, Properties>::BeginFrame(uint64_t frameNumber)
+    {
+        mFrameNumber = frameNumber;
+
+        while (!mEntries.empty())
+        {
+            uint64_t unusedFrameCount = mFrameNumber - mEntries.front().ReleaseFrameNumber;
+
+            bool isExpired = unusedFrameCount > mMaxUnusedFrameCount;
+            bool isOverLimit = mPooledBytes > mPooledBytesLimit && unusedFrameCount >= mMinUnusedFrameCount;
+
+            if (!isExpired && !isOverLimit)
+            {
+                break;
+            }
+
+            EvictOldest();
+        }
+    }
+
+    template <class Resource, class Properties>
+    void TransientResourcePool<Resource, Properties>::SetPooledBytesLimit(uint64_t limit)
+    {
+        mPooledBytesLimit = limit;
+    }
+
+    template <class Resource, class Properties>
+    void TransientResourcePool<Resource, Properties>::EvictOldest()
+    {
+        mPooledBytes -= mEntries.front().SizeInBytes;
+        mEntries.erase(mEntries.begin());
+        mStatistics.EvictionCount += 1;
+    }
+
+    template <class Resource, class Properties>
+    template <class Func>
+    void TransientResourcePool<Resource, Properties>::ForEachPooledResource(const Func& func) const
+    {
+        for (const Entry& entry : mEntries)
+        {
+            func(entry.PooledResource, entry.SizeInBytes);
+        }
+    }
+
+}
@@ -0,0 +1,232 @@
+#include "BarrierScheduler.hpp"
+
+#include <algorithm>
+
+namespace PathFinder
+{
+
+    BarrierScheduler::BarrierScheduler(const QueueTransitionSupportPredicate& isTransitionSupportedOnQueue, const ImplicitTransitionPredicate& canBeTransitionedImplicitly)
+        : mIsTransitionSupportedOnQueue{ isTransitionSupportedOnQueue }, mCanBeTransitionedImplicitly{ canBeTransitionedImplicitly } {}
+
+    void BarrierScheduler::Reset(uint64_t nodeCount)
+    {
+        mSubresourcesPreviousUsageInfo.clear();
+        mPlan.clear();
+        mStatistics = {};
+
+        mPerNodeBeginTransitions.clear();
+        mPerNodeBeginTransitions.resize(nodeCount);
+        mPerNodeEndTransitions.clear();
+        mPerNodeEndTransitions.resize(nodeCount);
+    }
+
+    void BarrierScheduler::RecordUsage(RenderPassGraph::SubresourceName subresourceName, const RenderPassGraph::Node* node, uint64_t commandListBatchIndex)
+    {
+        mSubresourcesPreviousUsageInfo[subresourceName] = { node, commandListBatchIndex };
+    }
+
+    const BarrierScheduler::PlannedTransition& BarrierScheduler::ScheduleTransition(
+        RenderPassGraph::SubresourceName subresourceName,
+        const HAL::Resource* resource,
+        uint32_t resourceSubresourceCount,
+        HAL::ResourceState beforeStates,
+        HAL::ResourceState afterStates,
+        const RenderPassGraph::Node* node,
+        uint64_t commandListBatchIndex)
+    {
+        PlannedTransition& transition = mPlan.emplace_back();
+        transition.SubresourceName = subresourceName;
+        transition.Resource = resource;
+        transition.SubresourceIndex = RenderPassGraph::DecodeSubresourceName(subresourceName).second;
+        transition.ResourceSubresourceCount = resourceSubresourceCount;
+        transition.BeforeStates = beforeStates;
+        transition.AfterStates = afterStates;
+        transition.EndNodeIndex = node->GlobalExecutionIndex();
+
+        // Look for previous usage info to see whether current explicit transition can be made
+        // implicit due to automatic promotion/decay. Promotion/decay only happens between ExecuteCommandLists calls,
+        // so it's impossible if subresource was already used in the current command list batch.
+        auto previousUsageIt = mSubresourcesPreviousUsageInfo.find(subresourceName);
+        bool foundPreviousUsage = previousUsageIt != mSubresourcesPreviousUsageInfo.end();
+        bool subresourceUsedInCurrentBatch = foundPreviousUsage && previousUsageIt->second.CommandListBatchIndex == commandListBatchIndex;
+
+        if (!subresourceUsedInCurrentBatch && mCanBeTransitionedImplicitly(resource, transition.BeforeStates, transition.AfterStates))
+        {
+            transition.Placement = TransitionPlacement::Implicit;
+            ++mStatistics.ImplicitTransitionCount;
+            // Usage still counts: later transitions in the same batch can't rely on promotion anymore
+            mSubresourcesPreviousUsageInfo[subresourceName] = { node, commandListBatchIndex };
+            return transition;
+        }
+
+        transition.Placement = TransitionPlacement::Full;
+
+        if (foundPreviousUsage)
+        {
+            const RenderPassGraph::Node* previousNode = previousUsageIt->second.Node;
+
+            // Split barrier is only possible when transmitting queue supports transitions for both before and after states
+            bool isSplitBarrierPossible = mIsTransitionSupportedOnQueue(previousNode->ExecutionQueueIndex, transition.BeforeStates, transition.AfterStates);
+
+            // There is no sense in splitting barriers between passes that are too close to each other.
+            // That will only double the amount of barriers without any performance gain.
+            transition.SplitDistance = CalculateSplitDistance(*previousNode, *node);
+
+            if (isSplitBarrierPossible && transition.SplitDistance >= mMinimumSplitDistance)
+            {
+                transition.Placement = TransitionPlacement::Split;
+                transition.BeginNodeIndex = previousNode->GlobalExecutionIndex();
+            }
+        }
+
+        uint64_t transitionIndex = mPlan.size() - 1;
+
+        if (transition.Placement == TransitionPlacement::Split)
+        {
+            mPerNodeBeginTransitions[*transition.BeginNodeIndex].push_back(transitionIndex);
+            ++mStatistics.SplitBarrierCount;
+        }
+        else
+        {
+            ++mStatistics.FullBarrierCount;
+        }
+
+        mPerNodeEndTransitions[transition.EndNodeIndex].push_back(transitionIndex);
+        mSubresourcesPreviousUsageInfo[subresourceName] = { node, commandListBatchIndex };
+
+        return transition;
+    }
+
+    void BarrierScheduler::EmitEndBarriers(uint64_t nodeGlobalExecutionIndex, HAL::ResourceBarrierCollection& collection)
+    {
+        mEmittedBarriers.clear();
+        EmitEndBarriers(nodeGlobalExecutionIndex, mEmittedBarriers);
+        ConvertBarriers(mEmittedBarriers, collection);
+    }
+
+    void BarrierScheduler::EmitEndBarriers(uint64_t nodeGlobalExecutionIndex, std::vector<EmittedBarrier>& barriers)
+    {
+        EmitBarriers(mPerNodeEndTransitions[nodeGlobalExecutionIndex], BarrierPart::End, barriers);
+    }
+
+    void BarrierScheduler::EmitBeginBarriers(uint64_t nodeGlobalExecutionIndex, HAL::ResourceBarrierCollection& collection)
+    {
+        mEmittedBarriers.clear();
+        EmitBeginBarriers(nodeGlobalExecutionIndex, mEmittedBarriers);
+        ConvertBarriers(mEmittedBarriers, collection);
+    }
+
+    void BarrierScheduler::EmitBeginBarriers(uint64_t nodeGlobalExecutionIndex, std::vector<EmittedBarrier>& barriers)
+    {
+        EmitBarriers(mPerNodeBeginTransitions[nodeGlobalExecutionIndex], BarrierPart::Begin, barriers);
+    }
+
+    void BarrierScheduler::SetMinimumSplitDistance(uint64_t distance)
+    {
+        mMinimumSplitDistance = std::max<uint64_t>(distance, 1);
+    }
+
+    uint64_t BarrierScheduler::CalculateSplitDistance(const RenderPassGraph::Node& previousNode, const RenderPassGraph::Node& currentNode) const
+    {
+        // Passes on the same queue are executed in order, so the amount of passes between usages is the amount
+        // of work the GPU can overlap with the transition. For usages on different queues only dependency levels are comparable.
+        if (previousNode.ExecutionQueueIndex == currentNode.ExecutionQueueIndex)
+        {
+            return currentNode.LocalToQueueExecutionIndex() - previousNode.LocalToQueueExecutionIndex();
+        }
+
+        return currentNode.DependencyLevelIndex() - previousNode.DependencyLevelIndex();
+    }
+
+    void BarrierScheduler::EmitBarriers(const std::vector<uint64_t>& transitionIndices, BarrierPart part, std::vector<EmittedBarrier>& barriers)
+    {
+        // Group transitions of the same resource together to detect
+        // cases where all subresources are transitioned identically
+        std::vector<uint64_t> sortedIndices = transitionIndices;
+
+        std::sort(sortedIndices.begin(), sortedIndices.end(), [this](uint64_t first, uint64_t second)
+        {
+            const PlannedTransition& a = mPlan[first];
+            const PlannedTransition& b = mPlan[second];
+            return a.Resource != b.Resource ? a.Resource < b.Resource : a.SubresourceIndex < b.SubresourceIndex;
+        });
+
+        auto rangeStart = sortedIndices.begin();
+
+        while (rangeStart != sortedIndices.end())
+        {
+            const PlannedTransition& first = mPlan[*rangeStart];
+
+            auto rangeEnd = std::find_if(rangeStart, sortedIndices.end(), [this, &first](uint64_t index)
+            {
+                return mPlan[index].Resource != first.Resource;
+            });
+
+            // Both halves of a split transition are merged independently, so a whole-resource barrier is only valid
+            // when every subresource begins and ends at the same nodes. Otherwise Begin and End parts of 
+            // the same subresource could end up in barriers of different granularity.
+            bool transitionsMatch = std::all_of(rangeStart, rangeEnd, [this, &first](uint64_t index)
+            {
+                const PlannedTransition& transition = mPlan[index];
+                return transition.BeforeStates == first.BeforeStates && 
+                    transition.AfterStates == first.AfterStates && 
+                    transition.Placement == first.Placement &&
+                    transition.BeginNodeIndex == first.BeginNodeIndex &&
+                    transition.EndNodeIndex == first.EndNodeIndex;
+            });
+
+            uint64_t transitionCount = std::distance(rangeStart, rangeEnd);
+            bool coversAllSubresources = transitionCount == first.ResourceSubresourceCount;
+
+            if (transitionCount > 1 && transitionsMatch && coversAllSubresources)
+            {
+                AddBarrier(first, std::nullopt, part, barriers);
+                mStatistics.MergedBarrierCount += transitionCount - 1;
+            }
+            else
+            {
+                for (auto it = rangeStart; it != rangeEnd; ++it)
+                {
+                    AddBarrier(mPlan[*it], mPlan[*it].SubresourceIndex, part, barriers);
+                }
+            }
+
+            rangeStart = rangeEnd;
+        }
+    }
+
+    void BarrierScheduler::AddBarrier(const PlannedTransition& transition, std::optional<uint32_t> subresourceIndex, BarrierPart part, std::vector<EmittedBarrier>& barriers)
+    {
+        EmittedBarrier& barrier = barriers.emplace_back();
+        barrier.Resource = transition.Resource;
+        barrier.SubresourceIndex = subresourceIndex;
+        barrier.BeforeStates = transition.BeforeStates;
+        barrier.AfterStates = transition.AfterStates;
+
+        if (transition.Placement == TransitionPlacement::Split)
+        {
+            barrier.Flag = part == BarrierPart::Begin ? BarrierFlag::BeginOnly : BarrierFlag::EndOnly;
+        }
+
+        ++mStatistics.EmittedBarrierCount;
+    }
+
+    void BarrierScheduler::ConvertBarriers(const std::vector<EmittedBarrier>& barriers, HAL::ResourceBarrierCollection& collection) const
+    {
+        for (const EmittedBarrier& emittedBarrier : barriers)
+        {
+            HAL::ResourceTransitionBarrier barrier{ emittedBarrier.BeforeStates, emittedBarrier.AfterStates, emittedBarrier.Resource, emittedBarrier.SubresourceIndex };
+
+            if (emittedBarrier.Flag == BarrierFlag::None)
+            {
+                collection.AddBarrier(barrier);
+            }
+            else
+            {
+                auto [beginBarrier, endBarrier] = barrier.Split();
+                collection.AddBarrier(emittedBarrier.Flag == BarrierFlag::BeginOnly ? beginBarrier : endBarrier);
+            }
+        }
+    }
+
+}
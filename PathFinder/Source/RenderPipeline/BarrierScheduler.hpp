@@ -0,0 +1,148 @@
+#pragma once
+
+#include <HardwareAbstractionLayer/Resource.hpp>
+#include <HardwareAbstractionLayer/ResourceBarrier.hpp>
+
+#include "RenderPassGraph.hpp"
+
+#include <robinhood/robin_hood.h>
+
+#include <vector>
+#include <optional>
+#include <functional>
+
+namespace PathFinder
+{
+    // Decides where Begin and End parts of subresource transitions are placed on the dependency level timeline,
+    // culls transitions that are covered by implicit state promotion/decay and merges per-subresource
+    // transitions into whole-resource barriers when possible. Produced plan is kept as plain data for inspection.
+
+    class BarrierScheduler
+    {
+    public:
+        enum class TransitionPlacement : uint8_t
+        {
+            // Transition is handled by implicit promotion/decay, no barrier is recorded
+            Implicit,
+            // Regular barrier recorded right before the pass that needs a new state
+            Full,
+            // Begin barrier recorded after previous usage, End barrier recorded before the pass that needs a new state
+            Split
+        };
+
+        struct PlannedTransition
+        {
+            RenderPassGraph::SubresourceName SubresourceName = 0;
+            const HAL::Resource* Resource = nullptr;
+            uint32_t SubresourceIndex = 0;
+            uint32_t ResourceSubresourceCount = 1;
+            HAL::ResourceState BeforeStates = HAL::ResourceState::Common;
+            HAL::ResourceState AfterStates = HAL::ResourceState::Common;
+            TransitionPlacement Placement = TransitionPlacement::Full;
+
+            // Global execution indices of nodes after which Begin barrier and before which End (or Full) barrier is recorded
+            std::optional<uint64_t> BeginNodeIndex;
+            uint64_t EndNodeIndex = 0;
+
+            // Distance between Begin and End points used to make a decision about splitting
+            uint64_t SplitDistance = 0;
+        };
+
+        struct Statistics
+        {
+            uint64_t ImplicitTransitionCount = 0;
+            uint64_t FullBarrierCount = 0;
+            uint64_t SplitBarrierCount = 0;
+
+            // Amount of barriers that were saved by merging per-subresource transitions into whole-resource ones
+            uint64_t MergedBarrierCount = 0;
+
+            // Amount of D3D barriers actually handed over to command lists
+            uint64_t EmittedBarrierCount = 0;
+        };
+
+        enum class BarrierFlag : uint8_t
+        {
+            None, BeginOnly, EndOnly
+        };
+
+        // Barrier in the form it is handed over to command lists, kept as plain data so that emission can be inspected without a device
+        struct EmittedBarrier
+        {
+            const HAL::Resource* Resource = nullptr;
+            // Empty when barrier covers all subresources
+            std::optional<uint32_t> SubresourceIndex;
+            HAL::ResourceState BeforeStates = HAL::ResourceState::Common;
+            HAL::ResourceState AfterStates = HAL::ResourceState::Common;
+            BarrierFlag Flag = BarrierFlag::None;
+        };
+
+        using QueueTransitionSupportPredicate = std::function<bool(uint64_t queueIndex, HAL::ResourceState beforeStates, HAL::ResourceState afterStates)>;
+        using ImplicitTransitionPredicate = std::function<bool(const HAL::Resource* resource, HAL::ResourceState beforeStates, HAL::ResourceState afterStates)>;
+
+        BarrierScheduler(const QueueTransitionSupportPredicate& isTransitionSupportedOnQueue, const ImplicitTransitionPredicate& canBeTransitionedImplicitly);
+
+        void Reset(uint64_t nodeCount);
+
+        // Register usage of subresource that did not require any transition to keep usage history intact
+        void RecordUsage(RenderPassGraph::SubresourceName subresourceName, const RenderPassGraph::Node* node, uint64_t commandListBatchIndex);
+
+        // Choose placement of a transition required by the node and record it into the plan
+        const PlannedTransition& ScheduleTransition(
+            RenderPassGraph::SubresourceName subresourceName,
+            const HAL::Resource* resource,
+            uint32_t resourceSubresourceCount,
+            HAL::ResourceState beforeStates,
+            HAL::ResourceState afterStates,
+            const RenderPassGraph::Node* node,
+            uint64_t commandListBatchIndex);
+
+        // Emit merged barriers that must be recorded before the node's work
+        void EmitEndBarriers(uint64_t nodeGlobalExecutionIndex, HAL::ResourceBarrierCollection& collection);
+        void EmitEndBarriers(uint64_t nodeGlobalExecutionIndex, std::vector<EmittedBarrier>& barriers);
+
+        // Emit merged Begin barriers that must be recorded after the node's work
+        void EmitBeginBarriers(uint64_t nodeGlobalExecutionIndex, HAL::ResourceBarrierCollection& collection);
+        void EmitBeginBarriers(uint64_t nodeGlobalExecutionIndex, std::vector<EmittedBarrier>& barriers);
+
+        // Minimum distance between previous subresource usage and the next transition for the transition to be split.
+        // Measured in passes when both usages are on the same queue and in dependency levels otherwise.
+        void SetMinimumSplitDistance(uint64_t distance);
+
+    private:
+        struct SubresourcePreviousUsageInfo
+        {
+            const RenderPassGraph::Node* Node = nullptr;
+            uint64_t CommandListBatchIndex = 0;
+        };
+
+        enum class BarrierPart
+        {
+            Begin, End
+        };
+
+        uint64_t CalculateSplitDistance(const RenderPassGraph::Node& previousNode, const RenderPassGraph::Node& currentNode) const;
+        void EmitBarriers(const std::vector<uint64_t>& transitionIndices, BarrierPart part, std::vector<EmittedBarrier>& barriers);
+        void AddBarrier(const PlannedTransition& transition, std::optional<uint32_t> subresourceIndex, BarrierPart part, std::vector<EmittedBarrier>& barriers);
+        void ConvertBarriers(const std::vector<EmittedBarrier>& barriers, HAL::ResourceBarrierCollection& collection) const;
+
+        QueueTransitionSupportPredicate mIsTransitionSupportedOnQueue;
+        ImplicitTransitionPredicate mCanBeTransitionedImplicitly;
+        uint64_t mMinimumSplitDistance = 2;
+
+        // Keep track of nodes where subresources were used last to insert Begin part of split barriers there
+        robin_hood::unordered_flat_map<RenderPassGraph::SubresourceName, SubresourcePreviousUsageInfo> mSubresourcesPreviousUsageInfo;
+
+        std::vector<PlannedTransition> mPlan;
+        std::vector<std::vector<uint64_t>> mPerNodeBeginTransitions;
+        std::vector<std::vector<uint64_t>> mPerNodeEndTransitions;
+        std::vector<EmittedBarrier> mEmittedBarriers;
+        Statistics mStatistics;
+
+    public:
+        inline const auto& Plan() const { return mPlan; }
+        inline const auto& PlanStatistics() const { return mStatistics; }
+        inline auto MinimumSplitDistance() const { return mMinimumSplitDistance; }
+    };
+
+}
@@ -1,40 +1,106 @@
 #include "CopyRequestHandling.hpp"
 
+#include <HardwareAbstractionLayer/ResourceFootprint.hpp>
+
 namespace PathFinder
 {
 
+    void RecordCopy(HAL::CopyCommandListBase& cmdList, const Memory::CopyRequestManager::CopyRegion& copy)
+    {
+        using CopyKind = Memory::CopyRequestManager::CopyKind;
+
+        switch (copy.Kind)
+        {
+        case CopyKind::BufferRegion:
+        {
+            auto source = static_cast<const HAL::Buffer*>(copy.Source);
+            auto destination = static_cast<const HAL::Buffer*>(copy.Destination);
+            cmdList.CopyBufferRegion(*source, *destination, copy.SourceOffset, copy.Size, copy.DestinationOffset);
+            break;
+        }
+
+        case CopyKind::BufferToTexture:
+        {
+            auto source = static_cast<const HAL::Buffer*>(copy.Source);
+            auto destination = static_cast<const HAL::Texture*>(copy.Destination);
+
+            // Footprints are placed at the texture's location in staging memory
+            HAL::ResourceFootprint footprint{ *destination, copy.SourceOffset };
+
+            for (const HAL::SubresourceFootprint& subresourceFootprint : footprint.SubresourceFootprints())
+            {
+                cmdList.CopyBufferToTexture(*source, *destination, subresourceFootprint);
+            }
+
+            break;
+        }
+
+        case CopyKind::TextureToBuffer:
+        {
+            auto source = static_cast<const HAL::Texture*>(copy.Source);
+            auto destination = static_cast<const HAL::Buffer*>(copy.Destination);
+
+            HAL::ResourceFootprint footprint{ *source, copy.DestinationOffset };
+
+            for (const HAL::SubresourceFootprint& subresourceFootprint : footprint.SubresourceFootprints())
+            {
+                cmdList.CopyTextureToBuffer(*source, *destination, subresourceFootprint);
+            }
+
+            break;
+        }
+
+        case CopyKind::WholeResource:
+            cmdList.CopyResource(*copy.Source, *copy.Destination);
+            break;
+        }
+    }
+
     void RecordCopyRequests(
         HAL::CopyCommandListBase& cmdList,
         Memory::ResourceStateTracker& stateTracker, 
-        const std::vector<Memory::CopyRequestManager::CopyRequest>& requests,
+        const std::vector<Memory::CopyRequestManager::CopyRegion>& copies,
         HAL::ResourceState copyState,
         bool applyBackTransition)
     {
         HAL::ResourceBarrierCollection preCopyTransisions{};
         HAL::ResourceBarrierCollection postCopyTransisions{};
 
-        for (const Memory::CopyRequestManager::CopyRequest& copyRequest : requests)
+        const HAL::Resource* previousResource = nullptr;
+
+        for (const Memory::CopyRequestManager::CopyRegion& copy : copies)
         {
-            const Memory::ResourceStateTracker::SubresourceStateList prevStates = stateTracker.ResourceCurrentStates(copyRequest.Resource);
+            // Resource being copied to on upload and from on readback
+            const HAL::Resource* resource = copyState == HAL::ResourceState::CopyDestination ? copy.Destination : copy.Source;
+
+            // Copies are grouped by resource, so each resource is transitioned once
+            if (resource == previousResource)
+            {
+                continue;
+            }
+
+            previousResource = resource;
+
+            const Memory::ResourceStateTracker::SubresourceStateList prevStates = stateTracker.ResourceCurrentStates(resource);
 
             HAL::ResourceBarrierCollection barriers =
-                stateTracker.TransitionToStateImmediately(copyRequest.Resource, copyState);
+                stateTracker.TransitionToStateImmediately(resource, copyState);
 
             preCopyTransisions.AddBarriers(barriers);
             
             // Return to previous state immediately after copy, if required
             if (applyBackTransition)
             {
-                barriers = stateTracker.TransitionToStatesImmediately(copyRequest.Resource, prevStates);
+                barriers = stateTracker.TransitionToStatesImmediately(resource, prevStates);
                 postCopyTransisions.AddBarriers(barriers);
             }
         }
 
         cmdList.InsertBarriers(preCopyTransisions);
 
-        for (const Memory::CopyRequestManager::CopyRequest& copyRequest : requests)
+        for (const Memory::CopyRequestManager::CopyRegion& copy : copies)
         {
-            copyRequest.Command(cmdList);
+            RecordCopy(cmdList, copy);
         }
 
         cmdList.InsertBarriers(postCopyTransisions);
@@ -42,10 +108,40 @@ namespace PathFinder
 
     void RecordUploadRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager, bool applyBackTransition)
     {
-        RecordCopyRequests(cmdList, stateTracker, copyManager.UploadRequests(), HAL::ResourceState::CopyDestination, applyBackTransition);
+        const Memory::CopyPlanner::Plan& plan = copyManager.PlanUploads();
+        RecordCopyRequests(cmdList, stateTracker, plan.Copies, HAL::ResourceState::CopyDestination, applyBackTransition);
         copyManager.FlushUploadRequests();
     }
 
+    void RecordRelocationRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager)
+    {
+        HAL::ResourceBarrierCollection preCopyTransisions{};
+        HAL::ResourceBarrierCollection postCopyTransisions{};
+
+        for (const Memory::CopyRequestManager::RelocationRequest& request : copyManager.RelocationRequests())
+        {
+            const Memory::ResourceStateTracker::SubresourceStateList prevStates = stateTracker.ResourceCurrentStates(request.Source);
+
+            preCopyTransisions.AddBarriers(stateTracker.TransitionToStateImmediately(request.Source, HAL::ResourceState::CopySource));
+            preCopyTransisions.AddBarriers(stateTracker.TransitionToStateImmediately(request.Destination, HAL::ResourceState::CopyDestination));
+
+            // Source keeps serving reads until the owner switches to the destination,
+            // destination should be indistinguishable from source by then
+            postCopyTransisions.AddBarriers(stateTracker.TransitionToStatesImmediately(request.Source, prevStates));
+            postCopyTransisions.AddBarriers(stateTracker.TransitionToStatesImmediately(request.Destination, prevStates));
+        }
+
+        cmdList.InsertBarriers(preCopyTransisions);
+
+        for (const Memory::CopyRequestManager::RelocationRequest& request : copyManager.RelocationRequests())
+        {
+            cmdList.CopyResource(*request.Source, *request.Destination);
+        }
+
+        cmdList.InsertBarriers(postCopyTransisions);
+        copyManager.FlushRelocationRequests();
+    }
+
     void RecordReadbackRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager, bool applyBackTransition)
     {
         RecordCopyRequests(cmdList, stateTracker, copyManager.ReadbackRequests(), HAL::ResourceState::CopySource, applyBackTransition);
@@ -3,10 +3,15 @@
 #include <Memory/ResourceStateTracker.hpp>
 #include <Memory/CopyRequestManager.hpp>
 
+#include <HardwareAbstractionLayer/CommandList.hpp>
+
 namespace PathFinder
 {
 
+    void RecordCopy(HAL::CopyCommandListBase& cmdList, const Memory::CopyRequestManager::CopyRegion& copy);
+
     void RecordUploadRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager, bool applyBackTransition);
+    void RecordRelocationRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager);
     void RecordReadbackRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager, bool applyBackTransition);
 
 }
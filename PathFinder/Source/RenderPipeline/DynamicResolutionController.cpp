@@ -0,0 +1,84 @@
+#include "DynamicResolutionController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    DynamicResolutionController::DynamicResolutionController(const Settings& settings)
+        : mSettings{ settings }
+    {
+        assert_format(mSettings.MinScale > 0.0f && mSettings.MinScale <= mSettings.MaxScale && mSettings.MaxScale <= 1.0f,
+            "Render scale bounds must satisfy 0 < min <= max <= 1");
+
+        assert_format(mSettings.TargetFrameTimeSeconds > 0.0f, "Target frame time must be positive");
+
+        Reset();
+    }
+
+    float DynamicResolutionController::Update(float gpuFrameTimeSeconds)
+    {
+        if (gpuFrameTimeSeconds <= 0.0f)
+        {
+            return mScale;
+        }
+
+        // Frames that were in flight during last change were rendered with previous scale
+        if (mFramesSinceScaleChange < mSettings.SettleFrameCount)
+        {
+            ++mFramesSinceScaleChange;
+            return mScale;
+        }
+
+        mSmoothedFrameTime = mMeasurementCount == 0 ?
+            gpuFrameTimeSeconds :
+            mSmoothedFrameTime + (gpuFrameTimeSeconds - mSmoothedFrameTime) * mSettings.SmoothingFactor;
+
+        ++mMeasurementCount;
+
+        float headroom = mSettings.TargetFrameTimeSeconds / mSmoothedFrameTime;
+
+        if (std::abs(headroom - 1.0f) <= mSettings.Hysteresis)
+        {
+            return mScale;
+        }
+
+        float estimatedScale = mScale * std::sqrt(headroom);
+        float rate = estimatedScale < mScale ? mSettings.DecreaseRate : mSettings.IncreaseRate;
+        float newScale = Quantize(mScale + (estimatedScale - mScale) * rate);
+
+        // Frame time is outside of hysteresis band, so scale has to move by at least one step
+        if (newScale == Quantize(mScale))
+        {
+            newScale += estimatedScale < mScale ? -mSettings.ScaleStep : mSettings.ScaleStep;
+        }
+
+        newScale = std::clamp(newScale, mSettings.MinScale, mSettings.MaxScale);
+
+        if (newScale != mScale)
+        {
+            mScale = newScale;
+            mMeasurementCount = 0;
+            mFramesSinceScaleChange = 0;
+            ++mScaleChangeCount;
+        }
+
+        return mScale;
+    }
+
+    void DynamicResolutionController::Reset()
+    {
+        mScale = mSettings.MaxScale;
+        mSmoothedFrameTime = 0.0f;
+        mMeasurementCount = 0;
+        mFramesSinceScaleChange = mSettings.SettleFrameCount;
+        mScaleChangeCount = 0;
+    }
+
+    float DynamicResolutionController::Quantize(float scale) const
+    {
+        return mSettings.ScaleStep > 0.0f ? std::round(scale / mSettings.ScaleStep) * mSettings.ScaleStep : scale;
+    }
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Picks a render scale that keeps GPU frame time close to a target.
+    /// Controller only consumes frame durations, so its behaviour can be verified
+    /// with synthetic timings without a device.
+    ///
+    /// GPU cost is assumed to be roughly proportional to pixel count,
+    /// so scale moves towards scale * sqrt(target / measured).
+    /// Deviations within hysteresis band are ignored and after every change
+    /// controller waits for frames rendered with the new scale before measuring again.
+    class DynamicResolutionController
+    {
+    public:
+        struct Settings
+        {
+            float TargetFrameTimeSeconds = 1.0f / 60.0f;
+            float MinScale = 0.5f;
+            float MaxScale = 1.0f;
+
+            // Relative deviation from target frame time that doesn't cause scale changes
+            float Hysteresis = 0.05f;
+
+            // Fraction of the distance to estimated scale covered by a single adjustment.
+            // Dropping resolution quickly and restoring it slowly avoids oscillation and hitches.
+            float DecreaseRate = 0.75f;
+            float IncreaseRate = 0.25f;
+
+            // Scales are snapped to multiples of this value to avoid rendering at slightly different sizes every frame
+            float ScaleStep = 1.0f / 64.0f;
+
+            // Weight of the newest measurement in exponential moving average of frame time
+            float SmoothingFactor = 0.25f;
+
+            // Measurements arrive with frames in flight delay,
+            // frames measured with a previous scale must be skipped after each change
+            uint64_t SettleFrameCount = 3;
+        };
+
+        DynamicResolutionController(const Settings& settings);
+
+        // Accepts duration of a completed GPU frame and returns scale to render next frame with.
+        // Non-positive durations are treated as missing measurements.
+        float Update(float gpuFrameTimeSeconds);
+
+        void Reset();
+
+    private:
+        float Quantize(float scale) const;
+
+        Settings mSettings;
+        float mScale = 1.0f;
+        float mSmoothedFrameTime = 0.0f;
+        uint64_t mMeasurementCount = 0;
+        uint64_t mFramesSinceScaleChange = 0;
+        uint64_t mScaleChangeCount = 0;
+
+    public:
+        inline float Scale() const { return mScale; }
+        inline float SmoothedFrameTimeSeconds() const { return mSmoothedFrameTime; }
+        inline uint64_t ScaleChangeCount() const { return mScaleChangeCount; }
+        inline const Settings& GetSettings() const { return mSettings; }
+    };
+
+}
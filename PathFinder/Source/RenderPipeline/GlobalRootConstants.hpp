@@ -9,6 +9,9 @@ namespace PathFinder
     {
         glm::vec2 PipelineRTResolution;
         glm::vec2 PipelineRTResolutionInverse;
+        // Part of pipeline render targets rendered at current dynamic resolution scale
+        glm::vec2 PipelineRenderResolution;
+        glm::vec2 PipelineRTUVScale;
         uint32_t AnisotropicClampSamplerIdx;
         uint32_t LinearClampSamplerIdx;
         uint32_t PointClampSamplerIdx;
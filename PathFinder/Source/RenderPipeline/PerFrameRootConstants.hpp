@@ -18,6 +18,7 @@ namespace PathFinder
         uint32_t IsGradientDebugEnabled;
         uint32_t IsMotionDebugEnabled;
         uint32_t IsDenoiserAntilagEnabled;
+        uint32_t IsRenderResolutionChanged;
     };
 
 }
@@ -177,7 +177,7 @@ namespace PathFinder
     PipelineResourceSchedulingInfo::PassInfo* PipelineResourceMemoryAliaser::GetFirstPassInfo(AliasingMetadataIterator schedulingInfoIt) const
     {
         const RenderPassGraph::Node* firstNode = mRenderPassGraph->NodesInGlobalExecutionOrder().at(schedulingInfoIt->SchedulingInfo->AliasingLifetime.first);
-        return schedulingInfoIt->SchedulingInfo->GetInfoForPass(firstNode->PassMetadata().Name);
+        return schedulingInfoIt->SchedulingInfo->GetInfoForPass(firstNode->IndexInUnorderedList());
     }
 
     void PipelineResourceMemoryAliaser::RemoveAliasedAllocationsFromOriginalList()
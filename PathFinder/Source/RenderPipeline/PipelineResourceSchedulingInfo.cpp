@@ -5,10 +5,21 @@
 namespace PathFinder
 {
 
-    PipelineResourceSchedulingInfo::PipelineResourceSchedulingInfo(Foundation::Name resourceName, const HAL::ResourceFormat& format)
+    PipelineResourceSchedulingInfo::PipelineResourceSchedulingInfo(Foundation::Name resourceName, const HAL::ResourceFormat& format, uint64_t passCount)
         : mResourceFormat{ format }, mResourceName{ resourceName }, mCombinedResourceNames{ resourceName.ToString() }, mSubresourceCount{ format.SubresourceCount() }
     {
         mSubresourceCombinedReadStates.resize(mSubresourceCount);
+        mPassInfos.resize(passCount);
+        mSubresourceInfos.resize(passCount * mSubresourceCount);
+    }
+
+    void PipelineResourceSchedulingInfo::SetPassCount(uint64_t passCount)
+    {
+        assert_format(passCount >= mPassInfos.size(), "Pass data cannot shrink during scheduling");
+
+        // Data is laid out pass by pass, so infos of existing passes stay in place
+        mPassInfos.resize(passCount);
+        mSubresourceInfos.resize(passCount * mSubresourceCount);
     }
 
     void PipelineResourceSchedulingInfo::AddExpectedStates(HAL::ResourceState states)
@@ -28,33 +39,40 @@ namespace PathFinder
         mResourceFormat.SetExpectedStates(mExpectedStates);
     }
 
-    const PipelineResourceSchedulingInfo::PassInfo* PipelineResourceSchedulingInfo::GetInfoForPass(Foundation::Name passName) const
+    const PipelineResourceSchedulingInfo::PassInfo* PipelineResourceSchedulingInfo::GetInfoForPass(uint64_t passIndex) const
     {
-        auto it = mPassInfoMap.find(passName);
-        return it != mPassInfoMap.end() ? &it->second : nullptr;
+        return passIndex < mPassInfos.size() && mPassInfos[passIndex].IsScheduled ? &mPassInfos[passIndex] : nullptr;
     }
 
-    PipelineResourceSchedulingInfo::PassInfo* PipelineResourceSchedulingInfo::GetInfoForPass(Foundation::Name passName)
+    PipelineResourceSchedulingInfo::PassInfo* PipelineResourceSchedulingInfo::GetInfoForPass(uint64_t passIndex)
     {
-        auto it = mPassInfoMap.find(passName);
-        return it != mPassInfoMap.end() ? &it->second : nullptr;
+        return passIndex < mPassInfos.size() && mPassInfos[passIndex].IsScheduled ? &mPassInfos[passIndex] : nullptr;
+    }
+
+    const std::optional<PipelineResourceSchedulingInfo::SubresourceInfo>& PipelineResourceSchedulingInfo::GetSubresourceInfo(uint64_t passIndex, uint64_t subresourceIndex) const
+    {
+        assert_format(passIndex < mPassInfos.size() && subresourceIndex < mSubresourceCount, "Pass or subresource index is out of bounds");
+        return mSubresourceInfos[passIndex * mSubresourceCount + subresourceIndex];
     }
 
     void PipelineResourceSchedulingInfo::SetSubresourceInfo(
-        Foundation::Name passName,
+        uint64_t passIndex,
         uint64_t subresourceIndex,
         HAL::ResourceState state,
         SubresourceInfo::AccessFlag accessFlag,
         std::optional<HAL::ColorFormat> shaderVisibleFormat)
     {
         assert_format(subresourceIndex < mSubresourceCount, "Subresource index is out of bounds");
+        assert_format(passIndex < mPassInfos.size(), "Pass index is out of bounds");
+
+        PassInfo& passInfo = mPassInfos[passIndex];
+        passInfo.IsScheduled = true;
 
-        PassInfo& passInfo = mPassInfoMap[passName];
-        passInfo.SubresourceInfos.resize(mSubresourceCount);
-        passInfo.SubresourceInfos[subresourceIndex] = SubresourceInfo{};
-        passInfo.SubresourceInfos[subresourceIndex]->AccessValidationFlag = accessFlag;
-        passInfo.SubresourceInfos[subresourceIndex]->RequestedState = state;
-        passInfo.SubresourceInfos[subresourceIndex]->ShaderVisibleFormat = shaderVisibleFormat;
+        std::optional<SubresourceInfo>& subresourceInfo = mSubresourceInfos[passIndex * mSubresourceCount + subresourceIndex];
+        subresourceInfo = SubresourceInfo{};
+        subresourceInfo->AccessValidationFlag = accessFlag;
+        subresourceInfo->RequestedState = state;
+        subresourceInfo->ShaderVisibleFormat = shaderVisibleFormat;
 
         if (IsResourceStateReadOnly(state))
         {
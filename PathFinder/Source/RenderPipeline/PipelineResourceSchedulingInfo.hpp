@@ -8,6 +8,7 @@
 
 #include <functional>
 #include <optional>
+#include <vector>
 
 namespace PathFinder
 {
@@ -32,22 +33,26 @@ namespace PathFinder
 
         struct PassInfo
         {
-            std::vector<std::optional<SubresourceInfo>> SubresourceInfos;
             bool NeedsUnorderedAccessBarrier = false;
             bool NeedsAliasingBarrier = false;
             bool IsReadbackRequested = false;
+            bool IsScheduled = false;
         };
 
-        PipelineResourceSchedulingInfo(Foundation::Name resourceName, const HAL::ResourceFormat& format);
+        // Pass data is indexed by pass node index in render pass graph
+        PipelineResourceSchedulingInfo(Foundation::Name resourceName, const HAL::ResourceFormat& format, uint64_t passCount);
 
+        // Sub passes join the graph after the first scheduling wave, so pass data grows with it
+        void SetPassCount(uint64_t passCount);
         void AddExpectedStates(HAL::ResourceState states);
         void AddNameAlias(Foundation::Name alias);
         void ApplyExpectedStates();
-        const PassInfo* GetInfoForPass(Foundation::Name passName) const;
-        PassInfo* GetInfoForPass(Foundation::Name passName);
+        const PassInfo* GetInfoForPass(uint64_t passIndex) const;
+        PassInfo* GetInfoForPass(uint64_t passIndex);
+        const std::optional<SubresourceInfo>& GetSubresourceInfo(uint64_t passIndex, uint64_t subresourceIndex) const;
 
         void SetSubresourceInfo(
-            Foundation::Name passName, 
+            uint64_t passIndex, 
             uint64_t subresourceIndex, 
             HAL::ResourceState state, 
             SubresourceInfo::AccessFlag accessFlag,
@@ -64,7 +69,10 @@ namespace PathFinder
         };
 
     private:
-        std::unordered_map<Foundation::Name, PassInfo> mPassInfoMap;
+        // Flat storage instead of per pass maps and lists: two allocations per resource regardless of pass count.
+        // Subresource infos are laid out pass by pass.
+        std::vector<PassInfo> mPassInfos;
+        std::vector<std::optional<SubresourceInfo>> mSubresourceInfos;
         HAL::ResourceFormat mResourceFormat;
         HAL::ResourceState mExpectedStates = HAL::ResourceState::Common;
         Foundation::Name mResourceName;
@@ -5,6 +5,7 @@
 #include <Foundation/StringUtils.hpp>
 
 #include <Foundation/STDHelpers.hpp>
+#include <Foundation/HashUtils.hpp>
 
 #include "RenderPasses/PipelineNames.hpp"
 
@@ -16,11 +17,16 @@ namespace PathFinder
         Memory::GPUResourceProducer* resourceProducer,
         Memory::PoolDescriptorAllocator* descriptorAllocator,
         Memory::ResourceStateTracker* stateTracker,
+        Memory::MemoryBudgetTracker* budgetTracker,
+        Memory::ConstantBufferManager* constantBufferManager,
+        uint64_t simultaneousFramesInFlight,
         const RenderSurfaceDescription& defaultRenderSurface,
         const RenderPassGraph* passExecutionGraph)
         :
         mDevice{ device },
         mResourceStateTracker{ stateTracker },
+        mBudgetTracker{ budgetTracker },
+        mConstantBufferManager{ constantBufferManager },
         mRTDSMemoryAliaser{ passExecutionGraph },
         mNonRTDSMemoryAliaser{ passExecutionGraph },
         mUniversalMemoryAliaser{ passExecutionGraph },
@@ -28,31 +34,58 @@ namespace PathFinder
         mDefaultRenderSurface{ defaultRenderSurface },
         mResourceProducer{ resourceProducer },
         mDescriptorAllocator{ descriptorAllocator },
-        mPassExecutionGraph{ passExecutionGraph } {}
+        mPassExecutionGraph{ passExecutionGraph },
+        // Resources released in a frame may still be used by GPU until that frame completes
+        mMemoryLayoutPool{ simultaneousFramesInFlight, PooledResourceLifetime },
+        mTexturePool{ simultaneousFramesInFlight, PooledResourceLifetime },
+        mBufferPool{ simultaneousFramesInFlight, PooledResourceLifetime }
+    {
+        mGlobalConstantsStream = mConstantBufferManager->CreateStream();
+        mPerFrameConstantsStream = mConstantBufferManager->CreateStream();
+    }
+
+    PipelineResourceStorage::TransientMemoryLayout::TransientMemoryLayout()
+        // Placed resources are never evicted on their own: they live exactly as long as the layout
+        : PlacedTextures{ 0, 0 }, PlacedBuffers{ 0, 0 } {}
+
+    uint64_t PipelineResourceStorage::TransientMemoryLayout::HeapBytes() const
+    {
+        uint64_t heapBytes = 0;
+
+        for (const HAL::Heap* heap : { RTDSHeap.get(), NonRTDSHeap.get(), BufferHeap.get(), UniversalHeap.get() })
+        {
+            if (heap)
+            {
+                heapBytes += heap->AlighnedSize();
+            }
+        }
+
+        return heapBytes;
+    }
 
-    const HAL::RTDescriptor* PipelineResourceStorage::GetRenderTargetDescriptor(Foundation::Name resourceName, Foundation::Name passName, uint64_t mipIndex) const
+    const HAL::RTDescriptor* PipelineResourceStorage::GetRenderTargetDescriptor(Foundation::Name resourceName, const RenderPassGraph::Node& passNode, uint64_t mipIndex) const
     {
         const PipelineResourceStorageResource* resourceObjects = GetPerResourceData(resourceName);
         const Memory::Texture* texture = resourceObjects->Texture.get();
         assert_format(texture, "Resource ", resourceName.ToString(), " doesn't exist");
 
-        const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceObjects->SchedulingInfo.GetInfoForPass(passName);
+        const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceObjects->SchedulingInfo.GetInfoForPass(passNode.IndexInUnorderedList());
         assert_format(passInfo, "Resource ", resourceName.ToString(), " was not scheduled to be used as render target");
 
-        const std::optional<PipelineResourceSchedulingInfo::SubresourceInfo>& subresourceInfo = passInfo->SubresourceInfos[mipIndex];
+        const std::optional<PipelineResourceSchedulingInfo::SubresourceInfo>& subresourceInfo = resourceObjects->SchedulingInfo.GetSubresourceInfo(passNode.IndexInUnorderedList(), mipIndex);
         assert_format(subresourceInfo != std::nullopt, "Resource ", resourceName.ToString(), ". Mip ", mipIndex, " was not scheduled to be used as render target");
         
         return texture->GetRTDescriptor(mipIndex);
     }
 
-    const HAL::DSDescriptor* PipelineResourceStorage::GetDepthStencilDescriptor(ResourceName resourceName, Foundation::Name passName) const
+    const HAL::DSDescriptor* PipelineResourceStorage::GetDepthStencilDescriptor(ResourceName resourceName, const RenderPassGraph::Node& passNode) const
     {
         const PipelineResourceStorageResource* resourceObjects = GetPerResourceData(resourceName);
         const Memory::Texture* texture = resourceObjects->Texture.get();
         assert_format(texture, "Resource ", resourceName.ToString(), " doesn't exist");
 
-        const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceObjects->SchedulingInfo.GetInfoForPass(passName);
-        assert_format(passInfo && passInfo->SubresourceInfos[0], "Resource ", resourceName.ToString(), " was not scheduled to be used as depth-stencil attachment");
+        const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceObjects->SchedulingInfo.GetInfoForPass(passNode.IndexInUnorderedList());
+        assert_format(passInfo && resourceObjects->SchedulingInfo.GetSubresourceInfo(passNode.IndexInUnorderedList(), 0), "Resource ", resourceName.ToString(), " was not scheduled to be used as depth-stencil attachment");
 
         return texture->GetDSDescriptor();
     }
@@ -64,29 +97,27 @@ namespace PathFinder
         return samplerIt->second.second.get();
     }
 
-    void PipelineResourceStorage::BeginFrame()
+    void PipelineResourceStorage::BeginFrame(uint64_t frameNumber)
     {
-        // Preallocate 
-        if (!mGlobalRootConstantsBuffer)
-        {
-            mGlobalRootConstantsBuffer = mResourceProducer->NewBuffer(
-                HAL::BufferProperties::Create<uint8_t>(1024, 1, HAL::ResourceState::ConstantBuffer));
-        }
-        
-        if (!mPerFrameRootConstantsBuffer)
-        {
-            mPerFrameRootConstantsBuffer = mResourceProducer->NewBuffer(
-                HAL::BufferProperties::Create<uint8_t>(1024, 1, HAL::ResourceState::ConstantBuffer),
-                Memory::GPUResource::AccessStrategy::DirectUpload);
-        }
-            
         mPreviousFrameResources->clear();
         mPreviousFrameResourceMap->clear();
-        mPreviousFrameDiffEntries->clear();
 
-        std::swap(mPreviousFrameDiffEntries, mCurrentFrameDiffEntries);
         std::swap(mPreviousFrameResources, mCurrentFrameResources);
         std::swap(mPreviousFrameResourceMap, mCurrentFrameResourceMap);
+
+        uint64_t evictionCount = 
+            mMemoryLayoutPool.GetStatistics().EvictionCount + 
+            mTexturePool.GetStatistics().EvictionCount + 
+            mBufferPool.GetStatistics().EvictionCount;
+
+        mMemoryLayoutPool.BeginFrame(frameNumber);
+        mTexturePool.BeginFrame(frameNumber);
+        mBufferPool.BeginFrame(frameNumber);
+
+        mPooledMemoryEvicted = evictionCount != 
+            mMemoryLayoutPool.GetStatistics().EvictionCount + 
+            mTexturePool.GetStatistics().EvictionCount + 
+            mBufferPool.GetStatistics().EvictionCount;
     }
 
     void PipelineResourceStorage::EndFrame()
@@ -105,9 +136,6 @@ namespace PathFinder
 
     void PipelineResourceStorage::StartResourceScheduling()
     {
-        mSchedulingCreationRequests.clear();
-        mSchedulingUsageRequests.clear();
-        mSchedulingReadbackRequests.clear();
         mPrimaryResourceCreationRequests.clear();
         mSecondaryResourceCreationRequests.clear();
         mAliasMap.clear();
@@ -115,6 +143,12 @@ namespace PathFinder
 
     void PipelineResourceStorage::EndResourceScheduling()
     {
+        // Resources created in previous scheduling waves have to cover passes added since then
+        for (PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
+        {
+            resourceData.SchedulingInfo.SetPassCount(mPassExecutionGraph->Nodes().size());
+        }
+
         // Create resource data 
         for (ResourceCreationRequest& request : mPrimaryResourceCreationRequests)
         {
@@ -135,19 +169,17 @@ namespace PathFinder
             CreatePerResourceData(request.ResourceName, resourceData->SchedulingInfo.ResourceFormat());
         }
 
-        std::vector<ResourceName> aliases;
-
         // Flat out aliases
         while (!mAliasMap.empty())
         {
-            aliases.clear();
+            mAliasChain.clear();
 
             auto aliasAndOriginalIt = mAliasMap.begin();
             ResourceName originalName = aliasAndOriginalIt->second;
 
             while (aliasAndOriginalIt != mAliasMap.end())
             {
-                aliases.push_back(aliasAndOriginalIt->first);
+                mAliasChain.push_back(aliasAndOriginalIt->first);
                 // Take next name in chain`
                 originalName = aliasAndOriginalIt->second;
                 // Remove processed alias so we don't encounter it again on next iterations
@@ -162,40 +194,13 @@ namespace PathFinder
             PipelineResourceStorageResource& resourceData = mCurrentFrameResources->at(indexIt->second);
 
             // Associate aliases with original resource
-            for (ResourceName alias : aliases)
+            for (ResourceName alias : mAliasChain)
             {
                 mCurrentFrameResourceMap->emplace(alias, indexIt->second);
                 resourceData.SchedulingInfo.AddNameAlias(alias);
             }
         }
 
-        // Run scheduling creation callbacks
-        for (SchedulingRequest& request : mSchedulingCreationRequests)
-        {
-            uint64_t resourceDataIndex = mCurrentFrameResourceMap->at(request.ResourceName);
-            PipelineResourceStorageResource& resourceData = mCurrentFrameResources->at(resourceDataIndex);
-            request.Configurator(resourceData.SchedulingInfo);
-        }
-
-        // Run scheduling usage callbacks
-        for (SchedulingRequest& request : mSchedulingUsageRequests)
-        {
-            auto indexIt = mCurrentFrameResourceMap->find(request.ResourceName);
-            assert_format(indexIt != mCurrentFrameResourceMap->end(), "Trying to use a resource that wasn't created: ", request.ResourceName.ToString());
-
-            PipelineResourceStorageResource& resourceData = mCurrentFrameResources->at(indexIt->second);
-            request.Configurator(resourceData.SchedulingInfo);
-        }
-
-        // Run scheduling readback callbacks
-        for (SchedulingRequest& request : mSchedulingReadbackRequests)
-        {
-            auto indexIt = mCurrentFrameResourceMap->find(request.ResourceName);
-            assert_format(indexIt != mCurrentFrameResourceMap->end(), "Trying to readback a resource that wasn't created: ", request.ResourceName.ToString());
-
-            PipelineResourceStorageResource& resourceData = mCurrentFrameResources->at(indexIt->second);
-            request.Configurator(resourceData.SchedulingInfo);
-        }
     }
 
     void PipelineResourceStorage::AllocateScheduledResources()
@@ -251,49 +256,32 @@ namespace PathFinder
 
         if (mMemoryLayoutChanged)
         {
-            // Re-alias memory, then reallocate resources only if memory was invalidated
-            // which can happen on first run or when resource properties were changed by the user.
+            // Reallocate resources only if memory was invalidated, which can happen 
+            // on first run or when resource properties were changed by the user.
+            // Previous resources go to pools first, so that ones that didn't change are picked up again.
             //
-            if (!mRTDSMemoryAliaser.IsEmpty()) mRTDSHeap = std::make_unique<HAL::Heap>(*mDevice, mRTDSMemoryAliaser.Alias(), HAL::HeapAliasingGroup::RTDSTextures);
-            if (!mNonRTDSMemoryAliaser.IsEmpty()) mNonRTDSHeap = std::make_unique<HAL::Heap>(*mDevice, mNonRTDSMemoryAliaser.Alias(), HAL::HeapAliasingGroup::NonRTDSTextures);
-            if (!mBufferMemoryAliaser.IsEmpty()) mBufferHeap = std::make_unique<HAL::Heap>(*mDevice, mBufferMemoryAliaser.Alias(), HAL::HeapAliasingGroup::Buffers);
-            if (!mUniversalMemoryAliaser.IsEmpty()) mUniversalHeap = std::make_unique<HAL::Heap>(*mDevice, mUniversalMemoryAliaser.Alias(), HAL::HeapAliasingGroup::Universal);
+            ReleasePreviousFrameResources();
+            AcquireMemoryLayout();
 
             for (PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
             {
-                const HAL::ResourceFormat& format = resourceData.SchedulingInfo.ResourceFormat();
-                HAL::Heap* heap = GetHeapForAliasingGroup(format.ResourceAliasingGroup());
-
-                std::visit(Foundation::MakeVisitor(
-                    [&resourceData, heap, this](const HAL::TextureProperties& textureProps)
-                    {
-                        resourceData.Texture = resourceData.SchedulingInfo.CanBeAliased ?
-                            mResourceProducer->NewTexture(textureProps, *heap, resourceData.SchedulingInfo.HeapOffset) :
-                            mResourceProducer->NewTexture(textureProps);
-
-                        resourceData.Texture->SetDebugName(resourceData.SchedulingInfo.CombinedResourceNames());
-                    },
-                    [&resourceData, heap, this](const HAL::BufferProperties& bufferProps)
-                    {
-                        resourceData.Buffer = resourceData.SchedulingInfo.CanBeAliased ?
-                            mResourceProducer->NewBuffer(bufferProps, *heap, resourceData.SchedulingInfo.HeapOffset) :
-                            mResourceProducer->NewBuffer(bufferProps);
-
-                        resourceData.Buffer->SetDebugName(resourceData.SchedulingInfo.CombinedResourceNames());
-                    }),
-                    format.ResourceProperties());
+                AcquireResource(resourceData);
             }
+
+            UpdatePooledBytesLimits();
+        }
+
+        if (mMemoryLayoutChanged || mPooledMemoryEvicted)
+        {
+            ReportTransientMemory();
         }
     }
 
     void PipelineResourceStorage::QueueResourceAllocationIfNeeded(
         ResourceName resourceName,
         const HAL::ResourcePropertiesVariant& properties,
-        std::optional<Foundation::Name> propertyCopySourceName,
-        const SchedulingInfoConfigurator& siConfigurator)
+        std::optional<Foundation::Name> propertyCopySourceName)
     {
-        mSchedulingCreationRequests.emplace_back(SchedulingRequest{ siConfigurator, resourceName });
-
         if (propertyCopySourceName)
         {
             mSecondaryResourceCreationRequests.emplace_back(ResourceCreationRequest{ properties, resourceName, *propertyCopySourceName });
@@ -303,21 +291,9 @@ namespace PathFinder
         }
     }
 
-    void PipelineResourceStorage::QueueResourceUsage(ResourceName resourceName, std::optional<ResourceName> aliasName, const SchedulingInfoConfigurator& siConfigurator)
-    {
-        if (aliasName)
-        {
-            mSchedulingUsageRequests.emplace_back(SchedulingRequest{ siConfigurator, *aliasName });
-            mAliasMap[*aliasName] = resourceName;
-        }
-        else {
-            mSchedulingUsageRequests.emplace_back(SchedulingRequest{ siConfigurator, resourceName });
-        }
-    }
-
-    void PipelineResourceStorage::QueueResourceReadback(ResourceName resourceName, const SchedulingInfoConfigurator& siConfigurator)
+    void PipelineResourceStorage::QueueResourceAlias(ResourceName resourceName, ResourceName aliasName)
     {
-        mSchedulingReadbackRequests.push_back(SchedulingRequest{ siConfigurator, resourceName });
+        mAliasMap[aliasName] = resourceName;
     }
 
     void PipelineResourceStorage::AddSampler(Foundation::Name samplerName, const HAL::Sampler& sampler)
@@ -329,6 +305,7 @@ namespace PathFinder
     PipelineResourceStoragePass& PipelineResourceStorage::CreatePerPassData(PassName name)
     {
         auto [it, success] = mPerPassData.emplace(name, PipelineResourceStoragePass{});
+        it->second.ConstantStream = mConstantBufferManager->CreateStream();
 
         auto properties = HAL::BufferProperties::Create<float>(1024);
         it->second.PassDebugBuffer = mResourceProducer->NewBuffer(properties);
@@ -344,87 +321,270 @@ namespace PathFinder
 
     PipelineResourceStorageResource& PipelineResourceStorage::CreatePerResourceData(ResourceName name, const HAL::ResourceFormat& resourceFormat)
     {
-        PipelineResourceStorageResource& resourceObjects = mCurrentFrameResources->emplace_back(name, resourceFormat);
+        PipelineResourceStorageResource& resourceObjects = mCurrentFrameResources->emplace_back(name, resourceFormat, mPassExecutionGraph->Nodes().size());
         mCurrentFrameResourceMap->emplace(name, mCurrentFrameResources->size() - 1);
         return resourceObjects;
     }
 
+    void PipelineResourceStorage::ReportTransientMemory()
+    {
+        if (!mBudgetTracker)
+        {
+            return;
+        }
+
+        uint64_t heapCount = 0;
+        uint64_t heapBytes = 0;
+
+        auto countHeaps = [&heapCount, &heapBytes](const TransientMemoryLayout& layout)
+        {
+            for (const HAL::Heap* heap : { layout.RTDSHeap.get(), layout.NonRTDSHeap.get(), layout.BufferHeap.get(), layout.UniversalHeap.get() })
+            {
+                if (heap)
+                {
+                    heapCount += 1;
+                    heapBytes += heap->AlighnedSize();
+                }
+            }
+        };
+
+        if (mMemoryLayout)
+        {
+            countHeaps(*mMemoryLayout);
+        }
+
+        // Pooled layouts keep their heaps alive
+        mMemoryLayoutPool.ForEachPooledResource([&countHeaps](const std::unique_ptr<TransientMemoryLayout>& layout, uint64_t sizeInBytes)
+        {
+            countHeaps(*layout);
+        });
+
+        // Non-aliased resources are accounted by resource allocator
+        uint64_t resourceCount = 0;
+        uint64_t resourceBytes = 0;
+
+        for (const PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
+        {
+            if (resourceData.SchedulingInfo.CanBeAliased)
+            {
+                resourceCount += 1;
+                resourceBytes += resourceData.SchedulingInfo.ResourceFormat().ResourceSizeInBytes();
+            }
+        }
+
+        mBudgetTracker->ReportTransientMemory(heapCount, heapBytes, resourceCount, resourceBytes);
+    }
+
     HAL::Heap* PipelineResourceStorage::GetHeapForAliasingGroup(HAL::HeapAliasingGroup group)
     {
+        if (!mMemoryLayout)
+        {
+            return nullptr;
+        }
+
         switch (group)
         {
-        case HAL::HeapAliasingGroup::RTDSTextures: return mRTDSHeap.get(); 
-        case HAL::HeapAliasingGroup::NonRTDSTextures: return mNonRTDSHeap.get(); 
-        case HAL::HeapAliasingGroup::Buffers: return mBufferHeap.get(); 
-        case HAL::HeapAliasingGroup::Universal: return mUniversalHeap.get();
+        case HAL::HeapAliasingGroup::RTDSTextures: return mMemoryLayout->RTDSHeap.get(); 
+        case HAL::HeapAliasingGroup::NonRTDSTextures: return mMemoryLayout->NonRTDSHeap.get(); 
+        case HAL::HeapAliasingGroup::Buffers: return mMemoryLayout->BufferHeap.get(); 
+        case HAL::HeapAliasingGroup::Universal: return mMemoryLayout->UniversalHeap.get();
         default: return nullptr;
         }
     }
 
     bool PipelineResourceStorage::TransferPreviousFrameResources()
     {
+        // Any added, removed or changed resource invalidates aliased memory layout,
+        // so either every resource is transferred from previous frame or none of them.
+        // Names are unique, so equal counts and a match for every current resource mean equal sets.
+        if (mCurrentFrameResources->size() != mPreviousFrameResources->size())
+        {
+            return false;
+        }
+
+        for (const PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
+        {
+            auto prevResourceDataIndexIt = mPreviousFrameResourceMap->find(resourceData.ResourceName());
+
+            if (prevResourceDataIndexIt == mPreviousFrameResourceMap->end() ||
+                mPreviousFrameResources->at(prevResourceDataIndexIt->second).SchedulingHash() != resourceData.SchedulingHash())
+            {
+                return false;
+            }
+        }
+
         for (PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
         {
-            PipelineResourceStorageResource::DiffEntry diffEntry = resourceData.GetDiffEntry();
-            mCurrentFrameDiffEntries->push_back(diffEntry);
+            PipelineResourceStorageResource& prevResourceData = mPreviousFrameResources->at(mPreviousFrameResourceMap->at(resourceData.ResourceName()));
+
+            // Transfer GPU resources from previous frame
+            resourceData.Texture = std::move(prevResourceData.Texture);
+            resourceData.Buffer = std::move(prevResourceData.Buffer);
         }
 
-        // Make diff independent from order by sorting first
-        std::sort(mCurrentFrameDiffEntries->begin(), mCurrentFrameDiffEntries->end(), [](auto& first, auto& second)
+        return true;
+    }
+
+    void PipelineResourceStorage::ReleasePreviousFrameResources()
+    {
+        for (PipelineResourceStorageResource& resourceData : *mPreviousFrameResources)
         {
-            return first.ResourceName.ToId() < second.ResourceName.ToId();
-        });
+            uint64_t sizeInBytes = resourceData.SchedulingInfo.TotalRequiredMemory();
+            uint64_t poolHash = PooledResourceHash(resourceData);
+            PooledResourceProperties poolProperties = GetPooledResourceProperties(resourceData);
 
-        dtl::Diff<PipelineResourceStorageResource::DiffEntry> diff{ *mPreviousFrameDiffEntries, *mCurrentFrameDiffEntries };
+            // Aliased resources of previous frame were placed into current layout
+            TexturePool& texturePool = resourceData.SchedulingInfo.CanBeAliased ? mMemoryLayout->PlacedTextures : mTexturePool;
+            BufferPool& bufferPool = resourceData.SchedulingInfo.CanBeAliased ? mMemoryLayout->PlacedBuffers : mBufferPool;
 
-        diff.compose();
-        dtl::Ses ses = diff.getSes();
-        auto sequence = ses.getSequence();
+            if (resourceData.Texture) texturePool.Release(poolHash, poolProperties, std::move(resourceData.Texture), sizeInBytes);
+            if (resourceData.Buffer) bufferPool.Release(poolHash, poolProperties, std::move(resourceData.Buffer), sizeInBytes);
+        }
 
-        if (ses.isChange())
+        if (mMemoryLayout)
         {
-            // Any ADD or DELETE will invalidate aliased memory layout
-            // so we'll need to reallocate everything.
-            // Return because there is nothing to transfer from previous frame:
-            // whole memory is invalidated.
-            return false;
+            uint64_t heapBytes = mMemoryLayout->HeapBytes();
+            mMemoryLayoutPool.Release(mMemoryLayoutHash, mMemoryLayoutProperties, std::move(mMemoryLayout), heapBytes);
         }
+    }
 
-        for (auto& [diffEntry, elementInfo] : sequence)
+    void PipelineResourceStorage::AcquireMemoryLayout()
+    {
+        using namespace Foundation::HashUtils;
+
+        // Re-alias memory to know heap sizes and resource offsets
+        uint64_t rtdsHeapSize = mRTDSMemoryAliaser.IsEmpty() ? 0 : mRTDSMemoryAliaser.Alias();
+        uint64_t nonRTDSHeapSize = mNonRTDSMemoryAliaser.IsEmpty() ? 0 : mNonRTDSMemoryAliaser.Alias();
+        uint64_t bufferHeapSize = mBufferMemoryAliaser.IsEmpty() ? 0 : mBufferMemoryAliaser.Alias();
+        uint64_t universalHeapSize = mUniversalMemoryAliaser.IsEmpty() ? 0 : mUniversalMemoryAliaser.Alias();
+
+        // Sum of placement hashes doesn't depend on resource order
+        uint64_t placementsHash = 0;
+
+        for (const PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
         {
-            dtl::edit_t diffOperation = elementInfo.type;
+            if (resourceData.SchedulingInfo.CanBeAliased)
+            {
+                placementsHash += Mix(PlacementHash(resourceData));
+            }
+        }
+
+        mMemoryLayoutHash = Combine(Mix(rtdsHeapSize), nonRTDSHeapSize);
+        mMemoryLayoutHash = Combine(mMemoryLayoutHash, bufferHeapSize);
+        mMemoryLayoutHash = Combine(mMemoryLayoutHash, universalHeapSize);
+        mMemoryLayoutHash = Combine(mMemoryLayoutHash, placementsHash);
+        mMemoryLayoutProperties = { rtdsHeapSize, nonRTDSHeapSize, bufferHeapSize, universalHeapSize };
 
-            switch (diffOperation)
+        // Placements only take part in the hash to prefer layouts already holding matching placed resources
+        mMemoryLayout = mMemoryLayoutPool.AcquireOrCreate(mMemoryLayoutHash, mMemoryLayoutProperties, [&]
+        {
+            auto layout = std::make_unique<TransientMemoryLayout>();
+            if (rtdsHeapSize > 0) layout->RTDSHeap = std::make_unique<HAL::Heap>(*mDevice, rtdsHeapSize, HAL::HeapAliasingGroup::RTDSTextures);
+            if (nonRTDSHeapSize > 0) layout->NonRTDSHeap = std::make_unique<HAL::Heap>(*mDevice, nonRTDSHeapSize, HAL::HeapAliasingGroup::NonRTDSTextures);
+            if (bufferHeapSize > 0) layout->BufferHeap = std::make_unique<HAL::Heap>(*mDevice, bufferHeapSize, HAL::HeapAliasingGroup::Buffers);
+            if (universalHeapSize > 0) layout->UniversalHeap = std::make_unique<HAL::Heap>(*mDevice, universalHeapSize, HAL::HeapAliasingGroup::Universal);
+            return layout;
+        });
+    }
+
+    void PipelineResourceStorage::AcquireResource(PipelineResourceStorageResource& resourceData)
+    {
+        const HAL::ResourceFormat& format = resourceData.SchedulingInfo.ResourceFormat();
+        const HAL::Heap* heap = GetHeapForAliasingGroup(format.ResourceAliasingGroup());
+        uint64_t heapOffset = resourceData.SchedulingInfo.HeapOffset;
+        bool canBeAliased = resourceData.SchedulingInfo.CanBeAliased;
+        uint64_t poolHash = PooledResourceHash(resourceData);
+        PooledResourceProperties poolProperties = GetPooledResourceProperties(resourceData);
+
+        std::visit(Foundation::MakeVisitor(
+            [&](const HAL::TextureProperties& textureProps)
             {
-            case dtl::SES_COMMON:
+                TexturePool& pool = canBeAliased ? mMemoryLayout->PlacedTextures : mTexturePool;
+
+                resourceData.Texture = pool.AcquireOrCreate(poolHash, poolProperties, [&]
+                {
+                    return canBeAliased ?
+                        mResourceProducer->NewTexture(textureProps, *heap, heapOffset) :
+                        mResourceProducer->NewTexture(textureProps, Memory::MemoryCategory::TransientRenderTarget);
+                });
+
+                resourceData.Texture->SetDebugName(resourceData.SchedulingInfo.CombinedResourceNames());
+            },
+            [&](const HAL::BufferProperties& bufferProps)
             {
-                // COMMON case means resource should be transfered from previous frame
-                uint64_t indexInPrevFrame = mPreviousFrameResourceMap->at(diffEntry.ResourceName);
-                uint64_t indexInCurrFrame = mCurrentFrameResourceMap->at(diffEntry.ResourceName);
-                PipelineResourceStorageResource& prevResourceData = mPreviousFrameResources->at(indexInPrevFrame);
-                PipelineResourceStorageResource& resourceData = mCurrentFrameResources->at(indexInCurrFrame);
-
-                // Transfer GPU resources from previous frame
-                resourceData.Texture = std::move(prevResourceData.Texture);
-                resourceData.Buffer = std::move(prevResourceData.Buffer);
-            }
-                
-            default:
-                break;
+                BufferPool& pool = canBeAliased ? mMemoryLayout->PlacedBuffers : mBufferPool;
+
+                resourceData.Buffer = pool.AcquireOrCreate(poolHash, poolProperties, [&]
+                {
+                    return canBeAliased ?
+                        mResourceProducer->NewBuffer(bufferProps, *heap, heapOffset) :
+                        mResourceProducer->NewBuffer(bufferProps, Memory::GPUResource::AccessStrategy::Automatic, Memory::MemoryCategory::TransientRenderTarget);
+                });
+
+                resourceData.Buffer->SetDebugName(resourceData.SchedulingInfo.CombinedResourceNames());
+            }),
+            format.ResourceProperties());
+    }
+
+    void PipelineResourceStorage::UpdatePooledBytesLimits()
+    {
+        uint64_t textureBytes = 0;
+        uint64_t bufferBytes = 0;
+
+        for (const PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
+        {
+            if (resourceData.SchedulingInfo.CanBeAliased)
+            {
+                continue;
             }
+
+            uint64_t& bytes = resourceData.Texture ? textureBytes : bufferBytes;
+            bytes += resourceData.SchedulingInfo.TotalRequiredMemory();
         }
 
-        return true;
+        mMemoryLayoutPool.SetPooledBytesLimit(PooledBytesToUsedBytesRatio * mMemoryLayout->HeapBytes());
+        mTexturePool.SetPooledBytesLimit(PooledBytesToUsedBytesRatio * textureBytes);
+        mBufferPool.SetPooledBytesLimit(PooledBytesToUsedBytesRatio * bufferBytes);
     }
 
-    const Memory::Buffer* PipelineResourceStorage::GlobalRootConstantsBuffer() const
+    uint64_t PipelineResourceStorage::PlacementHash(const PipelineResourceStorageResource& resourceData)
     {
-        return mGlobalRootConstantsBuffer.get();
+        return Foundation::HashUtils::Combine(resourceData.PropertiesHash(), resourceData.SchedulingInfo.HeapOffset);
     }
 
-    const Memory::Buffer* PipelineResourceStorage::PerFrameRootConstantsBuffer() const
+    uint64_t PipelineResourceStorage::PooledResourceHash(const PipelineResourceStorageResource& resourceData)
     {
-        return mPerFrameRootConstantsBuffer.get();
+        return resourceData.SchedulingInfo.CanBeAliased ? PlacementHash(resourceData) : resourceData.PropertiesHash();
+    }
+
+    PipelineResourceStorage::PooledResourceProperties PipelineResourceStorage::GetPooledResourceProperties(const PipelineResourceStorageResource& resourceData)
+    {
+        const PipelineResourceSchedulingInfo& schedulingInfo = resourceData.SchedulingInfo;
+        return { schedulingInfo.ResourceFormat().ResourceProperties(), schedulingInfo.CanBeAliased ? schedulingInfo.HeapOffset : 0 };
+    }
+
+    bool PipelineResourceStorage::PooledResourceProperties::operator==(const PooledResourceProperties& other) const
+    {
+        return ResourceProperties == other.ResourceProperties && HeapOffset == other.HeapOffset;
+    }
+
+    void PipelineResourceStorage::UpdateGlobalRootConstants(const void* data, uint64_t sizeInBytes)
+    {
+        mGlobalRootConstantsAddress = mConstantBufferManager->Upload(mGlobalConstantsStream, data, sizeInBytes);
+    }
+
+    void PipelineResourceStorage::UpdateFrameRootConstants(const void* data, uint64_t sizeInBytes)
+    {
+        mPerFrameRootConstantsAddress = mConstantBufferManager->Upload(mPerFrameConstantsStream, data, sizeInBytes);
+    }
+
+    void PipelineResourceStorage::UpdatePassRootConstants(const void* data, uint64_t sizeInBytes, const RenderPassGraph::Node& passNode)
+    {
+        PipelineResourceStoragePass* passData = GetPerPassData(passNode.PassMetadata().Name);
+
+        // Every update gets its own memory, so draws and dispatches
+        // recorded earlier in the pass keep their version of the data
+        passData->PassConstantBufferAddress = mConstantBufferManager->Upload(passData->ConstantStream, data, sizeInBytes);
     }
 
     PipelineResourceStoragePass* PipelineResourceStorage::GetPerPassData(PassName name)
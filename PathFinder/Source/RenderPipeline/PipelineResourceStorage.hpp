@@ -13,16 +13,18 @@
 #include <Foundation/MemoryUtils.hpp>
 #include <Memory/GPUResourceProducer.hpp>
 #include <Memory/PoolDescriptorAllocator.hpp>
+#include <Memory/ConstantBufferManager.hpp>
 #include <Memory/ResourceStateTracker.hpp>
+#include <Memory/TransientResourcePool.hpp>
 
 #include <vector>
 #include <functional>
 #include <tuple>
 #include <memory>
 #include <optional>
+#include <array>
 
 #include <robinhood/robin_hood.h>
-#include <dtl/dtl.hpp>
 
 namespace PathFinder
 {
@@ -40,18 +42,20 @@ namespace PathFinder
             Memory::GPUResourceProducer* resourceProducer,
             Memory::PoolDescriptorAllocator* descriptorAllocator,
             Memory::ResourceStateTracker* stateTracker,
+            Memory::MemoryBudgetTracker* budgetTracker,
+            Memory::ConstantBufferManager* constantBufferManager,
+            uint64_t simultaneousFramesInFlight,
             const RenderSurfaceDescription& defaultRenderSurface,
             const RenderPassGraph* passExecutionGraph
         );
 
         using DebugBufferIteratorFunc = std::function<void(PassName passName, const float* debugData)>;
-        using SchedulingInfoConfigurator = std::function<void(PipelineResourceSchedulingInfo&)>;
 
-        const HAL::RTDescriptor* GetRenderTargetDescriptor(Foundation::Name resourceName, Foundation::Name passName, uint64_t mipIndex = 0) const;
-        const HAL::DSDescriptor* GetDepthStencilDescriptor(Foundation::Name resourceName, Foundation::Name passName) const;
+        const HAL::RTDescriptor* GetRenderTargetDescriptor(Foundation::Name resourceName, const RenderPassGraph::Node& passNode, uint64_t mipIndex = 0) const;
+        const HAL::DSDescriptor* GetDepthStencilDescriptor(Foundation::Name resourceName, const RenderPassGraph::Node& passNode) const;
         const HAL::SamplerDescriptor* GetSamplerDescriptor(Foundation::Name resourceName) const;
 
-        void BeginFrame();
+        void BeginFrame(uint64_t frameNumber);
         void EndFrame();
 
         bool HasMemoryLayoutChange() const;
@@ -72,8 +76,10 @@ namespace PathFinder
         template <class Constants>
         void UpdatePassRootConstants(const Constants& constants, const RenderPassGraph::Node& passNode);
 
-        const Memory::Buffer* GlobalRootConstantsBuffer() const;
-        const Memory::Buffer* PerFrameRootConstantsBuffer() const;
+        // Variable sized constants, up to 64 KB
+        void UpdateGlobalRootConstants(const void* data, uint64_t sizeInBytes);
+        void UpdateFrameRootConstants(const void* data, uint64_t sizeInBytes);
+        void UpdatePassRootConstants(const void* data, uint64_t sizeInBytes, const RenderPassGraph::Node& passNode);
 
         PipelineResourceStoragePass* GetPerPassData(PassName name);
         PipelineResourceStorageResource* GetPerResourceData(ResourceName name);
@@ -83,14 +89,13 @@ namespace PathFinder
         void IterateDebugBuffers(const DebugBufferIteratorFunc& func) const;
         void SetMemoryAliasingEnabled(bool enabled);
 
+        // Scheduling info of queued resources is available after EndResourceScheduling()
         void QueueResourceAllocationIfNeeded(
             ResourceName resourceName, 
             const HAL::ResourcePropertiesVariant& properties, 
-            std::optional<Foundation::Name> propertyCopySourceName,
-            const SchedulingInfoConfigurator& siConfigurator);
+            std::optional<Foundation::Name> propertyCopySourceName);
 
-        void QueueResourceUsage(ResourceName resourceName, std::optional<ResourceName> aliasName, const SchedulingInfoConfigurator& siConfigurator);
-        void QueueResourceReadback(ResourceName resourceName, const SchedulingInfoConfigurator& siConfigurator);
+        void QueueResourceAlias(ResourceName resourceName, ResourceName aliasName);
         void AddSampler(Foundation::Name samplerName, const HAL::Sampler& sampler);
 
     private:
@@ -99,36 +104,91 @@ namespace PathFinder
         using SamplerMap = robin_hood::unordered_flat_map<ResourceName, SamplerDescriptorPair>;
         using ResourceAliasMap = robin_hood::unordered_flat_map<ResourceName, ResourceName>;
         using ResourceList = std::vector<PipelineResourceStorageResource>;
-        using DiffEntryList = std::vector<PipelineResourceStorageResource::DiffEntry>;
 
-        struct ResourceCreationRequest
+        // Everything a pooled resource was created from.
+        // Heap offset is only meaningful for placed resources and is zero otherwise.
+        struct PooledResourceProperties
         {
             HAL::ResourcePropertiesVariant ResourceProperties;
-            Foundation::Name ResourceName;
-            Foundation::Name ResourceNameToCopyPropertiesFrom;
+            uint64_t HeapOffset = 0;
+
+            bool operator==(const PooledResourceProperties& other) const;
         };
 
-        struct SchedulingRequest
+        // Sizes of RT/DS, non RT/DS, buffer and universal heaps.
+        // Only heaps decide layout compatibility, since resources placed into them are pooled by their full properties.
+        using MemoryLayoutProperties = std::array<uint64_t, 4>;
+
+        using TexturePool = Memory::TransientResourcePool<Memory::GPUResourceProducer::TexturePtr, PooledResourceProperties>;
+        using BufferPool = Memory::TransientResourcePool<Memory::GPUResourceProducer::BufferPtr, PooledResourceProperties>;
+
+        // Heaps of aliased resources together with resources placed into them.
+        // Placed resources are only valid for the heaps they were created in,
+        // so the whole layout is pooled and reused as a unit.
+        struct TransientMemoryLayout
         {
-            SchedulingInfoConfigurator Configurator;
+            TransientMemoryLayout();
+
+            std::unique_ptr<HAL::Heap> RTDSHeap;
+            std::unique_ptr<HAL::Heap> NonRTDSHeap;
+            std::unique_ptr<HAL::Heap> BufferHeap;
+            std::unique_ptr<HAL::Heap> UniversalHeap;
+
+            // Declared after heaps to be destroyed before them
+            TexturePool PlacedTextures;
+            BufferPool PlacedBuffers;
+
+            uint64_t HeapBytes() const;
+        };
+
+        using MemoryLayoutPool = Memory::TransientResourcePool<std::unique_ptr<TransientMemoryLayout>, MemoryLayoutProperties>;
+
+        // Pooled resources unused for this many frames are destroyed
+        static const uint64_t PooledResourceLifetime = 300;
+
+        // Pool can hold this many times the memory current frame uses
+        static const uint64_t PooledBytesToUsedBytesRatio = 2;
+
+        struct ResourceCreationRequest
+        {
+            HAL::ResourcePropertiesVariant ResourceProperties;
             Foundation::Name ResourceName;
+            Foundation::Name ResourceNameToCopyPropertiesFrom;
         };
 
         PipelineResourceStorageResource& CreatePerResourceData(ResourceName name, const HAL::ResourceFormat& resourceFormat);
         HAL::Heap* GetHeapForAliasingGroup(HAL::HeapAliasingGroup group);
+        void ReportTransientMemory();
 
         bool TransferPreviousFrameResources();
+        void ReleasePreviousFrameResources();
+        void AcquireMemoryLayout();
+        void AcquireResource(PipelineResourceStorageResource& resourceData);
+        void UpdatePooledBytesLimits();
+
+        // Placed resources are interchangeable when they have same properties and heap offset
+        static uint64_t PlacementHash(const PipelineResourceStorageResource& resourceData);
+        static uint64_t PooledResourceHash(const PipelineResourceStorageResource& resourceData);
+        static PooledResourceProperties GetPooledResourceProperties(const PipelineResourceStorageResource& resourceData);
 
         HAL::Device* mDevice;
         Memory::GPUResourceProducer* mResourceProducer;
         Memory::PoolDescriptorAllocator* mDescriptorAllocator;
         Memory::ResourceStateTracker* mResourceStateTracker;
+        Memory::MemoryBudgetTracker* mBudgetTracker;
+        Memory::ConstantBufferManager* mConstantBufferManager;
         const RenderPassGraph* mPassExecutionGraph;
 
-        std::unique_ptr<HAL::Heap> mRTDSHeap;
-        std::unique_ptr<HAL::Heap> mNonRTDSHeap;
-        std::unique_ptr<HAL::Heap> mBufferHeap;
-        std::unique_ptr<HAL::Heap> mUniversalHeap;
+        // Aliased memory of current frame and its pool key
+        std::unique_ptr<TransientMemoryLayout> mMemoryLayout;
+        uint64_t mMemoryLayoutHash = 0;
+        MemoryLayoutProperties mMemoryLayoutProperties{};
+
+        // Resources and layouts of previous schedules kept around for when pipeline returns to them,
+        // which makes switching between resolutions or settings back and forth cheap
+        MemoryLayoutPool mMemoryLayoutPool;
+        TexturePool mTexturePool;
+        BufferPool mBufferPool;
 
         RenderSurfaceDescription mDefaultRenderSurface;
 
@@ -137,17 +197,16 @@ namespace PathFinder
         PipelineResourceMemoryAliaser mBufferMemoryAliaser;
         PipelineResourceMemoryAliaser mUniversalMemoryAliaser;
 
-        // Constant buffer for global data that changes rarely
-        Memory::GPUResourceProducer::BufferPtr mGlobalRootConstantsBuffer;
+        // Constants for global data that changes rarely
+        Memory::ConstantBufferManager::StreamID mGlobalConstantsStream = 0;
+        HAL::GPUAddress mGlobalRootConstantsAddress = 0;
 
-        // Constant buffer for data that changes every frame
-        Memory::GPUResourceProducer::BufferPtr mPerFrameRootConstantsBuffer;
+        // Constants for data that changes every frame
+        Memory::ConstantBufferManager::StreamID mPerFrameConstantsStream = 0;
+        HAL::GPUAddress mPerFrameRootConstantsAddress = 0;
 
         robin_hood::unordered_node_map<PassName, PipelineResourceStoragePass> mPerPassData;
 
-        std::vector<SchedulingRequest> mSchedulingCreationRequests;
-        std::vector<SchedulingRequest> mSchedulingUsageRequests;
-        std::vector<SchedulingRequest> mSchedulingReadbackRequests;
         std::vector<ResourceCreationRequest> mPrimaryResourceCreationRequests;
         std::vector<ResourceCreationRequest> mSecondaryResourceCreationRequests;
 
@@ -159,18 +218,22 @@ namespace PathFinder
         ResourceMap* mPreviousFrameResourceMap = &mResourceMaps.first;
         ResourceMap* mCurrentFrameResourceMap = &mResourceMaps.second;
         ResourceAliasMap mAliasMap;
+        std::vector<ResourceName> mAliasChain;
         SamplerMap mSamplers;
 
-        // Resource diff entries to determine resource allocation needs
-        std::pair<DiffEntryList, DiffEntryList> mDiffEntries;
-        DiffEntryList* mPreviousFrameDiffEntries = &mDiffEntries.first;
-        DiffEntryList* mCurrentFrameDiffEntries = &mDiffEntries.second;
-
         // Transitions for resources scheduled for readback
         HAL::ResourceBarrierCollection mReadbackBarriers;
 
         bool mMemoryLayoutChanged = false;
+        bool mPooledMemoryEvicted = false;
         bool mIsMemoryAliasingEnabled = true;
+
+    public:
+        inline const auto& MemoryLayoutPoolStatistics() const { return mMemoryLayoutPool.GetStatistics(); }
+        inline const auto& TexturePoolStatistics() const { return mTexturePool.GetStatistics(); }
+        inline const auto& BufferPoolStatistics() const { return mBufferPool.GetStatistics(); }
+        inline HAL::GPUAddress GlobalRootConstantsAddress() const { return mGlobalRootConstantsAddress; }
+        inline HAL::GPUAddress PerFrameRootConstantsAddress() const { return mPerFrameRootConstantsAddress; }
     };
 
 }
@@ -2,6 +2,7 @@
 
 #include <Foundation/Name.hpp>
 #include <Memory/GPUResourceProducer.hpp>
+#include <Memory/ConstantBufferManager.hpp>
 
 #include "PipelineResourceStorageResource.hpp"
 
@@ -12,22 +13,12 @@ namespace PathFinder
 
     struct PipelineResourceStoragePass
     {
-        // Constant buffers for each pass that require it.
-        Memory::GPUResourceProducer::BufferPtr PassConstantBuffer;
+        // Upload memory of the last pass constants update in current frame, 0 if pass has no constants.
+        // Each update is placed in separate memory as a versioning mechanism for multiple draws/dispatches in one render pass.
+        HAL::GPUAddress PassConstantBufferAddress = 0;
 
-        std::vector<uint8_t> PassConstantData;
-
-        // Memory offset for pass constant buffer in current frame.
-        // Used to place pass data in different memory locations
-        // as a versioning mechanism for multiple draws/dispatches in one render pass.
-        uint64_t PassConstantBufferMemoryOffset = 0;
-
-        // Size of data last uploaded to pass constant buffer. Used to offset 
-        // the constant buffer after a draw/dispatch.
-        uint64_t LastSetConstantBufferDataSize = 0;
-
-        // 
-        bool IsAllowedToAdvanceConstantBufferOffset = false;
+        // Pass constants of consecutive frames are compared to skip repeated uploads
+        Memory::ConstantBufferManager::StreamID ConstantStream = 0;
 
         // Debug buffer for each pass.
         Memory::GPUResourceProducer::BufferPtr PassDebugBuffer;
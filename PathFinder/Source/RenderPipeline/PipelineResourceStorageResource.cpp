@@ -3,12 +3,13 @@
 #include <Foundation/StringUtils.hpp>
 
 #include <Foundation/STDHelpers.hpp>
+#include <Foundation/HashUtils.hpp>
 
 namespace PathFinder
 {
 
-    PipelineResourceStorageResource::PipelineResourceStorageResource(Foundation::Name resourceName, const HAL::ResourceFormat& format)
-        : mResourceName{ resourceName }, SchedulingInfo{ resourceName, format } {}
+    PipelineResourceStorageResource::PipelineResourceStorageResource(Foundation::Name resourceName, const HAL::ResourceFormat& format, uint64_t passCount)
+        : mResourceName{ resourceName }, SchedulingInfo{ resourceName, format, passCount } {}
 
     const Memory::GPUResource* PipelineResourceStorageResource::GetGPUResource() const
     {
@@ -24,36 +25,78 @@ namespace PathFinder
         else return nullptr;
     }
 
-    PipelineResourceStorageResource::DiffEntry PipelineResourceStorageResource::GetDiffEntry() const
+    uint64_t PipelineResourceStorageResource::PropertiesHash() const
     {
-        return { 
-            mResourceName, 
-            SchedulingInfo.CanBeAliased, 
-            SchedulingInfo.ExpectedStates(), 
-            SchedulingInfo.TotalRequiredMemory(), 
-            SchedulingInfo.AliasingLifetime.first, 
-            SchedulingInfo.AliasingLifetime.second 
-        };
+        using namespace Foundation::HashUtils;
+
+        const HAL::ResourceFormat& format = SchedulingInfo.ResourceFormat();
+        const D3D12_RESOURCE_DESC& description = format.D3DResourceDescription();
+
+        // Description already reflects dimensions, mips, format and usage flags derived from expected states
+        uint64_t hash = Mix(description.Dimension);
+        hash = Combine(hash, description.Alignment);
+        hash = Combine(hash, description.Width);
+        hash = Combine(hash, description.Height);
+        hash = Combine(hash, description.DepthOrArraySize);
+        hash = Combine(hash, description.MipLevels);
+        hash = Combine(hash, description.Format);
+        hash = Combine(hash, description.SampleDesc.Count);
+        hash = Combine(hash, description.SampleDesc.Quality);
+        hash = Combine(hash, description.Layout);
+        hash = Combine(hash, description.Flags);
+        hash = Combine(hash, uint64_t(format.ResourceAliasingGroup()));
+
+        std::visit(Foundation::MakeVisitor(
+            [&hash](const HAL::TextureProperties& properties)
+            {
+                // Typed and typeless formats produce different views
+                hash = Combine(hash, properties.Format.index());
+                hash = Combine(hash, uint64_t(properties.InitialStateMask));
+                hash = Combine(hash, uint64_t(properties.ExpectedStateMask));
+
+                std::visit(Foundation::MakeVisitor(
+                    [&hash](const HAL::ColorClearValue& color)
+                    {
+                        hash = Combine(hash, std::hash<float>{}(color.r));
+                        hash = Combine(hash, std::hash<float>{}(color.g));
+                        hash = Combine(hash, std::hash<float>{}(color.b));
+                        hash = Combine(hash, std::hash<float>{}(color.a));
+                    },
+                    [&hash](const HAL::DepthStencilClearValue& depthStencil)
+                    {
+                        hash = Combine(hash, std::hash<float>{}(depthStencil.Depth));
+                        hash = Combine(hash, depthStencil.Stencil);
+                    }),
+                    properties.OptimizedClearValue);
+            },
+            [&hash](const HAL::BufferProperties& properties)
+            {
+                hash = Combine(hash, properties.Stride);
+                hash = Combine(hash, uint64_t(properties.InitialStateMask));
+                hash = Combine(hash, uint64_t(properties.ExpectedStateMask));
+            }),
+            format.ResourceProperties());
+
+        return hash;
     }
 
-    bool PipelineResourceStorageResource::DiffEntry::operator==(const DiffEntry& that) const
+    uint64_t PipelineResourceStorageResource::SchedulingHash() const
     {
-        // Pipeline Resource is identified by its name, memory footprint and lifetime,
-        // which is sufficient to understand when
-        // resource allocation, reallocation or deallocation is required.
-        bool equal = 
-            ResourceName == that.ResourceName &&
-            MemoryFootprint == that.MemoryFootprint &&
-            CanBeAliased == that.CanBeAliased &&
-            ExpectedStates == that.ExpectedStates;
-
-        // Compare timelines only if resource can be aliased
-        if (CanBeAliased)
+        using namespace Foundation::HashUtils;
+
+        uint64_t hash = Combine(PropertiesHash(), std::hash<Foundation::Name>{}(mResourceName));
+        hash = Combine(hash, SchedulingInfo.CanBeAliased);
+        hash = Combine(hash, uint64_t(SchedulingInfo.ExpectedStates()));
+        hash = Combine(hash, SchedulingInfo.TotalRequiredMemory());
+
+        // Lifetimes only matter when resource shares memory with others
+        if (SchedulingInfo.CanBeAliased)
         {
-            equal = equal && LifetimeStart == that.LifetimeStart && LifetimeEnd == that.LifetimeEnd;
+            hash = Combine(hash, SchedulingInfo.AliasingLifetime.first);
+            hash = Combine(hash, SchedulingInfo.AliasingLifetime.second);
         }
 
-        return equal;
+        return hash;
     }
 
 }
@@ -12,29 +12,7 @@ namespace PathFinder
     struct PipelineResourceStorageResource
     {
     public:
-        struct DiffEntry
-        {
-        public:
-            bool operator==(const DiffEntry& that) const;
-
-            // Compare by name to detect new or deleted resources
-            Foundation::Name ResourceName;
-
-            // Compare by aliasing capability 
-            bool CanBeAliased = true;
-
-            // Compare by resource states because new state combination will require reallocation
-            HAL::ResourceState ExpectedStates = HAL::ResourceState::Common;
-
-            // Compare by total occupied memory
-            uint64_t MemoryFootprint = 0;
-
-            // Compare by lifetimes when aliasing is possible 
-            uint64_t LifetimeStart = 0;
-            uint64_t LifetimeEnd = 0;
-        };
-
-        PipelineResourceStorageResource(Foundation::Name resourceName, const HAL::ResourceFormat& format);
+        PipelineResourceStorageResource(Foundation::Name resourceName, const HAL::ResourceFormat& format, uint64_t passCount);
 
         PipelineResourceSchedulingInfo SchedulingInfo;
         Memory::GPUResourceProducer::TexturePtr Texture;
@@ -43,7 +21,13 @@ namespace PathFinder
         const Memory::GPUResource* GetGPUResource() const;
         Memory::GPUResource* GetGPUResource();
 
-        DiffEntry GetDiffEntry() const;
+        // Identifies resources that can be substituted for one another:
+        // same D3D description, clear value and state masks
+        uint64_t PropertiesHash() const;
+
+        // Changes whenever resource needs to be reallocated or aliased memory layout is invalidated:
+        // resource properties, name, aliasing capability and, for aliased resources, lifetime
+        uint64_t SchedulingHash() const;
 
     private:
         Foundation::Name mResourceName;
@@ -0,0 +1,283 @@
+#include "PipelineStateCache.hpp"
+
+#include <bitsery/bitsery.h>
+#include <bitsery/adapter/buffer.h>
+#include <bitsery/traits/vector.h>
+
+#include <fstream>
+#include <algorithm>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        const uint32_t CacheFileMagic = 0x43535046; // FPSC
+        const uint32_t CacheFileFormatVersion = 1;
+        const uint64_t MaxCacheEntryCount = 1 << 20;
+        const uint64_t MaxCacheBlobSize = 1 << 30;
+
+        struct CacheFileHeader
+        {
+            uint32_t Magic = CacheFileMagic;
+            uint32_t FormatVersion = CacheFileFormatVersion;
+            uint64_t DeviceFingerprint = 0;
+
+            template <typename S>
+            void serialize(S& s)
+            {
+                s.value4b(Magic);
+                s.value4b(FormatVersion);
+                s.value8b(DeviceFingerprint);
+            }
+        };
+
+        struct CacheFileEntry
+        {
+            uint64_t Key = 0;
+            uint64_t BlobHash = 0;
+            std::vector<uint8_t> Blob;
+
+            template <typename S>
+            void serialize(S& s)
+            {
+                s.value8b(Key);
+                s.value8b(BlobHash);
+                s.container1b(Blob, MaxCacheBlobSize);
+            }
+        };
+
+        struct CacheFile
+        {
+            CacheFileHeader Header;
+            std::vector<CacheFileEntry> Entries;
+
+            template <typename S>
+            void serialize(S& s)
+            {
+                s.object(Header);
+                s.container(Entries, MaxCacheEntryCount);
+            }
+        };
+
+        using Buffer = std::vector<uint8_t>;
+        using Writer = bitsery::OutputBufferAdapter<Buffer>;
+        using Reader = bitsery::InputBufferAdapter<Buffer>;
+    }
+
+    PipelineStateCache::PipelineStateCache(uint64_t deviceFingerprint)
+        : mDeviceFingerprint{ deviceFingerprint } {}
+
+    uint64_t PipelineStateCache::Hash(ByteSpan bytes)
+    {
+        // 64-bit FNV-1a. Hashes are persisted, so the function must
+        // not depend on platform, compiler or third-party library versions.
+        uint64_t hash = 0xcbf29ce484222325;
+
+        for (uint64_t i = 0; i < bytes.Size; ++i)
+        {
+            hash ^= bytes.Data[i];
+            hash *= 0x100000001b3;
+        }
+
+        return hash;
+    }
+
+    uint64_t PipelineStateCache::CombineHashes(uint64_t seed, uint64_t hash)
+    {
+        return seed ^ (hash + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+    }
+
+    PipelineStateCache::Key PipelineStateCache::ComputeKey(ByteSpan serializedDescription, const std::vector<ByteSpan>& shaderBinaries)
+    {
+        Key key = Hash(serializedDescription);
+
+        // Shader order matters: same binaries bound to different stages produce different states
+        for (const ByteSpan& binary : shaderBinaries)
+        {
+            key = CombineHashes(key, Hash(binary));
+        }
+
+        return key;
+    }
+
+    std::optional<PipelineStateCache::ByteSpan> PipelineStateCache::Find(Key key) const
+    {
+        auto it = mEntries.find(key);
+        if (it == mEntries.end()) return std::nullopt;
+        return ByteSpan{ it->second.Blob.data(), it->second.Blob.size() };
+    }
+
+    void PipelineStateCache::Store(Key key, std::vector<uint8_t>&& blob)
+    {
+        Entry& entry = mEntries[key];
+        entry.Blob = std::move(blob);
+        entry.IsUsed = true;
+        mIsDirty = true;
+    }
+
+    void PipelineStateCache::MarkAsUsed(Key key)
+    {
+        // Entries that were loaded but never used are dropped on next save
+        auto it = mEntries.find(key);
+        if (it != mEntries.end()) it->second.IsUsed = true;
+    }
+
+    void PipelineStateCache::Clear()
+    {
+        mEntries.clear();
+        mIsDirty = true;
+    }
+
+    std::vector<uint8_t> PipelineStateCache::Serialize() const
+    {
+        CacheFile file{};
+        file.Header.DeviceFingerprint = mDeviceFingerprint;
+
+        for (const auto& [key, entry] : mEntries)
+        {
+            if (!entry.IsUsed)
+            {
+                continue;
+            }
+
+            CacheFileEntry& fileEntry = file.Entries.emplace_back();
+            fileEntry.Key = key;
+            fileEntry.BlobHash = Hash({ entry.Blob.data(), entry.Blob.size() });
+            fileEntry.Blob = entry.Blob;
+        }
+
+        // Deterministic output for identical caches
+        std::sort(file.Entries.begin(), file.Entries.end(), [](const CacheFileEntry& a, const CacheFileEntry& b) { return a.Key < b.Key; });
+
+        Buffer buffer{};
+        size_t writtenSize = bitsery::quickSerialization(Writer{ buffer }, file);
+        buffer.resize(writtenSize);
+
+        return buffer;
+    }
+
+    PipelineStateCache::LoadResult PipelineStateCache::Deserialize(const std::vector<uint8_t>& data)
+    {
+        mEntries.clear();
+        mIsDirty = false;
+
+        // Validate header before touching the rest, which layout may have changed between versions
+        CacheFileHeader header{};
+        auto [headerError, headerCompleted] = bitsery::quickDeserialization(Reader{ data.begin(), data.size() }, header);
+
+        if (headerError != bitsery::ReaderError::NoError || header.Magic != CacheFileMagic)
+        {
+            return LoadResult::Corrupted;
+        }
+
+        if (header.FormatVersion != CacheFileFormatVersion)
+        {
+            return LoadResult::FormatMismatch;
+        }
+
+        // Blobs are only valid for a driver that produced them
+        if (header.DeviceFingerprint != mDeviceFingerprint)
+        {
+            return LoadResult::DeviceMismatch;
+        }
+
+        CacheFile file{};
+        auto [error, completed] = bitsery::quickDeserialization(Reader{ data.begin(), data.size() }, file);
+
+        if (error != bitsery::ReaderError::NoError || !completed)
+        {
+            return LoadResult::Corrupted;
+        }
+
+        for (CacheFileEntry& fileEntry : file.Entries)
+        {
+            if (Hash({ fileEntry.Blob.data(), fileEntry.Blob.size() }) != fileEntry.BlobHash)
+            {
+                mEntries.clear();
+                return LoadResult::Corrupted;
+            }
+
+            mEntries[fileEntry.Key].Blob = std::move(fileEntry.Blob);
+        }
+
+        return LoadResult::Loaded;
+    }
+
+    PipelineStateCache::LoadResult PipelineStateCache::LoadFromFile(const std::filesystem::path& path)
+    {
+        std::ifstream file{ path, std::ios::in | std::ios::binary };
+
+        if (!file)
+        {
+            mEntries.clear();
+            return LoadResult::FileMissing;
+        }
+
+        std::vector<uint8_t> data{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+        LoadResult result = Deserialize(data);
+
+        // Rewrite incompatible file as soon as new blobs are available
+        if (result != LoadResult::Loaded)
+        {
+            mIsDirty = true;
+        }
+
+        return result;
+    }
+
+    bool PipelineStateCache::SaveToFile(const std::filesystem::path& path)
+    {
+        std::vector<uint8_t> data = Serialize();
+
+        std::filesystem::path directory = path;
+        directory.remove_filename();
+
+        // Saving happens during state compilation, so nothing here is allowed to throw.
+        // Failure surfaces when the file is opened.
+        if (!directory.empty())
+        {
+            std::error_code error;
+            std::filesystem::create_directories(directory, error);
+        }
+
+        // Write next to the target and swap afterwards, so an interrupted
+        // or short write never leaves a truncated cache behind
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+
+        {
+            std::ofstream file{ temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc };
+
+            if (!file)
+            {
+                return false;
+            }
+
+            file.write((const char*)data.data(), data.size());
+            file.close();
+
+            if (!file)
+            {
+                std::error_code error;
+                std::filesystem::remove(temporaryPath, error);
+                return false;
+            }
+        }
+
+        std::error_code renameError;
+        std::filesystem::rename(temporaryPath, path, renameError);
+
+        if (renameError)
+        {
+            std::filesystem::remove(temporaryPath, renameError);
+            return false;
+        }
+
+        // Cache stays dirty on failure, so saving is retried after the next compilation batch
+        mIsDirty = false;
+
+        return true;
+    }
+
+}
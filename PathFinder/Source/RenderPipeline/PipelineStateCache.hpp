@@ -0,0 +1,70 @@
+#pragma once
+
+#include <robinhood/robin_hood.h>
+
+#include <vector>
+#include <optional>
+#include <filesystem>
+#include <cstdint>
+
+namespace PathFinder
+{
+    // Persistent storage of driver-compiled pipeline state blobs.
+    // Entries are keyed by a hash of serialized pipeline description and hashes of all shader binaries,
+    // so any change to either one results in a miss instead of an outdated blob.
+    // Whole cache is discarded when it was produced by a different device/driver or a different file format.
+
+    class PipelineStateCache
+    {
+    public:
+        using Key = uint64_t;
+
+        struct ByteSpan
+        {
+            const uint8_t* Data = nullptr;
+            uint64_t Size = 0;
+        };
+
+        enum class LoadResult
+        {
+            Loaded, FileMissing, Corrupted, FormatMismatch, DeviceMismatch
+        };
+
+        PipelineStateCache(uint64_t deviceFingerprint);
+
+        static uint64_t Hash(ByteSpan bytes);
+        static uint64_t CombineHashes(uint64_t seed, uint64_t hash);
+        static Key ComputeKey(ByteSpan serializedDescription, const std::vector<ByteSpan>& shaderBinaries);
+
+        // Thread safe as long as there are no concurrent modifications
+        std::optional<ByteSpan> Find(Key key) const;
+
+        void Store(Key key, std::vector<uint8_t>&& blob);
+        void MarkAsUsed(Key key);
+        void Clear();
+
+        // Only entries that were used or stored since loading are serialized, which prunes stale ones
+        std::vector<uint8_t> Serialize() const;
+        LoadResult Deserialize(const std::vector<uint8_t>& data);
+
+        LoadResult LoadFromFile(const std::filesystem::path& path);
+        bool SaveToFile(const std::filesystem::path& path);
+
+    private:
+        struct Entry
+        {
+            std::vector<uint8_t> Blob;
+            bool IsUsed = false;
+        };
+
+        uint64_t mDeviceFingerprint = 0;
+        robin_hood::unordered_node_map<Key, Entry> mEntries;
+        bool mIsDirty = false;
+
+    public:
+        inline auto EntryCount() const { return mEntries.size(); }
+        inline auto DeviceFingerprint() const { return mDeviceFingerprint; }
+        inline bool IsDirty() const { return mIsDirty; }
+    };
+
+}
@@ -1,5 +1,7 @@
 #include "PipelineStateManager.hpp"
 
+#include <Foundation/StringUtils.hpp>
+
 
 
 namespace PathFinder
@@ -9,12 +11,16 @@ namespace PathFinder
         HAL::Device* device,
         ShaderManager* shaderManager, 
         Memory::GPUResourceProducer* resourceProducer,
+        Foundation::JobSystem* jobSystem,
+        uint8_t simultaneousFramesInFlight,
         const RenderSurfaceDescription& defaultRenderSurface)
         : 
         mDevice{ device }, 
         mShaderManager{ shaderManager },
         mResourceProducer{ resourceProducer },
+        mJobSystem{ jobSystem },
         mDefaultRenderSurfaceDesc{ defaultRenderSurface }, 
+        mSimultaneousFramesInFlight{ simultaneousFramesInFlight },
         mBaseRootSignature{ device },
         mDefaultGraphicsState{ device }
     {
@@ -27,6 +33,20 @@ namespace PathFinder
         mShaderManager->LibraryRecompilationEvent() += { "library.recompilation", this, &PipelineStateManager::RecompileStatesWithNewLibrary };
     }
 
+    void PipelineStateManager::BeginFrame(uint64_t frameNumber)
+    {
+        mFrameNumber = frameNumber;
+    }
+
+    void PipelineStateManager::EnablePipelineStateCache(const std::filesystem::path& cacheFilePath, uint64_t deviceFingerprint)
+    {
+        mStateCache = std::make_unique<PipelineStateCache>(deviceFingerprint);
+        mStateCacheFilePath = cacheFilePath;
+
+        // Any failure just means states are compiled from scratch and the file is rewritten
+        mStateCache->LoadFromFile(cacheFilePath);
+    }
+
     void PipelineStateManager::CreateRootSignature(RootSignatureName name, const RootSignatureConfigurator& configurator)
     {
         assert_format(GetRootSignature(name) == nullptr, "Redefinition of Root Signature. ", name.ToString(), " already exists.");
@@ -266,29 +286,155 @@ namespace PathFinder
 
     void PipelineStateManager::CompileUncompiledSignaturesAndStates()
     {
-        for (HAL::RootSignature* signature : mSignaturesToCompile)
+        if (mSignaturesToCompile.empty() && mStatesToCompile.empty())
         {
-            signature->Compile();
+            return;
         }
 
-        for (PipelineStateVariantInternal* state : mStatesToCompile)
+        using namespace std::chrono;
+
+        auto batchStartTimestamp = steady_clock::now();
+
+        mLastCompilationStatistics = {};
+        mLastCompilationStatistics.CompiledSignatureCount = mSignaturesToCompile.size();
+
+        // States reference signatures, so signatures go first
+        CompileSignatures();
+
+        std::vector<StateCompilationResult> results;
+        results.reserve(mStatesToCompile.size());
+
+        for (auto& [name, state] : mPipelineStates)
         {
-            if (auto pso = std::get_if<HAL::GraphicsPipelineState>(state))
-            {
-                pso->Compile();
-            }
-            else if (auto pso = std::get_if<HAL::ComputePipelineState>(state))
+            if (mStatesToCompile.count(&state) > 0)
             {
-                pso->Compile();
+                StateCompilationResult& result = results.emplace_back();
+                result.Name = name;
+                result.State = &state;
             }
-            else if (auto psoWrapper = std::get_if<RayTracingStateWrapper>(state))
+        }
+
+        // Each task only touches its own state and result, cache is read-only at this point
+        Foundation::TaskGraph compilationGraph;
+
+        for (StateCompilationResult& result : results)
+        {
+            compilationGraph.AddTask(result.Name.ToString(), [this, &result] { CompileState(result); });
+        }
+
+        mJobSystem->Execute(compilationGraph);
+
+        // Resource producer and cache are not thread safe, finish serially
+        for (StateCompilationResult& result : results)
+        {
+            if (auto psoWrapper = std::get_if<RayTracingStateWrapper>(result.State))
             {
-                CompileRayTracingState(*psoWrapper);
+                UploadShaderTable(*psoWrapper);
             }
+
+            UpdatePipelineStateCache(result);
+
+            mCompilationInfos[result.Name] = result.Info;
+            mLastCompilationStatistics.AccumulatedDuration += result.Info.Duration;
+            mLastCompilationStatistics.CacheHitCount += result.Info.IsLoadedFromCache ? 1 : 0;
+        }
+
+        mLastCompilationStatistics.CompiledStateCount = results.size();
+
+        // Compiled states are valid either way, failure only means they are compiled from scratch next launch
+        if (mStateCache && mStateCache->IsDirty() && !mStateCache->SaveToFile(mStateCacheFilePath))
+        {
+            OutputDebugStringA(StringFormat("Failed to write pipeline state cache '%s'\n", mStateCacheFilePath.string().c_str()).c_str());
         }
 
         mSignaturesToCompile.clear();
         mStatesToCompile.clear();
+
+        mLastCompilationStatistics.WallDuration = duration_cast<microseconds>(steady_clock::now() - batchStartTimestamp);
+    }
+
+    void PipelineStateManager::CompileSignatures()
+    {
+        Foundation::TaskGraph compilationGraph;
+
+        for (HAL::RootSignature* signature : mSignaturesToCompile)
+        {
+            compilationGraph.AddTask("Compile Root Signature", [signature] { signature->Compile(); });
+        }
+
+        mJobSystem->Execute(compilationGraph);
+    }
+
+    void PipelineStateManager::CompileState(StateCompilationResult& result) const
+    {
+        auto startTimestamp = std::chrono::steady_clock::now();
+
+        if (auto pso = std::get_if<HAL::GraphicsPipelineState>(result.State))
+        {
+            CompileCacheableState(*pso, result);
+        }
+        else if (auto pso = std::get_if<HAL::ComputePipelineState>(result.State))
+        {
+            CompileCacheableState(*pso, result);
+        }
+        else if (auto psoWrapper = std::get_if<RayTracingStateWrapper>(result.State))
+        {
+            // State objects have no cached blob support
+            psoWrapper->State.Compile();
+        }
+
+        result.Info.Duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimestamp);
+    }
+
+    void PipelineStateManager::CompileCacheableState(HAL::PipelineState& state, StateCompilationResult& result) const
+    {
+        if (!mStateCache)
+        {
+            state.Compile();
+            return;
+        }
+
+        std::vector<uint8_t> description = state.SerializeDescription();
+        std::vector<PipelineStateCache::ByteSpan> shaderBinaries;
+
+        for (const D3D12_SHADER_BYTECODE& bytecode : state.ShaderBinaries())
+        {
+            shaderBinaries.push_back({ static_cast<const uint8_t*>(bytecode.pShaderBytecode), bytecode.BytecodeLength });
+        }
+
+        result.CacheKey = PipelineStateCache::ComputeKey({ description.data(), description.size() }, shaderBinaries);
+
+        if (std::optional<PipelineStateCache::ByteSpan> blob = mStateCache->Find(*result.CacheKey))
+        {
+            state.SetCachedBlob(blob->Data, blob->Size);
+        }
+
+        state.Compile();
+
+        result.Info.IsLoadedFromCache = state.IsCompiledFromCachedBlob();
+
+        // Either there was no blob or driver rejected it
+        if (!result.Info.IsLoadedFromCache)
+        {
+            result.NewCachedBlob = state.CachedBlob();
+        }
+    }
+
+    void PipelineStateManager::UpdatePipelineStateCache(StateCompilationResult& result)
+    {
+        if (!mStateCache || !result.CacheKey)
+        {
+            return;
+        }
+
+        if (result.NewCachedBlob)
+        {
+            mStateCache->Store(*result.CacheKey, std::move(*result.NewCachedBlob));
+        }
+        else
+        {
+            mStateCache->MarkAsUsed(*result.CacheKey);
+        }
     }
 
     void PipelineStateManager::AssociateStateWithShader(PipelineStateVariantInternal* state, const HAL::Shader* shader)
@@ -391,15 +537,83 @@ namespace PathFinder
         signature.AddDescriptorParameter(debugBuffer);
     }
 
-    void PipelineStateManager::CompileRayTracingState(RayTracingStateWrapper& stateWrapper)
+    void PipelineStateManager::UploadShaderTable(RayTracingStateWrapper& stateWrapper)
     {
-        stateWrapper.State.Compile();
         HAL::ShaderTable& shaderTable = stateWrapper.State.GetShaderTable();
-        HAL::BufferProperties properties{ shaderTable.GetMemoryRequirements().TableSizeInBytes };
-        stateWrapper.ShaderTableBuffer = mResourceProducer->NewBuffer(properties);
-        stateWrapper.ShaderTableBuffer->RequestWrite();
-        stateWrapper.BaseRayDispatchInfo = shaderTable.UploadToGPUMemory(stateWrapper.ShaderTableBuffer->WriteOnlyPtr(), stateWrapper.ShaderTableBuffer->HALBuffer());
-        stateWrapper.ShaderTableBuffer->SetDebugName(StringFormat("%s Shader Table", stateWrapper.Name.ToString().c_str()));
+        std::vector<HAL::ShaderTableBuilder::Patch> patches = shaderTable.ConsumePatches();
+        uint64_t tableSize = shaderTable.GetMemoryRequirements().TableSizeInBytes;
+        auto& copies = stateWrapper.ShaderTableCopies;
+
+        // Reuse table memory while its size is unchanged and upload only modified records.
+        // Layout may still differ, so dispatch info is always regenerated.
+        if (!copies.empty() && copies.front().Buffer->Properties().Size == tableSize)
+        {
+            if (!patches.empty())
+            {
+                for (ShaderTableCopy& copy : copies)
+                {
+                    copy.MissedPatches.insert(copy.MissedPatches.end(), patches.begin(), patches.end());
+                }
+
+                // Copies are switched at most once per frame, so the next copy in the ring 
+                // was last used by a frame that has already completed on GPU
+                if (stateWrapper.ShaderTableCopySwitchFrameNumber != mFrameNumber)
+                {
+                    stateWrapper.CurrentShaderTableCopyIndex = (stateWrapper.CurrentShaderTableCopyIndex + 1) % copies.size();
+                    stateWrapper.ShaderTableCopySwitchFrameNumber = mFrameNumber;
+                }
+
+                ShaderTableCopy& copy = copies[stateWrapper.CurrentShaderTableCopyIndex];
+
+                for (const HAL::ShaderTableBuilder::Patch& patch : copy.MissedPatches)
+                {
+                    copy.Buffer->RequestRegionWrite(patch.Offset, patch.Size);
+                }
+
+                shaderTable.UploadPatchesToGPUMemory(copy.Buffer->WriteOnlyPtr(), copy.MissedPatches);
+                copy.MissedPatches.clear();
+            }
+        }
+        else
+        {
+            // Memory of previous copies is released by the allocator once frames in flight complete
+            copies.clear();
+            copies.resize(mSimultaneousFramesInFlight);
+
+            HAL::BufferProperties properties{ tableSize };
+
+            for (auto copyIdx = 0u; copyIdx < copies.size(); ++copyIdx)
+            {
+                Memory::GPUResourceProducer::BufferPtr& buffer = copies[copyIdx].Buffer;
+                buffer = mResourceProducer->NewBuffer(properties);
+                buffer->RequestWrite();
+                shaderTable.UploadToGPUMemory(buffer->WriteOnlyPtr());
+                buffer->SetDebugName(StringFormat("%s Shader Table [%d]", stateWrapper.Name.ToString().c_str(), copyIdx));
+            }
+
+            stateWrapper.CurrentShaderTableCopyIndex = 0;
+            stateWrapper.ShaderTableCopySwitchFrameNumber = mFrameNumber;
+        }
+
+        const Memory::Buffer& currentCopy = *copies[stateWrapper.CurrentShaderTableCopyIndex].Buffer;
+        stateWrapper.BaseRayDispatchInfo = shaderTable.GetDispatchInfo(currentCopy.HALBuffer());
+    }
+
+    void PipelineStateManager::SetHitGroupLocalRootArguments(PSOName name, uint64_t hitGroupIndex, const void* arguments, uint64_t size)
+    {
+        auto it = mPipelineStates.find(name);
+        assert_format(it != mPipelineStates.end(), "Pipeline state does not exist");
+
+        RayTracingStateWrapper* stateWrapper = std::get_if<RayTracingStateWrapper>(&it->second);
+        assert_format(stateWrapper, "Local root arguments can only be set for ray tracing states");
+
+        stateWrapper->State.GetShaderTable().SetHitGroupLocalRootArguments(hitGroupIndex, arguments, size);
+
+        // Table of a state waiting for compilation will be uploaded along with compilation results
+        if (!stateWrapper->ShaderTableCopies.empty() && mStatesToCompile.find(&it->second) == mStatesToCompile.end())
+        {
+            UploadShaderTable(*stateWrapper);
+        }
     }
 
     void PipelineStateManager::RecompileStatesWithNewShader(const HAL::Shader* oldShader, const HAL::Shader* newShader)
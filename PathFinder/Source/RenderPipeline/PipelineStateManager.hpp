@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Name.hpp>
+#include <Foundation/JobSystem.hpp>
 #include <HardwareAbstractionLayer/PipelineState.hpp>
 #include <Memory/GPUResourceProducer.hpp>
 
@@ -10,8 +11,10 @@
 #include "RenderSurfaceDescription.hpp"
 #include "PipelineStateProxy.hpp"
 #include "RootSignatureProxy.hpp"
+#include "PipelineStateCache.hpp"
 
 #include <unordered_map>
+#include <chrono>
 
 namespace PathFinder
 {
@@ -39,18 +42,46 @@ namespace PathFinder
             const HAL::RayDispatchInfo* BaseRayDispatchInfo = nullptr;
         };
 
+        struct StateCompilationInfo
+        {
+            std::chrono::microseconds Duration = std::chrono::microseconds::zero();
+            bool IsLoadedFromCache = false;
+        };
+
+        struct CompilationStatistics
+        {
+            uint64_t CompiledSignatureCount = 0;
+            uint64_t CompiledStateCount = 0;
+            uint64_t CacheHitCount = 0;
+
+            // Wall time of the whole batch and sum of individual compilation times.
+            // Their ratio shows how much parallel compilation actually helps.
+            std::chrono::microseconds WallDuration = std::chrono::microseconds::zero();
+            std::chrono::microseconds AccumulatedDuration = std::chrono::microseconds::zero();
+        };
+
         PipelineStateManager(
             HAL::Device* device,
             ShaderManager* shaderManager,
             Memory::GPUResourceProducer* resourceProducer, 
+            Foundation::JobSystem* jobSystem,
+            uint8_t simultaneousFramesInFlight,
             const RenderSurfaceDescription& defaultRenderSurface
         );
 
+        void BeginFrame(uint64_t frameNumber);
+
+        // Load driver-compiled states from the file and keep it updated after every compilation batch
+        void EnablePipelineStateCache(const std::filesystem::path& cacheFilePath, uint64_t deviceFingerprint);
+
         void CreateRootSignature(RootSignatureName name, const RootSignatureConfigurator& configurator);
         void CreateGraphicsState(PSOName name, const GraphicsStateConfigurator& configurator);
         void CreateComputeState(PSOName name, const ComputeStateConfigurator& configurator);
         void CreateRayTracingState(PSOName name, const RayTracingStateConfigurator& configurator);
 
+        // Arguments are patched into shader table memory that is not used by frames in flight, no table rebuild is involved
+        void SetHitGroupLocalRootArguments(PSOName name, uint64_t hitGroupIndex, const void* arguments, uint64_t size);
+
         std::optional<PipelineStateVariant> GetPipelineState(PSOName name) const;
         const HAL::RootSignature* GetRootSignature(RootSignatureName name) const;
         const HAL::RootSignature& BaseRootSignature() const;
@@ -58,11 +89,21 @@ namespace PathFinder
         void CompileUncompiledSignaturesAndStates();
 
     private:
+        // Table memory that frames in flight may still be reading must stay intact,
+        // so every frame in flight gets its own copy which catches up on patches it missed
+        struct ShaderTableCopy
+        {
+            Memory::GPUResourceProducer::BufferPtr Buffer;
+            std::vector<HAL::ShaderTableBuilder::Patch> MissedPatches;
+        };
+
         struct RayTracingStateWrapper
         {
             PSOName Name;
             HAL::RayTracingPipelineState State;
-            Memory::GPUResourceProducer::BufferPtr ShaderTableBuffer;
+            std::vector<ShaderTableCopy> ShaderTableCopies;
+            uint64_t CurrentShaderTableCopyIndex = 0;
+            uint64_t ShaderTableCopySwitchFrameNumber = 0;
 
             // Dispatch info containing shader table memory layout
             // but not actual dispatch dimensions. Clone this
@@ -73,6 +114,16 @@ namespace PathFinder
         // Store graphic and compute states directly, but store ray tracing one in a wrapper because we need to manage and associate additional memory with it
         using PipelineStateVariantInternal = std::variant<HAL::GraphicsPipelineState, HAL::ComputePipelineState, RayTracingStateWrapper>;
 
+        // Produced by worker threads and consumed serially
+        struct StateCompilationResult
+        {
+            PSOName Name;
+            PipelineStateVariantInternal* State = nullptr;
+            StateCompilationInfo Info;
+            std::optional<PipelineStateCache::Key> CacheKey;
+            std::optional<std::vector<uint8_t>> NewCachedBlob;
+        };
+
         const HAL::RootSignature* GetNamedRootSignatureOrDefault(std::optional<RootSignatureName> name) const;
         const HAL::RootSignature* GetNamedRootSignatureOrNull(std::optional<RootSignatureName> name) const;
 
@@ -81,14 +132,21 @@ namespace PathFinder
 
         void ConfigureDefaultStates();
         void AddCommonRootSignatureParameters(HAL::RootSignature& signature) const;
-        void CompileRayTracingState(RayTracingStateWrapper& stateWrapper);
+        void CompileSignatures();
+        void CompileState(StateCompilationResult& result) const;
+        void CompileCacheableState(HAL::PipelineState& state, StateCompilationResult& result) const;
+        void UploadShaderTable(RayTracingStateWrapper& stateWrapper);
+        void UpdatePipelineStateCache(StateCompilationResult& result);
 
         void RecompileStatesWithNewShader(const HAL::Shader* oldShader, const HAL::Shader* newShader);
         void RecompileStatesWithNewLibrary(const HAL::Library* oldLibrary, const HAL::Library* newLibrary);
 
         ShaderManager* mShaderManager; 
         Memory::GPUResourceProducer* mResourceProducer;
+        Foundation::JobSystem* mJobSystem;
         RenderSurfaceDescription mDefaultRenderSurfaceDesc;
+        uint8_t mSimultaneousFramesInFlight = 1;
+        uint64_t mFrameNumber = 0;
         
         HAL::Device* mDevice;
         HAL::RootSignature mBaseRootSignature;
@@ -100,6 +158,11 @@ namespace PathFinder
         robin_hood::unordered_map<const HAL::Library*, robin_hood::unordered_flat_set<PipelineStateVariantInternal*>> mLibraryToPSOAssociations;
         robin_hood::unordered_set<PipelineStateVariantInternal*> mStatesToCompile;
         robin_hood::unordered_set<HAL::RootSignature*> mSignaturesToCompile;
+        robin_hood::unordered_flat_map<PSOName, StateCompilationInfo> mCompilationInfos;
+        CompilationStatistics mLastCompilationStatistics;
+
+        std::unique_ptr<PipelineStateCache> mStateCache;
+        std::filesystem::path mStateCacheFilePath;
 
         std::string mDefaultVertexEntryPointName = "VSMain";
         std::string mDefaultPixelEntryPointName = "PSMain";
@@ -113,6 +176,9 @@ namespace PathFinder
 
     public:
         inline const auto CommonRootSignatureParameterCount() const { return mBaseRootSignature.ParameterCount(); }
+        inline const auto& CompilationInfos() const { return mCompilationInfos; }
+        inline const auto& LastCompilationStatistics() const { return mLastCompilationStatistics; }
+        inline const PipelineStateCache* StateCache() const { return mStateCache.get(); }
     };
 
 }
@@ -1,6 +1,7 @@
 #include "RenderDevice.hpp"
+#include "CopyRequestHandling.hpp"
 
-
+#include <algorithm>
 
 namespace PathFinder
 {
@@ -30,7 +31,16 @@ namespace PathFinder
         mDefaultRenderSurface{ defaultRenderSurface },
         mGraphicsQueueFence{ device },
         mComputeQueueFence{ device },
-        mBVHFence{ device }
+        mBVHFence{ device },
+        mBarrierScheduler{ 
+            [this](uint64_t queueIndex, HAL::ResourceState beforeStates, HAL::ResourceState afterStates)
+            {
+                return IsStateTransitionSupportedOnQueue(queueIndex, beforeStates, afterStates);
+            },
+            [](const HAL::Resource* resource, HAL::ResourceState beforeStates, HAL::ResourceState afterStates)
+            {
+                return Memory::ResourceStateTracker::CanResourceBeImplicitlyTransitioned(*resource, beforeStates, afterStates);
+            }}
     {
         mGraphicsQueue.SetDebugName("Graphics Queue");
         mComputeQueue.SetDebugName("Async Compute Queue");
@@ -56,6 +66,11 @@ namespace PathFinder
         return mBackBuffer;
     }
 
+    void RenderDevice::SetDefaultRenderSurfaceDesc(const RenderSurfaceDescription& surface)
+    {
+        mDefaultRenderSurface = surface;
+    }
+
     void RenderDevice::AllocateUploadCommandList()
     {
         mPreRenderUploadsCommandList = mCommandListAllocator->AllocateGraphicsCommandList();
@@ -68,7 +83,7 @@ namespace PathFinder
     {
         mRTASBuildsCommandList = mCommandListAllocator->AllocateComputeCommandList();
         mRTASBuildsCommandList->Reset();
-        mPreRenderUploadsCommandList->SetDebugName("Ray Tracing BVH Build Cmd List");
+        mRTASBuildsCommandList->SetDebugName("Ray Tracing BVH Build Cmd List");
         mEventTracker.StartGPUEvent("Ray Tracing BVH Build", *mRTASBuildsCommandList);
     }
 
@@ -82,9 +97,7 @@ namespace PathFinder
             mPassHelpers[node->GlobalExecutionIndex()] = PassHelpers{};
             PassHelpers& helpers = mPassHelpers[node->GlobalExecutionIndex()];
             helpers.ResourceStoragePassData = mResourceStorage->GetPerPassData(node->PassMetadata().Name);
-            helpers.ResourceStoragePassData->LastSetConstantBufferDataSize = 0;
-            helpers.ResourceStoragePassData->PassConstantBufferMemoryOffset = 0;
-            helpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = false;
+            helpers.ResourceStoragePassData->PassConstantBufferAddress = 0;
         }
 
         mPassCommandLists.clear();
@@ -118,7 +131,7 @@ namespace PathFinder
                 }
 
                 const PipelineResourceStorageResource* resourceData = mResourceStorage->GetPerResourceData(resourceName);
-                const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceData->SchedulingInfo.GetInfoForPass(node->PassMetadata().Name);
+                const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceData->SchedulingInfo.GetInfoForPass(node->IndexInUnorderedList());
 
                 if (passInfo->NeedsAliasingBarrier)
                 {
@@ -142,7 +155,6 @@ namespace PathFinder
         ExecuteBVHBuildCommands();
 
         BatchCommandLists();
-        UploadPassConstants();
         ExetuteCommandLists();
     }
 
@@ -155,6 +167,21 @@ namespace PathFinder
         }
     }
 
+    float RenderDevice::GPUFrameDurationSeconds() const
+    {
+        std::vector<float> queueDurations(mQueueCount, 0.0f);
+
+        for (const PipelineMeasurement& measurement : mMeasurements)
+        {
+            if (measurement.QueueIndex < queueDurations.size())
+            {
+                queueDurations[measurement.QueueIndex] += measurement.DurationSeconds;
+            }
+        }
+
+        return queueDurations.empty() ? 0.0f : *std::max_element(queueDurations.begin(), queueDurations.end());
+    }
+
     void RenderDevice::BatchCommandLists()
     {
         mCommandListBatches.clear();
@@ -163,13 +190,10 @@ namespace PathFinder
         mReroutedTransitionsCommandLists.clear();
         mReroutedTransitionsCommandLists.resize(mRenderPassGraph->DependencyLevels().size());
 
-        mPerNodeBeginBarriers.clear();
-        mPerNodeBeginBarriers.resize(mRenderPassGraph->NodesInGlobalExecutionOrder().size());
-
         mPerNodeReadbackInfo.clear();
         mPerNodeReadbackInfo.resize(mRenderPassGraph->NodesInGlobalExecutionOrder().size());
 
-        mSubresourcesPreviousUsageInfo.clear();
+        mBarrierScheduler.Reset(mRenderPassGraph->NodesInGlobalExecutionOrder().size());
 
         for (const RenderPassGraph::DependencyLevel& dependencyLevel : mRenderPassGraph->DependencyLevels())
         {
@@ -210,13 +234,13 @@ namespace PathFinder
                 }
 
                 PipelineResourceStorageResource* resourceData = mResourceStorage->GetPerResourceData(resourceName);
-                const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceData->SchedulingInfo.GetInfoForPass(node->PassMetadata().Name);
+                const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceData->SchedulingInfo.GetInfoForPass(node->IndexInUnorderedList());
                 
                 // When dealing with reading use combined read state to make one transition instead of 
                 // several separate consequential transitions when neighboring render passes require resource in different read states
                 HAL::ResourceState newState = isReadDependency ?
                     resourceData->SchedulingInfo.GetSubresourceCombinedReadStates(subresourceIndex) :
-                    newState = passInfo->SubresourceInfos[subresourceIndex]->RequestedState;
+                    newState = resourceData->SchedulingInfo.GetSubresourceInfo(node->IndexInUnorderedList(), subresourceIndex)->RequestedState;
 
                 std::optional<HAL::ResourceTransitionBarrier> barrier =
                     mResourceStateTracker->TransitionToStateImmediately(resourceData->GetGPUResource()->HALResource(), newState, subresourceIndex, false);
@@ -291,10 +315,10 @@ namespace PathFinder
 
             ResourceReadbackInfo& readbackInfo = mPerNodeReadbackInfo[node->GlobalExecutionIndex()];
 
-            for (const Memory::CopyRequestManager::CopyRequest& request : mCopyRequestManager->ReadbackRequests())
+            for (const Memory::CopyRequestManager::CopyRegion& request : mCopyRequestManager->ReadbackRequests())
             {
-                HAL::ResourceBarrierCollection toCopyBarriers = mResourceStateTracker->TransitionToStateImmediately(request.Resource, HAL::ResourceState::CopySource);
-                readbackInfo.CopyCommands.push_back(request.Command);
+                HAL::ResourceBarrierCollection toCopyBarriers = mResourceStateTracker->TransitionToStateImmediately(request.Source, HAL::ResourceState::CopySource);
+                readbackInfo.Copies.push_back(request);
                 readbackInfo.ToCopyStateTransitions.AddBarriers(toCopyBarriers);
             }
 
@@ -317,59 +341,24 @@ namespace PathFinder
             // to correctly place split barriers later, if needed, graphic API transition for this pass is not required
             if (!transitionInfo.TransitionBarrier)
             {
-                mSubresourcesPreviousUsageInfo[transitionInfo.SubresourceName] = { node, currentCommandListBatchIndex };
+                mBarrierScheduler.RecordUsage(transitionInfo.SubresourceName, node, currentCommandListBatchIndex);
                 continue;
             }
 
-            // Transition is explicit. Look for previous transition info to see whether current explicit transition can be made
-            // implicit due to automatic promotion/decay.
-            auto previousTransitionInfoIt = mSubresourcesPreviousUsageInfo.find(transitionInfo.SubresourceName);
-            bool foundPreviousTransition = previousTransitionInfoIt != mSubresourcesPreviousUsageInfo.end();
-            bool subresourceTransitionedAtLeastOnce = foundPreviousTransition && previousTransitionInfoIt->second.CommandListBatchIndex == currentCommandListBatchIndex;
-
-            if (!subresourceTransitionedAtLeastOnce)
-            {
-                bool implicitTransitionPossible = Memory::ResourceStateTracker::CanResourceBeImplicitlyTransitioned(
-                    *transitionInfo.Resource, transitionInfo.TransitionBarrier->BeforeStates(), transitionInfo.TransitionBarrier->AfterStates());
-
-                if (implicitTransitionPossible)
-                {
-                    continue;
-                }
-            }
-
-            // When previous transition is found we can try to split the barrier
-            if (foundPreviousTransition)
-            {
-                const SubresourcePreviousUsageInfo& previousTransitionInfo = previousTransitionInfoIt->second;
-
-                // Split barrier is only possible when transmitting queue supports transitions for both before and after states
-                bool isSplitBarrierPossible = IsStateTransitionSupportedOnQueue(
-                    previousTransitionInfo.Node->ExecutionQueueIndex, transitionInfo.TransitionBarrier->BeforeStates(), transitionInfo.TransitionBarrier->AfterStates()
-                );
-
-                // There is no sense in splitting barriers between two adjacent render passes. 
-                // That will only double the amount of barriers without any performance gain.
-                bool currentNodeIsNextToPrevious = node->LocalToQueueExecutionIndex() - previousTransitionInfo.Node->LocalToQueueExecutionIndex() <= 1;
-
-                if (isSplitBarrierPossible && !currentNodeIsNextToPrevious)
-                {
-                    auto [beginBarrier, endBarrier] = transitionInfo.TransitionBarrier->Split();
-                    collection.AddBarrier(endBarrier);
-                    mPerNodeBeginBarriers[previousTransitionInfo.Node->GlobalExecutionIndex()].AddBarrier(beginBarrier);
-                }
-                else
-                {
-                    collection.AddBarrier(*transitionInfo.TransitionBarrier);
-                }
-            }
-            else
-            {
-                collection.AddBarrier(*transitionInfo.TransitionBarrier);
-            }
-
-            mSubresourcesPreviousUsageInfo[transitionInfo.SubresourceName] = { node, currentCommandListBatchIndex };
+            // Transition is explicit. Let the scheduler decide whether it can be made implicit 
+            // due to automatic promotion/decay or split between previous usage and current node.
+            mBarrierScheduler.ScheduleTransition(
+                transitionInfo.SubresourceName, 
+                transitionInfo.Resource, 
+                transitionInfo.Resource->SubresourceCount(),
+                transitionInfo.TransitionBarrier->BeforeStates(),
+                transitionInfo.TransitionBarrier->AfterStates(),
+                node, 
+                currentCommandListBatchIndex);
         }
+
+        // Begin parts of split barriers are emitted later, when all nodes are processed
+        mBarrierScheduler.EmitEndBarriers(node->GlobalExecutionIndex(), collection);
     }
 
     void RenderDevice::CreateBatchesWithTransitionRerouting(const RenderPassGraph::DependencyLevel& dependencyLevel)
@@ -568,12 +557,14 @@ namespace PathFinder
 
         for (const RenderPassGraph::Node* node : mRenderPassGraph->NodesInGlobalExecutionOrder())
         {
-            const HAL::ResourceBarrierCollection& beginBarriers = mPerNodeBeginBarriers[node->GlobalExecutionIndex()];
+            HAL::ResourceBarrierCollection beginBarriers{};
+            mBarrierScheduler.EmitBeginBarriers(node->GlobalExecutionIndex(), beginBarriers);
+
             const ResourceReadbackInfo& readbackInfo = mPerNodeReadbackInfo[node->GlobalExecutionIndex()];
 
             bool lastGraphicNode = node->LocalToQueueExecutionIndex() == graphicNodesCount - 1;
             bool beginBarriersExist = beginBarriers.BarrierCount() > 0;
-            bool readbackRequestsExist = readbackInfo.CopyCommands.size() > 0;
+            bool readbackRequestsExist = readbackInfo.Copies.size() > 0;
 
             bool postWorkExists = lastGraphicNode || beginBarriersExist || readbackRequestsExist;
 
@@ -607,9 +598,9 @@ namespace PathFinder
             {
                 cmdList->InsertBarriers(readbackInfo.ToCopyStateTransitions);
                 
-                for (const Memory::CopyRequestManager::CopyCommand& command : readbackInfo.CopyCommands)
+                for (const Memory::CopyRequestManager::CopyRegion& copy : readbackInfo.Copies)
                 {
-                    command(*cmdList);
+                    RecordCopy(*cmdList, copy);
                 }
             }
 
@@ -712,18 +703,6 @@ namespace PathFinder
         }
     }
 
-    void RenderDevice::UploadPassConstants()
-    {
-        for (PassHelpers& passHelpers : mPassHelpers)
-        {
-            if (Memory::Buffer* passConstantBuffer = passHelpers.ResourceStoragePassData->PassConstantBuffer.get())
-            {
-                const auto& bytes = passHelpers.ResourceStoragePassData->PassConstantData;
-                passConstantBuffer->Write(bytes.data(), 0, bytes.size());
-            }
-        }
-    }
-
     bool RenderDevice::IsStateTransitionSupportedOnQueue(uint64_t queueIndex, HAL::ResourceState beforeState, HAL::ResourceState afterState) const
     {
         return IsStateTransitionSupportedOnQueue(queueIndex, beforeState) && IsStateTransitionSupportedOnQueue(queueIndex, afterState);
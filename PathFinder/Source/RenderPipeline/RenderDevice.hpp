@@ -5,6 +5,7 @@
 #include "PipelineStateManager.hpp"
 #include "RenderPassMetadata.hpp"
 #include "GPUProfiler.hpp"
+#include "BarrierScheduler.hpp"
 
 #include <Foundation/Name.hpp>
 #include <Utility/EventTracker.hpp>
@@ -44,6 +45,7 @@ namespace PathFinder
             std::string Name;
             float DurationSeconds;
             GPUProfiler::EventID ProfilerEventID;
+            uint64_t QueueIndex = 0;
         };
 
         struct PassCommandLists
@@ -105,6 +107,9 @@ namespace PathFinder
         void SetBackBuffer(Memory::Texture* backBuffer);
         const Memory::Texture* BackBuffer() const;
 
+        // Render scale of the surface may change between frames
+        void SetDefaultRenderSurfaceDesc(const RenderSurfaceDescription& surface);
+
         void AllocateUploadCommandList();
         void AllocateRTASBuildsCommandList();
         void AllocateWorkerCommandLists();
@@ -112,6 +117,9 @@ namespace PathFinder
         void ExecuteRenderGraph();
         void GatherMeasurements();
 
+        // Queues work in parallel, so the busiest queue defines GPU frame duration
+        float GPUFrameDurationSeconds() const;
+
         template <class Lambda>
         void RecordWorkerCommandList(const RenderPassGraph::Node& passNode, const Lambda& action);
 
@@ -137,21 +145,14 @@ namespace PathFinder
             const HAL::Resource* Resource = nullptr;
         };
 
-        struct SubresourcePreviousUsageInfo
-        {
-            const RenderPassGraph::Node* Node = nullptr;
-            uint64_t CommandListBatchIndex = 0;
-        };
-
         struct ResourceReadbackInfo
         {
-            std::vector<Memory::CopyRequestManager::CopyCommand> CopyCommands;
+            std::vector<Memory::CopyRequestManager::CopyRegion> Copies;
             HAL::ResourceBarrierCollection ToCopyStateTransitions;
         };
 
         void BatchCommandLists();
         void ExetuteCommandLists();
-        void UploadPassConstants();
 
         void GatherResourceTransitionKnowledge(const RenderPassGraph::DependencyLevel& dependencyLevel);
         void CollectNodeTransitions(const RenderPassGraph::Node* node, uint64_t currentCommandListBatchIndex, HAL::ResourceBarrierCollection& collection);
@@ -201,8 +202,8 @@ namespace PathFinder
         uint64_t mQueueCount = 2;
         uint64_t mBVHBuildsQueueIndex = 1;
 
-        // Keep track of nodes where transitions previously occurred (where resource was used last) to insert Begin part of split barriers there
-        robin_hood::unordered_flat_map<RenderPassGraph::SubresourceName, SubresourcePreviousUsageInfo> mSubresourcesPreviousUsageInfo;
+        // Decides where Begin/End parts of transitions go and keeps the resulting plan for inspection
+        BarrierScheduler mBarrierScheduler;
 
         // Keep list of separate barriers gathered for dependency level so we could cull them, if conditions are met, when command list batches are determined
         std::vector<std::vector<SubresourceTransitionInfo>> mDependencyLevelTransitionBarriers;
@@ -213,9 +214,6 @@ namespace PathFinder
         // Keep track of queues inside a graph dependency layer that require transition rerouting
         robin_hood::unordered_flat_set<RenderPassGraph::Node::QueueIndex> mDependencyLevelQueuesThatRequireTransitionRerouting;
 
-        // Collect begin barriers for passes that may issue them to be applied in batches after all nodes are processed
-        std::vector<HAL::ResourceBarrierCollection> mPerNodeBeginBarriers;
-
         // Collect aliasing barriers for passes
         std::vector<HAL::ResourceBarrierCollection> mPerNodeAliasingBarriers;
 
@@ -232,6 +230,7 @@ namespace PathFinder
         inline HAL::ComputeCommandList* RTASBuildsCommandList() { return mRTASBuildsCommandList.get(); }
         inline const RenderSurfaceDescription& DefaultRenderSurfaceDesc() { return mDefaultRenderSurface; }
         inline const auto& Measurements() const { return mMeasurements; }
+        inline const auto& BarrierPlan() const { return mBarrierScheduler; }
     };
 
 }
@@ -17,6 +17,7 @@ namespace PathFinder
         PipelineMeasurement& measurement = mMeasurements[passNode.GlobalExecutionIndex()];
         measurement.Name = passName;
         measurement.ProfilerEventID = profilerEventID;
+        measurement.QueueIndex = passNode.ExecutionQueueIndex;
 
         if (worker->AftermathHandle())
         {
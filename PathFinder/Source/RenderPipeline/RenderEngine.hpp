@@ -12,10 +12,15 @@
 
 #include <Scene/Scene.hpp>
 #include <Foundation/Event.hpp>
+#include <Foundation/JobSystem.hpp>
 #include <IO/CommandLineParser.hpp>
 #include <Utility/AftermathCrashTracker.hpp>
 
 #include <Memory/SegregatedPoolsResourceAllocator.hpp>
+#include <Memory/FrameUploadAllocator.hpp>
+#include <Memory/ConstantBufferManager.hpp>
+#include <Memory/ConstantBufferUploadMemory.hpp>
+#include <Memory/MemoryBudgetTracker.hpp>
 #include <Memory/PoolDescriptorAllocator.hpp>
 #include <Memory/ResourceStateTracker.hpp>
 #include <Memory/GPUResourceProducer.hpp>
@@ -41,6 +46,7 @@
 #include "TopRTAS.hpp"
 #include "GPUProfiler.hpp"
 #include "FrameFence.hpp"
+#include "DynamicResolutionController.hpp"
 
 namespace PathFinder
 {
@@ -75,16 +81,20 @@ namespace PathFinder
         void NotifyStartFrame(uint64_t newFrameNumber);
         void NotifyEndFrame(uint64_t completedFrameNumber);
         void MoveToNextFrame();
+        void BuildFrameTaskGraph();
         void UploadAssets();
+        void AllocateAccelerationStructuresCommandList();
         void BuildAccelerationStructures();
         void RecordCommandLists();
         void ScheduleFrame();
         void UpdateBackBuffers();
+        void UpdateRenderScale();
 
         RenderPassGraph mRenderPassGraph;
 
         uint8_t mCurrentBackBufferIndex = 0;
         uint8_t mSimultaneousFramesInFlight = 2;
+        uint64_t mDefragmentationBudget = 0;
         uint64_t mFrameNumber = 0;
         std::chrono::time_point<std::chrono::steady_clock> mFrameStartTimestamp;
         std::chrono::microseconds mFrameDuration = std::chrono::microseconds::zero();
@@ -94,7 +104,11 @@ namespace PathFinder
 
         std::unique_ptr<HAL::Device> mDevice;
 
+        std::unique_ptr<Memory::MemoryBudgetTracker> mMemoryBudgetTracker;
         std::unique_ptr<Memory::SegregatedPoolsResourceAllocator> mResourceAllocator;
+        std::unique_ptr<Memory::FrameUploadAllocator> mFrameUploadAllocator;
+        std::unique_ptr<Memory::ConstantBufferUploadMemory> mConstantBufferMemory;
+        std::unique_ptr<Memory::ConstantBufferManager> mConstantBufferManager;
         std::unique_ptr<Memory::PoolCommandListAllocator> mCommandListAllocator;
         std::unique_ptr<Memory::PoolDescriptorAllocator> mDescriptorAllocator;
         std::unique_ptr<Memory::ResourceStateTracker> mResourceStateTracker;
@@ -115,6 +129,10 @@ namespace PathFinder
         std::unique_ptr<RenderDevice> mRenderDevice;
         std::unique_ptr<RenderPassContainer<ContentMediator>> mRenderPassContainer;
         std::unique_ptr<GPUProfiler> mGPUProfiler;
+        std::unique_ptr<DynamicResolutionController> mResolutionController;
+
+        std::unique_ptr<Foundation::JobSystem> mJobSystem;
+        Foundation::TaskGraph mFrameTaskGraph;
 
         std::unique_ptr<HAL::SwapChain> mSwapChain;
         std::unique_ptr<FrameFence> mFrameFence;
@@ -134,13 +152,18 @@ namespace PathFinder
         inline PipelineResourceStorage* ResourceStorage() { return mPipelineResourceStorage.get(); }
         inline const RenderSurfaceDescription& RenderSurface() const { return mRenderSurfaceDescription; }
         inline Memory::GPUResourceProducer* ResourceProducer() { return mResourceProducer.get(); }
+        inline const Memory::MemoryBudgetTracker* MemoryBudget() const { return mMemoryBudgetTracker.get(); }
+        inline const Memory::ConstantBufferManager* ConstantBuffers() const { return mConstantBufferManager.get(); }
         inline RenderDevice* RendererDevice() { return mRenderDevice.get(); }
         inline HAL::Device* Device() { return mDevice.get(); }
         inline HAL::SwapChain* SwapChain() { return mSwapChain.get(); }
         inline HAL::DisplayAdapter* SelectedAdapter() { return mSelectedAdapter; }
         inline Event& PreRenderEvent() { return mPreRenderEvent; }
         inline Event& PostRenderEvent() { return mPostRenderEvent; }
+        inline Foundation::JobSystem* Jobs() { return mJobSystem.get(); }
+        inline auto SimultaneousFramesInFlight() const { return mSimultaneousFramesInFlight; }
         inline uint64_t FrameDurationUS() const { return mFrameDuration.count(); }
+        inline const DynamicResolutionController* ResolutionController() const { return mResolutionController.get(); }
     };
 
 }
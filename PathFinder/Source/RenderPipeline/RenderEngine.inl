@@ -33,25 +33,54 @@ namespace PathFinder
             mAftermathCrashTracker->RegisterDevice(*mDevice);
         }
         
+        // Per-frame rings of every allocator, profiler query ranges and 
+        // per-frame upload buffers are all derived from this value
+        mSimultaneousFramesInFlight = commandLineParser.FramesInFlight();
+        mDefragmentationBudget = commandLineParser.DefragmentationBudgetMB() * 1024 * 1024;
+
         mPassUtilityProvider = std::make_unique<RenderPassUtilityProvider>(RenderPassUtilityProvider{ 0, mRenderSurfaceDescription });
         mResourceStateTracker = std::make_unique<Memory::ResourceStateTracker>();
-        mResourceAllocator = std::make_unique<Memory::SegregatedPoolsResourceAllocator>(mDevice.get(), mSimultaneousFramesInFlight);
+        mMemoryBudgetTracker = std::make_unique<Memory::MemoryBudgetTracker>();
+
+        uint64_t memoryBudget = commandLineParser.MemoryBudgetMB() > 0 ?
+            commandLineParser.MemoryBudgetMB() * 1024 * 1024 : hwAdapter->DedicatedVideoMemory();
+
+        if (memoryBudget > 0)
+        {
+            mMemoryBudgetTracker->SetBudget(memoryBudget);
+        }
+
+        mMemoryBudgetTracker->SetOverBudgetCallback([](const Memory::MemoryBudgetTracker::Snapshot& snapshot)
+        {
+            OutputDebugStringA(StringFormat(
+                "GPU memory budget exceeded: %llu MB reserved in local heaps, budget is %llu MB\n",
+                snapshot.LocalReservedBytes / (1024 * 1024), snapshot.BudgetBytes / (1024 * 1024)).c_str());
+        });
+
+        mResourceAllocator = std::make_unique<Memory::SegregatedPoolsResourceAllocator>(mDevice.get(), mSimultaneousFramesInFlight, mMemoryBudgetTracker.get());
+        mFrameUploadAllocator = std::make_unique<Memory::FrameUploadAllocator>(mResourceAllocator.get(), mSimultaneousFramesInFlight);
+        mConstantBufferMemory = std::make_unique<Memory::ConstantBufferUploadMemory>(mFrameUploadAllocator.get(), mResourceAllocator.get());
+        mConstantBufferManager = std::make_unique<Memory::ConstantBufferManager>(mConstantBufferMemory.get());
         mCommandListAllocator = std::make_unique<Memory::PoolCommandListAllocator>(mDevice.get(), mSimultaneousFramesInFlight);
-        mDescriptorAllocator = std::make_unique<Memory::PoolDescriptorAllocator>(mDevice.get(), mSimultaneousFramesInFlight);
-        mCopyRequestManager = std::make_unique<Memory::CopyRequestManager>();
+        mDescriptorAllocator = std::make_unique<Memory::PoolDescriptorAllocator>(mDevice.get(), mSimultaneousFramesInFlight, mMemoryBudgetTracker.get());
+        mCopyRequestManager = std::make_unique<Memory::CopyRequestManager>(commandLineParser.UploadBudgetMB() * 1024 * 1024);
 
         mResourceProducer = std::make_unique<Memory::GPUResourceProducer>(
             mDevice.get(), 
             mResourceAllocator.get(), 
             mResourceStateTracker.get(), 
             mDescriptorAllocator.get(),
-            mCopyRequestManager.get());
+            mCopyRequestManager.get(),
+            mFrameUploadAllocator.get());
 
         mPipelineResourceStorage = std::make_unique<PipelineResourceStorage>(
             mDevice.get(), 
             mResourceProducer.get(), 
             mDescriptorAllocator.get(), 
             mResourceStateTracker.get(), 
+            mMemoryBudgetTracker.get(),
+            mConstantBufferManager.get(),
+            mSimultaneousFramesInFlight,
             mRenderSurfaceDescription, 
             &mRenderPassGraph);
 
@@ -69,17 +98,42 @@ namespace PathFinder
             commandLineParser.ShouldEnableAftermath(),
             &mAftermathCrashTracker->ShaderDatabase());
 
+        mJobSystem = std::make_unique<Foundation::JobSystem>();
+
         mPipelineStateManager = std::make_unique<PipelineStateManager>(
             mDevice.get(),
             mShaderManager.get(), 
             mResourceProducer.get(), 
+            mJobSystem.get(),
+            mSimultaneousFramesInFlight,
             mRenderSurfaceDescription);
 
+        if (!commandLineParser.DisablePipelineStateCache())
+        {
+            // Driver-compiled blobs are only valid for the same GPU and driver
+            uint64_t deviceFingerprint = PipelineStateCache::CombineHashes(hwAdapter->VendorID(), hwAdapter->DeviceID());
+            deviceFingerprint = PipelineStateCache::CombineHashes(deviceFingerprint, hwAdapter->DriverVersion());
+
+            mPipelineStateManager->EnablePipelineStateCache(
+                commandLineParser.ExecutableFolderPath() / "Cache/PipelineStates.bin", deviceFingerprint);
+        }
+
         mPipelineStateCreator = std::make_unique<PipelineStateCreator>(mPipelineStateManager.get());
         mRootSignatureCreator = std::make_unique<RootSignatureCreator>(mPipelineStateManager.get());
         mSamplerCreator = std::make_unique<SamplerCreator>(mPipelineResourceStorage.get());
         mGPUProfiler = std::make_unique<GPUProfiler>(*mDevice, 1024, mSimultaneousFramesInFlight, mResourceProducer.get());
 
+        if (commandLineParser.DynamicResolutionTargetMS() > 0.0f)
+        {
+            DynamicResolutionController::Settings resolutionSettings{};
+            resolutionSettings.TargetFrameTimeSeconds = commandLineParser.DynamicResolutionTargetMS() / 1000.0f;
+            resolutionSettings.MinScale = commandLineParser.MinRenderScale();
+            // Frames already in flight when scale changes are still rendered with the old one
+            resolutionSettings.SettleFrameCount = mSimultaneousFramesInFlight + 1;
+
+            mResolutionController = std::make_unique<DynamicResolutionController>(resolutionSettings);
+        }
+
         mRenderDevice = std::make_unique<RenderDevice>(
             *mDevice,
             mDescriptorAllocator.get(),
@@ -97,7 +151,7 @@ namespace PathFinder
             mRenderDevice->GraphicsCommandQueue(),
             windowHandle,
             true,
-            HAL::BackBufferingStrategy::Double, 
+            mSimultaneousFramesInFlight > 2 ? HAL::BackBufferingStrategy::Triple : HAL::BackBufferingStrategy::Double,
             mRenderSurfaceDescription.Dimensions());
 
         mRenderPassContainer = std::make_unique<RenderPassContainer<ContentMediator>>(
@@ -115,6 +169,8 @@ namespace PathFinder
 
         mFrameFence = std::make_unique<FrameFence>(*mDevice);
 
+        BuildFrameTaskGraph();
+
         // Start first frame here to prepare engine for external data transfer requests
         mFrameFence->HALFence().IncrementExpectedValue();
         NotifyStartFrame(mFrameFence->HALFence().ExpectedValue());
@@ -157,28 +213,9 @@ namespace PathFinder
             NotifyStartFrame(mFrameFence->HALFence().ExpectedValue());
         }
 
-        // Scheduler resources, build graph
-        ScheduleFrame();
-
-        // Compile new states and signatures, if any
-        mPipelineStateManager->CompileUncompiledSignaturesAndStates();
-
-        // Notify external listeners
-        mPreRenderEvent.Raise();
+        // Schedule, compile, upload and record everything that is needed for the frame
+        mJobSystem->Execute(mFrameTaskGraph);
 
-        // External listeners might've caused back buffer reallocation
-        if (mSwapChain->AreBackBuffersUpdated())
-            UpdateBackBuffers();
-
-        // Update render device with current frame back buffer
-        mRenderDevice->SetBackBuffer(mBackBuffers[mCurrentBackBufferIndex].get());
-
-        UploadAssets();
-        BuildAccelerationStructures();
-
-        // Render
-        mRenderDevice->AllocateWorkerCommandLists();
-        RecordCommandLists();
         mRenderDevice->ExecuteRenderGraph();
 
         // Put the picture on the screen
@@ -193,6 +230,7 @@ namespace PathFinder
 
         // Gather extracted measurement
         mRenderDevice->GatherMeasurements();
+        UpdateRenderScale();
 
         // Notify external listeners
         mPostRenderEvent.Raise();
@@ -210,11 +248,19 @@ namespace PathFinder
     void RenderEngine<ContentMediator>::NotifyStartFrame(uint64_t newFrameNumber)
     {
         mShaderManager->BeginFrame();
+        mMemoryBudgetTracker->BeginFrame(newFrameNumber);
         mResourceAllocator->BeginFrame(newFrameNumber);
+        mFrameUploadAllocator->BeginFrame(newFrameNumber);
+        mConstantBufferManager->BeginFrame(newFrameNumber);
         mDescriptorAllocator->BeginFrame(newFrameNumber);
         mCommandListAllocator->BeginFrame(newFrameNumber);
         mResourceProducer->BeginFrame(newFrameNumber);
-        mPipelineResourceStorage->BeginFrame();
+        mPipelineStateManager->BeginFrame(newFrameNumber);
+
+        // Resources must know the new frame number to accept relocations
+        mResourceAllocator->Defragment(mDefragmentationBudget);
+
+        mPipelineResourceStorage->BeginFrame(newFrameNumber);
         mGPUProfiler->BeginFrame(newFrameNumber);
 
         mFrameStartTimestamp = std::chrono::steady_clock::now();
@@ -225,6 +271,8 @@ namespace PathFinder
     {
         mShaderManager->EndFrame();
         mResourceProducer->EndFrame(completedFrameNumber);
+        mFrameUploadAllocator->EndFrame(completedFrameNumber);
+        mConstantBufferManager->EndFrame(completedFrameNumber);
         mResourceAllocator->EndFrame(completedFrameNumber);
         mDescriptorAllocator->EndFrame(completedFrameNumber);
         mCommandListAllocator->EndFrame(completedFrameNumber);
@@ -246,16 +294,70 @@ namespace PathFinder
         mTopRTASes.clear();
     }
 
+    template <class ContentMediator>
+    void RenderEngine<ContentMediator>::BuildFrameTaskGraph()
+    {
+        using Affinity = Foundation::TaskGraph::Affinity;
+
+        // Command list allocator, resource producer and state tracker are not thread safe,
+        // so tasks touching them are chained, while the rest is allowed to overlap.
+        // External listeners are always invoked on the thread that calls Render().
+        auto schedule = mFrameTaskGraph.AddTask("Schedule Frame", [this] { ScheduleFrame(); });
+
+        auto preRender = mFrameTaskGraph.AddTask("Pre Render", [this]
+        {
+            // Notify external listeners
+            mPreRenderEvent.Raise();
+
+            // External listeners might've caused back buffer reallocation
+            if (mSwapChain->AreBackBuffersUpdated())
+                UpdateBackBuffers();
+
+            // Update render device with current frame back buffer
+            mRenderDevice->SetBackBuffer(mBackBuffers[mCurrentBackBufferIndex].get());
+        }, 
+        Affinity::CallingThread);
+
+        // Compilation can create shader tables, so it needs to go after scene upload in pre render
+        // and before asset upload. Shader tables are allocated through resource producer and
+        // its allocators, so compilation is chained with the rest of GPU side frame preparation.
+        auto compile = mFrameTaskGraph.AddTask("Compile States", [this] { mPipelineStateManager->CompileUncompiledSignaturesAndStates(); });
+        auto allocateRTASCommandList = mFrameTaskGraph.AddTask("Allocate BVH Cmd List", [this] { AllocateAccelerationStructuresCommandList(); });
+        auto buildRTAS = mFrameTaskGraph.AddTask("Build BVH", [this] { BuildAccelerationStructures(); });
+        auto allocateWorkerCommandLists = mFrameTaskGraph.AddTask("Allocate Worker Cmd Lists", [this] { mRenderDevice->AllocateWorkerCommandLists(); });
+        auto upload = mFrameTaskGraph.AddTask("Upload Assets", [this] { UploadAssets(); });
+        auto record = mFrameTaskGraph.AddTask("Record Cmd Lists", [this] { RecordCommandLists(); });
+
+        mFrameTaskGraph.AddDependency(preRender, schedule);
+        mFrameTaskGraph.AddDependency(compile, preRender);
+        mFrameTaskGraph.AddDependency(allocateRTASCommandList, compile);
+        mFrameTaskGraph.AddDependency(buildRTAS, allocateRTASCommandList);
+        mFrameTaskGraph.AddDependency(allocateWorkerCommandLists, allocateRTASCommandList);
+        mFrameTaskGraph.AddDependency(upload, compile);
+        mFrameTaskGraph.AddDependency(upload, allocateWorkerCommandLists);
+        mFrameTaskGraph.AddDependency(record, upload);
+    }
+
     template <class ContentMediator>
     void RenderEngine<ContentMediator>::UploadAssets()
     {
         mRenderDevice->AllocateUploadCommandList();
         RecordUploadRequests(*mRenderDevice->PreRenderUploadsCommandList(), *mResourceStateTracker, *mCopyRequestManager, true);
+        RecordRelocationRequests(*mRenderDevice->PreRenderUploadsCommandList(), *mResourceStateTracker, *mCopyRequestManager);
         mRenderDevice->PreRenderUploadsCommandList()->Close();
 
         assert_format(mCopyRequestManager->ReadbackRequests().empty(), "We shouldn't have any readback requests at this stage");
     }
 
+    template <class ContentMediator>
+    void RenderEngine<ContentMediator>::AllocateAccelerationStructuresCommandList()
+    {
+        if (mRenderPassGraph.FirstNodeThatUsesRayTracing())
+        {
+            mRenderDevice->AllocateRTASBuildsCommandList();
+        }
+    }
+
     template <class ContentMediator>
     void RenderEngine<ContentMediator>::BuildAccelerationStructures()
     {
@@ -266,8 +368,6 @@ namespace PathFinder
             return;
         }
 
-        mRenderDevice->AllocateRTASBuildsCommandList();
-
         HAL::ResourceBarrierCollection bottomRTASUABarriers{};
 
         for (const BottomRTAS* blas : mBottomRTASes)
@@ -325,7 +425,7 @@ namespace PathFinder
         mRenderPassGraph.Clear();
 
         // Run scheduling for standard render passes
-        mPipelineResourceStorage->StartResourceScheduling();
+        mResourceScheduler->BeginScheduling();
 
         for (auto& [passName, passHelpers] : mRenderPassContainer->RenderPasses())
         {
@@ -345,7 +445,7 @@ namespace PathFinder
             }
         }
 
-        mPipelineResourceStorage->EndResourceScheduling();
+        mResourceScheduler->EndScheduling();
 
         // Run sub pass scheduling after scheduling first wave of resources
         for (auto& [passName, passHelpers] : mRenderPassContainer->RenderPasses())
@@ -354,7 +454,7 @@ namespace PathFinder
         }
 
         // Run scheduling for sub render passes
-        mPipelineResourceStorage->StartResourceScheduling();
+        mResourceScheduler->BeginScheduling();
 
         for (auto& [passName, passHelpers] : mRenderPassContainer->RenderSubPasses())
         {
@@ -362,13 +462,35 @@ namespace PathFinder
             passHelpers.Pass->ScheduleResources(mResourceScheduler.get());
         }
 
-        mPipelineResourceStorage->EndResourceScheduling();
+        mResourceScheduler->EndScheduling();
 
         // Finish graph and allocate memory 
         mRenderPassGraph.Build();
         mPipelineResourceStorage->AllocateScheduledResources();
     }
 
+    template <class ContentMediator>
+    void RenderEngine<ContentMediator>::UpdateRenderScale()
+    {
+        if (!mResolutionController)
+        {
+            return;
+        }
+
+        float scale = mResolutionController->Update(mRenderDevice->GPUFrameDurationSeconds());
+
+        // Scale is also reapplied on the frame after a change, so that exactly one frame sees its history invalidated
+        if (scale == mRenderSurfaceDescription.RenderScale() && !mRenderSurfaceDescription.IsRenderDimensionsChanged())
+        {
+            return;
+        }
+
+        // Scheduled resources keep full surface dimensions, so only viewports and dispatches of the next frame shrink
+        mRenderSurfaceDescription.SetRenderScale(scale);
+        mPassUtilityProvider->DefaultRenderSurfaceDescription = mRenderSurfaceDescription;
+        mRenderDevice->SetDefaultRenderSurfaceDesc(mRenderSurfaceDescription);
+    }
+
     template <class ContentMediator>
     void RenderEngine<ContentMediator>::UpdateBackBuffers()
     {
@@ -91,6 +91,7 @@ namespace PathFinder
             inline const auto& AllResources() const { return mAllResources; }
             inline const auto& NodesToSyncWith() const { return mNodesToSyncWith; }
             inline auto GlobalExecutionIndex() const { return mGlobalExecutionIndex; }
+            inline auto IndexInUnorderedList() const { return mIndexInUnorderedList; }
             inline auto DependencyLevelIndex() const { return mDependencyLevelIndex; }
             inline auto LocalToDependencyLevelExecutionIndex() const { return mLocalToDependencyLevelExecutionIndex; }
             inline auto LocalToQueueExecutionIndex() const { return mLocalToQueueExecutionIndex; }
@@ -32,8 +32,8 @@ namespace PathFinder
         assert_format(RenderPassExecutionQueue{ GetPassNode().ExecutionQueueIndex } != RenderPassExecutionQueue::AsyncCompute,
             "Render Target Set command is unsupported on asynchronous compute queue");
 
-        const HAL::DSDescriptor* dsDescriptor = dsName ? mResourceStorage->GetDepthStencilDescriptor(*dsName, GetPassNode().PassMetadata().Name) : nullptr;
-        GetGraphicsCommandList()->SetRenderTarget(*mResourceStorage->GetRenderTargetDescriptor(rtName, GetPassNode().PassMetadata().Name), dsDescriptor);
+        const HAL::DSDescriptor* dsDescriptor = dsName ? mResourceStorage->GetDepthStencilDescriptor(*dsName, GetPassNode()) : nullptr;
+        GetGraphicsCommandList()->SetRenderTarget(*mResourceStorage->GetRenderTargetDescriptor(rtName, GetPassNode()), dsDescriptor);
     }
 
     void CommandRecorder::SetBackBufferAsRenderTarget(std::optional<Foundation::Name> dsName)
@@ -43,7 +43,7 @@ namespace PathFinder
 
         assert_format(GetPassNode().HasDependency(RenderPassGraph::Node::BackBufferName, 0), "Render pass has not scheduled writing to back buffer");
 
-        const HAL::DSDescriptor* dsDescriptor = dsName ? mResourceStorage->GetDepthStencilDescriptor(*dsName, GetPassNode().PassMetadata().Name) : nullptr;
+        const HAL::DSDescriptor* dsDescriptor = dsName ? mResourceStorage->GetDepthStencilDescriptor(*dsName, GetPassNode()) : nullptr;
         GetGraphicsCommandList()->SetRenderTarget(*mRenderDevice->BackBuffer()->GetRTDescriptor(), dsDescriptor);
     }
 
@@ -58,7 +58,7 @@ namespace PathFinder
         auto clearValue = std::get_if<HAL::ColorClearValue>(&renderTarget->Properties().OptimizedClearValue);
         assert_format(clearValue, "Texture does not contain optimized color clear value");
 
-        GetGraphicsCommandList()->ClearRenderTarget(*mResourceStorage->GetRenderTargetDescriptor(rtName, GetPassNode().PassMetadata().Name), *clearValue);
+        GetGraphicsCommandList()->ClearRenderTarget(*mResourceStorage->GetRenderTargetDescriptor(rtName, GetPassNode()), *clearValue);
     }
 
     void CommandRecorder::ClearDepth(Foundation::Name dsName)
@@ -72,7 +72,7 @@ namespace PathFinder
         auto clearValue = std::get_if<HAL::DepthStencilClearValue>(&depthAttachment->Properties().OptimizedClearValue);
         assert_format(clearValue, "Texture does not contain optimized depth/stencil clear value");
 
-        GetGraphicsCommandList()->CleadDepthStencil(*mResourceStorage->GetDepthStencilDescriptor(dsName, GetPassNode().PassMetadata().Name), clearValue->Depth);
+        GetGraphicsCommandList()->CleadDepthStencil(*mResourceStorage->GetDepthStencilDescriptor(dsName, GetPassNode()), clearValue->Depth);
     }
 
     void CommandRecorder::SetViewport(const HAL::Viewport& viewport)
@@ -105,13 +105,11 @@ namespace PathFinder
         HAL::GraphicsCommandList* cmdList = GetGraphicsCommandList();
         RenderDevice::PassHelpers& passHelpers = GetPassHelpers();
 
-        // Apply default viewport if none were provided by the render pass yet
+        // Apply default viewport if none were provided by the render pass yet.
+        // It only covers the part of render surface rendered at current render scale.
         if (!passHelpers.LastAppliedViewport)
         {
-            passHelpers.LastAppliedViewport = HAL::Viewport(
-                mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Width,
-                mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Height 
-            );
+            passHelpers.LastAppliedViewport = mRenderDevice->DefaultRenderSurfaceDesc().Viewport();
 
             cmdList->SetViewport(*passHelpers.LastAppliedViewport);
         }
@@ -122,8 +120,8 @@ namespace PathFinder
             passHelpers.LastAppliedScissor = Geometry::Rect2D{
                 {0, 0},
                 Geometry::Size2D(
-                    mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Width,
-                    mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Height)
+                    mRenderDevice->DefaultRenderSurfaceDesc().RenderDimensions().Width,
+                    mRenderDevice->DefaultRenderSurfaceDesc().RenderDimensions().Height)
             };
 
             cmdList->SetScissor(*passHelpers.LastAppliedScissor);
@@ -138,7 +136,6 @@ namespace PathFinder
         BindGraphicsPassRootConstantBuffer(cmdList);
         cmdList->Draw(vertexCount, 0);
 
-        passHelpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = true;
         passHelpers.ExecutedRenderCommandsCount++;
     }
 
@@ -160,7 +157,6 @@ namespace PathFinder
         BindComputePassRootConstantBuffer(cmdList);
         cmdList->Dispatch(groupCountX, groupCountY, groupCountZ);
 
-        passHelpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = true;
         passHelpers.ExecutedRenderCommandsCount++;
     }
 
@@ -190,7 +186,6 @@ namespace PathFinder
 
         BindComputePassRootConstantBuffer(cmdList);
         cmdList->DispatchRays(dispatchInfo);
-        passHelpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = true;
         passHelpers.ExecutedRenderCommandsCount++;
     }
 
@@ -229,8 +224,8 @@ namespace PathFinder
 
         cmdList->SetGraphicsRootDescriptorTable(samplerRangeAddress, 14 + commonParametersIndexOffset);
 
-        cmdList->SetGraphicsRootConstantBuffer(*mResourceStorage->GlobalRootConstantsBuffer()->HALBuffer(), 0 + commonParametersIndexOffset);
-        cmdList->SetGraphicsRootConstantBuffer(*mResourceStorage->PerFrameRootConstantsBuffer()->HALBuffer(), 1 + commonParametersIndexOffset);
+        cmdList->SetGraphicsRootConstantBuffer(mResourceStorage->GlobalRootConstantsAddress(), 0 + commonParametersIndexOffset);
+        cmdList->SetGraphicsRootConstantBuffer(mResourceStorage->PerFrameRootConstantsAddress(), 1 + commonParametersIndexOffset);
         cmdList->SetGraphicsRootUnorderedAccessResource(*passHelpers.ResourceStoragePassData->PassDebugBuffer->HALBuffer(), 15 + commonParametersIndexOffset);
     }
 
@@ -261,8 +256,8 @@ namespace PathFinder
 
         cmdList->SetComputeRootDescriptorTable(samplerRangeAddress, 14 + commonParametersIndexOffset);
 
-        cmdList->SetComputeRootConstantBuffer(*mResourceStorage->GlobalRootConstantsBuffer()->HALBuffer(), 0 + commonParametersIndexOffset);
-        cmdList->SetComputeRootConstantBuffer(*mResourceStorage->PerFrameRootConstantsBuffer()->HALBuffer(), 1 + commonParametersIndexOffset);
+        cmdList->SetComputeRootConstantBuffer(mResourceStorage->GlobalRootConstantsAddress(), 0 + commonParametersIndexOffset);
+        cmdList->SetComputeRootConstantBuffer(mResourceStorage->PerFrameRootConstantsAddress(), 1 + commonParametersIndexOffset);
         cmdList->SetComputeRootUnorderedAccessResource(*passHelpers.ResourceStoragePassData->PassDebugBuffer->HALBuffer(), 15 + commonParametersIndexOffset);
     }
 
@@ -273,17 +268,10 @@ namespace PathFinder
 
         auto commonParametersIndexOffset = passHelpers.LastSetRootSignature->ParameterCount() - mPipelineStateManager->CommonRootSignatureParameterCount();
 
-        if (!passHelpers.ResourceStoragePassData->PassConstantBuffer)
-        {
-            return;
-        }
-
-        HAL::GPUAddress address =
-            passHelpers.ResourceStoragePassData->PassConstantBuffer->HALBuffer()->GPUVirtualAddress() +
-            passHelpers.ResourceStoragePassData->PassConstantBufferMemoryOffset;
+        HAL::GPUAddress address = passHelpers.ResourceStoragePassData->PassConstantBufferAddress;
 
-        // Already bound
-        if (passHelpers.LastBoundRootConstantBufferAddress == address)
+        // Either no constants or already bound
+        if (address == 0 || passHelpers.LastBoundRootConstantBufferAddress == address)
         {
             return;
         }
@@ -299,17 +287,10 @@ namespace PathFinder
 
         auto commonParametersIndexOffset = passHelpers.LastSetRootSignature->ParameterCount() - mPipelineStateManager->CommonRootSignatureParameterCount();
 
-        if (!passHelpers.ResourceStoragePassData->PassConstantBuffer)
-        {
-            return;
-        }
-
-        HAL::GPUAddress address =
-            passHelpers.ResourceStoragePassData->PassConstantBuffer->HALBuffer()->GPUVirtualAddress() +
-            passHelpers.ResourceStoragePassData->PassConstantBufferMemoryOffset;
+        HAL::GPUAddress address = passHelpers.ResourceStoragePassData->PassConstantBufferAddress;
 
-        // Already bound
-        if (passHelpers.LastBoundRootConstantBufferAddress == address)
+        // Either no constants or already bound
+        if (address == 0 || passHelpers.LastBoundRootConstantBufferAddress == address)
         {
             return;
         }
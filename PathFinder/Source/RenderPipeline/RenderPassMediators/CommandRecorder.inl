@@ -39,13 +39,13 @@ namespace PathFinder
             "Render Target Set command is unsupported on asynchronous compute queue");
 
         HAL::GraphicsCommandList* cmdList = GetGraphicsCommandList();
-        const HAL::DSDescriptor* dsDescriptor = dsName ? mResourceStorage->GetDepthStencilDescriptor(*dsName, GetPassNode().PassMetadata().Name) : nullptr;
+        const HAL::DSDescriptor* dsDescriptor = dsName ? mResourceStorage->GetDepthStencilDescriptor(*dsName, GetPassNode()) : nullptr;
 
         std::array<const HAL::RTDescriptor*, RTCount> descriptors;
 
         for (auto i = 0; i < RTCount; ++i)
         {
-            descriptors[i] = mResourceStorage->GetRenderTargetDescriptor(rtNames[i], GetPassNode().PassMetadata().Name);
+            descriptors[i] = mResourceStorage->GetRenderTargetDescriptor(rtNames[i], GetPassNode());
         }
 
         cmdList->SetRenderTargets(descriptors, dsDescriptor);
@@ -12,11 +12,11 @@ namespace PathFinder
         assert_format(resourceObjects && resourceObjects->Buffer, "Buffer ", bufferName.ToString(), " does not exist");
 
         Foundation::Name passName = mPassGraph->Nodes()[mGraphNodeIndex].PassMetadata().Name;
-        const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceObjects->SchedulingInfo.GetInfoForPass(passName);
+        const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceObjects->SchedulingInfo.GetInfoForPass(mGraphNodeIndex);
 
-        assert_format(passInfo && passInfo->SubresourceInfos[0], "Buffer ", bufferName.ToString(), " was not scheduled for usage in ", passName.ToString());
+        assert_format(passInfo && resourceObjects->SchedulingInfo.GetSubresourceInfo(mGraphNodeIndex, 0), "Buffer ", bufferName.ToString(), " was not scheduled for usage in ", passName.ToString());
 
-        assert_format(passInfo->SubresourceInfos[0]->AccessValidationFlag == PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::BufferUA,
+        assert_format(resourceObjects->SchedulingInfo.GetSubresourceInfo(mGraphNodeIndex, 0)->AccessValidationFlag == PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::BufferUA,
             "Buffer ", bufferName.ToString(), " was not scheduled to be accessed as Unordered Access resource in ", passName.ToString());
 
         return resourceObjects->Buffer->GetUADescriptor()->IndexInHeapRange();
@@ -28,15 +28,15 @@ namespace PathFinder
         assert_format(resourceObjects && resourceObjects->Texture, "Texture ", textureName.ToString(), " does not exist");
 
         Foundation::Name passName = mPassGraph->Nodes()[mGraphNodeIndex].PassMetadata().Name;
-        const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceObjects->SchedulingInfo.GetInfoForPass(passName);
+        const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceObjects->SchedulingInfo.GetInfoForPass(mGraphNodeIndex);
 
-        assert_format(passInfo && passInfo->SubresourceInfos[mipLevel],
+        assert_format(passInfo && resourceObjects->SchedulingInfo.GetSubresourceInfo(mGraphNodeIndex, mipLevel),
             "Texture ",
             textureName.ToString(),
             " was not scheduled for usage in ",
             passName.ToString());
 
-        assert_format(passInfo->SubresourceInfos[mipLevel]->AccessValidationFlag == PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureUA,
+        assert_format(resourceObjects->SchedulingInfo.GetSubresourceInfo(mGraphNodeIndex, mipLevel)->AccessValidationFlag == PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureUA,
             "Texture ",
             textureName.ToString(),
             " was not scheduled to be accessed as Unordered Access resource in ",
@@ -53,15 +53,15 @@ namespace PathFinder
         Foundation::Name passName = mPassGraph->Nodes()[mGraphNodeIndex].PassMetadata().Name;
 
         // Mip level only used for sanity check. It doesn't alter SRV in any way in current implementation.
-        const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceObjects->SchedulingInfo.GetInfoForPass(passName);
+        const PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceObjects->SchedulingInfo.GetInfoForPass(mGraphNodeIndex);
 
-        assert_format(passInfo && passInfo->SubresourceInfos[mipLevel],
+        assert_format(passInfo && resourceObjects->SchedulingInfo.GetSubresourceInfo(mGraphNodeIndex, mipLevel),
             "Texture ",
             textureName.ToString(),
             " was not scheduled for usage in ",
             passName.ToString());
 
-        assert_format(passInfo->SubresourceInfos[mipLevel]->AccessValidationFlag == PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureSR,
+        assert_format(resourceObjects->SchedulingInfo.GetSubresourceInfo(mGraphNodeIndex, mipLevel)->AccessValidationFlag == PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureSR,
             "Texture ", 
             textureName.ToString(),
             " was not scheduled to be accessed as Shader Resource in ",
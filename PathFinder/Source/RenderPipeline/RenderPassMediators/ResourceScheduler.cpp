@@ -25,28 +25,15 @@ namespace PathFinder
         mResourceStorage->QueueResourceAllocationIfNeeded(
             resourceName, 
             HAL::TextureProperties{ format, *props.Kind, *props.Dimensions, *props.ClearValues, HAL::ResourceState::Common, *props.MipCount },
-            props.TextureToCopyPropertiesFrom,
+            props.TextureToCopyPropertiesFrom);
 
-            [canBeReadAcrossFrames,
-            passNode = mCurrentlySchedulingPassNode,
-            typelessFormat = props.TypelessFormat,
-            shaderVisibleFormat = props.ShaderVisibleFormat,
-            resourceName,
-            writtenMips,
-            this]
-            (PipelineResourceSchedulingInfo& schedulingInfo)
-            {
-                schedulingInfo.CanBeAliased = !canBeReadAcrossFrames && mResourceStorage->IsMemoryAliasingEnabled();
-                RegisterGraphDependency(*passNode, writtenMips, resourceName, {}, schedulingInfo.ResourceFormat().GetTextureProperties().MipCount, true);
-                UpdateSubresourceInfos(
-                    schedulingInfo,
-                    writtenMips,
-                    passNode->PassMetadata().Name,
-                    HAL::ResourceState::RenderTarget,
-                    PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureRT,
-                    typelessFormat ? shaderVisibleFormat : std::nullopt);
-            }
-        );
+        SchedulingRequest& request = mCreationRequests.emplace_back();
+        request.Kind = RequestKind::NewRenderTarget;
+        request.PassNode = mCurrentlySchedulingPassNode;
+        request.ResourceName = resourceName;
+        request.Mips = writtenMips;
+        request.ConcreteFormat = props.TypelessFormat ? props.ShaderVisibleFormat : std::nullopt;
+        request.CanBeReadAcrossFrames = canBeReadAcrossFrames;
     }
 
     void ResourceScheduler::NewDepthStencil(Foundation::Name resourceName, std::optional<NewDepthStencilProperties> properties)
@@ -58,25 +45,14 @@ namespace PathFinder
         mResourceStorage->QueueResourceAllocationIfNeeded(
             resourceName,
             HAL::TextureProperties{ *props.Format, HAL::TextureKind::Texture2D, *props.Dimensions, clearValue, HAL::ResourceState::Common, *props.MipCount },
-            props.TextureToCopyPropertiesFrom,
+            props.TextureToCopyPropertiesFrom);
 
-            [canBeReadAcrossFrames,
-            passNode = mCurrentlySchedulingPassNode,
-            resourceName,
-            this]
-            (PipelineResourceSchedulingInfo& schedulingInfo)
-            {
-                schedulingInfo.CanBeAliased = !canBeReadAcrossFrames && mResourceStorage->IsMemoryAliasingEnabled();
-                RegisterGraphDependency(*passNode, MipSet::FirstMip(), resourceName, {}, schedulingInfo.ResourceFormat().GetTextureProperties().MipCount, true);
-                UpdateSubresourceInfos(
-                    schedulingInfo,
-                    MipSet::FirstMip(),
-                    passNode->PassMetadata().Name,
-                    HAL::ResourceState::DepthWrite,
-                    PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureDS,
-                    std::nullopt);
-            }
-        );
+        SchedulingRequest& request = mCreationRequests.emplace_back();
+        request.Kind = RequestKind::NewDepthStencil;
+        request.PassNode = mCurrentlySchedulingPassNode;
+        request.ResourceName = resourceName;
+        request.Mips = MipSet::FirstMip();
+        request.CanBeReadAcrossFrames = canBeReadAcrossFrames;
     }
 
     void ResourceScheduler::NewTexture(Foundation::Name resourceName, std::optional<NewTextureProperties> properties)
@@ -95,28 +71,15 @@ namespace PathFinder
         mResourceStorage->QueueResourceAllocationIfNeeded(
             resourceName,
             HAL::TextureProperties{ format, *props.Kind, *props.Dimensions, *props.ClearValues, HAL::ResourceState::Common, *props.MipCount },
-            props.TextureToCopyPropertiesFrom,
+            props.TextureToCopyPropertiesFrom);
 
-            [canBeReadAcrossFrames,
-            passNode = mCurrentlySchedulingPassNode,
-            typelessFormat = props.TypelessFormat,
-            shaderVisibleFormat = props.ShaderVisibleFormat,
-            resourceName,
-            writtenMips,
-            this]
-            (PipelineResourceSchedulingInfo& schedulingInfo)
-            {
-                schedulingInfo.CanBeAliased = !canBeReadAcrossFrames && mResourceStorage->IsMemoryAliasingEnabled();
-                RegisterGraphDependency(*passNode, writtenMips, resourceName, {}, schedulingInfo.ResourceFormat().GetTextureProperties().MipCount, true);
-                UpdateSubresourceInfos(
-                    schedulingInfo,
-                    writtenMips,
-                    passNode->PassMetadata().Name,
-                    HAL::ResourceState::UnorderedAccess,
-                    PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureUA,
-                    typelessFormat ? shaderVisibleFormat : std::nullopt);
-            }
-        );
+        SchedulingRequest& request = mCreationRequests.emplace_back();
+        request.Kind = RequestKind::NewTexture;
+        request.PassNode = mCurrentlySchedulingPassNode;
+        request.ResourceName = resourceName;
+        request.Mips = writtenMips;
+        request.ConcreteFormat = props.TypelessFormat ? props.ShaderVisibleFormat : std::nullopt;
+        request.CanBeReadAcrossFrames = canBeReadAcrossFrames;
     }
 
     void ResourceScheduler::UseRenderTarget(Foundation::Name resourceName, const MipSet& writtenMips, std::optional<HAL::ColorFormat> concreteFormat)
@@ -126,30 +89,7 @@ namespace PathFinder
 
     void ResourceScheduler::AliasAndUseRenderTarget(Foundation::Name resourceName, Foundation::Name outputAliasName, const MipSet& writtenMips, std::optional<HAL::ColorFormat> concreteFormat)
     {
-        mResourceStorage->QueueResourceUsage(resourceName, outputAliasName.IsValid() ? std::optional(outputAliasName) : std::nullopt,
-
-            [passNode = mCurrentlySchedulingPassNode,
-            concreteFormat,
-            writtenMips,
-            resourceName,
-            outputAliasName,
-            this]
-            (PipelineResourceSchedulingInfo& schedulingInfo)
-        {
-            bool isTypeless = std::holds_alternative<HAL::TypelessColorFormat>(schedulingInfo.ResourceFormat().GetTextureProperties().Format);
-
-            assert_format(concreteFormat || !isTypeless, "Redefinition of Render target format is not allowed");
-            assert_format(!concreteFormat || isTypeless, "Render target is typeless and concrete color format was not provided");
-
-            RegisterGraphDependency(*passNode, writtenMips, resourceName, outputAliasName, schedulingInfo.ResourceFormat().GetTextureProperties().MipCount, true);
-            UpdateSubresourceInfos(
-                schedulingInfo,
-                writtenMips,
-                passNode->PassMetadata().Name,
-                HAL::ResourceState::RenderTarget,
-                PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureRT,
-                isTypeless ? concreteFormat : std::nullopt);
-        });
+        QueueUsageRequest(RequestKind::UseRenderTarget, resourceName, outputAliasName, writtenMips, concreteFormat);
     }
 
     void ResourceScheduler::UseDepthStencil(Foundation::Name resourceName)
@@ -159,56 +99,12 @@ namespace PathFinder
 
     void ResourceScheduler::AliasAndUseDepthStencil(Foundation::Name resourceName, Foundation::Name outputAliasName)
     {
-        mResourceStorage->QueueResourceUsage(resourceName, outputAliasName.IsValid() ? std::optional(outputAliasName) : std::nullopt, 
-
-            [passNode = mCurrentlySchedulingPassNode,
-            resourceName,
-            outputAliasName,
-            this]
-            (PipelineResourceSchedulingInfo& schedulingInfo)
-        {
-            assert_format(std::holds_alternative<HAL::DepthStencilFormat>(schedulingInfo.ResourceFormat().GetTextureProperties().Format), "Cannot reuse non-depth-stencil texture");
-
-            RegisterGraphDependency(*passNode, MipSet::FirstMip(), resourceName, outputAliasName, schedulingInfo.ResourceFormat().GetTextureProperties().MipCount, true);
-            UpdateSubresourceInfos(
-                schedulingInfo,
-                MipSet::FirstMip(),
-                passNode->PassMetadata().Name,
-                HAL::ResourceState::DepthWrite,
-                PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureDS,
-                std::nullopt);
-        });
+        QueueUsageRequest(RequestKind::UseDepthStencil, resourceName, outputAliasName, MipSet::FirstMip(), std::nullopt);
     }
 
     void ResourceScheduler::ReadTexture(Foundation::Name resourceName, const MipSet& readMips, std::optional<HAL::ColorFormat> concreteFormat)
     {
-        mResourceStorage->QueueResourceUsage(resourceName, {},
-            [passNode = mCurrentlySchedulingPassNode, 
-            readMips,
-            concreteFormat,
-            resourceName,
-            this]
-            (PipelineResourceSchedulingInfo& schedulingInfo)
-        {
-            bool isTypeless = std::holds_alternative<HAL::TypelessColorFormat>(schedulingInfo.ResourceFormat().GetTextureProperties().Format);
-            assert_format(concreteFormat || !isTypeless, "Redefinition of texture format is not allowed");
-
-            HAL::ResourceState state = HAL::ResourceState::AnyShaderAccess;
-
-            if (std::holds_alternative<HAL::DepthStencilFormat>(schedulingInfo.ResourceFormat().GetTextureProperties().Format))
-            {
-                state |= HAL::ResourceState::DepthRead;
-            }
-
-            RegisterGraphDependency(*passNode, readMips, resourceName, {}, schedulingInfo.ResourceFormat().GetTextureProperties().MipCount, false);
-            UpdateSubresourceInfos(
-                schedulingInfo,
-                readMips,
-                passNode->PassMetadata().Name,
-                state,
-                PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureSR,
-                std::nullopt);
-        });
+        QueueUsageRequest(RequestKind::ReadTexture, resourceName, {}, readMips, concreteFormat);
     }
 
     void ResourceScheduler::WriteTexture(Foundation::Name resourceName, const MipSet& writtenMips, std::optional<HAL::ColorFormat> concreteFormat)
@@ -218,30 +114,7 @@ namespace PathFinder
 
     void ResourceScheduler::AliasAndWriteTexture(Foundation::Name resourceName, Foundation::Name outputAliasName, const MipSet& writtenMips, std::optional<HAL::ColorFormat> concreteFormat)
     {
-        mResourceStorage->QueueResourceUsage(resourceName, outputAliasName.IsValid() ? std::optional(outputAliasName) : std::nullopt, 
-
-            [passNode = mCurrentlySchedulingPassNode,
-            concreteFormat,
-            resourceName,
-            outputAliasName,
-            writtenMips,
-            this]
-            (PipelineResourceSchedulingInfo& schedulingInfo)
-        {
-            bool isTypeless = std::holds_alternative<HAL::TypelessColorFormat>(schedulingInfo.ResourceFormat().GetTextureProperties().Format);
-
-            assert_format(concreteFormat || !isTypeless, "Redefinition of texture format is not allowed");
-            assert_format(!concreteFormat || isTypeless, "Texture is typeless and concrete color format was not provided");
-
-            RegisterGraphDependency(*passNode, writtenMips, resourceName, outputAliasName, schedulingInfo.ResourceFormat().GetTextureProperties().MipCount, true);
-            UpdateSubresourceInfos(
-                schedulingInfo,
-                writtenMips,
-                passNode->PassMetadata().Name,
-                HAL::ResourceState::UnorderedAccess,
-                PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::TextureUA,
-                isTypeless ? concreteFormat : std::nullopt);
-        });
+        QueueUsageRequest(RequestKind::WriteTexture, resourceName, outputAliasName, writtenMips, concreteFormat);
     }
 
     void ResourceScheduler::ReadBuffer(Foundation::Name resourceName, BufferReadContext readContext)
@@ -276,12 +149,10 @@ namespace PathFinder
 
     void ResourceScheduler::Export(Foundation::Name resourceName)
     {
-        mResourceStorage->QueueResourceReadback(resourceName, [resourceName, node = mCurrentlySchedulingPassNode](PipelineResourceSchedulingInfo& schedulingInfo)
-        {
-            PipelineResourceSchedulingInfo::PassInfo* passInfo = schedulingInfo.GetInfoForPass(node->PassMetadata().Name);
-            assert_format(passInfo, "Resource ", resourceName.ToString(), " wasn't scheduled for usage in ", node->PassMetadata().Name.ToString());
-            passInfo->IsReadbackRequested = true;
-        });
+        SchedulingRequest& request = mReadbackRequests.emplace_back();
+        request.Kind = RequestKind::Export;
+        request.PassNode = mCurrentlySchedulingPassNode;
+        request.ResourceName = resourceName;
     }
 
     void ResourceScheduler::SetCurrentlySchedulingPassNode(RenderPassGraph::Node* node)
@@ -289,8 +160,134 @@ namespace PathFinder
         mCurrentlySchedulingPassNode = node;
     }
 
+    void ResourceScheduler::BeginScheduling()
+    {
+        mCreationRequests.clear();
+        mUsageRequests.clear();
+        mReadbackRequests.clear();
+        mResourceStorage->StartResourceScheduling();
+    }
+
+    void ResourceScheduler::EndScheduling()
+    {
+        // Creates resource data so that requests can be applied to it
+        mResourceStorage->EndResourceScheduling();
+
+        for (const std::vector<SchedulingRequest>* requests : { &mCreationRequests, &mUsageRequests, &mReadbackRequests })
+        {
+            for (const SchedulingRequest& request : *requests)
+            {
+                ApplyRequest(request);
+            }
+        }
+    }
+
+    void ResourceScheduler::QueueUsageRequest(RequestKind kind, Foundation::Name resourceName, Foundation::Name outputAliasName, const MipSet& mips, std::optional<HAL::ColorFormat> concreteFormat)
+    {
+        if (outputAliasName.IsValid())
+        {
+            mResourceStorage->QueueResourceAlias(resourceName, outputAliasName);
+        }
+
+        SchedulingRequest& request = mUsageRequests.emplace_back();
+        request.Kind = kind;
+        request.PassNode = mCurrentlySchedulingPassNode;
+        request.ResourceName = resourceName;
+        request.OutputAliasName = outputAliasName;
+        request.Mips = mips;
+        request.ConcreteFormat = concreteFormat;
+    }
+
+    void ResourceScheduler::ApplyRequest(const SchedulingRequest& request)
+    {
+        using AccessFlag = PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag;
+
+        PipelineResourceStorageResource* resourceData = mResourceStorage->GetPerResourceData(request.ResourceName);
+        assert_format(resourceData, "Trying to use a resource that wasn't created: ", request.ResourceName.ToString());
+
+        PipelineResourceSchedulingInfo& schedulingInfo = resourceData->SchedulingInfo;
+        RenderPassGraph::Node& passNode = *request.PassNode;
+        uint64_t passIndex = passNode.IndexInUnorderedList();
+
+        if (request.Kind == RequestKind::Export)
+        {
+            PipelineResourceSchedulingInfo::PassInfo* passInfo = schedulingInfo.GetInfoForPass(passIndex);
+            assert_format(passInfo, "Resource ", request.ResourceName.ToString(), " wasn't scheduled for usage in ", passNode.PassMetadata().Name.ToString());
+            passInfo->IsReadbackRequested = true;
+            return;
+        }
+
+        if (request.Kind == RequestKind::NewBuffer)
+        {
+            schedulingInfo.CanBeAliased = !request.CanBeReadAcrossFrames && mResourceStorage->IsMemoryAliasingEnabled();
+            RegisterGraphDependency(passNode, request.Mips, request.ResourceName, {}, 1, true);
+            schedulingInfo.SetSubresourceInfo(passIndex, 0, HAL::ResourceState::UnorderedAccess, AccessFlag::BufferUA, std::nullopt);
+            return;
+        }
+
+        const HAL::TextureProperties& textureProperties = schedulingInfo.ResourceFormat().GetTextureProperties();
+        bool isTypeless = std::holds_alternative<HAL::TypelessColorFormat>(textureProperties.Format);
+        bool isDepthStencil = std::holds_alternative<HAL::DepthStencilFormat>(textureProperties.Format);
+
+        HAL::ResourceState state = HAL::ResourceState::Common;
+        AccessFlag accessFlag = AccessFlag::TextureSR;
+        std::optional<HAL::ColorFormat> shaderVisibleFormat = std::nullopt;
+        bool isWriteDependency = true;
+
+        switch (request.Kind)
+        {
+        case RequestKind::NewRenderTarget:
+        case RequestKind::NewDepthStencil:
+        case RequestKind::NewTexture:
+            schedulingInfo.CanBeAliased = !request.CanBeReadAcrossFrames && mResourceStorage->IsMemoryAliasingEnabled();
+            shaderVisibleFormat = request.ConcreteFormat;
+            state = request.Kind == RequestKind::NewRenderTarget ? HAL::ResourceState::RenderTarget : 
+                request.Kind == RequestKind::NewDepthStencil ? HAL::ResourceState::DepthWrite : HAL::ResourceState::UnorderedAccess;
+            accessFlag = request.Kind == RequestKind::NewRenderTarget ? AccessFlag::TextureRT : 
+                request.Kind == RequestKind::NewDepthStencil ? AccessFlag::TextureDS : AccessFlag::TextureUA;
+            break;
+
+        case RequestKind::UseRenderTarget:
+            assert_format(request.ConcreteFormat || !isTypeless, "Redefinition of Render target format is not allowed");
+            assert_format(!request.ConcreteFormat || isTypeless, "Render target is typeless and concrete color format was not provided");
+            state = HAL::ResourceState::RenderTarget;
+            accessFlag = AccessFlag::TextureRT;
+            shaderVisibleFormat = isTypeless ? request.ConcreteFormat : std::nullopt;
+            break;
+
+        case RequestKind::UseDepthStencil:
+            assert_format(isDepthStencil, "Cannot reuse non-depth-stencil texture");
+            state = HAL::ResourceState::DepthWrite;
+            accessFlag = AccessFlag::TextureDS;
+            break;
+
+        case RequestKind::ReadTexture:
+            assert_format(request.ConcreteFormat || !isTypeless, "Redefinition of texture format is not allowed");
+            state = isDepthStencil ? HAL::ResourceState::AnyShaderAccess | HAL::ResourceState::DepthRead : HAL::ResourceState::AnyShaderAccess;
+            accessFlag = AccessFlag::TextureSR;
+            isWriteDependency = false;
+            break;
+
+        case RequestKind::WriteTexture:
+            assert_format(request.ConcreteFormat || !isTypeless, "Redefinition of texture format is not allowed");
+            assert_format(!request.ConcreteFormat || isTypeless, "Texture is typeless and concrete color format was not provided");
+            state = HAL::ResourceState::UnorderedAccess;
+            accessFlag = AccessFlag::TextureUA;
+            shaderVisibleFormat = isTypeless ? request.ConcreteFormat : std::nullopt;
+            break;
+
+        default:
+            break;
+        }
+
+        RegisterGraphDependency(passNode, request.Mips, request.ResourceName, request.OutputAliasName, textureProperties.MipCount, isWriteDependency);
+        UpdateSubresourceInfos(schedulingInfo, request.Mips, passIndex, state, accessFlag, shaderVisibleFormat);
+    }
+
     ResourceScheduler::NewTextureProperties ResourceScheduler::FillMissingFields(std::optional<NewTextureProperties> properties) const
     {
+        // Default textures always get full surface dimensions regardless of render scale,
+        // so scale changes never invalidate scheduled resources
         NewTextureProperties filledProperties{
             mUtilityProvider->DefaultRenderSurfaceDescription.RenderTargetFormat(),
             HAL::TextureKind::Texture2D,
@@ -403,7 +400,7 @@ namespace PathFinder
     void ResourceScheduler::UpdateSubresourceInfos(
         PipelineResourceSchedulingInfo& resourceShcedulingInfo, 
         const MipSet& mips,
-        Foundation::Name passName,
+        uint64_t passIndex,
         HAL::ResourceState state, 
         PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag accessFlag,
         std::optional<HAL::ColorFormat> concreteFormat)
@@ -420,7 +417,7 @@ namespace PathFinder
         {
             for (uint32_t mip : *explicitMipList)
             {
-                resourceShcedulingInfo.SetSubresourceInfo(passName, mip, state, accessFlag, concreteFormat);
+                resourceShcedulingInfo.SetSubresourceInfo(passIndex, mip, state, accessFlag, concreteFormat);
             }
 
             return;
@@ -443,7 +440,7 @@ namespace PathFinder
 
         for (auto mip = firstMip; mip <= lastMip; ++mip)
         {
-            resourceShcedulingInfo.SetSubresourceInfo(passName, mip, state, accessFlag, concreteFormat);
+            resourceShcedulingInfo.SetSubresourceInfo(passIndex, mip, state, accessFlag, concreteFormat);
         }
     }
 
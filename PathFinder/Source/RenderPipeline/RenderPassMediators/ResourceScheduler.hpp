@@ -209,8 +209,33 @@ namespace PathFinder
 
         // To be called by the engine, not render passes
         void SetCurrentlySchedulingPassNode(RenderPassGraph::Node* node);
+        void BeginScheduling();
+        void EndScheduling();
 
     private:
+        enum class RequestKind : uint8_t
+        {
+            NewRenderTarget, NewDepthStencil, NewTexture, NewBuffer,
+            UseRenderTarget, UseDepthStencil, ReadTexture, WriteTexture, Export
+        };
+
+        // Requests are plain data that is applied to scheduling infos once every resource of a frame is created.
+        // They are kept in vectors that retain capacity between frames, so scheduling doesn't allocate
+        // in a steady state, except for explicit mip lists.
+        struct SchedulingRequest
+        {
+            RequestKind Kind = RequestKind::ReadTexture;
+            RenderPassGraph::Node* PassNode = nullptr;
+            Foundation::Name ResourceName;
+            Foundation::Name OutputAliasName;
+            MipSet Mips;
+            std::optional<HAL::ColorFormat> ConcreteFormat;
+            bool CanBeReadAcrossFrames = false;
+        };
+
+        void QueueUsageRequest(RequestKind kind, Foundation::Name resourceName, Foundation::Name outputAliasName, const MipSet& mips, std::optional<HAL::ColorFormat> concreteFormat);
+        void ApplyRequest(const SchedulingRequest& request);
+
         NewTextureProperties FillMissingFields(std::optional<NewTextureProperties> properties) const;
         NewDepthStencilProperties FillMissingFields(std::optional<NewDepthStencilProperties> properties) const;
         uint32_t MaxMipCount(const Geometry::Dimensions& dimensions) const;
@@ -226,7 +251,7 @@ namespace PathFinder
         void UpdateSubresourceInfos(
             PipelineResourceSchedulingInfo& resourceShcedulingInfo,
             const MipSet& mips,
-            Foundation::Name passName,
+            uint64_t passIndex,
             HAL::ResourceState state, 
             PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag accessFlag,
             std::optional<HAL::ColorFormat> concreteFormat);
@@ -239,6 +264,11 @@ namespace PathFinder
         RenderPassUtilityProvider* mUtilityProvider = nullptr;
         RenderPassGraph* mRenderPassGraph = nullptr;
 
+        // Applied in this order: resources have to be created before they are used or read back
+        std::vector<SchedulingRequest> mCreationRequests;
+        std::vector<SchedulingRequest> mUsageRequests;
+        std::vector<SchedulingRequest> mReadbackRequests;
+
     public:
         inline const RenderSurfaceDescription& DefaultRenderSurfaceDesc() const { return mUtilityProvider->DefaultRenderSurfaceDescription; }
         inline auto FrameNumber() const { return mUtilityProvider->FrameNumber; }
@@ -9,22 +9,14 @@ namespace PathFinder
         mResourceStorage->QueueResourceAllocationIfNeeded(
             resourceName,
             HAL::BufferProperties::Create<T>(bufferProperties.Capacity, bufferProperties.PerElementAlignment),
-            bufferProperties.BufferToCopyPropertiesFrom,
-
-            [this, resourceName, canBeReadAcrossFrames, node = mCurrentlySchedulingPassNode](PipelineResourceSchedulingInfo& schedulingInfo)
-            {
-                RegisterGraphDependency(*node, MipSet::FirstMip(), resourceName, {}, 1, true);
-
-                schedulingInfo.SetSubresourceInfo(
-                    node->PassMetadata().Name,
-                    0, 
-                    HAL::ResourceState::UnorderedAccess,
-                    PipelineResourceSchedulingInfo::SubresourceInfo::AccessFlag::BufferUA,
-                    std::nullopt);
-
-                schedulingInfo.CanBeAliased = !canBeReadAcrossFrames && mResourceStorage->IsMemoryAliasingEnabled();
-            }
-        );
+            bufferProperties.BufferToCopyPropertiesFrom);
+
+        SchedulingRequest& request = mCreationRequests.emplace_back();
+        request.Kind = RequestKind::NewBuffer;
+        request.PassNode = mCurrentlySchedulingPassNode;
+        request.ResourceName = resourceName;
+        request.Mips = MipSet::FirstMip();
+        request.CanBeReadAcrossFrames = canBeReadAcrossFrames;
     }
 
     template <class Lambda>
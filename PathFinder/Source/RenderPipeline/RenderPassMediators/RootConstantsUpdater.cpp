@@ -6,4 +6,9 @@ namespace PathFinder
     RootConstantsUpdater::RootConstantsUpdater(PipelineResourceStorage* storage, const RenderPassGraph* passGraph, uint64_t graphNodeIndex)
         : mResourceStorage{ storage }, mPassGraph{ passGraph }, mGraphNodeIndex{ graphNodeIndex } {}
 
+    void RootConstantsUpdater::UpdateRootConstantBuffer(const void* data, uint64_t sizeInBytes)
+    {
+        mResourceStorage->UpdatePassRootConstants(data, sizeInBytes, mPassGraph->Nodes()[mGraphNodeIndex]);
+    }
+
 }
@@ -16,6 +16,9 @@ namespace PathFinder
         template <class RootCBufferContent>
         void UpdateRootConstantBuffer(const RootCBufferContent& data);
 
+        /// Variable sized version for data which layout is only known at runtime, up to 64 KB
+        void UpdateRootConstantBuffer(const void* data, uint64_t sizeInBytes);
+
     private:
         PipelineResourceStorage* mResourceStorage;
         const RenderPassGraph* mPassGraph;
@@ -51,7 +51,7 @@ namespace PathFinder
         const auto& defaultRenderSurfaceDesc = context->GetDefaultRenderSurfaceDesc();
         
         auto resourceProvider = context->GetResourceProvider();
-        auto dimensions = resourceProvider->GetTextureProperties(ResourceNames::CombinedShadingOversaturated).MipSize(mipLevel);
+        auto dimensions = defaultRenderSurfaceDesc.RenderDimensions(resourceProvider->GetTextureProperties(ResourceNames::CombinedShadingOversaturated).MipSize(mipLevel));
 
         SeparableBlurCBContent blurInputs{};
 
@@ -41,7 +41,7 @@ namespace PathFinder
         inputs.LargeBloomWeight = parameters.LargeBloomWeight;
 
         context->GetConstantsUpdater()->UpdateRootConstantBuffer(inputs);
-        context->GetCommandRecorder()->Dispatch(dimensions, { 16, 16 });
+        context->GetCommandRecorder()->Dispatch(context->GetDefaultRenderSurfaceDesc().RenderDimensions(), { 16, 16 });
     }
 
 }
@@ -53,7 +53,8 @@ namespace PathFinder
 
         context->GetCommandRecorder()->ApplyPipelineState(PSONames::DenoiserForwardProjection);
 
-        auto groupCount = CommandRecorder::DispatchGroupCount(resourceProvider->GetTextureProperties(ResourceNames::DenoiserPrimaryGradientInputs).Dimensions, { 16, 16 });
+        const Geometry::Dimensions& gradientDimensions = resourceProvider->GetTextureProperties(ResourceNames::DenoiserPrimaryGradientInputs).Dimensions;
+        auto groupCount = CommandRecorder::DispatchGroupCount(context->GetDefaultRenderSurfaceDesc().RenderDimensions(gradientDimensions), { 16, 16 });
 
         DenoiserForwardProjectionCBContent cbContent{};
         cbContent.DispatchGroupCount = { groupCount.Width, groupCount.Height };
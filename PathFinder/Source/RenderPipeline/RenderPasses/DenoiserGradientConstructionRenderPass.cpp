@@ -43,7 +43,8 @@ namespace PathFinder
         cbContent.UnshadowedShadingTexIdx = resourceProvider->GetSRTextureIndex(ResourceNames::StochasticUnshadowedShadingPreBlurred);
         cbContent.GradientTexIdx = resourceProvider->GetUATextureIndex(ResourceNames::DenoiserPrimaryGradient);
 
-        const Geometry::Dimensions& outputDimensions = resourceProvider->GetTextureProperties(ResourceNames::DenoiserPrimaryGradient).Dimensions;
+        Geometry::Dimensions outputDimensions = context->GetDefaultRenderSurfaceDesc().RenderDimensions(
+            resourceProvider->GetTextureProperties(ResourceNames::DenoiserPrimaryGradient).Dimensions);
 
         context->GetConstantsUpdater()->UpdateRootConstantBuffer(cbContent);
         context->GetCommandRecorder()->Dispatch(outputDimensions, { 16, 16 });
@@ -29,7 +29,9 @@ namespace PathFinder
 
         auto resourceProvider = context->GetResourceProvider();
 
-        const Geometry::Dimensions& outputDimensions = resourceProvider->GetTextureProperties(ResourceNames::DenoiserPrimaryGradientFiltered).Dimensions;
+        // Filter must not pick up gradients outside of rendered region
+        Geometry::Dimensions outputDimensions = context->GetDefaultRenderSurfaceDesc().RenderDimensions(
+            resourceProvider->GetTextureProperties(ResourceNames::DenoiserPrimaryGradientFiltered).Dimensions);
         auto inputTexIdx = resourceProvider->GetUATextureIndex(ResourceNames::DenoiserPrimaryGradientFilteredIntermediate);
         auto outputTexIdx = resourceProvider->GetUATextureIndex(ResourceNames::DenoiserPrimaryGradientFiltered);
 
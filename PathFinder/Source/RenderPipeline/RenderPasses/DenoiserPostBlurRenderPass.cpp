@@ -47,7 +47,7 @@ namespace PathFinder
         auto previousFrameIndex = (context->FrameNumber() - 1) % 2;
         auto frameIndex = context->FrameNumber() % 2;
 
-        auto groupCount = CommandRecorder::DispatchGroupCount(context->GetDefaultRenderSurfaceDesc().Dimensions(), { 16, 16 });
+        auto groupCount = CommandRecorder::DispatchGroupCount(context->GetDefaultRenderSurfaceDesc().RenderDimensions(), { 16, 16 });
 
         const RenderSettings* settings = context->GetContent()->GetSettings();
 
@@ -38,7 +38,8 @@ namespace PathFinder
     {
         auto resourceProvider = context->GetResourceProvider();
 
-        Geometry::Dimensions dispatchDimensions = resourceProvider->GetTextureProperties(inputName).Dimensions;
+        // Blur is clamped to rendered region through image size
+        Geometry::Dimensions dispatchDimensions = context->GetDefaultRenderSurfaceDesc().RenderDimensions(resourceProvider->GetTextureProperties(inputName).Dimensions);
 
         SeparableBlurCBContent cbContent{};
         cbContent.BlurRadius = context->GetContent()->GetSettings()->IsDenoiserEnabled ? 2 : 0;
@@ -51,7 +51,7 @@ namespace PathFinder
         auto previousFrameIndex = (context->FrameNumber() - 1) % 2;
         auto frameIndex = context->FrameNumber() % 2;
 
-        auto groupCount = CommandRecorder::DispatchGroupCount(context->GetDefaultRenderSurfaceDesc().Dimensions(), { 16, 16 });
+        auto groupCount = CommandRecorder::DispatchGroupCount(context->GetDefaultRenderSurfaceDesc().RenderDimensions(), { 16, 16 });
 
         DenoiserReprojectionCBContent cbContent{};
         cbContent.DispatchGroupCount = { groupCount.Width, groupCount.Height };
@@ -31,9 +31,13 @@ namespace PathFinder
 
         for (DownsamplingInvocationInputs& inputs : mInvocationInputs)
         {
+            // Downsampled textures have surface dimensions and only their rendered part needs mips.
+            // Texel size stays that of full mips, so UVs computed in shader still address full textures.
+            Geometry::Dimensions dispatchDimensions = context->GetDefaultRenderSurfaceDesc().RenderDimensions(inputs.DispatchDimensions);
+
             UpdateDownsamplingInputsWithTextureIndices(inputs, context->GetResourceProvider());
             context->GetConstantsUpdater()->UpdateRootConstantBuffer(inputs.CBContent);
-            context->GetCommandRecorder()->Dispatch(inputs.DispatchDimensions, { 8, 8 });
+            context->GetCommandRecorder()->Dispatch(dispatchDimensions, { 8, 8 });
         }
     }
 
@@ -124,7 +124,7 @@ namespace PathFinder
         for (const MeshInstance& instance : instances)
         {
             context->GetCommandRecorder()->SetRootConstants(instance.IndexInGPUTable(), 0, 0);
-            context->GetCommandRecorder()->Draw(instance.AssociatedMesh()->LocationInVertexStorage().IndexCount);
+            context->GetCommandRecorder()->Draw(instance.AssociatedMesh()->LocationInVertexStorage().IndexCountForLOD(instance.LODIndex()));
         }
     }
 
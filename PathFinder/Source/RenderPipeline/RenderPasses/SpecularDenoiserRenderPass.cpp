@@ -49,7 +49,7 @@ namespace PathFinder
         auto resourceProvider = context->GetResourceProvider();
         auto currentFrameIndex = context->FrameNumber() % 2;
 
-        auto groupCount = CommandRecorder::DispatchGroupCount(context->GetDefaultRenderSurfaceDesc().Dimensions(), { 16, 16 });
+        auto groupCount = CommandRecorder::DispatchGroupCount(context->GetDefaultRenderSurfaceDesc().RenderDimensions(), { 16, 16 });
 
         const RenderSettings* settings = context->GetContent()->GetSettings();
 
@@ -49,8 +49,7 @@ namespace PathFinder
         context->GetCommandRecorder()->BindBuffer(ResourceNames::LuminanceHistogram, 0, 0, HAL::ShaderRegister::UnorderedAccess);
         context->GetConstantsUpdater()->UpdateRootConstantBuffer(cbContent);
 
-        auto dimensions = context->GetDefaultRenderSurfaceDesc().DispatchDimensionsForGroupSize(16, 16);
-        context->GetCommandRecorder()->Dispatch(dimensions.x, dimensions.y);
+        context->GetCommandRecorder()->Dispatch(context->GetDefaultRenderSurfaceDesc().RenderDimensions(), { 16, 16 });
     }
 
 }
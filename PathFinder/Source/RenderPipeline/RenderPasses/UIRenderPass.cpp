@@ -56,14 +56,19 @@ namespace PathFinder
 
         context->GetConstantsUpdater()->UpdateRootConstantBuffer(cbContent);
 
+        float renderScale = context->GetDefaultRenderSurfaceDesc().RenderScale();
+
         for (const UIGPUStorage::DrawCommand& drawCommand : context->GetContent()->GetUIGPUStorage()->DrawCommands())
         {
             UIRootConstants offsets;
             offsets.VertexBufferOffset = drawCommand.VertexBufferOffset;
             offsets.IndexBufferOffset = drawCommand.IndexBufferOffset;
 
+            // UI is rendered together with the scene and upscaled in back buffer output
+            Geometry::Rect2D scissor{ drawCommand.ScissorRect.Origin * renderScale, drawCommand.ScissorRect.Size.TransformedBy(glm::vec2{ renderScale }) };
+
             context->GetCommandRecorder()->SetRootConstants(offsets, 0, 0);
-            context->GetCommandRecorder()->SetScissor(drawCommand.ScissorRect);
+            context->GetCommandRecorder()->SetScissor(scissor);
             context->GetCommandRecorder()->Draw(drawCommand.IndexCount);
         }
     }
@@ -1,15 +1,36 @@
 #include "RenderSurfaceDescription.hpp"
 
+#include <algorithm>
+
 namespace PathFinder
 {
 
     RenderSurfaceDescription::RenderSurfaceDescription(const Geometry::Dimensions& dimensions, HAL::ColorFormat rtFormat, HAL::DepthStencilFormat dsFormat)
-        : mDimensions(dimensions), mRTFormat(rtFormat), mDSFormat(dsFormat) {}
+        : mDimensions(dimensions), mRenderDimensions(dimensions), mPreviousRenderDimensions(dimensions), mRTFormat(rtFormat), mDSFormat(dsFormat) {}
+
+    void RenderSurfaceDescription::SetRenderScale(float scale)
+    {
+        assert_format(scale > 0.0f && scale <= 1.0f, "Render scale must be in (0; 1] range");
+
+        mRenderScale = scale;
+        mPreviousRenderDimensions = mRenderDimensions;
+        mRenderDimensions.Width = std::clamp<uint64_t>(ceilf(mDimensions.Width * scale), 1, mDimensions.Width);
+        mRenderDimensions.Height = std::clamp<uint64_t>(ceilf(mDimensions.Height * scale), 1, mDimensions.Height);
+    }
+
+    Geometry::Dimensions RenderSurfaceDescription::RenderDimensions(const Geometry::Dimensions& textureDimensions) const
+    {
+        glm::vec2 uvScale = UVScale();
+        Geometry::Dimensions dimensions = textureDimensions;
+        dimensions.Width = std::clamp<uint64_t>(ceilf(textureDimensions.Width * uvScale.x), 1, textureDimensions.Width);
+        dimensions.Height = std::clamp<uint64_t>(ceilf(textureDimensions.Height * uvScale.y), 1, textureDimensions.Height);
+        return dimensions;
+    }
 
     glm::uvec2 RenderSurfaceDescription::DispatchDimensionsForGroupSize(uint32_t groupSizeX, uint32_t groupSizeY) const
     {
-        float x = ceilf((float)mDimensions.Width / groupSizeX);
-        float y = ceilf((float)mDimensions.Height / groupSizeY);
+        float x = ceilf((float)mRenderDimensions.Width / groupSizeX);
+        float y = ceilf((float)mRenderDimensions.Height / groupSizeY);
         return { x, y };
     }
 
@@ -3,6 +3,7 @@
 #include <Foundation/Name.hpp>
 #include <Geometry/Dimensions.hpp>
 #include <HardwareAbstractionLayer/ResourceFormat.hpp>
+#include <HardwareAbstractionLayer/Viewport.hpp>
 
 #include <glm/vec2.hpp>
 
@@ -18,17 +19,40 @@ namespace PathFinder
             HAL::DepthStencilFormat dsFormat
         );
 
+        // Fraction of surface dimensions actually rendered to.
+        // Resources are always allocated with full dimensions, 
+        // so changing the scale doesn't cause reallocations.
+        void SetRenderScale(float scale);
+
+        // Part of a texture derived from surface dimensions, like a mip or a reduced resolution buffer,
+        // that is covered by rendering at current scale
+        Geometry::Dimensions RenderDimensions(const Geometry::Dimensions& textureDimensions) const;
+
         glm::uvec2 DispatchDimensionsForGroupSize(uint32_t groupSizeX, uint32_t groupSizeY) const;
 
     private:
         Geometry::Dimensions mDimensions;
+        Geometry::Dimensions mRenderDimensions;
+        Geometry::Dimensions mPreviousRenderDimensions;
         HAL::ColorFormat mRTFormat;
         HAL::DepthStencilFormat mDSFormat;
+        float mRenderScale = 1.0f;
 
     public:
         const Geometry::Dimensions& Dimensions() const { return mDimensions; }
+        const Geometry::Dimensions& RenderDimensions() const { return mRenderDimensions; }
         const HAL::ColorFormat RenderTargetFormat() const { return mRTFormat; }
         const HAL::DepthStencilFormat DepthStencilFormat() const { return mDSFormat; }
+        float RenderScale() const { return mRenderScale; }
+
+        // Temporal history rendered before the last SetRenderScale() call covers a different region
+        bool IsRenderDimensionsChanged() const { return mRenderDimensions != mPreviousRenderDimensions; }
+
+        // Region of full size textures covered by rendering
+        HAL::Viewport Viewport() const { return HAL::Viewport((uint16_t)mRenderDimensions.Width, (uint16_t)mRenderDimensions.Height); }
+
+        // Converts [0; 1] UVs of rendered region into UVs of full size textures
+        glm::vec2 UVScale() const { return { (float)mRenderDimensions.Width / mDimensions.Width, (float)mRenderDimensions.Height / mDimensions.Height }; }
     };
 
 }
@@ -15,7 +15,11 @@ struct PassData
 float4 PSMain(VertexOut pin) : SV_Target
 {
     Texture2D source = Textures2D[PassDataCB.SourceTexIdx];
-    float3 color = source.Sample(PointClampSampler(), pin.UV).rgb;
+    // Upscale the rendered part of pipeline render target to the whole back buffer
+    float2 uv = RenderUVToTextureUV(pin.UV);
+    float3 color = all(GlobalDataCB.PipelineRTUVScale == 1.0) ?
+        source.Sample(PointClampSampler(), uv).rgb :
+        source.Sample(LinearClampSampler(), uv).rgb;
     return float4(color, 1.0);
 }
 
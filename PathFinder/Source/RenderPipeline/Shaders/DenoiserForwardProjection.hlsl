@@ -35,6 +35,12 @@ void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 groupID : SV_GroupID)
     uint2 prevDownsampledPixelIdx = ThreadGroupTilingX(PassDataCB.DispatchGroupCount, GroupDimensionSize.xx, 16, groupThreadID.xy, groupID.xy);
     uint2 prevPixelIdx = prevDownsampledPixelIdx * GradientUpscaleCoefficient;
 
+    // Previous frame was rendered at a different resolution and can't be projected into current one
+    if (FrameDataCB.IsRenderResolutionChanged)
+    {
+        return;
+    }
+
     Texture2D GBufferViewDepthPrevTexture = Textures2D[PassDataCB.GBufferViewDepthPrevTexIdx];
     Texture2D shadowedShadingPrevTexture = Textures2D[PassDataCB.StochasticShadowedShadingPrevTexIdx];
     Texture2D unshadowedShadingPrevTexture = Textures2D[PassDataCB.StochasticUnshadowedShadingPrevTexIdx];
@@ -107,7 +113,7 @@ void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 groupID : SV_GroupID)
             CIELuminance(unshadowedShadingPrevTexture[prevPixelIdx].rgb));
     }
 
-    if (any(prevPixelIdx >= GlobalDataCB.PipelineRTResolution))
+    if (any(prevPixelIdx >= GlobalDataCB.PipelineRenderResolution))
     {
         return;
     }
@@ -121,11 +127,11 @@ void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 groupID : SV_GroupID)
         return;
     }
 
-    float2 prevUV = TexelIndexToUV(prevPixelIdx, GlobalDataCB.PipelineRTResolution);
+    float2 prevUV = TexelIndexToUV(prevPixelIdx, GlobalDataCB.PipelineRenderResolution);
     float3 prevWorldPos = NDCDepthToWorldPosition(prevDepth, prevUV, FrameDataCB.PreviousFrameCamera);
     float3 currNDCPos = ViewProject(prevWorldPos, FrameDataCB.CurrentFrameCamera);
     float2 currUV = NDCToUV(currNDCPos);
-    uint2 currPixelIdx = UVToTexelIndex(currUV, GlobalDataCB.PipelineRTResolution);
+    uint2 currPixelIdx = UVToTexelIndex(currUV, GlobalDataCB.PipelineRenderResolution);
 
     if (any(currUV) < 0.0 || any(currUV > 1.0))
     {
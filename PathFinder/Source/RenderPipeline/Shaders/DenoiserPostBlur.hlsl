@@ -46,7 +46,7 @@ float3 Blur(Texture2D image, float2 uv, uint2 pixelIdx, float2 texelSize, float
     {
         // Generate sample in 2D
         float2 vdSample = VogelDiskSample(i, BlurSampleCount, diskRotation);
-        float2 sampleUV = uv + vdSample * diskScale;
+        float2 sampleUV = ClampToRenderRegion(uv + vdSample * diskScale);
 
         // Sample neighbor value and weight accordingly
         blurred += image.SampleLevel(LinearClampSampler(), sampleUV, 0).rgb;
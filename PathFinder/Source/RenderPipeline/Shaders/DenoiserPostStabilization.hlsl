@@ -67,7 +67,7 @@ void CSMain(int3 DTid : SV_DispatchThreadID, int3 GTid : SV_GroupThreadID)
     Texture2D inputTexture = Textures2D[PassDataCB.InputTexIdx];
     RWTexture2D<float4> outputTexture = RW_Float4_Textures2D[PassDataCB.OutputTexIdx];
 
-    GSBoxLoadStoreCoords coords = GetGSBoxLoadStoreCoords(DTid.xy, GTid.xy, GlobalDataCB.PipelineRTResolution, GroupDimensionSize, SamplingRadius);
+    GSBoxLoadStoreCoords coords = GetGSBoxLoadStoreCoords(DTid.xy, GTid.xy, GlobalDataCB.PipelineRenderResolution, GroupDimensionSize, SamplingRadius);
     gCache[coords.StoreCoord0.x][coords.StoreCoord0.y] = varianceSourceTexture[coords.LoadCoord0].rgb;
 
     if (coords.IsLoadStore1Required) gCache[coords.StoreCoord1.x][coords.StoreCoord1.y] = varianceSourceTexture[coords.LoadCoord1].rgb;
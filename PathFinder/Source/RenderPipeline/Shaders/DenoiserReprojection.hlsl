@@ -42,7 +42,7 @@ void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 groupID : SV_GroupID)
     //------------------------------------//
 
     uint2 pixelIndex = ThreadGroupTilingX(PassDataCB.DispatchGroupCount, GroupDimensionSize.xx, 16, groupThreadID.xy, groupID.xy);
-    float2 uv = TexelIndexToUV(pixelIndex, GlobalDataCB.PipelineRTResolution);
+    float2 uv = TexelIndexToUV(pixelIndex, GlobalDataCB.PipelineRenderResolution);
 
     Texture2D normalRoughnessTexture = Textures2D[PassDataCB.GBufferNormalRoughnessTexIdx];
     Texture2D depthTexture = Textures2D[PassDataCB.DepthTexIdx];
@@ -69,7 +69,8 @@ void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 groupID : SV_GroupID)
     float3 motionVector = LoadGBufferMotion(motionTexture, pixelIndex);
     float3 previousPosition = currentPosition - motionVector;
     float3 reprojectedCoord = ViewProject(previousPosition, FrameDataCB.PreviousFrameCamera); 
-    float2 reprojectedUV = NDCToUV(reprojectedCoord);
+    // History textures are full size, but only their rendered part is valid
+    float2 reprojectedUV = NDCToUV(reprojectedCoord) * GlobalDataCB.PipelineRTUVScale;
 
     // Custom binary weights based on disocclusion help us get rid of ghosting
     Bilinear bilinearFilterAtPrevPos = GetBilinearFilter(reprojectedUV, GlobalDataCB.PipelineRTResolutionInv, GlobalDataCB.PipelineRTResolution);
@@ -79,9 +80,12 @@ void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 groupID : SV_GroupID)
     // Compute disocclusion
     float4 isInScreen = float4(
         bilinearFilterAtPrevPos.TopLeftUV.x >= 0.0,
-        bilinearFilterAtPrevPos.TopLeftUV.y + bilinearFilterAtPrevPos.TexelSize.y < 1.0,
+        bilinearFilterAtPrevPos.TopLeftUV.y + bilinearFilterAtPrevPos.TexelSize.y < GlobalDataCB.PipelineRTUVScale.y,
         bilinearFilterAtPrevPos.TopLeftUV.y >= 0.0,
-        bilinearFilterAtPrevPos.TopLeftUV.x + bilinearFilterAtPrevPos.TexelSize.x < 1.0);
+        bilinearFilterAtPrevPos.TopLeftUV.x + bilinearFilterAtPrevPos.TexelSize.x < GlobalDataCB.PipelineRTUVScale.x);
+
+    // History rendered at a different resolution covers a different region and is discarded
+    isInScreen *= !FrameDataCB.IsRenderResolutionChanged;
 
     float3 previousViewPosition = mul(FrameDataCB.PreviousFrameCamera.View, float4(previousPosition, 1.0)).xyz; 
 
@@ -15,7 +15,7 @@ struct RootConstants
 
 ConstantBuffer<RootConstants> RootConstantBuffer : register(b0);
 StructuredBuffer<Light> LightTable : register(t0);
-StructuredBuffer<Vertex1P1N1UV1T1BT> UnifiedVertexBuffer : register(t1);
+StructuredBuffer<CompressedVertex1P1N1UV1T1BT> UnifiedVertexBuffer : register(t1);
 StructuredBuffer<IndexU32> UnifiedIndexBuffer : register(t2);
 
 //------------------------  Vertex  ------------------------------//
@@ -35,11 +35,12 @@ VertexOut VSMain(uint vertexId : SV_VertexID)
 
     // Load index and vertex
     IndexU32 index = UnifiedIndexBuffer[light.UnifiedIndexBufferOffset + vertexId];
-    Vertex1P1N1UV1T1BT vertex = UnifiedVertexBuffer[light.UnifiedVertexBufferOffset + index.Index];
+    CompressedVertex1P1N1UV1T1BT vertex = UnifiedVertexBuffer[light.UnifiedVertexBufferOffset + index.Index];
+    float4 position = float4(DecompressVertexPosition(vertex, light.VertexPositionOffset, light.VertexPositionScale), 1.0);
 
-    float2 localSpacePosition = vertex.Position.xy;
+    float2 localSpacePosition = position.xy;
 
-    float4 WSPosition = mul(light.ModelMatrix, vertex.Position);
+    float4 WSPosition = mul(light.ModelMatrix, position);
     float4 CSPosition = mul(FrameDataCB.CurrentFrameCamera.View, WSPosition);
     float4 ClipSPosition = mul(FrameDataCB.CurrentFrameCamera.Projection, CSPosition);
 
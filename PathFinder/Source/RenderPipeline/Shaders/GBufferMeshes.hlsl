@@ -15,7 +15,7 @@ struct RootConstants
 #include "Mesh.hlsl"
 
 ConstantBuffer<RootConstants> RootConstantBuffer : register(b0);
-StructuredBuffer<Vertex1P1N1UV1T1BT> UnifiedVertexBuffer : register(t0);
+StructuredBuffer<CompressedVertex1P1N1UV1T1BT> UnifiedVertexBuffer : register(t0);
 StructuredBuffer<IndexU32> UnifiedIndexBuffer : register(t1);
 StructuredBuffer<MeshInstance> InstanceTable : register(t2);
 StructuredBuffer<Material> MaterialTable : register(t3);
@@ -32,11 +32,11 @@ struct VertexOut
     float3x3 TBN : TBN_MATRIX;
 };
 
-float3x3 BuildTBNMatrix(Vertex1P1N1UV1T1BT vertex, MeshInstance instanceData)
+float3x3 BuildTBNMatrix(Vertex1P1N1UV1T1BT vertex, float bitangentSign, MeshInstance instanceData)
 {
     float3 N = mul(instanceData.NormalMatrix, float4(normalize(vertex.Normal), 0.0)).xyz;
     float3 T = mul(instanceData.NormalMatrix, float4(normalize(vertex.Tangent), 0.0)).xyz;
-    float3 B = normalize(cross(N, T));
+    float3 B = normalize(cross(N, T)) * bitangentSign;
 
     return Matrix3x3ColumnMajor(T, B, N);
 }
@@ -49,9 +49,10 @@ VertexOut VSMain(uint indexId : SV_VertexID)
 
     // Load index and vertex
     IndexU32 index = UnifiedIndexBuffer[instanceData.UnifiedIndexBufferOffset + indexId];
-    Vertex1P1N1UV1T1BT vertex = UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + index.Index];
+    CompressedVertex1P1N1UV1T1BT compressedVertex = UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + index.Index];
+    Vertex1P1N1UV1T1BT vertex = DecompressVertex(compressedVertex, instanceData.VertexPositionOffset, instanceData.VertexPositionScale);
 
-    float3x3 TBN = BuildTBNMatrix(vertex, instanceData);
+    float3x3 TBN = BuildTBNMatrix(vertex, DecompressBitangentSign(compressedVertex), instanceData);
     float3x3 TBNInverse = transpose(TBN);
 
     float4 prevWSPosition = mul(instanceData.PrevModelMatrix, vertex.Position);
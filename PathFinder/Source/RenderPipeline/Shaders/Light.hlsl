@@ -26,6 +26,8 @@ struct Light
     uint UnifiedVertexBufferOffset;
     uint UnifiedIndexBufferOffset;
     uint IndexCount;
+    float3 VertexPositionOffset;
+    float3 VertexPositionScale;
 };
 
 struct LightTablePartitionInfo
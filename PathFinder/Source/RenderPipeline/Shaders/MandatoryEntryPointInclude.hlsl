@@ -7,6 +7,9 @@ struct GlobalData
 {
     float2 PipelineRTResolution;
     float2 PipelineRTResolutionInv;
+    // Part of pipeline render targets rendered at current dynamic resolution scale
+    float2 PipelineRenderResolution;
+    float2 PipelineRTUVScale;
 
     uint AnisotropicClampSamplerIdx;
     uint LinearClampSamplerIdx;
@@ -25,6 +28,8 @@ struct FrameData
     bool IsGradientDebugEnabled;
     bool IsMotionDebugEnabled;
     bool IsDenoiserAntilagEnabled;
+    // Previous frame was rendered at different dynamic resolution scale
+    bool IsRenderResolutionChanged;
 }; 
 
 #define GlobalDataType GlobalData
@@ -38,4 +43,18 @@ sampler PointClampSampler() { return Samplers[GlobalDataCB.PointClampSamplerIdx]
 sampler MinSampler() { return Samplers[GlobalDataCB.MinSamplerIdx]; }
 sampler MaxSampler() { return Samplers[GlobalDataCB.MaxSamplerIdx]; }
 
+// Only the top left PipelineRenderResolution part of pipeline render targets is rendered to.
+// Keeps filtering from reaching texels outside of that part.
+float2 ClampToRenderRegion(float2 textureUV)
+{
+    float2 maxUV = (GlobalDataCB.PipelineRenderResolution - 0.5) * GlobalDataCB.PipelineRTResolutionInv;
+    return min(textureUV, maxUV);
+}
+
+// Camera projections produce UVs of the rendered part, while textures are sampled with UVs of the whole texture
+float2 RenderUVToTextureUV(float2 renderUV)
+{
+    return ClampToRenderRegion(renderUV * GlobalDataCB.PipelineRTUVScale);
+}
+
 #endif
\ No newline at end of file
@@ -11,6 +11,26 @@ struct MeshInstance
     uint UnifiedIndexBufferOffset;
     uint IndexCount;
     bool HasTangentSpace;
+    float3 VertexPositionOffset;
+    float3 VertexPositionScale;
+    uint MeshletOffset;
+    uint MeshletCount;
+};
+
+// Bounds are in mesh space, triangles are three 8 bit local indices packed into 32 bits
+struct Meshlet
+{
+    float3 BoundingSphereCenter;
+    float BoundingSphereRadius;
+    float3 ConeApex;
+    float ConeCutoff;
+    float3 ConeAxis;
+    uint VertexCount;
+    float3 BoundingBoxMin;
+    uint TriangleCount;
+    float3 BoundingBoxMax;
+    uint UnifiedMeshletVertexBufferOffset;
+    uint UnifiedMeshletTriangleBufferOffset;
 };
 
 static const uint MaterialTypeCookTorrance = 0;
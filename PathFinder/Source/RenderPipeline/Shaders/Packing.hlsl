@@ -131,6 +131,24 @@ float2 UnpackUnorm2x16(uint package, float range)
     return float2(fFirst, fSecond);
 }
 
+// Sign extended 16 bit integers, x is stored in low bits
+int2 UnpackInt16x2(uint packed)
+{
+    return int2(int(packed << 16) >> 16, int(packed) >> 16);
+}
+
+// Signed normalized 16 bit values with x in low bits, same as DXGI SNORM formats
+float2 UnpackSnorm16x2(uint packed)
+{
+    return max(float2(UnpackInt16x2(packed)) / 32767.0, -1.0);
+}
+
+// Half floats with x in low bits
+float2 UnpackHalf2x16(uint packed)
+{
+    return f16tof32(uint2(packed, packed >> 16));
+}
+
 float4 Decode8888(uint encoded)
 {
     float4 decoded;
@@ -15,4 +15,12 @@
 static const float2 Vertices[3] = { float2(-1.0, -1.0), float2(-1.0, 3.0), float2(3.0, -1.0) };
 static const float2 UVs[3] = { float2(0.0, 0.0), float2(0.0, 2.0), float2(2.0, 0.0) };
 
+// Triangle covers only the rendered part of pipeline render targets
+float2 FullScreenTriangleUV(uint indexId)
+{
+    float2 uv = UVs[indexId];
+    uv.y = 1.0 - uv.y;
+    return uv * GlobalDataCB.PipelineRTUVScale;
+}
+
 #endif
\ No newline at end of file
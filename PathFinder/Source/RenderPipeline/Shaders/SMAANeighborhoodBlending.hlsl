@@ -22,8 +22,7 @@ struct VertexOut
 VertexOut VSMain(uint indexId : SV_VertexID)
 {
     float4 position = float4(Vertices[indexId], 0.0, 1.0);
-    float2 uv = UVs[indexId];
-    uv.y = 1.0 - uv.y;
+    float2 uv = FullScreenTriangleUV(indexId);
 
     float4 offset;
     SMAANeighborhoodBlendingVS(uv, offset);
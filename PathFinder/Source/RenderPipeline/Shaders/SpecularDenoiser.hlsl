@@ -88,7 +88,7 @@ float3x3 SamplingBasis(float3 Xview, float3 Nview, float roughness, float radius
 void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 groupID : SV_GroupID)
 {
     uint2 pixelIndex = ThreadGroupTilingX(PassDataCB.DispatchGroupCount, GroupDimensionSize.xx, 16, groupThreadID.xy, groupID.xy);
-    float2 uv = TexelIndexToUV(pixelIndex, GlobalDataCB.PipelineRTResolution);
+    float2 uv = TexelIndexToUV(pixelIndex, GlobalDataCB.PipelineRenderResolution);
 
     GBufferTexturePack gBufferTextures;
     gBufferTextures.NormalRoughness = Textures2D[PassDataCB.GBufferIndices.NormalRoughnessTexIdx];
@@ -205,15 +205,16 @@ void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 groupID : SV_GroupID)
             // Project and obtain sample's UV
             float3 projectedSample = Project(viewSpaceSample, FrameDataCB.CurrentFrameCamera);
             float2 sampleUV = NDCToUV(projectedSample);
+            float2 sampleTextureUV = RenderUVToTextureUV(sampleUV);
 
             // Now that we know screen-space sample location, we need to obtain view-space 3d position of 
             // a surface that lives at that location. We basically need to cast a ray through sample UV into depth buffer.
             // Unprojection will do just what we need.
-            float neightborDepth = gBufferTextures.DepthStencil.SampleLevel(LinearClampSampler(), sampleUV, 0).r;
+            float neightborDepth = gBufferTextures.DepthStencil.SampleLevel(LinearClampSampler(), sampleTextureUV, 0).r;
             float3 neighborViewPos = NDCDepthToViewPosition(neightborDepth, sampleUV, FrameDataCB.CurrentFrameCamera);
 
             // Get neighbor properties
-            float4 neighborNormalRoughness = gBufferTextures.NormalRoughness.SampleLevel(LinearClampSampler(), sampleUV, 0);
+            float4 neighborNormalRoughness = gBufferTextures.NormalRoughness.SampleLevel(LinearClampSampler(), sampleTextureUV, 0);
 
             float3 neighborNormal = ExpandGBufferNormal(neighborNormalRoughness.xyz);
             float neighborRoughness = neighborNormalRoughness.w;
@@ -226,8 +227,8 @@ void CSMain(uint3 groupThreadID : SV_GroupThreadID, uint3 groupID : SV_GroupID)
             float sampleWeight = normalWeight * geometryWeight * roughnessWeight;
 
             // Sample neighbor value and weight accordingly
-            denoisedShadowed += currentShadowedShadingTexture.SampleLevel(LinearClampSampler(), sampleUV, 0).rgb * sampleWeight;
-            denoisedUnshadowed += currentUnshadowedShadingTexture.SampleLevel(LinearClampSampler(), sampleUV, 0).rgb * sampleWeight;
+            denoisedShadowed += currentShadowedShadingTexture.SampleLevel(LinearClampSampler(), sampleTextureUV, 0).rgb * sampleWeight;
+            denoisedUnshadowed += currentUnshadowedShadingTexture.SampleLevel(LinearClampSampler(), sampleTextureUV, 0).rgb * sampleWeight;
 
             totalWeight += sampleWeight;
         }
@@ -73,7 +73,13 @@ void CSMain(int3 dispatchThreadID : SV_DispatchThreadID, int groupIndex : SV_Gro
     float2 minMaxLum = float2(0.0, 1.0);
     uint bin = GetHistogramBin(CIELuminance(color), minMaxLum.x, minMaxLum.y);
     uint prevValue;
-    InterlockedAdd(gHistogram[bin], 1, prevValue);
+
+    // Pixels outside of rendered region hold stale data
+    if (all(dispatchThreadID.xy < GlobalDataCB.PipelineRenderResolution))
+    {
+        InterlockedAdd(gHistogram[bin], 1, prevValue);
+    }
+
     GroupMemoryBarrierWithGroupSync();
 
     if (groupIndex < HistogramBinCount)
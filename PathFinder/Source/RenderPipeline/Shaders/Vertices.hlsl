@@ -1,6 +1,8 @@
 #ifndef _Vertices__
 #define _Vertices__
 
+#include "Packing.hlsl"
+
 struct Vertex1P1N1UV
 {
     float4 Position;
@@ -17,6 +19,43 @@ struct Vertex1P1N1UV1T1BT
     float3 Bitangent;
 };
 
+// Mirrors CompressedVertex1P1N1UV1T1BT on CPU side:
+// snorm16 position relative to mesh bounds with bitangent sign in W,
+// octahedral snorm 2x16 normal and tangent, half float uv
+struct CompressedVertex1P1N1UV1T1BT
+{
+    uint PositionXY;
+    uint PositionZW;
+    uint Normal;
+    uint Tangent;
+    uint UV;
+};
+
+float3 DecompressVertexPosition(CompressedVertex1P1N1UV1T1BT vertex, float3 positionOffset, float3 positionScale)
+{
+    float3 position = float3(UnpackSnorm16x2(vertex.PositionXY), UnpackSnorm16x2(vertex.PositionZW).x);
+    return positionOffset + positionScale * position;
+}
+
+float DecompressBitangentSign(CompressedVertex1P1N1UV1T1BT vertex)
+{
+    return UnpackSnorm16x2(vertex.PositionZW).y;
+}
+
+Vertex1P1N1UV1T1BT DecompressVertex(CompressedVertex1P1N1UV1T1BT vertex, float3 positionOffset, float3 positionScale)
+{
+    Vertex1P1N1UV1T1BT decompressed;
+    decompressed.Position = float4(DecompressVertexPosition(vertex, positionOffset, positionScale), 1.0);
+    decompressed.Normal = OctUnpackDecode(vertex.Normal);
+    decompressed.UV = UnpackHalf2x16(vertex.UV);
+    decompressed.Tangent = OctUnpackDecode(vertex.Tangent);
+
+    // Encoder makes tangent orthogonal to normal, quantization leaves basis slightly skewed
+    decompressed.Tangent = normalize(decompressed.Tangent - decompressed.Normal * dot(decompressed.Normal, decompressed.Tangent));
+    decompressed.Bitangent = cross(decompressed.Normal, decompressed.Tangent) * DecompressBitangentSign(vertex);
+    return decompressed;
+}
+
 struct IndexU32
 {
     uint Index;
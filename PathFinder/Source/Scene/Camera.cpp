@@ -95,6 +95,16 @@ namespace PathFinder
         return fabs(clipSpaceVector.w) > std::numeric_limits<float>::epsilon() ? clipSpaceVector / clipSpaceVector.w : clipSpaceVector;
     }
 
+    Geometry::Ray3D Camera::RayFromNDC(const glm::vec2 &ndc) const
+    {
+        glm::mat4 inverseViewProjection = InverseViewProjection();
+        glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc, 0.0, 1.0);
+        glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndc, 1.0, 1.0);
+        nearPoint /= nearPoint.w;
+        farPoint /= farPoint.w;
+        return Geometry::Ray3D(glm::vec3(nearPoint), glm::vec3(farPoint - nearPoint));
+    }
+
     glm::mat4 Camera::ViewProjection() const
     {
         return Projection() * View();
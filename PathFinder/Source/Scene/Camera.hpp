@@ -42,6 +42,9 @@ namespace PathFinder
 
         glm::vec3 WorldToNDC(const glm::vec3 &v) const;
 
+        // Ray from near plane through a point on the screen, for picking
+        Geometry::Ray3D RayFromNDC(const glm::vec2 &ndc) const;
+
     private:
         glm::vec3 mFront;
         glm::vec3 mRight;
@@ -3,24 +3,48 @@
 #include <cstdint>
 #include <HardwareAbstractionLayer/RayTracingAccelerationStructure.hpp>
 #include <Foundation/BitwiseEnum.hpp>
+#include <Foundation/SlotMap.hpp>
 
-namespace PathFinder 
+namespace PathFinder
 {
-   
-    using EntityID = uint32_t;
 
-    inline static const auto NoEntityID = std::numeric_limits<EntityID>::max();
+    enum class EntityType : uint8_t
+    {
+        MeshInstance = 0, SphericalLight = 1, RectangularLight = 2, DiskLight = 3
+    };
+
+    // Stable handle of a scene entity. Stays the same while the entity exists,
+    // and never resolves to another entity after this one is removed.
+    struct EntityID
+    {
+        Foundation::SlotMapHandle Handle;
+        EntityType Type = EntityType::MeshInstance;
+
+        inline bool operator==(const EntityID& other) const { return Handle == other.Handle && Type == other.Type; }
+        inline bool operator!=(const EntityID& other) const { return !(*this == other); }
+    };
+
+    inline static const EntityID NoEntityID{};
+
+    // Ray tracing instance IDs are 24 bits wide, so GPU gets entity type and slot index without generation
+    inline static const uint32_t GPUEntitySlotIndexBitCount = 22;
+
+    inline uint32_t GPUEntityID(const EntityID& id)
+    {
+        assert_format(id.Handle.Index < (1u << GPUEntitySlotIndexBitCount), "Entity slot index doesn't fit into GPU entity ID");
+        return (uint32_t(id.Type) << GPUEntitySlotIndexBitCount) | id.Handle.Index;
+    }
 
     enum class EntityMask : uint8_t
     {
         Unknown = 0, MeshInstance = 1 << 0, Light = 1 << 1
     };
 
-    inline HAL::RayTracingTopAccelerationStructure::InstanceInfo RTASInstanceInfoForEntity(EntityID id, EntityMask mask)
+    inline HAL::RayTracingTopAccelerationStructure::InstanceInfo RTASInstanceInfoForEntity(const EntityID& id, EntityMask mask)
     {
-        return { id, std::underlying_type_t<EntityMask>(mask) };
+        return { GPUEntityID(id), std::underlying_type_t<EntityMask>(mask) };
     }
 
 }
 
-ENABLE_BITMASK_OPERATORS(PathFinder::EntityMask);
\ No newline at end of file
+ENABLE_BITMASK_OPERATORS(PathFinder::EntityMask);
@@ -26,7 +26,7 @@ namespace PathFinder
         // is equal to its total luminous power Phi divided by the emitter area A and the projected solid angle (Pi)
     }
 
-    void Light::SetEntityID(EntityID id)
+    void Light::SetEntityID(const EntityID& id)
     {
         mEntityID = id;
     }
@@ -26,14 +26,14 @@ namespace PathFinder
         void SetLuminousPower(Lumen luminousPower);
 
         void SetIndexInGPUTable(uint32_t index);
-        void SetEntityID(EntityID id);
+        void SetEntityID(const EntityID& id);
         void SetVertexStorageLocation(const VertexStorageLocation& location);
 
     protected:
         void SetArea(float area);
 
         glm::mat4 mModelMatrix;
-        EntityID mEntityID = 0;
+        EntityID mEntityID;
         uint32_t mIndexInGPUTable = 0;
 
     private:
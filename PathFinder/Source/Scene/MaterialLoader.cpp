@@ -23,6 +23,15 @@ namespace PathFinder
     {
         Material material{};
 
+        // Paths are what scene files store for materials
+        material.AlbedoMapPath = albedoMapRelativePath;
+        material.NormalMapPath = normalMapRelativePath;
+        material.RoughnessMapPath = roughnessMapRelativePath.value_or("");
+        material.MetalnessMapPath = metalnessMapRelativePath.value_or("");
+        material.DisplacementMapPath = displacementMapRelativePath.value_or("");
+        material.DistanceFieldPath = distanceFieldRelativePath.value_or("");
+        material.AOMapPath = AOMapRelativePath.value_or("");
+
         material.AlbedoMap = GetOrAllocateTexture(albedoMapRelativePath);
         material.NormalMap = GetOrAllocateTexture(normalMapRelativePath);
 
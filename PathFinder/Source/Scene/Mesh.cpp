@@ -1,6 +1,7 @@
 #include "Mesh.hpp"
 
 #include <Geometry/Triangle3D.hpp>
+#include <Geometry/Collision.hpp>
 
 namespace PathFinder
 {
@@ -45,6 +46,22 @@ namespace PathFinder
         return mHasTangentSpace;
     }
 
+    uint64_t Mesh::TriangleCount() const
+    {
+        return (mIndices.empty() ? mVertices.size() : mIndices.size()) / 3;
+    }
+
+    Geometry::Triangle3D Mesh::Triangle(uint64_t index) const
+    {
+        auto vertexIndex = [this](uint64_t i) -> uint64_t { return mIndices.empty() ? i : mIndices[i]; };
+
+        return Geometry::Triangle3D{
+            glm::vec3{ mVertices[vertexIndex(index * 3 + 0)].Position },
+            glm::vec3{ mVertices[vertexIndex(index * 3 + 1)].Position },
+            glm::vec3{ mVertices[vertexIndex(index * 3 + 2)].Position }
+        };
+    }
+
     void Mesh::SetName(const std::string& name)
     {
         mName = name;
@@ -65,6 +82,9 @@ namespace PathFinder
         mBoundingBox.Min = glm::min(glm::vec3(vertex.Position), mBoundingBox.Min);
         mBoundingBox.Max = glm::max(glm::vec3(vertex.Position), mBoundingBox.Max);
         mVertices.push_back(vertex);
+        mTriangleBVH = {};
+        mCompressedVertices.clear();
+        ClearDerivedGeometry();
 
         if ((mVertices.size() % 3) == 0) {
             size_t count = mVertices.size();
@@ -85,6 +105,76 @@ namespace PathFinder
     void Mesh::AddIndex(uint32_t index)
     {
         mIndices.push_back(index);
+        mTriangleBVH = {};
+        ClearDerivedGeometry();
+    }
+
+    void Mesh::SetGeometry(
+        std::vector<Vertex1P1N1UV1T1BT>&& vertices, std::vector<uint32_t>&& indices,
+        const Geometry::AxisAlignedBox3D& boundingBox, float surfaceArea, bool hasTangentSpace)
+    {
+        mVertices = std::move(vertices);
+        mIndices = std::move(indices);
+        mBoundingBox = boundingBox;
+        mArea = surfaceArea;
+        mHasTangentSpace = hasTangentSpace;
+        mTriangleBVH = {};
+        mCompressedVertices.clear();
+        ClearDerivedGeometry();
+    }
+
+    void Mesh::SetMeshlets(std::vector<Meshlet>&& meshlets, std::vector<uint32_t>&& meshletVertices, std::vector<uint8_t>&& meshletTriangles)
+    {
+        mMeshlets = std::move(meshlets);
+        mMeshletVertices = std::move(meshletVertices);
+        mMeshletTriangles = std::move(meshletTriangles);
+    }
+
+    void Mesh::SetLODs(std::vector<MeshLOD>&& lods)
+    {
+        assert_format(lods.size() <= MeshLOD::MaxCount, "Too many LODs for a mesh");
+        mLODs = std::move(lods);
+    }
+
+    void Mesh::ClearDerivedGeometry()
+    {
+        mMeshlets.clear();
+        mMeshletVertices.clear();
+        mMeshletTriangles.clear();
+        mLODs.clear();
+    }
+
+    void Mesh::BuildTriangleBVH(Foundation::JobSystem* jobSystem)
+    {
+        std::vector<Geometry::AxisAlignedBox3D> triangleBounds(TriangleCount());
+
+        for (uint64_t triangleIdx = 0; triangleIdx < triangleBounds.size(); ++triangleIdx)
+        {
+            Geometry::Triangle3D triangle = Triangle(triangleIdx);
+            triangleBounds[triangleIdx].Min = glm::min(glm::min(triangle.a, triangle.b), triangle.c);
+            triangleBounds[triangleIdx].Max = glm::max(glm::max(triangle.a, triangle.b), triangle.c);
+        }
+
+        mTriangleBVH.Build(triangleBounds, jobSystem);
+    }
+
+    void Mesh::CompressVertices()
+    {
+        mPositionQuantization = CompressedVertex1P1N1UV1T1BT::Quantization::ForBounds(mBoundingBox);
+        mCompressedVertices.resize(mVertices.size());
+
+        for (uint64_t vertexIdx = 0; vertexIdx < mVertices.size(); ++vertexIdx)
+        {
+            mCompressedVertices[vertexIdx] = CompressedVertex1P1N1UV1T1BT::Encode(mVertices[vertexIdx], mPositionQuantization);
+        }
+    }
+
+    std::optional<Geometry::BoundingVolumeHierarchy::RayHit> Mesh::CastRay(const Geometry::Ray3D& ray, float maxDistance) const
+    {
+        return mTriangleBVH.CastRay(ray, maxDistance, [this, &ray](uint32_t triangleIdx, float& distance)
+        {
+            return Geometry::Collision::RayTriangle(ray, Triangle(triangleIdx), distance);
+        });
     }
 
 }
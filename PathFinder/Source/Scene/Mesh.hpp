@@ -4,10 +4,16 @@
 #include <string>
 
 #include "VertexStorageLocation.hpp"
+#include "Meshlet.hpp"
+#include "MeshLOD.hpp"
 #include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+#include "Vertices/CompressedVertex1P1N1UV1T1BT.hpp"
 
 #include <bitsery/bitsery.h>
 #include <Geometry/AxisAlignedBox3D.hpp>
+#include <Geometry/BoundingVolumeHierarchy.hpp>
+#include <Geometry/Triangle3D.hpp>
+#include <Geometry/Ray3D.hpp>
 
 
 namespace PathFinder
@@ -24,6 +30,8 @@ namespace PathFinder
         const VertexStorageLocation& LocationInVertexStorage() const;
         float SurfaceArea() const;
         bool HasTangentSpace() const;
+        uint64_t TriangleCount() const;
+        Geometry::Triangle3D Triangle(uint64_t index) const;
 
         void SetName(const std::string& name);
         void SetHasTangentSpace(bool hts);
@@ -31,9 +39,31 @@ namespace PathFinder
         void AddVertex(const Vertex1P1N1UV1T1BT& vertex);
         void AddIndex(uint32_t index);
 
+        // Replaces geometry with one which properties are already known, such as geometry restored from a scene file
+        void SetGeometry(
+            std::vector<Vertex1P1N1UV1T1BT>&& vertices, std::vector<uint32_t>&& indices,
+            const Geometry::AxisAlignedBox3D& boundingBox, float surfaceArea, bool hasTangentSpace);
+
+        // Meshlets and LODs are dropped when vertices or indices are added or geometry is replaced
+        void SetMeshlets(std::vector<Meshlet>&& meshlets, std::vector<uint32_t>&& meshletVertices, std::vector<uint8_t>&& meshletTriangles);
+        void SetLODs(std::vector<MeshLOD>&& lods);
+
+        // Hierarchy is kept until vertices or indices are added, 
+        // modifications through Vertices() require an explicit rebuild
+        void BuildTriangleBVH(Foundation::JobSystem* jobSystem = nullptr);
+
+        // Quantizes vertices relative to the bounding box into the stream uploaded to GPU.
+        // Compressed vertices are dropped when geometry changes, modifications through Vertices() require an explicit call
+        void CompressVertices();
+
+        // Closest front facing triangle hit by a ray in mesh space, requires built hierarchy
+        std::optional<Geometry::BoundingVolumeHierarchy::RayHit> CastRay(const Geometry::Ray3D& ray, float maxDistance) const;
+
     private:
         friend bitsery::Access;
 
+        void ClearDerivedGeometry();
+
         template <typename S>
         void serialize(S& s)
         {
@@ -53,6 +83,24 @@ namespace PathFinder
         Geometry::AxisAlignedBox3D mBoundingBox = Geometry::AxisAlignedBox3D::MaximumReversed();
         float mArea = 0.0;
         bool mHasTangentSpace = true;
+        Geometry::BoundingVolumeHierarchy mTriangleBVH;
+        std::vector<CompressedVertex1P1N1UV1T1BT> mCompressedVertices;
+        CompressedVertex1P1N1UV1T1BT::Quantization mPositionQuantization;
+        std::vector<Meshlet> mMeshlets;
+        std::vector<uint32_t> mMeshletVertices;
+        std::vector<uint8_t> mMeshletTriangles;
+        std::vector<MeshLOD> mLODs;
+
+    public:
+        inline const Geometry::BoundingVolumeHierarchy& TriangleBVH() const { return mTriangleBVH; }
+        inline const auto& CompressedVertices() const { return mCompressedVertices; }
+        inline const auto& PositionQuantization() const { return mPositionQuantization; }
+        inline const auto& Meshlets() const { return mMeshlets; }
+        inline const auto& MeshletVertices() const { return mMeshletVertices; }
+        inline const auto& MeshletTriangles() const { return mMeshletTriangles; }
+
+        // Simplified levels from finest to coarsest, base geometry is level 0 and is not included
+        inline const auto& LODs() const { return mLODs; }
     };
 
 }
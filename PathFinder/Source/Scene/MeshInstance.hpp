@@ -45,9 +45,12 @@ namespace PathFinder
         bool mIsHighlighted = false;
         Geometry::Transformation mTransformation;
         Geometry::Transformation mPrevTransformation;
-        EntityID mEntityID = 0;
+        EntityID mEntityID;
         uint32_t mIndexInGPUTable = 0;
 
+        // Selected every frame from camera distance, so it's not serialized
+        uint32_t mLODIndex = 0;
+
     public:
         inline bool IsSelected() const { return mIsSelected; }
         inline bool IsHighlighted() const { return mIsHighlighted; }
@@ -58,12 +61,14 @@ namespace PathFinder
         inline const Material* AssociatedMaterial() const { return mMaterial; }
         inline const EntityID& ID() const { return mEntityID; }
         inline auto IndexInGPUTable () const { return mIndexInGPUTable; }
+        inline auto LODIndex() const { return mLODIndex; }
 
         inline void SetIsSelected(bool selected) { mIsSelected = selected; }
         inline void SetIsHighlighted(bool highlighted) { mIsHighlighted = highlighted; }
         inline void SetTransformation(const Geometry::Transformation& transform) { mTransformation = transform; }
         inline void SetIndexInGPUTable(uint32_t index) { mIndexInGPUTable = index; }
-        inline void SetEntityID(EntityID id) { mEntityID = id; }
+        inline void SetEntityID(const EntityID& id) { mEntityID = id; }
+        inline void SetLODIndex(uint32_t lod) { mLODIndex = lod; }
     };
 
 }
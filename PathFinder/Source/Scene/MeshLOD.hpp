@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Simplified level of mesh geometry.
+    ///
+    /// Levels index vertices of the base mesh, so a LOD chain costs only its index buffers.
+    struct MeshLOD
+    {
+        // Simplified levels kept per mesh. Base geometry is level 0 and is not stored as a MeshLOD.
+        static const uint32_t MaxCount = 4;
+
+        std::vector<uint32_t> Indices;
+
+        // Largest distance from base mesh vertices to the level surface in mesh space units,
+        // never smaller than errors of finer levels
+        float Error = 0.0f;
+    };
+
+}
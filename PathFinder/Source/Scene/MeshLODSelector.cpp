@@ -0,0 +1,92 @@
+#include "MeshLODSelector.hpp"
+#include "Scene.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    MeshLODSelector::MeshLODSelector(const Settings& settings)
+        : mSettings{ settings } {}
+
+    void MeshLODSelector::SelectLODs(Scene& scene, uint64_t viewportHeight, Foundation::JobSystem* jobSystem) const
+    {
+        auto& meshInstances = scene.MeshInstances();
+        const Camera& camera = scene.MainCamera();
+        uint64_t instanceCount = meshInstances.size();
+
+        auto selectBatch = [this, &meshInstances, &camera, viewportHeight](uint64_t first, uint64_t count)
+        {
+            for (uint64_t index = first; index < first + count; ++index)
+            {
+                MeshInstance& instance = meshInstances[index];
+                instance.SetLODIndex(SelectLOD(instance, camera, viewportHeight));
+            }
+        };
+
+        // Batches write disjoint instances and only read meshes and the camera
+        if (jobSystem && instanceCount > InstanceBatchSize)
+        {
+            Foundation::TaskGraph batchGraph;
+
+            for (uint64_t first = 0; first < instanceCount; first += InstanceBatchSize)
+            {
+                uint64_t count = std::min(InstanceBatchSize, instanceCount - first);
+                batchGraph.AddTask("Select Mesh LODs", [&selectBatch, first, count] { selectBatch(first, count); });
+            }
+
+            jobSystem->Execute(batchGraph);
+        }
+        else
+        {
+            selectBatch(0, instanceCount);
+        }
+    }
+
+    uint32_t MeshLODSelector::SelectLOD(const MeshInstance& instance, const Camera& camera, uint64_t viewportHeight) const
+    {
+        const Mesh* mesh = instance.AssociatedMesh();
+        const std::vector<MeshLOD>& lods = mesh->LODs();
+
+        if (lods.empty())
+        {
+            return 0;
+        }
+
+        Geometry::AxisAlignedBox3D bounds = instance.BoundingBox(*mesh);
+        float distance = glm::distance(camera.Position(), glm::clamp(camera.Position(), bounds.Min, bounds.Max));
+
+        // Camera inside of bounds sees errors at any size
+        if (distance <= 0.0f)
+        {
+            return 0;
+        }
+
+        const glm::vec3& scale = instance.Transformation().Scale;
+        float maxScale = std::max({ std::abs(scale.x), std::abs(scale.y), std::abs(scale.z) });
+
+        // Pixels per world unit at the distance
+        float pixelsPerUnit = float(viewportHeight) * 0.5f / (distance * std::tan(glm::radians(camera.FOVV()) * 0.5f));
+
+        uint32_t selected = 0;
+
+        // Errors grow along the chain, so the first level over the limit ends the search
+        for (uint32_t lodIdx = 0; lodIdx < lods.size(); ++lodIdx)
+        {
+            if (lods[lodIdx].Error * maxScale * pixelsPerUnit > mSettings.MaxScreenSpaceError)
+            {
+                break;
+            }
+
+            selected = lodIdx + 1;
+        }
+
+        return selected;
+    }
+
+}
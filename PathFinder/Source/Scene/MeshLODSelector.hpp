@@ -0,0 +1,47 @@
+#pragma once
+
+#include "MeshInstance.hpp"
+#include "Camera.hpp"
+
+#include <Foundation/JobSystem.hpp>
+
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    class Scene;
+
+    /// Picks a LOD of every mesh instance from projected screen space error.
+    ///
+    /// LOD errors are mesh space deviations, they are scaled by the largest instance scale
+    /// and projected from the point of instance bounding box closest to the camera,
+    /// so selection errs on the side of finer levels. The coarsest level within the error limit is picked.
+    class MeshLODSelector
+    {
+    public:
+        struct Settings
+        {
+            // Largest deviation from base geometry in pixels of viewport height
+            float MaxScreenSpaceError = 1.0f;
+        };
+
+        MeshLODSelector() = default;
+        MeshLODSelector(const Settings& settings);
+
+        // Instances are processed in parallel batches when a job system is provided
+        void SelectLODs(Scene& scene, uint64_t viewportHeight, Foundation::JobSystem* jobSystem = nullptr) const;
+
+        uint32_t SelectLOD(const MeshInstance& instance, const Camera& camera, uint64_t viewportHeight) const;
+
+    private:
+        static const uint64_t InstanceBatchSize = 4096;
+
+        Settings mSettings;
+
+    public:
+        inline const Settings& SelectorSettings() const { return mSettings; }
+        inline void SetSelectorSettings(const Settings& settings) { mSettings = settings; }
+    };
+
+}
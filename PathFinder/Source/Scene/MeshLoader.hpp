@@ -2,6 +2,10 @@
 
 #include "Vertices/Vertex1P1N1UV1T1BT.hpp"
 #include "Mesh.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshletBuilder.hpp"
+#include "MeshSimplifier.hpp"
+#include "TangentSpaceGenerator.hpp"
 
 // Assimp is in conflict with windows.h definitions of min and max
 #ifndef NOMINMAX 
@@ -28,17 +32,27 @@ namespace PathFinder
     class MeshLoader
     {
     public:
-        MeshLoader(const std::filesystem::path& fileRoot);
+        // Tangent frames are generated in parallel when a job system is provided
+        MeshLoader(const std::filesystem::path& fileRoot, Foundation::JobSystem* jobSystem = nullptr);
 
         std::vector<Mesh> Load(const std::string& fileName);
 
     private:
         Mesh ProcessMesh(aiMesh* mesh, const aiScene* scene);
         void ProcessNode(aiNode* node, const aiScene* scene);
-        void CalculateTangentSpace(Mesh* mesh);
 
         std::vector<Mesh> mLoadedMeshes;
+        std::vector<MeshOptimizer::Statistics> mLastLoadStatistics;
         std::filesystem::path mRootPath;
+        MeshOptimizer mOptimizer;
+        MeshletBuilder mMeshletBuilder;
+        MeshSimplifier mSimplifier;
+        TangentSpaceGenerator mTangentGenerator;
+        Foundation::JobSystem* mJobSystem = nullptr;
+
+    public:
+        // Optimization statistics of meshes returned by the last Load() call, in the same order
+        inline const auto& LastLoadStatistics() const { return mLastLoadStatistics; }
     };
 
 }
@@ -0,0 +1,655 @@
+#include "MeshOptimizer.hpp"
+
+#include <Foundation/HashUtils.hpp>
+#include <robinhood/robin_hood.h>
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cstring>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        struct VertexBytesHash
+        {
+            const std::vector<Vertex1P1N1UV1T1BT>* Vertices;
+
+            size_t operator()(uint32_t index) const
+            {
+                uint32_t words[sizeof(Vertex1P1N1UV1T1BT) / sizeof(uint32_t)];
+                std::memcpy(words, &(*Vertices)[index], sizeof(words));
+
+                // Cheap multiplicative accumulation, bits are spread once at the end
+                uint64_t hash = 0;
+                for (uint32_t word : words) hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+                return Foundation::HashUtils::Mix(hash);
+            }
+        };
+
+        struct VertexBytesEqual
+        {
+            const std::vector<Vertex1P1N1UV1T1BT>* Vertices;
+
+            bool operator()(uint32_t a, uint32_t b) const
+            {
+                return std::memcmp(&(*Vertices)[a], &(*Vertices)[b], sizeof(Vertex1P1N1UV1T1BT)) == 0;
+            }
+        };
+
+        static_assert(sizeof(Vertex1P1N1UV1T1BT) % sizeof(uint32_t) == 0, "Vertex bytes are hashed as words and must have no padding");
+
+        // FIFO cache where a vertex is resident if it was loaded less than cache size misses ago.
+        // Reset is a jump of the miss counter, so restarting the cache is free.
+        class FIFOCacheSimulation
+        {
+        public:
+            FIFOCacheSimulation(uint64_t vertexCount, uint32_t cacheSize)
+                : mTimestamps(vertexCount, 0), mCacheSize{ cacheSize }, mTime{ cacheSize + 1ull } {}
+
+            bool Access(uint32_t vertex)
+            {
+                if (mTime - mTimestamps[vertex] > mCacheSize)
+                {
+                    mTimestamps[vertex] = mTime++;
+                    return false;
+                }
+
+                return true;
+            }
+
+            uint32_t MissCount(const uint32_t* triangle)
+            {
+                return uint32_t(!Access(triangle[0])) + uint32_t(!Access(triangle[1])) + uint32_t(!Access(triangle[2]));
+            }
+
+            void Reset()
+            {
+                mTime += mCacheSize + 1;
+            }
+
+        private:
+            std::vector<uint64_t> mTimestamps;
+            uint64_t mCacheSize;
+            uint64_t mTime;
+        };
+
+        // Scoring of Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+        float ForsythVertexScore(int32_t cachePosition, uint32_t liveTriangleCount, uint32_t cacheSize)
+        {
+            if (liveTriangleCount == 0)
+            {
+                return -1.0f;
+            }
+
+            float score = 0.0f;
+
+            if (cachePosition >= 0)
+            {
+                // Vertices of the last triangle get a fixed score, so it doesn't matter which one of them was used last
+                score = cachePosition < 3 ?
+                    0.75f :
+                    std::pow(1.0f - float(cachePosition - 3) / float(cacheSize - 3), 1.5f);
+            }
+
+            // Boost vertices with few triangles left, so lone triangles don't get stranded
+            score += 2.0f / std::sqrt(float(liveTriangleCount));
+
+            return score;
+        }
+    }
+
+    MeshOptimizer::MeshOptimizer(const Settings& settings)
+        : mSettings{ settings } {}
+
+    MeshOptimizer::Statistics MeshOptimizer::Optimize(Mesh& mesh) const
+    {
+        std::vector<Vertex1P1N1UV1T1BT> vertices = mesh.Vertices();
+        std::vector<uint32_t> indices = mesh.Indices();
+
+        if (indices.empty())
+        {
+            indices.resize(vertices.size());
+            std::iota(indices.begin(), indices.end(), 0);
+        }
+
+        Statistics statistics;
+        statistics.ImportedVertexCount = vertices.size();
+        statistics.TriangleCount = indices.size() / 3;
+        statistics.Imported = Analyze(vertices, indices);
+
+        statistics.WeldedVertexCount = WeldVertices(vertices, indices);
+        statistics.Welded = Analyze(vertices, indices);
+
+        OptimizeVertexCache(indices, vertices.size());
+        statistics.VertexCacheOptimized = Analyze(vertices, indices);
+
+        OptimizeOverdraw(indices, vertices);
+        statistics.OverdrawOptimized = Analyze(vertices, indices);
+
+        OptimizeVertexFetch(vertices, indices);
+        statistics.VertexFetchOptimized = Analyze(vertices, indices);
+
+        // Reordering keeps bounds and area intact
+        mesh.SetGeometry(std::move(vertices), std::move(indices), mesh.BoundingBox(), mesh.SurfaceArea(), mesh.HasTangentSpace());
+
+        return statistics;
+    }
+
+    uint64_t MeshOptimizer::WeldVertices(std::vector<Vertex1P1N1UV1T1BT>& vertices, std::vector<uint32_t>& indices) const
+    {
+        robin_hood::unordered_flat_map<uint32_t, uint32_t, VertexBytesHash, VertexBytesEqual> uniqueVertices{
+            0, VertexBytesHash{ &vertices }, VertexBytesEqual{ &vertices } };
+
+        uniqueVertices.reserve(vertices.size());
+
+        std::vector<uint32_t> remap(vertices.size());
+        std::vector<Vertex1P1N1UV1T1BT> weldedVertices;
+        weldedVertices.reserve(vertices.size());
+
+        // Lookups compare against original vertices, welded ones are written into a separate array
+        for (uint32_t vertexIdx = 0; vertexIdx < vertices.size(); ++vertexIdx)
+        {
+            auto [it, inserted] = uniqueVertices.emplace(vertexIdx, uint32_t(weldedVertices.size()));
+
+            if (inserted)
+            {
+                weldedVertices.push_back(vertices[vertexIdx]);
+            }
+
+            remap[vertexIdx] = it->second;
+        }
+
+        for (uint32_t& index : indices)
+        {
+            index = remap[index];
+        }
+
+        vertices = std::move(weldedVertices);
+
+        return vertices.size();
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, uint64_t vertexCount) const
+    {
+        uint64_t triangleCount = indices.size() / 3;
+        uint32_t cacheSize = mSettings.VertexCacheSize;
+
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        // Triangles adjacent to each vertex, live ones are kept at the front of each range
+        std::vector<uint32_t> liveTriangleCounts(vertexCount, 0);
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        std::vector<uint32_t> adjacency(triangleCount * 3);
+
+        for (uint32_t index : indices) ++liveTriangleCounts[index];
+
+        std::partial_sum(liveTriangleCounts.begin(), liveTriangleCounts.end(), adjacencyOffsets.begin() + 1);
+
+        std::vector<uint32_t> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+        for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            for (auto corner = 0u; corner < 3; ++corner)
+            {
+                adjacency[adjacencyFill[indices[triangleIdx * 3 + corner]]++] = triangleIdx;
+            }
+        }
+
+        std::vector<float> vertexScores(vertexCount);
+        std::vector<float> triangleScores(triangleCount, 0.0f);
+        std::vector<bool> emittedTriangles(triangleCount, false);
+
+        for (uint64_t vertexIdx = 0; vertexIdx < vertexCount; ++vertexIdx)
+        {
+            vertexScores[vertexIdx] = ForsythVertexScore(-1, liveTriangleCounts[vertexIdx], cacheSize);
+        }
+
+        for (uint64_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            const uint32_t* triangle = &indices[triangleIdx * 3];
+            triangleScores[triangleIdx] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+        }
+
+        std::vector<uint32_t> optimizedIndices;
+        optimizedIndices.reserve(indices.size());
+
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> newCache;
+        cache.reserve(cacheSize + 3);
+        newCache.reserve(cacheSize + 3);
+
+        int64_t bestTriangle = std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin();
+        uint64_t scanCursor = 0;
+
+        while (optimizedIndices.size() < indices.size())
+        {
+            // Nothing in cache is adjacent to live triangles, so continue with the next one in input order
+            if (bestTriangle < 0)
+            {
+                while (emittedTriangles[scanCursor]) ++scanCursor;
+                bestTriangle = scanCursor;
+            }
+
+            const uint32_t* triangle = &indices[bestTriangle * 3];
+            emittedTriangles[bestTriangle] = true;
+
+            newCache.clear();
+
+            for (auto corner = 0u; corner < 3; ++corner)
+            {
+                uint32_t vertex = triangle[corner];
+                optimizedIndices.push_back(vertex);
+
+                // Remove triangle from live adjacency of the vertex
+                uint32_t* first = &adjacency[adjacencyOffsets[vertex]];
+                uint32_t* last = first + liveTriangleCounts[vertex];
+                *std::find(first, last, uint32_t(bestTriangle)) = *(last - 1);
+                --liveTriangleCounts[vertex];
+
+                if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+                {
+                    newCache.push_back(vertex);
+                }
+            }
+
+            for (uint32_t vertex : cache)
+            {
+                if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+                {
+                    newCache.push_back(vertex);
+                }
+            }
+
+            // Vertices pushed out of cache lose their position score
+            for (uint64_t position = cacheSize; position < newCache.size(); ++position)
+            {
+                uint32_t vertex = newCache[position];
+                vertexScores[vertex] = ForsythVertexScore(-1, liveTriangleCounts[vertex], cacheSize);
+            }
+
+            newCache.resize(std::min<uint64_t>(newCache.size(), cacheSize));
+            std::swap(cache, newCache);
+
+            for (uint32_t position = 0; position < cache.size(); ++position)
+            {
+                uint32_t vertex = cache[position];
+                vertexScores[vertex] = ForsythVertexScore(position, liveTriangleCounts[vertex], cacheSize);
+            }
+
+            // Only live triangles of cached vertices are candidates for the next step
+            bestTriangle = -1;
+            float bestScore = -1.0f;
+
+            for (uint32_t vertex : cache)
+            {
+                const uint32_t* liveTriangles = &adjacency[adjacencyOffsets[vertex]];
+
+                for (uint32_t i = 0; i < liveTriangleCounts[vertex]; ++i)
+                {
+                    uint32_t triangleIdx = liveTriangles[i];
+                    const uint32_t* candidate = &indices[triangleIdx * 3];
+                    float score = vertexScores[candidate[0]] + vertexScores[candidate[1]] + vertexScores[candidate[2]];
+                    triangleScores[triangleIdx] = score;
+
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        bestTriangle = triangleIdx;
+                    }
+                }
+            }
+        }
+
+        indices = std::move(optimizedIndices);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex1P1N1UV1T1BT>& vertices) const
+    {
+        // Tom Forsyth's order is split into clusters at vertex cache restarts and, within those,
+        // at points that cost little in cache efficiency. Clusters are then ordered so that outward facing ones,
+        // which are likely to occlude the rest of the mesh, are drawn first, as in
+        // Sander et al. "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw".
+
+        uint32_t triangleCount = uint32_t(indices.size() / 3);
+
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        FIFOCacheSimulation cache{ vertices.size(), mSettings.AnalysisCacheSize };
+
+        // Hard boundaries: triangles with all three vertices missing the cache
+        std::vector<uint32_t> hardBoundaries;
+
+        for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            if (cache.MissCount(&indices[triangleIdx * 3]) == 3)
+            {
+                hardBoundaries.push_back(triangleIdx);
+            }
+        }
+
+        hardBoundaries.push_back(triangleCount);
+
+        // Soft boundaries split hard clusters where the prefix ACMR is within threshold of the whole cluster ACMR
+        std::vector<uint32_t> clusterStarts;
+
+        for (uint64_t hardIdx = 0; hardIdx + 1 < hardBoundaries.size(); ++hardIdx)
+        {
+            uint32_t start = hardBoundaries[hardIdx];
+            uint32_t end = hardBoundaries[hardIdx + 1];
+
+            cache.Reset();
+            uint32_t clusterMisses = 0;
+
+            for (uint32_t triangleIdx = start; triangleIdx < end; ++triangleIdx)
+            {
+                clusterMisses += cache.MissCount(&indices[triangleIdx * 3]);
+            }
+
+            float clusterACMR = float(clusterMisses) / float(end - start);
+            float targetACMR = clusterACMR * mSettings.OverdrawClusterThreshold;
+
+            cache.Reset();
+            clusterStarts.push_back(start);
+
+            uint32_t segmentStart = start;
+            uint32_t segmentMisses = 0;
+
+            for (uint32_t triangleIdx = start; triangleIdx < end; ++triangleIdx)
+            {
+                segmentMisses += cache.MissCount(&indices[triangleIdx * 3]);
+
+                if (triangleIdx + 1 < end && float(segmentMisses) / float(triangleIdx + 1 - segmentStart) <= targetACMR)
+                {
+                    segmentStart = triangleIdx + 1;
+                    segmentMisses = 0;
+                    clusterStarts.push_back(segmentStart);
+                    cache.Reset();
+                }
+            }
+        }
+
+        clusterStarts.push_back(triangleCount);
+
+        uint64_t clusterCount = clusterStarts.size() - 1;
+
+        auto position = [&vertices](uint32_t index) { return glm::vec3{ vertices[index].Position }; };
+
+        // Area weighted centroids and normals of the mesh and clusters
+        std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3{ 0.0f });
+        std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3{ 0.0f });
+        glm::vec3 meshCentroid{ 0.0f };
+        float meshArea = 0.0f;
+
+        for (uint64_t clusterIdx = 0; clusterIdx < clusterCount; ++clusterIdx)
+        {
+            float clusterArea = 0.0f;
+
+            for (uint32_t triangleIdx = clusterStarts[clusterIdx]; triangleIdx < clusterStarts[clusterIdx + 1]; ++triangleIdx)
+            {
+                glm::vec3 a = position(indices[triangleIdx * 3 + 0]);
+                glm::vec3 b = position(indices[triangleIdx * 3 + 1]);
+                glm::vec3 c = position(indices[triangleIdx * 3 + 2]);
+
+                glm::vec3 areaNormal = glm::cross(b - a, c - a);
+                float area = glm::length(areaNormal);
+
+                clusterCentroids[clusterIdx] += (a + b + c) * (area / 3.0f);
+                clusterNormals[clusterIdx] += areaNormal;
+                clusterArea += area;
+            }
+
+            meshCentroid += clusterCentroids[clusterIdx];
+            meshArea += clusterArea;
+
+            if (clusterArea > 0.0f) clusterCentroids[clusterIdx] /= clusterArea;
+        }
+
+        if (meshArea > 0.0f) meshCentroid /= meshArea;
+
+        std::vector<float> clusterSortKeys(clusterCount);
+
+        for (uint64_t clusterIdx = 0; clusterIdx < clusterCount; ++clusterIdx)
+        {
+            float normalLength = glm::length(clusterNormals[clusterIdx]);
+            glm::vec3 normal = normalLength > 0.0f ? clusterNormals[clusterIdx] / normalLength : glm::vec3{ 0.0f };
+            clusterSortKeys[clusterIdx] = glm::dot(clusterCentroids[clusterIdx] - meshCentroid, normal);
+        }
+
+        std::vector<uint32_t> clusterOrder(clusterCount);
+        std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+
+        std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&clusterSortKeys](uint32_t a, uint32_t b)
+        {
+            return clusterSortKeys[a] > clusterSortKeys[b];
+        });
+
+        std::vector<uint32_t> orderedIndices;
+        orderedIndices.reserve(indices.size());
+
+        for (uint32_t clusterIdx : clusterOrder)
+        {
+            auto first = indices.begin() + clusterStarts[clusterIdx] * 3;
+            auto last = indices.begin() + clusterStarts[clusterIdx + 1] * 3;
+            orderedIndices.insert(orderedIndices.end(), first, last);
+        }
+
+        indices = std::move(orderedIndices);
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex1P1N1UV1T1BT>& vertices, std::vector<uint32_t>& indices) const
+    {
+        const uint32_t Unassigned = std::numeric_limits<uint32_t>::max();
+
+        std::vector<uint32_t> remap(vertices.size(), Unassigned);
+        std::vector<Vertex1P1N1UV1T1BT> remappedVertices;
+        remappedVertices.reserve(vertices.size());
+
+        for (uint32_t& index : indices)
+        {
+            if (remap[index] == Unassigned)
+            {
+                remap[index] = uint32_t(remappedVertices.size());
+                remappedVertices.push_back(vertices[index]);
+            }
+
+            index = remap[index];
+        }
+
+        vertices = std::move(remappedVertices);
+    }
+
+    MeshOptimizer::Metrics MeshOptimizer::Analyze(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices) const
+    {
+        Metrics metrics;
+        AnalyzeVertexCache(indices, vertices.size(), metrics);
+        AnalyzeVertexFetch(indices, vertices.size(), metrics);
+        AnalyzeOverdraw(vertices, indices, metrics);
+        return metrics;
+    }
+
+    void MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint64_t vertexCount, Metrics& metrics) const
+    {
+        FIFOCacheSimulation cache{ vertexCount, mSettings.AnalysisCacheSize };
+        std::vector<bool> referenced(vertexCount, false);
+
+        uint64_t misses = 0;
+        uint64_t referencedCount = 0;
+
+        for (uint32_t index : indices)
+        {
+            misses += !cache.Access(index);
+
+            if (!referenced[index])
+            {
+                referenced[index] = true;
+                ++referencedCount;
+            }
+        }
+
+        uint64_t triangleCount = indices.size() / 3;
+
+        metrics.ACMR = triangleCount > 0 ? float(misses) / float(triangleCount) : 0.0f;
+        metrics.ATVR = referencedCount > 0 ? float(misses) / float(referencedCount) : 0.0f;
+    }
+
+    void MeshOptimizer::AnalyzeVertexFetch(const std::vector<uint32_t>& indices, uint64_t vertexCount, Metrics& metrics) const
+    {
+        uint64_t lineSize = mSettings.FetchCacheLineSize;
+        uint64_t stride = mSettings.FetchVertexStride;
+        uint64_t lineCount = (vertexCount * stride + lineSize - 1) / lineSize;
+
+        FIFOCacheSimulation cache{ lineCount, mSettings.FetchCacheLineCount };
+        std::vector<bool> referenced(vertexCount, false);
+
+        uint64_t fetchedBytes = 0;
+        uint64_t referencedBytes = 0;
+
+        for (uint32_t index : indices)
+        {
+            uint64_t firstLine = (index * stride) / lineSize;
+            uint64_t lastLine = (index * stride + stride - 1) / lineSize;
+
+            for (uint64_t line = firstLine; line <= lastLine; ++line)
+            {
+                fetchedBytes += cache.Access(uint32_t(line)) ? 0 : lineSize;
+            }
+
+            if (!referenced[index])
+            {
+                referenced[index] = true;
+                referencedBytes += stride;
+            }
+        }
+
+        metrics.Overfetch = referencedBytes > 0 ? float(fetchedBytes) / float(referencedBytes) : 0.0f;
+    }
+
+    void MeshOptimizer::AnalyzeOverdraw(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices, Metrics& metrics) const
+    {
+        // Mesh is fitted into a unit cube and rasterized in index order from both sides of each axis
+        // with depth test and back face culling, counting pixels that pass depth test against covered ones
+
+        if (vertices.empty() || indices.size() < 3)
+        {
+            return;
+        }
+
+        glm::vec3 boundsMin{ std::numeric_limits<float>::max() };
+        glm::vec3 boundsMax{ std::numeric_limits<float>::lowest() };
+
+        for (const Vertex1P1N1UV1T1BT& vertex : vertices)
+        {
+            boundsMin = glm::min(boundsMin, glm::vec3{ vertex.Position });
+            boundsMax = glm::max(boundsMax, glm::vec3{ vertex.Position });
+        }
+
+        glm::vec3 extent = boundsMax - boundsMin;
+        float maxExtent = std::max(std::max(extent.x, extent.y), extent.z);
+        float resolution = float(mSettings.OverdrawViewResolution);
+        float scale = maxExtent > 0.0f ? 1.0f / maxExtent : 0.0f;
+
+        uint32_t pixelCount = mSettings.OverdrawViewResolution * mSettings.OverdrawViewResolution;
+        std::vector<float> depthBuffers[2]{ std::vector<float>(pixelCount), std::vector<float>(pixelCount) };
+
+        uint64_t shadedPixels = 0;
+        uint64_t coveredPixels = 0;
+
+        for (auto axis = 0u; axis < 3; ++axis)
+        {
+            uint32_t axisU = (axis + 1) % 3;
+            uint32_t axisV = (axis + 2) % 3;
+
+            for (std::vector<float>& depthBuffer : depthBuffers)
+            {
+                std::fill(depthBuffer.begin(), depthBuffer.end(), std::numeric_limits<float>::max());
+            }
+
+            for (uint64_t triangleIdx = 0; triangleIdx < indices.size() / 3; ++triangleIdx)
+            {
+                glm::vec3 p[3];
+
+                for (auto corner = 0u; corner < 3; ++corner)
+                {
+                    glm::vec3 normalized = (glm::vec3{ vertices[indices[triangleIdx * 3 + corner]].Position } - boundsMin) * scale;
+                    p[corner] = glm::vec3{ normalized[axisU] * resolution, normalized[axisV] * resolution, normalized[axis] };
+                }
+
+                float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+
+                if (area == 0.0f)
+                {
+                    continue;
+                }
+
+                // Triangle faces exactly one of two opposite views: the one looking down the axis
+                // when its normal points along the axis, and the one looking up the axis otherwise.
+                // Depth grows away from the viewer in both.
+                uint32_t view = area > 0.0f ? 0 : 1;
+
+                if (view == 0)
+                {
+                    for (glm::vec3& point : p) point.z = 1.0f - point.z;
+                }
+                else
+                {
+                    std::swap(p[1], p[2]);
+                    area = -area;
+                }
+
+                std::vector<float>& depthBuffer = depthBuffers[view];
+
+                int32_t minX = std::max(int32_t(std::floor(std::min({ p[0].x, p[1].x, p[2].x }))), 0);
+                int32_t minY = std::max(int32_t(std::floor(std::min({ p[0].y, p[1].y, p[2].y }))), 0);
+                int32_t maxX = std::min(int32_t(std::ceil(std::max({ p[0].x, p[1].x, p[2].x }))), int32_t(resolution) - 1);
+                int32_t maxY = std::min(int32_t(std::ceil(std::max({ p[0].y, p[1].y, p[2].y }))), int32_t(resolution) - 1);
+
+                float areaInverse = 1.0f / area;
+
+                for (int32_t y = minY; y <= maxY; ++y)
+                {
+                    for (int32_t x = minX; x <= maxX; ++x)
+                    {
+                        float px = x + 0.5f;
+                        float py = y + 0.5f;
+
+                        float w0 = (p[2].x - p[1].x) * (py - p[1].y) - (p[2].y - p[1].y) * (px - p[1].x);
+                        float w1 = (p[0].x - p[2].x) * (py - p[2].y) - (p[0].y - p[2].y) * (px - p[2].x);
+                        float w2 = (p[1].x - p[0].x) * (py - p[0].y) - (p[1].y - p[0].y) * (px - p[0].x);
+
+                        if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                        {
+                            continue;
+                        }
+
+                        float depth = (w0 * p[0].z + w1 * p[1].z + w2 * p[2].z) * areaInverse;
+                        float& storedDepth = depthBuffer[y * mSettings.OverdrawViewResolution + x];
+
+                        if (depth < storedDepth)
+                        {
+                            storedDepth = depth;
+                            ++shadedPixels;
+                        }
+                    }
+                }
+            }
+
+            for (const std::vector<float>& depthBuffer : depthBuffers)
+            {
+                coveredPixels += std::count_if(depthBuffer.begin(), depthBuffer.end(), [](float depth) { return depth != std::numeric_limits<float>::max(); });
+            }
+        }
+
+        metrics.Overdraw = coveredPixels > 0 ? float(shadedPixels) / float(coveredPixels) : 0.0f;
+    }
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Offline reordering of mesh vertices and indices for GPU consumption.
+    ///
+    /// Steps run in order: duplicate vertex welding, vertex cache reordering (Forsyth),
+    /// overdraw aware reordering of triangle clusters and vertex fetch remapping.
+    /// Every step is measured with CPU simulations of the post-transform cache, vertex fetch and overdraw,
+    /// so import quality of each mesh can be tracked.
+    class MeshOptimizer
+    {
+    public:
+        struct Settings
+        {
+            // Size of the LRU cache modeled by the reordering heuristic
+            uint32_t VertexCacheSize = 32;
+
+            // Size of the FIFO cache used to measure ACMR and ATVR and to find cluster boundaries
+            uint32_t AnalysisCacheSize = 16;
+
+            // Clusters are split at points where their ACMR is within this factor of the unsplit sequence
+            float OverdrawClusterThreshold = 1.05f;
+
+            // Resolution of each of the six orthographic views rasterized by the overdraw estimate
+            uint32_t OverdrawViewResolution = 256;
+
+            // Vertex fetch is modeled as a FIFO cache of memory lines over vertices of this stride
+            uint32_t FetchVertexStride = sizeof(CompressedVertex1P1N1UV1T1BT);
+            uint32_t FetchCacheLineSize = 64;
+            uint32_t FetchCacheLineCount = 256;
+        };
+
+        struct Metrics
+        {
+            // Average cache miss ratio: transformed vertices per triangle, 0.5 at best for regular meshes, 3 at worst
+            float ACMR = 0.0f;
+
+            // Average transform to vertex ratio: transformed vertices per referenced vertex, 1 at best
+            float ATVR = 0.0f;
+
+            // Shaded pixels per covered pixel averaged over six axis aligned views, 1 at best
+            float Overdraw = 0.0f;
+
+            // Fetched bytes per byte of referenced vertex data, 1 at best
+            float Overfetch = 0.0f;
+        };
+
+        struct Statistics
+        {
+            uint64_t ImportedVertexCount = 0;
+            uint64_t WeldedVertexCount = 0;
+            uint64_t TriangleCount = 0;
+
+            // Metrics after each step
+            Metrics Imported;
+            Metrics Welded;
+            Metrics VertexCacheOptimized;
+            Metrics OverdrawOptimized;
+            Metrics VertexFetchOptimized;
+        };
+
+        MeshOptimizer() = default;
+        MeshOptimizer(const Settings& settings);
+
+        // Runs all steps on mesh geometry, non indexed meshes get an index buffer
+        Statistics Optimize(Mesh& mesh) const;
+
+        // Merges bitwise identical vertices. Returns number of remaining vertices.
+        uint64_t WeldVertices(std::vector<Vertex1P1N1UV1T1BT>& vertices, std::vector<uint32_t>& indices) const;
+
+        void OptimizeVertexCache(std::vector<uint32_t>& indices, uint64_t vertexCount) const;
+
+        // Expects indices already optimized for vertex cache
+        void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex1P1N1UV1T1BT>& vertices) const;
+
+        // Orders vertices by first use and drops unreferenced ones
+        void OptimizeVertexFetch(std::vector<Vertex1P1N1UV1T1BT>& vertices, std::vector<uint32_t>& indices) const;
+
+        Metrics Analyze(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices) const;
+
+    private:
+        void AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint64_t vertexCount, Metrics& metrics) const;
+        void AnalyzeVertexFetch(const std::vector<uint32_t>& indices, uint64_t vertexCount, Metrics& metrics) const;
+        void AnalyzeOverdraw(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices, Metrics& metrics) const;
+
+        Settings mSettings;
+
+    public:
+        inline const Settings& OptimizerSettings() const { return mSettings; }
+    };
+
+}
@@ -0,0 +1,862 @@
+#include "MeshSimplifier.hpp"
+
+#include <Foundation/HashUtils.hpp>
+#include <robinhood/robin_hood.h>
+
+#include <glm/geometric.hpp>
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cstring>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        const uint32_t NoVertex = std::numeric_limits<uint32_t>::max();
+
+        // Simplification attempts per LOD level with tightening quadric error limits
+        const uint32_t MaxLevelAttempts = 4;
+
+        enum class VertexKind : uint8_t
+        {
+            // Interior vertex with a single set of attributes
+            Manifold = 0,
+            // Vertex on an open border of the mesh
+            Border = 1,
+            // One of two vertices sharing a position on an attribute seam
+            Seam = 2,
+            // Seam junctions, seams reaching borders, non manifold vertices
+            Locked = 3
+        };
+
+        // Whether a vertex of one kind may be collapsed onto a vertex of another kind
+        const bool CanCollapse[4][4] = {
+            { true, true, true, true },
+            { false, true, false, false },
+            { false, false, true, false },
+            { false, false, false, false },
+        };
+
+        struct PositionHash
+        {
+            const std::vector<Vertex1P1N1UV1T1BT>* Vertices;
+
+            size_t operator()(uint32_t index) const
+            {
+                uint32_t words[3];
+                std::memcpy(words, &(*Vertices)[index].Position, sizeof(words));
+
+                uint64_t hash = 0;
+                for (uint32_t word : words) hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+                return Foundation::HashUtils::Mix(hash);
+            }
+        };
+
+        struct PositionEqual
+        {
+            const std::vector<Vertex1P1N1UV1T1BT>* Vertices;
+
+            bool operator()(uint32_t a, uint32_t b) const
+            {
+                return std::memcmp(&(*Vertices)[a].Position, &(*Vertices)[b].Position, sizeof(float) * 3) == 0;
+            }
+        };
+
+        // Sum of weighted squared distances to planes, Q(p) = p^T A p + 2 b^T p + c.
+        // Accumulated in doubles, positions far from the origin would lose the constant term in floats.
+        struct Quadric
+        {
+            double A00 = 0.0, A11 = 0.0, A22 = 0.0;
+            double A10 = 0.0, A20 = 0.0, A21 = 0.0;
+            double B0 = 0.0, B1 = 0.0, B2 = 0.0;
+            double C = 0.0;
+            double Weight = 0.0;
+
+            // Plane dot(normal, p) + distance = 0
+            static Quadric FromPlane(const glm::vec3& normal, float distance, float weight)
+            {
+                Quadric q;
+                q.A00 = weight * normal.x * normal.x;
+                q.A11 = weight * normal.y * normal.y;
+                q.A22 = weight * normal.z * normal.z;
+                q.A10 = weight * normal.y * normal.x;
+                q.A20 = weight * normal.z * normal.x;
+                q.A21 = weight * normal.z * normal.y;
+                q.B0 = weight * distance * normal.x;
+                q.B1 = weight * distance * normal.y;
+                q.B2 = weight * distance * normal.z;
+                q.C = double(weight) * distance * distance;
+                q.Weight = weight;
+                return q;
+            }
+
+            Quadric& operator+=(const Quadric& other)
+            {
+                A00 += other.A00; A11 += other.A11; A22 += other.A22;
+                A10 += other.A10; A20 += other.A20; A21 += other.A21;
+                B0 += other.B0; B1 += other.B1; B2 += other.B2;
+                C += other.C;
+                Weight += other.Weight;
+                return *this;
+            }
+
+            // Weighted mean squared distance to accumulated planes
+            float Error(const glm::vec3& p) const
+            {
+                double x = p.x, y = p.y, z = p.z;
+
+                double error =
+                    x * (A00 * x + A10 * y + A20 * z) +
+                    y * (A10 * x + A11 * y + A21 * z) +
+                    z * (A20 * x + A21 * y + A22 * z) +
+                    2.0 * (B0 * x + B1 * y + B2 * z) + C;
+
+                return Weight > 0.0 ? float(std::abs(error) / Weight) : 0.0f;
+            }
+        };
+
+        struct EdgeCollapse
+        {
+            uint32_t From;
+            uint32_t To;
+            float Error;
+        };
+
+        // Closest point search over triangle regions from Real-Time Collision Detection by C. Ericson
+        float PointTriangleDistance(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+        {
+            glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+            float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+            if (d1 <= 0.0f && d2 <= 0.0f) return glm::distance(p, a);
+
+            glm::vec3 bp = p - b;
+            float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+            if (d3 >= 0.0f && d4 <= d3) return glm::distance(p, b);
+
+            float vc = d1 * d4 - d3 * d2;
+            if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return glm::distance(p, a + ab * (d1 / (d1 - d3)));
+
+            glm::vec3 cp = p - c;
+            float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+            if (d6 >= 0.0f && d5 <= d6) return glm::distance(p, c);
+
+            float vb = d5 * d2 - d1 * d6;
+            if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return glm::distance(p, a + ac * (d2 / (d2 - d6)));
+
+            float va = d3 * d6 - d5 * d4;
+            if (va <= 0.0f && d4 >= d3 && d5 >= d6) return glm::distance(p, b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+
+            float denominator = va + vb + vc;
+
+            // Degenerate triangle, edges have been handled above
+            if (denominator <= 0.0f) return std::min({ glm::distance(p, a), glm::distance(p, b), glm::distance(p, c) });
+
+            return glm::distance(p, a + ab * (vb / denominator) + ac * (vc / denominator));
+        }
+    }
+
+    MeshSimplifier::MeshSimplifier(const Settings& settings)
+        : mSettings{ settings } {}
+
+    void MeshSimplifier::BuildLODChain(Mesh& mesh) const
+    {
+        std::vector<uint32_t> sequentialIndices;
+
+        if (mesh.Indices().empty())
+        {
+            sequentialIndices.resize(mesh.Vertices().size());
+            std::iota(sequentialIndices.begin(), sequentialIndices.end(), 0);
+        }
+
+        mesh.SetLODs(BuildLODChain(mesh.Vertices(), mesh.Indices().empty() ? sequentialIndices : mesh.Indices()));
+    }
+
+    std::vector<MeshLOD> MeshSimplifier::BuildLODChain(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices) const
+    {
+        assert_format(mSettings.LODCount <= MeshLOD::MaxCount, "LOD count exceeds the maximum kept per mesh");
+
+        std::vector<MeshLOD> lods;
+
+        if (vertices.empty() || indices.empty())
+        {
+            return lods;
+        }
+
+        glm::vec3 min{ vertices.front().Position };
+        glm::vec3 max{ vertices.front().Position };
+
+        for (const Vertex1P1N1UV1T1BT& vertex : vertices)
+        {
+            min = glm::min(min, glm::vec3{ vertex.Position });
+            max = glm::max(max, glm::vec3{ vertex.Position });
+        }
+
+        float maxError = glm::distance(min, max) * mSettings.MaxRelativeError;
+
+        // Owners are tracked across levels, so every level is measured against the base mesh
+        std::vector<uint32_t> owners(vertices.size());
+        std::iota(owners.begin(), owners.end(), 0);
+
+        for (uint32_t level = 0; level < mSettings.LODCount; ++level)
+        {
+            const std::vector<uint32_t>& source = lods.empty() ? indices : lods.back().Indices;
+            uint64_t targetIndexCount = uint64_t(source.size() / 3 * mSettings.TriangleRatio) * 3;
+
+            // Quadric error underestimates measured deviation on curved surfaces,
+            // so a level over the budget is retried with a proportionally tighter quadric limit
+            float quadricErrorLimit = maxError;
+            std::vector<uint32_t> simplified;
+            std::vector<uint32_t> levelOwners;
+            float error = std::numeric_limits<float>::max();
+
+            for (uint32_t attempt = 0; attempt < MaxLevelAttempts && error > maxError; ++attempt)
+            {
+                levelOwners = owners;
+                simplified = CollapseEdges(vertices, source, targetIndexCount, quadricErrorLimit, levelOwners);
+
+                if (simplified.empty() || simplified.size() > source.size() * (1.0f - mSettings.MinTriangleReduction))
+                {
+                    break;
+                }
+
+                error = MeasureDeviation(vertices, indices, simplified, levelOwners);
+                quadricErrorLimit *= std::min(0.5f, maxError / error);
+            }
+
+            if (error > maxError)
+            {
+                break;
+            }
+
+            // Errors are kept non decreasing along the chain, so LOD selection can stop at the first level over its limit
+            if (!lods.empty())
+            {
+                error = std::max(error, lods.back().Error);
+            }
+
+            owners = std::move(levelOwners);
+            lods.push_back(MeshLOD{ std::move(simplified), error });
+        }
+
+        return lods;
+    }
+
+    std::vector<uint32_t> MeshSimplifier::Simplify(
+        const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices,
+        uint64_t targetIndexCount, float targetError, float& resultError) const
+    {
+        std::vector<uint32_t> owners(vertices.size());
+        std::iota(owners.begin(), owners.end(), 0);
+
+        std::vector<uint32_t> result = CollapseEdges(vertices, indices, targetIndexCount, targetError, owners);
+        resultError = MeasureDeviation(vertices, indices, result, owners);
+
+        return result;
+    }
+
+    std::vector<uint32_t> MeshSimplifier::CollapseEdges(
+        const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices,
+        uint64_t targetIndexCount, float targetError, std::vector<uint32_t>& owners) const
+    {
+        std::vector<uint32_t> result = indices;
+
+        if (result.size() <= targetIndexCount || targetError <= 0.0f)
+        {
+            return result;
+        }
+
+        uint32_t vertexCount = uint32_t(vertices.size());
+
+        auto position = [&](uint32_t vertex) { return glm::vec3{ vertices[vertex].Position }; };
+
+        // Vertices sharing a position are linked into circular wedge lists, remap points to the first one of them
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<uint32_t> wedges(vertexCount);
+
+        {
+            robin_hood::unordered_flat_map<uint32_t, uint32_t, PositionHash, PositionEqual> positions{
+                0, PositionHash{ &vertices }, PositionEqual{ &vertices } };
+
+            positions.reserve(vertexCount);
+
+            for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                remap[vertex] = positions.emplace(vertex, vertex).first->second;
+                wedges[vertex] = vertex;
+
+                if (remap[vertex] != vertex)
+                {
+                    wedges[vertex] = wedges[remap[vertex]];
+                    wedges[remap[vertex]] = vertex;
+                }
+            }
+        }
+
+        // Directed edges of triangles, an edge without its opposite is open: a border or a side of a seam
+        std::vector<uint32_t> edgeOffsets(vertexCount + 1, 0);
+        std::vector<uint32_t> edgeTargets(result.size());
+
+        for (uint32_t index : result) ++edgeOffsets[index + 1];
+
+        std::partial_sum(edgeOffsets.begin(), edgeOffsets.end(), edgeOffsets.begin());
+
+        {
+            std::vector<uint32_t> edgeFill(edgeOffsets.begin(), edgeOffsets.end() - 1);
+
+            for (uint64_t corner = 0; corner < result.size(); ++corner)
+            {
+                uint64_t triangleStart = corner - corner % 3;
+                edgeTargets[edgeFill[result[corner]]++] = result[triangleStart + (corner + 1) % 3];
+            }
+        }
+
+        auto hasEdge = [&](uint32_t from, uint32_t to)
+        {
+            auto first = edgeTargets.begin() + edgeOffsets[from];
+            auto last = edgeTargets.begin() + edgeOffsets[from + 1];
+            return std::find(first, last, to) != last;
+        };
+
+        // Ends of open edges, a vertex itself marks multiple open edges
+        std::vector<uint32_t> openIncoming(vertexCount, NoVertex);
+        std::vector<uint32_t> openOutgoing(vertexCount, NoVertex);
+
+        for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            for (uint32_t edgeIdx = edgeOffsets[vertex]; edgeIdx < edgeOffsets[vertex + 1]; ++edgeIdx)
+            {
+                uint32_t target = edgeTargets[edgeIdx];
+
+                if (!hasEdge(target, vertex))
+                {
+                    openIncoming[target] = openIncoming[target] == NoVertex ? vertex : target;
+                    openOutgoing[vertex] = openOutgoing[vertex] == NoVertex ? target : vertex;
+                }
+            }
+        }
+
+        auto isSingleLink = [](uint32_t link, uint32_t vertex) { return link != NoVertex && link != vertex; };
+
+        std::vector<VertexKind> kinds(vertexCount, VertexKind::Locked);
+
+        for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            if (remap[vertex] != vertex)
+            {
+                continue;
+            }
+
+            if (wedges[vertex] == vertex)
+            {
+                if (openIncoming[vertex] == NoVertex && openOutgoing[vertex] == NoVertex)
+                {
+                    kinds[vertex] = VertexKind::Manifold;
+                }
+                else if (isSingleLink(openIncoming[vertex], vertex) && isSingleLink(openOutgoing[vertex], vertex))
+                {
+                    kinds[vertex] = VertexKind::Border;
+                }
+            }
+            else if (wedges[wedges[vertex]] == vertex)
+            {
+                // Each side of a seam has one open edge in and out, which run opposite to ones of the other side
+                uint32_t other = wedges[vertex];
+                uint32_t a = openIncoming[vertex], b = openOutgoing[vertex];
+                uint32_t c = openIncoming[other], d = openOutgoing[other];
+
+                if (isSingleLink(a, vertex) && isSingleLink(b, vertex) && isSingleLink(c, other) && isSingleLink(d, other) &&
+                    remap[a] == remap[d] && remap[b] == remap[c])
+                {
+                    kinds[vertex] = VertexKind::Seam;
+                }
+            }
+        }
+
+        for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            kinds[vertex] = kinds[remap[vertex]];
+        }
+
+        // Neighbours along a border or a seam side, the only vertices such vertices may collapse onto
+        std::vector<uint32_t> loop(vertexCount, NoVertex);
+        std::vector<uint32_t> loopBack(vertexCount, NoVertex);
+
+        for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+        {
+            if (kinds[vertex] == VertexKind::Border || kinds[vertex] == VertexKind::Seam)
+            {
+                loop[vertex] = openOutgoing[vertex];
+                loopBack[vertex] = openIncoming[vertex];
+            }
+        }
+
+        // Quadrics are kept per position, so all wedges of a vertex share them
+        std::vector<Quadric> quadrics(vertexCount);
+
+        for (uint64_t triangleStart = 0; triangleStart < result.size(); triangleStart += 3)
+        {
+            const uint32_t* triangle = &result[triangleStart];
+            glm::vec3 p0 = position(triangle[0]), p1 = position(triangle[1]), p2 = position(triangle[2]);
+
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float doubleArea = glm::length(normal);
+
+            if (doubleArea > 0.0f)
+            {
+                normal /= doubleArea;
+                Quadric q = Quadric::FromPlane(normal, -glm::dot(normal, p0), doubleArea * 0.5f);
+                for (auto corner = 0u; corner < 3; ++corner) quadrics[remap[triangle[corner]]] += q;
+            }
+
+            // Planes through open edges, perpendicular to their triangles, keep borders and seams from drifting sideways
+            for (auto corner = 0u; corner < 3; ++corner)
+            {
+                uint32_t from = triangle[corner];
+                uint32_t to = triangle[(corner + 1) % 3];
+
+                if (remap[from] == remap[to] || hasEdge(to, from))
+                {
+                    continue;
+                }
+
+                glm::vec3 edgeStart = position(from);
+                glm::vec3 edge = position(to) - edgeStart;
+                glm::vec3 opposite = position(triangle[(corner + 2) % 3]) - edgeStart;
+
+                float edgeLength = glm::length(edge);
+                if (edgeLength <= 0.0f) continue;
+                edge /= edgeLength;
+
+                glm::vec3 edgeNormal = opposite - edge * glm::dot(opposite, edge);
+                float edgeNormalLength = glm::length(edgeNormal);
+                if (edgeNormalLength <= 0.0f) continue;
+                edgeNormal /= edgeNormalLength;
+
+                Quadric q = Quadric::FromPlane(edgeNormal, -glm::dot(edgeNormal, edgeStart), edgeLength * edgeLength * mSettings.BoundaryWeight);
+                quadrics[remap[from]] += q;
+                quadrics[remap[to]] += q;
+            }
+        }
+
+        std::vector<uint32_t> triangleOffsets(vertexCount + 1);
+        std::vector<uint32_t> vertexTriangles;
+        std::vector<uint32_t> collapseRemap(vertexCount);
+        std::vector<bool> collapseLocked(vertexCount);
+        std::vector<EdgeCollapse> collapses;
+
+        float targetErrorSquared = targetError * targetError;
+
+        // Collapse of a vertex must not turn any of its remaining triangles over
+        auto hasTriangleFlip = [&](uint32_t from, uint32_t to)
+        {
+            glm::vec3 target = position(to);
+            uint32_t wedge = from;
+
+            do
+            {
+                for (uint32_t i = triangleOffsets[wedge]; i < triangleOffsets[wedge + 1]; ++i)
+                {
+                    const uint32_t* triangle = &result[vertexTriangles[i] * 3];
+
+                    // Triangles on the collapsed edge disappear
+                    if (remap[triangle[0]] == remap[to] || remap[triangle[1]] == remap[to] || remap[triangle[2]] == remap[to])
+                    {
+                        continue;
+                    }
+
+                    uint32_t corner = triangle[0] == wedge ? 0 : (triangle[1] == wedge ? 1 : 2);
+                    glm::vec3 a = position(wedge);
+                    glm::vec3 b = position(triangle[(corner + 1) % 3]);
+                    glm::vec3 c = position(triangle[(corner + 2) % 3]);
+
+                    if (glm::dot(glm::cross(b - a, c - a), glm::cross(b - target, c - target)) <= 0.0f)
+                    {
+                        return true;
+                    }
+                }
+
+                wedge = wedges[wedge];
+
+            } while (wedge != from);
+
+            return false;
+        };
+
+        // Triangles of a vertex take over the target wedge, so they must not use any other wedge of the target,
+        // as it happens around UV poles or seam junctions. Attributes of such triangles would end up mixed.
+        auto touchesOtherWedge = [&](uint32_t from, uint32_t to)
+        {
+            for (uint32_t i = triangleOffsets[from]; i < triangleOffsets[from + 1]; ++i)
+            {
+                const uint32_t* triangle = &result[vertexTriangles[i] * 3];
+
+                for (auto corner = 0u; corner < 3; ++corner)
+                {
+                    if (triangle[corner] != to && remap[triangle[corner]] == remap[to])
+                    {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        };
+
+        auto lockPosition = [&](uint32_t vertex)
+        {
+            uint32_t wedge = vertex;
+            do { collapseLocked[wedge] = true; wedge = wedges[wedge]; } while (wedge != vertex);
+        };
+
+        while (result.size() > targetIndexCount)
+        {
+            // Triangles around each vertex in current geometry
+            std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+            for (uint32_t index : result) ++triangleOffsets[index + 1];
+            std::partial_sum(triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin());
+
+            vertexTriangles.resize(result.size());
+            std::vector<uint32_t> triangleFill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+
+            for (uint64_t corner = 0; corner < result.size(); ++corner)
+            {
+                vertexTriangles[triangleFill[result[corner]]++] = uint32_t(corner / 3);
+            }
+
+            // Cheaper allowed direction of every edge
+            collapses.clear();
+
+            auto collapseError = [&](uint32_t from, uint32_t to)
+            {
+                VertexKind kind = kinds[from];
+
+                if (!CanCollapse[uint8_t(kind)][uint8_t(kinds[to])] ||
+                    ((kind == VertexKind::Border || kind == VertexKind::Seam) && loop[from] != to && loopBack[from] != to))
+                {
+                    return std::numeric_limits<float>::max();
+                }
+
+                return quadrics[remap[from]].Error(position(to));
+            };
+
+            for (uint64_t corner = 0; corner < result.size(); ++corner)
+            {
+                uint32_t a = result[corner];
+                uint32_t b = result[corner - corner % 3 + (corner + 1) % 3];
+
+                if (remap[a] == remap[b])
+                {
+                    continue;
+                }
+
+                float errorAB = collapseError(a, b);
+                float errorBA = collapseError(b, a);
+
+                if (std::min(errorAB, errorBA) == std::numeric_limits<float>::max())
+                {
+                    continue;
+                }
+
+                collapses.push_back(errorAB <= errorBA ? EdgeCollapse{ a, b, errorAB } : EdgeCollapse{ b, a, errorBA });
+            }
+
+            if (collapses.empty())
+            {
+                break;
+            }
+
+            auto cheaperCollapse = [](const EdgeCollapse& a, const EdgeCollapse& b) { return a.Error < b.Error; };
+
+            // Collapses far worse than the ones needed to reach the target are left for next passes,
+            // where cheaper collapses locked in this pass become available again.
+            // Only collapses within limits of the pass are sorted.
+            uint64_t triangleGoal = (result.size() - targetIndexCount + 2) / 3;
+            uint64_t edgeGoal = triangleGoal / 2;
+            float passErrorLimit = targetErrorSquared;
+
+            if (edgeGoal < collapses.size())
+            {
+                std::nth_element(collapses.begin(), collapses.begin() + edgeGoal, collapses.end(), cheaperCollapse);
+                passErrorLimit = std::min(passErrorLimit, collapses[edgeGoal].Error * 1.5f);
+            }
+
+            auto passCollapsesEnd = std::partition(collapses.begin(), collapses.end(),
+                [passErrorLimit](const EdgeCollapse& collapse) { return collapse.Error <= passErrorLimit; });
+
+            std::sort(collapses.begin(), passCollapsesEnd, cheaperCollapse);
+
+            std::iota(collapseRemap.begin(), collapseRemap.end(), 0);
+            std::fill(collapseLocked.begin(), collapseLocked.end(), false);
+
+            uint64_t removedTriangles = 0;
+
+            for (auto collapse = collapses.begin(); collapse != passCollapsesEnd && removedTriangles < triangleGoal; ++collapse)
+            {
+                uint32_t from = collapse->From;
+                uint32_t to = collapse->To;
+
+                if (collapseLocked[from] || collapseLocked[to])
+                {
+                    continue;
+                }
+
+                // Other side of a seam collapses along with it, onto the matching wedge of the target
+                uint32_t seamFrom = NoVertex;
+                uint32_t seamTo = NoVertex;
+
+                if (kinds[from] == VertexKind::Seam)
+                {
+                    seamFrom = wedges[from];
+                    seamTo = loop[from] == to ? loopBack[seamFrom] : loop[seamFrom];
+
+                    if (seamTo == NoVertex || remap[seamTo] != remap[to])
+                    {
+                        continue;
+                    }
+                }
+
+                if (hasTriangleFlip(from, to) || touchesOtherWedge(from, to) ||
+                    (seamFrom != NoVertex && touchesOtherWedge(seamFrom, seamTo)))
+                {
+                    continue;
+                }
+
+                collapseRemap[from] = to;
+
+                if (seamFrom != NoVertex)
+                {
+                    collapseRemap[seamFrom] = seamTo;
+                }
+
+                quadrics[remap[to]] += quadrics[remap[from]];
+
+                // Whole neighbourhood is locked, so flip tests of this pass see final positions
+                uint32_t wedge = from;
+
+                do
+                {
+                    for (uint32_t i = triangleOffsets[wedge]; i < triangleOffsets[wedge + 1]; ++i)
+                    {
+                        const uint32_t* triangle = &result[vertexTriangles[i] * 3];
+                        for (auto corner = 0u; corner < 3; ++corner) lockPosition(triangle[corner]);
+                    }
+
+                    wedge = wedges[wedge];
+
+                } while (wedge != from);
+
+                lockPosition(to);
+
+                removedTriangles += kinds[from] == VertexKind::Border ? 1 : 2;
+            }
+
+            if (removedTriangles == 0)
+            {
+                break;
+            }
+
+            uint64_t writeIdx = 0;
+
+            for (uint64_t triangleStart = 0; triangleStart < result.size(); triangleStart += 3)
+            {
+                uint32_t a = collapseRemap[result[triangleStart + 0]];
+                uint32_t b = collapseRemap[result[triangleStart + 1]];
+                uint32_t c = collapseRemap[result[triangleStart + 2]];
+
+                if (remap[a] != remap[b] && remap[b] != remap[c] && remap[c] != remap[a])
+                {
+                    result[writeIdx++] = a;
+                    result[writeIdx++] = b;
+                    result[writeIdx++] = c;
+                }
+            }
+
+            result.resize(writeIdx);
+
+            for (uint32_t& owner : owners)
+            {
+                owner = collapseRemap[owner];
+            }
+
+            // Loops skip over collapsed vertices
+            for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+            {
+                if (loop[vertex] != NoVertex)
+                {
+                    uint32_t next = loop[vertex];
+                    uint32_t remapped = collapseRemap[next];
+                    loop[vertex] = remapped == vertex ? (loop[next] != NoVertex ? collapseRemap[loop[next]] : NoVertex) : remapped;
+                }
+
+                if (loopBack[vertex] != NoVertex)
+                {
+                    uint32_t previous = loopBack[vertex];
+                    uint32_t remapped = collapseRemap[previous];
+                    loopBack[vertex] = remapped == vertex ? (loopBack[previous] != NoVertex ? collapseRemap[loopBack[previous]] : NoVertex) : remapped;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    float MeshSimplifier::MeasureDeviation(
+        const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& sourceIndices,
+        const std::vector<uint32_t>& simplifiedIndices, const std::vector<uint32_t>& owners) const
+    {
+        uint32_t triangleCount = uint32_t(simplifiedIndices.size() / 3);
+
+        if (triangleCount == 0)
+        {
+            return std::numeric_limits<float>::max();
+        }
+
+        auto trianglePosition = [&](uint32_t triangleIdx, uint32_t corner)
+        {
+            return glm::vec3{ vertices[simplifiedIndices[triangleIdx * 3 + corner]].Position };
+        };
+
+        auto triangleDistance = [&](const glm::vec3& p, uint32_t triangleIdx)
+        {
+            return PointTriangleDistance(p, trianglePosition(triangleIdx, 0), trianglePosition(triangleIdx, 1), trianglePosition(triangleIdx, 2));
+        };
+
+        std::vector<uint32_t> triangleOffsets(vertices.size() + 1, 0);
+        std::vector<uint32_t> vertexTriangles(simplifiedIndices.size());
+
+        for (uint32_t index : simplifiedIndices) ++triangleOffsets[index + 1];
+
+        std::partial_sum(triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin());
+
+        std::vector<uint32_t> triangleFill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+
+        for (uint64_t corner = 0; corner < simplifiedIndices.size(); ++corner)
+        {
+            vertexTriangles[triangleFill[simplifiedIndices[corner]]++] = uint32_t(corner / 3);
+        }
+
+        // Triangles are binned into a uniform grid with cells of about their size.
+        // Cell coordinates wrap around, which only adds candidates to a search.
+        float cellSize = 0.0f;
+
+        for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            glm::vec3 a = trianglePosition(triangleIdx, 0), b = trianglePosition(triangleIdx, 1), c = trianglePosition(triangleIdx, 2);
+            glm::vec3 extent = glm::max(glm::max(a, b), c) - glm::min(glm::min(a, b), c);
+            cellSize += std::max({ extent.x, extent.y, extent.z });
+        }
+
+        cellSize = std::max(cellSize / triangleCount, std::numeric_limits<float>::epsilon());
+
+        auto cellCoordinates = [cellSize](const glm::vec3& p) { return glm::ivec3{ glm::floor(p / cellSize) }; };
+
+        auto cellKey = [](int32_t x, int32_t y, int32_t z)
+        {
+            const uint64_t Mask = (1ull << 21) - 1;
+            return ((uint64_t(uint32_t(x)) & Mask) << 42) | ((uint64_t(uint32_t(y)) & Mask) << 21) | (uint64_t(uint32_t(z)) & Mask);
+        };
+
+        auto forEachTriangleCell = [&](uint32_t triangleIdx, auto&& function)
+        {
+            glm::vec3 a = trianglePosition(triangleIdx, 0), b = trianglePosition(triangleIdx, 1), c = trianglePosition(triangleIdx, 2);
+            glm::ivec3 first = cellCoordinates(glm::min(glm::min(a, b), c));
+            glm::ivec3 last = cellCoordinates(glm::max(glm::max(a, b), c));
+
+            for (int32_t x = first.x; x <= last.x; ++x)
+                for (int32_t y = first.y; y <= last.y; ++y)
+                    for (int32_t z = first.z; z <= last.z; ++z)
+                        function(cellKey(x, y, z));
+        };
+
+        // Cell key to a range of cellTriangles
+        robin_hood::unordered_flat_map<uint64_t, std::pair<uint32_t, uint32_t>> cells;
+        cells.reserve(triangleCount);
+
+        for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            forEachTriangleCell(triangleIdx, [&](uint64_t key) { ++cells[key].second; });
+        }
+
+        uint32_t cellOffset = 0;
+
+        for (auto& [key, range] : cells)
+        {
+            range.first = cellOffset;
+            cellOffset += range.second;
+            range.second = range.first;
+        }
+
+        std::vector<uint32_t> cellTriangles(cellOffset);
+
+        for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            forEachTriangleCell(triangleIdx, [&](uint64_t key) { cellTriangles[cells[key].second++] = triangleIdx; });
+        }
+
+        // Searches reaching further keep the bound from triangles around the owner
+        const uint64_t MaxSearchedCellCount = 512;
+
+        std::vector<bool> measured(vertices.size(), false);
+        float deviation = 0.0f;
+
+        for (uint32_t vertex : sourceIndices)
+        {
+            if (measured[vertex])
+            {
+                continue;
+            }
+
+            measured[vertex] = true;
+
+            glm::vec3 p{ vertices[vertex].Position };
+            uint32_t owner = owners[vertex];
+
+            // Owner lies on the result surface, so distances to it and to its triangles bound the distance to the surface
+            float distance = glm::distance(p, glm::vec3{ vertices[owner].Position });
+
+            for (uint32_t i = triangleOffsets[owner]; i < triangleOffsets[owner + 1]; ++i)
+            {
+                distance = std::min(distance, triangleDistance(p, vertexTriangles[i]));
+            }
+
+            // Only triangles within the bound can be closer
+            glm::ivec3 first = cellCoordinates(p - distance);
+            glm::ivec3 last = cellCoordinates(p + distance);
+            uint64_t cellCount = uint64_t(last.x - first.x + 1) * uint64_t(last.y - first.y + 1) * uint64_t(last.z - first.z + 1);
+
+            if (distance > 0.0f && cellCount <= MaxSearchedCellCount)
+            {
+                for (int32_t x = first.x; x <= last.x; ++x)
+                {
+                    for (int32_t y = first.y; y <= last.y; ++y)
+                    {
+                        for (int32_t z = first.z; z <= last.z; ++z)
+                        {
+                            auto cell = cells.find(cellKey(x, y, z));
+
+                            if (cell == cells.end())
+                            {
+                                continue;
+                            }
+
+                            for (uint32_t i = cell->second.first; i < cell->second.second; ++i)
+                            {
+                                distance = std::min(distance, triangleDistance(p, cellTriangles[i]));
+                            }
+                        }
+                    }
+                }
+            }
+
+            deviation = std::max(deviation, distance);
+        }
+
+        return deviation;
+    }
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "MeshLOD.hpp"
+#include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Index buffer simplification by edge collapses ordered by quadric error.
+    ///
+    /// Vertices sharing a position with different attributes form seams, such as UV or hard normal seams.
+    /// Seam and border vertices only collapse along their seam or border, both sides of a seam at once,
+    /// and planes through seam and border edges are added to quadrics, so outlines of UV charts and open
+    /// borders stay in place. Vertices on seam junctions, non manifold or otherwise complex ones never move.
+    /// Collapses are never done onto new positions, so simplified levels reuse vertices of the source geometry.
+    ///
+    /// Quadric error only orders collapses and stops them, it underestimates deviation on curved surfaces.
+    /// Reported errors are measured afterwards as largest distances from source vertices to the result surface.
+    class MeshSimplifier
+    {
+    public:
+        struct Settings
+        {
+            // Simplified levels built at most, limited by MeshLOD::MaxCount
+            uint32_t LODCount = MeshLOD::MaxCount;
+
+            // Each level targets this fraction of triangles of the previous one
+            float TriangleRatio = 0.5f;
+
+            // Chain ends when a level deviates from the base mesh by more than this fraction of bounding box diagonal
+            float MaxRelativeError = 0.02f;
+
+            // or when it can't remove at least this fraction of triangles of the previous level
+            float MinTriangleReduction = 0.1f;
+
+            // Quadrics of planes through seam and border edges are weighted up relative to triangle planes
+            float BoundaryWeight = 10.0f;
+        };
+
+        MeshSimplifier() = default;
+        MeshSimplifier(const Settings& settings);
+
+        // Replaces LODs of the mesh, non indexed meshes are treated as having sequential indices
+        void BuildLODChain(Mesh& mesh) const;
+
+        std::vector<MeshLOD> BuildLODChain(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices) const;
+
+        // Collapses edges until index count is at most target count or until quadric error of next collapse
+        // exceeds target error in mesh space units. Measured deviation of source vertices is written to resultError.
+        std::vector<uint32_t> Simplify(
+            const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices,
+            uint64_t targetIndexCount, float targetError, float& resultError) const;
+
+    private:
+        // Owners of vertices are redirected to vertices they are collapsed into
+        std::vector<uint32_t> CollapseEdges(
+            const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices,
+            uint64_t targetIndexCount, float targetError, std::vector<uint32_t>& owners) const;
+
+        // Largest distance from vertices of source indices to triangles of simplified indices.
+        // Triangles around owners give an initial bound, which is then refined by a search in a uniform grid.
+        float MeasureDeviation(
+            const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& sourceIndices,
+            const std::vector<uint32_t>& simplifiedIndices, const std::vector<uint32_t>& owners) const;
+
+        Settings mSettings;
+
+    public:
+        inline const Settings& SimplifierSettings() const { return mSettings; }
+    };
+
+}
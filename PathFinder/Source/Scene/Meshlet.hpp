@@ -0,0 +1,37 @@
+#pragma once
+
+#include <Geometry/AxisAlignedBox3D.hpp>
+
+#include <glm/vec3.hpp>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Cluster of mesh triangles small enough to be culled as a unit.
+    ///
+    /// Meshlet references a range of Mesh::MeshletVertices(), which are indices of mesh vertices,
+    /// and a range of Mesh::MeshletTriangles(), which are triples of local indices into that vertex range.
+    struct Meshlet
+    {
+        uint32_t VertexOffset = 0;
+        uint32_t VertexCount = 0;
+
+        // In triangles, local indices start at 3 * TriangleOffset
+        uint32_t TriangleOffset = 0;
+        uint32_t TriangleCount = 0;
+
+        glm::vec3 BoundingSphereCenter{ 0.0f };
+        float BoundingSphereRadius = 0.0f;
+
+        // All triangles are back facing and meshlet can be skipped when
+        // dot(normalize(ConeApex - cameraPosition), ConeAxis) > ConeCutoff.
+        // Meshlets with normals spread over a hemisphere or more have a cutoff of 1 and are never culled this way.
+        glm::vec3 ConeAxis{ 0.0f, 0.0f, 1.0f };
+        float ConeCutoff = 1.0f;
+        glm::vec3 ConeApex{ 0.0f };
+
+        Geometry::AxisAlignedBox3D BoundingBox;
+    };
+
+}
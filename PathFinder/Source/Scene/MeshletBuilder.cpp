@@ -0,0 +1,350 @@
+#include "MeshletBuilder.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    MeshletBuilder::MeshletBuilder(const Settings& settings)
+        : mSettings{ settings } {}
+
+    void MeshletBuilder::Build(Mesh& mesh) const
+    {
+        std::vector<uint32_t> sequentialIndices;
+
+        if (mesh.Indices().empty())
+        {
+            sequentialIndices.resize(mesh.Vertices().size());
+            std::iota(sequentialIndices.begin(), sequentialIndices.end(), 0);
+        }
+
+        Result result = Build(mesh.Vertices(), mesh.Indices().empty() ? sequentialIndices : mesh.Indices());
+        mesh.SetMeshlets(std::move(result.Meshlets), std::move(result.Vertices), std::move(result.Triangles));
+    }
+
+    MeshletBuilder::Result MeshletBuilder::Build(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices) const
+    {
+        const uint8_t NotInMeshlet = std::numeric_limits<uint8_t>::max();
+
+        assert_format(mSettings.MaxVertexCount >= 3 && mSettings.MaxVertexCount < NotInMeshlet, "Meshlet vertex count limit must fit into 8 bit local indices");
+        assert_format(mSettings.MaxTriangleCount > 0, "Meshlet triangle count limit must be positive");
+
+        Result result;
+
+        uint32_t triangleCount = uint32_t(indices.size() / 3);
+
+        if (triangleCount == 0)
+        {
+            return result;
+        }
+
+        // Triangles adjacent to each vertex, ones not yet in any meshlet are kept at the front of each range
+        std::vector<uint32_t> liveTriangleCounts(vertices.size(), 0);
+        std::vector<uint32_t> adjacencyOffsets(vertices.size() + 1, 0);
+        std::vector<uint32_t> adjacency(triangleCount * 3);
+
+        for (uint32_t index : indices) ++liveTriangleCounts[index];
+
+        std::partial_sum(liveTriangleCounts.begin(), liveTriangleCounts.end(), adjacencyOffsets.begin() + 1);
+
+        std::vector<uint32_t> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+
+        for (uint32_t triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            for (auto corner = 0u; corner < 3; ++corner)
+            {
+                adjacency[adjacencyFill[indices[triangleIdx * 3 + corner]]++] = triangleIdx;
+            }
+        }
+
+        std::vector<bool> emittedTriangles(triangleCount, false);
+        std::vector<uint8_t> localIndices(vertices.size(), NotInMeshlet);
+
+        auto triangleCentroid = [&](uint32_t triangleIdx)
+        {
+            const uint32_t* triangle = &indices[triangleIdx * 3];
+            return (glm::vec3{ vertices[triangle[0]].Position } + glm::vec3{ vertices[triangle[1]].Position } + glm::vec3{ vertices[triangle[2]].Position }) / 3.0f;
+        };
+
+        Meshlet meshlet;
+        glm::vec3 centroidSum{ 0.0f };
+        uint32_t lastTriangle = 0;
+        uint32_t emittedCount = 0;
+        uint32_t scanCursor = 0;
+
+        auto newVertexCount = [&](uint32_t triangleIdx)
+        {
+            const uint32_t* triangle = &indices[triangleIdx * 3];
+            uint32_t count = localIndices[triangle[0]] == NotInMeshlet;
+            count += localIndices[triangle[1]] == NotInMeshlet && triangle[1] != triangle[0];
+            count += localIndices[triangle[2]] == NotInMeshlet && triangle[2] != triangle[0] && triangle[2] != triangle[1];
+            return count;
+        };
+
+        auto addTriangle = [&](uint32_t triangleIdx)
+        {
+            for (auto corner = 0u; corner < 3; ++corner)
+            {
+                uint32_t vertex = indices[triangleIdx * 3 + corner];
+
+                if (localIndices[vertex] == NotInMeshlet)
+                {
+                    localIndices[vertex] = uint8_t(meshlet.VertexCount++);
+                    result.Vertices.push_back(vertex);
+                }
+
+                result.Triangles.push_back(localIndices[vertex]);
+
+                uint32_t* first = &adjacency[adjacencyOffsets[vertex]];
+                uint32_t* last = first + liveTriangleCounts[vertex];
+                *std::find(first, last, triangleIdx) = *(last - 1);
+                --liveTriangleCounts[vertex];
+            }
+
+            emittedTriangles[triangleIdx] = true;
+            centroidSum += triangleCentroid(triangleIdx);
+            lastTriangle = triangleIdx;
+            ++meshlet.TriangleCount;
+            ++emittedCount;
+        };
+
+        // Among live triangles around given vertices, picks one that fits into the meshlet and adds fewest vertices,
+        // breaking ties by distance to meshlet center
+        auto bestCandidate = [&](const uint32_t* sourceVertices, uint32_t sourceVertexCount) -> int64_t
+        {
+            if (meshlet.TriangleCount >= mSettings.MaxTriangleCount)
+            {
+                return -1;
+            }
+
+            glm::vec3 center = centroidSum / float(meshlet.TriangleCount);
+
+            int64_t best = -1;
+            uint32_t bestNewVertexCount = std::numeric_limits<uint32_t>::max();
+            float bestDistance = std::numeric_limits<float>::max();
+
+            for (uint32_t sourceIdx = 0; sourceIdx < sourceVertexCount; ++sourceIdx)
+            {
+                uint32_t vertex = sourceVertices[sourceIdx];
+                const uint32_t* liveTriangles = &adjacency[adjacencyOffsets[vertex]];
+
+                for (uint32_t i = 0; i < liveTriangleCounts[vertex]; ++i)
+                {
+                    uint32_t triangleIdx = liveTriangles[i];
+                    uint32_t extraVertices = newVertexCount(triangleIdx);
+
+                    if (meshlet.VertexCount + extraVertices > mSettings.MaxVertexCount || extraVertices > bestNewVertexCount)
+                    {
+                        continue;
+                    }
+
+                    float distance = glm::distance2(triangleCentroid(triangleIdx), center);
+
+                    if (extraVertices < bestNewVertexCount || distance < bestDistance)
+                    {
+                        best = triangleIdx;
+                        bestNewVertexCount = extraVertices;
+                        bestDistance = distance;
+                    }
+                }
+            }
+
+            return best;
+        };
+
+        auto finishMeshlet = [&]()
+        {
+            ComputeBounds(vertices, result, meshlet);
+            result.Meshlets.push_back(meshlet);
+
+            for (uint32_t i = 0; i < meshlet.VertexCount; ++i)
+            {
+                localIndices[result.Vertices[meshlet.VertexOffset + i]] = NotInMeshlet;
+            }
+
+            meshlet = Meshlet{};
+            meshlet.VertexOffset = uint32_t(result.Vertices.size());
+            meshlet.TriangleOffset = uint32_t(result.Triangles.size() / 3);
+            centroidSum = glm::vec3{ 0.0f };
+        };
+
+        while (emittedCount < triangleCount)
+        {
+            int64_t next = -1;
+
+            if (meshlet.TriangleCount > 0)
+            {
+                // Neighbours of the last triangle first, they are cheap to look through and usually contain the best pick
+                next = bestCandidate(&indices[lastTriangle * 3], 3);
+
+                if (next < 0)
+                {
+                    next = bestCandidate(&result.Vertices[meshlet.VertexOffset], meshlet.VertexCount);
+                }
+
+                if (next < 0)
+                {
+                    // Next meshlet continues from the border of this one when possible
+                    for (uint32_t i = 0; i < meshlet.VertexCount && next < 0; ++i)
+                    {
+                        uint32_t vertex = result.Vertices[meshlet.VertexOffset + i];
+                        if (liveTriangleCounts[vertex] > 0) next = adjacency[adjacencyOffsets[vertex]];
+                    }
+
+                    finishMeshlet();
+                }
+            }
+
+            if (next < 0)
+            {
+                while (emittedTriangles[scanCursor]) ++scanCursor;
+                next = scanCursor;
+            }
+
+            addTriangle(uint32_t(next));
+        }
+
+        finishMeshlet();
+
+        return result;
+    }
+
+    void MeshletBuilder::ComputeBounds(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const Result& result, Meshlet& meshlet) const
+    {
+        auto position = [&](uint32_t localIndex)
+        {
+            return glm::vec3{ vertices[result.Vertices[meshlet.VertexOffset + localIndex]].Position };
+        };
+
+        meshlet.BoundingBox = Geometry::AxisAlignedBox3D{ position(0), position(0) };
+
+        for (uint32_t i = 1; i < meshlet.VertexCount; ++i)
+        {
+            meshlet.BoundingBox.Min = glm::min(meshlet.BoundingBox.Min, position(i));
+            meshlet.BoundingBox.Max = glm::max(meshlet.BoundingBox.Max, position(i));
+        }
+
+        // Ritter's bounding sphere: start from the most distant pair of axis extremes and grow to enclose outliers
+        uint32_t extremes[3][2] = {};
+
+        for (uint32_t i = 0; i < meshlet.VertexCount; ++i)
+        {
+            glm::vec3 p = position(i);
+
+            for (auto axis = 0u; axis < 3; ++axis)
+            {
+                if (p[axis] < position(extremes[axis][0])[axis]) extremes[axis][0] = i;
+                if (p[axis] > position(extremes[axis][1])[axis]) extremes[axis][1] = i;
+            }
+        }
+
+        uint32_t spanAxis = 0;
+
+        for (auto axis = 1u; axis < 3; ++axis)
+        {
+            if (glm::distance2(position(extremes[axis][0]), position(extremes[axis][1])) >
+                glm::distance2(position(extremes[spanAxis][0]), position(extremes[spanAxis][1])))
+            {
+                spanAxis = axis;
+            }
+        }
+
+        glm::vec3 center = (position(extremes[spanAxis][0]) + position(extremes[spanAxis][1])) * 0.5f;
+        float radius = glm::distance(position(extremes[spanAxis][0]), position(extremes[spanAxis][1])) * 0.5f;
+
+        for (uint32_t i = 0; i < meshlet.VertexCount; ++i)
+        {
+            float distance = glm::distance(position(i), center);
+
+            if (distance > radius)
+            {
+                float newRadius = (radius + distance) * 0.5f;
+                center += (position(i) - center) * ((newRadius - radius) / distance);
+                radius = newRadius;
+            }
+        }
+
+        // Radius is recomputed exactly, so rounding while growing can't leave vertices outside
+        radius = 0.0f;
+
+        for (uint32_t i = 0; i < meshlet.VertexCount; ++i)
+        {
+            radius = std::max(radius, glm::distance(position(i), center));
+        }
+
+        meshlet.BoundingSphereCenter = center;
+        meshlet.BoundingSphereRadius = radius;
+
+        // Normal cone over unit normals of non degenerate triangles
+        const uint8_t* triangles = &result.Triangles[meshlet.TriangleOffset * 3];
+        glm::vec3 normalSum{ 0.0f };
+
+        auto triangleNormal = [&](uint32_t triangleIdx, glm::vec3& normal)
+        {
+            glm::vec3 a = position(triangles[triangleIdx * 3 + 0]);
+            glm::vec3 areaNormal = glm::cross(position(triangles[triangleIdx * 3 + 1]) - a, position(triangles[triangleIdx * 3 + 2]) - a);
+            float length = glm::length(areaNormal);
+            normal = length > 0.0f ? areaNormal / length : glm::vec3{ 0.0f };
+            return length > 0.0f;
+        };
+
+        for (uint32_t triangleIdx = 0; triangleIdx < meshlet.TriangleCount; ++triangleIdx)
+        {
+            glm::vec3 normal;
+            if (triangleNormal(triangleIdx, normal)) normalSum += normal;
+        }
+
+        meshlet.ConeAxis = glm::vec3{ 0.0f, 0.0f, 1.0f };
+        meshlet.ConeCutoff = 1.0f;
+        meshlet.ConeApex = center;
+
+        float normalSumLength = glm::length(normalSum);
+
+        if (normalSumLength <= 0.0f)
+        {
+            return;
+        }
+
+        glm::vec3 axis = normalSum / normalSumLength;
+        float minDot = 1.0f;
+
+        for (uint32_t triangleIdx = 0; triangleIdx < meshlet.TriangleCount; ++triangleIdx)
+        {
+            glm::vec3 normal;
+            if (triangleNormal(triangleIdx, normal)) minDot = std::min(minDot, glm::dot(axis, normal));
+        }
+
+        meshlet.ConeAxis = axis;
+
+        // Normals spread over a hemisphere, some triangle faces any camera
+        if (minDot <= 0.0f)
+        {
+            return;
+        }
+
+        // Apex is moved along the axis behind every triangle plane,
+        // so any camera inside the culling cone is behind all of them
+        float maxT = std::numeric_limits<float>::lowest();
+
+        for (uint32_t triangleIdx = 0; triangleIdx < meshlet.TriangleCount; ++triangleIdx)
+        {
+            glm::vec3 normal;
+
+            if (triangleNormal(triangleIdx, normal))
+            {
+                glm::vec3 a = position(triangles[triangleIdx * 3 + 0]);
+                maxT = std::max(maxT, glm::dot(center - a, normal) / glm::dot(axis, normal));
+            }
+        }
+
+        meshlet.ConeApex = center - axis * maxT;
+        meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+
+}
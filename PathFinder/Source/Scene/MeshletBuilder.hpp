@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "Meshlet.hpp"
+#include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Splits mesh triangles into meshlets bounded by vertex and triangle counts.
+    ///
+    /// Meshlets are grown greedily over triangle adjacency, preferring triangles that add fewest new vertices
+    /// and then ones closest to the meshlet, starting from triangles in index order.
+    /// Index order is expected to be optimized for vertex cache already, which keeps seeds spatially coherent.
+    class MeshletBuilder
+    {
+    public:
+        struct Settings
+        {
+            // Limits of mesh shader outputs commonly recommended for current hardware.
+            // Vertex count must fit into 8 bit local indices.
+            uint32_t MaxVertexCount = 64;
+            uint32_t MaxTriangleCount = 124;
+        };
+
+        struct Result
+        {
+            std::vector<Meshlet> Meshlets;
+            std::vector<uint32_t> Vertices;
+            std::vector<uint8_t> Triangles;
+        };
+
+        MeshletBuilder() = default;
+        MeshletBuilder(const Settings& settings);
+
+        // Replaces meshlets of the mesh, non indexed meshes are treated as having sequential indices
+        void Build(Mesh& mesh) const;
+
+        Result Build(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices) const;
+
+    private:
+        void ComputeBounds(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const Result& result, Meshlet& meshlet) const;
+
+        Settings mSettings;
+
+    public:
+        inline const Settings& BuilderSettings() const { return mSettings; }
+    };
+
+}
@@ -175,7 +175,7 @@ namespace PathFinder
 
         HAL::TextureProperties properties{ format, kind, dimensions, HAL::ResourceState::AnyShaderAccess, (uint16_t)textureInfo.num_mips };
 
-        return mResourceProducer->NewTexture(properties);
+        return mResourceProducer->NewTexture(properties, Memory::MemoryCategory::SceneTexture);
     }
 
 }
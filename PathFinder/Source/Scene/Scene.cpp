@@ -1,10 +1,7 @@
 #include "Scene.hpp"
+#include "MaterialLoader.hpp"
 
-#include <bitsery/bitsery.h>
-#include <bitsery/adapter/buffer.h>
-#include <bitsery/traits/vector.h>
-
-#include <fstream>
+#include <robinhood/robin_hood.h>
 
 namespace PathFinder 
 {
@@ -15,16 +12,19 @@ namespace PathFinder
         LoadUtilityResources();
     }
 
-    Mesh& Scene::AddMesh(Mesh&& mesh)
+    template <class Entity, class... Args>
+    EntityID Scene::EmplaceEntity(Foundation::SlotMap<Entity>& entities, EntityType type, Args&&... args)
     {
-        mMeshes.emplace_back(std::move(mesh));
-        return mMeshes.back();
+        Foundation::SlotMapHandle handle = entities.Emplace(std::forward<Args>(args)...);
+        EntityID id{ handle, type };
+        entities.Get(handle)->SetEntityID(id);
+        return id;
     }
 
-    MeshInstance& Scene::AddMeshInstance(MeshInstance&& instance)
+    Mesh& Scene::AddMesh(Mesh&& mesh)
     {
-        mMeshInstances.emplace_back(std::move(instance));
-        return mMeshInstances.back();
+        mMeshes.emplace_back(std::move(mesh));
+        return mMeshes.back();
     }
 
     Material& Scene::AddMaterial(Material&& material)
@@ -33,82 +33,212 @@ namespace PathFinder
         return mMaterials.back();
     }
 
-    Scene::FlatLightIt Scene::EmplaceDiskLight()
+    EntityID Scene::AddMeshInstance(MeshInstance&& instance)
+    {
+        return EmplaceEntity(mMeshInstances, EntityType::MeshInstance, std::move(instance));
+    }
+
+    EntityID Scene::EmplaceDiskLight()
+    {
+        return EmplaceEntity(mDiskLights, EntityType::DiskLight, FlatLight::Type::Disk);
+    }
+
+    EntityID Scene::EmplaceRectangularLight()
+    {
+        return EmplaceEntity(mRectangularLights, EntityType::RectangularLight, FlatLight::Type::Rectangle);
+    }
+
+    EntityID Scene::EmplaceSphericalLight()
+    {
+        return EmplaceEntity(mSphericalLights, EntityType::SphericalLight);
+    }
+
+    bool Scene::RemoveEntity(const EntityID& id)
     {
-        mDiskLights.emplace_back(FlatLight::Type::Disk);
-        return std::prev(mDiskLights.end());
+        switch (id.Type)
+        {
+        case EntityType::MeshInstance: return mMeshInstances.Remove(id.Handle);
+        case EntityType::SphericalLight: return mSphericalLights.Remove(id.Handle);
+        case EntityType::RectangularLight: return mRectangularLights.Remove(id.Handle);
+        case EntityType::DiskLight: return mDiskLights.Remove(id.Handle);
+        default: return false;
+        }
+    }
+
+    std::optional<Scene::EntityVariant> Scene::GetEntityByID(const EntityID& id)
+    {
+        if (MeshInstance* instance = GetMeshInstance(id)) return EntityVariant{ instance };
+        if (SphericalLight* light = GetSphericalLight(id)) return EntityVariant{ light };
+        if (FlatLight* light = GetFlatLight(id)) return EntityVariant{ light };
+
+        return std::nullopt;
     }
 
-    Scene::FlatLightIt Scene::EmplaceRectangularLight()
+    MeshInstance* Scene::GetMeshInstance(const EntityID& id)
     {
-        mRectangularLights.emplace_back(FlatLight::Type::Rectangle);
-        return std::prev(mRectangularLights.end());
+        return id.Type == EntityType::MeshInstance ? mMeshInstances.Get(id.Handle) : nullptr;
     }
 
-    Scene::SphericalLightIt Scene::EmplaceSphericalLight()
+    FlatLight* Scene::GetFlatLight(const EntityID& id)
     {
-        mSphericalLights.emplace_back();
-        return std::prev(mSphericalLights.end());
+        switch (id.Type)
+        {
+        case EntityType::RectangularLight: return mRectangularLights.Get(id.Handle);
+        case EntityType::DiskLight: return mDiskLights.Get(id.Handle);
+        default: return nullptr;
+        }
     }
 
-    std::optional<Scene::EntityVariant> Scene::GetEntityByID(const EntityID& id) const
+    SphericalLight* Scene::GetSphericalLight(const EntityID& id)
     {
-        auto it = mMappedEntities.find(id);
-        return it == mMappedEntities.end() ? std::nullopt : std::optional(it->second);
+        return id.Type == EntityType::SphericalLight ? mSphericalLights.Get(id.Handle) : nullptr;
     }
 
-    void Scene::RemapEntityIDs()
+    EntityID Scene::EntityIDFromGPUID(uint32_t gpuId) const
     {
-        mMappedEntities.clear();
+        uint32_t slotIndex = gpuId & ((1u << GPUEntitySlotIndexBitCount) - 1);
+        uint32_t type = gpuId >> GPUEntitySlotIndexBitCount;
 
-        auto remap = [this](auto&& entities)
+        std::optional<Foundation::SlotMapHandle> handle;
+
+        switch (EntityType(type))
         {
-            for (auto& entity : entities)
+        case EntityType::MeshInstance: handle = mMeshInstances.HandleAtSlot(slotIndex); break;
+        case EntityType::SphericalLight: handle = mSphericalLights.HandleAtSlot(slotIndex); break;
+        case EntityType::RectangularLight: handle = mRectangularLights.HandleAtSlot(slotIndex); break;
+        case EntityType::DiskLight: handle = mDiskLights.HandleAtSlot(slotIndex); break;
+        // Anything else, including 'nothing picked' value
+        default: break;
+        }
+
+        return handle ? EntityID{ *handle, EntityType(type) } : NoEntityID;
+    }
+
+    void Scene::BuildMeshBVHs(Foundation::JobSystem* jobSystem)
+    {
+        for (Mesh& mesh : mMeshes)
+        {
+            if (mesh.TriangleBVH().IsEmpty() && mesh.TriangleCount() > 0)
             {
-                mMappedEntities[entity.ID()] = &entity;
+                mesh.BuildTriangleBVH(jobSystem);
             }
-        };
+        }
+    }
 
-        remap(mMeshInstances);
-        remap(mSphericalLights);
-        remap(mDiskLights);
-        remap(mRectangularLights);
+    std::optional<SceneRayQuery::Hit> Scene::CastRay(const Geometry::Ray3D& ray)
+    {
+        BuildMeshBVHs();
+        mRayQuery.Build(mMeshInstances);
+        return mRayQuery.CastRay(ray);
     }
 
-    void Scene::Serialize(const std::filesystem::path& destination) const
+    MeshInstance* Scene::PickMeshInstance(const Geometry::Ray3D& ray)
     {
-        using Buffer = std::vector<uint8_t>;
-        using Writer = bitsery::OutputBufferAdapter<Buffer>;
-        using Reader = bitsery::InputBufferAdapter<Buffer>;
+        std::optional<SceneRayQuery::Hit> hit = CastRay(ray);
+        return hit ? hit->Instance : nullptr;
+    }
 
-        Buffer buffer{};
-        size_t writtenSize{};
+    bool Scene::Serialize(const std::filesystem::path& destination) const
+    {
+        SceneFileWriter writer{};
 
-        bitsery::ext::PointerLinkingContext ctx{};
-        writtenSize = bitsery::quickSerialization(ctx, Writer{ buffer }, mCamera);
+        robin_hood::unordered_flat_map<const Mesh*, uint32_t> meshIndices;
+        robin_hood::unordered_flat_map<const Material*, uint32_t> materialIndices;
 
-        //make sure that pointer linking context is valid
-        //this ensures that all non-owning pointers points to data that has been serialized,
-        //so we can successfully reconstruct pointers after deserialization
-        assert(ctx.isValid());
+        for (const Mesh& mesh : mMeshes)
+        {
+            meshIndices[&mesh] = writer.AddMesh(mesh);
+        }
 
-        std::filesystem::path directory = destination;
-        directory.remove_filename();
+        for (const Material& material : mMaterials)
+        {
+            materialIndices[&material] = writer.AddMaterial(material);
+        }
 
-        std::filesystem::create_directories(directory);
+        for (const MeshInstance& instance : mMeshInstances)
+        {
+            auto meshIt = meshIndices.find(instance.AssociatedMesh());
+            auto materialIt = materialIndices.find(instance.AssociatedMaterial());
 
-        std::ofstream sceneFile{ destination, std::ios::out | std::ios::binary };
+            assert_format(meshIt != meshIndices.end() && materialIt != materialIndices.end(), 
+                "Instance references mesh or material that is not owned by the scene");
 
-        if (sceneFile)
-        {
-            sceneFile.write((const char*)buffer.data(), writtenSize);
-            sceneFile.close();
+            writer.AddMeshInstance(instance, meshIt->second, materialIt->second);
         }
+
+        for (const FlatLight& light : mRectangularLights) writer.AddLight(light);
+        for (const FlatLight& light : mDiskLights) writer.AddLight(light);
+        for (const SphericalLight& light : mSphericalLights) writer.AddLight(light);
+
+        writer.SetCamera(mCamera);
+
+        return writer.SaveToFile(destination);
     }
 
-    void Scene::Deserialize(const std::filesystem::path& source)
+    SceneFile::LoadResult Scene::Deserialize(const std::filesystem::path& source, MaterialLoader& materialLoader)
     {
+        assert_format(mMeshes.empty() && mMaterials.empty() && mMeshInstances.empty() && TotalLightCount() == 0,
+            "Scene files can only be loaded into an empty scene");
+
+        SceneFile file{};
+        SceneFile::LoadResult result = file.Open(source);
+
+        if (result != SceneFile::LoadResult::Loaded)
+        {
+            return result;
+        }
+
+        std::vector<const Mesh*> meshes;
+        std::vector<const Material*> materials;
+
+        meshes.reserve(file.MeshCount());
+        materials.reserve(file.MaterialCount());
+
+        for (uint64_t meshIdx = 0; meshIdx < file.MeshCount(); ++meshIdx)
+        {
+            meshes.push_back(&AddMesh(file.ReadMesh(meshIdx)));
+        }
+
+        auto optionalPath = [](const std::string& path) -> std::optional<std::string>
+        {
+            return path.empty() ? std::nullopt : std::optional<std::string>{ path };
+        };
+
+        for (uint64_t materialIdx = 0; materialIdx < file.MaterialCount(); ++materialIdx)
+        {
+            Material paths = file.ReadMaterial(materialIdx);
+
+            materials.push_back(&AddMaterial(materialLoader.LoadMaterial(
+                paths.AlbedoMapPath, paths.NormalMapPath, 
+                optionalPath(paths.RoughnessMapPath), optionalPath(paths.MetalnessMapPath),
+                optionalPath(paths.DisplacementMapPath), optionalPath(paths.DistanceFieldPath), 
+                optionalPath(paths.AOMapPath))));
+        }
+
+        mMeshInstances.Reserve(file.MeshInstanceCount());
+
+        for (uint64_t instanceIdx = 0; instanceIdx < file.MeshInstanceCount(); ++instanceIdx)
+        {
+            SceneFile::MeshInstanceDescription description = file.ReadMeshInstance(instanceIdx);
+            MeshInstance instance{ meshes[description.MeshIndex], materials[description.MaterialIndex] };
+            instance.SetTransformation(description.Transformation);
+            AddMeshInstance(std::move(instance));
+        }
+
+        for (uint64_t lightIdx = 0; lightIdx < file.FlatLightCount(); ++lightIdx)
+        {
+            EntityID id = file.FlatLightType(lightIdx) == FlatLight::Type::Disk ? EmplaceDiskLight() : EmplaceRectangularLight();
+            file.ReadFlatLight(lightIdx, *GetFlatLight(id));
+        }
+
+        for (uint64_t lightIdx = 0; lightIdx < file.SphericalLightCount(); ++lightIdx)
+        {
+            file.ReadSphericalLight(lightIdx, *GetSphericalLight(EmplaceSphericalLight()));
+        }
+
+        file.ReadCamera(mCamera);
 
+        return result;
     }
 
     void Scene::LoadUtilityResources()
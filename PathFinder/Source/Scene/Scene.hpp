@@ -12,53 +12,80 @@
 #include "SphericalLight.hpp"
 #include "LuminanceMeter.hpp"
 #include "SceneGPUStorage.hpp"
+#include "SceneRayQuery.hpp"
+#include "SceneFile.hpp"
 
 #include <Memory/GPUResourceProducer.hpp>
-#include <robinhood/robin_hood.h>
+#include <Foundation/SlotMap.hpp>
 
 #include <functional>
 #include <vector>
+#include <list>
 #include <memory>
 #include <filesystem>
 
 namespace PathFinder 
 {
 
+    class MaterialLoader;
+
     class Scene 
     {
     public:
-        using FlatLightIt = std::list<FlatLight>::iterator;
-        using SphericalLightIt = std::list<SphericalLight>::iterator;
-
         using EntityVariant = std::variant<MeshInstance*, FlatLight*, SphericalLight*>;
 
         Scene(const std::filesystem::path& executableFolder, const HAL::Device* device, Memory::GPUResourceProducer* resourceProducer);
 
         Mesh& AddMesh(Mesh&& mesh);
-        MeshInstance& AddMeshInstance(MeshInstance&& instance);
         Material& AddMaterial(Material&& material);
-        FlatLightIt EmplaceDiskLight();
-        FlatLightIt EmplaceRectangularLight();
-        SphericalLightIt EmplaceSphericalLight();
 
-        std::optional<EntityVariant> GetEntityByID(const EntityID& id) const;
+        // Entities are packed and move in memory when others are added or removed,
+        // so they are referred to by IDs and pointers to them are only good until the next change
+        EntityID AddMeshInstance(MeshInstance&& instance);
+        EntityID EmplaceDiskLight();
+        EntityID EmplaceRectangularLight();
+        EntityID EmplaceSphericalLight();
+
+        // Returns false if entity doesn't exist
+        bool RemoveEntity(const EntityID& id);
+
+        std::optional<EntityVariant> GetEntityByID(const EntityID& id);
+        MeshInstance* GetMeshInstance(const EntityID& id);
+        FlatLight* GetFlatLight(const EntityID& id);
+        SphericalLight* GetSphericalLight(const EntityID& id);
 
-        void RemapEntityIDs();
+        // ID of an entity that currently occupies a slot encoded by GPUEntityID(), if any
+        EntityID EntityIDFromGPUID(uint32_t gpuId) const;
 
-        void Serialize(const std::filesystem::path& destination) const;
-        void Deserialize(const std::filesystem::path& source);
+        // Builds triangle hierarchies of meshes that don't have one yet
+        void BuildMeshBVHs(Foundation::JobSystem* jobSystem = nullptr);
+
+        // Synchronous CPU ray cast against mesh instances at their current transformations.
+        // Instance level hierarchy is rebuilt on each call, batches of rays should use SceneRayQuery directly.
+        std::optional<SceneRayQuery::Hit> CastRay(const Geometry::Ray3D& ray);
+        MeshInstance* PickMeshInstance(const Geometry::Ray3D& ray);
+
+        // Writes meshes, materials, instances, lights and camera into a scene file
+        bool Serialize(const std::filesystem::path& destination) const;
+
+        // Adds scene file content to an empty scene. Material textures are loaded through the loader.
+        SceneFile::LoadResult Deserialize(const std::filesystem::path& source, MaterialLoader& materialLoader);
 
     private:
+        template <class Entity, class... Args>
+        EntityID EmplaceEntity(Foundation::SlotMap<Entity>& entities, EntityType type, Args&&... args);
+
         void LoadUtilityResources();
 
+        // Meshes and materials are loaded once, never iterated per frame and are referenced
+        // by address from instances and serialization, so their addresses have to be stable
         std::list<Mesh> mMeshes;
-        std::list<MeshInstance> mMeshInstances;
         std::list<Material> mMaterials;
-        std::list<FlatLight> mRectangularLights;
-        std::list<FlatLight> mDiskLights;
-        std::list<SphericalLight> mSphericalLights;
 
-        robin_hood::unordered_flat_map<EntityID, EntityVariant> mMappedEntities;
+        Foundation::SlotMap<MeshInstance> mMeshInstances;
+        Foundation::SlotMap<FlatLight> mRectangularLights;
+        Foundation::SlotMap<FlatLight> mDiskLights;
+        Foundation::SlotMap<SphericalLight> mSphericalLights;
 
         Camera mCamera;
         LuminanceMeter mLuminanceMeter;
@@ -74,6 +101,7 @@ namespace PathFinder
         ResourceLoader mResourceLoader;
         MeshLoader mMeshLoader;
         SceneGPUStorage mGPUStorage;
+        SceneRayQuery mRayQuery;
 
     public:
         inline Camera& MainCamera() { return mCamera; }
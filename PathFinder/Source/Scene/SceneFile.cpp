@@ -0,0 +1,566 @@
+#include "SceneFile.hpp"
+
+#include <bitsery/bitsery.h>
+#include <bitsery/adapter/buffer.h>
+#include <bitsery/traits/vector.h>
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        using namespace SceneFileFormat;
+
+        const uint32_t SceneFileMagic = 0x4E435346; // FSCN
+        const uint32_t SceneFileFormatVersion = 4;
+
+        // Every array starts at an offset suitable for any record or vertex type
+        const uint64_t DataAlignment = 16;
+
+        // Layout must not depend on compiler or glm configuration
+        static_assert(std::is_trivially_copyable_v<Vertex1P1N1UV1T1BT> && sizeof(Vertex1P1N1UV1T1BT) == 60, "Vertex layout changed, bump format version");
+        static_assert(std::is_trivially_copyable_v<Meshlet> && sizeof(Meshlet) == 84, "Meshlet layout changed, bump format version");
+        static_assert(sizeof(LODRecord) == 24, "LOD record layout changed, bump format version");
+        static_assert(sizeof(MeshRecord) == 144, "Mesh record layout changed, bump format version");
+        static_assert(sizeof(MaterialRecord) == 112, "Material record layout changed, bump format version");
+        static_assert(sizeof(MeshInstanceRecord) == 48, "Mesh instance record layout changed, bump format version");
+        static_assert(sizeof(FlatLightRecord) == 60, "Flat light record layout changed, bump format version");
+        static_assert(sizeof(SphericalLightRecord) == 40, "Spherical light record layout changed, bump format version");
+        static_assert(sizeof(Header) == 112, "Header layout changed, bump format version");
+
+        using Buffer = std::vector<uint8_t>;
+        using Writer = bitsery::OutputBufferAdapter<Buffer>;
+        using Reader = bitsery::InputBufferAdapter<Buffer>;
+
+        uint64_t AlignedOffset(uint64_t offset)
+        {
+            return (offset + DataAlignment - 1) / DataAlignment * DataAlignment;
+        }
+
+        TransformationRecord ToRecord(const Geometry::Transformation& transformation)
+        {
+            return {
+                { transformation.Scale.x, transformation.Scale.y, transformation.Scale.z },
+                { transformation.Translation.x, transformation.Translation.y, transformation.Translation.z },
+                { transformation.Rotation.x, transformation.Rotation.y, transformation.Rotation.z, transformation.Rotation.w }
+            };
+        }
+
+        Geometry::Transformation FromRecord(const TransformationRecord& record)
+        {
+            return Geometry::Transformation{
+                glm::vec3{ record.Scale[0], record.Scale[1], record.Scale[2] },
+                glm::vec3{ record.Translation[0], record.Translation[1], record.Translation[2] },
+                glm::quat{ record.Rotation[3], record.Rotation[0], record.Rotation[1], record.Rotation[2] }
+            };
+        }
+
+        LightRecord ToRecord(const Light& light)
+        {
+            const Foundation::Color& color = light.Color();
+            return { { color.R(), color.G(), color.B(), color.A() }, uint32_t(color.CurrentSpace()), light.LuminousPower() };
+        }
+
+        // Area must already be known for luminance to be correct
+        void ApplyRecord(const LightRecord& record, Light& light)
+        {
+            light.SetColor(Foundation::Color{ record.Color[0], record.Color[1], record.Color[2], record.Color[3], Foundation::Color::Space(record.ColorSpace) });
+            light.SetLuminousPower(record.LuminousPower);
+        }
+    }
+
+    SceneFileWriter::SceneFileWriter()
+    {
+        mData.resize(AlignedOffset(sizeof(Header)));
+    }
+
+    template <class T>
+    ArrayRef<T> SceneFileWriter::AddData(const T* data, uint64_t count)
+    {
+        ArrayRef<T> ref{ AlignedOffset(mData.size()), count };
+
+        mData.resize(ref.Offset + count * sizeof(T));
+
+        if (count > 0)
+        {
+            std::memcpy(mData.data() + ref.Offset, data, count * sizeof(T));
+        }
+
+        return ref;
+    }
+
+    StringRef SceneFileWriter::AddString(const std::string& string)
+    {
+        // Strings are not aligned
+        StringRef ref{ mData.size(), string.size() };
+        mData.insert(mData.end(), string.begin(), string.end());
+        return ref;
+    }
+
+    uint32_t SceneFileWriter::AddMesh(const Mesh& mesh)
+    {
+        assert_format(!mesh.Vertices().empty() && mesh.Indices().size() % 3 == 0, "Scene files can only hold non-empty triangle list meshes");
+
+        const Geometry::AxisAlignedBox3D& bounds = mesh.BoundingBox();
+
+        MeshRecord& record = mMeshes.emplace_back();
+        record.Name = AddString(mesh.Name());
+        record.Vertices = AddData(mesh.Vertices().data(), mesh.Vertices().size());
+        record.Indices = AddData(mesh.Indices().data(), mesh.Indices().size());
+        record.BoundingBoxMin[0] = bounds.Min.x; record.BoundingBoxMin[1] = bounds.Min.y; record.BoundingBoxMin[2] = bounds.Min.z;
+        record.BoundingBoxMax[0] = bounds.Max.x; record.BoundingBoxMax[1] = bounds.Max.y; record.BoundingBoxMax[2] = bounds.Max.z;
+        record.SurfaceArea = mesh.SurfaceArea();
+        record.HasTangentSpace = mesh.HasTangentSpace();
+        record.Meshlets = AddData(mesh.Meshlets().data(), mesh.Meshlets().size());
+        record.MeshletVertices = AddData(mesh.MeshletVertices().data(), mesh.MeshletVertices().size());
+        record.MeshletTriangles = AddData(mesh.MeshletTriangles().data(), mesh.MeshletTriangles().size());
+
+        std::vector<LODRecord> lods;
+
+        for (const MeshLOD& lod : mesh.LODs())
+        {
+            lods.push_back(LODRecord{ AddData(lod.Indices.data(), lod.Indices.size()), lod.Error, 0 });
+        }
+
+        record.LODs = AddData(lods.data(), lods.size());
+
+        return uint32_t(mMeshes.size() - 1);
+    }
+
+    uint32_t SceneFileWriter::AddMaterial(const Material& material)
+    {
+        MaterialRecord& record = mMaterials.emplace_back();
+        record.AlbedoMapPath = AddString(material.AlbedoMapPath);
+        record.NormalMapPath = AddString(material.NormalMapPath);
+        record.RoughnessMapPath = AddString(material.RoughnessMapPath);
+        record.MetalnessMapPath = AddString(material.MetalnessMapPath);
+        record.AOMapPath = AddString(material.AOMapPath);
+        record.DisplacementMapPath = AddString(material.DisplacementMapPath);
+        record.DistanceFieldPath = AddString(material.DistanceFieldPath);
+
+        return uint32_t(mMaterials.size() - 1);
+    }
+
+    void SceneFileWriter::AddMeshInstance(const MeshInstance& instance, uint32_t meshIndex, uint32_t materialIndex)
+    {
+        assert_format(meshIndex < mMeshes.size() && materialIndex < mMaterials.size(), "Instance references mesh or material that wasn't added");
+
+        mMeshInstances.push_back({ meshIndex, materialIndex, ToRecord(instance.Transformation()) });
+    }
+
+    void SceneFileWriter::AddLight(const FlatLight& light)
+    {
+        FlatLightRecord& record = mFlatLights.emplace_back();
+        record.Light = ToRecord(light);
+        record.Type = uint32_t(light.LightType());
+        record.Normal[0] = light.Normal().x; record.Normal[1] = light.Normal().y; record.Normal[2] = light.Normal().z;
+        record.Position[0] = light.Position().x; record.Position[1] = light.Position().y; record.Position[2] = light.Position().z;
+        record.Width = light.Width();
+        record.Height = light.Height();
+    }
+
+    void SceneFileWriter::AddLight(const SphericalLight& light)
+    {
+        SphericalLightRecord& record = mSphericalLights.emplace_back();
+        record.Light = ToRecord(light);
+        record.Position[0] = light.Position().x; record.Position[1] = light.Position().y; record.Position[2] = light.Position().z;
+        record.Radius = light.Radius();
+    }
+
+    void SceneFileWriter::SetCamera(const Camera& camera)
+    {
+        // Camera state is private and small, reuse its bitsery description
+        Buffer buffer{};
+        size_t writtenSize = bitsery::quickSerialization(Writer{ buffer }, camera);
+        mCamera = AddData(buffer.data(), writtenSize);
+    }
+
+    std::vector<uint8_t> SceneFileWriter::Finish() const
+    {
+        std::vector<uint8_t> file = mData;
+
+        auto appendRecords = [&file](const auto& records)
+        {
+            using Record = typename std::decay_t<decltype(records)>::value_type;
+
+            ArrayRef<Record> ref{ AlignedOffset(file.size()), records.size() };
+            file.resize(ref.Offset + records.size() * sizeof(Record));
+            if (!records.empty()) std::memcpy(file.data() + ref.Offset, records.data(), records.size() * sizeof(Record));
+            return ref;
+        };
+
+        Header header{};
+        header.Magic = SceneFileMagic;
+        header.FormatVersion = SceneFileFormatVersion;
+        header.Meshes = appendRecords(mMeshes);
+        header.Materials = appendRecords(mMaterials);
+        header.MeshInstances = appendRecords(mMeshInstances);
+        header.FlatLights = appendRecords(mFlatLights);
+        header.SphericalLights = appendRecords(mSphericalLights);
+        header.Camera = mCamera;
+        header.FileSize = file.size();
+
+        std::memcpy(file.data(), &header, sizeof(Header));
+
+        return file;
+    }
+
+    bool SceneFileWriter::SaveToFile(const std::filesystem::path& path) const
+    {
+        std::vector<uint8_t> data = Finish();
+
+        std::filesystem::path directory = path;
+        directory.remove_filename();
+
+        // Failure surfaces when the file is opened
+        if (!directory.empty())
+        {
+            std::error_code error;
+            std::filesystem::create_directories(directory, error);
+        }
+
+        std::ofstream file{ path, std::ios::out | std::ios::binary | std::ios::trunc };
+
+        if (!file)
+        {
+            return false;
+        }
+
+        file.write((const char*)data.data(), data.size());
+        return bool(file);
+    }
+
+    SceneFile::LoadResult SceneFile::Open(const std::filesystem::path& path)
+    {
+        Foundation::MemoryMappedFile file;
+
+        if (!file.Open(path))
+        {
+            mFile.Close();
+            mHeader = nullptr;
+            return LoadResult::FileMissing;
+        }
+
+        return Open(std::move(file));
+    }
+
+    SceneFile::LoadResult SceneFile::Open(Foundation::MemoryMappedFile&& file)
+    {
+        mFile = std::move(file);
+        mHeader = mFile.Size() >= sizeof(Header) ? reinterpret_cast<const Header*>(mFile.Data()) : nullptr;
+
+        LoadResult result = mHeader ? Validate() : LoadResult::Corrupted;
+
+        if (result != LoadResult::Loaded)
+        {
+            mFile.Close();
+            mHeader = nullptr;
+        }
+
+        return result;
+    }
+
+    SceneFile::LoadResult SceneFile::Validate() const
+    {
+        if (mHeader->Magic != SceneFileMagic)
+        {
+            return LoadResult::Corrupted;
+        }
+
+        // Layout of everything past magic and version may have changed between versions
+        if (mHeader->FormatVersion != SceneFileFormatVersion)
+        {
+            return LoadResult::FormatMismatch;
+        }
+
+        if (mHeader->FileSize != mFile.Size() ||
+            !IsValidRef(mHeader->Meshes) ||
+            !IsValidRef(mHeader->Materials) ||
+            !IsValidRef(mHeader->MeshInstances) ||
+            !IsValidRef(mHeader->FlatLights) ||
+            !IsValidRef(mHeader->SphericalLights) ||
+            !IsValidRef(mHeader->Camera))
+        {
+            return LoadResult::Corrupted;
+        }
+
+        const MeshRecord* meshes = Resolve(mHeader->Meshes);
+
+        for (uint64_t meshIdx = 0; meshIdx < mHeader->Meshes.Count; ++meshIdx)
+        {
+            const MeshRecord& mesh = meshes[meshIdx];
+
+            if (!IsValidRef(mesh.Name) || !IsValidRef(mesh.Vertices) || !IsValidRef(mesh.Indices))
+            {
+                return LoadResult::Corrupted;
+            }
+
+            // Writer never produces empty meshes
+            if (mesh.Vertices.Count == 0)
+            {
+                return LoadResult::Corrupted;
+            }
+
+            // Out of range indices would make every consumer read outside of vertex arrays
+            if (!HasValidIndices(mesh.Indices, mesh.Vertices.Count))
+            {
+                return LoadResult::Corrupted;
+            }
+
+            if (!IsValidRef(mesh.Meshlets) || !IsValidRef(mesh.MeshletVertices) || !IsValidRef(mesh.MeshletTriangles))
+            {
+                return LoadResult::Corrupted;
+            }
+
+            // Same goes for meshlet ranges and both levels of meshlet indirection
+            const Meshlet* meshlets = Resolve(mesh.Meshlets);
+            const uint32_t* meshletVertices = Resolve(mesh.MeshletVertices);
+            const uint8_t* meshletTriangles = Resolve(mesh.MeshletTriangles);
+
+            for (uint64_t i = 0; i < mesh.MeshletVertices.Count; ++i)
+            {
+                if (meshletVertices[i] >= mesh.Vertices.Count)
+                {
+                    return LoadResult::Corrupted;
+                }
+            }
+
+            for (uint64_t meshletIdx = 0; meshletIdx < mesh.Meshlets.Count; ++meshletIdx)
+            {
+                const Meshlet& meshlet = meshlets[meshletIdx];
+
+                if (uint64_t(meshlet.VertexOffset) + meshlet.VertexCount > mesh.MeshletVertices.Count ||
+                    (uint64_t(meshlet.TriangleOffset) + meshlet.TriangleCount) * 3 > mesh.MeshletTriangles.Count)
+                {
+                    return LoadResult::Corrupted;
+                }
+
+                const uint8_t* localIndices = meshletTriangles + uint64_t(meshlet.TriangleOffset) * 3;
+
+                for (uint64_t i = 0; i < uint64_t(meshlet.TriangleCount) * 3; ++i)
+                {
+                    if (localIndices[i] >= meshlet.VertexCount)
+                    {
+                        return LoadResult::Corrupted;
+                    }
+                }
+            }
+
+            if (!IsValidRef(mesh.LODs) || mesh.LODs.Count > MeshLOD::MaxCount)
+            {
+                return LoadResult::Corrupted;
+            }
+
+            const LODRecord* lods = Resolve(mesh.LODs);
+
+            for (uint64_t lodIdx = 0; lodIdx < mesh.LODs.Count; ++lodIdx)
+            {
+                if (!IsValidRef(lods[lodIdx].Indices) || !HasValidIndices(lods[lodIdx].Indices, mesh.Vertices.Count))
+                {
+                    return LoadResult::Corrupted;
+                }
+            }
+        }
+
+        const MaterialRecord* materials = Resolve(mHeader->Materials);
+
+        for (uint64_t materialIdx = 0; materialIdx < mHeader->Materials.Count; ++materialIdx)
+        {
+            const MaterialRecord& material = materials[materialIdx];
+
+            if (!IsValidRef(material.AlbedoMapPath) || !IsValidRef(material.NormalMapPath) ||
+                !IsValidRef(material.RoughnessMapPath) || !IsValidRef(material.MetalnessMapPath) ||
+                !IsValidRef(material.AOMapPath) || !IsValidRef(material.DisplacementMapPath) ||
+                !IsValidRef(material.DistanceFieldPath))
+            {
+                return LoadResult::Corrupted;
+            }
+        }
+
+        const MeshInstanceRecord* instances = Resolve(mHeader->MeshInstances);
+
+        for (uint64_t instanceIdx = 0; instanceIdx < mHeader->MeshInstances.Count; ++instanceIdx)
+        {
+            if (instances[instanceIdx].MeshIndex >= mHeader->Meshes.Count ||
+                instances[instanceIdx].MaterialIndex >= mHeader->Materials.Count)
+            {
+                return LoadResult::Corrupted;
+            }
+        }
+
+        const FlatLightRecord* flatLights = Resolve(mHeader->FlatLights);
+
+        for (uint64_t lightIdx = 0; lightIdx < mHeader->FlatLights.Count; ++lightIdx)
+        {
+            if (flatLights[lightIdx].Type > uint32_t(FlatLight::Type::Rectangle))
+            {
+                return LoadResult::Corrupted;
+            }
+        }
+
+        return LoadResult::Loaded;
+    }
+
+    template <class T>
+    bool SceneFile::IsValidRef(const ArrayRef<T>& ref) const
+    {
+        uint64_t size = mFile.Size();
+
+        // Written this way to not overflow on garbage offsets and counts
+        return ref.Offset <= size &&
+            ref.Offset % alignof(T) == 0 &&
+            ref.Count <= (size - ref.Offset) / sizeof(T);
+    }
+
+    template <class T>
+    const T* SceneFile::Resolve(const ArrayRef<T>& ref) const
+    {
+        return reinterpret_cast<const T*>(mFile.Data() + ref.Offset);
+    }
+
+    std::string SceneFile::ResolveString(const StringRef& ref) const
+    {
+        return std::string{ Resolve(ref), ref.Count };
+    }
+
+    bool SceneFile::HasValidIndices(const ArrayRef<uint32_t>& indices, uint64_t vertexCount) const
+    {
+        // Meshes are triangle lists
+        if (indices.Count % 3 != 0)
+        {
+            return false;
+        }
+
+        const uint32_t* data = Resolve(indices);
+
+        for (uint64_t i = 0; i < indices.Count; ++i)
+        {
+            if (data[i] >= vertexCount)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    Mesh SceneFile::ReadMesh(uint64_t index) const
+    {
+        assert_format(index < MeshCount(), "Mesh index is out of bounds");
+
+        const MeshRecord& record = Resolve(mHeader->Meshes)[index];
+        const Vertex1P1N1UV1T1BT* vertices = Resolve(record.Vertices);
+        const uint32_t* indices = Resolve(record.Indices);
+
+        Geometry::AxisAlignedBox3D bounds{
+            glm::vec3{ record.BoundingBoxMin[0], record.BoundingBoxMin[1], record.BoundingBoxMin[2] },
+            glm::vec3{ record.BoundingBoxMax[0], record.BoundingBoxMax[1], record.BoundingBoxMax[2] } };
+
+        Mesh mesh{};
+        mesh.SetName(ResolveString(record.Name));
+        mesh.SetGeometry(
+            std::vector<Vertex1P1N1UV1T1BT>{ vertices, vertices + record.Vertices.Count },
+            std::vector<uint32_t>{ indices, indices + record.Indices.Count },
+            bounds, record.SurfaceArea, record.HasTangentSpace != 0);
+
+        const Meshlet* meshlets = Resolve(record.Meshlets);
+        const uint32_t* meshletVertices = Resolve(record.MeshletVertices);
+        const uint8_t* meshletTriangles = Resolve(record.MeshletTriangles);
+
+        mesh.SetMeshlets(
+            std::vector<Meshlet>{ meshlets, meshlets + record.Meshlets.Count },
+            std::vector<uint32_t>{ meshletVertices, meshletVertices + record.MeshletVertices.Count },
+            std::vector<uint8_t>{ meshletTriangles, meshletTriangles + record.MeshletTriangles.Count });
+
+        const LODRecord* lodRecords = Resolve(record.LODs);
+        std::vector<MeshLOD> lods;
+
+        for (uint64_t lodIdx = 0; lodIdx < record.LODs.Count; ++lodIdx)
+        {
+            const uint32_t* lodIndices = Resolve(lodRecords[lodIdx].Indices);
+            lods.push_back(MeshLOD{ std::vector<uint32_t>{ lodIndices, lodIndices + lodRecords[lodIdx].Indices.Count }, lodRecords[lodIdx].Error });
+        }
+
+        mesh.SetLODs(std::move(lods));
+
+        return mesh;
+    }
+
+    Material SceneFile::ReadMaterial(uint64_t index) const
+    {
+        assert_format(index < MaterialCount(), "Material index is out of bounds");
+
+        const MaterialRecord& record = Resolve(mHeader->Materials)[index];
+
+        Material material{};
+        material.AlbedoMapPath = ResolveString(record.AlbedoMapPath);
+        material.NormalMapPath = ResolveString(record.NormalMapPath);
+        material.RoughnessMapPath = ResolveString(record.RoughnessMapPath);
+        material.MetalnessMapPath = ResolveString(record.MetalnessMapPath);
+        material.AOMapPath = ResolveString(record.AOMapPath);
+        material.DisplacementMapPath = ResolveString(record.DisplacementMapPath);
+        material.DistanceFieldPath = ResolveString(record.DistanceFieldPath);
+
+        return material;
+    }
+
+    SceneFile::MeshInstanceDescription SceneFile::ReadMeshInstance(uint64_t index) const
+    {
+        assert_format(index < MeshInstanceCount(), "Mesh instance index is out of bounds");
+
+        const MeshInstanceRecord& record = Resolve(mHeader->MeshInstances)[index];
+        return { record.MeshIndex, record.MaterialIndex, FromRecord(record.Transformation) };
+    }
+
+    FlatLight::Type SceneFile::FlatLightType(uint64_t index) const
+    {
+        assert_format(index < FlatLightCount(), "Light index is out of bounds");
+        return FlatLight::Type(Resolve(mHeader->FlatLights)[index].Type);
+    }
+
+    void SceneFile::ReadFlatLight(uint64_t index, FlatLight& light) const
+    {
+        assert_format(index < FlatLightCount(), "Light index is out of bounds");
+
+        const FlatLightRecord& record = Resolve(mHeader->FlatLights)[index];
+
+        assert_format(light.LightType() == FlatLight::Type(record.Type), "Light type mismatch");
+
+        light.SetNormal({ record.Normal[0], record.Normal[1], record.Normal[2] });
+        light.SetPosition({ record.Position[0], record.Position[1], record.Position[2] });
+        light.SetWidth(record.Width);
+        light.SetHeight(record.Height);
+        ApplyRecord(record.Light, light);
+    }
+
+    void SceneFile::ReadSphericalLight(uint64_t index, SphericalLight& light) const
+    {
+        assert_format(index < SphericalLightCount(), "Light index is out of bounds");
+
+        const SphericalLightRecord& record = Resolve(mHeader->SphericalLights)[index];
+
+        light.SetPosition({ record.Position[0], record.Position[1], record.Position[2] });
+        light.SetRadius(record.Radius);
+        ApplyRecord(record.Light, light);
+    }
+
+    bool SceneFile::ReadCamera(Camera& camera) const
+    {
+        if (!mHeader || mHeader->Camera.Count == 0)
+        {
+            return false;
+        }
+
+        const uint8_t* data = Resolve(mHeader->Camera);
+        Buffer buffer{ data, data + mHeader->Camera.Count };
+
+        auto [error, completed] = bitsery::quickDeserialization(Reader{ buffer.begin(), buffer.size() }, camera);
+        return error == bitsery::ReaderError::NoError && completed;
+    }
+
+}
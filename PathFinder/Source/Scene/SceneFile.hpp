@@ -0,0 +1,213 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "MeshInstance.hpp"
+#include "Material.hpp"
+#include "FlatLight.hpp"
+#include "SphericalLight.hpp"
+#include "Camera.hpp"
+
+#include <Foundation/MemoryMappedFile.hpp>
+#include <Geometry/Transformation.hpp>
+
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <cstdint>
+
+namespace PathFinder
+{
+    // Binary scene file that is memory mapped and read in place.
+    //
+    // File starts with a header, followed by a data section with vertices, indices, meshlets, LODs and strings
+    // and then by arrays of fixed size records. Records reference data by offsets from the beginning
+    // of the file and other records by indices instead of pointers, so the file needs no fixups
+    // and is valid at any address it's mapped to. Vertices and indices are stored exactly as in memory
+    // and are copied into meshes without any parsing, the same goes for meshlets and LOD indices.
+    //
+    // Textures are not embedded: materials store paths to texture files and cached assets,
+    // such as distance fields, which are loaded through MaterialLoader as usual.
+
+    namespace SceneFileFormat
+    {
+        template <class T>
+        struct ArrayRef
+        {
+            uint64_t Offset = 0;
+            uint64_t Count = 0;
+        };
+
+        using StringRef = ArrayRef<char>;
+
+        struct TransformationRecord
+        {
+            float Scale[3];
+            float Translation[3];
+            float Rotation[4]; // x, y, z, w
+        };
+
+        struct LODRecord
+        {
+            ArrayRef<uint32_t> Indices;
+            float Error;
+            uint32_t Pad__;
+        };
+
+        struct MeshRecord
+        {
+            StringRef Name;
+            ArrayRef<Vertex1P1N1UV1T1BT> Vertices;
+            ArrayRef<uint32_t> Indices;
+            float BoundingBoxMin[3];
+            float BoundingBoxMax[3];
+            float SurfaceArea;
+            uint32_t HasTangentSpace;
+            ArrayRef<Meshlet> Meshlets;
+            ArrayRef<uint32_t> MeshletVertices;
+            ArrayRef<uint8_t> MeshletTriangles;
+            ArrayRef<LODRecord> LODs;
+        };
+
+        struct MaterialRecord
+        {
+            StringRef AlbedoMapPath;
+            StringRef NormalMapPath;
+            StringRef RoughnessMapPath;
+            StringRef MetalnessMapPath;
+            StringRef AOMapPath;
+            StringRef DisplacementMapPath;
+            StringRef DistanceFieldPath;
+        };
+
+        struct MeshInstanceRecord
+        {
+            uint32_t MeshIndex;
+            uint32_t MaterialIndex;
+            TransformationRecord Transformation;
+        };
+
+        struct LightRecord
+        {
+            float Color[4];
+            uint32_t ColorSpace;
+            float LuminousPower;
+        };
+
+        struct FlatLightRecord
+        {
+            LightRecord Light;
+            uint32_t Type;
+            float Normal[3];
+            float Position[3];
+            float Width;
+            float Height;
+        };
+
+        struct SphericalLightRecord
+        {
+            LightRecord Light;
+            float Position[3];
+            float Radius;
+        };
+
+        struct Header
+        {
+            uint32_t Magic;
+            uint32_t FormatVersion;
+            uint64_t FileSize;
+            ArrayRef<MeshRecord> Meshes;
+            ArrayRef<MaterialRecord> Materials;
+            ArrayRef<MeshInstanceRecord> MeshInstances;
+            ArrayRef<FlatLightRecord> FlatLights;
+            ArrayRef<SphericalLightRecord> SphericalLights;
+            ArrayRef<uint8_t> Camera;
+        };
+    }
+
+    class SceneFileWriter
+    {
+    public:
+        SceneFileWriter();
+
+        // Returned indices are used to reference meshes and materials from instances
+        uint32_t AddMesh(const Mesh& mesh);
+        uint32_t AddMaterial(const Material& material);
+        void AddMeshInstance(const MeshInstance& instance, uint32_t meshIndex, uint32_t materialIndex);
+        void AddLight(const FlatLight& light);
+        void AddLight(const SphericalLight& light);
+        void SetCamera(const Camera& camera);
+
+        std::vector<uint8_t> Finish() const;
+        bool SaveToFile(const std::filesystem::path& path) const;
+
+    private:
+        template <class T>
+        SceneFileFormat::ArrayRef<T> AddData(const T* data, uint64_t count);
+
+        SceneFileFormat::StringRef AddString(const std::string& string);
+
+        std::vector<uint8_t> mData;
+        std::vector<SceneFileFormat::MeshRecord> mMeshes;
+        std::vector<SceneFileFormat::MaterialRecord> mMaterials;
+        std::vector<SceneFileFormat::MeshInstanceRecord> mMeshInstances;
+        std::vector<SceneFileFormat::FlatLightRecord> mFlatLights;
+        std::vector<SceneFileFormat::SphericalLightRecord> mSphericalLights;
+        SceneFileFormat::ArrayRef<uint8_t> mCamera;
+    };
+
+    class SceneFile
+    {
+    public:
+        enum class LoadResult
+        {
+            Loaded, FileMissing, Corrupted, FormatMismatch
+        };
+
+        struct MeshInstanceDescription
+        {
+            uint32_t MeshIndex = 0;
+            uint32_t MaterialIndex = 0;
+            Geometry::Transformation Transformation;
+        };
+
+        // Validates all references, so reading never goes outside of the file afterwards
+        LoadResult Open(const std::filesystem::path& path);
+        LoadResult Open(Foundation::MemoryMappedFile&& file);
+
+        Mesh ReadMesh(uint64_t index) const;
+
+        // Only texture paths are restored
+        Material ReadMaterial(uint64_t index) const;
+
+        MeshInstanceDescription ReadMeshInstance(uint64_t index) const;
+        FlatLight::Type FlatLightType(uint64_t index) const;
+        void ReadFlatLight(uint64_t index, FlatLight& light) const;
+        void ReadSphericalLight(uint64_t index, SphericalLight& light) const;
+        bool ReadCamera(Camera& camera) const;
+
+    private:
+        LoadResult Validate() const;
+
+        template <class T>
+        bool IsValidRef(const SceneFileFormat::ArrayRef<T>& ref) const;
+
+        template <class T>
+        const T* Resolve(const SceneFileFormat::ArrayRef<T>& ref) const;
+
+        std::string ResolveString(const SceneFileFormat::StringRef& ref) const;
+
+        // Indices must be a valid reference already. Checks that they form whole triangles of existing vertices.
+        bool HasValidIndices(const SceneFileFormat::ArrayRef<uint32_t>& indices, uint64_t vertexCount) const;
+
+        Foundation::MemoryMappedFile mFile;
+        const SceneFileFormat::Header* mHeader = nullptr;
+
+    public:
+        inline uint64_t MeshCount() const { return mHeader ? mHeader->Meshes.Count : 0; }
+        inline uint64_t MaterialCount() const { return mHeader ? mHeader->Materials.Count : 0; }
+        inline uint64_t MeshInstanceCount() const { return mHeader ? mHeader->MeshInstances.Count : 0; }
+        inline uint64_t FlatLightCount() const { return mHeader ? mHeader->FlatLights.Count : 0; }
+        inline uint64_t SphericalLightCount() const { return mHeader ? mHeader->SphericalLights.Count : 0; }
+    };
+
+}
@@ -1,12 +1,12 @@
 #include "SceneGPUStorage.hpp"
 #include "EntityID.hpp"
 #include "Scene.hpp"
+#include "MeshletBuilder.hpp"
 
 #include <algorithm>
 #include <iterator>
 
 #include <RenderPipeline/DrawablePrimitive.hpp>
-#include <fplus/fplus.hpp>
 
 namespace PathFinder
 {
@@ -27,27 +27,126 @@ namespace PathFinder
         {
             assert_format(!mesh.Vertices().empty(), "Empty meshes are not allowed");
 
-            VertexStorageLocation locationInStorage = WriteToTemporaryBuffers(
-                mesh.Vertices().data(), mesh.Vertices().size(), mesh.Indices().data(), mesh.Indices().size());
+            // Meshes not coming from the mesh loader, such as ones restored from a scene file, are compressed here
+            if (mesh.CompressedVertices().size() != mesh.Vertices().size())
+            {
+                mesh.CompressVertices();
+            }
+
+            if (mesh.Meshlets().empty())
+            {
+                MeshletBuilder{}.Build(mesh);
+            }
 
-            mesh.SetVertexStorageLocation(locationInStorage);
+            mesh.SetVertexStorageLocation(WriteToTemporaryBuffers(mesh));
         }
 
-        auto quadVertices = fplus::transform([](const glm::vec3& p) { return Vertex1P1N1UV1T1BT{ glm::vec4{p, 1.0f} }; }, DrawablePrimitive::UnitQuadVertices);
+        Mesh unitQuad;
 
-        mUnitQuadVertexLocation = WriteToTemporaryBuffers(
-            quadVertices.data(), quadVertices.size(),
-            DrawablePrimitive::UnitQuadIndices.data(), DrawablePrimitive::UnitQuadIndices.size());
+        for (const glm::vec3& position : DrawablePrimitive::UnitQuadVertices)
+        {
+            unitQuad.AddVertex(Vertex1P1N1UV1T1BT{ glm::vec4{ position, 1.0f } });
+        }
 
-        mUnitCubeVertexLocation = WriteToTemporaryBuffers(
-            mScene->UnitCube().Vertices().data(), mScene->UnitCube().Vertices().size(), 
-            mScene->UnitCube().Indices().data(), mScene->UnitCube().Indices().size());
+        for (uint32_t index : DrawablePrimitive::UnitQuadIndices)
+        {
+            unitQuad.AddIndex(index);
+        }
 
-        mUnitSphereVertexLocation = WriteToTemporaryBuffers(
-            mScene->UnitSphere().Vertices().data(), mScene->UnitSphere().Vertices().size(),
-            mScene->UnitSphere().Indices().data(), mScene->UnitSphere().Indices().size());
+        unitQuad.CompressVertices();
 
-        SubmitTemporaryBuffersToGPU<Vertex1P1N1UV1T1BT>();
+        mUnitQuadVertexLocation = WriteToTemporaryBuffers(unitQuad);
+        mUnitCubeVertexLocation = WriteToTemporaryBuffers(mScene->UnitCube());
+        mUnitSphereVertexLocation = WriteToTemporaryBuffers(mScene->UnitSphere());
+
+        SubmitTemporaryBuffersToGPU<CompressedVertex1P1N1UV1T1BT>();
+        SubmitMeshletBuffersToGPU();
+    }
+
+    VertexStorageLocation SceneGPUStorage::WriteToTemporaryBuffers(const Mesh& mesh)
+    {
+        assert_format(mesh.CompressedVertices().size() == mesh.Vertices().size(), "Mesh vertices must be compressed before upload");
+
+        VertexStorageLocation location = WriteToTemporaryBuffers(
+            mesh.CompressedVertices().data(), mesh.CompressedVertices().size(), mesh.Indices().data(), mesh.Indices().size());
+
+        location.PositionQuantization = mesh.PositionQuantization();
+
+        // LODs share vertices of the base level, so only their indices follow the base ones.
+        // Ray tracing geometry is always built from the base level.
+        auto& indices = std::get<UploadBufferPackage<CompressedVertex1P1N1UV1T1BT>>(mUploadBuffers).Indices;
+
+        for (const MeshLOD& lod : mesh.LODs())
+        {
+            location.LODIndexBufferOffsets[location.LODCount] = uint32_t(indices.size());
+            location.LODIndexCounts[location.LODCount] = uint32_t(lod.Indices.size());
+            ++location.LODCount;
+
+            indices.insert(indices.end(), lod.Indices.begin(), lod.Indices.end());
+        }
+
+        auto& package = mMeshletUploadBuffers;
+
+        location.MeshletOffset = uint32_t(package.Meshlets.size());
+        location.MeshletCount = uint32_t(mesh.Meshlets().size());
+
+        uint32_t vertexBufferOffset = uint32_t(package.Vertices.size());
+        uint32_t triangleBufferOffset = uint32_t(package.Triangles.size());
+
+        for (const Meshlet& meshlet : mesh.Meshlets())
+        {
+            package.Meshlets.push_back({
+                meshlet.BoundingSphereCenter, meshlet.BoundingSphereRadius,
+                meshlet.ConeApex, meshlet.ConeCutoff,
+                meshlet.ConeAxis, meshlet.VertexCount,
+                meshlet.BoundingBox.Min, meshlet.TriangleCount,
+                meshlet.BoundingBox.Max, vertexBufferOffset + meshlet.VertexOffset,
+                triangleBufferOffset + meshlet.TriangleOffset
+            });
+        }
+
+        package.Vertices.insert(package.Vertices.end(), mesh.MeshletVertices().begin(), mesh.MeshletVertices().end());
+
+        const std::vector<uint8_t>& triangles = mesh.MeshletTriangles();
+
+        for (uint64_t i = 0; i + 2 < triangles.size(); i += 3)
+        {
+            package.Triangles.push_back(uint32_t(triangles[i]) | (uint32_t(triangles[i + 1]) << 8) | (uint32_t(triangles[i + 2]) << 16));
+        }
+
+        return location;
+    }
+
+    void SceneGPUStorage::SubmitMeshletBuffersToGPU()
+    {
+        auto& package = mMeshletUploadBuffers;
+
+        if (package.Meshlets.empty())
+        {
+            return;
+        }
+
+        auto tableProperties = HAL::BufferProperties::Create<GPUMeshletTableEntry>(package.Meshlets.size());
+        mMeshletTable = mResourceProducer->NewBuffer(tableProperties, Memory::GPUResource::AccessStrategy::Automatic, Memory::MemoryCategory::VertexIndex);
+        mMeshletTable->RequestWrite();
+        mMeshletTable->Write(package.Meshlets.data(), 0, package.Meshlets.size());
+        mMeshletTable->SetDebugName("Meshlet Table");
+
+        auto vertexProperties = HAL::BufferProperties::Create<uint32_t>(package.Vertices.size());
+        mMeshletVertexBuffer = mResourceProducer->NewBuffer(vertexProperties, Memory::GPUResource::AccessStrategy::Automatic, Memory::MemoryCategory::VertexIndex);
+        mMeshletVertexBuffer->RequestWrite();
+        mMeshletVertexBuffer->Write(package.Vertices.data(), 0, package.Vertices.size());
+        mMeshletVertexBuffer->SetDebugName("Unified Meshlet Vertex Buffer");
+
+        auto triangleProperties = HAL::BufferProperties::Create<uint32_t>(package.Triangles.size());
+        mMeshletTriangleBuffer = mResourceProducer->NewBuffer(triangleProperties, Memory::GPUResource::AccessStrategy::Automatic, Memory::MemoryCategory::VertexIndex);
+        mMeshletTriangleBuffer->RequestWrite();
+        mMeshletTriangleBuffer->Write(package.Triangles.data(), 0, package.Triangles.size());
+        mMeshletTriangleBuffer->SetDebugName("Unified Meshlet Triangle Buffer");
+
+        package.Meshlets.clear();
+        package.Vertices.clear();
+        package.Triangles.clear();
     }
 
     void SceneGPUStorage::UploadMaterials()
@@ -94,23 +193,48 @@ namespace PathFinder
             mMaterialTable->Write(&materialEntry, materialIndex, 1);
             ++materialIndex;
         }
+
+        mUploadedMaterialDescriptorGeneration = MaterialDescriptorGeneration();
     }
 
-    void SceneGPUStorage::UploadInstances()
+    bool SceneGPUStorage::AreMaterialDescriptorsOutdated() const
+    {
+        return mMaterialTable && mUploadedMaterialDescriptorGeneration != MaterialDescriptorGeneration();
+    }
+
+    uint64_t SceneGPUStorage::MaterialDescriptorGeneration() const
+    {
+        uint64_t generation = 0;
+
+        for (const Material& material : mScene->Materials())
+        {
+            const Memory::Texture* textures[] = {
+                material.AlbedoMap, material.NormalMap, material.RoughnessMap, material.MetalnessMap,
+                material.AOMap, material.DisplacementMap, material.DistanceField,
+                material.LTC_LUT_MatrixInverse_Specular, material.LTC_LUT_Matrix_Specular, material.LTC_LUT_Terms_Specular,
+                material.LTC_LUT_MatrixInverse_Diffuse, material.LTC_LUT_Matrix_Diffuse, material.LTC_LUT_Terms_Diffuse
+            };
+
+            for (const Memory::Texture* texture : textures)
+            {
+                generation += texture->DescriptorGeneration();
+            }
+        }
+
+        return generation;
+    }
+
+    void SceneGPUStorage::UploadInstances(Foundation::JobSystem* jobSystem)
     {
-        mUniqueEntityID = 0;
         mTopAccelerationStructure.Clear();
-        UploadMeshInstances();
+        UploadMeshInstances(jobSystem);
         UploadLights();
         mTopAccelerationStructure.Build();
     }
 
-    void SceneGPUStorage::UploadMeshInstances()
+    void SceneGPUStorage::UploadMeshInstances(Foundation::JobSystem* jobSystem)
     {
         auto& meshInstances = mScene->MeshInstances();
-        auto& sphericalLights = mScene->SphericalLights();
-        auto& rectangularLights = mScene->RectangularLights();
-        auto& diskLights = mScene->DiskLights();
 
         auto requiredBufferSize = meshInstances.size() + mScene->TotalLightCount();
 
@@ -126,40 +250,90 @@ namespace PathFinder
 
         mMeshInstanceTable->RequestWrite();
 
-        uint32_t instanceIdx = 0;
+        uint64_t instanceCount = meshInstances.size();
+
+        mInstanceTransformations.Resize(instanceCount);
+        mPrevInstanceTransformations.Resize(instanceCount);
+        mInstanceWorldMatrices.resize(instanceCount);
 
-        auto uploadInstance = [&](const GPUMeshInstanceTableEntry& gpuInstance, const VertexStorageLocation& vertexLocations, EntityMask mask, auto&& sceneObject)
+        // Instances are packed, so their positions in scene storage are their table indices
+        for (uint64_t index = 0; index < instanceCount; ++index)
         {
-            EntityID entityId = GetNextEntityID();
+            mInstanceTransformations.Set(index, meshInstances[index].Transformation());
+            mPrevInstanceTransformations.Set(index, meshInstances[index].PrevTransformation());
+        }
 
-            sceneObject.SetIndexInGPUTable(instanceIdx);
-            sceneObject.SetEntityID(entityId);
+        GPUMeshInstanceTableEntry* tableEntries = mMeshInstanceTable->WriteOnlyPtr<GPUMeshInstanceTableEntry>();
 
-            BottomRTAS& blas = mBottomAccelerationStructures[vertexLocations.BottomAccelerationStructureIndex];
-            mTopAccelerationStructure.AddInstance(blas, RTASInstanceInfoForEntity(entityId, mask), gpuInstance.InstanceWorldMatrix);
-            mMeshInstanceTable->Write(&gpuInstance, instanceIdx, 1);
+        // Batches write disjoint table entries and only read instances, meshes and materials
+        if (jobSystem && instanceCount > InstanceMatrixBatchSize)
+        {
+            Foundation::TaskGraph batchGraph;
 
-            ++instanceIdx;
-        };
+            for (uint64_t first = 0; first < instanceCount; first += InstanceMatrixBatchSize)
+            {
+                uint64_t count = std::min(InstanceMatrixBatchSize, instanceCount - first);
+                batchGraph.AddTask("Write Mesh Instance Table", [this, tableEntries, first, count] { WriteMeshInstanceTableEntries(tableEntries, first, count); });
+            }
 
-        for (MeshInstance& instance : meshInstances)
+            jobSystem->Execute(batchGraph);
+        }
+        else
         {
-            GPUMeshInstanceTableEntry instanceEntry{
-                instance.Transformation().ModelMatrix(),
-                instance.PrevTransformation().ModelMatrix(),
-                instance.Transformation().NormalMatrix(),
-                instance.AssociatedMaterial()->GPUMaterialTableIndex,
-                instance.AssociatedMesh()->LocationInVertexStorage().VertexBufferOffset,
-                instance.AssociatedMesh()->LocationInVertexStorage().IndexBufferOffset,
-                instance.AssociatedMesh()->LocationInVertexStorage().IndexCount,
-                instance.AssociatedMesh()->HasTangentSpace()
-            };
+            WriteMeshInstanceTableEntries(tableEntries, 0, instanceCount);
+        }
+
+        // Top RT AS is not thread safe and stays sequential
+        for (uint64_t index = 0; index < instanceCount; ++index)
+        {
+            MeshInstance& instance = meshInstances[index];
+
+            instance.SetIndexInGPUTable(uint32_t(index));
+
+            const VertexStorageLocation& location = instance.AssociatedMesh()->LocationInVertexStorage();
+            BottomRTAS& blas = mBottomAccelerationStructures[location.BottomAccelerationStructureIndex];
+
+            // Bottom RT AS is built from quantized positions
+            glm::mat4 instanceMatrix = mInstanceWorldMatrices[index] * location.PositionQuantization.DequantizationMatrix();
+            mTopAccelerationStructure.AddInstance(blas, RTASInstanceInfoForEntity(instance.ID(), EntityMask::MeshInstance), instanceMatrix);
 
-            uploadInstance(instanceEntry, instance.AssociatedMesh()->LocationInVertexStorage(), EntityMask::MeshInstance, instance);
             instance.UpdatePreviousTransform();
         }
     }
 
+    void SceneGPUStorage::WriteMeshInstanceTableEntries(GPUMeshInstanceTableEntry* tableEntries, uint64_t first, uint64_t count)
+    {
+        using MatrixOutput = Geometry::TransformationBatch::MatrixOutput;
+
+        GPUMeshInstanceTableEntry* entries = tableEntries + first;
+        uint64_t entryStride = sizeof(GPUMeshInstanceTableEntry);
+
+        // World matrices are needed by top RT AS as well, so they are composed into regular memory
+        // and copied, instead of being read back from write-combined upload memory later
+        mInstanceTransformations.ComposeMatrices(first, count, MatrixOutput{ &mInstanceWorldMatrices[first] }, MatrixOutput{ &entries->InstanceNormalMatrix, entryStride });
+        mPrevInstanceTransformations.ComposeMatrices(first, count, MatrixOutput{ &entries->InstancePrevWorldMatrix, entryStride }, MatrixOutput{});
+
+        const auto& meshInstances = mScene->MeshInstances();
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            const MeshInstance& instance = meshInstances[first + i];
+            const VertexStorageLocation& location = instance.AssociatedMesh()->LocationInVertexStorage();
+            GPUMeshInstanceTableEntry& entry = entries[i];
+
+            entry.InstanceWorldMatrix = mInstanceWorldMatrices[first + i];
+            entry.MaterialIndex = instance.AssociatedMaterial()->GPUMaterialTableIndex;
+            entry.UnifiedVertexBufferOffset = location.VertexBufferOffset;
+            entry.UnifiedIndexBufferOffset = location.IndexBufferOffsetForLOD(instance.LODIndex());
+            entry.IndexCount = location.IndexCountForLOD(instance.LODIndex());
+            entry.HasTangentSpace = instance.AssociatedMesh()->HasTangentSpace();
+            entry.VertexPositionOffset = location.PositionQuantization.Offset;
+            entry.VertexPositionScale = location.PositionQuantization.Scale;
+            entry.MeshletOffset = location.MeshletOffset;
+            entry.MeshletCount = location.MeshletCount;
+        }
+    }
+
     void SceneGPUStorage::UploadLights()
     {
         auto& sphericalLights = mScene->SphericalLights();
@@ -193,14 +367,12 @@ namespace PathFinder
                 GPULightTableEntry lightEntry = CreateLightGPUTableEntry(light);
                 mLightTable->Write(&lightEntry, index, 1);
 
-                EntityID entityId = GetNextEntityID();
-
-                light.SetEntityID(entityId);
                 light.SetIndexInGPUTable(index);
                 light.SetVertexStorageLocation(vertexLocation);
 
                 BottomRTAS& blas = mBottomAccelerationStructures[vertexLocation.BottomAccelerationStructureIndex];
-                mTopAccelerationStructure.AddInstance(blas, RTASInstanceInfoForEntity(entityId, EntityMask::Light), light.ModelMatrix());
+                mTopAccelerationStructure.AddInstance(
+                    blas, RTASInstanceInfoForEntity(light.ID(), EntityMask::Light), light.ModelMatrix() * vertexLocation.PositionQuantization.DequantizationMatrix());
 
                 ++index;
                 ++lightCount;
@@ -213,11 +385,6 @@ namespace PathFinder
         uploadLights(mScene->DiskLights(), mLightTablePartitionInfo.EllipticalLightsOffset, mLightTablePartitionInfo.EllipticalLightsCount, mUnitQuadVertexLocation);
     }
 
-    EntityID SceneGPUStorage::GetNextEntityID()
-    {
-        return ++mUniqueEntityID;
-    }
-
     GPUCamera SceneGPUStorage::CameraGPURepresentation() const
     {
         const PathFinder::Camera& camera = mScene->MainCamera();
@@ -264,7 +431,9 @@ namespace PathFinder
                 light.ModelMatrix(),
                 mUnitQuadVertexLocation.VertexBufferOffset,
                 mUnitQuadVertexLocation.IndexBufferOffset,
-                mUnitQuadVertexLocation.IndexCount
+                mUnitQuadVertexLocation.IndexCount,
+                mUnitQuadVertexLocation.PositionQuantization.Offset,
+                mUnitQuadVertexLocation.PositionQuantization.Scale
         };
     }
 
@@ -281,7 +450,9 @@ namespace PathFinder
                 light.ModelMatrix(),
                 mUnitSphereVertexLocation.VertexBufferOffset,
                 mUnitSphereVertexLocation.IndexBufferOffset,
-                mUnitSphereVertexLocation.IndexCount
+                mUnitSphereVertexLocation.IndexCount,
+                mUnitSphereVertexLocation.PositionQuantization.Offset,
+                mUnitSphereVertexLocation.PositionQuantization.Scale
         };
     }
 
@@ -6,10 +6,12 @@
 #include <HardwareAbstractionLayer/ResourceBarrier.hpp>
 
 #include <Memory/GPUResourceProducer.hpp>
+#include <Geometry/TransformationBatch.hpp>
+#include <Foundation/JobSystem.hpp>
 
 #include "Mesh.hpp"
 #include "MeshInstance.hpp"
-#include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+#include "Vertices/CompressedVertex1P1N1UV1T1BT.hpp"
 #include "Vertices/Vertex1P1N1UV.hpp"
 #include "Vertices/Vertex1P3.hpp"
 #include "FlatLight.hpp"
@@ -22,6 +24,7 @@
 #include <vector>
 #include <memory>
 #include <tuple>
+#include <type_traits>
 
 namespace PathFinder
 {
@@ -40,6 +43,33 @@ namespace PathFinder
         uint32_t IndexCount;
         // 16 byte boundary
         uint32_t HasTangentSpace;
+        glm::vec3 VertexPositionOffset;
+        // 16 byte boundary
+        glm::vec3 VertexPositionScale;
+        uint32_t MeshletOffset;
+        uint32_t MeshletCount;
+    };
+
+    // Bounds are in mesh space, offsets are absolute positions in unified meshlet vertex and triangle buffers.
+    // Meshlet vertices are mesh relative vertex indices, triangles are three 8 bit local indices packed into 32 bits.
+    struct GPUMeshletTableEntry
+    {
+        glm::vec3 BoundingSphereCenter;
+        float BoundingSphereRadius;
+        // 16 byte boundary
+        glm::vec3 ConeApex;
+        float ConeCutoff;
+        // 16 byte boundary
+        glm::vec3 ConeAxis;
+        uint32_t VertexCount;
+        // 16 byte boundary
+        glm::vec3 BoundingBoxMin;
+        uint32_t TriangleCount;
+        // 16 byte boundary
+        glm::vec3 BoundingBoxMax;
+        uint32_t UnifiedMeshletVertexBufferOffset;
+        // 16 byte boundary
+        uint32_t UnifiedMeshletTriangleBufferOffset;
     };
 
     struct GPUMaterialTableEntry
@@ -92,6 +122,8 @@ namespace PathFinder
         uint32_t UnifiedVertexBufferOffset;
         uint32_t UnifiedIndexBufferOffset;
         uint32_t IndexCount;
+        glm::vec3 VertexPositionOffset;
+        glm::vec3 VertexPositionScale;
     };
 
     struct GPULightTablePartitionInfo
@@ -140,7 +172,13 @@ namespace PathFinder
 
         void UploadMeshes();
         void UploadMaterials();
-        void UploadInstances();
+
+        // Scene textures get new descriptors when they are relocated by defragmentation,
+        // material table has to be uploaded again to reference them
+        bool AreMaterialDescriptorsOutdated() const;
+
+        // Instance matrices are composed in parallel batches when a job system is provided
+        void UploadInstances(Foundation::JobSystem* jobSystem = nullptr);
 
         GPUCamera CameraGPURepresentation() const;
 
@@ -160,13 +198,27 @@ namespace PathFinder
             Memory::GPUResourceProducer::BufferPtr IndexBuffer;
         };
 
+        struct MeshletUploadBufferPackage
+        {
+            std::vector<GPUMeshletTableEntry> Meshlets;
+            std::vector<uint32_t> Vertices;
+            std::vector<uint32_t> Triangles;
+        };
+
         template <class Vertex>
         void SubmitTemporaryBuffersToGPU();
 
-        void UploadMeshInstances();
+        void SubmitMeshletBuffersToGPU();
+
+        // Multiple of SIMD lane count, so only the last batch has a scalar remainder
+        static const uint64_t InstanceMatrixBatchSize = 4096;
+
+        void UploadMeshInstances(Foundation::JobSystem* jobSystem);
+        void WriteMeshInstanceTableEntries(GPUMeshInstanceTableEntry* tableEntries, uint64_t first, uint64_t count);
         void UploadLights();
 
-        EntityID GetNextEntityID();
+        // Sum of descriptor generations of all material textures, grows whenever any of them is relocated
+        uint64_t MaterialDescriptorGeneration() const;
 
         GPULightTableEntry CreateLightGPUTableEntry(const FlatLight& light) const;
         GPULightTableEntry CreateLightGPUTableEntry(const SphericalLight& light) const;
@@ -174,15 +226,28 @@ namespace PathFinder
         template <class Vertex>
         VertexStorageLocation WriteToTemporaryBuffers(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices = nullptr, uint32_t indexCount = 0);
 
-        std::tuple<UploadBufferPackage<Vertex1P1N1UV1T1BT>, UploadBufferPackage<Vertex1P1N1UV>, UploadBufferPackage<Vertex1P3>> mUploadBuffers;
-        std::tuple<FinalBufferPackage<Vertex1P1N1UV1T1BT>, FinalBufferPackage<Vertex1P1N1UV>, FinalBufferPackage<Vertex1P3>> mFinalBuffers;
+        // Writes compressed vertices and meshlets of a mesh, returned location carries their dequantization parameters
+        VertexStorageLocation WriteToTemporaryBuffers(const Mesh& mesh);
+
+        std::tuple<UploadBufferPackage<CompressedVertex1P1N1UV1T1BT>, UploadBufferPackage<Vertex1P1N1UV>, UploadBufferPackage<Vertex1P3>> mUploadBuffers;
+        std::tuple<FinalBufferPackage<CompressedVertex1P1N1UV1T1BT>, FinalBufferPackage<Vertex1P1N1UV>, FinalBufferPackage<Vertex1P3>> mFinalBuffers;
+        MeshletUploadBufferPackage mMeshletUploadBuffers;
 
         std::vector<BottomRTAS> mBottomAccelerationStructures;
         TopRTAS mTopAccelerationStructure;
 
+        // Transformations of mesh instances in order of the instance table
+        Geometry::TransformationBatch mInstanceTransformations;
+        Geometry::TransformationBatch mPrevInstanceTransformations;
+        std::vector<glm::mat4> mInstanceWorldMatrices;
+
         Memory::GPUResourceProducer::BufferPtr mMeshInstanceTable;
         Memory::GPUResourceProducer::BufferPtr mLightTable;
         Memory::GPUResourceProducer::BufferPtr mMaterialTable;
+        uint64_t mUploadedMaterialDescriptorGeneration = 0;
+        Memory::GPUResourceProducer::BufferPtr mMeshletTable;
+        Memory::GPUResourceProducer::BufferPtr mMeshletVertexBuffer;
+        Memory::GPUResourceProducer::BufferPtr mMeshletTriangleBuffer;
 
         VertexStorageLocation mUnitQuadVertexLocation;
         VertexStorageLocation mUnitCubeVertexLocation;
@@ -193,14 +258,15 @@ namespace PathFinder
         const HAL::Device* mDevice;
         Memory::GPUResourceProducer* mResourceProducer;
 
-        EntityID mUniqueEntityID = 0;
-
     public:
-        inline const auto UnifiedVertexBuffer() const { return std::get<FinalBufferPackage<Vertex1P1N1UV1T1BT>>(mFinalBuffers).VertexBuffer.get(); }
-        inline const auto UnifiedIndexBuffer() const { return std::get<FinalBufferPackage<Vertex1P1N1UV1T1BT>>(mFinalBuffers).IndexBuffer.get(); }
+        inline const auto UnifiedVertexBuffer() const { return std::get<FinalBufferPackage<CompressedVertex1P1N1UV1T1BT>>(mFinalBuffers).VertexBuffer.get(); }
+        inline const auto UnifiedIndexBuffer() const { return std::get<FinalBufferPackage<CompressedVertex1P1N1UV1T1BT>>(mFinalBuffers).IndexBuffer.get(); }
         inline const auto MeshInstanceTable() const { return mMeshInstanceTable.get(); }
         inline const auto LightTable() const { return mLightTable.get(); }
         inline const auto MaterialTable() const { return mMaterialTable.get(); }
+        inline const auto MeshletTable() const { return mMeshletTable.get(); }
+        inline const auto MeshletVertexBuffer() const { return mMeshletVertexBuffer.get(); }
+        inline const auto MeshletTriangleBuffer() const { return mMeshletTriangleBuffer.get(); }
         inline const auto& LightTablePartitionInfo() const { return mLightTablePartitionInfo; }
         inline const auto& TopAccelerationStructure() const { return mTopAccelerationStructure; }
         inline const auto& BottomAccelerationStructures() const { return mBottomAccelerationStructures; }
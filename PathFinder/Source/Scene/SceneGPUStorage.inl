@@ -34,7 +34,7 @@ namespace PathFinder
         if (!uploadBuffers.Vertices.empty())
         {
             auto properties = HAL::BufferProperties::Create<Vertex>(uploadBuffers.Vertices.size());
-            finalBuffers.VertexBuffer = mResourceProducer->NewBuffer(properties);
+            finalBuffers.VertexBuffer = mResourceProducer->NewBuffer(properties, Memory::GPUResource::AccessStrategy::Automatic, Memory::MemoryCategory::VertexIndex);
             finalBuffers.VertexBuffer->RequestWrite();
             finalBuffers.VertexBuffer->Write(uploadBuffers.Vertices.data(), 0, uploadBuffers.Vertices.size());
             finalBuffers.VertexBuffer->SetDebugName("Unified Vertex Buffer");
@@ -44,7 +44,7 @@ namespace PathFinder
         if (!uploadBuffers.Indices.empty())
         {
             auto properties = HAL::BufferProperties::Create<uint32_t>(uploadBuffers.Indices.size());
-            finalBuffers.IndexBuffer = mResourceProducer->NewBuffer(properties);
+            finalBuffers.IndexBuffer = mResourceProducer->NewBuffer(properties, Memory::GPUResource::AccessStrategy::Automatic, Memory::MemoryCategory::VertexIndex);
             finalBuffers.IndexBuffer->RequestWrite();
             finalBuffers.IndexBuffer->Write(uploadBuffers.Indices.data(), 0, uploadBuffers.Indices.size());
             finalBuffers.IndexBuffer->SetDebugName("Unified Index Buffer");
@@ -55,8 +55,11 @@ namespace PathFinder
         {
             BottomRTAS& blas = mBottomAccelerationStructures[location.BottomAccelerationStructureIndex];
 
+            // Quantized positions are consumed as is, dequantization is a part of instance transforms in top RT AS
+            HAL::ColorFormat positionFormat = std::is_same_v<Vertex, CompressedVertex1P1N1UV1T1BT> ? HAL::ColorFormat::RGBA16_Signed_Norm : HAL::ColorFormat::RGB32_Float;
+
             HAL::RayTracingGeometry blasGeometry{
-                finalBuffers.VertexBuffer->HALBuffer(), location.VertexBufferOffset, location.VertexCount, sizeof(Vertex), HAL::ColorFormat::RGB32_Float,
+                finalBuffers.VertexBuffer->HALBuffer(), location.VertexBufferOffset, location.VertexCount, sizeof(Vertex), positionFormat,
                 finalBuffers.IndexBuffer->HALBuffer(), location.IndexBufferOffset, location.IndexCount, sizeof(uint32_t), HAL::ColorFormat::R32_Unsigned,
                 glm::mat4x4{}, true
             };
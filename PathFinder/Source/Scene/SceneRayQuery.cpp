@@ -0,0 +1,76 @@
+#include "SceneRayQuery.hpp"
+
+#include <glm/gtc/matrix_inverse.hpp>
+
+namespace PathFinder
+{
+
+    void SceneRayQuery::Build(Foundation::SlotMap<MeshInstance>& instances, Foundation::JobSystem* jobSystem)
+    {
+        mInstances.clear();
+
+        std::vector<Geometry::AxisAlignedBox3D> instanceBounds;
+
+        for (MeshInstance& instance : instances)
+        {
+            const Mesh* mesh = instance.AssociatedMesh();
+            glm::mat4 meshToWorld = instance.Transformation().ModelMatrix();
+
+            // Collapsed instances can't be hit and have no inverse transformation
+            if (mesh->TriangleCount() == 0 || glm::determinant(meshToWorld) == 0.0f)
+            {
+                continue;
+            }
+
+            assert_format(!mesh->TriangleBVH().IsEmpty(), "Mesh triangle hierarchy must be built before instances are queried");
+
+            mInstances.push_back({ &instance, meshToWorld, glm::inverse(meshToWorld) });
+            instanceBounds.push_back(instance.BoundingBox(*mesh));
+        }
+
+        mInstanceBVH.Build(instanceBounds, jobSystem);
+    }
+
+    std::optional<SceneRayQuery::Hit> SceneRayQuery::CastRay(const Geometry::Ray3D& ray, float maxDistance) const
+    {
+        std::optional<Hit> closestHit;
+
+        mInstanceBVH.CastRay(ray, maxDistance, [this, &ray, &closestHit](uint32_t instanceIdx, float& distance)
+        {
+            const Instance& instance = mInstances[instanceIdx];
+
+            // Mesh space ray direction is normalized again, so distances
+            // are converted between spaces through points on the ray
+            Geometry::Ray3D meshSpaceRay = ray.transformedBy(instance.WorldToMesh);
+            float meshSpaceMaxDistance = std::numeric_limits<float>::max();
+
+            if (distance < std::numeric_limits<float>::max())
+            {
+                glm::vec3 meshSpaceMaxPoint = instance.WorldToMesh * glm::vec4{ ray.origin + ray.direction * distance, 1.0f };
+                meshSpaceMaxDistance = glm::length(meshSpaceMaxPoint - meshSpaceRay.origin);
+            }
+
+            auto meshHit = instance.SceneInstance->AssociatedMesh()->CastRay(meshSpaceRay, meshSpaceMaxDistance);
+
+            if (!meshHit)
+            {
+                return false;
+            }
+
+            glm::vec3 meshSpacePosition = meshSpaceRay.origin + meshSpaceRay.direction * meshHit->Distance;
+            glm::vec3 position = instance.MeshToWorld * glm::vec4{ meshSpacePosition, 1.0f };
+            distance = glm::length(position - ray.origin);
+
+            if (closestHit && distance >= closestHit->Distance)
+            {
+                return false;
+            }
+
+            closestHit = Hit{ instance.SceneInstance, meshHit->PrimitiveIndex, distance, position };
+            return true;
+        });
+
+        return closestHit;
+    }
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "MeshInstance.hpp"
+
+#include <Geometry/BoundingVolumeHierarchy.hpp>
+#include <Geometry/Ray3D.hpp>
+#include <Foundation/SlotMap.hpp>
+
+#include <vector>
+#include <optional>
+#include <limits>
+
+namespace PathFinder
+{
+
+    /// Synchronous ray casts against mesh instances on CPU, without waiting for GPU picking readback.
+    /// Instance bounds form the top level hierarchy. Rays that reach an instance are moved
+    /// into its mesh space and traverse triangle hierarchy cached in the mesh.
+    class SceneRayQuery
+    {
+    public:
+        struct Hit
+        {
+            MeshInstance* Instance = nullptr;
+            uint32_t TriangleIndex = 0;
+            float Distance = 0.0f;
+            glm::vec3 Position;
+        };
+
+        // Captures current instance transformations, so the query has to be rebuilt after instances move.
+        // Meshes of the instances must have their triangle hierarchies built.
+        void Build(Foundation::SlotMap<MeshInstance>& instances, Foundation::JobSystem* jobSystem = nullptr);
+
+        std::optional<Hit> CastRay(const Geometry::Ray3D& ray, float maxDistance = std::numeric_limits<float>::max()) const;
+
+    private:
+        struct Instance
+        {
+            MeshInstance* SceneInstance = nullptr;
+            glm::mat4 MeshToWorld;
+            glm::mat4 WorldToMesh;
+        };
+
+        std::vector<Instance> mInstances;
+        Geometry::BoundingVolumeHierarchy mInstanceBVH;
+    };
+
+}
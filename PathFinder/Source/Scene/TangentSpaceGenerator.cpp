@@ -0,0 +1,485 @@
+#include "TangentSpaceGenerator.hpp"
+
+#include <Foundation/HashUtils.hpp>
+#include <robinhood/robin_hood.h>
+
+#include <glm/geometric.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cstring>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        const uint32_t NoGroup = std::numeric_limits<uint32_t>::max();
+
+        // Position, UV and normal, without tangent space that is being generated
+        struct SurfaceBytesHash
+        {
+            const std::vector<Vertex1P1N1UV1T1BT>* Vertices;
+
+            size_t operator()(uint32_t index) const
+            {
+                uint32_t words[sizeof(Vertex1P1N1UV) / sizeof(uint32_t)];
+                std::memcpy(words, static_cast<const Vertex1P1N1UV*>(&(*Vertices)[index]), sizeof(words));
+
+                uint64_t hash = 0;
+                for (uint32_t word : words) hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+                return Foundation::HashUtils::Mix(hash);
+            }
+        };
+
+        struct SurfaceBytesEqual
+        {
+            const std::vector<Vertex1P1N1UV1T1BT>* Vertices;
+
+            bool operator()(uint32_t a, uint32_t b) const
+            {
+                return std::memcmp(static_cast<const Vertex1P1N1UV*>(&(*Vertices)[a]), static_cast<const Vertex1P1N1UV*>(&(*Vertices)[b]), sizeof(Vertex1P1N1UV)) == 0;
+            }
+        };
+
+        static_assert(sizeof(Vertex1P1N1UV) % sizeof(uint32_t) == 0, "Vertex bytes are hashed as words and must have no padding");
+
+        struct TriangleFrame
+        {
+            // Directions of increasing U and V, zero when undefined
+            glm::vec3 Tangent{ 0.0f };
+            glm::vec3 Bitangent{ 0.0f };
+
+            // Coincident positions, triangle is left out of grouping
+            bool IsDegenerate = false;
+
+            // Zero UV area or UV derivatives, triangle joins any neighbouring group
+            bool GroupsWithAny = true;
+
+            bool PreservesOrientation = false;
+        };
+
+        struct CornerFrame
+        {
+            glm::vec3 Tangent;
+            float BitangentSign;
+
+            // Index of the group among groups of the corner vertex
+            uint32_t Group;
+        };
+
+        glm::vec3 AnyOrthogonalVector(const glm::vec3& v)
+        {
+            if (glm::length2(v) <= 0.0f)
+            {
+                return glm::vec3{ 1.0f, 0.0f, 0.0f };
+            }
+
+            glm::vec3 axis = std::abs(v.x) < 0.9f ? glm::vec3{ 1.0f, 0.0f, 0.0f } : glm::vec3{ 0.0f, 1.0f, 0.0f };
+            return glm::normalize(glm::cross(v, axis));
+        }
+
+        glm::vec3 SafeNormalize(const glm::vec3& v)
+        {
+            float length = glm::length(v);
+            return length > std::numeric_limits<float>::min() ? v / length : glm::vec3{ 0.0f };
+        }
+
+        TriangleFrame ComputeTriangleFrame(const Vertex1P1N1UV1T1BT& v0, const Vertex1P1N1UV1T1BT& v1, const Vertex1P1N1UV1T1BT& v2)
+        {
+            TriangleFrame frame;
+
+            glm::vec3 p0{ v0.Position }, p1{ v1.Position }, p2{ v2.Position };
+
+            if (p0 == p1 || p1 == p2 || p0 == p2)
+            {
+                frame.IsDegenerate = true;
+                return frame;
+            }
+
+            glm::vec3 d1 = p1 - p0;
+            glm::vec3 d2 = p2 - p0;
+            glm::vec2 t21 = v1.UV - v0.UV;
+            glm::vec2 t31 = v2.UV - v0.UV;
+
+            float signedUVArea = t21.x * t31.y - t21.y * t31.x;
+
+            frame.PreservesOrientation = signedUVArea > 0.0f;
+
+            if (std::abs(signedUVArea) <= std::numeric_limits<float>::min())
+            {
+                return frame;
+            }
+
+            // Unnormalized derivatives of position by U and V, scaled by UV area
+            glm::vec3 os = t31.y * d1 - t21.y * d2;
+            glm::vec3 ot = t21.x * d2 - t31.x * d1;
+
+            float sign = frame.PreservesOrientation ? 1.0f : -1.0f;
+            float lengthOs = glm::length(os);
+            float lengthOt = glm::length(ot);
+
+            if (lengthOs > std::numeric_limits<float>::min()) frame.Tangent = os * (sign / lengthOs);
+            if (lengthOt > std::numeric_limits<float>::min()) frame.Bitangent = ot * (sign / lengthOt);
+
+            float absUVArea = std::abs(signedUVArea);
+            frame.GroupsWithAny = lengthOs / absUVArea <= std::numeric_limits<float>::min() || lengthOt / absUVArea <= std::numeric_limits<float>::min();
+
+            return frame;
+        }
+
+        template <class Function>
+        void ForEachBatch(Foundation::JobSystem* jobSystem, uint64_t count, uint64_t batchSize, const std::string& name, const Function& function)
+        {
+            if (!jobSystem || count <= batchSize)
+            {
+                function(0, count);
+                return;
+            }
+
+            Foundation::TaskGraph graph;
+
+            for (uint64_t first = 0; first < count; first += batchSize)
+            {
+                uint64_t batchCount = std::min(batchSize, count - first);
+                graph.AddTask(name, [&function, first, batchCount] { function(first, batchCount); });
+            }
+
+            jobSystem->Execute(graph);
+        }
+    }
+
+    TangentSpaceGenerator::TangentSpaceGenerator(const Settings& settings)
+        : mSettings{ settings } {}
+
+    void TangentSpaceGenerator::Generate(Mesh& mesh, Foundation::JobSystem* jobSystem) const
+    {
+        std::vector<Vertex1P1N1UV1T1BT> vertices = mesh.Vertices();
+        std::vector<uint32_t> indices = mesh.Indices();
+
+        if (indices.empty())
+        {
+            indices.resize(vertices.size());
+            std::iota(indices.begin(), indices.end(), 0);
+        }
+
+        Generate(vertices, indices, jobSystem);
+
+        mesh.SetGeometry(std::move(vertices), std::move(indices), mesh.BoundingBox(), mesh.SurfaceArea(), true);
+    }
+
+    void TangentSpaceGenerator::Generate(std::vector<Vertex1P1N1UV1T1BT>& vertices, std::vector<uint32_t>& indices, Foundation::JobSystem* jobSystem) const
+    {
+        assert_format(mSettings.BatchSize > 0, "Batch size must be positive");
+
+        uint64_t triangleCount = indices.size() / 3;
+        uint64_t cornerCount = triangleCount * 3;
+
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        // Vertices with bitwise equal surface attributes are one vertex for grouping
+        std::vector<uint32_t> surfaceVertices(vertices.size());
+        uint32_t surfaceVertexCount = 0;
+
+        {
+            robin_hood::unordered_flat_map<uint32_t, uint32_t, SurfaceBytesHash, SurfaceBytesEqual> uniqueVertices{
+                0, SurfaceBytesHash{ &vertices }, SurfaceBytesEqual{ &vertices } };
+
+            uniqueVertices.reserve(vertices.size());
+
+            for (uint32_t vertexIdx = 0; vertexIdx < vertices.size(); ++vertexIdx)
+            {
+                auto [it, isInserted] = uniqueVertices.try_emplace(vertexIdx, surfaceVertexCount);
+                surfaceVertices[vertexIdx] = it->second;
+                surfaceVertexCount += isInserted ? 1 : 0;
+            }
+        }
+
+        std::vector<TriangleFrame> triangleFrames(triangleCount);
+
+        ForEachBatch(jobSystem, triangleCount, mSettings.BatchSize, "Compute Triangle Tangent Frames", [&](uint64_t first, uint64_t count)
+        {
+            for (uint64_t triangleIdx = first; triangleIdx < first + count; ++triangleIdx)
+            {
+                triangleFrames[triangleIdx] = ComputeTriangleFrame(
+                    vertices[indices[triangleIdx * 3 + 0]], vertices[indices[triangleIdx * 3 + 1]], vertices[indices[triangleIdx * 3 + 2]]);
+            }
+        });
+
+        // Corners of every surface vertex
+        std::vector<uint32_t> cornerOffsets(surfaceVertexCount + 1, 0);
+        std::vector<uint32_t> vertexCorners(cornerCount);
+
+        for (uint64_t corner = 0; corner < cornerCount; ++corner)
+        {
+            ++cornerOffsets[surfaceVertices[indices[corner]] + 1];
+        }
+
+        std::partial_sum(cornerOffsets.begin(), cornerOffsets.end(), cornerOffsets.begin());
+
+        {
+            std::vector<uint32_t> cornerFill{ cornerOffsets.begin(), cornerOffsets.end() - 1 };
+
+            for (uint64_t corner = 0; corner < cornerCount; ++corner)
+            {
+                vertexCorners[cornerFill[surfaceVertices[indices[corner]]]++] = uint32_t(corner);
+            }
+        }
+
+        std::vector<CornerFrame> cornerFrames(cornerCount);
+
+        // Vertices only write frames of their own corners
+        ForEachBatch(jobSystem, surfaceVertexCount, mSettings.BatchSize, "Compute Vertex Tangent Frames", [&](uint64_t first, uint64_t count)
+        {
+            // Per corner of the current vertex, reused across vertices of the batch
+            std::vector<uint32_t> parents;
+            std::vector<uint32_t> groups;
+            std::vector<bool> isGrouped;
+            std::vector<std::pair<uint32_t, uint32_t>> nextVertices;
+            std::vector<std::pair<uint32_t, uint32_t>> links;
+            std::vector<glm::vec3> tangentSums;
+            std::vector<glm::vec3> bitangentSums;
+
+            auto findRoot = [&parents](uint32_t corner)
+            {
+                while (parents[corner] != corner)
+                {
+                    parents[corner] = parents[parents[corner]];
+                    corner = parents[corner];
+                }
+
+                return corner;
+            };
+
+            for (uint64_t surfaceVertex = first; surfaceVertex < first + count; ++surfaceVertex)
+            {
+                const uint32_t* corners = vertexCorners.data() + cornerOffsets[surfaceVertex];
+                uint32_t localCornerCount = cornerOffsets[surfaceVertex + 1] - cornerOffsets[surfaceVertex];
+
+                if (localCornerCount == 0)
+                {
+                    continue;
+                }
+
+                auto triangleFrame = [&](uint32_t localCorner) -> const TriangleFrame& { return triangleFrames[corners[localCorner] / 3]; };
+
+                auto neighbourVertex = [&](uint32_t localCorner, uint32_t offset)
+                {
+                    uint32_t corner = corners[localCorner];
+                    return surfaceVertices[indices[corner - corner % 3 + (corner + offset) % 3]];
+                };
+
+                // Triangles are linked through edges with consistent winding: outgoing edge of one is incoming edge of another
+                nextVertices.clear();
+                links.clear();
+
+                for (uint32_t localCorner = 0; localCorner < localCornerCount; ++localCorner)
+                {
+                    if (!triangleFrame(localCorner).IsDegenerate)
+                    {
+                        nextVertices.emplace_back(neighbourVertex(localCorner, 1), localCorner);
+                    }
+                }
+
+                std::sort(nextVertices.begin(), nextVertices.end());
+
+                for (uint32_t localCorner = 0; localCorner < localCornerCount; ++localCorner)
+                {
+                    if (triangleFrame(localCorner).IsDegenerate)
+                    {
+                        continue;
+                    }
+
+                    uint32_t previousVertex = neighbourVertex(localCorner, 2);
+                    auto it = std::lower_bound(nextVertices.begin(), nextVertices.end(), std::make_pair(previousVertex, 0u));
+
+                    for (; it != nextVertices.end() && it->first == previousVertex; ++it)
+                    {
+                        if (it->second != localCorner)
+                        {
+                            links.emplace_back(localCorner, it->second);
+                        }
+                    }
+                }
+
+                parents.resize(localCornerCount);
+                std::iota(parents.begin(), parents.end(), 0);
+
+                isGrouped.assign(localCornerCount, false);
+
+                auto isRegular = [&](uint32_t localCorner) { return !triangleFrame(localCorner).IsDegenerate && !triangleFrame(localCorner).GroupsWithAny; };
+
+                // Regular triangles group only with the same UV orientation
+                for (auto [a, b] : links)
+                {
+                    if (isRegular(a) && isRegular(b) && triangleFrame(a).PreservesOrientation == triangleFrame(b).PreservesOrientation)
+                    {
+                        parents[findRoot(a)] = findRoot(b);
+                    }
+                }
+
+                for (uint32_t localCorner = 0; localCorner < localCornerCount; ++localCorner)
+                {
+                    isGrouped[localCorner] = isRegular(localCorner);
+                }
+
+                // Triangles with degenerate UVs join the first group reaching them from either side of a link, without merging groups
+                for (bool isChanged = true; isChanged;)
+                {
+                    isChanged = false;
+
+                    for (auto [a, b] : links)
+                    {
+                        if (isGrouped[a] != isGrouped[b])
+                        {
+                            uint32_t grouped = isGrouped[a] ? a : b;
+                            uint32_t ungrouped = isGrouped[a] ? b : a;
+
+                            parents[ungrouped] = findRoot(grouped);
+                            isGrouped[ungrouped] = true;
+                            isChanged = true;
+                        }
+                    }
+                }
+
+                // and form their own groups when no regular triangle is connected to them
+                for (auto [a, b] : links)
+                {
+                    if (!isGrouped[a] && !isGrouped[b])
+                    {
+                        parents[findRoot(a)] = findRoot(b);
+                    }
+                }
+
+                // Triangles with coincident positions take a frame of the vertex
+                uint32_t firstNonDegenerate = NoGroup;
+                uint32_t firstDegenerate = NoGroup;
+
+                for (uint32_t localCorner = 0; localCorner < localCornerCount; ++localCorner)
+                {
+                    uint32_t& first = triangleFrame(localCorner).IsDegenerate ? firstDegenerate : firstNonDegenerate;
+                    first = first == NoGroup ? localCorner : first;
+                }
+
+                for (uint32_t localCorner = 0; localCorner < localCornerCount; ++localCorner)
+                {
+                    if (triangleFrame(localCorner).IsDegenerate)
+                    {
+                        parents[localCorner] = findRoot(firstNonDegenerate != NoGroup ? firstNonDegenerate : firstDegenerate);
+                    }
+                }
+
+                // Compact group indices in order of first corners
+                groups.assign(localCornerCount, NoGroup);
+                uint32_t groupCount = 0;
+
+                for (uint32_t localCorner = 0; localCorner < localCornerCount; ++localCorner)
+                {
+                    uint32_t root = findRoot(localCorner);
+
+                    if (groups[root] == NoGroup)
+                    {
+                        groups[root] = groupCount++;
+                    }
+
+                    groups[localCorner] = groups[root];
+                }
+
+                const Vertex1P1N1UV1T1BT& vertex = vertices[indices[corners[0]]];
+                glm::vec3 normal = SafeNormalize(vertex.Normal);
+                glm::vec3 position{ vertex.Position };
+
+                tangentSums.assign(groupCount, glm::vec3{ 0.0f });
+                bitangentSums.assign(groupCount, glm::vec3{ 0.0f });
+
+                // Triangle directions projected onto the tangent plane, weighted by corner angles
+                for (uint32_t localCorner = 0; localCorner < localCornerCount; ++localCorner)
+                {
+                    if (!isRegular(localCorner))
+                    {
+                        continue;
+                    }
+
+                    const TriangleFrame& frame = triangleFrame(localCorner);
+                    uint32_t corner = corners[localCorner];
+                    uint32_t triangleStart = corner - corner % 3;
+
+                    glm::vec3 next{ vertices[indices[triangleStart + (corner + 1) % 3]].Position };
+                    glm::vec3 previous{ vertices[indices[triangleStart + (corner + 2) % 3]].Position };
+
+                    float cosine = glm::dot(SafeNormalize(next - position), SafeNormalize(previous - position));
+                    float angle = std::acos(std::clamp(cosine, -1.0f, 1.0f));
+
+                    tangentSums[groups[localCorner]] += angle * SafeNormalize(frame.Tangent - normal * glm::dot(normal, frame.Tangent));
+                    bitangentSums[groups[localCorner]] += angle * SafeNormalize(frame.Bitangent - normal * glm::dot(normal, frame.Bitangent));
+                }
+
+                for (uint32_t localCorner = 0; localCorner < localCornerCount; ++localCorner)
+                {
+                    uint32_t group = groups[localCorner];
+                    glm::vec3 tangent = SafeNormalize(tangentSums[group]);
+
+                    if (glm::length2(tangent) <= 0.0f)
+                    {
+                        tangent = AnyOrthogonalVector(normal);
+                    }
+
+                    float bitangentSign = glm::dot(glm::cross(normal, tangent), bitangentSums[group]) < 0.0f ? -1.0f : 1.0f;
+
+                    cornerFrames[corners[localCorner]] = CornerFrame{ tangent, bitangentSign, group };
+                }
+            }
+        });
+
+        // Vertices keep a frame of the first group using them, other groups get copies
+        std::vector<uint32_t> vertexGroups(vertices.size(), NoGroup);
+        robin_hood::unordered_flat_map<uint64_t, uint32_t> splitVertices;
+
+        auto writeFrame = [](Vertex1P1N1UV1T1BT& vertex, const glm::vec3& tangent, float bitangentSign)
+        {
+            vertex.Tangent = tangent;
+            vertex.Bitangent = bitangentSign * glm::cross(SafeNormalize(vertex.Normal), tangent);
+        };
+
+        for (uint64_t corner = 0; corner < cornerCount; ++corner)
+        {
+            uint32_t vertexIdx = indices[corner];
+            const CornerFrame& frame = cornerFrames[corner];
+
+            if (vertexGroups[vertexIdx] == NoGroup)
+            {
+                vertexGroups[vertexIdx] = frame.Group;
+                writeFrame(vertices[vertexIdx], frame.Tangent, frame.BitangentSign);
+            }
+            else if (vertexGroups[vertexIdx] != frame.Group)
+            {
+                auto [it, isInserted] = splitVertices.try_emplace((uint64_t(vertexIdx) << 32) | frame.Group, uint32_t(vertices.size()));
+
+                if (isInserted)
+                {
+                    Vertex1P1N1UV1T1BT copy = vertices[vertexIdx];
+                    writeFrame(copy, frame.Tangent, frame.BitangentSign);
+                    vertices.push_back(copy);
+                }
+
+                indices[corner] = it->second;
+            }
+        }
+
+        // Unreferenced vertices still get a valid frame
+        for (uint32_t vertexIdx = 0; vertexIdx < vertexGroups.size(); ++vertexIdx)
+        {
+            if (vertexGroups[vertexIdx] == NoGroup)
+            {
+                writeFrame(vertices[vertexIdx], AnyOrthogonalVector(SafeNormalize(vertices[vertexIdx].Normal)), 1.0f);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Mesh.hpp"
+#include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+
+#include <Foundation/JobSystem.hpp>
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /// Per vertex tangent frames following MikkTSpace rules.
+    ///
+    /// Corners sharing position, normal and UV form a vertex. Around each vertex, corners connected through
+    /// shared edges of triangles with the same UV orientation form a group, so mirrored UV charts never blend.
+    /// Group tangent is a sum of triangle UV tangents projected onto vertex normal and weighted by corner angles,
+    /// bitangent sign follows accumulated triangle bitangents. Triangles with degenerate UVs join any neighbouring group
+    /// and contribute nothing, triangles with coincident positions take the frame of another group of the vertex.
+    /// Vertices used by several groups are split, tangent is always orthogonal to vertex normal.
+    ///
+    /// Triangles and vertices are processed in parallel batches when a job system is provided.
+    class TangentSpaceGenerator
+    {
+    public:
+        struct Settings
+        {
+            // Triangles or vertices processed by a single task
+            uint64_t BatchSize = 8192;
+        };
+
+        TangentSpaceGenerator() = default;
+        TangentSpaceGenerator(const Settings& settings);
+
+        // Replaces tangents and bitangents, non indexed meshes are treated as having sequential indices
+        void Generate(Mesh& mesh, Foundation::JobSystem* jobSystem = nullptr) const;
+
+        // New vertices are appended for split ones and indices are redirected to them
+        void Generate(std::vector<Vertex1P1N1UV1T1BT>& vertices, std::vector<uint32_t>& indices, Foundation::JobSystem* jobSystem = nullptr) const;
+
+    private:
+        Settings mSettings;
+
+    public:
+        inline const Settings& GeneratorSettings() const { return mSettings; }
+    };
+
+}
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
+
+#include "Vertices/CompressedVertex1P1N1UV1T1BT.hpp"
+#include "MeshLOD.hpp"
 
 namespace PathFinder
 {
@@ -12,6 +16,20 @@ namespace PathFinder
         uint32_t IndexBufferOffset = 0;
         uint32_t IndexCount = 0;
         uint16_t BottomAccelerationStructureIndex = 0;
+        CompressedVertex1P1N1UV1T1BT::Quantization PositionQuantization;
+
+        // Range of the meshlet table, empty for geometry drawn without meshlets
+        uint32_t MeshletOffset = 0;
+        uint32_t MeshletCount = 0;
+
+        // Index ranges of simplified levels in the same index buffer, level 0 is the range above
+        uint32_t LODIndexBufferOffsets[MeshLOD::MaxCount] = {};
+        uint32_t LODIndexCounts[MeshLOD::MaxCount] = {};
+        uint32_t LODCount = 0;
+
+        // Levels past the last stored one are clamped to it
+        inline uint32_t IndexBufferOffsetForLOD(uint32_t lod) const { lod = std::min(lod, LODCount); return lod == 0 ? IndexBufferOffset : LODIndexBufferOffsets[lod - 1]; }
+        inline uint32_t IndexCountForLOD(uint32_t lod) const { lod = std::min(lod, LODCount); return lod == 0 ? IndexCount : LODIndexCounts[lod - 1]; }
     };
 
 }
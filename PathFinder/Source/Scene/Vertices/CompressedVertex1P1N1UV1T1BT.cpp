@@ -0,0 +1,149 @@
+#include "CompressedVertex1P1N1UV1T1BT.hpp"
+
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtx/norm.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        const float SnormBase = 32767.0f;
+
+        int16_t EncodeSnorm16(float value)
+        {
+            return int16_t(std::round(std::clamp(value, -1.0f, 1.0f) * SnormBase));
+        }
+
+        float DecodeSnorm16(int16_t value)
+        {
+            return std::max(float(value) / SnormBase, -1.0f);
+        }
+
+        // Same conventions as OctEncode/OctDecode in Packing.hlsl
+        float SignNotZero(float value)
+        {
+            return value < 0.0f ? -1.0f : 1.0f;
+        }
+
+        glm::vec2 OctEncode(const glm::vec3& v)
+        {
+            float l1norm = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+            glm::vec2 result = glm::vec2{ v.x, v.y } / l1norm;
+
+            if (v.z < 0.0f)
+            {
+                result = glm::vec2{
+                    (1.0f - std::abs(result.y)) * SignNotZero(result.x),
+                    (1.0f - std::abs(result.x)) * SignNotZero(result.y)
+                };
+            }
+
+            return result;
+        }
+
+        glm::vec3 OctDecode(const glm::vec2& o)
+        {
+            glm::vec3 v{ o.x, o.y, 1.0f - std::abs(o.x) - std::abs(o.y) };
+
+            if (v.z < 0.0f)
+            {
+                v = glm::vec3{ (1.0f - std::abs(o.y)) * SignNotZero(o.x), (1.0f - std::abs(o.x)) * SignNotZero(o.y), v.z };
+            }
+
+            return glm::normalize(v);
+        }
+
+        // First component goes into high bits to match UnpackSnorm2x16 in Packing.hlsl
+        uint32_t OctEncodePack(const glm::vec3& v)
+        {
+            glm::vec2 oct = OctEncode(v);
+            return (uint32_t(uint16_t(EncodeSnorm16(oct.x))) << 16) | uint32_t(uint16_t(EncodeSnorm16(oct.y)));
+        }
+
+        glm::vec3 OctUnpackDecode(uint32_t packed)
+        {
+            return OctDecode(glm::vec2{ DecodeSnorm16(int16_t(packed >> 16)), DecodeSnorm16(int16_t(packed & 0xFFFF)) });
+        }
+
+        glm::vec3 AnyOrthogonalVector(const glm::vec3& v)
+        {
+            glm::vec3 axis = std::abs(v.x) < 0.9f ? glm::vec3{ 1.0f, 0.0f, 0.0f } : glm::vec3{ 0.0f, 1.0f, 0.0f };
+            return glm::normalize(glm::cross(v, axis));
+        }
+    }
+
+    glm::mat4 CompressedVertex1P1N1UV1T1BT::Quantization::DequantizationMatrix() const
+    {
+        return glm::scale(glm::translate(glm::mat4{ 1.0f }, Offset), Scale);
+    }
+
+    CompressedVertex1P1N1UV1T1BT::Quantization CompressedVertex1P1N1UV1T1BT::Quantization::ForBounds(const Geometry::AxisAlignedBox3D& bounds)
+    {
+        Quantization quantization;
+        quantization.Offset = (bounds.Min + bounds.Max) * 0.5f;
+
+        glm::vec3 halfExtent = (bounds.Max - bounds.Min) * 0.5f;
+
+        // Flat axes keep a unit scale: all positions are exactly at the offset there,
+        // and the dequantization matrix stays invertible, which ray tracing instance transforms require
+        for (auto axis = 0u; axis < 3; ++axis)
+        {
+            quantization.Scale[axis] = halfExtent[axis] > 0.0f ? halfExtent[axis] : 1.0f;
+        }
+
+        return quantization;
+    }
+
+    CompressedVertex1P1N1UV1T1BT CompressedVertex1P1N1UV1T1BT::Encode(const Vertex1P1N1UV1T1BT& vertex, const Quantization& quantization)
+    {
+        glm::vec3 normal = glm::length2(vertex.Normal) > 0.0f ? glm::normalize(vertex.Normal) : glm::vec3{ 0.0f, 0.0f, 1.0f };
+
+        // Tangent is made orthogonal to normal (Gram-Schmidt), so bitangents reconstructed from both never degenerate.
+        // Meshes without tangent space and tangents (nearly) parallel to normal still get a valid basis.
+        glm::vec3 tangent = vertex.Tangent - normal * glm::dot(normal, vertex.Tangent);
+        float tangentLength2 = glm::length2(tangent);
+
+        tangent = tangentLength2 > glm::length2(vertex.Tangent) * 1e-6f ? tangent / std::sqrt(tangentLength2) : AnyOrthogonalVector(normal);
+
+        float bitangentSign = glm::dot(glm::cross(normal, tangent), vertex.Bitangent) < 0.0f ? -1.0f : 1.0f;
+
+        glm::vec3 position = (glm::vec3{ vertex.Position } - quantization.Offset) / quantization.Scale;
+
+        CompressedVertex1P1N1UV1T1BT compressed;
+        compressed.Position[0] = EncodeSnorm16(position.x);
+        compressed.Position[1] = EncodeSnorm16(position.y);
+        compressed.Position[2] = EncodeSnorm16(position.z);
+        compressed.Position[3] = EncodeSnorm16(bitangentSign);
+        compressed.Normal = OctEncodePack(normal);
+        compressed.Tangent = OctEncodePack(tangent);
+        compressed.UV = glm::packHalf2x16(vertex.UV);
+
+        return compressed;
+    }
+
+    Vertex1P1N1UV1T1BT CompressedVertex1P1N1UV1T1BT::Decode(const Quantization& quantization) const
+    {
+        glm::vec3 position{ DecodeSnorm16(Position[0]), DecodeSnorm16(Position[1]), DecodeSnorm16(Position[2]) };
+        glm::vec3 normal = OctUnpackDecode(Normal);
+        glm::vec3 tangent = OctUnpackDecode(Tangent);
+
+        // Quantization leaves encoded basis slightly skewed
+        tangent = glm::normalize(tangent - normal * glm::dot(normal, tangent));
+
+        glm::vec3 bitangent = glm::cross(normal, tangent) * DecodeSnorm16(Position[3]);
+
+        return Vertex1P1N1UV1T1BT{
+            glm::vec4{ quantization.Offset + quantization.Scale * position, 1.0f },
+            glm::unpackHalf2x16(UV),
+            normal,
+            tangent,
+            bitangent
+        };
+    }
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Vertex1P1N1UV1T1BT.hpp"
+
+#include <Geometry/AxisAlignedBox3D.hpp>
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /**
+     Compressed 1P1N1UV1T1BT vertex, 20 bytes instead of 60
+
+     1 position: signed normalized 16 bit components relative to mesh bounds,
+       W component stores bitangent sign
+     1 normal: octahedral encoded, signed normalized 2x16 bits
+     1 uv channel: half floats
+     1 tangent vector: made orthogonal to normal, octahedral encoded, signed normalized 2x16 bits
+     Bitangent is reconstructed as cross(Normal, Tangent) * sign
+
+     Normal and tangent are packed with the first component in high bits,
+     so they are decoded by OctUnpackDecode in shaders
+     */
+    struct CompressedVertex1P1N1UV1T1BT
+    {
+        // Positions are decoded as Offset + Scale * Position.xyz
+        struct Quantization
+        {
+            glm::vec3 Offset{ 0.0f };
+            glm::vec3 Scale{ 1.0f };
+
+            // Maps quantized position space onto mesh space,
+            // used as part of ray tracing instance transforms for BLASes built from quantized positions
+            glm::mat4 DequantizationMatrix() const;
+
+            static Quantization ForBounds(const Geometry::AxisAlignedBox3D& bounds);
+        };
+
+        int16_t Position[4];
+        uint32_t Normal;
+        uint32_t Tangent;
+        uint32_t UV;
+
+        static CompressedVertex1P1N1UV1T1BT Encode(const Vertex1P1N1UV1T1BT& vertex, const Quantization& quantization);
+
+        Vertex1P1N1UV1T1BT Decode(const Quantization& quantization) const;
+    };
+
+    static_assert(sizeof(CompressedVertex1P1N1UV1T1BT) == 20, "Compressed vertex must stay tightly packed, shaders rely on its layout");
+
+}
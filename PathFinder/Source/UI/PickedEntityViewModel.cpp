@@ -9,18 +9,7 @@ namespace PathFinder
 
     void PickedEntityViewModel::HandleClick()
     {
-        mMeshInstance = nullptr;
-        mSphericalLight = nullptr;
-        mFlatLight = nullptr;
-
-        if (auto entity = mScene->GetEntityByID(mHoveredEntityID))
-        {
-            std::visit(Foundation::MakeVisitor(
-                [this](MeshInstance* instance) { mMeshInstance = instance; },
-                [this](SphericalLight* light) { mSphericalLight = light; },
-                [this](FlatLight* light) { mFlatLight = light; }),
-                *entity);
-        }
+        mPickedEntityID = mHoveredEntityID;
     }
 
     void PickedEntityViewModel::SetModifiedModelMatrix(const glm::mat4& mat, const glm::mat4& delta)
@@ -33,6 +22,20 @@ namespace PathFinder
     {
         mScene = Dependencies->ScenePtr;
 
+        // Scene entities move in memory as others are added or removed, so they're looked up every time
+        mMeshInstance = nullptr;
+        mSphericalLight = nullptr;
+        mFlatLight = nullptr;
+
+        if (auto entity = mScene->GetEntityByID(mPickedEntityID))
+        {
+            std::visit(Foundation::MakeVisitor(
+                [this](MeshInstance* instance) { mMeshInstance = instance; },
+                [this](SphericalLight* light) { mSphericalLight = light; },
+                [this](FlatLight* light) { mFlatLight = light; }),
+                *entity);
+        }
+
         mShouldDisplay = mMeshInstance != nullptr || mSphericalLight != nullptr || mFlatLight != nullptr;
         mAreRotationsAllowed = mSphericalLight == nullptr;
        
@@ -88,7 +91,7 @@ namespace PathFinder
 
             pickedGeometryInfo->Read<uint32_t>([this](const uint32_t* info)
             {
-                if (info) mHoveredEntityID = EntityID{ *info };
+                if (info && mScene) mHoveredEntityID = mScene->EntityIDFromGPUID(*info);
             });
         }};
     }
@@ -29,6 +29,7 @@ namespace PathFinder
         FlatLight* mFlatLight = nullptr;
         Scene* mScene = nullptr;
         EntityID mHoveredEntityID = NoEntityID;
+        EntityID mPickedEntityID = NoEntityID;
 
     public:
         inline const glm::mat4& ModelMatrix() const { return mModelMatrix; }
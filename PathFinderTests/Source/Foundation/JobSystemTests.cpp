@@ -0,0 +1,236 @@
+#include <TestFramework.hpp>
+
+#include <Foundation/JobSystem.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace Foundation;
+
+    constexpr uint64_t WorkerThreadCount = 4;
+
+    // Random DAG where every task depends on a few of the previously added ones
+    void BuildRandomGraph(TaskGraph& graph, uint64_t taskCount, std::vector<std::atomic<uint64_t>>& finishStamps,
+        std::atomic<uint64_t>& clock, std::vector<std::pair<TaskGraph::TaskID, TaskGraph::TaskID>>& dependencies)
+    {
+        std::mt19937 random{ 11 };
+
+        for (uint64_t taskIdx = 0; taskIdx < taskCount; ++taskIdx)
+        {
+            graph.AddTask("Task", [&finishStamps, &clock, taskIdx] { finishStamps[taskIdx].store(++clock); });
+
+            for (uint64_t dependencyIdx = 0; taskIdx > 0 && dependencyIdx < random() % 4; ++dependencyIdx)
+            {
+                TaskGraph::TaskID dependency = random() % taskIdx;
+                graph.AddDependency(taskIdx, dependency);
+                dependencies.emplace_back(taskIdx, dependency);
+            }
+        }
+    }
+}
+
+TEST_CASE(TasksStartAfterTheirDependencies)
+{
+    const uint64_t taskCount = 500;
+
+    JobSystem jobSystem{ WorkerThreadCount };
+    TaskGraph graph;
+    std::vector<std::atomic<uint64_t>> finishStamps(taskCount);
+    std::atomic<uint64_t> clock{ 0 };
+    std::vector<std::pair<TaskGraph::TaskID, TaskGraph::TaskID>> dependencies;
+
+    BuildRandomGraph(graph, taskCount, finishStamps, clock, dependencies);
+
+    // Graphs are reused every frame, so counters must be reset properly between executions
+    for (uint64_t execution = 0; execution < 20; ++execution)
+    {
+        jobSystem.Execute(graph);
+
+        TEST_CHECK(clock.load() == (execution + 1) * taskCount, "Every task must run exactly once per execution");
+
+        for (auto [task, dependency] : dependencies)
+        {
+            TEST_CHECK(finishStamps[dependency].load() < finishStamps[task].load(), "Task ", task, " ran before its dependency ", dependency);
+        }
+    }
+}
+
+TEST_CASE(NestedGraphFinishesBeforeContinuation)
+{
+    const uint64_t nestedTaskCount = 64;
+
+    JobSystem jobSystem{ WorkerThreadCount };
+    TaskGraph graph;
+    std::atomic<uint64_t> nestedTasksDone{ 0 };
+    std::atomic<bool> isContinuationOrderValid{ true };
+
+    auto fanOut = [&]
+    {
+        TaskGraph nestedGraph;
+
+        for (uint64_t taskIdx = 0; taskIdx < nestedTaskCount; ++taskIdx)
+        {
+            nestedGraph.AddTask("Nested", [&] { nestedTasksDone.fetch_add(1); });
+        }
+
+        jobSystem.Execute(nestedGraph);
+    };
+
+    TaskGraph::TaskID first = graph.AddTask("Fan Out A", fanOut);
+    TaskGraph::TaskID second = graph.AddTask("Fan Out B", fanOut);
+    TaskGraph::TaskID join = graph.AddTask("Join", [&]
+    {
+        isContinuationOrderValid.store(nestedTasksDone.load() == 2 * nestedTaskCount);
+    });
+
+    graph.AddDependency(join, first);
+    graph.AddDependency(join, second);
+
+    jobSystem.Execute(graph);
+
+    TEST_CHECK(nestedTasksDone.load() == 2 * nestedTaskCount, "Nested tasks were lost: ", nestedTasksDone.load());
+    TEST_CHECK(isContinuationOrderValid.load(), "Continuation started before nested graphs of its dependencies finished");
+}
+
+TEST_CASE(CallingThreadTasksStayOnCallingThread)
+{
+    JobSystem jobSystem{ WorkerThreadCount };
+    TaskGraph graph;
+    std::thread::id callingThreadId = std::this_thread::get_id();
+    std::atomic<uint64_t> misplacedTaskCount{ 0 };
+    std::atomic<uint64_t> callingThreadTaskCount{ 0 };
+
+    for (uint64_t chainIdx = 0; chainIdx < 16; ++chainIdx)
+    {
+        // Worker tasks complete dependencies of calling thread tasks, which must not be run inline by workers
+        TaskGraph::TaskID worker = graph.AddTask("Worker", [] { std::this_thread::sleep_for(std::chrono::microseconds{ 100 }); });
+        TaskGraph::TaskID main = graph.AddTask("Main", [&]
+        {
+            callingThreadTaskCount.fetch_add(1);
+
+            if (std::this_thread::get_id() != callingThreadId)
+            {
+                misplacedTaskCount.fetch_add(1);
+            }
+        },
+        TaskGraph::Affinity::CallingThread);
+
+        graph.AddDependency(main, worker);
+    }
+
+    for (uint64_t execution = 0; execution < 10; ++execution)
+    {
+        jobSystem.Execute(graph);
+    }
+
+    TEST_CHECK(callingThreadTaskCount.load() == 160, "Calling thread tasks were lost");
+    TEST_CHECK(misplacedTaskCount.load() == 0, misplacedTaskCount.load(), " calling thread tasks were executed by workers");
+}
+
+TEST_CASE(IdleThreadsStealFromBusyThread)
+{
+    const uint64_t shortTaskCount = 200;
+
+    JobSystem jobSystem{ WorkerThreadCount };
+    TaskGraph graph;
+    std::atomic<uint64_t> shortTasksDone{ 0 };
+    bool wereShortTasksDoneMeanwhile = false;
+    std::mutex threadIdsMutex;
+    std::set<std::thread::id> threadIds;
+
+    // Every root lands in the queue of the thread calling Execute().
+    // Whichever thread takes the long task, the rest can only finish if other threads steal them.
+    for (uint64_t taskIdx = 0; taskIdx < shortTaskCount; ++taskIdx)
+    {
+        graph.AddTask("Short", [&]
+        {
+            {
+                std::lock_guard lock{ threadIdsMutex };
+                threadIds.insert(std::this_thread::get_id());
+            }
+
+            std::this_thread::sleep_for(std::chrono::microseconds{ 50 });
+            shortTasksDone.fetch_add(1);
+        });
+    }
+
+    graph.AddTask("Long", [&]
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 10 };
+
+        while (shortTasksDone.load() < shortTaskCount && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+
+        wereShortTasksDoneMeanwhile = shortTasksDone.load() == shortTaskCount;
+    });
+
+    jobSystem.Execute(graph);
+
+    TEST_CHECK(wereShortTasksDoneMeanwhile, "Only ", shortTasksDone.load(), " short tasks were finished while long task occupied its thread");
+    TEST_CHECK(threadIds.size() > 1, "Work was not distributed between threads");
+}
+
+BENCHMARK(JobSystemThroughput)
+{
+    const uint64_t taskCount = 100000;
+
+    for (uint64_t workerCount : { 1, 3, 7 })
+    {
+        JobSystem jobSystem{ workerCount };
+        std::atomic<uint64_t> counter{ 0 };
+        auto work = [&counter] { counter.fetch_add(1, std::memory_order_relaxed); };
+
+        // Independent tasks exercise queues and stealing
+        TaskGraph independentGraph;
+
+        for (uint64_t taskIdx = 0; taskIdx < taskCount; ++taskIdx)
+        {
+            independentGraph.AddTask("Independent", work);
+        }
+
+        // Chain exercises inline continuations
+        TaskGraph chainGraph;
+
+        for (uint64_t taskIdx = 0; taskIdx < taskCount; ++taskIdx)
+        {
+            chainGraph.AddTask("Chain", work);
+
+            if (taskIdx > 0)
+            {
+                chainGraph.AddDependency(taskIdx, taskIdx - 1);
+            }
+        }
+
+        // Wide layers released by the last task of a previous layer exercise continuation enqueueing and wake ups
+        const uint64_t layerWidth = 1000;
+        TaskGraph layeredGraph;
+
+        for (uint64_t taskIdx = 0; taskIdx < taskCount; ++taskIdx)
+        {
+            layeredGraph.AddTask("Layer", work);
+
+            if (taskIdx >= layerWidth)
+            {
+                layeredGraph.AddDependency(taskIdx, taskIdx - taskIdx % layerWidth - 1);
+            }
+        }
+
+        double independentMS = Tests::MeasureBestMilliseconds(5, [&] { jobSystem.Execute(independentGraph); });
+        double chainMS = Tests::MeasureBestMilliseconds(5, [&] { jobSystem.Execute(chainGraph); });
+        double layeredMS = Tests::MeasureBestMilliseconds(5, [&] { jobSystem.Execute(layeredGraph); });
+
+        TEST_CHECK(counter.load() == 15 * taskCount, "Tasks were lost");
+
+        Tests::Report(workerCount, " workers: independent ", taskCount / independentMS / 1000.0, " M tasks/s, chain ",
+            taskCount / chainMS / 1000.0, " M tasks/s, layered ", taskCount / layeredMS / 1000.0, " M tasks/s");
+    }
+}
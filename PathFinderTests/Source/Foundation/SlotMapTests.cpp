@@ -0,0 +1,243 @@
+#include <TestFramework.hpp>
+
+#include <Foundation/SlotMap.hpp>
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace Foundation;
+
+    // Roughly the size of a mesh instance: transformation, bounds and a few references
+    struct Entity
+    {
+        float Transformation[16] = {};
+        float Bounds[6] = {};
+        uint64_t References[4] = {};
+        uint64_t Value = 0;
+    };
+
+    // Containers go through the same insertion and removal churn as a scene being edited,
+    // so that list nodes end up scattered over the heap like they do in a long session
+    template <class Container, class Insert, class Erase>
+    void Churn(Container& container, uint64_t count, const Insert& insert, const Erase& erase)
+    {
+        std::mt19937 random{ 3 };
+
+        for (uint64_t value = 0; value < count; ++value)
+        {
+            insert(container, value);
+        }
+
+        for (uint64_t round = 0; round < 4; ++round)
+        {
+            for (uint64_t removal = 0; removal < count / 2; ++removal)
+            {
+                erase(container, random());
+            }
+
+            for (uint64_t value = 0; value < count / 2; ++value)
+            {
+                insert(container, value);
+            }
+        }
+    }
+}
+
+TEST_CASE(RemovalKeepsValuesPackedAndHandlesValid)
+{
+    SlotMap<std::string> map;
+
+    SlotMapHandle a = map.Emplace("A");
+    SlotMapHandle b = map.Emplace("B");
+    SlotMapHandle c = map.Emplace("C");
+
+    TEST_CHECK(map.Remove(a), "Existing value must be removed");
+
+    TEST_CHECK(map.size() == 2, "Size is ", map.size());
+    TEST_CHECK(map[0] == "C" && map[1] == "B", "Last value must fill the gap left by removal");
+    TEST_CHECK(*map.Get(b) == "B" && *map.Get(c) == "C", "Handles of moved values must keep resolving to them");
+    TEST_CHECK(map.HandleAt(0) == c && map.HandleAt(1) == b, "Dense positions must map back to handles of their values");
+}
+
+TEST_CASE(StaleHandlesNeverResolve)
+{
+    SlotMap<int> map;
+
+    SlotMapHandle removed = map.Emplace(1);
+    map.Remove(removed);
+    SlotMapHandle reused = map.Emplace(2);
+
+    TEST_CHECK(reused.Index == removed.Index, "Free slot must be reused");
+    TEST_CHECK(reused.Generation != removed.Generation, "Reused slot must get a new generation");
+    TEST_CHECK(!map.Contains(removed) && map.Get(removed) == nullptr, "Handle of removed value resolved to a new value");
+    TEST_CHECK(!map.Remove(removed) && map.size() == 1, "Removal through a stale handle must be rejected");
+    TEST_CHECK(!map.Contains(SlotMapHandle{}) && !SlotMapHandle{}.IsValid(), "Default handle must be invalid");
+}
+
+TEST_CASE(ClearInvalidatesAllHandles)
+{
+    SlotMap<int> map;
+
+    SlotMapHandle first = map.Emplace(1);
+    SlotMapHandle second = map.Emplace(2);
+    map.Clear();
+
+    TEST_CHECK(map.empty() && map.SlotCount() == 2, "Clearing must keep slots for reuse");
+    TEST_CHECK(!map.Contains(first) && !map.Contains(second), "Handles must not survive clearing");
+    TEST_CHECK(!map.HandleAtSlot(first.Index), "Cleared slot must be free");
+
+    SlotMapHandle inserted = map.Emplace(3);
+
+    TEST_CHECK(inserted.Index == 0, "Slots must be reused in order after clearing");
+    TEST_CHECK(map.HandleAtSlot(0) == inserted, "Occupied slot must report handle of its value");
+    TEST_CHECK(map.SlotCount() == 2, "Map must not grow while it has free slots");
+}
+
+TEST_CASE(SupportsMoveOnlyValues)
+{
+    SlotMap<std::unique_ptr<int>> map;
+
+    SlotMapHandle first = map.Emplace(std::make_unique<int>(1));
+    SlotMapHandle second = map.Emplace(std::make_unique<int>(2));
+    map.Remove(first);
+
+    TEST_CHECK(**map.Get(second) == 2, "Moved value must keep its contents");
+}
+
+TEST_CASE(MatchesReferenceContainerUnderRandomOperations)
+{
+    SlotMap<uint64_t> map;
+    std::map<uint64_t, SlotMapHandle> expectedHandles;
+    std::vector<SlotMapHandle> removedHandles;
+    std::mt19937 random{ 11 };
+
+    for (uint64_t value = 0; value < 20000; ++value)
+    {
+        if (!expectedHandles.empty() && random() % 5 < 2)
+        {
+            auto it = std::next(expectedHandles.begin(), random() % expectedHandles.size());
+
+            TEST_CHECK(map.Remove(it->second), "Live handle of value ", it->first, " could not be removed");
+
+            removedHandles.push_back(it->second);
+            expectedHandles.erase(it);
+        }
+        else
+        {
+            expectedHandles.emplace(value, map.Emplace(value));
+        }
+    }
+
+    TEST_CHECK(map.size() == expectedHandles.size(), "Map holds ", map.size(), " values, expected ", expectedHandles.size());
+
+    for (const auto& [value, handle] : expectedHandles)
+    {
+        const uint64_t* storedValue = map.Get(handle);
+        TEST_CHECK(storedValue && *storedValue == value, "Handle does not resolve to value ", value);
+    }
+
+    for (const SlotMapHandle& handle : removedHandles)
+    {
+        TEST_CHECK(!map.Contains(handle), "Removed handle at slot ", handle.Index, " still resolves");
+    }
+
+    for (uint64_t denseIndex = 0; denseIndex < map.size(); ++denseIndex)
+    {
+        TEST_CHECK(*map.Get(map.HandleAt(denseIndex)) == map[denseIndex], "Dense index ", denseIndex, " does not round trip through its handle");
+    }
+}
+
+BENCHMARK(SlotMapVersusList)
+{
+    const uint64_t entityCount = 100000;
+
+    // Handles and list iterators are kept by owners of entities, the way scene objects keep their IDs
+    SlotMap<Entity> slotMap;
+    std::vector<SlotMapHandle> handles;
+
+    std::list<Entity> list;
+    std::vector<std::list<Entity>::iterator> iterators;
+
+    auto insertIntoSlotMap = [&](SlotMap<Entity>& map, uint64_t value) { handles.push_back(map.Emplace(Entity{ {}, {}, {}, value })); };
+    auto insertIntoList = [&](std::list<Entity>& entities, uint64_t value) { iterators.push_back(entities.insert(entities.end(), Entity{ {}, {}, {}, value })); };
+
+    auto eraseFromSlotMap = [&](SlotMap<Entity>& map, uint64_t randomValue)
+    {
+        uint64_t index = randomValue % handles.size();
+        map.Remove(handles[index]);
+        handles[index] = handles.back();
+        handles.pop_back();
+    };
+
+    auto eraseFromList = [&](std::list<Entity>& entities, uint64_t randomValue)
+    {
+        uint64_t index = randomValue % iterators.size();
+        entities.erase(iterators[index]);
+        iterators[index] = iterators.back();
+        iterators.pop_back();
+    };
+
+    Churn(slotMap, entityCount, insertIntoSlotMap, eraseFromSlotMap);
+    Churn(list, entityCount, insertIntoList, eraseFromList);
+
+    uint64_t slotMapSum = 0;
+    uint64_t listSum = 0;
+
+    double slotMapIteration = Tests::MeasureBestMilliseconds(20, [&]
+    {
+        slotMapSum = 0;
+        for (const Entity& entity : slotMap) slotMapSum += entity.Value;
+    });
+
+    double listIteration = Tests::MeasureBestMilliseconds(20, [&]
+    {
+        listSum = 0;
+        for (const Entity& entity : list) listSum += entity.Value;
+    });
+
+    TEST_CHECK(slotMapSum == listSum && slotMap.size() == list.size(), "Containers must hold the same entities");
+
+    // Lookups by handle resolve through the slot array, list iterators are dereferenced directly
+    std::vector<SlotMapHandle> shuffledHandles = handles;
+    std::vector<std::list<Entity>::iterator> shuffledIterators = iterators;
+    std::shuffle(shuffledHandles.begin(), shuffledHandles.end(), std::mt19937{ 5 });
+    std::shuffle(shuffledIterators.begin(), shuffledIterators.end(), std::mt19937{ 5 });
+
+    double slotMapLookup = Tests::MeasureBestMilliseconds(5, [&]
+    {
+        slotMapSum = 0;
+        for (const SlotMapHandle& handle : shuffledHandles) slotMapSum += slotMap.Get(handle)->Value;
+    });
+
+    double listLookup = Tests::MeasureBestMilliseconds(5, [&]
+    {
+        listSum = 0;
+        for (const auto& iterator : shuffledIterators) listSum += iterator->Value;
+    });
+
+    TEST_CHECK(slotMapSum == listSum, "Lookups must find the same entities");
+
+    // Removal of every entity in random order followed by insertion of the same number of entities
+    double slotMapRemoval = Tests::MeasureBestMilliseconds(1, [&] { for (const SlotMapHandle& handle : shuffledHandles) slotMap.Remove(handle); });
+    double listRemoval = Tests::MeasureBestMilliseconds(1, [&] { for (const auto& iterator : shuffledIterators) list.erase(iterator); });
+
+    TEST_CHECK(slotMap.empty() && list.empty(), "Every entity must be removed");
+
+    double slotMapInsertion = Tests::MeasureBestMilliseconds(1, [&] { for (uint64_t value = 0; value < entityCount; ++value) slotMap.Emplace(Entity{ {}, {}, {}, value }); });
+    double listInsertion = Tests::MeasureBestMilliseconds(1, [&] { for (uint64_t value = 0; value < entityCount; ++value) list.emplace_back(Entity{ {}, {}, {}, value }); });
+
+    auto nanoseconds = [&](double milliseconds) { return milliseconds * 1000000.0 / entityCount; };
+
+    Tests::Report(entityCount, " entities of ", sizeof(Entity), " bytes after churn, ns per entity (SlotMap vs std::list):");
+    Tests::Report("Iteration ", nanoseconds(slotMapIteration), " vs ", nanoseconds(listIteration), ", ", listIteration / slotMapIteration, "x faster");
+    Tests::Report("Lookup    ", nanoseconds(slotMapLookup), " vs ", nanoseconds(listLookup));
+    Tests::Report("Removal   ", nanoseconds(slotMapRemoval), " vs ", nanoseconds(listRemoval));
+    Tests::Report("Insertion ", nanoseconds(slotMapInsertion), " vs ", nanoseconds(listInsertion));
+}
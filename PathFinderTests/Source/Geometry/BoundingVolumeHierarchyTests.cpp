@@ -0,0 +1,322 @@
+#include <TestFramework.hpp>
+
+#include <Geometry/BoundingVolumeHierarchy.hpp>
+#include <Geometry/Collision.hpp>
+#include <Geometry/Triangle3D.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Geometry;
+
+    using BVH = BoundingVolumeHierarchy;
+
+    // Bundled models are not part of the test environment, so meshes are procedural
+    std::vector<Triangle3D> MakeBumpySphere(uint32_t rings)
+    {
+        std::vector<Triangle3D> triangles;
+        uint32_t segments = rings * 2;
+
+        auto vertex = [&](uint32_t ring, uint32_t segment)
+        {
+            float theta = glm::pi<float>() * ring / rings;
+            float phi = glm::two_pi<float>() * segment / segments;
+            float radius = 1.0f + 0.05f * std::sin(13.0f * theta) * std::cos(7.0f * phi);
+            return radius * glm::vec3{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+        };
+
+        for (uint32_t ring = 0; ring < rings; ++ring)
+        {
+            for (uint32_t segment = 0; segment < segments; ++segment)
+            {
+                triangles.emplace_back(vertex(ring, segment), vertex(ring + 1, segment), vertex(ring + 1, segment + 1));
+                triangles.emplace_back(vertex(ring, segment), vertex(ring + 1, segment + 1), vertex(ring, segment + 1));
+            }
+        }
+
+        return triangles;
+    }
+
+    // Overlapping triangles of mixed sizes, facing any direction
+    std::vector<Triangle3D> MakeTriangleSoup(uint32_t count, uint32_t seed)
+    {
+        std::mt19937 random{ seed };
+        std::uniform_real_distribution<float> position{ -10.0f, 10.0f };
+        std::uniform_real_distribution<float> size{ 0.05f, 3.0f };
+
+        auto randomVector = [&] { return glm::vec3{ position(random), position(random), position(random) }; };
+
+        std::vector<Triangle3D> triangles;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            glm::vec3 a = randomVector();
+            float scale = size(random) * 0.1f;
+            triangles.emplace_back(a, a + randomVector() * scale, a + randomVector() * scale);
+        }
+
+        return triangles;
+    }
+
+    // Many triangles sharing one centroid defeat any split plane
+    std::vector<Triangle3D> MakeTriangleFan(uint32_t count)
+    {
+        std::vector<Triangle3D> triangles;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            float angle = glm::two_pi<float>() * i / count;
+            glm::vec3 direction{ std::cos(angle), std::sin(angle), 0.0f };
+            glm::vec3 side{ -direction.y, direction.x, 0.0f };
+            triangles.emplace_back(-direction - side * 0.1f, direction, -direction + side * 0.1f);
+        }
+
+        return triangles;
+    }
+
+    std::vector<AxisAlignedBox3D> Bounds(const std::vector<Triangle3D>& triangles)
+    {
+        std::vector<AxisAlignedBox3D> bounds;
+
+        for (const Triangle3D& triangle : triangles)
+        {
+            bounds.emplace_back(glm::min(triangle.a, glm::min(triangle.b, triangle.c)), glm::max(triangle.a, glm::max(triangle.b, triangle.c)));
+        }
+
+        return bounds;
+    }
+
+    // Rays start outside of the mesh bounds and aim at random points inside of them
+    std::vector<Ray3D> MakeRays(const std::vector<AxisAlignedBox3D>& bounds, uint32_t count, uint32_t seed)
+    {
+        glm::vec3 min{ std::numeric_limits<float>::max() };
+        glm::vec3 max{ std::numeric_limits<float>::lowest() };
+
+        for (const AxisAlignedBox3D& box : bounds)
+        {
+            min = glm::min(min, box.Min);
+            max = glm::max(max, box.Max);
+        }
+
+        glm::vec3 center = (min + max) * 0.5f;
+        float radius = glm::length(max - min);
+
+        std::mt19937 random{ seed };
+        std::uniform_real_distribution<float> unit{ -1.0f, 1.0f };
+        auto randomVector = [&] { return glm::vec3{ unit(random), unit(random), unit(random) }; };
+
+        std::vector<Ray3D> rays;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            glm::vec3 origin = center + glm::normalize(randomVector() + glm::vec3{ 1e-3f }) * radius;
+            glm::vec3 target = center + (max - min) * 0.5f * randomVector();
+            rays.emplace_back(origin, glm::normalize(target - origin));
+        }
+
+        return rays;
+    }
+
+    std::optional<float> BruteForceClosestHit(const std::vector<Triangle3D>& triangles, const Ray3D& ray, float maxDistance)
+    {
+        std::optional<float> closest;
+
+        for (const Triangle3D& triangle : triangles)
+        {
+            float distance = 0.0f;
+
+            if (Collision::RayTriangle(ray, triangle, distance) && distance >= 0.0f && distance <= maxDistance && (!closest || distance < *closest))
+            {
+                closest = distance;
+            }
+        }
+
+        return closest;
+    }
+
+    std::optional<BVH::RayHit> CastRay(const BVH& bvh, const std::vector<Triangle3D>& triangles, const Ray3D& ray, float maxDistance)
+    {
+        return bvh.CastRay(ray, maxDistance, [&](uint32_t triangleIndex, float& distance)
+        {
+            return Collision::RayTriangle(ray, triangles[triangleIndex], distance);
+        });
+    }
+
+    struct TestMesh
+    {
+        const char* Name;
+        std::vector<Triangle3D> Triangles;
+    };
+
+    std::vector<TestMesh> TestMeshes()
+    {
+        return {
+            { "Sphere", MakeBumpySphere(24) },
+            { "Soup", MakeTriangleSoup(3000, 1) },
+            { "Fan", MakeTriangleFan(500) },
+            { "Single", MakeTriangleSoup(1, 2) },
+        };
+    }
+}
+
+TEST_CASE(ClosestHitMatchesBruteForce)
+{
+    Foundation::JobSystem jobSystem{ 3 };
+
+    BVH::BuildSettings parallelSettings{};
+    parallelSettings.MinParallelSubtreeSize = 64;
+
+    BVH::BuildSettings narrowSettings{};
+    narrowSettings.BinCount = 2;
+    narrowSettings.MaxLeafSize = 1;
+
+    for (const TestMesh& mesh : TestMeshes())
+    {
+        std::vector<AxisAlignedBox3D> bounds = Bounds(mesh.Triangles);
+        std::vector<Ray3D> rays = MakeRays(bounds, 500, 3);
+
+        BVH serial;
+        BVH parallel;
+        BVH narrow;
+        serial.Build(bounds);
+        parallel.Build(bounds, parallelSettings, &jobSystem);
+        narrow.Build(bounds, narrowSettings);
+
+        uint64_t hitCount = 0;
+
+        for (uint64_t rayIndex = 0; rayIndex < rays.size(); ++rayIndex)
+        {
+            const Ray3D& ray = rays[rayIndex];
+
+            // Limited distance cuts off some of the hits
+            for (float maxDistance : { std::numeric_limits<float>::max(), 1.5f * glm::length(bounds.front().Max - ray.origin) })
+            {
+                std::optional<float> expected = BruteForceClosestHit(mesh.Triangles, ray, maxDistance);
+                hitCount += expected.has_value();
+
+                for (const BVH* bvh : { &serial, &parallel, &narrow })
+                {
+                    std::optional<BVH::RayHit> hit = CastRay(*bvh, mesh.Triangles, ray, maxDistance);
+
+                    TEST_CHECK(hit.has_value() == expected.has_value(), mesh.Name, " ray ", rayIndex, " disagrees with brute force on hit presence");
+
+                    // Ties between coincident triangles may resolve to either one, distances are the same
+                    TEST_CHECK(!hit || hit->Distance == *expected, mesh.Name, " ray ", rayIndex, " hit at ", hit->Distance, ", closest is at ", *expected);
+
+                    float distance = 0.0f;
+                    TEST_CHECK(!hit || (Collision::RayTriangle(ray, mesh.Triangles[hit->PrimitiveIndex], distance) && distance == hit->Distance),
+                        mesh.Name, " ray ", rayIndex, " reports a primitive that is not at the hit distance");
+                }
+            }
+        }
+
+        TEST_CHECK(hitCount > 0, mesh.Name, " rays must hit something to be meaningful");
+    }
+}
+
+TEST_CASE(HierarchyCoversEveryPrimitiveOnce)
+{
+    Foundation::JobSystem jobSystem{ 3 };
+
+    BVH::BuildSettings settings{};
+    settings.MinParallelSubtreeSize = 64;
+
+    for (const TestMesh& mesh : TestMeshes())
+    {
+        std::vector<AxisAlignedBox3D> bounds = Bounds(mesh.Triangles);
+
+        BVH bvh;
+        bvh.Build(bounds, settings, &jobSystem);
+
+        const std::vector<BVH::Node>& nodes = bvh.Nodes();
+        std::vector<uint32_t> referenceCounts(bounds.size(), 0);
+
+        TEST_CHECK(nodes.size() <= 2 * bounds.size() - 1, mesh.Name, " has more nodes than a binary tree needs");
+
+        auto contains = [](const AxisAlignedBox3D& outer, const AxisAlignedBox3D& inner)
+        {
+            return glm::all(glm::lessThanEqual(outer.Min, inner.Min)) && glm::all(glm::greaterThanEqual(outer.Max, inner.Max));
+        };
+
+        for (uint64_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+        {
+            const BVH::Node& node = nodes[nodeIndex];
+
+            if (!node.IsLeaf())
+            {
+                TEST_CHECK(node.FirstChildOrPrimitive > nodeIndex && node.FirstChildOrPrimitive + 1 < nodes.size(), mesh.Name, " node ", nodeIndex, " has invalid children");
+                TEST_CHECK(contains(node.Bounds, nodes[node.FirstChildOrPrimitive].Bounds) && contains(node.Bounds, nodes[node.FirstChildOrPrimitive + 1].Bounds),
+                    mesh.Name, " node ", nodeIndex, " does not contain its children");
+                continue;
+            }
+
+            for (uint32_t i = node.FirstChildOrPrimitive; i < node.FirstChildOrPrimitive + node.PrimitiveCount; ++i)
+            {
+                uint32_t primitiveIndex = bvh.PrimitiveIndices()[i];
+                referenceCounts[primitiveIndex] += 1;
+
+                TEST_CHECK(contains(node.Bounds, bounds[primitiveIndex]), mesh.Name, " leaf ", nodeIndex, " does not contain primitive ", primitiveIndex);
+            }
+        }
+
+        TEST_CHECK(std::all_of(referenceCounts.begin(), referenceCounts.end(), [](uint32_t count) { return count == 1; }),
+            mesh.Name, " leaves must reference every primitive exactly once");
+    }
+
+    BVH empty;
+    empty.Build({});
+    TEST_CHECK(empty.IsEmpty() && !CastRay(empty, {}, Ray3D{ glm::vec3{ 0.0f }, glm::vec3{ 0.0f, 0.0f, 1.0f } }, 1.0f), "Empty hierarchy must have no nodes and no hits");
+}
+
+BENCHMARK(BoundingVolumeHierarchyBuildAndRayCast)
+{
+    Foundation::JobSystem jobSystem;
+
+    const uint32_t rayCount = 100000;
+    const uint32_t bruteForceRayCount = 200;
+
+    for (uint32_t rings : { 50, 200, 700 })
+    {
+        std::vector<Triangle3D> triangles = MakeBumpySphere(rings);
+        std::vector<AxisAlignedBox3D> bounds = Bounds(triangles);
+        std::vector<Ray3D> rays = MakeRays(bounds, rayCount, 5);
+
+        BVH serial;
+        BVH parallel;
+
+        double serialMilliseconds = Tests::MeasureBestMilliseconds(3, [&] { serial.Build(bounds); });
+        double parallelMilliseconds = Tests::MeasureBestMilliseconds(3, [&] { parallel.Build(bounds, &jobSystem); });
+
+        uint64_t hitCount = 0;
+
+        double castMilliseconds = Tests::MeasureBestMilliseconds(3, [&]
+        {
+            hitCount = 0;
+
+            for (const Ray3D& ray : rays)
+            {
+                hitCount += CastRay(parallel, triangles, ray, std::numeric_limits<float>::max()).has_value();
+            }
+        });
+
+        uint64_t bruteForceHitCount = 0;
+
+        double bruteForceMilliseconds = Tests::MeasureBestMilliseconds(1, [&]
+        {
+            for (uint32_t rayIndex = 0; rayIndex < bruteForceRayCount; ++rayIndex)
+            {
+                bruteForceHitCount += BruteForceClosestHit(triangles, rays[rayIndex], std::numeric_limits<float>::max()).has_value();
+            }
+        });
+
+        TEST_CHECK(hitCount > 0 && bruteForceHitCount > 0, "Rays must hit the mesh");
+
+        Tests::Report(triangles.size(), " triangles, ", parallel.Nodes().size(), " nodes: build ", serialMilliseconds, " ms serial, ", parallelMilliseconds, " ms with ",
+            jobSystem.WorkerThreadCount(), " workers, ", rayCount / castMilliseconds / 1000.0, " Mrays/s, brute force ",
+            bruteForceRayCount / bruteForceMilliseconds, " Krays/s");
+    }
+}
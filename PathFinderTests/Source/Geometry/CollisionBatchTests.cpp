@@ -0,0 +1,291 @@
+#include <TestFramework.hpp>
+
+#include <Geometry/CollisionBatch.hpp>
+#include <Geometry/Collision.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Geometry;
+
+    using InstructionSet = CollisionBatch::InstructionSet;
+
+    // Not a multiple of packet width, so the last packet is partially filled
+    constexpr uint64_t ItemCount = 1003;
+
+    struct Scene
+    {
+        std::vector<AxisAlignedBox3D> Boxes;
+        std::vector<Triangle3D> Triangles;
+        std::vector<Ray3D> Rays;
+    };
+
+    Scene MakeScene(uint32_t seed)
+    {
+        std::mt19937 random{ seed };
+        std::uniform_real_distribution<float> position{ -10.0f, 10.0f };
+        std::uniform_real_distribution<float> extent{ 0.1f, 3.0f };
+
+        auto randomVector = [&] { return glm::vec3{ position(random), position(random), position(random) }; };
+
+        Scene scene;
+
+        for (uint64_t i = 0; i < ItemCount; ++i)
+        {
+            glm::vec3 center = randomVector();
+            glm::vec3 halfSize{ extent(random), extent(random), extent(random) };
+            scene.Boxes.emplace_back(center - halfSize, center + halfSize);
+
+            glm::vec3 a = randomVector();
+            scene.Triangles.emplace_back(a, a + randomVector() * 0.3f, a + randomVector() * 0.3f);
+            scene.Rays.emplace_back(randomVector() * 2.0f, randomVector());
+        }
+
+        // Zero direction components produce infinite slab distances.
+        // Origins exactly on a slab plane produce NaNs, which batched Min and Max resolve differently, so they are avoided.
+        scene.Rays[1] = Ray3D{ glm::vec3{ 0.0f }, glm::vec3{ 1.0f, 0.0f, 0.0f } };
+        scene.Rays[2] = Ray3D{ (scene.Boxes[2].Min + scene.Boxes[2].Max) * 0.5f, glm::vec3{ 0.0f, 1.0f, 0.0f } };
+
+        return scene;
+    }
+
+    std::vector<InstructionSet> AvailableInstructionSets()
+    {
+        std::vector<InstructionSet> sets{ InstructionSet::Scalar };
+
+        for (InstructionSet set : { InstructionSet::SSE, InstructionSet::AVX })
+        {
+            if (set <= CollisionBatch::SupportedInstructionSet())
+            {
+                sets.push_back(set);
+            }
+        }
+
+        return sets;
+    }
+
+    bool IsLaneHit(const std::vector<CollisionBatch::PacketHits>& hits, uint64_t index)
+    {
+        return (hits[index / CollisionBatch::PacketWidth].Mask >> (index % CollisionBatch::PacketWidth)) & 1;
+    }
+
+    float LaneDistance(const std::vector<CollisionBatch::PacketHits>& hits, uint64_t index)
+    {
+        return hits[index / CollisionBatch::PacketWidth].Distances[index % CollisionBatch::PacketWidth];
+    }
+}
+
+TEST_CASE(RayAABBMatchesScalarCollision)
+{
+    Scene scene = MakeScene(3);
+    std::vector<CollisionBatch::AABBPacket> packets = CollisionBatch::MakePackets(scene.Boxes.data(), ItemCount);
+
+    for (uint64_t rayIndex = 0; rayIndex < 50; ++rayIndex)
+    {
+        const Ray3D& ray = scene.Rays[rayIndex];
+        std::vector<CollisionBatch::PacketHits> hits(CollisionBatch::PacketCount(ItemCount));
+        CollisionBatch::RayAABB(ray, packets.data(), ItemCount, hits.data());
+
+        for (uint64_t boxIndex = 0; boxIndex < ItemCount; ++boxIndex)
+        {
+            float distance = 0.0f;
+            bool isHit = Collision::RayAABB(ray, scene.Boxes[boxIndex], distance);
+
+            TEST_CHECK(isHit == IsLaneHit(hits, boxIndex), "Ray ", rayIndex, " disagrees with Collision::RayAABB on box ", boxIndex);
+            TEST_CHECK(!isHit || distance == LaneDistance(hits, boxIndex), "Distance to box ", boxIndex, " is ", LaneDistance(hits, boxIndex), ", expected ", distance);
+        }
+    }
+}
+
+TEST_CASE(RayTriangleMatchesScalarCollision)
+{
+    Scene scene = MakeScene(5);
+    std::vector<CollisionBatch::TrianglePacket> packets = CollisionBatch::MakePackets(scene.Triangles.data(), ItemCount);
+    uint64_t hitCount = 0;
+
+    for (uint64_t rayIndex = 0; rayIndex < 200; ++rayIndex)
+    {
+        const Ray3D& ray = scene.Rays[rayIndex];
+        std::vector<CollisionBatch::PacketHits> hits(CollisionBatch::PacketCount(ItemCount));
+        CollisionBatch::RayTriangle(ray, packets.data(), ItemCount, hits.data());
+
+        for (uint64_t triangleIndex = 0; triangleIndex < ItemCount; ++triangleIndex)
+        {
+            float distance = 0.0f;
+            bool isHit = Collision::RayTriangle(ray, scene.Triangles[triangleIndex], distance);
+            hitCount += isHit;
+
+            TEST_CHECK(isHit == IsLaneHit(hits, triangleIndex), "Ray ", rayIndex, " disagrees with Collision::RayTriangle on triangle ", triangleIndex);
+
+            // Batched kernel works with precomputed edges, so distances may differ in the last bits
+            TEST_CHECK(!isHit || std::abs(distance - LaneDistance(hits, triangleIndex)) <= 1e-4f * std::max(1.0f, distance),
+                "Distance to triangle ", triangleIndex, " is ", LaneDistance(hits, triangleIndex), ", expected ", distance);
+        }
+    }
+
+    TEST_CHECK(hitCount > 0, "Scene must produce some triangle hits to be meaningful");
+}
+
+TEST_CASE(InstructionSetsProduceIdenticalHits)
+{
+    Scene scene = MakeScene(7);
+    std::vector<CollisionBatch::AABBPacket> boxPackets = CollisionBatch::MakePackets(scene.Boxes.data(), ItemCount);
+    std::vector<CollisionBatch::TrianglePacket> trianglePackets = CollisionBatch::MakePackets(scene.Triangles.data(), ItemCount);
+    std::vector<CollisionBatch::RayPacket> rayPackets = CollisionBatch::MakePackets(scene.Rays.data(), ItemCount);
+
+    uint64_t packetCount = CollisionBatch::PacketCount(ItemCount);
+    std::vector<CollisionBatch::PacketHits> reference[3];
+
+    for (InstructionSet set : AvailableInstructionSets())
+    {
+        std::vector<CollisionBatch::PacketHits> hits[3];
+
+        for (std::vector<CollisionBatch::PacketHits>& queryHits : hits)
+        {
+            queryHits.resize(packetCount);
+        }
+
+        CollisionBatch::RayAABB(scene.Rays[0], boxPackets.data(), ItemCount, hits[0].data(), set);
+        CollisionBatch::RayTriangle(scene.Rays[5], trianglePackets.data(), ItemCount, hits[1].data(), set);
+        CollisionBatch::RayAABB(rayPackets.data(), ItemCount, scene.Boxes[7], hits[2].data(), set);
+
+        if (set == InstructionSet::Scalar)
+        {
+            std::copy(std::begin(hits), std::end(hits), std::begin(reference));
+            continue;
+        }
+
+        for (uint64_t query = 0; query < 3; ++query)
+        {
+            for (uint64_t packet = 0; packet < packetCount; ++packet)
+            {
+                const CollisionBatch::PacketHits& expected = reference[query][packet];
+                const CollisionBatch::PacketHits& actual = hits[query][packet];
+
+                TEST_CHECK(expected.Mask == actual.Mask, "Hit mask of packet ", packet, " in query ", query, " differs from scalar code");
+                TEST_CHECK(memcmp(expected.Distances, actual.Distances, sizeof(expected.Distances)) == 0,
+                    "Distances of packet ", packet, " in query ", query, " are not bit-identical to scalar code");
+            }
+        }
+    }
+}
+
+TEST_CASE(LanesPastItemCountAreNeverHit)
+{
+    // Zero-initialized padding lanes are a point box at the origin and a ray at the origin,
+    // both would be hit by the queries below if they were not masked out
+    AxisAlignedBox3D boxes[3]{ AxisAlignedBox3D::Unit(), AxisAlignedBox3D::Unit(), AxisAlignedBox3D::Unit() };
+    Ray3D rays[3]{ Ray3D{ glm::vec3{ -2.0f, 0.5f, 0.5f }, glm::vec3{ 1.0f, 0.0f, 0.0f } }, rays[0], rays[0] };
+    Ray3D ray{ glm::vec3{ -1.0f }, glm::vec3{ 1.0f } };
+
+    std::vector<CollisionBatch::AABBPacket> boxPackets = CollisionBatch::MakePackets(boxes, 3);
+    std::vector<CollisionBatch::RayPacket> rayPackets = CollisionBatch::MakePackets(rays, 3);
+
+    for (InstructionSet set : AvailableInstructionSets())
+    {
+        CollisionBatch::PacketHits boxHits;
+        CollisionBatch::PacketHits rayHits;
+
+        CollisionBatch::RayAABB(ray, boxPackets.data(), 3, &boxHits, set);
+        CollisionBatch::RayAABB(rayPackets.data(), 3, AxisAlignedBox3D::NDC(), &rayHits, set);
+
+        TEST_CHECK(boxHits.Mask == 0b111, "Only the 3 boxes must be hit, mask is ", boxHits.Mask);
+        TEST_CHECK(rayHits.Mask == 0b111, "Only the 3 rays must hit, mask is ", rayHits.Mask);
+    }
+}
+
+BENCHMARK(CollisionBatchThroughput)
+{
+    const uint64_t queryCount = 1000;
+    const double testCount = double(queryCount) * ItemCount;
+
+    Scene scene = MakeScene(11);
+    std::vector<CollisionBatch::AABBPacket> boxPackets = CollisionBatch::MakePackets(scene.Boxes.data(), ItemCount);
+    std::vector<CollisionBatch::TrianglePacket> trianglePackets = CollisionBatch::MakePackets(scene.Triangles.data(), ItemCount);
+    std::vector<CollisionBatch::RayPacket> rayPackets = CollisionBatch::MakePackets(scene.Rays.data(), ItemCount);
+    std::vector<CollisionBatch::PacketHits> hits(CollisionBatch::PacketCount(ItemCount));
+
+    // Each query tests one primitive against all items and returns its hit count,
+    // which keeps the work from being optimized out and must agree between code paths
+    auto measure = [&](auto&& query, uint64_t& hitCount)
+    {
+        double milliseconds = Tests::MeasureBestMilliseconds(5, [&]
+        {
+            hitCount = 0;
+
+            for (uint64_t queryIndex = 0; queryIndex < queryCount; ++queryIndex)
+            {
+                hitCount += query(queryIndex % ItemCount);
+            }
+        });
+
+        return testCount / (milliseconds * 1000.0);
+    };
+
+    auto countBatchHits = [&]
+    {
+        uint64_t count = 0;
+        for (const CollisionBatch::PacketHits& packetHits : hits) count += std::bitset<32>{ packetHits.Mask }.count();
+        return count;
+    };
+
+    uint64_t expectedHits[3] = {};
+    float distance = 0.0f;
+
+    double boxRate = measure([&](uint64_t index)
+    {
+        uint64_t count = 0;
+        for (const AxisAlignedBox3D& box : scene.Boxes) count += Collision::RayAABB(scene.Rays[index], box, distance);
+        return count;
+    }, expectedHits[0]);
+
+    double triangleRate = measure([&](uint64_t index)
+    {
+        uint64_t count = 0;
+        for (const Triangle3D& triangle : scene.Triangles) count += Collision::RayTriangle(scene.Rays[index], triangle, distance);
+        return count;
+    }, expectedHits[1]);
+
+    double rayRate = measure([&](uint64_t index)
+    {
+        uint64_t count = 0;
+        for (const Ray3D& ray : scene.Rays) count += Collision::RayAABB(ray, scene.Boxes[index], distance);
+        return count;
+    }, expectedHits[2]);
+
+    Tests::Report("Collision: ", boxRate, " Mtests/s ray-box, ", triangleRate, " Mtests/s ray-triangle, ", rayRate, " Mtests/s rays-box");
+
+    for (InstructionSet set : AvailableInstructionSets())
+    {
+        const char* setName = set == InstructionSet::AVX ? "AVX" : set == InstructionSet::SSE ? "SSE" : "Scalar";
+        uint64_t batchHits[3] = {};
+
+        double batchBoxRate = measure([&](uint64_t index)
+        {
+            CollisionBatch::RayAABB(scene.Rays[index], boxPackets.data(), ItemCount, hits.data(), set);
+            return countBatchHits();
+        }, batchHits[0]);
+
+        double batchTriangleRate = measure([&](uint64_t index)
+        {
+            CollisionBatch::RayTriangle(scene.Rays[index], trianglePackets.data(), ItemCount, hits.data(), set);
+            return countBatchHits();
+        }, batchHits[1]);
+
+        double batchRayRate = measure([&](uint64_t index)
+        {
+            CollisionBatch::RayAABB(rayPackets.data(), ItemCount, scene.Boxes[index], hits.data(), set);
+            return countBatchHits();
+        }, batchHits[2]);
+
+        TEST_CHECK(std::equal(std::begin(batchHits), std::end(batchHits), std::begin(expectedHits)), setName, " kernels disagree with Collision on hit counts");
+
+        Tests::Report(setName, " batch: ", batchBoxRate, " Mtests/s ray-box, ", batchTriangleRate, " Mtests/s ray-triangle, ", batchRayRate, " Mtests/s rays-box");
+    }
+}
@@ -0,0 +1,280 @@
+#include <TestFramework.hpp>
+
+#include <Geometry/TransformationBatch.hpp>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Geometry;
+
+    using InstructionSet = TransformationBatch::InstructionSet;
+    using MatrixOutput = TransformationBatch::MatrixOutput;
+
+    // Normal matrix tolerance documented by TransformationBatch::ComposeMatrices
+    constexpr float NormalMatrixTolerance = 3e-5f;
+
+    // Layout of a GPU instance table entry, matrices are interleaved with other fields
+    struct InstanceEntry
+    {
+        glm::mat4 ModelMatrix;
+        uint32_t MaterialIndex;
+        glm::mat4 NormalMatrix;
+        uint32_t Padding[3];
+    };
+
+    std::vector<Transformation> MakeTransformations(uint64_t count, uint32_t seed)
+    {
+        std::mt19937 random{ seed };
+        std::uniform_real_distribution<float> translation{ -100.0f, 100.0f };
+        std::uniform_real_distribution<float> logScale{ std::log(0.1f), std::log(10.0f) };
+        std::normal_distribution<float> rotation{ 0.0f, 1.0f };
+
+        std::vector<Transformation> transformations;
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            glm::vec3 scale{ std::exp(logScale(random)), std::exp(logScale(random)), std::exp(logScale(random)) };
+
+            // Mirrored transformations are common in scenes
+            if (i % 5 == 0)
+            {
+                scale.x = -scale.x;
+            }
+
+            glm::quat orientation = glm::normalize(glm::quat{ rotation(random), rotation(random), rotation(random), rotation(random) });
+            transformations.emplace_back(scale, glm::vec3{ translation(random), translation(random), translation(random) }, orientation);
+        }
+
+        // Identity, uniform scale and mirrored axis aligned transformations have many zero elements
+        transformations[0] = Transformation{};
+        transformations[1] = Transformation{ glm::vec3{ 2.0f }, glm::vec3{ 0.0f }, glm::quat{ 1.0f, 0.0f, 0.0f, 0.0f } };
+        transformations[2] = Transformation{ glm::vec3{ -1.0f, 1.0f, -3.0f }, glm::vec3{ -0.0f, 5.0f, 0.0f }, glm::quat{ 0.0f, 0.0f, 1.0f, 0.0f } };
+
+        return transformations;
+    }
+
+    TransformationBatch MakeBatch(const std::vector<Transformation>& transformations)
+    {
+        TransformationBatch batch;
+        batch.Resize(transformations.size());
+
+        for (uint64_t i = 0; i < transformations.size(); ++i)
+        {
+            batch.Set(i, transformations[i]);
+        }
+
+        return batch;
+    }
+
+    std::vector<InstructionSet> AvailableInstructionSets()
+    {
+        std::vector<InstructionSet> sets{ InstructionSet::Scalar };
+
+        if (TransformationBatch::SupportedInstructionSet() == InstructionSet::SSE)
+        {
+            sets.push_back(InstructionSet::SSE);
+        }
+
+        return sets;
+    }
+
+    const char* InstructionSetName(InstructionSet set)
+    {
+        return set == InstructionSet::SSE ? "SSE" : "Scalar";
+    }
+
+    bool IsBitIdentical(const glm::mat4& a, const glm::mat4& b)
+    {
+        return memcmp(&a, &b, sizeof(glm::mat4)) == 0;
+    }
+
+    // Error of an element is relative to the largest element of its row, since elements of a row
+    // are combined with the same vector component and near zero elements only carry absolute error
+    float NormalMatrixError(const glm::mat4& actual, const glm::mat4& expected)
+    {
+        float maxError = 0.0f;
+
+        for (int row = 0; row < 4; ++row)
+        {
+            float rowMagnitude = 0.0f;
+
+            for (int column = 0; column < 4; ++column)
+            {
+                rowMagnitude = std::max(rowMagnitude, std::abs(expected[column][row]));
+            }
+
+            for (int column = 0; column < 4; ++column)
+            {
+                maxError = std::max(maxError, std::abs(actual[column][row] - expected[column][row]) / std::max(rowMagnitude, 1e-20f));
+            }
+        }
+
+        return maxError;
+    }
+}
+
+TEST_CASE(ModelMatricesAreBitIdentical)
+{
+    std::vector<Transformation> transformations = MakeTransformations(1003, 1);
+    TransformationBatch batch = MakeBatch(transformations);
+
+    for (InstructionSet set : AvailableInstructionSets())
+    {
+        std::vector<glm::mat4> modelMatrices(transformations.size(), glm::mat4{ 0.0f });
+        batch.ComposeMatrices(0, batch.Count(), MatrixOutput{ modelMatrices.data() }, MatrixOutput{}, set);
+
+        for (uint64_t i = 0; i < transformations.size(); ++i)
+        {
+            TEST_CHECK(IsBitIdentical(modelMatrices[i], transformations[i].ModelMatrix()), InstructionSetName(set), " model matrix ", i, " differs from Transformation::ModelMatrix()");
+        }
+    }
+}
+
+TEST_CASE(NormalMatricesMatchWithinTolerance)
+{
+    std::vector<Transformation> transformations = MakeTransformations(1003, 2);
+    TransformationBatch batch = MakeBatch(transformations);
+
+    for (InstructionSet set : AvailableInstructionSets())
+    {
+        std::vector<glm::mat4> normalMatrices(transformations.size(), glm::mat4{ 0.0f });
+        batch.ComposeMatrices(0, batch.Count(), MatrixOutput{}, MatrixOutput{ normalMatrices.data() }, set);
+
+        for (uint64_t i = 0; i < transformations.size(); ++i)
+        {
+            float error = NormalMatrixError(normalMatrices[i], transformations[i].NormalMatrix());
+
+            TEST_CHECK(error <= NormalMatrixTolerance, InstructionSetName(set), " normal matrix ", i, " is off by ", error, " relative to Transformation::NormalMatrix()");
+        }
+
+        TEST_CHECK(normalMatrices[0] == glm::mat4{ 1.0f }, "Identity must have exact identity normal matrix");
+    }
+}
+
+TEST_CASE(InstructionSetsProduceIdenticalMatrices)
+{
+    if (TransformationBatch::SupportedInstructionSet() == InstructionSet::Scalar)
+    {
+        return;
+    }
+
+    std::vector<Transformation> transformations = MakeTransformations(1003, 3);
+    TransformationBatch batch = MakeBatch(transformations);
+
+    std::vector<glm::mat4> scalarMatrices[2];
+    std::vector<glm::mat4> sseMatrices[2];
+
+    for (std::vector<glm::mat4>* matrices : { scalarMatrices, sseMatrices })
+    {
+        matrices[0].resize(transformations.size());
+        matrices[1].resize(transformations.size());
+    }
+
+    batch.ComposeMatrices(0, batch.Count(), MatrixOutput{ scalarMatrices[0].data() }, MatrixOutput{ scalarMatrices[1].data() }, InstructionSet::Scalar);
+    batch.ComposeMatrices(0, batch.Count(), MatrixOutput{ sseMatrices[0].data() }, MatrixOutput{ sseMatrices[1].data() }, InstructionSet::SSE);
+
+    for (uint64_t i = 0; i < transformations.size(); ++i)
+    {
+        TEST_CHECK(IsBitIdentical(scalarMatrices[0][i], sseMatrices[0][i]), "SSE model matrix ", i, " differs from scalar code");
+        TEST_CHECK(IsBitIdentical(scalarMatrices[1][i], sseMatrices[1][i]), "SSE normal matrix ", i, " differs from scalar code");
+    }
+}
+
+TEST_CASE(UnalignedRangesWriteStridedOutputs)
+{
+    std::vector<Transformation> transformations = MakeTransformations(23, 4);
+    TransformationBatch batch = MakeBatch(transformations);
+
+    const glm::mat4 untouched{ -7.0f };
+
+    for (InstructionSet set : AvailableInstructionSets())
+    {
+        // Ranges start and end inside of packets, span none, one or several whole packets
+        for (uint64_t first = 0; first < 6; ++first)
+        {
+            for (uint64_t count = 0; first + count <= transformations.size(); count += 1 + count / 4)
+            {
+                std::vector<InstanceEntry> entries(transformations.size(), InstanceEntry{ untouched, 0xAAAAAAAA, untouched, { 1, 2, 3 } });
+
+                // Entries are indexed by transformation, so output starts at the first one
+                InstanceEntry* firstEntry = &entries[first];
+                batch.ComposeMatrices(first, count,
+                    MatrixOutput{ &firstEntry->ModelMatrix, sizeof(InstanceEntry) }, MatrixOutput{ &firstEntry->NormalMatrix, sizeof(InstanceEntry) }, set);
+
+                for (uint64_t i = 0; i < entries.size(); ++i)
+                {
+                    const InstanceEntry& entry = entries[i];
+                    bool isInRange = i >= first && i < first + count;
+
+                    TEST_CHECK(entry.MaterialIndex == 0xAAAAAAAA && entry.Padding[0] == 1 && entry.Padding[2] == 3,
+                        InstructionSetName(set), " range [", first, "; ", first + count, ") overwrote fields between matrices of entry ", i);
+
+                    if (!isInRange)
+                    {
+                        TEST_CHECK(IsBitIdentical(entry.ModelMatrix, untouched) && IsBitIdentical(entry.NormalMatrix, untouched),
+                            InstructionSetName(set), " range [", first, "; ", first + count, ") wrote entry ", i, " outside of it");
+                        continue;
+                    }
+
+                    TEST_CHECK(IsBitIdentical(entry.ModelMatrix, transformations[i].ModelMatrix()),
+                        InstructionSetName(set), " range [", first, "; ", first + count, ") wrote wrong model matrix ", i);
+                    TEST_CHECK(NormalMatrixError(entry.NormalMatrix, transformations[i].NormalMatrix()) <= NormalMatrixTolerance,
+                        InstructionSetName(set), " range [", first, "; ", first + count, ") wrote wrong normal matrix ", i);
+                }
+            }
+        }
+    }
+}
+
+BENCHMARK(TransformationBatchMillionInstances)
+{
+    const uint64_t instanceCount = 1000000;
+
+    std::vector<Transformation> transformations = MakeTransformations(instanceCount, 5);
+    std::vector<InstanceEntry> entries(instanceCount);
+
+    TransformationBatch batch;
+    batch.Resize(instanceCount);
+
+    double setMilliseconds = Tests::MeasureBestMilliseconds(3, [&]
+    {
+        for (uint64_t i = 0; i < instanceCount; ++i)
+        {
+            batch.Set(i, transformations[i]);
+        }
+    });
+
+    // What instance table update did before batching
+    double matrixMilliseconds = Tests::MeasureBestMilliseconds(3, [&]
+    {
+        for (uint64_t i = 0; i < instanceCount; ++i)
+        {
+            entries[i].ModelMatrix = transformations[i].ModelMatrix();
+            entries[i].NormalMatrix = transformations[i].NormalMatrix();
+        }
+    });
+
+    Tests::Report(instanceCount, " instances: Set ", setMilliseconds, " ms, Transformation matrices ", matrixMilliseconds, " ms, ",
+        matrixMilliseconds * 1000000.0 / instanceCount, " ns per instance");
+
+    for (InstructionSet set : AvailableInstructionSets())
+    {
+        double composeMilliseconds = Tests::MeasureBestMilliseconds(5, [&]
+        {
+            batch.ComposeMatrices(0, instanceCount,
+                MatrixOutput{ &entries[0].ModelMatrix, sizeof(InstanceEntry) }, MatrixOutput{ &entries[0].NormalMatrix, sizeof(InstanceEntry) }, set);
+        });
+
+        TEST_CHECK(IsBitIdentical(entries.back().ModelMatrix, transformations.back().ModelMatrix()), "Composed matrices must be correct");
+
+        Tests::Report(InstructionSetName(set), " batch: ", composeMilliseconds, " ms, ", composeMilliseconds * 1000000.0 / instanceCount, " ns per instance, ",
+            matrixMilliseconds / composeMilliseconds, "x faster");
+    }
+}
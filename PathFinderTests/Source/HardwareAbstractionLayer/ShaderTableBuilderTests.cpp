@@ -0,0 +1,145 @@
+#include <TestFramework.hpp>
+
+#include <HardwareAbstractionLayer/ShaderTableBuilder.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    using namespace HAL;
+
+    using RecordType = ShaderTableBuilder::RecordType;
+    using Patch = ShaderTableBuilder::Patch;
+
+    ShaderTableBuilder::ShaderIdentifierBytes Identifier(uint8_t value)
+    {
+        ShaderTableBuilder::ShaderIdentifierBytes identifier;
+        identifier.fill(value);
+        return identifier;
+    }
+
+    // Ray generation without arguments, misses and hit groups with mixed argument sizes, no callables
+    bool BuildTable(ShaderTableBuilder& builder, uint8_t hitGroupIdentifier = 4)
+    {
+        builder.BeginUpdate();
+        builder.AddRecord(RecordType::RayGeneration, Identifier(1));
+        builder.AddRecord(RecordType::Miss, Identifier(2), 8);
+        builder.AddRecord(RecordType::Miss, Identifier(3), 40);
+        builder.AddRecord(RecordType::Miss, Identifier(3));
+        builder.AddRecord(RecordType::HitGroup, Identifier(hitGroupIdentifier), 100);
+        builder.AddRecord(RecordType::HitGroup, Identifier(5), 4);
+        return builder.EndUpdate();
+    }
+
+    uint64_t RecordOffset(const ShaderTableBuilder& builder, RecordType type, uint64_t recordIndex)
+    {
+        const ShaderTableBuilder::Region& region = builder.GetLayout().RegionOf(type);
+        return region.Offset + recordIndex * region.Stride;
+    }
+}
+
+TEST_CASE(LayoutAlignsRecordsAndRegions)
+{
+    ShaderTableBuilder builder;
+    BuildTable(builder);
+
+    const ShaderTableBuilder::Layout& layout = builder.GetLayout();
+
+    // Strides are defined by the largest record of a type rounded up to 32 bytes
+    TEST_CHECK(layout.RegionOf(RecordType::RayGeneration).Stride == 32, "Identifier-only record takes 32 bytes");
+    TEST_CHECK(layout.RegionOf(RecordType::Miss).Stride == 96, "32 + 40 bytes round up to 96, got ", layout.RegionOf(RecordType::Miss).Stride);
+    TEST_CHECK(layout.RegionOf(RecordType::HitGroup).Stride == 160, "32 + 100 bytes round up to 160, got ", layout.RegionOf(RecordType::HitGroup).Stride);
+
+    // Missing type still gets a null record
+    TEST_CHECK(layout.RegionOf(RecordType::Callable).RecordCount == 1 && layout.RegionOf(RecordType::Callable).Stride == 32, "Callable region must hold a null record");
+
+    uint64_t expectedOffsets[] = { 0, 64, 384, 704 };
+    uint64_t previousEnd = 0;
+
+    for (uint64_t typeIndex = 0; typeIndex < ShaderTableBuilder::RecordTypeCount; ++typeIndex)
+    {
+        const ShaderTableBuilder::Region& region = layout.Regions[typeIndex];
+
+        TEST_CHECK(region.Offset % ShaderTableBuilder::RegionAlignment == 0, "Region ", typeIndex, " is not 64 byte aligned");
+        TEST_CHECK(region.Stride % ShaderTableBuilder::RecordAlignment == 0, "Stride of region ", typeIndex, " is not 32 byte aligned");
+        TEST_CHECK(region.Offset >= previousEnd, "Region ", typeIndex, " overlaps the previous one");
+        TEST_CHECK(region.Offset == expectedOffsets[typeIndex], "Region ", typeIndex, " is at ", region.Offset, ", expected ", expectedOffsets[typeIndex]);
+
+        previousEnd = region.Offset + region.SizeInBytes();
+    }
+
+    TEST_CHECK(layout.TableSizeInBytes == 768 && builder.Image().size() == 768, "Table size is ", layout.TableSizeInBytes);
+
+    uint64_t secondMissOffset = RecordOffset(builder, RecordType::Miss, 1);
+    TEST_CHECK(memcmp(builder.Image().data() + secondMissOffset, Identifier(3).data(), 32) == 0, "Identifier must start the record");
+}
+
+TEST_CASE(LocalRootArgumentsFollowIdentifier)
+{
+    ShaderTableBuilder builder;
+    BuildTable(builder);
+    builder.ConsumePatches();
+
+    std::vector<uint8_t> arguments(100);
+
+    for (uint64_t byte = 0; byte < arguments.size(); ++byte)
+    {
+        arguments[byte] = uint8_t(byte + 1);
+    }
+
+    builder.SetLocalRootArguments(RecordType::HitGroup, 0, arguments.data(), arguments.size());
+
+    uint64_t argumentsOffset = RecordOffset(builder, RecordType::HitGroup, 0) + ShaderTableBuilder::ShaderIdentifierSize;
+    std::vector<Patch> patches = builder.ConsumePatches();
+
+    TEST_CHECK(memcmp(builder.Image().data() + argumentsOffset, arguments.data(), arguments.size()) == 0, "Arguments must be written right after identifier");
+    TEST_CHECK(patches.size() == 1 && patches[0].Offset == argumentsOffset && patches[0].Size == arguments.size(), "Argument update must patch only arguments");
+
+    // Arguments survive a structure update with the same argument size
+    BuildTable(builder);
+    TEST_CHECK(builder.ConsumePatches().empty(), "Rebuilt table with preserved arguments must not be patched");
+    TEST_CHECK(memcmp(builder.Image().data() + argumentsOffset, arguments.data(), arguments.size()) == 0, "Arguments were lost on structure update");
+}
+
+TEST_CASE(HotReloadOfOneShaderPatchesOneIdentifier)
+{
+    ShaderTableBuilder builder;
+    BuildTable(builder);
+
+    std::vector<Patch> initialPatches = builder.ConsumePatches();
+    TEST_CHECK(initialPatches.size() == 1 && initialPatches[0].Offset == 0 && initialPatches[0].Size == 768, "First build must upload the whole table");
+
+    BuildTable(builder, 42);
+    std::vector<Patch> patches = builder.ConsumePatches();
+
+    TEST_CHECK(patches.size() == 1, "Changed identifier must produce exactly one patch, got ", patches.size());
+    TEST_CHECK(patches[0].Offset == RecordOffset(builder, RecordType::HitGroup, 0) && patches[0].Size == ShaderTableBuilder::ShaderIdentifierSize,
+        "Patch must cover the identifier only: ", patches[0].Offset, "+", patches[0].Size);
+}
+
+TEST_CASE(UnchangedTableProducesNoPatches)
+{
+    ShaderTableBuilder builder;
+    BuildTable(builder);
+    builder.ConsumePatches();
+
+    for (uint64_t iteration = 0; iteration < 3; ++iteration)
+    {
+        TEST_CHECK(!BuildTable(builder), "Identical structure must keep layout");
+    }
+
+    TEST_CHECK(builder.ConsumePatches().empty(), "Identical structure must not be patched");
+
+    uint8_t sameArguments[8]{};
+    builder.SetLocalRootArguments(RecordType::Miss, 0, sameArguments, sizeof(sameArguments));
+    TEST_CHECK(builder.ConsumePatches().empty(), "Setting identical arguments must not be patched");
+
+    // Growing a record changes the stride, which moves every record after it
+    builder.BeginUpdate();
+    builder.AddRecord(RecordType::RayGeneration, Identifier(1), 64);
+    TEST_CHECK(builder.EndUpdate(), "Stride change must be reported as layout change");
+
+    std::vector<Patch> patches = builder.ConsumePatches();
+    TEST_CHECK(patches.size() == 1 && patches[0].Offset == 0 && patches[0].Size == builder.GetLayout().TableSizeInBytes, "Layout change must patch the whole table");
+}
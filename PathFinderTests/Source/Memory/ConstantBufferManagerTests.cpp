@@ -0,0 +1,375 @@
+#include <TestFramework.hpp>
+
+#include <Memory/ConstantBufferManager.hpp>
+#include <Memory/PagedLinearAllocator.hpp>
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Memory;
+
+    using Manager = ConstantBufferManager;
+
+    constexpr HAL::GPUAddress FrameMemoryBase = 1ull << 32;
+    constexpr HAL::GPUAddress PersistentMemoryBase = 1ull << 40;
+
+    // Largest persistent page, so that fake GPU ranges of pages never overlap
+    constexpr uint64_t PersistentPageStride = Manager::MaxConstantBufferSize * 32;
+
+    // CPU memory posing as upload heaps. GPU addresses are fake and translated back to read the uploaded data.
+    class FakeUploadMemory : public Manager::UploadMemory
+    {
+    public:
+        FakeUploadMemory(uint64_t frameMemorySize)
+            : mFrameAllocator{ frameMemorySize }, mFrameMemory(frameMemorySize)
+        {
+            mFrameAllocator.SetPageCount(1);
+        }
+
+        std::optional<Range> AllocateFrameMemory(uint64_t sizeInBytes, uint64_t alignment) override
+        {
+            std::optional<PagedLinearAllocator::Range> range = mFrameAllocator.Allocate(sizeInBytes, alignment);
+
+            if (!range)
+            {
+                return std::nullopt;
+            }
+
+            return Range{ mFrameMemory.data() + range->OffsetInPage, FrameMemoryBase + range->OffsetInPage };
+        }
+
+        std::optional<Range> CreatePersistentPage(uint64_t pageSize, uint64_t slotSize) override
+        {
+            if (mPersistentPages.size() >= mPersistentPageLimit)
+            {
+                return std::nullopt;
+            }
+
+            mPersistentPages.push_back(std::make_unique<std::vector<uint8_t>>(pageSize));
+            mPersistentPageSizes.push_back(pageSize);
+
+            uint64_t pageIndex = mPersistentPages.size() - 1;
+            return Range{ mPersistentPages.back()->data(), PersistentMemoryBase + pageIndex * PersistentPageStride };
+        }
+
+        // Frame memory of the previous frame is treated as recycled
+        void BeginFrame()
+        {
+            mFrameAllocator.Reset();
+        }
+
+        void SetFrameMemoryExhausted(bool isExhausted)
+        {
+            mFrameAllocator.SetPageCount(isExhausted ? 0 : 1);
+        }
+
+        void SetPersistentPageLimit(uint64_t pageLimit)
+        {
+            mPersistentPageLimit = pageLimit;
+        }
+
+        bool IsFrameMemory(HAL::GPUAddress address, uint64_t size) const
+        {
+            return address >= FrameMemoryBase && address + size <= FrameMemoryBase + mFrameMemory.size();
+        }
+
+        bool IsPersistentMemory(HAL::GPUAddress address, uint64_t size) const
+        {
+            if (address < PersistentMemoryBase)
+            {
+                return false;
+            }
+
+            uint64_t pageIndex = (address - PersistentMemoryBase) / PersistentPageStride;
+            uint64_t offsetInPage = (address - PersistentMemoryBase) % PersistentPageStride;
+
+            return pageIndex < mPersistentPages.size() && offsetInPage + size <= mPersistentPageSizes[pageIndex];
+        }
+
+        // Data that GPU would read at the address
+        const uint8_t* Read(HAL::GPUAddress address) const
+        {
+            if (address >= PersistentMemoryBase)
+            {
+                uint64_t pageIndex = (address - PersistentMemoryBase) / PersistentPageStride;
+                return mPersistentPages[pageIndex]->data() + (address - PersistentMemoryBase) % PersistentPageStride;
+            }
+
+            return mFrameMemory.data() + (address - FrameMemoryBase);
+        }
+
+    private:
+        PagedLinearAllocator mFrameAllocator;
+        std::vector<uint8_t> mFrameMemory;
+        std::vector<std::unique_ptr<std::vector<uint8_t>>> mPersistentPages;
+        std::vector<uint64_t> mPersistentPageSizes;
+        uint64_t mPersistentPageLimit = std::numeric_limits<uint64_t>::max();
+    };
+
+    // Drives manager the way render engine does, with two frames in flight
+    struct Harness
+    {
+        Harness(uint64_t frameMemorySize = 1024 * 1024)
+            : Memory{ frameMemorySize }, Constants{ &Memory } {}
+
+        void NextFrame()
+        {
+            ++FrameNumber;
+            Memory.BeginFrame();
+            Constants.BeginFrame(FrameNumber);
+        }
+
+        // Completes the frame on GPU
+        void CompleteFrame(uint64_t frameNumber)
+        {
+            Constants.EndFrame(frameNumber);
+        }
+
+        HAL::GPUAddress Upload(Manager::StreamID stream, const std::vector<uint8_t>& data)
+        {
+            return Constants.Upload(stream, data.data(), data.size());
+        }
+
+        bool Holds(HAL::GPUAddress address, const std::vector<uint8_t>& data) const
+        {
+            return memcmp(Memory.Read(address), data.data(), data.size()) == 0;
+        }
+
+        FakeUploadMemory Memory;
+        Manager Constants;
+        uint64_t FrameNumber = 0;
+    };
+
+    std::vector<uint8_t> MakeConstants(uint64_t size, uint64_t seed)
+    {
+        std::vector<uint8_t> data(size);
+        std::mt19937 random{ uint32_t(seed) };
+
+        for (uint8_t& byte : data)
+        {
+            byte = uint8_t(random());
+        }
+
+        return data;
+    }
+}
+
+TEST_CASE(ConstantBuffersAreAlignedInBothMemoryKinds)
+{
+    Harness harness;
+    std::vector<uint64_t> sizes{ 4, 100, 255, 256, 300, 1000, 4096, 10000, Manager::MaxConstantBufferSize };
+    std::vector<Manager::StreamID> streams;
+
+    for (uint64_t size : sizes)
+    {
+        streams.push_back(harness.Constants.CreateStream());
+    }
+
+    // First frame uploads to frame memory, second one grows persistent pools and the third one uses persistent pages
+    for (uint64_t frame = 0; frame < 4; ++frame)
+    {
+        harness.NextFrame();
+
+        for (uint64_t sizeIdx = 0; sizeIdx < sizes.size(); ++sizeIdx)
+        {
+            std::vector<uint8_t> data = MakeConstants(sizes[sizeIdx], sizeIdx);
+            HAL::GPUAddress address = harness.Upload(streams[sizeIdx], data);
+
+            bool isPersistent = harness.Memory.IsPersistentMemory(address, data.size());
+
+            TEST_CHECK(address % Manager::Alignment == 0, "Constant buffer of ", data.size(), " bytes is placed at unaligned address ", address);
+            TEST_CHECK(isPersistent == (frame >= 2) && (isPersistent || harness.Memory.IsFrameMemory(address, data.size())),
+                "Constant buffer of ", data.size(), " bytes is in unexpected memory in frame ", frame);
+            TEST_CHECK(harness.Holds(address, data), "Constant buffer of ", data.size(), " bytes holds wrong data");
+        }
+    }
+
+    // Every update of the last frame was repeated
+    harness.NextFrame();
+    TEST_CHECK(harness.Constants.LastFrameStatistics().SkippedUpdateCount == sizes.size() && harness.Constants.LastFrameStatistics().UploadedBytes == 0,
+        "Repeated data must not be uploaded again");
+}
+
+TEST_CASE(ExhaustedMemoryFallsBackToOtherMemoryKind)
+{
+    Harness harness;
+    Manager::StreamID stream = harness.Constants.CreateStream();
+    std::vector<uint8_t> repeated = MakeConstants(512, 1);
+
+    harness.NextFrame();
+    harness.Upload(stream, repeated);
+
+    // Repeated data has no persistent page to go to yet
+    harness.NextFrame();
+    HAL::GPUAddress address = harness.Upload(stream, repeated);
+    TEST_CHECK(harness.Memory.IsFrameMemory(address, repeated.size()) && harness.Holds(address, repeated), "Repeated data must fall back to frame memory without persistent pages");
+
+    // Changing data has no frame memory to go to
+    harness.NextFrame();
+    harness.Memory.SetFrameMemoryExhausted(true);
+
+    std::vector<uint8_t> changed = MakeConstants(512, 2);
+    address = harness.Upload(stream, changed);
+
+    TEST_CHECK(harness.Memory.IsPersistentMemory(address, changed.size()) && harness.Holds(address, changed), "Changing data must fall back to persistent memory when frame memory is exhausted");
+    TEST_CHECK(address % Manager::Alignment == 0, "Fallback constant buffer is unaligned");
+
+    // Fallback data repeats and stays where it is
+    harness.NextFrame();
+    TEST_CHECK(harness.Upload(stream, changed) == address, "Data repeated after fallback must stay in persistent memory");
+
+    // Size class without pages whose pages can't be created
+    harness.Memory.SetFrameMemoryExhausted(false);
+    harness.Memory.SetPersistentPageLimit(0);
+
+    Manager::StreamID otherStream = harness.Constants.CreateStream();
+    std::vector<uint8_t> large = MakeConstants(20000, 3);
+
+    for (uint64_t frame = 0; frame < 3; ++frame)
+    {
+        harness.NextFrame();
+        address = harness.Upload(otherStream, large);
+
+        TEST_CHECK(harness.Memory.IsFrameMemory(address, large.size()) && harness.Holds(address, large), "Page creation failure must keep repeated data in frame memory");
+    }
+}
+
+TEST_CASE(PersistentSlotsOutliveFramesThatReadThem)
+{
+    Harness harness;
+
+    // Residents fill the first persistent page, latecomers ask for slots while a resident's slot is pending release
+    const uint64_t residentCount = 32;
+    const uint64_t latecomerCount = 33;
+
+    std::vector<Manager::StreamID> streams;
+    std::vector<std::vector<uint8_t>> data;
+
+    for (uint64_t streamIdx = 0; streamIdx < residentCount + latecomerCount; ++streamIdx)
+    {
+        streams.push_back(harness.Constants.CreateStream());
+        data.push_back(MakeConstants(200, streamIdx));
+    }
+
+    for (uint64_t frame = 0; frame < 2; ++frame)
+    {
+        harness.NextFrame();
+
+        for (uint64_t streamIdx = 0; streamIdx < streams.size(); ++streamIdx)
+        {
+            harness.Upload(streams[streamIdx], data[streamIdx]);
+        }
+    }
+
+    harness.NextFrame();
+    harness.CompleteFrame(1);
+
+    std::vector<HAL::GPUAddress> residentAddresses;
+
+    for (uint64_t streamIdx = 0; streamIdx < residentCount; ++streamIdx)
+    {
+        residentAddresses.push_back(harness.Upload(streams[streamIdx], data[streamIdx]));
+        TEST_CHECK(harness.Memory.IsPersistentMemory(residentAddresses.back(), 200), "Resident ", streamIdx, " must move into persistent memory");
+    }
+
+    HAL::GPUAddress releasedAddress = residentAddresses[0];
+
+    // GPU still reads the resident slot in frame 3 while frame 4 changes the data
+    harness.NextFrame();
+    harness.CompleteFrame(2);
+
+    std::vector<uint8_t> changed = MakeConstants(200, 1000);
+    TEST_CHECK(harness.Memory.IsFrameMemory(harness.Upload(streams[0], changed), 200), "Changed resident data must go to frame memory");
+
+    harness.CompleteFrame(3);
+
+    HAL::GPUAddress latecomerAddress = harness.Upload(streams[residentCount], data[residentCount]);
+
+    TEST_CHECK(harness.Memory.IsPersistentMemory(latecomerAddress, 200), "Latecomer must get a persistent slot");
+    TEST_CHECK(latecomerAddress != releasedAddress, "Slot released in frame 4 was reused before frame 4 completed");
+    TEST_CHECK(harness.Holds(releasedAddress, data[0]), "Data of the released slot was overwritten while GPU could read it");
+
+    // Once frame 4 completes, the slot goes back to the pool behind the slots that were free before
+    harness.NextFrame();
+    harness.CompleteFrame(4);
+
+    bool isReleasedSlotReused = false;
+
+    for (uint64_t streamIdx = residentCount + 1; streamIdx < streams.size(); ++streamIdx)
+    {
+        HAL::GPUAddress address = harness.Upload(streams[streamIdx], data[streamIdx]);
+        isReleasedSlotReused = isReleasedSlotReused || address == releasedAddress;
+    }
+
+    TEST_CHECK(isReleasedSlotReused, "Slot must be reused after the frame that released it completed");
+}
+
+BENCHMARK(ConstantBufferUploadedBytes)
+{
+    // Pass constants of a typical frame: a few change with the camera every frame, the rest repeats and changes rarely
+    const uint64_t streamCount = 200;
+    const uint64_t everyFrameCount = 20;
+    const uint64_t frameCount = 500;
+
+    Harness harness{ 4 * 1024 * 1024 };
+    std::mt19937 random{ 7 };
+
+    std::vector<Manager::StreamID> streams;
+    std::vector<std::vector<uint8_t>> data;
+
+    for (uint64_t streamIdx = 0; streamIdx < streamCount; ++streamIdx)
+    {
+        streams.push_back(harness.Constants.CreateStream());
+        data.push_back(MakeConstants(64 + random() % 2048, streamIdx));
+    }
+
+    uint64_t naiveBytes = 0;
+    uint64_t uploadedBytes = 0;
+    uint64_t skippedUpdateCount = 0;
+    uint64_t updateCount = 0;
+
+    double milliseconds = Tests::MeasureBestMilliseconds(1, [&]
+    {
+        for (uint64_t frame = 0; frame < frameCount; ++frame)
+        {
+            harness.NextFrame();
+
+            if (harness.FrameNumber > 2)
+            {
+                harness.CompleteFrame(harness.FrameNumber - 2);
+            }
+
+            // Statistics are of the previous frame
+            if (frame > 0)
+            {
+                const Manager::Statistics& statistics = harness.Constants.LastFrameStatistics();
+                naiveBytes += statistics.UploadedBytes + statistics.SkippedBytes;
+                uploadedBytes += statistics.UploadedBytes;
+                skippedUpdateCount += statistics.SkippedUpdateCount;
+                updateCount += statistics.UpdateCount;
+            }
+
+            for (uint64_t streamIdx = 0; streamIdx < streamCount; ++streamIdx)
+            {
+                if (streamIdx < everyFrameCount || random() % 100 == 0)
+                {
+                    data[streamIdx][random() % data[streamIdx].size()] += 1;
+                }
+
+                harness.Upload(streams[streamIdx], data[streamIdx]);
+            }
+        }
+    });
+
+    TEST_CHECK(uploadedBytes < naiveBytes, "Repeated constants must not be uploaded every frame");
+
+    Tests::Report(streamCount, " streams, ", everyFrameCount, " changing every frame: ", double(uploadedBytes) / (frameCount - 1) / 1024.0, " KB uploaded per frame instead of ",
+        double(naiveBytes) / (frameCount - 1) / 1024.0, " KB, ", 100.0 * skippedUpdateCount / updateCount, "% updates skipped");
+
+    Tests::Report(milliseconds * 1000000.0 / (frameCount * streamCount), " ns per update");
+}
@@ -0,0 +1,292 @@
+#include <TestFramework.hpp>
+
+#include <Memory/CopyPlanner.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Memory;
+
+    using Planner = CopyPlanner;
+    using Kind = CopyPlanner::CopyKind;
+
+    // Planner never dereferences resources, so any distinct addresses do
+    const HAL::Resource* FakeResource(uint64_t index)
+    {
+        return reinterpret_cast<const HAL::Resource*>(uintptr_t(0x10000 * (index + 1)));
+    }
+
+    const HAL::Resource* const StagingA = FakeResource(0);
+    const HAL::Resource* const StagingB = FakeResource(1);
+    const HAL::Resource* const BufferA = FakeResource(2);
+    const HAL::Resource* const BufferB = FakeResource(3);
+
+    class RequestList
+    {
+    public:
+        RequestList& Add(const HAL::Resource* source, const HAL::Resource* destination, uint64_t sourceOffset, uint64_t destinationOffset, uint64_t size,
+            bool isDeferrable = false, Kind kind = Kind::BufferRegion)
+        {
+            mRegions.push_back({ kind, source, destination, sourceOffset, destinationOffset, size, isDeferrable, mSequence++ });
+            return *this;
+        }
+
+        std::vector<Planner::CopyRegion>& Regions() { return mRegions; }
+
+    private:
+        std::vector<Planner::CopyRegion> mRegions;
+        uint64_t mSequence = 0;
+    };
+
+    Planner::Plan BuildPlan(const std::vector<Planner::CopyRegion>& regions, uint64_t budget = ~0ull)
+    {
+        Planner planner;
+        Planner::Plan plan;
+        planner.BuildPlan(regions, budget, plan);
+        return plan;
+    }
+
+    // Replays copies on byte arrays: source bytes are labelled by resource and offset,
+    // so the destination content tells which request wrote each byte last
+    using ResourceContents = std::vector<std::vector<uint64_t>>;
+
+    constexpr uint64_t ResourceCount = 6;
+    constexpr uint64_t ResourceSize = 512;
+
+    void Apply(const std::vector<Planner::CopyRegion>& copies, ResourceContents& memory)
+    {
+        auto index = [](const HAL::Resource* resource) { return reinterpret_cast<uintptr_t>(resource) / 0x10000 - 1; };
+
+        for (const Planner::CopyRegion& copy : copies)
+        {
+            std::vector<uint64_t>& destination = memory[index(copy.Destination)];
+            const std::vector<uint64_t>& source = memory[index(copy.Source)];
+            std::copy_n(source.begin() + copy.SourceOffset, copy.Size, destination.begin() + copy.DestinationOffset);
+        }
+    }
+
+    ResourceContents MakeContents()
+    {
+        ResourceContents memory(ResourceCount, std::vector<uint64_t>(ResourceSize, 0));
+
+        for (uint64_t resource = 0; resource < ResourceCount; ++resource)
+        {
+            for (uint64_t byte = 0; byte < ResourceSize; ++byte)
+            {
+                memory[resource][byte] = resource * ResourceSize + byte + 1;
+            }
+        }
+
+        return memory;
+    }
+}
+
+TEST_CASE(MergesRegionsReadingSameStagingBytes)
+{
+    RequestList requests;
+    requests.Add(StagingA, BufferA, 0, 100, 50)
+        .Add(StagingA, BufferA, 50, 150, 50)     // Contiguous
+        .Add(StagingA, BufferA, 80, 180, 120)    // Overlapping, same delta
+        .Add(StagingA, BufferA, 10, 110, 5);     // Contained
+
+    Planner::Plan plan = BuildPlan(requests.Regions());
+
+    TEST_CHECK(plan.Copies.size() == 1, "Regions with one offset delta must merge, got ", plan.Copies.size(), " copies");
+    TEST_CHECK(plan.Copies[0].SourceOffset == 0 && plan.Copies[0].DestinationOffset == 100 && plan.Copies[0].Size == 200, "Merged copy covers wrong range");
+    TEST_CHECK(plan.Copies[0].Sequence == 0, "Merged copy must keep earliest sequence");
+    TEST_CHECK(plan.RequestedRegionCount == 4 && plan.SubmittedBytes == 225, "Statistics are off");
+}
+
+TEST_CASE(KeepsRegionsOfDifferentSourcesOrDeltasApart)
+{
+    RequestList requests;
+    requests.Add(StagingA, BufferA, 0, 0, 64)
+        .Add(StagingB, BufferA, 64, 64, 64)      // Other source
+        .Add(StagingA, BufferA, 200, 128, 64)    // Other delta
+        .Add(StagingA, BufferB, 64, 64, 64)      // Other destination
+        .Add(StagingA, BufferA, 0, 0, 64, false, Kind::WholeResource)
+        .Add(StagingA, BufferA, 64, 64, 64, false, Kind::BufferToTexture);
+
+    Planner::Plan plan = BuildPlan(requests.Regions());
+
+    TEST_CHECK(plan.Copies.size() == 6, "Nothing may merge, got ", plan.Copies.size(), " copies");
+
+    // Texture copies of one footprint from the same bytes are redundant
+    RequestList textureRequests;
+    textureRequests.Add(StagingA, BufferA, 0, 0, 256, false, Kind::BufferToTexture)
+        .Add(StagingA, BufferA, 0, 0, 256, false, Kind::BufferToTexture);
+
+    TEST_CHECK(BuildPlan(textureRequests.Regions()).Copies.size() == 1, "Duplicate texture copy must be dropped");
+}
+
+TEST_CASE(LaterRequestsWinForEveryDestination)
+{
+    std::mt19937 random{ 21 };
+
+    // Destination content after planned copies must equal content after executing every request in order
+    for (uint64_t iteration = 0; iteration < 500; ++iteration)
+    {
+        RequestList requests;
+
+        for (uint64_t requestIdx = 0; requestIdx < 1 + random() % 24; ++requestIdx)
+        {
+            const HAL::Resource* source = FakeResource(random() % 2);
+            const HAL::Resource* destination = FakeResource(2 + random() % 4);
+            uint64_t size = 1 + random() % 64;
+            uint64_t sourceOffset = random() % 4 * 16 + random() % 2;
+            uint64_t destinationOffset = random() % 8 == 0 ? random() % (ResourceSize - size) : sourceOffset + random() % 2 * 32;
+            requests.Add(source, destination, sourceOffset, destinationOffset, size);
+        }
+
+        // Planner must not depend on input order, only on sequence numbers
+        std::vector<Planner::CopyRegion> shuffled = requests.Regions();
+        std::shuffle(shuffled.begin(), shuffled.end(), random);
+
+        Planner::Plan plan = BuildPlan(shuffled);
+
+        ResourceContents expected = MakeContents();
+        ResourceContents actual = MakeContents();
+        Apply(requests.Regions(), expected);
+        Apply(plan.Copies, actual);
+
+        TEST_CHECK(expected == actual, "Iteration ", iteration, ": planned copies produce different content");
+        TEST_CHECK(plan.Copies.size() <= requests.Regions().size(), "Plan has more copies than requests");
+    }
+}
+
+TEST_CASE(DeferrableCopiesRespectBudget)
+{
+    RequestList requests;
+    requests.Add(StagingA, BufferA, 0, 0, 100, true)
+        .Add(StagingA, BufferB, 0, 0, 300)              // Not deferrable, always submitted
+        .Add(StagingB, BufferA, 0, 200, 100, true)
+        .Add(StagingB, BufferB, 400, 400, 10, true);    // Would fit, but follows a deferred copy
+
+    Planner::Plan plan = BuildPlan(requests.Regions(), 450);
+
+    TEST_CHECK(plan.SubmittedBytes == 400, "Submitted ", plan.SubmittedBytes, " bytes");
+    TEST_CHECK(plan.Copies.size() == 2 && plan.Deferred.size() == 2, "Expected two submitted and two deferred copies");
+    TEST_CHECK(plan.Deferred[0].Sequence == 2 && plan.Deferred[1].Sequence == 3, "Deferred copies must keep request order");
+
+    // Non deferrable copies exceed budget alone, but one deferrable copy still makes progress
+    RequestList oversized;
+    oversized.Add(StagingA, BufferA, 0, 0, 1000, true)
+        .Add(StagingA, BufferB, 0, 0, 1000)
+        .Add(StagingB, BufferA, 0, 0, 10, true);
+
+    Planner::Plan oversizedPlan = BuildPlan(oversized.Regions(), 100);
+
+    TEST_CHECK(oversizedPlan.Copies.size() == 2 && oversizedPlan.SubmittedBytes == 2000, "One deferrable copy must be submitted per frame");
+    TEST_CHECK(oversizedPlan.Deferred.size() == 1 && oversizedPlan.Deferred[0].Sequence == 2, "The rest must wait");
+
+    // Deferring the first copy would let the undeferrable one overtake it
+    RequestList overtaking;
+    overtaking.Add(StagingA, BufferB, 0, 0, 100, true)
+        .Add(StagingA, BufferA, 0, 0, 100, true)
+        .Add(StagingB, BufferA, 0, 0, 100, true)
+        .Add(StagingB, BufferB, 0, 50, 100);
+
+    Planner::Plan overtakingPlan = BuildPlan(overtaking.Regions(), 0);
+
+    TEST_CHECK(overtakingPlan.Deferred.size() == 1 && overtakingPlan.Deferred[0].Sequence == 2, "Only copy not followed by undeferrable one may wait");
+    TEST_CHECK(overtakingPlan.Copies.size() == 3 && overtakingPlan.SubmittedBytes == 300, "Copy followed by undeferrable one must be submitted");
+}
+
+TEST_CASE(DeferredCopiesGoFirstNextFrame)
+{
+    std::mt19937 random{ 8 };
+    Planner planner;
+    Planner::Plan plan;
+    std::vector<Planner::CopyRegion> pending;
+    uint64_t sequence = 0;
+    uint64_t requestedBytes = 0;
+    uint64_t submittedBytes = 0;
+
+    ResourceContents expected = MakeContents();
+    ResourceContents actual = MakeContents();
+
+    // Same flow as copy request manager: deferred copies are fed back ahead of new requests
+    for (uint64_t frame = 0; frame < 64; ++frame)
+    {
+        for (uint64_t requestIdx = 0; frame < 48 && requestIdx < random() % 8; ++requestIdx)
+        {
+            uint64_t size = 16 + random() % 128;
+            uint64_t offset = random() % (ResourceSize - size);
+            Planner::CopyRegion region{ Kind::BufferRegion, FakeResource(random() % 2), FakeResource(2 + random() % 4), offset, offset, size, random() % 4 != 0, sequence++ };
+
+            pending.push_back(region);
+            requestedBytes += size;
+            Apply({ region }, expected);
+        }
+
+        uint64_t oldestPendingSequence = pending.empty() ? sequence : std::min_element(pending.begin(), pending.end(),
+            [](const Planner::CopyRegion& a, const Planner::CopyRegion& b) { return a.Sequence < b.Sequence; })->Sequence;
+
+        planner.BuildPlan(pending, 256, plan);
+
+        for (const Planner::CopyRegion& deferred : plan.Deferred)
+        {
+            TEST_CHECK(deferred.IsDeferrable, "Copy that can't wait was deferred");
+        }
+
+        if (!pending.empty())
+        {
+            bool isOldestSubmitted = std::any_of(plan.Copies.begin(), plan.Copies.end(),
+                [oldestPendingSequence](const Planner::CopyRegion& copy) { return copy.Sequence == oldestPendingSequence; });
+
+            TEST_CHECK(isOldestSubmitted, "Frame ", frame, ": oldest pending copy was not submitted");
+        }
+
+        for (const Planner::CopyRegion& copy : plan.Copies) submittedBytes += copy.Size;
+
+        Apply(plan.Copies, actual);
+        pending = plan.Deferred;
+    }
+
+    TEST_CHECK(pending.empty(), pending.size(), " copies were never submitted");
+    TEST_CHECK(expected == actual, "Copies spread over frames produce different content");
+    TEST_CHECK(submittedBytes <= requestedBytes, "Merged copies must not copy more than requested");
+}
+
+BENCHMARK(CopyPlannerCopyCount)
+{
+    // Streaming style upload: many small contiguous per-instance and per-meshlet regions
+    // written into a handful of buffers, interleaved with unrelated texture uploads
+    std::mt19937 random{ 4 };
+    RequestList requests;
+    std::vector<uint64_t> bufferCursors(8, 0);
+    uint64_t stagingCursor = 0;
+
+    for (uint64_t requestIdx = 0; requestIdx < 20000; ++requestIdx)
+    {
+        if (random() % 16 == 0)
+        {
+            uint64_t size = 65536;
+            requests.Add(StagingA, FakeResource(100 + requestIdx), stagingCursor, 0, size, true, Kind::BufferToTexture);
+            stagingCursor += size;
+            continue;
+        }
+
+        uint64_t buffer = random() % bufferCursors.size();
+        uint64_t size = 64 * (1 + random() % 4);
+
+        // Runs of writes to one buffer are packed back to back in staging memory
+        for (uint64_t runIdx = 0; runIdx < 1 + random() % 16; ++runIdx)
+        {
+            requests.Add(StagingA, FakeResource(10 + buffer), stagingCursor, bufferCursors[buffer], size, true);
+            stagingCursor += size;
+            bufferCursors[buffer] += size;
+        }
+    }
+
+    Planner planner;
+    Planner::Plan plan;
+
+    double milliseconds = Tests::MeasureBestMilliseconds(10, [&] { planner.BuildPlan(requests.Regions(), ~0ull, plan); });
+
+    Tests::Report(plan.RequestedRegionCount, " requested regions -> ", plan.Copies.size(), " copies (",
+        double(plan.RequestedRegionCount) / plan.Copies.size(), "x fewer), ", milliseconds, " ms per plan");
+}
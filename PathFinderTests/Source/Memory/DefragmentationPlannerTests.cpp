@@ -0,0 +1,219 @@
+#include <TestFramework.hpp>
+
+#include <Memory/DefragmentationPlanner.hpp>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+    using namespace Memory;
+
+    using Planner = DefragmentationPlanner;
+
+    constexpr uint64_t SlotSize = 65536;
+    constexpr uint64_t SlotsPerHeap = 4;
+
+    // Slot 0 is pinned, heap 0 has three free slots, heap 1 is half full and heap 2 holds two movable blocks
+    void MakeFragmentedPool(std::vector<Planner::PoolState>& pools, std::vector<Planner::MovableBlock>& blocks)
+    {
+        Planner::PoolState& pool = pools.emplace_back();
+        pool.SlotSize = SlotSize;
+        pool.SlotCount = 3 * SlotsPerHeap;
+        pool.SlotsPerHeap = SlotsPerHeap;
+        pool.FreeSlots = { 1, 2, 3, 5, 6, 9, 10 };
+
+        uint64_t poolIndex = pools.size() - 1;
+
+        for (uint64_t slot : { 4, 7, 8, 11 })
+        {
+            blocks.push_back({ blocks.size(), poolIndex, slot });
+        }
+    }
+
+    void MakeRandomPools(std::mt19937& random, std::vector<Planner::PoolState>& pools, std::vector<Planner::MovableBlock>& blocks)
+    {
+        for (uint64_t poolIndex = 0; poolIndex < 6; ++poolIndex)
+        {
+            Planner::PoolState& pool = pools.emplace_back();
+            pool.SlotSize = SlotSize << (random() % 4);
+            pool.SlotsPerHeap = 1 + random() % 8;
+            pool.SlotCount = pool.SlotsPerHeap * (1 + random() % 10);
+
+            for (uint64_t slot = 0; slot < pool.SlotCount; ++slot)
+            {
+                switch (random() % 8)
+                {
+                case 0: break; // Immovable
+                case 1: case 2: case 3: case 4: pool.FreeSlots.push_back(slot); break;
+                default: blocks.push_back({ blocks.size(), poolIndex, slot }); break;
+                }
+            }
+        }
+    }
+
+    enum class Occupancy { Free, Immovable, Movable };
+
+    std::vector<std::vector<Occupancy>> Occupancies(const std::vector<Planner::PoolState>& pools, const std::vector<Planner::MovableBlock>& blocks)
+    {
+        std::vector<std::vector<Occupancy>> occupancies;
+
+        for (const Planner::PoolState& pool : pools)
+        {
+            std::vector<Occupancy>& occupancy = occupancies.emplace_back(pool.SlotCount, Occupancy::Immovable);
+
+            for (uint64_t slot : pool.FreeSlots)
+            {
+                occupancy[slot] = Occupancy::Free;
+            }
+        }
+
+        for (const Planner::MovableBlock& block : blocks)
+        {
+            occupancies[block.PoolIndex][block.Slot] = Occupancy::Movable;
+        }
+
+        return occupancies;
+    }
+
+    bool AreMovesEqual(const std::vector<Planner::Move>& a, const std::vector<Planner::Move>& b)
+    {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Planner::Move& first, const Planner::Move& second)
+        {
+            return first.BlockID == second.BlockID && first.PoolIndex == second.PoolIndex &&
+                first.SourceSlot == second.SourceSlot && first.DestinationSlot == second.DestinationSlot;
+        });
+    }
+}
+
+TEST_CASE(EvacuatesTrailingHeapIntoLowerFreeSlots)
+{
+    std::vector<Planner::PoolState> pools;
+    std::vector<Planner::MovableBlock> blocks;
+    MakeFragmentedPool(pools, blocks);
+
+    Planner planner;
+    Planner::Plan plan = planner.BuildPlan(pools, blocks, ~0ull);
+
+    // Heap 1 would need two free slots below it, but there is only one
+    TEST_CHECK(plan.Moves.size() == 2, "Only the last heap can be evacuated, got ", plan.Moves.size(), " moves");
+    TEST_CHECK(plan.ReleasableHeapCount == 1, "Evacuated heap must be releasable");
+    TEST_CHECK(plan.MovedBytes == 2 * SlotSize, "Moved bytes are ", plan.MovedBytes);
+
+    for (const Planner::Move& move : plan.Moves)
+    {
+        TEST_CHECK(move.SourceSlot >= 2 * SlotsPerHeap && move.DestinationSlot < SlotsPerHeap, "Move ", move.SourceSlot, " -> ", move.DestinationSlot, " does not free the last heap");
+    }
+
+    TEST_CHECK(Planner::TrailingFreeHeapCount(pools[0]) == 0, "Pool has no free heaps before defragmentation");
+}
+
+TEST_CASE(BudgetIsOnlySpentOnHeapsThatGetEmpty)
+{
+    std::vector<Planner::PoolState> pools;
+    std::vector<Planner::MovableBlock> blocks;
+    MakeFragmentedPool(pools, blocks);
+
+    Planner planner;
+
+    // Budget runs out halfway through the last heap: moving one block would free nothing
+    Planner::Plan partialPlan = planner.BuildPlan(pools, blocks, SlotSize);
+    TEST_CHECK(partialPlan.Moves.empty() && partialPlan.MovedBytes == 0, "Budget was spent on a heap that stays occupied");
+    TEST_CHECK(partialPlan.ReleasableHeapCount == 0, "Nothing can be released");
+
+    Planner::Plan zeroPlan = planner.BuildPlan(pools, blocks, 0);
+    TEST_CHECK(zeroPlan.Moves.empty(), "Zero budget must not move anything");
+
+    Planner::Plan exactPlan = planner.BuildPlan(pools, blocks, 2 * SlotSize + SlotSize / 2);
+    TEST_CHECK(exactPlan.Moves.size() == 2 && exactPlan.MovedBytes <= 2 * SlotSize + SlotSize / 2, "Budget for exactly one heap must evacuate it");
+}
+
+TEST_CASE(HeapsWithImmovableBlocksAreKept)
+{
+    Planner::PoolState pool;
+    pool.SlotSize = SlotSize;
+    pool.SlotCount = 2 * SlotsPerHeap;
+    pool.SlotsPerHeap = SlotsPerHeap;
+    pool.FreeSlots = { 0, 1, 2, 3, 5, 6 };
+
+    // Slot 7 is pinned, so moving the block from slot 4 would free nothing
+    std::vector<Planner::MovableBlock> blocks{ { 0, 0, 4 } };
+
+    Planner planner;
+    Planner::Plan plan = planner.BuildPlan({ pool }, blocks, ~0ull);
+
+    TEST_CHECK(plan.Moves.empty(), "Heap with immovable allocation must not be evacuated");
+}
+
+TEST_CASE(PlansAreDeterministicAndValid)
+{
+    std::mt19937 random{ 3 };
+
+    for (uint64_t iteration = 0; iteration < 200; ++iteration)
+    {
+        std::vector<Planner::PoolState> pools;
+        std::vector<Planner::MovableBlock> blocks;
+        MakeRandomPools(random, pools, blocks);
+
+        uint64_t budget = SlotSize * (random() % 40);
+
+        Planner planner;
+        Planner::Plan plan = planner.BuildPlan(pools, blocks, budget);
+
+        // Scratch state of a reused planner and input order must not leak into the plan
+        std::vector<Planner::MovableBlock> shuffledBlocks = blocks;
+        std::shuffle(shuffledBlocks.begin(), shuffledBlocks.end(), random);
+
+        TEST_CHECK(AreMovesEqual(plan.Moves, planner.BuildPlan(pools, shuffledBlocks, budget).Moves), "Same input produced a different plan");
+        TEST_CHECK(AreMovesEqual(plan.Moves, Planner{}.BuildPlan(pools, blocks, budget).Moves), "Fresh planner produced a different plan");
+
+        std::vector<std::vector<Occupancy>> occupancies = Occupancies(pools, blocks);
+        std::set<std::pair<uint64_t, uint64_t>> evacuatedHeaps;
+        uint64_t movedBytes = 0;
+
+        for (const Planner::Move& move : plan.Moves)
+        {
+            std::vector<Occupancy>& occupancy = occupancies[move.PoolIndex];
+            const Planner::PoolState& pool = pools[move.PoolIndex];
+
+            TEST_CHECK(blocks[move.BlockID].PoolIndex == move.PoolIndex && blocks[move.BlockID].Slot == move.SourceSlot, "Move does not match its block");
+            TEST_CHECK(occupancy[move.SourceSlot] == Occupancy::Movable, "Block at ", move.SourceSlot, " is moved twice");
+            TEST_CHECK(occupancy[move.DestinationSlot] == Occupancy::Free, "Block is moved onto occupied slot ", move.DestinationSlot);
+            TEST_CHECK(move.DestinationSlot / pool.SlotsPerHeap < move.SourceSlot / pool.SlotsPerHeap, "Block must move to a lower heap");
+
+            occupancy[move.SourceSlot] = Occupancy::Free;
+            occupancy[move.DestinationSlot] = Occupancy::Immovable;
+            evacuatedHeaps.emplace(move.PoolIndex, move.SourceSlot / pool.SlotsPerHeap);
+            movedBytes += pool.SlotSize;
+        }
+
+        TEST_CHECK(movedBytes == plan.MovedBytes && movedBytes <= budget, "Moved ", movedBytes, " bytes with budget of ", budget);
+
+        uint64_t releasableHeapCount = 0;
+
+        for (uint64_t poolIndex = 0; poolIndex < pools.size(); ++poolIndex)
+        {
+            Planner::PoolState compacted = pools[poolIndex];
+            compacted.FreeSlots.clear();
+
+            for (uint64_t slot = 0; slot < compacted.SlotCount; ++slot)
+            {
+                if (occupancies[poolIndex][slot] == Occupancy::Free) compacted.FreeSlots.push_back(slot);
+            }
+
+            releasableHeapCount += Planner::TrailingFreeHeapCount(compacted);
+        }
+
+        TEST_CHECK(releasableHeapCount == plan.ReleasableHeapCount, "Plan reports ", plan.ReleasableHeapCount, " releasable heaps, moves free ", releasableHeapCount);
+
+        for (auto [poolIndex, heap] : evacuatedHeaps)
+        {
+            auto heapBegin = occupancies[poolIndex].begin() + heap * pools[poolIndex].SlotsPerHeap;
+            bool isEmpty = std::all_of(heapBegin, heapBegin + pools[poolIndex].SlotsPerHeap, [](Occupancy occupancy) { return occupancy == Occupancy::Free; });
+
+            TEST_CHECK(isEmpty, "Heap ", heap, " of pool ", poolIndex, " is left partially evacuated");
+        }
+    }
+}
@@ -0,0 +1,188 @@
+#include <TestFramework.hpp>
+
+#include <Memory/MemoryBudgetTracker.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace Memory;
+
+    constexpr uint64_t KB = 1024;
+    constexpr uint64_t MB = 1024 * KB;
+}
+
+TEST_CASE(AccountsHeapsAndAllocations)
+{
+    MemoryBudgetTracker tracker;
+
+    tracker.ReportHeapCreation(MemoryHeapKind::DefaultNonRTDS, 4 * MB);
+    tracker.ReportAllocation(MemoryHeapKind::DefaultNonRTDS, MemoryCategory::SceneTexture, 900 * KB, 1 * MB);
+    tracker.ReportAllocation(MemoryHeapKind::DefaultNonRTDS, MemoryCategory::SceneTexture, 1 * MB, 1 * MB);
+
+    MemoryBudgetTracker::Snapshot snapshot = tracker.CurrentSnapshot();
+    const MemoryBudgetTracker::HeapStatistics& heap = snapshot.Heap(MemoryHeapKind::DefaultNonRTDS);
+
+    TEST_CHECK(heap.ReservedBytes == 4 * MB, "Heap reservation is not accounted");
+    TEST_CHECK(heap.UsedBytes == 2 * MB, "Used bytes must include size rounding, got ", heap.UsedBytes);
+    TEST_CHECK(heap.WastedBytes == 124 * KB, "Rounding waste is ", heap.WastedBytes);
+    TEST_CHECK(heap.AllocationCount == 2 && heap.HeapCount == 1, "Counters are off");
+    TEST_CHECK(heap.Fragmentation() == 0.5f, "Half of the heap is free, fragmentation is ", heap.Fragmentation());
+    TEST_CHECK(snapshot.Category(MemoryCategory::SceneTexture).CurrentBytes == 900 * KB + 1 * MB, "Categories count requested bytes");
+
+    tracker.ReportDeallocation(MemoryHeapKind::DefaultNonRTDS, MemoryCategory::SceneTexture, 900 * KB, 1 * MB);
+    snapshot = tracker.CurrentSnapshot();
+
+    TEST_CHECK(snapshot.Heap(MemoryHeapKind::DefaultNonRTDS).UsedBytes == 1 * MB, "Deallocation is not accounted");
+    TEST_CHECK(snapshot.Heap(MemoryHeapKind::DefaultNonRTDS).WastedBytes == 0, "Waste of deallocated resource remained");
+    TEST_CHECK(snapshot.Heap(MemoryHeapKind::DefaultNonRTDS).PeakUsedBytes == 2 * MB, "Peak must survive deallocation");
+    TEST_CHECK(snapshot.Category(MemoryCategory::SceneTexture).PeakBytes == 900 * KB + 1 * MB, "Category peak must survive deallocation");
+
+    tracker.ResetPeaks();
+    snapshot = tracker.CurrentSnapshot();
+
+    TEST_CHECK(snapshot.Heap(MemoryHeapKind::DefaultNonRTDS).PeakUsedBytes == 1 * MB, "Peaks must drop to current values");
+}
+
+TEST_CASE(SeparatesLocalAndSystemMemory)
+{
+    MemoryBudgetTracker tracker;
+
+    tracker.ReportHeapCreation(MemoryHeapKind::Upload, 8 * MB);
+    tracker.ReportHeapCreation(MemoryHeapKind::Readback, 2 * MB);
+    tracker.ReportHeapCreation(MemoryHeapKind::Descriptor, 1 * MB);
+    tracker.ReportHeapCreation(MemoryHeapKind::DefaultRTDS, 16 * MB);
+
+    MemoryBudgetTracker::Snapshot snapshot = tracker.CurrentSnapshot();
+
+    TEST_CHECK(snapshot.TotalReservedBytes == 27 * MB, "All heaps count towards total reservation");
+    TEST_CHECK(snapshot.LocalReservedBytes == 16 * MB, "Only video memory heaps count towards local reservation, got ", snapshot.LocalReservedBytes);
+}
+
+TEST_CASE(ReplacesTransientMemoryReports)
+{
+    MemoryBudgetTracker tracker;
+
+    tracker.ReportTransientMemory(2, 64 * MB, 10, 96 * MB);
+    tracker.ReportTransientMemory(1, 32 * MB, 4, 40 * MB);
+
+    MemoryBudgetTracker::Snapshot snapshot = tracker.CurrentSnapshot();
+    const MemoryBudgetTracker::HeapStatistics& heap = snapshot.Heap(MemoryHeapKind::TransientAliased);
+    const MemoryBudgetTracker::CategoryStatistics& category = snapshot.Category(MemoryCategory::TransientRenderTarget);
+
+    TEST_CHECK(heap.ReservedBytes == 32 * MB && heap.HeapCount == 1, "Transient heaps must be replaced, not accumulated");
+    TEST_CHECK(heap.PeakReservedBytes == 64 * MB, "Transient peak is lost");
+    TEST_CHECK(category.CurrentBytes == 40 * MB && category.AllocationCount == 4, "Transient resources must be replaced, not accumulated");
+    TEST_CHECK(snapshot.AliasedBytes == 8 * MB, "Aliasing saved 8 MB, reported ", snapshot.AliasedBytes);
+}
+
+TEST_CASE(NotifiesOnceWhenBudgetIsExceeded)
+{
+    MemoryBudgetTracker tracker;
+    tracker.SetBudget(10 * MB);
+
+    uint64_t notificationCount = 0;
+    uint64_t notifiedLocalBytes = 0;
+
+    tracker.SetOverBudgetCallback([&](const MemoryBudgetTracker::Snapshot& snapshot)
+    {
+        ++notificationCount;
+        notifiedLocalBytes = snapshot.LocalReservedBytes;
+
+        // Callbacks are invoked outside of the tracker lock and are free to query it
+        TEST_CHECK(tracker.IsOverBudget(), "Tracker must be over budget inside the callback");
+    });
+
+    tracker.ReportHeapCreation(MemoryHeapKind::DefaultNonRTDS, 8 * MB);
+    TEST_CHECK(notificationCount == 0 && !tracker.IsOverBudget(), "Budget is not exceeded yet");
+
+    // System memory does not count towards the budget
+    tracker.ReportHeapCreation(MemoryHeapKind::Upload, 8 * MB);
+    TEST_CHECK(notificationCount == 0, "Upload heaps must not trigger budget notification");
+
+    tracker.ReportHeapCreation(MemoryHeapKind::DefaultNonRTDS, 4 * MB);
+    tracker.ReportHeapCreation(MemoryHeapKind::DefaultNonRTDS, 4 * MB);
+
+    TEST_CHECK(notificationCount == 1, "Callback must fire once per excess, fired ", notificationCount, " times");
+    TEST_CHECK(notifiedLocalBytes == 12 * MB, "Snapshot must be taken at the moment budget is exceeded");
+
+    tracker.ReportHeapDestruction(MemoryHeapKind::DefaultNonRTDS, 4 * MB);
+    tracker.ReportHeapDestruction(MemoryHeapKind::DefaultNonRTDS, 4 * MB);
+    TEST_CHECK(!tracker.IsOverBudget(), "Tracker must leave over budget state");
+
+    tracker.SetBudget(4 * MB);
+    TEST_CHECK(notificationCount == 2, "Callback must be rearmed after going back under budget");
+}
+
+TEST_CASE(CapturesPreviousFrameSnapshot)
+{
+    MemoryBudgetTracker tracker;
+
+    tracker.BeginFrame(1);
+    tracker.ReportHeapCreation(MemoryHeapKind::DefaultRTDS, 2 * MB);
+    tracker.BeginFrame(2);
+    tracker.ReportHeapCreation(MemoryHeapKind::DefaultRTDS, 2 * MB);
+
+    MemoryBudgetTracker::Snapshot snapshot = tracker.LastFrameSnapshot();
+
+    TEST_CHECK(snapshot.FrameNumber == 1, "Snapshot must belong to the previous frame");
+    TEST_CHECK(snapshot.TotalReservedBytes == 2 * MB, "Snapshot must not see memory of the current frame");
+}
+
+TEST_CASE(AccumulatesReportsFromConcurrentThreads)
+{
+    MemoryBudgetTracker tracker;
+    tracker.SetBudget(1 * MB);
+
+    uint64_t notificationCount = 0;
+    tracker.SetOverBudgetCallback([&](const MemoryBudgetTracker::Snapshot&) { ++notificationCount; });
+
+    const uint64_t threadCount = 8;
+    const uint64_t iterationCount = 20000;
+    std::vector<std::thread> threads;
+
+    for (uint64_t threadIdx = 0; threadIdx < threadCount; ++threadIdx)
+    {
+        threads.emplace_back([&tracker, threadIdx]
+        {
+            MemoryCategory category = threadIdx % 2 ? MemoryCategory::Upload : MemoryCategory::Other;
+
+            for (uint64_t iteration = 0; iteration < iterationCount; ++iteration)
+            {
+                tracker.ReportAllocation(MemoryHeapKind::DefaultUniversalOrBuffer, category, 200, 256);
+
+                // Keep a part of allocations alive, release the rest
+                if (iteration % 4)
+                {
+                    tracker.ReportDeallocation(MemoryHeapKind::DefaultUniversalOrBuffer, category, 200, 256);
+                }
+
+                if (iteration % 1000 == 0)
+                {
+                    tracker.ReportHeapCreation(MemoryHeapKind::DefaultUniversalOrBuffer, 64 * KB);
+                    tracker.CurrentSnapshot();
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    MemoryBudgetTracker::Snapshot snapshot = tracker.CurrentSnapshot();
+    const MemoryBudgetTracker::HeapStatistics& heap = snapshot.Heap(MemoryHeapKind::DefaultUniversalOrBuffer);
+    uint64_t liveAllocationCount = threadCount * iterationCount / 4;
+
+    TEST_CHECK(heap.AllocationCount == liveAllocationCount, "Lost allocation reports: ", heap.AllocationCount, " of ", liveAllocationCount);
+    TEST_CHECK(heap.UsedBytes == liveAllocationCount * 256, "Lost used bytes");
+    TEST_CHECK(heap.WastedBytes == liveAllocationCount * 56, "Lost wasted bytes");
+    TEST_CHECK(heap.HeapCount == threadCount * iterationCount / 1000, "Lost heap reports");
+    TEST_CHECK(heap.ReservedBytes == threadCount * iterationCount / 1000 * 64 * KB, "Lost heap bytes");
+    TEST_CHECK(notificationCount == 1, "Budget must be reported exceeded exactly once, reported ", notificationCount, " times");
+
+    uint64_t categoryBytes = snapshot.Category(MemoryCategory::Upload).CurrentBytes + snapshot.Category(MemoryCategory::Other).CurrentBytes;
+    TEST_CHECK(categoryBytes == liveAllocationCount * 200, "Lost category bytes");
+}
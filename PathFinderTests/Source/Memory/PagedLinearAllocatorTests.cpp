@@ -0,0 +1,150 @@
+#include <TestFramework.hpp>
+
+#include <Memory/PagedLinearAllocator.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace Memory;
+
+    constexpr uint64_t PageSize = 64 * 1024;
+    constexpr uint64_t ThreadCount = 8;
+
+    struct RecordedRange
+    {
+        uint64_t Start = 0;
+        uint64_t Size = 0;
+        uint64_t Alignment = 0;
+        uint64_t OffsetInPage = 0;
+    };
+
+    struct ThreadResult
+    {
+        std::vector<RecordedRange> Ranges;
+        uint64_t FailureCount = 0;
+    };
+
+    // Every thread allocates until it fails a few times in a row, sizes and alignments vary like constant buffers and small uploads do
+    std::vector<ThreadResult> AllocateConcurrently(PagedLinearAllocator& allocator)
+    {
+        std::vector<ThreadResult> results(ThreadCount);
+        std::vector<std::thread> threads;
+        std::atomic<bool> start{ false };
+
+        for (uint64_t threadIdx = 0; threadIdx < ThreadCount; ++threadIdx)
+        {
+            threads.emplace_back([&allocator, &start, &result = results[threadIdx], threadIdx]
+            {
+                std::mt19937 random{ uint32_t(threadIdx + 1) };
+
+                while (!start.load()) { std::this_thread::yield(); }
+
+                while (result.FailureCount < 16)
+                {
+                    uint64_t size = random() % 8 == 0 ? 1 + random() % PageSize : 1 + random() % 2048;
+                    uint64_t alignment = 1ull << (random() % 13);
+
+                    std::optional<PagedLinearAllocator::Range> range = allocator.Allocate(size, alignment);
+
+                    if (range)
+                    {
+                        result.Ranges.push_back({ range->PageIndex * PageSize + range->OffsetInPage, size, alignment, range->OffsetInPage });
+                    }
+                    else
+                    {
+                        ++result.FailureCount;
+                    }
+                }
+            });
+        }
+
+        start.store(true);
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        return results;
+    }
+}
+
+TEST_CASE(ConcurrentRangesAreDisjointAlignedAndWithinPages)
+{
+    const uint64_t pageCount = 32;
+
+    PagedLinearAllocator allocator{ PageSize };
+    allocator.SetPageCount(pageCount);
+
+    // Frame memory is reused after reset, second round must behave as the first one
+    for (uint64_t round = 0; round < 3; ++round)
+    {
+        allocator.Reset();
+
+        std::vector<ThreadResult> results = AllocateConcurrently(allocator);
+        std::vector<RecordedRange> ranges;
+
+        for (const ThreadResult& result : results)
+        {
+            ranges.insert(ranges.end(), result.Ranges.begin(), result.Ranges.end());
+        }
+
+        TEST_CHECK(!ranges.empty(), "Nothing was allocated");
+
+        std::sort(ranges.begin(), ranges.end(), [](const RecordedRange& a, const RecordedRange& b) { return a.Start < b.Start; });
+
+        for (uint64_t rangeIdx = 0; rangeIdx < ranges.size(); ++rangeIdx)
+        {
+            const RecordedRange& range = ranges[rangeIdx];
+
+            TEST_CHECK(range.Start % range.Alignment == 0, "Range at ", range.Start, " is not aligned to ", range.Alignment);
+            TEST_CHECK(range.OffsetInPage + range.Size <= PageSize, "Range at ", range.Start, " of ", range.Size, " bytes straddles pages");
+            TEST_CHECK(range.Start + range.Size <= pageCount * PageSize, "Range at ", range.Start, " is outside of available pages");
+
+            if (rangeIdx > 0)
+            {
+                const RecordedRange& previous = ranges[rangeIdx - 1];
+                TEST_CHECK(previous.Start + previous.Size <= range.Start, "Ranges at ", previous.Start, " and ", range.Start, " overlap");
+            }
+        }
+
+        TEST_CHECK(allocator.UsedBytes() >= ranges.back().Start + ranges.back().Size, "Used bytes are behind allocated ranges");
+        TEST_CHECK(allocator.RequestedPageCount() > pageCount, "Failed allocations must request more pages, requested ", allocator.RequestedPageCount());
+    }
+}
+
+TEST_CASE(ExhaustedPagesFailAndRequestMore)
+{
+    PagedLinearAllocator allocator{ PageSize };
+
+    TEST_CHECK(!allocator.Allocate(16, 16), "Allocator without pages must fail");
+    TEST_CHECK(allocator.RequestedPageCount() == 1, "First allocation needs one page");
+
+    allocator.SetPageCount(2);
+
+    std::optional<PagedLinearAllocator::Range> first = allocator.Allocate(PageSize - 100, 256);
+    TEST_CHECK(first && first->PageIndex == 0 && first->OffsetInPage == 0, "First range must start the first page");
+
+    // Doesn't fit into the rest of the first page
+    std::optional<PagedLinearAllocator::Range> second = allocator.Allocate(200, 4);
+    TEST_CHECK(second && second->PageIndex == 1 && second->OffsetInPage == 0, "Range must skip to the next page instead of straddling");
+
+    std::optional<PagedLinearAllocator::Range> third = allocator.Allocate(300, 256);
+    TEST_CHECK(third && third->PageIndex == 1 && third->OffsetInPage == 256, "Range must be aligned inside of the page");
+
+    TEST_CHECK(!allocator.Allocate(PageSize, 256), "Full page range must not fit into a started page");
+    TEST_CHECK(allocator.RequestedPageCount() == 3, "Failed range needs a third page, requested ", allocator.RequestedPageCount());
+
+    // Failures don't move the cursor, smaller ranges still fit
+    TEST_CHECK(allocator.Allocate(16, 16), "Failed allocation must not consume memory");
+    TEST_CHECK(!allocator.Allocate(0, 16) && !allocator.Allocate(PageSize + 1, 16), "Empty and oversized ranges are never served");
+
+    allocator.Reset();
+    TEST_CHECK(allocator.UsedBytes() == 0 && allocator.RequestedPageCount() == 0, "Reset must rewind the cursor and forget requests");
+    TEST_CHECK(allocator.Allocate(PageSize, 256), "Full page range must fit after reset");
+}
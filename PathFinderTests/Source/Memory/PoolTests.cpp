@@ -0,0 +1,246 @@
+#include <TestFramework.hpp>
+
+#include <Memory/Pool.hpp>
+
+#include <algorithm>
+#include <list>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Memory;
+
+    using TestPool = Pool<int>;
+
+    constexpr uint64_t SlotSize = 256;
+    constexpr uint64_t GrowSlotCount = 8;
+
+    // Behaviour of the std::list based pool the intrusive one replaced:
+    // FIFO reuse of freed slots, growth appends slots at the end in offset order
+    class ReferencePool
+    {
+    public:
+        TestPool::SlotType Allocate()
+        {
+            if (mFreeSlots.empty())
+            {
+                for (uint64_t slot = 0; slot < GrowSlotCount; ++slot)
+                {
+                    mFreeSlots.push_back(TestPool::SlotType{ mSlotCount++ * SlotSize });
+                }
+            }
+
+            TestPool::SlotType slot = mFreeSlots.front();
+            mFreeSlots.pop_front();
+            return slot;
+        }
+
+        void Deallocate(const TestPool::SlotType& slot)
+        {
+            mFreeSlots.push_back(slot);
+        }
+
+        std::optional<TestPool::SlotType> Allocate(uint64_t memoryOffset)
+        {
+            auto it = std::find_if(mFreeSlots.begin(), mFreeSlots.end(), [memoryOffset](const TestPool::SlotType& slot) { return slot.MemoryOffset == memoryOffset; });
+
+            if (it == mFreeSlots.end())
+            {
+                return std::nullopt;
+            }
+
+            TestPool::SlotType slot = *it;
+            mFreeSlots.erase(it);
+            return slot;
+        }
+
+        uint64_t ReleaseTrailingFreeSlots(uint64_t slotsPerGroup)
+        {
+            uint64_t releasedGroupCount = 0;
+
+            while (mSlotCount >= slotsPerGroup)
+            {
+                uint64_t groupStart = (mSlotCount - slotsPerGroup) * SlotSize;
+                auto isInGroup = [groupStart](const TestPool::SlotType& slot) { return slot.MemoryOffset >= groupStart; };
+
+                if (uint64_t(std::count_if(mFreeSlots.begin(), mFreeSlots.end(), isInGroup)) != slotsPerGroup)
+                {
+                    break;
+                }
+
+                mFreeSlots.remove_if(isInGroup);
+                mSlotCount -= slotsPerGroup;
+                ++releasedGroupCount;
+            }
+
+            return releasedGroupCount;
+        }
+
+        const std::list<TestPool::SlotType>& FreeSlots() const { return mFreeSlots; }
+        uint64_t SlotCount() const { return mSlotCount; }
+
+    private:
+        std::list<TestPool::SlotType> mFreeSlots;
+        uint64_t mSlotCount = 0;
+    };
+
+    bool AreFreeListsEqual(const TestPool& pool, const ReferencePool& reference)
+    {
+        std::vector<TestPool::SlotType> freeSlots;
+        pool.ForEachFreeSlot([&freeSlots](const TestPool::SlotType& slot) { freeSlots.push_back(slot); });
+
+        return std::equal(freeSlots.begin(), freeSlots.end(), reference.FreeSlots().begin(), reference.FreeSlots().end(),
+            [](const TestPool::SlotType& a, const TestPool::SlotType& b) { return a.MemoryOffset == b.MemoryOffset && a.UserData == b.UserData; });
+    }
+}
+
+TEST_CASE(MatchesListBasedReferenceModel)
+{
+    std::mt19937 random{ 5 };
+    TestPool pool{ SlotSize, GrowSlotCount };
+    ReferencePool reference;
+    std::vector<TestPool::SlotType> allocated;
+
+    for (uint64_t iteration = 0; iteration < 50000; ++iteration)
+    {
+        uint64_t operation = random() % 16;
+
+        if (operation < 7 || allocated.empty())
+        {
+            TestPool::SlotType slot = pool.Allocate();
+            TestPool::SlotType expected = reference.Allocate();
+
+            TEST_CHECK(slot.MemoryOffset == expected.MemoryOffset && slot.UserData == expected.UserData,
+                "Iteration ", iteration, ": allocated ", slot.MemoryOffset, ", reference allocated ", expected.MemoryOffset);
+
+            // User data must travel with the slot through deallocation
+            slot.UserData = int(iteration);
+            allocated.push_back(slot);
+        }
+        else if (operation < 14)
+        {
+            uint64_t index = random() % allocated.size();
+            pool.Deallocate(allocated[index]);
+            reference.Deallocate(allocated[index]);
+            allocated[index] = allocated.back();
+            allocated.pop_back();
+        }
+        else if (operation < 15)
+        {
+            // Mostly aligned offsets around pool end, some of them misaligned
+            uint64_t offset = (random() % (pool.SlotCount() + 2)) * SlotSize + (random() % 8 == 0 ? 1 : 0);
+            std::optional<TestPool::SlotType> slot = pool.Allocate(offset);
+            std::optional<TestPool::SlotType> expected = reference.Allocate(offset);
+
+            TEST_CHECK(slot.has_value() == expected.has_value(), "Targeted allocation of ", offset, " disagrees with reference");
+
+            if (slot)
+            {
+                TEST_CHECK(slot->MemoryOffset == offset && slot->UserData == expected->UserData, "Targeted allocation returned wrong slot");
+                allocated.push_back(*slot);
+            }
+        }
+        else
+        {
+            uint64_t slotsPerGroup = GrowSlotCount * (1 + random() % 2);
+            TEST_CHECK(pool.ReleaseTrailingFreeSlots(slotsPerGroup) == reference.ReleaseTrailingFreeSlots(slotsPerGroup), "Released group count disagrees with reference");
+        }
+
+        TEST_CHECK(pool.SlotCount() == reference.SlotCount(), "Iteration ", iteration, ": slot count ", pool.SlotCount(), ", reference ", reference.SlotCount());
+        TEST_CHECK(pool.FreeSlotCount() == reference.FreeSlots().size(), "Iteration ", iteration, ": free slot count disagrees with reference");
+
+        if (iteration % 64 == 0)
+        {
+            TEST_CHECK(AreFreeListsEqual(pool, reference), "Iteration ", iteration, ": free slot order disagrees with reference");
+        }
+    }
+
+    TEST_CHECK(pool.Stats().AllocatedSlotCount == allocated.size(), "Allocated slot statistics are off");
+}
+
+TEST_CASE(TargetedAllocationTakesOnlyFreeSlots)
+{
+    TestPool pool{ SlotSize, GrowSlotCount };
+    TestPool::SlotType first = pool.Allocate();
+
+    TEST_CHECK(!pool.Allocate(first.MemoryOffset), "Occupied slot must not be handed out");
+    TEST_CHECK(!pool.Allocate(3 * SlotSize + 1), "Misaligned offset must not be handed out");
+    TEST_CHECK(!pool.Allocate(GrowSlotCount * SlotSize), "Targeted allocation must not grow the pool");
+
+    std::optional<TestPool::SlotType> taken = pool.Allocate(5 * SlotSize);
+    TEST_CHECK(taken && taken->MemoryOffset == 5 * SlotSize && !pool.IsFree(5 * SlotSize), "Free slot must be taken");
+
+    // Taken slot is unlinked from the middle of the free list, the rest keeps its order
+    for (uint64_t expectedSlot : { 1, 2, 3, 4, 6, 7 })
+    {
+        TEST_CHECK(pool.Allocate().MemoryOffset == expectedSlot * SlotSize, "Free list order broke after targeted allocation");
+    }
+
+    TEST_CHECK(pool.Stats().AllocatedSlotCount == GrowSlotCount && pool.Stats().GrowCount == 1, "Statistics are off");
+}
+
+TEST_CASE(ReleasesOnlyFullyFreeTrailingGroups)
+{
+    TestPool pool{ SlotSize, GrowSlotCount };
+    std::vector<TestPool::SlotType> slots;
+
+    for (uint64_t slot = 0; slot < 3 * GrowSlotCount; ++slot)
+    {
+        slots.push_back(pool.Allocate());
+    }
+
+    // Last group is free, second one has a single allocation left
+    for (uint64_t slot = GrowSlotCount; slot < 3 * GrowSlotCount; ++slot)
+    {
+        if (slot != GrowSlotCount + 3) pool.Deallocate(slots[slot]);
+    }
+
+    TEST_CHECK(pool.ReleaseTrailingFreeSlots(GrowSlotCount) == 1 && pool.SlotCount() == 2 * GrowSlotCount, "Only the last group must be released");
+    TEST_CHECK(pool.FreeSlotCount() == GrowSlotCount - 1, "Released slots must leave the free list");
+
+    pool.Deallocate(slots[GrowSlotCount + 3]);
+
+    TEST_CHECK(pool.ReleaseTrailingFreeSlots(GrowSlotCount) == 1 && pool.SlotCount() == GrowSlotCount, "Emptied group must be released");
+    TEST_CHECK(pool.ReleaseTrailingFreeSlots(GrowSlotCount) == 0, "Group with allocations must stay");
+
+    // Growth after release continues right after remaining slots
+    for (uint64_t slot = 0; slot < GrowSlotCount; ++slot)
+    {
+        TEST_CHECK(pool.Allocate().MemoryOffset == (GrowSlotCount + slot) * SlotSize, "Pool must grow from its current end");
+    }
+}
+
+BENCHMARK(PoolAllocateDeallocate)
+{
+    const uint64_t liveSlotCount = 4096;
+    const uint64_t operationCount = 1000000;
+
+    auto run = [&](auto& pool)
+    {
+        std::mt19937 random{ 9 };
+        std::vector<TestPool::SlotType> allocated;
+
+        for (uint64_t slot = 0; slot < liveSlotCount; ++slot)
+        {
+            allocated.push_back(pool.Allocate());
+        }
+
+        // Steady state churn of a frame: free a random slot, allocate a new one
+        for (uint64_t operation = 0; operation < operationCount; ++operation)
+        {
+            uint64_t index = random() % liveSlotCount;
+            pool.Deallocate(allocated[index]);
+            allocated[index] = pool.Allocate();
+        }
+
+        return allocated.size();
+    };
+
+    double poolMS = Tests::MeasureBestMilliseconds(5, [&] { TestPool pool{ SlotSize, GrowSlotCount }; run(pool); });
+    double referenceMS = Tests::MeasureBestMilliseconds(5, [&] { ReferencePool pool; run(pool); });
+
+    Tests::Report("Intrusive free list: ", poolMS * 1e6 / (2 * operationCount), " ns per operation");
+    Tests::Report("std::list free list: ", referenceMS * 1e6 / (2 * operationCount), " ns per operation");
+}
@@ -0,0 +1,123 @@
+#include <TestFramework.hpp>
+
+#include <Memory/SegregatedPools.hpp>
+
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+    using namespace Memory;
+
+    using TestPools = SegregatedPools<int, int>;
+
+    // Mirrors how resource allocator configures its pools
+    constexpr uint64_t MinimumSlotSize = 65536;
+    constexpr uint64_t SubBucketCount = 4;
+}
+
+TEST_CASE(BucketsStartAtMinimumSlotSize)
+{
+    TestPools pools{ MinimumSlotSize, 1, SubBucketCount };
+
+    TestPools::Allocation small = pools.Allocate(1);
+    TestPools::Allocation exact = pools.Allocate(MinimumSlotSize);
+    TestPools::Allocation next = pools.Allocate(MinimumSlotSize + 1);
+
+    TEST_CHECK(small.BucketIndex == 0 && exact.BucketIndex == 0, "Allocations up to minimum slot size belong to the first bucket");
+    TEST_CHECK(pools.SlotSizeInBucket(0) == MinimumSlotSize, "First bucket slot size is ", pools.SlotSizeInBucket(0));
+    TEST_CHECK(pools.SlotSizeInBucket(next.BucketIndex) == 2 * MinimumSlotSize, "Second bucket must hold two minimum slots");
+}
+
+TEST_CASE(AllocationsOfBucketDoNotOverlap)
+{
+    TestPools pools{ MinimumSlotSize, 4, SubBucketCount };
+    std::mt19937 random{ 7 };
+    std::uniform_int_distribution<uint64_t> sizeDistribution{ 1, 40 * MinimumSlotSize };
+    std::vector<TestPools::Allocation> allocations;
+
+    for (uint64_t iteration = 0; iteration < 4000; ++iteration)
+    {
+        if (!allocations.empty() && random() % 3 == 0)
+        {
+            uint64_t index = random() % allocations.size();
+            pools.Deallocate(allocations[index]);
+            allocations[index] = allocations.back();
+            allocations.pop_back();
+        }
+        else
+        {
+            uint64_t size = sizeDistribution(random);
+            TestPools::Allocation allocation = pools.Allocate(size);
+            uint64_t slotSize = pools.SlotSizeInBucket(allocation.BucketIndex);
+
+            TEST_CHECK(slotSize >= size, "Slot of ", slotSize, " bytes is too small for ", size);
+            TEST_CHECK(allocation.Slot.MemoryOffset % slotSize == 0, "Slot offset is not slot aligned");
+
+            allocations.push_back(allocation);
+        }
+    }
+
+    std::set<std::pair<uint64_t, uint64_t>> occupiedSlots;
+
+    for (const TestPools::Allocation& allocation : allocations)
+    {
+        bool isUnique = occupiedSlots.emplace(allocation.BucketIndex, allocation.Slot.MemoryOffset).second;
+        TEST_CHECK(isUnique, "Slot at ", allocation.Slot.MemoryOffset, " of bucket ", allocation.BucketIndex, " is handed out twice");
+    }
+}
+
+TEST_CASE(BucketStatisticsTrackRoundingWaste)
+{
+    TestPools pools{ MinimumSlotSize, 1, SubBucketCount };
+
+    TestPools::Allocation first = pools.Allocate(5 * MinimumSlotSize - 100);
+    TestPools::Allocation second = pools.Allocate(5 * MinimumSlotSize);
+
+    TEST_CHECK(first.BucketIndex == second.BucketIndex, "Both allocations belong to the 5 slot size class");
+
+    const SegregatedPoolsBucketStatistics& stats = pools.GetBucket(first.BucketIndex).Stats();
+
+    TEST_CHECK(stats.AllocationCount == 2, "Allocation count is ", stats.AllocationCount);
+    TEST_CHECK(stats.RequestedBytes == 10 * MinimumSlotSize - 100, "Requested bytes are ", stats.RequestedBytes);
+    TEST_CHECK(stats.WastedBytes == 100, "Wasted bytes are ", stats.WastedBytes);
+
+    pools.Deallocate(first);
+
+    TEST_CHECK(stats.WastedBytes == 0 && stats.AllocationCount == 1, "Deallocation must release its waste");
+    TEST_CHECK(stats.PeakWastedBytes == 100, "Peak waste must survive deallocation");
+}
+
+TEST_CASE(FreedSlotsAreReused)
+{
+    TestPools pools{ MinimumSlotSize, 2, SubBucketCount };
+
+    TestPools::Allocation first = pools.Allocate(MinimumSlotSize);
+    first.Slot.UserData = 42;
+    pools.Allocate(MinimumSlotSize);
+    pools.Deallocate(first);
+
+    TestPools::Allocation reused = pools.Allocate(MinimumSlotSize);
+
+    TEST_CHECK(reused.Slot.MemoryOffset == first.Slot.MemoryOffset, "Freed slot must be reused before the pool grows");
+    TEST_CHECK(pools.GetBucket(0).Slots().SlotCount() == 2, "Pool must not grow while it has free slots");
+}
+
+TEST_CASE(RelocationTakesRequestedSlot)
+{
+    TestPools pools{ MinimumSlotSize, 4, SubBucketCount };
+
+    TestPools::Allocation occupied = pools.Allocate(MinimumSlotSize);
+    std::optional<TestPools::Allocation> taken = pools.AllocateInBucket(0, 3 * MinimumSlotSize, 1000);
+    std::optional<TestPools::Allocation> busy = pools.AllocateInBucket(0, occupied.Slot.MemoryOffset, 1000);
+
+    TEST_CHECK(taken && taken->Slot.MemoryOffset == 3 * MinimumSlotSize, "Free slot at a particular offset must be taken");
+    TEST_CHECK(!busy, "Occupied slot must not be handed out");
+
+    pools.Deallocate(*taken);
+    pools.Deallocate(occupied);
+
+    TEST_CHECK(pools.ReleaseTrailingFreeSlots(0, 4) == 1, "Fully free slot group must be released");
+    TEST_CHECK(pools.GetBucket(0).Slots().SlotCount() == 0, "Pool must be empty after release");
+}
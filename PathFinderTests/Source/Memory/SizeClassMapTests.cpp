@@ -0,0 +1,238 @@
+#include <TestFramework.hpp>
+
+#include <Memory/SizeClassMap.hpp>
+#include <Memory/SegregatedPools.hpp>
+
+#include <cmath>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Memory;
+
+    constexpr uint64_t KB = 1024;
+    constexpr uint64_t MB = 1024 * KB;
+
+    // Mirrors how resource allocator configures its pools
+    constexpr uint64_t MinimumSlotSize = 64 * KB;
+
+    struct TraceEvent
+    {
+        uint64_t Size = 0;
+        // Index of a live allocation to release instead of allocating
+        std::optional<uint64_t> ReleasedAllocation;
+    };
+
+    struct TraceReplayResult
+    {
+        uint64_t RequestedBytes = 0;
+        uint64_t WastedBytes = 0;
+        uint64_t PeakWastedBytes = 0;
+        uint64_t ReservedBytes = 0;
+        uint64_t BucketCount = 0;
+    };
+
+    // Resource sizes of a streaming scene: block compressed and uncompressed textures with mip chains,
+    // render targets at common resolutions and buffers spread over several orders of magnitude.
+    // About a third of allocations are released again at random to mimic streaming and resizes.
+    std::vector<TraceEvent> MakeResourceTrace()
+    {
+        std::mt19937 random{ 17 };
+        std::vector<TraceEvent> trace;
+        uint64_t liveCount = 0;
+
+        auto withMips = [](uint64_t size) { return size * 4 / 3; };
+
+        for (uint64_t eventIdx = 0; eventIdx < 20000; ++eventIdx)
+        {
+            if (liveCount > 0 && random() % 3 == 0)
+            {
+                trace.push_back({ 0, random() % liveCount });
+                --liveCount;
+                continue;
+            }
+
+            uint64_t size = 0;
+
+            switch (random() % 4)
+            {
+            case 0: // Compressed texture, 1 byte per texel
+            {
+                uint64_t dimension = 64ull << (random() % 7);
+                size = withMips(dimension * dimension);
+                break;
+            }
+            case 1: // Uncompressed texture with non-square aspect
+            {
+                uint64_t width = 64ull << (random() % 6);
+                uint64_t height = 64ull << (random() % 6);
+                size = withMips(width * height * 4);
+                break;
+            }
+            case 2: // Render target
+            {
+                const uint64_t resolutions[][2] = { { 1920, 1080 }, { 1280, 720 }, { 2560, 1440 }, { 960, 540 } };
+                const uint64_t texelSizes[] = { 4, 8, 16 };
+                const uint64_t* resolution = resolutions[random() % 4];
+                size = resolution[0] * resolution[1] * texelSizes[random() % 3];
+                break;
+            }
+            default: // Buffer, log-uniform between 1 KB and 32 MB
+            {
+                std::uniform_real_distribution<double> exponent{ 10.0, 25.0 };
+                size = uint64_t(std::pow(2.0, exponent(random))) / 256 * 256 + 256;
+                break;
+            }
+            }
+
+            trace.push_back({ size, std::nullopt });
+            ++liveCount;
+        }
+
+        return trace;
+    }
+
+    TraceReplayResult ReplayTrace(const std::vector<TraceEvent>& trace, uint64_t subClassCount)
+    {
+        using TestPools = SegregatedPools<int, int>;
+
+        TestPools pools{ MinimumSlotSize, 1, subClassCount };
+        std::vector<TestPools::Allocation> allocations;
+        TraceReplayResult result{};
+
+        for (const TraceEvent& event : trace)
+        {
+            if (event.ReleasedAllocation)
+            {
+                pools.Deallocate(allocations[*event.ReleasedAllocation]);
+                allocations[*event.ReleasedAllocation] = allocations.back();
+                allocations.pop_back();
+            }
+            else
+            {
+                allocations.push_back(pools.Allocate(event.Size));
+            }
+        }
+
+        for (uint64_t bucketIdx = 0; bucketIdx < pools.BucketCount(); ++bucketIdx)
+        {
+            const TestPools::Bucket& bucket = pools.GetBucket(bucketIdx);
+
+            result.RequestedBytes += bucket.Stats().RequestedBytes;
+            result.WastedBytes += bucket.Stats().WastedBytes;
+            result.PeakWastedBytes += bucket.Stats().PeakWastedBytes;
+            result.ReservedBytes += bucket.Slots().SlotCount() * bucket.SlotSize();
+            result.BucketCount += bucket.Slots().SlotCount() > 0 ? 1 : 0;
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE(SizeClassesFollowDocumentedSequence)
+{
+    SizeClassMap map{ 1, 4 };
+    std::vector<uint64_t> expectedSizes{ 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 14, 16, 20, 24, 28, 32, 40 };
+
+    for (uint64_t classIndex = 0; classIndex < expectedSizes.size(); ++classIndex)
+    {
+        TEST_CHECK(map.ClassSize(classIndex) == expectedSizes[classIndex],
+            "Class ", classIndex, " has size ", map.ClassSize(classIndex), ", expected ", expectedSizes[classIndex]);
+    }
+}
+
+TEST_CASE(SingleSubClassProducesPowersOfTwo)
+{
+    SizeClassMap map{ 256, 1 };
+
+    for (uint64_t classIndex = 0; classIndex < 40; ++classIndex)
+    {
+        TEST_CHECK(map.ClassSize(classIndex) == (uint64_t(256) << classIndex), "Class ", classIndex, " is not a power of two granules");
+    }
+
+    TEST_CHECK(map.ClassIndex(256) == 0 && map.ClassIndex(257) == 1 && map.ClassIndex(513) == 2, "Sizes are rounded to wrong classes");
+}
+
+TEST_CASE(SizesMapToSmallestFittingClass)
+{
+    for (uint64_t subClassCount : { 1, 2, 4, 8, 16 })
+    {
+        for (uint64_t granularity : { 1, 3, 256, 65536 })
+        {
+            SizeClassMap map{ granularity, subClassCount };
+
+            // Dense near class boundaries where rounding carries into the next power of two range
+            for (uint64_t size = 0; size < granularity * 1024; size += granularity > 1 ? granularity / 2 + 1 : 1)
+            {
+                uint64_t classIndex = map.ClassIndex(size);
+                uint64_t classSize = map.ClassSize(classIndex);
+
+                TEST_CHECK(classSize >= size, "Size ", size, " does not fit its class of ", classSize, " bytes");
+                TEST_CHECK(classIndex == 0 || map.ClassSize(classIndex - 1) < std::max<uint64_t>(size, 1),
+                    "Size ", size, " fits a smaller class than ", classIndex, ", granularity ", granularity, ", sub classes ", subClassCount);
+                TEST_CHECK(classSize % granularity == 0, "Class size is not a multiple of granularity");
+            }
+        }
+    }
+}
+
+TEST_CASE(RoundingWasteIsBoundedBySubClassCount)
+{
+    SizeClassMap map{ 65536, 4 };
+
+    for (uint64_t size = 65536; size < 64ull * 1024 * 1024; size = size * 17 / 16 + 1)
+    {
+        uint64_t classSize = map.ClassSize(map.ClassIndex(size));
+        uint64_t waste = classSize - size;
+
+        // Requests beyond the first power of two range lose less than a quarter of their size
+        TEST_CHECK(waste * 4 <= size || size < 65536 * 4, "Size ", size, " wastes ", waste, " bytes in a class of ", classSize);
+    }
+}
+
+TEST_CASE(LargestSizesDoNotOverflow)
+{
+    for (uint64_t subClassCount : { 1, 4, 16 })
+    {
+        SizeClassMap map{ 65536, subClassCount };
+        uint64_t maxSize = map.MaxAllocationSize();
+        uint64_t classSize = map.ClassSize(map.ClassIndex(maxSize));
+
+        TEST_CHECK(classSize >= maxSize, "Class of the largest size overflowed to ", classSize);
+    }
+}
+
+TEST_CASE(SubClassesReduceWasteOnResourceTrace)
+{
+    std::vector<TraceEvent> trace = MakeResourceTrace();
+
+    TraceReplayResult powersOfTwo = ReplayTrace(trace, 1);
+    TraceReplayResult fourSubClasses = ReplayTrace(trace, 4);
+    TraceReplayResult eightSubClasses = ReplayTrace(trace, 8);
+
+    TEST_CHECK(powersOfTwo.RequestedBytes == fourSubClasses.RequestedBytes && fourSubClasses.RequestedBytes == eightSubClasses.RequestedBytes,
+        "Every configuration must end up with the same live allocations");
+
+    TEST_CHECK(fourSubClasses.WastedBytes < powersOfTwo.WastedBytes && eightSubClasses.WastedBytes < fourSubClasses.WastedBytes,
+        "More sub classes must waste less: ", powersOfTwo.WastedBytes, ", ", fourSubClasses.WastedBytes, ", ", eightSubClasses.WastedBytes);
+
+    // With N sub classes every request above minimum slot size loses less than 1/N of its size to rounding
+    TEST_CHECK(fourSubClasses.WastedBytes * 4 <= fourSubClasses.RequestedBytes, "4 sub classes waste more than a quarter of requested memory");
+    TEST_CHECK(eightSubClasses.WastedBytes * 8 <= eightSubClasses.RequestedBytes, "8 sub classes waste more than an eighth of requested memory");
+}
+
+BENCHMARK(SubClassWasteOnResourceTrace)
+{
+    std::vector<TraceEvent> trace = MakeResourceTrace();
+
+    for (uint64_t subClassCount : { 1, 4, 8 })
+    {
+        TraceReplayResult result = ReplayTrace(trace, subClassCount);
+
+        Tests::Report(subClassCount, " sub classes: requested ", double(result.RequestedBytes) / MB, " MB, wasted ", double(result.WastedBytes) / MB,
+            " MB (", 100.0 * result.WastedBytes / result.RequestedBytes, "%), peak wasted ", double(result.PeakWastedBytes) / MB,
+            " MB, reserved ", double(result.ReservedBytes) / MB, " MB in ", result.BucketCount, " buckets");
+    }
+}
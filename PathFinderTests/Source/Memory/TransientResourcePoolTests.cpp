@@ -0,0 +1,68 @@
+#include <TestFramework.hpp>
+
+#include <Memory/TransientResourcePool.hpp>
+
+#include <memory>
+#include <string>
+
+namespace
+{
+    using namespace Memory;
+
+    using TestPool = TransientResourcePool<std::unique_ptr<int>, std::string>;
+
+    constexpr uint64_t MinUnusedFrameCount = 2;
+    constexpr uint64_t MaxUnusedFrameCount = 10;
+}
+
+TEST_CASE(ReusesResourceWithMatchingProperties)
+{
+    TestPool pool{ MinUnusedFrameCount, MaxUnusedFrameCount };
+    pool.Release(1, "Texture 512x512", std::make_unique<int>(5), 100);
+
+    std::unique_ptr<int> resource = pool.AcquireOrCreate(1, "Texture 512x512", [] { return std::make_unique<int>(0); });
+
+    TEST_CHECK(resource && *resource == 5, "Released resource must be handed out again");
+    TEST_CHECK(pool.PooledResourceCount() == 0 && pool.PooledBytes() == 0, "Reused resource must leave the pool");
+    TEST_CHECK(pool.GetStatistics().ReuseCount == 1 && pool.GetStatistics().CreationCount == 0, "Statistics are off");
+}
+
+TEST_CASE(HashCollisionDoesNotHandOutDifferentResource)
+{
+    TestPool pool{ MinUnusedFrameCount, MaxUnusedFrameCount };
+    pool.Release(1, "Texture 512x512", std::make_unique<int>(5), 100);
+
+    std::unique_ptr<int> resource = pool.AcquireOrCreate(1, "Texture 1024x1024", [] { return std::make_unique<int>(7); });
+
+    TEST_CHECK(resource && *resource == 7, "Resource with colliding hash but different properties must not be reused");
+    TEST_CHECK(pool.PooledResourceCount() == 1, "Mismatching resource must stay in the pool");
+    TEST_CHECK(pool.GetStatistics().CreationCount == 1, "New resource must be created");
+}
+
+TEST_CASE(PrefersMostRecentlyReleasedResource)
+{
+    TestPool pool{ MinUnusedFrameCount, MaxUnusedFrameCount };
+    pool.Release(1, "Buffer", std::make_unique<int>(1), 100);
+    pool.BeginFrame(1);
+    pool.Release(1, "Buffer", std::make_unique<int>(2), 100);
+
+    std::unique_ptr<int> resource = pool.AcquireOrCreate(1, "Buffer", [] { return std::make_unique<int>(0); });
+
+    TEST_CHECK(*resource == 2, "Most recently released resource must be reused first");
+}
+
+TEST_CASE(EvictsUnusedAndExcessResources)
+{
+    TestPool pool{ MinUnusedFrameCount, MaxUnusedFrameCount };
+    pool.Release(1, "A", std::make_unique<int>(1), 100);
+    pool.BeginFrame(1);
+    pool.Release(2, "B", std::make_unique<int>(2), 100);
+    pool.SetPooledBytesLimit(100);
+
+    pool.BeginFrame(2);
+    TEST_CHECK(pool.PooledResourceCount() == 1, "Oldest resource must be evicted once it is out of frames in flight and over limit");
+
+    pool.BeginFrame(2 + MaxUnusedFrameCount);
+    TEST_CHECK(pool.PooledResourceCount() == 0, "Resources unused for too long must be evicted");
+    TEST_CHECK(pool.GetStatistics().EvictionCount == 2 && pool.PooledBytes() == 0, "Evictions are not accounted");
+}
@@ -0,0 +1,633 @@
+#include <TestFramework.hpp>
+
+#include <RenderPipeline/BarrierScheduler.hpp>
+#include <RenderPipeline/RenderPassGraph.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace PathFinder;
+    using HAL::ResourceState;
+    using EmittedBarrier = BarrierScheduler::EmittedBarrier;
+    using BarrierFlag = BarrierScheduler::BarrierFlag;
+
+    struct SyntheticResource
+    {
+        Foundation::Name Name;
+        uint32_t SubresourceCount = 1;
+
+        // Stands in for buffers and simultaneous access textures that are promoted and decayed by D3D12
+        bool IsImplicitlyTransitioned = false;
+    };
+
+    struct SyntheticUsage
+    {
+        uint64_t ResourceIndex = 0;
+        uint32_t SubresourceIndex = 0;
+        ResourceState State = ResourceState::Common;
+    };
+
+    struct SyntheticPass
+    {
+        Foundation::Name Name;
+        uint64_t QueueIndex = 0;
+        std::vector<SyntheticUsage> Usages;
+    };
+
+    /// A frame of passes and resource usages that is scheduled the same way RenderDevice does it,
+    /// except that barriers are collected as plain data instead of being recorded into command lists.
+    /// Resources are never dereferenced by the scheduler, so their addresses in this frame serve as identities.
+    class SyntheticFrame
+    {
+    public:
+        using BatchIndexGetter = std::function<uint64_t(const RenderPassGraph::Node&)>;
+
+        uint64_t AddResource(const std::string& name, uint32_t subresourceCount = 1, bool isImplicitlyTransitioned = false)
+        {
+            mResources.push_back(SyntheticResource{ name, subresourceCount, isImplicitlyTransitioned });
+            return mResources.size() - 1;
+        }
+
+        uint64_t AddPass(const std::string& name, uint64_t queueIndex = 0)
+        {
+            mPasses.push_back(SyntheticPass{ name, queueIndex, {} });
+            return mPasses.size() - 1;
+        }
+
+        void Use(uint64_t passIndex, uint64_t resourceIndex, uint32_t subresourceIndex, ResourceState state)
+        {
+            mPasses[passIndex].Usages.push_back(SyntheticUsage{ resourceIndex, subresourceIndex, state });
+        }
+
+        void UseAllSubresources(uint64_t passIndex, uint64_t resourceIndex, ResourceState state)
+        {
+            for (uint32_t subresourceIdx = 0; subresourceIdx < mResources[resourceIndex].SubresourceCount; ++subresourceIdx)
+            {
+                Use(passIndex, resourceIndex, subresourceIdx, state);
+            }
+        }
+
+        // Passes linked by a private resource each, so that they execute in order on a single queue one dependency level apart
+        std::vector<uint64_t> AddPassChain(const std::string& name, uint64_t length)
+        {
+            std::vector<uint64_t> passes;
+
+            for (uint64_t passIdx = 0; passIdx < length; ++passIdx)
+            {
+                passes.push_back(AddPass(name + std::to_string(passIdx)));
+
+                if (passIdx > 0)
+                {
+                    uint64_t link = AddResource(name + "Link" + std::to_string(passIdx));
+                    Use(passes[passIdx - 1], link, 0, ResourceState::UnorderedAccess);
+                    Use(passes[passIdx], link, 0, ResourceState::NonPixelShaderAccess);
+                }
+            }
+
+            return passes;
+        }
+
+        void Schedule(BarrierScheduler& scheduler, const BatchIndexGetter& batchIndexGetter = {})
+        {
+            BuildGraph();
+
+            uint64_t nodeCount = mGraph.NodesInGlobalExecutionOrder().size();
+
+            mEndBarriers.assign(nodeCount, {});
+            mBeginBarriers.assign(nodeCount, {});
+            mTransitionCount = 0;
+
+            std::vector<std::vector<ResourceState>> currentStates = InitialStates();
+
+            scheduler.Reset(nodeCount);
+
+            for (const RenderPassGraph::Node* node : mGraph.NodesInGlobalExecutionOrder())
+            {
+                uint64_t batchIndex = batchIndexGetter ? batchIndexGetter(*node) : node->DependencyLevelIndex();
+
+                for (const SyntheticUsage& usage : mPasses[node->IndexInUnorderedList()].Usages)
+                {
+                    const SyntheticResource& resource = mResources[usage.ResourceIndex];
+                    RenderPassGraph::SubresourceName subresourceName = RenderPassGraph::ConstructSubresourceName(resource.Name, usage.SubresourceIndex);
+                    ResourceState& currentState = currentStates[usage.ResourceIndex][usage.SubresourceIndex];
+
+                    if (currentState == usage.State)
+                    {
+                        scheduler.RecordUsage(subresourceName, node, batchIndex);
+                        continue;
+                    }
+
+                    scheduler.ScheduleTransition(subresourceName, Handle(usage.ResourceIndex), resource.SubresourceCount, currentState, usage.State, node, batchIndex);
+                    currentState = usage.State;
+                    ++mTransitionCount;
+                }
+
+                scheduler.EmitEndBarriers(node->GlobalExecutionIndex(), mEndBarriers[node->GlobalExecutionIndex()]);
+            }
+
+            // Begin parts are known only after every node was scheduled
+            for (const RenderPassGraph::Node* node : mGraph.NodesInGlobalExecutionOrder())
+            {
+                scheduler.EmitBeginBarriers(node->GlobalExecutionIndex(), mBeginBarriers[node->GlobalExecutionIndex()]);
+            }
+        }
+
+        // Replays emitted barriers on a per subresource state model and checks them against D3D12 rules:
+        // states before a transition match, split halves pair up with identical subresource coverage,
+        // no subresource is used while its transition is in flight and every usage sees the requested state.
+        void Validate(const BarrierScheduler& scheduler, const BatchIndexGetter& batchIndexGetter = {}) const
+        {
+            struct PendingTransition
+            {
+                ResourceState BeforeStates;
+                ResourceState AfterStates;
+                bool IsWholeResource;
+            };
+
+            std::vector<std::vector<ResourceState>> states = InitialStates();
+            std::vector<std::vector<std::optional<PendingTransition>>> pendingTransitions(mResources.size());
+            std::vector<std::vector<std::optional<uint64_t>>> lastUsageBatches(mResources.size());
+
+            for (uint64_t resourceIdx = 0; resourceIdx < mResources.size(); ++resourceIdx)
+            {
+                pendingTransitions[resourceIdx].resize(mResources[resourceIdx].SubresourceCount);
+                lastUsageBatches[resourceIdx].resize(mResources[resourceIdx].SubresourceCount);
+            }
+
+            auto forEachCoveredSubresource = [this](const EmittedBarrier& barrier, auto&& function)
+            {
+                uint64_t resourceIdx = ResourceIndex(barrier.Resource);
+
+                if (barrier.SubresourceIndex)
+                {
+                    function(resourceIdx, *barrier.SubresourceIndex);
+                    return;
+                }
+
+                for (uint32_t subresourceIdx = 0; subresourceIdx < mResources[resourceIdx].SubresourceCount; ++subresourceIdx)
+                {
+                    function(resourceIdx, subresourceIdx);
+                }
+            };
+
+            for (const RenderPassGraph::Node* node : mGraph.NodesInGlobalExecutionOrder())
+            {
+                uint64_t nodeIdx = node->GlobalExecutionIndex();
+                uint64_t batchIndex = batchIndexGetter ? batchIndexGetter(*node) : node->DependencyLevelIndex();
+
+                for (const EmittedBarrier& barrier : mEndBarriers[nodeIdx])
+                {
+                    TEST_CHECK(barrier.Flag != BarrierFlag::BeginOnly, "Begin barrier emitted before work of node ", nodeIdx);
+
+                    forEachCoveredSubresource(barrier, [&](uint64_t resourceIdx, uint32_t subresourceIdx)
+                    {
+                        std::optional<PendingTransition>& pending = pendingTransitions[resourceIdx][subresourceIdx];
+
+                        if (barrier.Flag == BarrierFlag::EndOnly)
+                        {
+                            TEST_CHECK(pending, "End barrier without Begin for ", mResources[resourceIdx].Name.ToString(), " subresource ", subresourceIdx);
+                            TEST_CHECK(pending->BeforeStates == barrier.BeforeStates && pending->AfterStates == barrier.AfterStates,
+                                "End barrier states differ from Begin barrier states at node ", nodeIdx);
+                            TEST_CHECK(pending->IsWholeResource == !barrier.SubresourceIndex,
+                                "Begin and End barriers of ", mResources[resourceIdx].Name.ToString(), " cover different subresources");
+                            pending = std::nullopt;
+                        }
+                        else
+                        {
+                            TEST_CHECK(!pending, "Full barrier issued during split transition of ", mResources[resourceIdx].Name.ToString());
+                            TEST_CHECK(states[resourceIdx][subresourceIdx] == barrier.BeforeStates,
+                                "Barrier before state doesn't match current state of ", mResources[resourceIdx].Name.ToString(), " subresource ", subresourceIdx);
+                        }
+
+                        states[resourceIdx][subresourceIdx] = barrier.AfterStates;
+                    });
+                }
+
+                // Transitions culled by the scheduler are performed by the driver when the command list batch starts
+                for (const BarrierScheduler::PlannedTransition& transition : scheduler.Plan())
+                {
+                    if (transition.Placement != BarrierScheduler::TransitionPlacement::Implicit || transition.EndNodeIndex != nodeIdx)
+                    {
+                        continue;
+                    }
+
+                    uint64_t resourceIdx = ResourceIndex(transition.Resource);
+                    const std::optional<uint64_t>& lastUsageBatch = lastUsageBatches[resourceIdx][transition.SubresourceIndex];
+
+                    TEST_CHECK(mResources[resourceIdx].IsImplicitlyTransitioned, "Transition of ", mResources[resourceIdx].Name.ToString(), " can't be implicit");
+                    TEST_CHECK(!lastUsageBatch || *lastUsageBatch != batchIndex, "Implicit transition inside of a command list batch that already used ", mResources[resourceIdx].Name.ToString());
+                    TEST_CHECK(states[resourceIdx][transition.SubresourceIndex] == transition.BeforeStates, "Implicit transition starts from a wrong state");
+
+                    states[resourceIdx][transition.SubresourceIndex] = transition.AfterStates;
+                }
+
+                for (const SyntheticUsage& usage : mPasses[node->IndexInUnorderedList()].Usages)
+                {
+                    const std::string& name = mResources[usage.ResourceIndex].Name.ToString();
+
+                    TEST_CHECK(!pendingTransitions[usage.ResourceIndex][usage.SubresourceIndex], name, " is used by node ", nodeIdx, " while its transition is in flight");
+                    TEST_CHECK(states[usage.ResourceIndex][usage.SubresourceIndex] == usage.State, name, " is not in requested state at node ", nodeIdx);
+
+                    lastUsageBatches[usage.ResourceIndex][usage.SubresourceIndex] = batchIndex;
+                }
+
+                for (const EmittedBarrier& barrier : mBeginBarriers[nodeIdx])
+                {
+                    TEST_CHECK(barrier.Flag == BarrierFlag::BeginOnly, "Only Begin barriers are emitted after work of node ", nodeIdx);
+
+                    forEachCoveredSubresource(barrier, [&](uint64_t resourceIdx, uint32_t subresourceIdx)
+                    {
+                        std::optional<PendingTransition>& pending = pendingTransitions[resourceIdx][subresourceIdx];
+
+                        TEST_CHECK(!pending, "Split transition of ", mResources[resourceIdx].Name.ToString(), " begins twice");
+                        TEST_CHECK(states[resourceIdx][subresourceIdx] == barrier.BeforeStates,
+                            "Begin barrier before state doesn't match current state of ", mResources[resourceIdx].Name.ToString());
+
+                        pending = PendingTransition{ barrier.BeforeStates, barrier.AfterStates, !barrier.SubresourceIndex };
+                    });
+                }
+            }
+
+            for (uint64_t resourceIdx = 0; resourceIdx < mResources.size(); ++resourceIdx)
+            {
+                for (const std::optional<PendingTransition>& pending : pendingTransitions[resourceIdx])
+                {
+                    TEST_CHECK(!pending, "Split transition of ", mResources[resourceIdx].Name.ToString(), " never ends");
+                }
+            }
+
+            // Every emitted barrier is either a Full one, a half of a Split one or stands for several merged ones
+            const BarrierScheduler::Statistics& statistics = scheduler.PlanStatistics();
+
+            TEST_CHECK(statistics.ImplicitTransitionCount + statistics.FullBarrierCount + statistics.SplitBarrierCount == mTransitionCount,
+                "Every requested transition has to be planned");
+            TEST_CHECK(statistics.EmittedBarrierCount == EmittedBarrierCount(), "Emitted barrier count mismatch");
+            TEST_CHECK(statistics.EmittedBarrierCount + statistics.MergedBarrierCount == statistics.FullBarrierCount + 2 * statistics.SplitBarrierCount,
+                "Merged barrier accounting mismatch");
+        }
+
+        const HAL::Resource* Handle(uint64_t resourceIndex) const
+        {
+            return reinterpret_cast<const HAL::Resource*>(&mResources[resourceIndex]);
+        }
+
+        uint64_t ResourceIndex(const HAL::Resource* handle) const
+        {
+            return reinterpret_cast<const SyntheticResource*>(handle) - mResources.data();
+        }
+
+        uint64_t EmittedBarrierCount() const
+        {
+            uint64_t count = 0;
+            for (const auto& barriers : mEndBarriers) count += barriers.size();
+            for (const auto& barriers : mBeginBarriers) count += barriers.size();
+            return count;
+        }
+
+        uint64_t NodeIndex(uint64_t passIndex) const
+        {
+            return mGraph.Nodes()[passIndex].GlobalExecutionIndex();
+        }
+
+        bool IsImplicitlyTransitioned(const HAL::Resource* handle) const
+        {
+            return mResources[ResourceIndex(handle)].IsImplicitlyTransitioned;
+        }
+
+        const std::vector<EmittedBarrier>& EndBarriers(uint64_t passIndex) const { return mEndBarriers[NodeIndex(passIndex)]; }
+        const std::vector<EmittedBarrier>& BeginBarriers(uint64_t passIndex) const { return mBeginBarriers[NodeIndex(passIndex)]; }
+        const RenderPassGraph& Graph() const { return mGraph; }
+
+    private:
+        void BuildGraph()
+        {
+            mGraph.Clear();
+
+            for (const SyntheticPass& pass : mPasses)
+            {
+                uint64_t nodeIndex = mGraph.AddPass(RenderPassMetadata{ pass.Name });
+                RenderPassGraph::Node& node = mGraph.Nodes()[nodeIndex];
+                node.ExecutionQueueIndex = pass.QueueIndex;
+
+                for (const SyntheticUsage& usage : pass.Usages)
+                {
+                    Foundation::Name name = mResources[usage.ResourceIndex].Name;
+
+                    if (HAL::IsResourceStateReadOnly(usage.State))
+                    {
+                        node.AddReadDependency(name, usage.SubresourceIndex, usage.SubresourceIndex);
+                    }
+                    else
+                    {
+                        node.AddWriteDependency(name, std::nullopt, usage.SubresourceIndex, usage.SubresourceIndex);
+                    }
+                }
+            }
+
+            mGraph.Build();
+        }
+
+        std::vector<std::vector<ResourceState>> InitialStates() const
+        {
+            std::vector<std::vector<ResourceState>> states;
+
+            for (const SyntheticResource& resource : mResources)
+            {
+                states.emplace_back(resource.SubresourceCount, ResourceState::Common);
+            }
+
+            return states;
+        }
+
+        std::vector<SyntheticResource> mResources;
+        std::vector<SyntheticPass> mPasses;
+        RenderPassGraph mGraph;
+        std::vector<std::vector<EmittedBarrier>> mEndBarriers;
+        std::vector<std::vector<EmittedBarrier>> mBeginBarriers;
+        uint64_t mTransitionCount = 0;
+    };
+
+    BarrierScheduler MakeScheduler(const SyntheticFrame& frame)
+    {
+        return BarrierScheduler{
+            [](uint64_t queueIndex, ResourceState beforeStates, ResourceState afterStates)
+            {
+                return queueIndex == 0 || (HAL::IsResourceStateTransitionSupportedOnComputeQueue(beforeStates) && HAL::IsResourceStateTransitionSupportedOnComputeQueue(afterStates));
+            },
+            [&frame](const HAL::Resource* resource, ResourceState beforeStates, ResourceState afterStates)
+            {
+                return frame.IsImplicitlyTransitioned(resource);
+            }
+        };
+    }
+
+    const BarrierScheduler::PlannedTransition* FindTransition(const BarrierScheduler& scheduler, const SyntheticFrame& frame, uint64_t resourceIndex, uint32_t subresourceIndex, ResourceState afterStates)
+    {
+        for (const BarrierScheduler::PlannedTransition& transition : scheduler.Plan())
+        {
+            if (transition.Resource == frame.Handle(resourceIndex) && transition.SubresourceIndex == subresourceIndex && transition.AfterStates == afterStates)
+            {
+                return &transition;
+            }
+        }
+
+        return nullptr;
+    }
+
+    uint64_t CountBarriersOf(const std::vector<EmittedBarrier>& barriers, const SyntheticFrame& frame, uint64_t resourceIndex)
+    {
+        return std::count_if(barriers.begin(), barriers.end(), [&](const EmittedBarrier& barrier) { return barrier.Resource == frame.Handle(resourceIndex); });
+    }
+
+}
+
+TEST_CASE(BarrierScheduler_SplitsDistantTransitions)
+{
+    SyntheticFrame frame;
+    std::vector<uint64_t> chain = frame.AddPassChain("Pass", 6);
+    uint64_t texture = frame.AddResource("Texture");
+    frame.Use(chain[0], texture, 0, ResourceState::RenderTarget);
+    frame.Use(chain[5], texture, 0, ResourceState::PixelShaderAccess);
+
+    BarrierScheduler scheduler = MakeScheduler(frame);
+    frame.Schedule(scheduler);
+    frame.Validate(scheduler);
+
+    const BarrierScheduler::PlannedTransition* transition = FindTransition(scheduler, frame, texture, 0, ResourceState::PixelShaderAccess);
+    TEST_CHECK(transition && transition->Placement == BarrierScheduler::TransitionPlacement::Split, "Transition 5 passes away from previous usage has to be split");
+    TEST_CHECK(transition->BeginNodeIndex == frame.NodeIndex(chain[0]), "Split transition has to begin right after the previous usage");
+    TEST_CHECK(transition->SplitDistance == 5, "Same queue distance is measured in passes");
+
+    TEST_CHECK(CountBarriersOf(frame.BeginBarriers(chain[0]), frame, texture) == 1, "Begin barrier is expected after the writer");
+    TEST_CHECK(CountBarriersOf(frame.EndBarriers(chain[5]), frame, texture) == 1, "End barrier is expected before the reader");
+
+    // Chain links are used by adjacent passes and must stay regular barriers
+    TEST_CHECK(scheduler.PlanStatistics().SplitBarrierCount == 1, "Only the distant transition is split");
+}
+
+TEST_CASE(BarrierScheduler_KeepsCloseTransitionsFull)
+{
+    SyntheticFrame frame;
+    std::vector<uint64_t> chain = frame.AddPassChain("Pass", 6);
+    uint64_t texture = frame.AddResource("Texture");
+    frame.Use(chain[0], texture, 0, ResourceState::RenderTarget);
+    frame.Use(chain[5], texture, 0, ResourceState::PixelShaderAccess);
+
+    BarrierScheduler scheduler = MakeScheduler(frame);
+    scheduler.SetMinimumSplitDistance(6);
+    frame.Schedule(scheduler);
+    frame.Validate(scheduler);
+
+    const BarrierScheduler::PlannedTransition* transition = FindTransition(scheduler, frame, texture, 0, ResourceState::PixelShaderAccess);
+    TEST_CHECK(transition && transition->Placement == BarrierScheduler::TransitionPlacement::Full, "Transition closer than minimum split distance must not be split");
+    TEST_CHECK(scheduler.PlanStatistics().SplitBarrierCount == 0, "No transitions are expected to be split");
+    TEST_CHECK(frame.BeginBarriers(chain[0]).empty(), "No Begin barriers are expected");
+}
+
+TEST_CASE(BarrierScheduler_MergesIdenticalSubresourceTransitions)
+{
+    SyntheticFrame frame;
+    std::vector<uint64_t> chain = frame.AddPassChain("Pass", 6);
+    uint64_t texture = frame.AddResource("MippedTexture", 4);
+    frame.UseAllSubresources(chain[0], texture, ResourceState::RenderTarget);
+    frame.UseAllSubresources(chain[5], texture, ResourceState::PixelShaderAccess);
+
+    BarrierScheduler scheduler = MakeScheduler(frame);
+    frame.Schedule(scheduler);
+    frame.Validate(scheduler);
+
+    for (const std::vector<EmittedBarrier>* barriers : { &frame.EndBarriers(chain[0]), &frame.BeginBarriers(chain[0]), &frame.EndBarriers(chain[5]) })
+    {
+        TEST_CHECK(CountBarriersOf(*barriers, frame, texture) == 1, "Identical subresource transitions have to be merged");
+
+        for (const EmittedBarrier& barrier : *barriers)
+        {
+            TEST_CHECK(barrier.Resource != frame.Handle(texture) || !barrier.SubresourceIndex, "Merged barrier has to cover all subresources");
+        }
+    }
+
+    // Full Common -> RenderTarget and both halves of RenderTarget -> PixelShaderAccess save 3 barriers each
+    TEST_CHECK(scheduler.PlanStatistics().MergedBarrierCount == 9, "Unexpected amount of merged barriers: ", scheduler.PlanStatistics().MergedBarrierCount);
+}
+
+TEST_CASE(BarrierScheduler_DoesNotMergeSplitTransitionsBeganAtDifferentNodes)
+{
+    SyntheticFrame frame;
+    std::vector<uint64_t> chain = frame.AddPassChain("Pass", 6);
+    uint64_t texture = frame.AddResource("MippedTexture", 2);
+    frame.Use(chain[0], texture, 0, ResourceState::RenderTarget);
+    frame.Use(chain[2], texture, 1, ResourceState::RenderTarget);
+    frame.UseAllSubresources(chain[5], texture, ResourceState::PixelShaderAccess);
+
+    BarrierScheduler scheduler = MakeScheduler(frame);
+    frame.Schedule(scheduler);
+
+    // Both subresources end at the same node in the same states, but their Begin halves were recorded separately
+    const std::vector<EmittedBarrier>& endBarriers = frame.EndBarriers(chain[5]);
+    TEST_CHECK(CountBarriersOf(endBarriers, frame, texture) == 2, "End halves of transitions began at different nodes must stay per subresource");
+
+    for (const EmittedBarrier& barrier : endBarriers)
+    {
+        TEST_CHECK(barrier.Resource != frame.Handle(texture) || (barrier.SubresourceIndex && barrier.Flag == BarrierFlag::EndOnly), "Expected per subresource End barriers");
+    }
+
+    frame.Validate(scheduler);
+}
+
+TEST_CASE(BarrierScheduler_DoesNotMergeTransitionsOfDifferentPlacement)
+{
+    SyntheticFrame frame;
+    std::vector<uint64_t> chain = frame.AddPassChain("Pass", 6);
+    uint64_t texture = frame.AddResource("MippedTexture", 2);
+    frame.Use(chain[0], texture, 0, ResourceState::RenderTarget);
+    frame.Use(chain[4], texture, 1, ResourceState::RenderTarget);
+    frame.UseAllSubresources(chain[5], texture, ResourceState::PixelShaderAccess);
+
+    BarrierScheduler scheduler = MakeScheduler(frame);
+    frame.Schedule(scheduler);
+    frame.Validate(scheduler);
+
+    TEST_CHECK(CountBarriersOf(frame.EndBarriers(chain[5]), frame, texture) == 2, "Split and Full transitions can't be merged");
+}
+
+TEST_CASE(BarrierScheduler_CullsImplicitTransitionsBetweenBatches)
+{
+    SyntheticFrame frame;
+    std::vector<uint64_t> chain = frame.AddPassChain("Pass", 4);
+    uint64_t buffer = frame.AddResource("Buffer", 1, true);
+    frame.Use(chain[0], buffer, 0, ResourceState::UnorderedAccess);
+    frame.Use(chain[3], buffer, 0, ResourceState::NonPixelShaderAccess);
+
+    BarrierScheduler scheduler = MakeScheduler(frame);
+    frame.Schedule(scheduler);
+    frame.Validate(scheduler);
+
+    const BarrierScheduler::PlannedTransition* transition = FindTransition(scheduler, frame, buffer, 0, ResourceState::NonPixelShaderAccess);
+    TEST_CHECK(transition && transition->Placement == BarrierScheduler::TransitionPlacement::Implicit, "Promotable transition across batches has to be implicit");
+    TEST_CHECK(frame.EndBarriers(chain[3]).size() == 1, "Only the chain link barrier is expected");
+}
+
+TEST_CASE(BarrierScheduler_KeepsExplicitTransitionsInsideBatch)
+{
+    SyntheticFrame frame;
+    std::vector<uint64_t> chain = frame.AddPassChain("Pass", 4);
+    uint64_t buffer = frame.AddResource("Buffer", 1, true);
+    frame.Use(chain[0], buffer, 0, ResourceState::UnorderedAccess);
+    frame.Use(chain[3], buffer, 0, ResourceState::NonPixelShaderAccess);
+
+    // Everything is submitted in a single ExecuteCommandLists call, so no promotion/decay happens in between
+    auto singleBatch = [](const RenderPassGraph::Node& node) -> uint64_t { return 0; };
+
+    BarrierScheduler scheduler = MakeScheduler(frame);
+    frame.Schedule(scheduler, singleBatch);
+    frame.Validate(scheduler, singleBatch);
+
+    const BarrierScheduler::PlannedTransition* transition = FindTransition(scheduler, frame, buffer, 0, ResourceState::NonPixelShaderAccess);
+    TEST_CHECK(transition && transition->Placement == BarrierScheduler::TransitionPlacement::Split, "Transition inside of a batch has to be explicit");
+}
+
+TEST_CASE(BarrierScheduler_MeasuresCrossQueueDistanceInDependencyLevels)
+{
+    SyntheticFrame frame;
+    std::vector<uint64_t> chain = frame.AddPassChain("Pass", 5);
+    uint64_t computePass = frame.AddPass("AsyncCompute", 1);
+    uint64_t computeOutput = frame.AddResource("ComputeOutput");
+    uint64_t computeTexture = frame.AddResource("ComputeTexture");
+    frame.Use(computePass, computeOutput, 0, ResourceState::UnorderedAccess);
+    frame.Use(computePass, computeTexture, 0, ResourceState::UnorderedAccess);
+    frame.Use(chain[4], computeOutput, 0, ResourceState::NonPixelShaderAccess);
+    frame.Use(chain[4], computeTexture, 0, ResourceState::PixelShaderAccess);
+
+    BarrierScheduler scheduler = MakeScheduler(frame);
+    frame.Schedule(scheduler);
+    frame.Validate(scheduler);
+
+    const RenderPassGraph::Node& computeNode = frame.Graph().Nodes()[computePass];
+    const RenderPassGraph::Node& readerNode = frame.Graph().Nodes()[chain[4]];
+
+    const BarrierScheduler::PlannedTransition* supported = FindTransition(scheduler, frame, computeOutput, 0, ResourceState::NonPixelShaderAccess);
+    TEST_CHECK(supported && supported->SplitDistance == readerNode.DependencyLevelIndex() - computeNode.DependencyLevelIndex(), "Cross queue distance is measured in dependency levels");
+    TEST_CHECK(supported->Placement == BarrierScheduler::TransitionPlacement::Split, "Compute queue can begin UnorderedAccess -> NonPixelShaderAccess transition");
+
+    // Compute queue can't handle pixel shader states, so the transition can't begin there
+    const BarrierScheduler::PlannedTransition* unsupported = FindTransition(scheduler, frame, computeTexture, 0, ResourceState::PixelShaderAccess);
+    TEST_CHECK(unsupported && unsupported->Placement == BarrierScheduler::TransitionPlacement::Full, "Unsupported transition can't begin on compute queue");
+}
+
+TEST_CASE(BarrierScheduler_RandomGraphsMatchReferenceSimulation)
+{
+    const ResourceState graphicsWriteStates[] = { ResourceState::RenderTarget, ResourceState::UnorderedAccess };
+    const ResourceState graphicsReadStates[] = { ResourceState::PixelShaderAccess, ResourceState::NonPixelShaderAccess, ResourceState::AnyShaderAccess };
+
+    for (uint32_t seed = 0; seed < 200; ++seed)
+    {
+        std::mt19937 random{ seed };
+        auto randomIndex = [&random](uint64_t count) { return std::uniform_int_distribution<uint64_t>{ 0, count - 1 }(random); };
+
+        SyntheticFrame frame;
+
+        uint64_t passCount = 4 + randomIndex(12);
+        uint64_t resourceCount = 2 + randomIndex(10);
+        std::vector<uint64_t> passes;
+        std::vector<uint64_t> passQueues;
+
+        for (uint64_t passIdx = 0; passIdx < passCount; ++passIdx)
+        {
+            // Roughly a quarter of passes go to async compute
+            passQueues.push_back(randomIndex(4) == 0 ? 1 : 0);
+            passes.push_back(frame.AddPass("RandomPass" + std::to_string(passIdx), passQueues.back()));
+        }
+
+        // Compute passes are limited to states their queue can use
+        auto writeState = [&](uint64_t passIdx) { return passQueues[passIdx] == 1 ? ResourceState::UnorderedAccess : graphicsWriteStates[randomIndex(2)]; };
+        auto readState = [&](uint64_t passIdx) { return passQueues[passIdx] == 1 ? ResourceState::NonPixelShaderAccess : graphicsReadStates[randomIndex(3)]; };
+
+        for (uint64_t resourceIdx = 0; resourceIdx < resourceCount; ++resourceIdx)
+        {
+            uint32_t subresourceCount = randomIndex(3) == 0 ? 1 + randomIndex(4) : 1;
+            uint64_t resource = frame.AddResource("RandomResource" + std::to_string(resourceIdx), subresourceCount, randomIndex(4) == 0);
+
+            for (uint32_t subresourceIdx = 0; subresourceIdx < subresourceCount; ++subresourceIdx)
+            {
+                // Pass creation order is a valid execution order: every subresource is written once and only read by later passes
+                uint64_t writer = randomIndex(passCount - 1);
+                std::vector<uint64_t> readers;
+                for (uint64_t passIdx = writer + 1; passIdx < passCount; ++passIdx)
+                {
+                    if (randomIndex(3) == 0) readers.push_back(passIdx);
+                }
+
+                frame.Use(passes[writer], resource, subresourceIdx, writeState(writer));
+
+                for (uint64_t reader : readers)
+                {
+                    frame.Use(passes[reader], resource, subresourceIdx, readState(reader));
+                }
+            }
+        }
+
+        // Batch boundaries every few dependency levels
+        uint64_t levelsPerBatch = 1 + randomIndex(3);
+        auto batchIndexGetter = [levelsPerBatch](const RenderPassGraph::Node& node) { return node.DependencyLevelIndex() / levelsPerBatch; };
+
+        BarrierScheduler scheduler = MakeScheduler(frame);
+        scheduler.SetMinimumSplitDistance(1 + randomIndex(4));
+        frame.Schedule(scheduler, batchIndexGetter);
+
+        try
+        {
+            frame.Validate(scheduler, batchIndexGetter);
+        }
+        catch (Tests::TestFailure& failure)
+        {
+            failure.Message += " (seed " + std::to_string(seed) + ")";
+            throw;
+        }
+    }
+}
@@ -0,0 +1,230 @@
+#include <TestFramework.hpp>
+
+#include <RenderPipeline/DynamicResolutionController.hpp>
+#include <RenderPipeline/RenderSurfaceDescription.hpp>
+
+#include <cmath>
+#include <deque>
+
+namespace
+{
+    using namespace PathFinder;
+
+    using Controller = DynamicResolutionController;
+
+    constexpr float Target = 1.0f / 60.0f;
+
+    // GPU whose frame time grows with pixel count on top of a fixed cost.
+    // Durations arrive with frames in flight delay, like timestamp queries do.
+    class SimulatedGPU
+    {
+    public:
+        SimulatedGPU(float fullResolutionSeconds, uint64_t framesInFlight = 2)
+            : mFullResolutionSeconds{ fullResolutionSeconds }, mPendingScales(framesInFlight, 1.0f) {}
+
+        float Render(float scale)
+        {
+            mPendingScales.push_back(scale);
+            float completedScale = mPendingScales.front();
+            mPendingScales.pop_front();
+            return FrameTime(completedScale);
+        }
+
+        float FrameTime(float scale) const
+        {
+            return FixedCostSeconds + (mFullResolutionSeconds - FixedCostSeconds) * scale * scale;
+        }
+
+        void SetLoad(float fullResolutionSeconds) { mFullResolutionSeconds = fullResolutionSeconds; }
+
+    private:
+        static constexpr float FixedCostSeconds = 0.002f;
+
+        float mFullResolutionSeconds = 0.0f;
+        std::deque<float> mPendingScales;
+    };
+
+    // Runs controller in a loop with the simulated GPU and returns scale change count of the last frames
+    uint64_t Run(Controller& controller, SimulatedGPU& gpu, uint64_t frameCount, uint64_t trailingFrameCount)
+    {
+        uint64_t changeCountBeforeTrailingFrames = 0;
+
+        for (uint64_t frame = 0; frame < frameCount; ++frame)
+        {
+            if (frame == frameCount - trailingFrameCount)
+            {
+                changeCountBeforeTrailingFrames = controller.ScaleChangeCount();
+            }
+
+            controller.Update(gpu.Render(controller.Scale()));
+        }
+
+        return controller.ScaleChangeCount() - changeCountBeforeTrailingFrames;
+    }
+
+    bool IsWithinBand(float frameTime, const Controller::Settings& settings, float tolerance)
+    {
+        return std::abs(settings.TargetFrameTimeSeconds / frameTime - 1.0f) <= settings.Hysteresis + tolerance;
+    }
+}
+
+TEST_CASE(ConvergesAfterLoadStep)
+{
+    Controller::Settings settings{};
+    Controller controller{ settings };
+    SimulatedGPU gpu{ 0.012f };
+
+    TEST_CHECK(Run(controller, gpu, 60, 60) == 0 && controller.Scale() == settings.MaxScale, "Light load must keep full resolution");
+
+    // Heavy scene comes into view
+    gpu.SetLoad(0.030f);
+
+    TEST_CHECK(Run(controller, gpu, 200, 60) == 0, "Scale must settle after a load increase");
+    TEST_CHECK(controller.Scale() < settings.MaxScale && controller.Scale() > settings.MinScale, "Scale ", controller.Scale(), " does not compensate the load");
+
+    // One scale step of tolerance, since scales are quantized
+    TEST_CHECK(IsWithinBand(gpu.FrameTime(controller.Scale()), settings, 0.05f), "Frame time ", gpu.FrameTime(controller.Scale()), " did not converge to target");
+
+    // Scene gets light again
+    gpu.SetLoad(0.012f);
+
+    TEST_CHECK(Run(controller, gpu, 400, 60) == 0 && controller.Scale() == settings.MaxScale, "Full resolution must be restored, scale is ", controller.Scale());
+}
+
+TEST_CASE(KeepsScaleInsideHysteresisBand)
+{
+    Controller::Settings settings{};
+    settings.MaxScale = 0.75f;
+    Controller controller{ settings };
+
+    for (uint64_t frame = 0; frame < 200; ++frame)
+    {
+        // Noise of 4% in both directions around target
+        controller.Update(Target * (frame % 2 == 0 ? 1.04f : 0.96f));
+    }
+
+    TEST_CHECK(controller.ScaleChangeCount() == 0 && controller.Scale() == 0.75f, "Noise inside hysteresis band changed scale ", controller.ScaleChangeCount(), " times");
+
+    controller.Update(Target * 1.2f);
+    TEST_CHECK(controller.ScaleChangeCount() == 0, "Single spike must be smoothed out");
+}
+
+TEST_CASE(SkipsFramesRenderedBeforeScaleChange)
+{
+    Controller::Settings settings{};
+    Controller controller{ settings };
+
+    float scale = controller.Update(Target * 2.0f);
+    float smoothedFrameTime = controller.SmoothedFrameTimeSeconds();
+
+    TEST_CHECK(scale < settings.MaxScale && controller.ScaleChangeCount() == 1, "Slow frame must reduce scale");
+
+    // Frames that were already in flight carry no information about the new scale
+    for (uint64_t frame = 0; frame < settings.SettleFrameCount; ++frame)
+    {
+        TEST_CHECK(controller.Update(Target * 10.0f) == scale, "Settle frame ", frame, " changed scale");
+    }
+
+    TEST_CHECK(controller.SmoothedFrameTimeSeconds() == smoothedFrameTime, "Settle frames must not be measured");
+
+    // First frame rendered with new scale replaces the smoothed history instead of blending with old scale timings
+    controller.Update(Target * 0.5f);
+    TEST_CHECK(controller.SmoothedFrameTimeSeconds() == Target * 0.5f, "Measurements must restart after scale change");
+    TEST_CHECK(controller.Scale() > scale && controller.ScaleChangeCount() == 2, "Fast frame after settling must raise scale");
+}
+
+TEST_CASE(IgnoresMissingMeasurements)
+{
+    Controller::Settings settings{};
+    Controller controller{ settings };
+
+    for (float duration : { 0.0f, -1.0f, -0.0f })
+    {
+        TEST_CHECK(controller.Update(duration) == settings.MaxScale, "Missing measurement changed scale");
+    }
+
+    TEST_CHECK(controller.SmoothedFrameTimeSeconds() == 0.0f && controller.ScaleChangeCount() == 0, "Missing measurements must not be averaged");
+
+    float scale = controller.Update(Target * 2.0f);
+
+    // Missing measurements don't count as settled frames either
+    for (uint64_t frame = 0; frame < 10; ++frame)
+    {
+        controller.Update(0.0f);
+    }
+
+    for (uint64_t frame = 0; frame < settings.SettleFrameCount; ++frame)
+    {
+        controller.Update(Target * 2.0f);
+    }
+
+    TEST_CHECK(controller.Scale() == scale && controller.ScaleChangeCount() == 1, "Scale changed before enough real frames settled");
+}
+
+TEST_CASE(ScaleStaysWithinBounds)
+{
+    Controller::Settings settings{};
+    settings.MinScale = 0.5f;
+    settings.MaxScale = 0.9f;
+    Controller controller{ settings };
+
+    for (uint64_t frame = 0; frame < 500; ++frame)
+    {
+        float scale = controller.Update(Target * 100.0f);
+        TEST_CHECK(scale >= settings.MinScale, "Scale ", scale, " is below minimum");
+    }
+
+    TEST_CHECK(controller.Scale() == settings.MinScale, "Overloaded GPU must end at minimum scale, got ", controller.Scale());
+
+    for (uint64_t frame = 0; frame < 500; ++frame)
+    {
+        float scale = controller.Update(Target * 0.01f);
+        TEST_CHECK(scale <= settings.MaxScale, "Scale ", scale, " is above maximum");
+    }
+
+    TEST_CHECK(controller.Scale() == settings.MaxScale, "Idle GPU must end at maximum scale, got ", controller.Scale());
+
+    controller.Reset();
+    TEST_CHECK(controller.Scale() == settings.MaxScale && controller.ScaleChangeCount() == 0, "Reset must restore maximum scale");
+}
+
+TEST_CASE(SurfaceDimensionsFollowRenderScale)
+{
+    RenderSurfaceDescription surface{ { 1920, 1080 }, HAL::ColorFormat::RGBA8_Usigned_Norm, HAL::DepthStencilFormat::Depth32_Float };
+
+    TEST_CHECK(surface.RenderDimensions() == Geometry::Dimensions(1920, 1080) && !surface.IsRenderDimensionsChanged(), "Surface must start at full resolution");
+
+    surface.SetRenderScale(0.5f);
+
+    TEST_CHECK(surface.RenderDimensions() == Geometry::Dimensions(960, 540) && surface.IsRenderDimensionsChanged(), "Half scale must halve render dimensions");
+    TEST_CHECK(surface.UVScale() == glm::vec2(0.5f, 0.5f), "UV scale must match render scale");
+    TEST_CHECK(surface.RenderDimensions({ 960, 540 }) == Geometry::Dimensions(480, 270), "Half resolution buffer must be covered by half");
+    TEST_CHECK(surface.RenderDimensions({ 1, 1 }) == Geometry::Dimensions(1, 1), "Smallest mip must keep a texel");
+
+    surface.SetRenderScale(0.5f);
+    TEST_CHECK(!surface.IsRenderDimensionsChanged(), "Same scale must not invalidate history");
+
+    // Rounding up never leaves unrendered texels at the edges
+    RenderSurfaceDescription oddSurface{ { 1366, 767 }, HAL::ColorFormat::RGBA8_Usigned_Norm, HAL::DepthStencilFormat::Depth32_Float };
+
+    for (float scale : { 0.3f, 0.5f, 0.6640625f, 0.75f, 0.9921875f, 1.0f })
+    {
+        oddSurface.SetRenderScale(scale);
+
+        const Geometry::Dimensions& rendered = oddSurface.RenderDimensions();
+        glm::vec2 uvScale = oddSurface.UVScale();
+
+        TEST_CHECK(rendered.Width >= 1366 * scale && rendered.Width < 1366 * scale + 1 && rendered.Height >= 767 * scale && rendered.Height < 767 * scale + 1,
+            "Render dimensions are off at scale ", scale);
+
+        TEST_CHECK(std::abs(uvScale.x * 1366 - rendered.Width) < 1e-3f && std::abs(uvScale.y * 767 - rendered.Height) < 1e-3f, "UV scale does not map onto rendered texels at scale ", scale);
+
+        for (Geometry::Dimensions mip : { Geometry::Dimensions{ 683, 383 }, Geometry::Dimensions{ 170, 95 }, Geometry::Dimensions{ 2, 1 } })
+        {
+            Geometry::Dimensions covered = oddSurface.RenderDimensions(mip);
+
+            TEST_CHECK(covered.Width >= mip.Width * uvScale.x && covered.Width <= mip.Width && covered.Height >= mip.Height * uvScale.y && covered.Height <= mip.Height,
+                "Texture of ", mip.Width, "x", mip.Height, " is not covered at scale ", scale);
+        }
+    }
+}
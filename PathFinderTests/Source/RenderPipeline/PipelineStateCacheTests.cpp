@@ -0,0 +1,153 @@
+#include <TestFramework.hpp>
+
+#include <RenderPipeline/PipelineStateCache.hpp>
+
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    using namespace PathFinder;
+
+    using Bytes = std::vector<uint8_t>;
+
+    constexpr uint64_t DeviceFingerprint = 0x1234;
+
+    // Header is magic, format version and device fingerprint
+    constexpr uint64_t FormatVersionOffset = 4;
+    constexpr uint64_t DeviceFingerprintOffset = 8;
+
+    PipelineStateCache::ByteSpan Span(const Bytes& bytes)
+    {
+        return { bytes.data(), bytes.size() };
+    }
+
+    PipelineStateCache MakeCache()
+    {
+        PipelineStateCache cache{ DeviceFingerprint };
+        cache.Store(1, Bytes{ 1, 2, 3 });
+        cache.Store(2, Bytes(1000, 7));
+        cache.Store(3, Bytes{ 9 });
+        return cache;
+    }
+
+    std::filesystem::path TemporaryDirectory()
+    {
+        std::filesystem::path directory = std::filesystem::temp_directory_path() / "PathFinderTests" / "PipelineStateCache";
+        std::filesystem::remove_all(directory);
+        return directory;
+    }
+}
+
+TEST_CASE(KeyChangesWithDescriptionAndShaders)
+{
+    Bytes description{ 1, 2, 3, 4 };
+    Bytes vertexShader{ 10, 11, 12 };
+    Bytes pixelShader{ 20, 21, 22 };
+
+    PipelineStateCache::Key key = PipelineStateCache::ComputeKey(Span(description), { Span(vertexShader), Span(pixelShader) });
+
+    TEST_CHECK(key == PipelineStateCache::ComputeKey(Span(description), { Span(vertexShader), Span(pixelShader) }), "Key must be deterministic");
+
+    Bytes otherDescription = description;
+    otherDescription.back() ^= 1;
+    TEST_CHECK(key != PipelineStateCache::ComputeKey(Span(otherDescription), { Span(vertexShader), Span(pixelShader) }), "Description change must change the key");
+
+    Bytes otherPixelShader = pixelShader;
+    otherPixelShader.front() ^= 1;
+    TEST_CHECK(key != PipelineStateCache::ComputeKey(Span(description), { Span(vertexShader), Span(otherPixelShader) }), "Shader change must change the key");
+
+    TEST_CHECK(key != PipelineStateCache::ComputeKey(Span(description), { Span(pixelShader), Span(vertexShader) }), "Shaders bound to other stages must change the key");
+    TEST_CHECK(key != PipelineStateCache::ComputeKey(Span(description), { Span(vertexShader) }), "Missing shader must change the key");
+
+    // Persisted hashes must not change between builds
+    TEST_CHECK(PipelineStateCache::Hash(Span(Bytes{})) == 0xcbf29ce484222325, "Hash of empty data is not FNV-1a offset basis");
+    TEST_CHECK(PipelineStateCache::Hash(Span(Bytes{ 'a' })) == 0xaf63dc4c8601ec8c, "Hash is not 64-bit FNV-1a");
+}
+
+TEST_CASE(SerializedCacheRoundTrips)
+{
+    PipelineStateCache cache = MakeCache();
+    Bytes data = cache.Serialize();
+
+    PipelineStateCache loaded{ DeviceFingerprint };
+    TEST_CHECK(loaded.Deserialize(data) == PipelineStateCache::LoadResult::Loaded, "Valid cache must load");
+    TEST_CHECK(loaded.EntryCount() == 3 && !loaded.IsDirty(), "Loaded cache has ", loaded.EntryCount(), " entries");
+
+    for (PipelineStateCache::Key key : { 1, 2, 3 })
+    {
+        std::optional<PipelineStateCache::ByteSpan> original = cache.Find(key);
+        std::optional<PipelineStateCache::ByteSpan> blob = loaded.Find(key);
+
+        TEST_CHECK(blob && blob->Size == original->Size && memcmp(blob->Data, original->Data, blob->Size) == 0, "Blob ", key, " did not survive round trip");
+    }
+
+    TEST_CHECK(!loaded.Find(4), "Unknown key must miss");
+
+    // Entries that were loaded but not used since are pruned on save
+    loaded.MarkAsUsed(2);
+    PipelineStateCache pruned{ DeviceFingerprint };
+    pruned.Deserialize(loaded.Serialize());
+
+    TEST_CHECK(pruned.EntryCount() == 1 && pruned.Find(2), "Only used entries must be saved, got ", pruned.EntryCount());
+}
+
+TEST_CASE(RejectsForeignAndDamagedData)
+{
+    Bytes data = MakeCache().Serialize();
+    PipelineStateCache cache{ DeviceFingerprint };
+
+    Bytes badMagic = data;
+    badMagic[0] ^= 0xFF;
+    TEST_CHECK(cache.Deserialize(badMagic) == PipelineStateCache::LoadResult::Corrupted, "Wrong magic must be rejected");
+
+    Bytes badVersion = data;
+    badVersion[FormatVersionOffset] += 1;
+    TEST_CHECK(cache.Deserialize(badVersion) == PipelineStateCache::LoadResult::FormatMismatch, "Other format version must be rejected");
+
+    Bytes badDevice = data;
+    badDevice[DeviceFingerprintOffset] ^= 1;
+    TEST_CHECK(cache.Deserialize(badDevice) == PipelineStateCache::LoadResult::DeviceMismatch, "Blobs of other device must be rejected");
+
+    // Last byte belongs to the last blob
+    Bytes badBlob = data;
+    badBlob.back() ^= 1;
+    TEST_CHECK(cache.Deserialize(badBlob) == PipelineStateCache::LoadResult::Corrupted, "Blob not matching its hash must be rejected");
+    TEST_CHECK(cache.EntryCount() == 0, "Rejected cache must not keep entries that were valid");
+
+    for (uint64_t size : { uint64_t(0), uint64_t(3), DeviceFingerprintOffset + 4, data.size() / 2, data.size() - 1 })
+    {
+        Bytes truncated{ data.begin(), data.begin() + size };
+        TEST_CHECK(cache.Deserialize(truncated) == PipelineStateCache::LoadResult::Corrupted, "File truncated to ", size, " bytes must be rejected");
+    }
+}
+
+TEST_CASE(SavesToFileAndReportsFailures)
+{
+    std::filesystem::path directory = TemporaryDirectory();
+    std::filesystem::path path = directory / "Nested" / "PSO.cache";
+
+    PipelineStateCache cache = MakeCache();
+    TEST_CHECK(cache.IsDirty(), "Stored entries must make cache dirty");
+    TEST_CHECK(cache.SaveToFile(path) && !cache.IsDirty(), "Save must create missing folders and clear dirty flag");
+    TEST_CHECK(!std::filesystem::exists(path.string() + ".tmp"), "Temporary file must be renamed over the target");
+
+    PipelineStateCache loaded{ DeviceFingerprint };
+    TEST_CHECK(loaded.LoadFromFile(path) == PipelineStateCache::LoadResult::Loaded && loaded.EntryCount() == 3, "Saved cache must load");
+
+    // Overwriting an existing file
+    cache.Store(4, Bytes{ 4 });
+    TEST_CHECK(cache.SaveToFile(path), "Existing cache file must be replaced");
+    TEST_CHECK(loaded.LoadFromFile(path) == PipelineStateCache::LoadResult::Loaded && loaded.EntryCount() == 4, "Replaced cache must load");
+
+    PipelineStateCache missing{ DeviceFingerprint };
+    TEST_CHECK(missing.LoadFromFile(directory / "Missing.cache") == PipelineStateCache::LoadResult::FileMissing, "Missing file must be reported");
+
+    // Folder cannot be created where a file is
+    std::filesystem::path blockedPath = path / "PSO.cache";
+    cache.Store(5, Bytes{ 5 });
+    TEST_CHECK(!cache.SaveToFile(blockedPath), "Save into unusable folder must fail without throwing");
+    TEST_CHECK(cache.IsDirty(), "Failed save must keep cache dirty");
+
+    std::filesystem::remove_all(directory);
+}
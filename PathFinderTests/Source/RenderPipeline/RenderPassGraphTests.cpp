@@ -0,0 +1,191 @@
+#include <TestFramework.hpp>
+
+#include <RenderPipeline/RenderPassGraph.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace PathFinder;
+
+    enum class Access { New, Read, Write };
+
+    struct Usage
+    {
+        Access Kind = Access::Read;
+        Foundation::Name Resource;
+        Foundation::Name OutputAlias;
+        uint32_t FirstMip = 0;
+        uint32_t LastMip = 0;
+    };
+
+    struct PassSchedule
+    {
+        const char* Name = nullptr;
+        uint64_t QueueIndex = 0;
+        std::vector<Usage> Usages;
+    };
+
+    // Resource usages of the 23 default render passes, as their ScheduleResources() request them.
+    // Resources with a per frame history are listed for one frame parity.
+    std::vector<PassSchedule> DefaultFrameSchedule()
+    {
+        const Access N = Access::New;
+        const Access R = Access::Read;
+        const Access W = Access::Write;
+
+        return {
+            { "CommonSetup", 0, {} },
+            { "GBuffer", 0, { { N, "GBufferAlbedoMetalness" }, { N, "GBufferNormalRoughness" }, { N, "GBufferMotionVector" }, { N, "GBufferTypeAndMaterialIndex" },
+                { N, "GBufferViewDepth0" }, { N, "GBufferViewDepth1" }, { N, "GBufferDepthStencil" } } },
+            { "RngSeedGeneration", 1, { { N, "RngSeeds0" } } },
+            { "DenoiserForwardProjection", 0, { { N, "DenoiserGradientSamplePositions0" }, { N, "DenoiserPrimaryGradientInputs" },
+                { R, "GBufferViewDepth1" }, { R, "RngSeeds1" }, { R, "DenoiserGradientSamplePositions1" }, { W, "RngSeeds0", "RngSeedsCorrelated" } } },
+            { "Shading", 0, { { N, "ShadingAnalyticOutput" }, { N, "StochasticShadowedShadingOutput" }, { N, "StochasticUnshadowedShadingOutput" },
+                { R, "GBufferAlbedoMetalness" }, { R, "GBufferNormalRoughness" }, { R, "GBufferMotionVector" }, { R, "GBufferTypeAndMaterialIndex" },
+                { R, "GBufferDepthStencil" }, { R, "RngSeedsCorrelated" } } },
+            { "DenoiserPreBlur", 0, { { N, "DenoisedPreBlurIntermediate" }, { N, "StochasticShadowedShadingPreBlurred" }, { N, "StochasticUnshadowedShadingPreBlurred" },
+                { R, "StochasticShadowedShadingOutput" }, { R, "StochasticUnshadowedShadingOutput" } } },
+            { "DenoiserMipGeneration", 0, { { W, "StochasticShadowedShadingPreBlurred", {}, 1, 4 }, { W, "StochasticUnshadowedShadingPreBlurred", {}, 1, 4 } } },
+            { "DenoiserReprojection", 0, { { N, "DenoiserReprojectedFramesCount0" }, { N, "StochasticShadowedShadingReprojected" }, { N, "StochasticUnshadowedShadingReprojected" },
+                { R, "GBufferNormalRoughness" }, { R, "GBufferDepthStencil" }, { R, "GBufferMotionVector" }, { R, "GBufferViewDepth0" }, { R, "GBufferViewDepth1" },
+                { R, "DenoiserReprojectedFramesCount1" }, { R, "StochasticShadowedShadingPreBlurred" }, { R, "StochasticUnshadowedShadingPreBlurred" } } },
+            { "DenoiserGradientConstruction", 0, { { R, "StochasticShadowedShadingPreBlurred" }, { R, "StochasticUnshadowedShadingPreBlurred" },
+                { R, "DenoiserGradientSamplePositions0" }, { R, "DenoiserPrimaryGradientInputs" }, { N, "DenoiserPrimaryGradient" } } },
+            { "DenoiserGradientFiltering", 0, { { W, "DenoiserPrimaryGradient", "DenoiserPrimaryGradientFilteredIntermediate" }, { N, "DenoiserPrimaryGradientFiltered" } } },
+            { "DenoiserHistoryFix", 0, { { R, "GBufferNormalRoughness" }, { R, "GBufferViewDepth0" }, { R, "DenoiserReprojectedFramesCount0" },
+                { W, "StochasticShadowedShadingPreBlurred", "StochasticShadowedShadingFixed" }, { W, "StochasticUnshadowedShadingPreBlurred", "StochasticUnshadowedShadingFixed" },
+                { R, "StochasticShadowedShadingPreBlurred", {}, 1, 4 }, { R, "StochasticUnshadowedShadingPreBlurred", {}, 1, 4 } } },
+            { "SpecularDenoiser", 0, { { R, "GBufferNormalRoughness" }, { R, "GBufferMotionVector" }, { R, "GBufferDepthStencil" }, { R, "GBufferViewDepth0" },
+                { R, "DenoiserReprojectedFramesCount0" }, { R, "StochasticShadowedShadingReprojected" }, { R, "StochasticUnshadowedShadingReprojected" },
+                { R, "StochasticShadowedShadingFixed" }, { R, "StochasticUnshadowedShadingFixed" }, { R, "DenoiserPrimaryGradientFiltered" },
+                { N, "StochasticShadowedShadingDenoised0" }, { N, "StochasticUnshadowedShadingDenoised0" }, { N, "DenoiserSecondaryGradient" } } },
+            { "DenoiserPostStabilization", 0, { { N, "StochasticShadowedShadingDenoisedStabilized" }, { N, "StochasticUnshadowedShadingDenoisedStabilized" },
+                { R, "StochasticShadowedShadingDenoised0" }, { R, "StochasticUnshadowedShadingDenoised0" },
+                { R, "StochasticShadowedShadingReprojected" }, { R, "StochasticUnshadowedShadingReprojected" } } },
+            { "DenoiserPostBlur", 0, { { N, "StochasticShadowedShadingPostBlurred" }, { N, "StochasticUnshadowedShadingPostBlurred" }, { N, "CombinedShading" },
+                { N, "CombinedShadingOversaturated", {}, 0, 4 }, { R, "ShadingAnalyticOutput" }, { R, "StochasticShadowedShadingDenoisedStabilized" },
+                { R, "StochasticUnshadowedShadingDenoisedStabilized" }, { R, "DenoiserReprojectedFramesCount0" }, { R, "DenoiserSecondaryGradient" } } },
+            { "BloomBlur", 0, { { R, "CombinedShadingOversaturated", {}, 0, 4 }, { N, "BloomBlurIntermediate", {}, 0, 4 }, { N, "BloomBlurOutput", {}, 0, 4 } } },
+            { "BloomComposition", 0, { { R, "CombinedShading" }, { R, "BloomBlurOutput" }, { N, "BloomCompositionOutput" } } },
+            { "ToneMapping", 0, { { R, "BloomCompositionOutput" }, { N, "ToneMappingOutput" }, { N, "LuminanceHistogram" } } },
+            { "SMAAEdgeDetection", 0, { { R, "ToneMappingOutput" }, { N, "SMAADetectedEdges" } } },
+            { "SMAABlendingWeightCalculation", 0, { { R, "SMAADetectedEdges" }, { N, "SMAABlendingWeights" } } },
+            { "SMAANeighborhoodBlending", 0, { { R, "ToneMappingOutput" }, { R, "SMAABlendingWeights" }, { N, "SMAAAntialiased" } } },
+            { "UI", 0, { { W, "SMAAAntialiased", "UIOutput" } } },
+            { "BackBufferOutput", 0, { { R, "UIOutput" }, { N, RenderPassGraph::Node::BackBufferName } } },
+            { "GeometryPicking", 0, { { N, "PickedGeometryInfo" } } },
+        };
+    }
+
+    // Mirrors what resource scheduler and render engine do with the graph every frame
+    class ScheduledGraph
+    {
+    public:
+        ScheduledGraph(const std::vector<PassSchedule>& schedule)
+            : mSchedule{ schedule }
+        {
+            for (const PassSchedule& pass : mSchedule)
+            {
+                mGraph.AddPass(RenderPassMetadata{ Foundation::Name{ pass.Name } });
+            }
+        }
+
+        void RegisterDependencies()
+        {
+            mGraph.Clear();
+
+            for (uint64_t passIdx = 0; passIdx < mSchedule.size(); ++passIdx)
+            {
+                RenderPassGraph::Node& node = mGraph.Nodes()[passIdx];
+                node.ExecutionQueueIndex = mSchedule[passIdx].QueueIndex;
+
+                for (const Usage& usage : mSchedule[passIdx].Usages)
+                {
+                    Foundation::Name resourceName = usage.OutputAlias.IsValid() ? usage.OutputAlias : usage.Resource;
+                    std::optional<Foundation::Name> originalName = usage.OutputAlias.IsValid() ? std::optional(usage.Resource) : std::nullopt;
+
+                    usage.Kind == Access::Read ?
+                        node.AddReadDependency(resourceName, usage.FirstMip, usage.LastMip) :
+                        node.AddWriteDependency(resourceName, originalName, usage.FirstMip, usage.LastMip);
+                }
+            }
+        }
+
+        void Build()
+        {
+            mGraph.Build();
+        }
+
+        std::vector<std::string> ExecutionOrder() const
+        {
+            std::vector<std::string> order;
+
+            for (const RenderPassGraph::Node* node : mGraph.NodesInGlobalExecutionOrder())
+            {
+                order.push_back(node->PassMetadata().Name.ToString());
+            }
+
+            return order;
+        }
+
+    private:
+        std::vector<PassSchedule> mSchedule;
+        RenderPassGraph mGraph;
+    };
+}
+
+TEST_CASE(RescheduledFrameKeepsExecutionOrder)
+{
+    ScheduledGraph graph{ DefaultFrameSchedule() };
+
+    graph.RegisterDependencies();
+    graph.Build();
+
+    std::vector<std::string> firstOrder = graph.ExecutionOrder();
+
+    // Common setup pass has no resource dependencies and is culled
+    TEST_CHECK(firstOrder.size() == 22, "Every pass with dependencies must be scheduled, got ", firstOrder.size());
+    TEST_CHECK(firstOrder.front() != "BackBufferOutput" && firstOrder.back() != "GBuffer", "Execution order ignores dependencies");
+
+    // Graph is cleared and refilled every frame, no state may leak between frames
+    for (uint64_t frame = 0; frame < 3; ++frame)
+    {
+        graph.RegisterDependencies();
+        graph.Build();
+
+        TEST_CHECK(graph.ExecutionOrder() == firstOrder, "Frame ", frame, " executes passes in a different order");
+    }
+}
+
+BENCHMARK(ResourceSchedulingAllocations)
+{
+    const uint64_t frameCount = 100;
+
+    ScheduledGraph graph{ DefaultFrameSchedule() };
+
+    // Warm up so that only steady state frames are measured
+    graph.RegisterDependencies();
+    graph.Build();
+
+    uint64_t registrationAllocations = 0;
+    uint64_t buildAllocations = 0;
+
+    double milliseconds = Tests::MeasureBestMilliseconds(1, [&]
+    {
+        for (uint64_t frame = 0; frame < frameCount; ++frame)
+        {
+            uint64_t start = Tests::AllocationCount();
+            graph.RegisterDependencies();
+            uint64_t registered = Tests::AllocationCount();
+            graph.Build();
+
+            registrationAllocations += registered - start;
+            buildAllocations += Tests::AllocationCount() - registered;
+        }
+    });
+
+    Tests::Report("23 default passes, per frame: ", double(registrationAllocations) / frameCount, " allocations registering dependencies, ",
+        double(buildAllocations) / frameCount, " allocations building the graph, ", milliseconds * 1000.0 / frameCount, " us");
+}
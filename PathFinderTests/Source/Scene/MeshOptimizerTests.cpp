@@ -0,0 +1,147 @@
+#include <TestFramework.hpp>
+
+#include <Scene/MeshOptimizer.hpp>
+
+#include "TestMeshes.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    using namespace PathFinder;
+    using namespace TestMeshes;
+
+    bool IsNear(float value, float expected)
+    {
+        return std::abs(value - expected) <= 1e-4f;
+    }
+}
+
+TEST_CASE(VertexCacheMetricsOfKnownSequences)
+{
+    MeshOptimizer::Settings settings;
+    settings.AnalysisCacheSize = 3;
+    MeshOptimizer optimizer{ settings };
+
+    Vertices vertices{ MakeVertex({ 0, 0, 0 }), MakeVertex({ 1, 0, 0 }), MakeVertex({ 0, 1, 0 }), MakeVertex({ 1, 1, 0 }), MakeVertex({ 2, 0, 0 }), MakeVertex({ 2, 1, 0 }) };
+
+    MeshOptimizer::Metrics single = optimizer.Analyze(vertices, { 0, 1, 2 });
+    TEST_CHECK(IsNear(single.ACMR, 3.0f) && IsNear(single.ATVR, 1.0f), "Lone triangle transforms all of its vertices once, ACMR ", single.ACMR, ", ATVR ", single.ATVR);
+
+    MeshOptimizer::Metrics repeated = optimizer.Analyze(vertices, { 0, 1, 2, 0, 1, 2 });
+    TEST_CHECK(IsNear(repeated.ACMR, 1.5f) && IsNear(repeated.ATVR, 1.0f), "Repeated triangle must hit the cache, ACMR ", repeated.ACMR);
+
+    // Second triangle evicts the whole FIFO cache of 3, so the first one is transformed again
+    MeshOptimizer::Metrics evicted = optimizer.Analyze(vertices, { 0, 1, 2, 3, 4, 5, 0, 1, 2 });
+    TEST_CHECK(IsNear(evicted.ACMR, 3.0f) && IsNear(evicted.ATVR, 1.5f), "Evicted vertices must be transformed again, ATVR ", evicted.ATVR);
+}
+
+TEST_CASE(VertexFetchMetricsOfKnownSequences)
+{
+    MeshOptimizer::Settings settings;
+    settings.FetchVertexStride = 16;
+    settings.FetchCacheLineSize = 64;
+    settings.FetchCacheLineCount = 1;
+    MeshOptimizer optimizer{ settings };
+
+    Vertices vertices(8, MakeVertex({ 0, 0, 0 }));
+    vertices[1] = MakeVertex({ 1, 0, 0 });
+    vertices[2] = MakeVertex({ 0, 1, 0 });
+
+    // Sequential vertices share memory lines, each line is fetched once
+    MeshOptimizer::Metrics sequential = optimizer.Analyze(vertices, { 0, 1, 2, 3, 4, 5, 6, 7, 7 });
+    TEST_CHECK(IsNear(sequential.Overfetch, 1.0f), "Sequential fetch must not refetch lines, overfetch ", sequential.Overfetch);
+
+    // Alternating between two lines with a single line cache fetches a whole line per vertex
+    MeshOptimizer::Metrics alternating = optimizer.Analyze(vertices, { 0, 4, 1, 5, 2, 6, 3, 7, 0 });
+    TEST_CHECK(IsNear(alternating.Overfetch, 9.0f * 64.0f / (8.0f * 16.0f)), "Every access must fetch a line, overfetch ", alternating.Overfetch);
+}
+
+TEST_CASE(OverdrawDependsOnDrawOrder)
+{
+    MeshOptimizer optimizer;
+
+    // Two identical quads, one behind another
+    Vertices vertices;
+
+    for (float z : { 0.0f, 1.0f })
+    {
+        vertices.insert(vertices.end(), { MakeVertex({ 0, 0, z }), MakeVertex({ 1, 0, z }), MakeVertex({ 0, 1, z }), MakeVertex({ 1, 1, z }) });
+    }
+
+    Indices nearFirst{ 0, 2, 1, 1, 2, 3, 4, 6, 5, 5, 6, 7 };
+    Indices farFirst{ 4, 6, 5, 5, 6, 7, 0, 2, 1, 1, 2, 3 };
+
+    float nearFirstOverdraw = optimizer.Analyze(vertices, nearFirst).Overdraw;
+    float farFirstOverdraw = optimizer.Analyze(vertices, farFirst).Overdraw;
+
+    // Which quad is near depends on the one view that sees their front faces
+    float minOverdraw = std::min(nearFirstOverdraw, farFirstOverdraw);
+    float maxOverdraw = std::max(nearFirstOverdraw, farFirstOverdraw);
+
+    TEST_CHECK(IsNear(minOverdraw, 1.0f), "Front to back order must shade every pixel once, overdraw ", minOverdraw);
+    TEST_CHECK(IsNear(maxOverdraw, 2.0f), "Back to front order must shade every pixel twice, overdraw ", maxOverdraw);
+}
+
+TEST_CASE(OptimizationImprovesMetricsOfShuffledGrid)
+{
+    MeshOptimizer optimizer;
+    Vertices vertices;
+    Indices indices;
+
+    MakeGrid(32, vertices, indices);
+    ShuffleVertices(vertices, indices, 3);
+    ShuffleTriangles(indices, 5);
+
+    MeshOptimizer::Metrics shuffled = optimizer.Analyze(vertices, indices);
+
+    optimizer.OptimizeVertexCache(indices, vertices.size());
+    MeshOptimizer::Metrics cacheOptimized = optimizer.Analyze(vertices, indices);
+
+    optimizer.OptimizeVertexFetch(vertices, indices);
+    MeshOptimizer::Metrics fetchOptimized = optimizer.Analyze(vertices, indices);
+
+    TEST_CHECK(shuffled.ACMR > 1.5f, "Shuffled grid must thrash the cache, ACMR ", shuffled.ACMR);
+    TEST_CHECK(cacheOptimized.ACMR < 0.8f, "Regular grid must get close to 0.5 ACMR, got ", cacheOptimized.ACMR);
+    TEST_CHECK(IsNear(fetchOptimized.ACMR, cacheOptimized.ACMR), "Vertex remapping must not change cache behavior");
+    TEST_CHECK(cacheOptimized.Overfetch > 1.5f, "Scattered vertices must be fetched with waste, overfetch ", cacheOptimized.Overfetch);
+    TEST_CHECK(fetchOptimized.Overfetch < 1.1f,
+        "Vertices ordered by first use must be fetched almost linearly, overfetch ", fetchOptimized.Overfetch);
+    TEST_CHECK(shuffled.Overdraw >= 1.0f && IsNear(fetchOptimized.Overdraw, 1.0f), "Flat grid has no overdraw, got ", fetchOptimized.Overdraw);
+}
+
+TEST_CASE(WeldingMergesOnlyIdenticalVertices)
+{
+    MeshOptimizer optimizer;
+    Vertices vertices;
+    Indices indices;
+
+    MakeGrid(4, vertices, indices);
+
+    // Unindexed copy, as imported from formats without shared vertices
+    Vertices unindexed;
+
+    for (uint32_t index : indices)
+    {
+        unindexed.push_back(vertices[index]);
+    }
+
+    // Second corner of the first triangle is shared with its neighbours, so its copy stays distinct
+    unindexed[1].UV.x += 0.5f;
+
+    Indices weldedIndices(unindexed.size());
+    std::iota(weldedIndices.begin(), weldedIndices.end(), 0);
+
+    uint64_t weldedCount = optimizer.WeldVertices(unindexed, weldedIndices);
+
+    TEST_CHECK(weldedCount == vertices.size() + 1, "Grid vertices and one distinct copy must remain, got ", weldedCount);
+    TEST_CHECK(weldedIndices.size() == indices.size(), "Welding must keep every triangle");
+
+    for (uint64_t i = 0; i < indices.size(); ++i)
+    {
+        TEST_CHECK(unindexed[weldedIndices[i]].Position == vertices[indices[i]].Position, "Corner ", i, " moved during welding");
+    }
+}
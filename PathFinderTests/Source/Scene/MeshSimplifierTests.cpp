@@ -0,0 +1,175 @@
+#include <TestFramework.hpp>
+
+#include <Scene/MeshSimplifier.hpp>
+
+#include "TestMeshes.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    using namespace PathFinder;
+    using namespace TestMeshes;
+
+    // Closed sphere with radial noise and a UV seam, where first and last segment columns share positions
+    const SphereSettings BumpySphere{ true, 0.03f };
+
+    // Ericson's closest point on triangle
+    float PointTriangleDistance(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+    {
+        glm::vec3 ab = b - a;
+        glm::vec3 ac = c - a;
+        glm::vec3 ap = p - a;
+        float d1 = glm::dot(ab, ap);
+        float d2 = glm::dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) return glm::distance(p, a);
+
+        glm::vec3 bp = p - b;
+        float d3 = glm::dot(ab, bp);
+        float d4 = glm::dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3) return glm::distance(p, b);
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return glm::distance(p, a + ab * (d1 / (d1 - d3)));
+
+        glm::vec3 cp = p - c;
+        float d5 = glm::dot(ab, cp);
+        float d6 = glm::dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6) return glm::distance(p, c);
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return glm::distance(p, a + ac * (d2 / (d2 - d6)));
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) return glm::distance(p, b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+
+        float denominator = 1.0f / (va + vb + vc);
+        return glm::distance(p, a + ab * (vb * denominator) + ac * (vc * denominator));
+    }
+
+    // Largest distance from vertices of source triangles to simplified surface, by brute force
+    float MeasureDeviation(const Vertices& vertices, const Indices& sourceIndices, const Indices& simplifiedIndices)
+    {
+        auto position = [&](uint32_t index) { return glm::vec3{ vertices[index].Position }; };
+        float deviation = 0.0f;
+
+        for (uint32_t index : sourceIndices)
+        {
+            float distance = std::numeric_limits<float>::max();
+
+            for (uint64_t i = 0; i < simplifiedIndices.size(); i += 3)
+            {
+                distance = std::min(distance, PointTriangleDistance(position(index), 
+                    position(simplifiedIndices[i]), position(simplifiedIndices[i + 1]), position(simplifiedIndices[i + 2])));
+            }
+
+            deviation = std::max(deviation, distance);
+        }
+
+        return deviation;
+    }
+
+    float TotalArea(const Vertices& vertices, const Indices& indices)
+    {
+        float area = 0.0f;
+
+        for (uint64_t i = 0; i < indices.size(); i += 3)
+        {
+            glm::vec3 a{ vertices[indices[i]].Position };
+            area += glm::length(glm::cross(glm::vec3{ vertices[indices[i + 1]].Position } - a, glm::vec3{ vertices[indices[i + 2]].Position } - a)) * 0.5f;
+        }
+
+        return area;
+    }
+}
+
+TEST_CASE(ReportedErrorIsDeviationOfSourceVertices)
+{
+    Vertices vertices;
+    Indices indices;
+    MakeSphere(24, 32, vertices, indices, BumpySphere);
+
+    MeshSimplifier simplifier;
+
+    for (uint64_t targetIndexCount : { indices.size() / 2, indices.size() / 4, indices.size() / 10 })
+    {
+        float reportedError = 0.0f;
+        Indices simplified = simplifier.Simplify(vertices, indices, targetIndexCount, std::numeric_limits<float>::max(), reportedError);
+        float measuredError = MeasureDeviation(vertices, indices, simplified);
+
+        // Vertices on seam junctions never move, so small targets may be out of reach
+        TEST_CHECK(simplified.size() <= std::max<uint64_t>(targetIndexCount, indices.size() / 8), "Simplification stopped at ", simplified.size(), " indices");
+        TEST_CHECK(measuredError <= reportedError * 1.0001f + 1e-6f, "Reported error ", reportedError, " underestimates deviation ", measuredError);
+        TEST_CHECK(reportedError <= measuredError * 1.0001f + 1e-6f, "Reported error ", reportedError, " overestimates deviation ", measuredError);
+    }
+}
+
+TEST_CASE(LODChainErrorsGrowWithinLimit)
+{
+    Vertices vertices;
+    Indices indices;
+    MakeSphere(32, 48, vertices, indices, BumpySphere);
+
+    MeshSimplifier simplifier;
+    std::vector<MeshLOD> lods = simplifier.BuildLODChain(vertices, indices);
+
+    // Sphere spans 2 units in every direction
+    float diagonal = 2.0f * std::sqrt(3.0f) * 1.03f;
+    float maxError = simplifier.SimplifierSettings().MaxRelativeError * diagonal;
+
+    TEST_CHECK(!lods.empty() && lods.size() <= MeshLOD::MaxCount, "Sphere must produce a LOD chain, got ", lods.size(), " levels");
+
+    uint64_t previousIndexCount = indices.size();
+    float previousError = 0.0f;
+
+    for (const MeshLOD& lod : lods)
+    {
+        TEST_CHECK(lod.Indices.size() % 3 == 0 && lod.Indices.size() < previousIndexCount, "Each level must have fewer whole triangles");
+        TEST_CHECK(std::all_of(lod.Indices.begin(), lod.Indices.end(), [&](uint32_t index) { return index < vertices.size(); }), "Levels must index base vertices");
+        TEST_CHECK(lod.Error >= previousError, "Level error ", lod.Error, " is below error of a finer level ", previousError);
+        TEST_CHECK(lod.Error <= maxError, "Level error ", lod.Error, " exceeds chain limit ", maxError);
+
+        // Errors are relative to the base mesh, not to the previous level
+        float measuredError = MeasureDeviation(vertices, indices, lod.Indices);
+        TEST_CHECK(measuredError <= lod.Error * 1.0001f + 1e-6f, "Level error ", lod.Error, " underestimates deviation from base mesh ", measuredError);
+
+        previousIndexCount = lod.Indices.size();
+        previousError = lod.Error;
+    }
+}
+
+TEST_CASE(FlatGridSimplifiesWithoutErrorAndKeepsBorder)
+{
+    const uint32_t size = 16;
+    Vertices vertices;
+    Indices indices;
+
+    for (uint32_t y = 0; y <= size; ++y)
+    {
+        for (uint32_t x = 0; x <= size; ++x)
+        {
+            glm::vec2 uv{ float(x) / size, float(y) / size };
+            vertices.push_back(MakeVertex(glm::vec3{ uv.x, 0.0f, uv.y }, uv, glm::vec3{ 0.0f, 1.0f, 0.0f }));
+        }
+    }
+
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            uint32_t corner = y * (size + 1) + x;
+            indices.insert(indices.end(), { corner, corner + size + 1, corner + 1, corner + 1, corner + size + 1, corner + size + 2 });
+        }
+    }
+
+    // Any collapse of a border corner moves the outline by a cell, which is far above target error
+    float reportedError = 1.0f;
+    Indices simplified = MeshSimplifier{}.Simplify(vertices, indices, 0, 1e-3f, reportedError);
+
+    TEST_CHECK(simplified.size() < indices.size() / 4, "Plane interior must collapse, ", simplified.size() / 3, " triangles left");
+    TEST_CHECK(reportedError <= 1e-6f, "Collapses within a plane must not deviate, error is ", reportedError);
+    TEST_CHECK(std::abs(TotalArea(vertices, simplified) - 1.0f) <= 1e-4f, "Open border must stay in place, area is ", TotalArea(vertices, simplified));
+}
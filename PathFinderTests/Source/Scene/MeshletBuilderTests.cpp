@@ -0,0 +1,190 @@
+#include <TestFramework.hpp>
+
+#include <Scene/MeshletBuilder.hpp>
+
+#include "TestMeshes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+    using namespace PathFinder;
+    using namespace TestMeshes;
+
+    using Triangle = std::array<uint32_t, 3>;
+
+    // Unit sphere with degenerate triangles around poles, as most exported UV spheres have
+    const SphereSettings StripPoleSphere{ false };
+
+    // Rotated so that the smallest index comes first, winding is preserved
+    Triangle Canonical(Triangle triangle)
+    {
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        return triangle;
+    }
+
+    glm::vec3 MeshletPosition(const Vertices& vertices, const MeshletBuilder::Result& result, const Meshlet& meshlet, uint32_t localIndex)
+    {
+        return glm::vec3{ vertices[result.Vertices[meshlet.VertexOffset + localIndex]].Position };
+    }
+
+    glm::vec3 MeshletCorner(const Vertices& vertices, const MeshletBuilder::Result& result, const Meshlet& meshlet, uint32_t triangle, uint32_t corner)
+    {
+        return MeshletPosition(vertices, result, meshlet, result.Triangles[(meshlet.TriangleOffset + triangle) * 3 + corner]);
+    }
+}
+
+TEST_CASE(MeshletsCoverEveryTriangleOnceWithinLimits)
+{
+    Vertices vertices;
+    Indices indices;
+    MakeSphere(32, 48, vertices, indices, StripPoleSphere);
+    ShuffleTriangles(indices, 3);
+
+    for (MeshletBuilder::Settings settings : { MeshletBuilder::Settings{}, MeshletBuilder::Settings{ 8, 6 } })
+    {
+        MeshletBuilder::Result result = MeshletBuilder{ settings }.Build(vertices, indices);
+
+        std::multiset<Triangle> expectedTriangles;
+        std::multiset<Triangle> meshletTriangles;
+
+        for (uint64_t i = 0; i < indices.size(); i += 3)
+        {
+            expectedTriangles.insert(Canonical({ indices[i], indices[i + 1], indices[i + 2] }));
+        }
+
+        for (const Meshlet& meshlet : result.Meshlets)
+        {
+            TEST_CHECK(meshlet.VertexCount <= settings.MaxVertexCount && meshlet.TriangleCount <= settings.MaxTriangleCount,
+                "Meshlet of ", meshlet.VertexCount, " vertices and ", meshlet.TriangleCount, " triangles exceeds limits");
+            TEST_CHECK(meshlet.TriangleCount > 0, "Meshlets must not be empty");
+
+            std::vector<bool> isVertexUsed(meshlet.VertexCount, false);
+
+            for (uint32_t triangle = 0; triangle < meshlet.TriangleCount; ++triangle)
+            {
+                Triangle meshTriangle;
+
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    uint8_t localIndex = result.Triangles[(meshlet.TriangleOffset + triangle) * 3 + corner];
+                    TEST_CHECK(localIndex < meshlet.VertexCount, "Local index ", uint32_t(localIndex), " is outside of meshlet vertices");
+
+                    isVertexUsed[localIndex] = true;
+                    meshTriangle[corner] = result.Vertices[meshlet.VertexOffset + localIndex];
+                }
+
+                meshletTriangles.insert(Canonical(meshTriangle));
+            }
+
+            TEST_CHECK(std::all_of(isVertexUsed.begin(), isVertexUsed.end(), [](bool isUsed) { return isUsed; }), "Meshlet references unused vertices");
+        }
+
+        TEST_CHECK(meshletTriangles == expectedTriangles, "Meshlets must hold every triangle exactly once with its winding");
+    }
+}
+
+TEST_CASE(BoundsEncloseMeshletVertices)
+{
+    Vertices vertices;
+    Indices indices;
+    MakeSphere(24, 32, vertices, indices, StripPoleSphere);
+    ShuffleTriangles(indices, 3);
+
+    MeshletBuilder::Result result = MeshletBuilder{}.Build(vertices, indices);
+
+    for (const Meshlet& meshlet : result.Meshlets)
+    {
+        glm::vec3 boxMin{ std::numeric_limits<float>::max() };
+        glm::vec3 boxMax{ std::numeric_limits<float>::lowest() };
+
+        for (uint32_t localIndex = 0; localIndex < meshlet.VertexCount; ++localIndex)
+        {
+            glm::vec3 position = MeshletPosition(vertices, result, meshlet, localIndex);
+            boxMin = glm::min(boxMin, position);
+            boxMax = glm::max(boxMax, position);
+
+            float distance = glm::distance(position, meshlet.BoundingSphereCenter);
+            TEST_CHECK(distance <= meshlet.BoundingSphereRadius, "Vertex is ", distance - meshlet.BoundingSphereRadius, " outside of bounding sphere");
+        }
+
+        TEST_CHECK(boxMin == meshlet.BoundingBox.Min && boxMax == meshlet.BoundingBox.Max, "Bounding box must be exactly the vertex extents");
+
+        // Ritter's sphere is not minimal, but it never exceeds the sphere around the box
+        TEST_CHECK(meshlet.BoundingSphereRadius <= glm::distance(boxMin, boxMax), "Bounding sphere is unreasonably loose");
+    }
+}
+
+TEST_CASE(NormalConesOnlyCullBackFacingMeshlets)
+{
+    Vertices vertices;
+    Indices indices;
+    MakeSphere(32, 48, vertices, indices, StripPoleSphere);
+    ShuffleTriangles(indices, 3);
+
+    MeshletBuilder::Result result = MeshletBuilder{}.Build(vertices, indices);
+
+    std::mt19937 random{ 5 };
+    std::uniform_real_distribution<float> offset{ -4.0f, 4.0f };
+
+    uint64_t cullableMeshletCount = 0;
+    uint64_t culledCount = 0;
+
+    for (const Meshlet& meshlet : result.Meshlets)
+    {
+        if (meshlet.ConeCutoff >= 1.0f)
+        {
+            continue;
+        }
+
+        ++cullableMeshletCount;
+
+        for (uint32_t cameraIdx = 0; cameraIdx < 200; ++cameraIdx)
+        {
+            glm::vec3 camera = meshlet.BoundingSphereCenter + glm::vec3{ offset(random), offset(random), offset(random) };
+
+            if (glm::dot(glm::normalize(meshlet.ConeApex - camera), meshlet.ConeAxis) <= meshlet.ConeCutoff)
+            {
+                continue;
+            }
+
+            ++culledCount;
+
+            for (uint32_t triangle = 0; triangle < meshlet.TriangleCount; ++triangle)
+            {
+                glm::vec3 a = MeshletCorner(vertices, result, meshlet, triangle, 0);
+                glm::vec3 normal = glm::cross(MeshletCorner(vertices, result, meshlet, triangle, 1) - a, MeshletCorner(vertices, result, meshlet, triangle, 2) - a);
+
+                TEST_CHECK(glm::dot(camera - a, normal) <= 1e-6f, "Culled meshlet has a triangle facing the camera");
+            }
+        }
+    }
+
+    // Sphere meshlets are small patches with narrow cones, most of them must be cullable
+    TEST_CHECK(cullableMeshletCount * 2 > result.Meshlets.size(), "Only ", cullableMeshletCount, " of ", result.Meshlets.size(), " meshlets got a usable cone");
+    TEST_CHECK(culledCount > 0, "Cones must cull some meshlets seen from behind");
+}
+
+TEST_CASE(FlatMeshletConeMatchesPlaneNormal)
+{
+    Vertex1P1N1UV1T1BT vertex{ glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f } };
+    Vertices vertices(4, vertex);
+    vertices[1].Position = glm::vec4{ 1.0f, 0.0f, 0.0f, 1.0f };
+    vertices[2].Position = glm::vec4{ 0.0f, 1.0f, 0.0f, 1.0f };
+    vertices[3].Position = glm::vec4{ 1.0f, 1.0f, 0.0f, 1.0f };
+
+    MeshletBuilder::Result result = MeshletBuilder{}.Build(vertices, { 0, 1, 2, 1, 3, 2 });
+
+    TEST_CHECK(result.Meshlets.size() == 1, "Quad must fit into one meshlet");
+
+    const Meshlet& meshlet = result.Meshlets.front();
+
+    TEST_CHECK(glm::distance(meshlet.ConeAxis, glm::vec3{ 0.0f, 0.0f, 1.0f }) < 1e-6f, "Cone axis must be the plane normal");
+    TEST_CHECK(meshlet.ConeCutoff < 1e-6f, "Coplanar triangles are back facing from the whole half space behind them");
+}
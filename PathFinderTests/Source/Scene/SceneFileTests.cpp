@@ -0,0 +1,428 @@
+#include <TestFramework.hpp>
+
+#include <Scene/SceneFile.hpp>
+#include <Scene/MeshletBuilder.hpp>
+#include <Scene/MeshSimplifier.hpp>
+
+#include "TestMeshes.hpp"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace PathFinder;
+    using namespace SceneFileFormat;
+    using namespace TestMeshes;
+
+    using LoadResult = SceneFile::LoadResult;
+
+    // Closed unit sphere with single point poles, so it can be simplified into a full LOD chain
+    Mesh MakeSphereMesh(uint32_t ringCount, uint32_t segmentCount)
+    {
+        Vertices vertices;
+        Indices indices;
+        MakeSphere(ringCount, segmentCount, vertices, indices);
+
+        Mesh mesh;
+        mesh.SetName("Sphere");
+
+        for (const Vertex1P1N1UV1T1BT& vertex : vertices)
+        {
+            mesh.AddVertex(vertex);
+        }
+
+        for (uint32_t index : indices)
+        {
+            mesh.AddIndex(index);
+        }
+
+        MeshletBuilder{ MeshletBuilder::Settings{ 16, 16 } }.Build(mesh);
+        MeshSimplifier{}.BuildLODChain(mesh);
+
+        return mesh;
+    }
+
+    // Mesh without meshlets and LODs
+    Mesh MakeTriangleMesh()
+    {
+        Mesh mesh;
+
+        for (glm::vec3 position : { glm::vec3{ 0.0f, 0.0f, 0.0f }, glm::vec3{ 1.0f, 0.0f, 0.0f }, glm::vec3{ 0.0f, 0.0f, 1.0f } })
+        {
+            mesh.AddVertex(Vertex1P1N1UV1T1BT{ glm::vec4{ position, 1.0f }, glm::vec2{ position.x, position.z },
+                glm::vec3{ 0.0f, 1.0f, 0.0f }, glm::vec3{ 1.0f, 0.0f, 0.0f }, glm::vec3{ 0.0f, 0.0f, 1.0f } });
+        }
+
+        for (uint32_t index : { 0u, 2u, 1u })
+        {
+            mesh.AddIndex(index);
+        }
+
+        mesh.SetHasTangentSpace(true);
+
+        return mesh;
+    }
+
+    template <class T>
+    bool IsBitIdentical(const std::vector<T>& a, const std::vector<T>& b)
+    {
+        return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+    }
+
+    bool IsEqual(const Mesh& a, const Mesh& b)
+    {
+        if (a.LODs().size() != b.LODs().size())
+        {
+            return false;
+        }
+
+        for (uint64_t lodIdx = 0; lodIdx < a.LODs().size(); ++lodIdx)
+        {
+            if (a.LODs()[lodIdx].Indices != b.LODs()[lodIdx].Indices || a.LODs()[lodIdx].Error != b.LODs()[lodIdx].Error)
+            {
+                return false;
+            }
+        }
+
+        return a.Name() == b.Name() &&
+            IsBitIdentical(a.Vertices(), b.Vertices()) &&
+            a.Indices() == b.Indices() &&
+            a.BoundingBox().Min == b.BoundingBox().Min &&
+            a.BoundingBox().Max == b.BoundingBox().Max &&
+            a.SurfaceArea() == b.SurfaceArea() &&
+            a.HasTangentSpace() == b.HasTangentSpace() &&
+            IsBitIdentical(a.Meshlets(), b.Meshlets()) &&
+            a.MeshletVertices() == b.MeshletVertices() &&
+            a.MeshletTriangles() == b.MeshletTriangles();
+    }
+
+    bool IsEqual(const Light& a, const Light& b)
+    {
+        return a.Color().R() == b.Color().R() && a.Color().G() == b.Color().G() && a.Color().B() == b.Color().B() && a.Color().A() == b.Color().A() &&
+            a.Color().CurrentSpace() == b.Color().CurrentSpace() && a.LuminousPower() == b.LuminousPower() && a.Luminance() == b.Luminance();
+    }
+
+    // Scene files are only read through a memory mapping.
+    // Every case gets its own file, since mapped files can't be overwritten on some platforms.
+    LoadResult Open(SceneFile& sceneFile, const std::vector<uint8_t>& bytes, const std::string& name)
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / ("PathFinderTests" + name + ".pfscene");
+
+        {
+            std::ofstream stream{ path, std::ios::out | std::ios::binary | std::ios::trunc };
+            stream.write((const char*)bytes.data(), bytes.size());
+        }
+
+        Foundation::MemoryMappedFile file;
+
+        if (!file.Open(path))
+        {
+            return LoadResult::FileMissing;
+        }
+
+        return sceneFile.Open(std::move(file));
+    }
+
+    LoadResult Open(const std::vector<uint8_t>& bytes, const std::string& name)
+    {
+        SceneFile sceneFile;
+        LoadResult result = Open(sceneFile, bytes, name);
+
+        TEST_CHECK(result == LoadResult::Loaded || (sceneFile.MeshCount() == 0 && sceneFile.MeshInstanceCount() == 0),
+            "Rejected file ", name, " must not expose any records");
+
+        return result;
+    }
+
+    // Records are patched in place, file bytes are allocated with alignment suitable for any of them
+    template <class T>
+    T* Records(std::vector<uint8_t>& bytes, const ArrayRef<T>& ref)
+    {
+        return reinterpret_cast<T*>(bytes.data() + ref.Offset);
+    }
+
+    Header& FileHeader(std::vector<uint8_t>& bytes)
+    {
+        return *reinterpret_cast<Header*>(bytes.data());
+    }
+
+    MeshRecord& SphereRecord(std::vector<uint8_t>& bytes)
+    {
+        return Records(bytes, FileHeader(bytes).Meshes)[0];
+    }
+
+    template <class T>
+    constexpr uint64_t OverflowingCount()
+    {
+        // Count times record size wraps around to a small number
+        return std::numeric_limits<uint64_t>::max() / sizeof(T) + 2;
+    }
+
+    struct SceneContents
+    {
+        std::vector<Mesh> Meshes;
+        std::vector<Material> Materials;
+        std::vector<MeshInstance> Instances;
+        FlatLight Rectangle{ FlatLight::Type::Rectangle };
+        FlatLight Disk{ FlatLight::Type::Disk };
+        SphericalLight Sphere;
+        Camera SceneCamera;
+    };
+
+    void MakeScene(SceneContents& scene)
+    {
+        scene.Meshes.push_back(MakeSphereMesh(12, 24));
+        scene.Meshes.push_back(MakeTriangleMesh());
+
+        scene.Materials.resize(2);
+        scene.Materials[0].AlbedoMapPath = "/MediaResources/Textures/Metal/Albedo.dds";
+        scene.Materials[0].NormalMapPath = "/MediaResources/Textures/Metal/Normal.dds";
+        scene.Materials[0].DisplacementMapPath = "/MediaResources/Textures/Metal/Displacement.dds";
+        scene.Materials[0].DistanceFieldPath = "/Cache/Metal/DistanceField.dds";
+        scene.Materials[1].AlbedoMapPath = "/MediaResources/Textures/Plastic/Albedo.dds";
+        scene.Materials[1].AOMapPath = "/MediaResources/Textures/Plastic/AO.dds";
+
+        for (uint32_t i = 0; i < 5; ++i)
+        {
+            MeshInstance& instance = scene.Instances.emplace_back(&scene.Meshes[i % 2], &scene.Materials[(i / 2) % 2]);
+
+            Geometry::Transformation transformation;
+            transformation.Scale = glm::vec3{ 0.5f + i, 1.0f, i % 2 ? -1.0f : 1.0f };
+            transformation.Translation = glm::vec3{ float(i), -3.0f * i, 0.25f };
+            transformation.Rotation = glm::angleAxis(0.3f * i, glm::normalize(glm::vec3{ 1.0f, 2.0f, 3.0f }));
+            instance.SetTransformation(transformation);
+        }
+
+        scene.Rectangle.SetWidth(7.0f);
+        scene.Rectangle.SetHeight(4.0f);
+        scene.Rectangle.SetNormal({ 0.0f, -1.0f, 0.0f });
+        scene.Rectangle.SetPosition({ 10.65f, 15.0f, -4.6f });
+        scene.Rectangle.SetColor({ 1.0f, 0.9f, 0.8f });
+        scene.Rectangle.SetLuminousPower(40000.0f);
+
+        scene.Disk.SetWidth(2.0f);
+        scene.Disk.SetHeight(3.0f);
+        scene.Disk.SetNormal(glm::normalize(glm::vec3{ 1.0f, 1.0f, 0.0f }));
+        scene.Disk.SetPosition({ 1.0f, 2.0f, 3.0f });
+        scene.Disk.SetColor({ 0.2f, 0.3f, 0.4f, 0.5f, Foundation::Color::Space::sRGB });
+        scene.Disk.SetLuminousPower(1000.0f);
+
+        scene.Sphere.SetRadius(7.5f);
+        scene.Sphere.SetPosition({ -10.65f, 12.0f, -4.6f });
+        scene.Sphere.SetColor({ 0.25f, 0.6f, 1.0f });
+        scene.Sphere.SetLuminousPower(100000.0f);
+
+        scene.SceneCamera.SetNearPlane(1.0f);
+        scene.SceneCamera.SetFarPlane(500.0f);
+        scene.SceneCamera.MoveTo({ 63.65f, 6.41f, -32.7f });
+        scene.SceneCamera.LookAt({ 0.0f, 0.0f, 0.0f });
+        scene.SceneCamera.SetAperture(1.2f);
+        scene.SceneCamera.SetFilmSpeed(800.0f);
+        scene.SceneCamera.SetShutterTime(1.0f / 125.0f);
+        scene.SceneCamera.SetFieldOfView(75.0f);
+    }
+
+    std::vector<uint8_t> WriteScene(const SceneContents& scene)
+    {
+        SceneFileWriter writer;
+
+        for (const Mesh& mesh : scene.Meshes) writer.AddMesh(mesh);
+        for (const Material& material : scene.Materials) writer.AddMaterial(material);
+
+        for (const MeshInstance& instance : scene.Instances)
+        {
+            writer.AddMeshInstance(instance, uint32_t(instance.AssociatedMesh() - scene.Meshes.data()), uint32_t(instance.AssociatedMaterial() - scene.Materials.data()));
+        }
+
+        writer.AddLight(scene.Rectangle);
+        writer.AddLight(scene.Disk);
+        writer.AddLight(scene.Sphere);
+        writer.SetCamera(scene.SceneCamera);
+
+        return writer.Finish();
+    }
+}
+
+TEST_CASE(SceneSurvivesRoundTrip)
+{
+    SceneContents scene;
+    MakeScene(scene);
+
+    TEST_CHECK(!scene.Meshes[0].Meshlets().empty() && !scene.Meshes[0].LODs().empty(), "Sphere must have meshlets and LODs to round trip");
+
+    std::vector<uint8_t> bytes = WriteScene(scene);
+    SceneFile file;
+
+    TEST_CHECK(Open(file, bytes, "RoundTrip") == LoadResult::Loaded, "Written scene must load");
+    TEST_CHECK(file.MeshCount() == 2 && file.MaterialCount() == 2 && file.MeshInstanceCount() == 5 && file.FlatLightCount() == 2 && file.SphericalLightCount() == 1,
+        "Record counts changed");
+
+    if (file.MeshCount() != 2)
+    {
+        return;
+    }
+
+    for (uint64_t meshIdx = 0; meshIdx < scene.Meshes.size(); ++meshIdx)
+    {
+        TEST_CHECK(IsEqual(file.ReadMesh(meshIdx), scene.Meshes[meshIdx]), "Mesh ", meshIdx, " differs after round trip");
+    }
+
+    for (uint64_t materialIdx = 0; materialIdx < scene.Materials.size(); ++materialIdx)
+    {
+        Material material = file.ReadMaterial(materialIdx);
+        const Material& expected = scene.Materials[materialIdx];
+
+        TEST_CHECK(material.AlbedoMapPath == expected.AlbedoMapPath && material.NormalMapPath == expected.NormalMapPath &&
+            material.RoughnessMapPath == expected.RoughnessMapPath && material.MetalnessMapPath == expected.MetalnessMapPath &&
+            material.AOMapPath == expected.AOMapPath && material.DisplacementMapPath == expected.DisplacementMapPath &&
+            material.DistanceFieldPath == expected.DistanceFieldPath, "Material ", materialIdx, " paths differ after round trip");
+    }
+
+    for (uint64_t instanceIdx = 0; instanceIdx < scene.Instances.size(); ++instanceIdx)
+    {
+        SceneFile::MeshInstanceDescription instance = file.ReadMeshInstance(instanceIdx);
+        const Geometry::Transformation& expected = scene.Instances[instanceIdx].Transformation();
+
+        TEST_CHECK(instance.MeshIndex == instanceIdx % 2 && instance.MaterialIndex == (instanceIdx / 2) % 2, "Instance ", instanceIdx, " references wrong mesh or material");
+        TEST_CHECK(instance.Transformation.Scale == expected.Scale && instance.Transformation.Translation == expected.Translation &&
+            instance.Transformation.Rotation == expected.Rotation, "Instance ", instanceIdx, " transformation differs after round trip");
+    }
+
+    const FlatLight* expectedFlatLights[] = { &scene.Rectangle, &scene.Disk };
+
+    for (uint64_t lightIdx = 0; lightIdx < 2; ++lightIdx)
+    {
+        const FlatLight& expected = *expectedFlatLights[lightIdx];
+        FlatLight light{ file.FlatLightType(lightIdx) };
+        file.ReadFlatLight(lightIdx, light);
+
+        TEST_CHECK(light.LightType() == expected.LightType() && glm::distance(light.Normal(), expected.Normal()) < 1e-6f && light.Position() == expected.Position() &&
+            light.Width() == expected.Width() && light.Height() == expected.Height() && IsEqual(light, expected), "Flat light ", lightIdx, " differs after round trip");
+    }
+
+    SphericalLight sphere;
+    file.ReadSphericalLight(0, sphere);
+
+    TEST_CHECK(sphere.Position() == scene.Sphere.Position() && sphere.Radius() == scene.Sphere.Radius() && IsEqual(sphere, scene.Sphere), "Spherical light differs after round trip");
+
+    Camera camera;
+    const Camera& expectedCamera = scene.SceneCamera;
+
+    TEST_CHECK(file.ReadCamera(camera), "Camera must be restored");
+    TEST_CHECK(camera.Position() == expectedCamera.Position() && camera.Front() == expectedCamera.Front() && camera.Up() == expectedCamera.Up() &&
+        camera.NearClipPlane() == expectedCamera.NearClipPlane() && camera.FarClipPlane() == expectedCamera.FarClipPlane() && camera.FOVH() == expectedCamera.FOVH() &&
+        camera.Aperture() == expectedCamera.Aperture() && camera.FilmSpeed() == expectedCamera.FilmSpeed() && camera.ShutterTime() == expectedCamera.ShutterTime(),
+        "Camera differs after round trip");
+}
+
+TEST_CASE(TruncatedFilesAreRejected)
+{
+    SceneContents scene;
+    MakeScene(scene);
+    const std::vector<uint8_t> bytes = WriteScene(scene);
+
+    for (uint64_t size : { uint64_t(1), uint64_t(sizeof(Header) - 1), uint64_t(sizeof(Header)), bytes.size() / 2, bytes.size() - 1 })
+    {
+        std::vector<uint8_t> truncated{ bytes.begin(), bytes.begin() + size };
+        TEST_CHECK(Open(truncated, "Truncated") == LoadResult::Corrupted, "File truncated to ", size, " of ", bytes.size(), " bytes must be rejected");
+
+        // Header that agrees with truncated size leaves only references to catch it
+        if (size >= sizeof(Header))
+        {
+            FileHeader(truncated).FileSize = size;
+            TEST_CHECK(Open(truncated, "Truncated") == LoadResult::Corrupted, "File truncated to ", size, " bytes with patched size must be rejected");
+        }
+    }
+
+    std::vector<uint8_t> extended = bytes;
+    extended.resize(bytes.size() + 16);
+    TEST_CHECK(Open(extended, "Extended") == LoadResult::Corrupted, "File with trailing bytes must be rejected");
+}
+
+TEST_CASE(ForeignFilesAreRejected)
+{
+    SceneContents scene;
+    MakeScene(scene);
+    const std::vector<uint8_t> bytes = WriteScene(scene);
+
+    TEST_CHECK(Open(bytes, "Intact") == LoadResult::Loaded, "Intact file must load");
+
+    std::vector<uint8_t> badMagic = bytes;
+    FileHeader(badMagic).Magic ^= 0x100;
+    TEST_CHECK(Open(badMagic, "BadMagic") == LoadResult::Corrupted, "File with wrong magic must be rejected");
+
+    for (int32_t versionDelta : { -1, 1 })
+    {
+        std::vector<uint8_t> otherVersion = bytes;
+        FileHeader(otherVersion).FormatVersion += versionDelta;
+        TEST_CHECK(Open(otherVersion, "OtherVersion") == LoadResult::FormatMismatch, "File of version ", FileHeader(otherVersion).FormatVersion, " must be a format mismatch");
+    }
+
+    SceneFile missing;
+    TEST_CHECK(missing.Open(std::filesystem::temp_directory_path() / "PathFinderTestsMissing.pfscene") == LoadResult::FileMissing, "Missing file must be reported");
+}
+
+TEST_CASE(DamagedReferencesAreRejected)
+{
+    SceneContents scene;
+    MakeScene(scene);
+    const std::vector<uint8_t> bytes = WriteScene(scene);
+
+    struct Damage
+    {
+        const char* Name;
+        std::function<void(std::vector<uint8_t>&)> Apply;
+    };
+
+    const uint32_t sphereVertexCount = uint32_t(scene.Meshes[0].Vertices().size());
+
+    Damage damages[] = {
+        // Overflowing counts
+        { "MeshCountOverflow", [](auto& b) { FileHeader(b).Meshes.Count = OverflowingCount<MeshRecord>(); } },
+        { "InstanceCountOverflow", [](auto& b) { FileHeader(b).MeshInstances.Count = OverflowingCount<MeshInstanceRecord>(); } },
+        { "VertexCountOverflow", [](auto& b) { SphereRecord(b).Vertices.Count = OverflowingCount<Vertex1P1N1UV1T1BT>(); } },
+        { "IndexCountOverflow", [](auto& b) { SphereRecord(b).Indices.Count = OverflowingCount<uint32_t>(); } },
+        { "MeshletCountOverflow", [](auto& b) { SphereRecord(b).Meshlets.Count = OverflowingCount<Meshlet>(); } },
+        { "LODCountOverflow", [](auto& b) { SphereRecord(b).LODs.Count = OverflowingCount<LODRecord>(); } },
+        { "CameraSizeOverflow", [](auto& b) { FileHeader(b).Camera.Count = std::numeric_limits<uint64_t>::max(); } },
+        { "NameOutsideOfFile", [](auto& b) { SphereRecord(b).Name.Offset = std::numeric_limits<uint64_t>::max(); } },
+        { "TooManyLODs", [](auto& b) { SphereRecord(b).LODs.Count = MeshLOD::MaxCount + 1; } },
+
+        // Misaligned offsets
+        { "MisalignedMeshes", [](auto& b) { FileHeader(b).Meshes.Offset += 4; } },
+        { "MisalignedLights", [](auto& b) { FileHeader(b).FlatLights.Offset += 2; } },
+        { "MisalignedVertices", [](auto& b) { SphereRecord(b).Vertices.Offset += 1; } },
+        { "MisalignedIndices", [](auto& b) { SphereRecord(b).Indices.Offset += 2; } },
+        { "MisalignedLODs", [](auto& b) { SphereRecord(b).LODs.Offset += 4; } },
+
+        // Out of range indices
+        { "PartialTriangle", [](auto& b) { SphereRecord(b).Indices.Count -= 1; } },
+        { "VertexIndex", [=](auto& b) { Records(b, SphereRecord(b).Indices)[7] = sphereVertexCount; } },
+        { "LODVertexIndex", [=](auto& b) { Records(b, Records(b, SphereRecord(b).LODs)[0].Indices)[0] = sphereVertexCount; } },
+        { "MeshletVertexIndex", [=](auto& b) { Records(b, SphereRecord(b).MeshletVertices)[3] = sphereVertexCount; } },
+        { "MeshletVertexRange", [](auto& b) { Records(b, SphereRecord(b).Meshlets)[1].VertexOffset = uint32_t(SphereRecord(b).MeshletVertices.Count); } },
+        { "MeshletTriangleRange", [](auto& b) { Records(b, SphereRecord(b).Meshlets)[1].TriangleCount = std::numeric_limits<uint32_t>::max(); } },
+        { "MeshletLocalIndex", [](auto& b) { Records(b, SphereRecord(b).MeshletTriangles)[Records(b, SphereRecord(b).Meshlets)[0].TriangleOffset * 3] = 255; } },
+        { "InstanceMeshIndex", [](auto& b) { Records(b, FileHeader(b).MeshInstances)[2].MeshIndex = 2; } },
+        { "InstanceMaterialIndex", [](auto& b) { Records(b, FileHeader(b).MeshInstances)[4].MaterialIndex = 2; } },
+        { "FlatLightType", [](auto& b) { Records(b, FileHeader(b).FlatLights)[1].Type = 2; } },
+    };
+
+    for (const Damage& damage : damages)
+    {
+        std::vector<uint8_t> damaged = bytes;
+        damage.Apply(damaged);
+
+        TEST_CHECK(damaged != bytes, "Damage ", damage.Name, " changed nothing");
+        TEST_CHECK(Open(damaged, damage.Name) == LoadResult::Corrupted, "File with damage ", damage.Name, " must be rejected");
+    }
+}
@@ -0,0 +1,185 @@
+#include <TestFramework.hpp>
+
+#include <Scene/TangentSpaceGenerator.hpp>
+
+#include "TestMeshes.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    using namespace PathFinder;
+    using namespace TestMeshes;
+
+    // Reference frames are analytic, generated ones may only differ by rounding
+    constexpr float MaxAngleError = 1e-3f;
+
+    float AngleInDegrees(const glm::vec3& a, const glm::vec3& b)
+    {
+        return glm::degrees(std::acos(std::clamp(glm::dot(glm::normalize(a), glm::normalize(b)), -1.0f, 1.0f)));
+    }
+
+    bool HasOrthonormalFrames(const Vertices& vertices)
+    {
+        return std::all_of(vertices.begin(), vertices.end(), [](const Vertex1P1N1UV1T1BT& vertex)
+        {
+            return std::isfinite(vertex.Tangent.x) && std::isfinite(vertex.Bitangent.x) &&
+                std::abs(glm::length(vertex.Tangent) - 1.0f) < 1e-4f &&
+                std::abs(glm::length(vertex.Bitangent) - 1.0f) < 1e-4f &&
+                std::abs(glm::dot(vertex.Tangent, glm::normalize(vertex.Normal))) < 1e-4f;
+        });
+    }
+}
+
+TEST_CASE(PlanarGridFramesFollowUVAxes)
+{
+    Vertices vertices;
+    Indices indices;
+    MakeGrid(16, vertices, indices);
+
+    TangentSpaceGenerator{}.Generate(vertices, indices);
+
+    TEST_CHECK(vertices.size() == 17 * 17, "Continuous UV mapping must not split vertices, got ", vertices.size());
+    TEST_CHECK(HasOrthonormalFrames(vertices), "Frames must be orthonormal");
+
+    for (const Vertex1P1N1UV1T1BT& vertex : vertices)
+    {
+        TEST_CHECK(AngleInDegrees(vertex.Tangent, glm::vec3{ 1.0f, 0.0f, 0.0f }) < MaxAngleError, "Tangent must point along +U");
+        TEST_CHECK(AngleInDegrees(vertex.Bitangent, glm::vec3{ 0.0f, 1.0f, 0.0f }) < MaxAngleError, "Bitangent must point along +V");
+    }
+}
+
+TEST_CASE(MirroredUVsSplitVerticesOnSeam)
+{
+    Vertices vertices;
+    Indices indices;
+    MakeGrid(16, vertices, indices, true);
+
+    uint64_t vertexCount = vertices.size();
+    TangentSpaceGenerator{}.Generate(vertices, indices);
+
+    TEST_CHECK(vertices.size() == vertexCount + 17, "Column of vertices on the mirror seam must be split, got ", vertices.size() - vertexCount, " new vertices");
+    TEST_CHECK(HasOrthonormalFrames(vertices), "Frames must be orthonormal");
+
+    for (uint64_t corner = 0; corner < indices.size(); ++corner)
+    {
+        uint64_t triangle = corner / 3;
+        float centerX = 0.0f;
+
+        for (uint32_t triangleCorner = 0; triangleCorner < 3; ++triangleCorner)
+        {
+            centerX += vertices[indices[triangle * 3 + triangleCorner]].Position.x / 3.0f;
+        }
+
+        const Vertex1P1N1UV1T1BT& vertex = vertices[indices[corner]];
+        glm::vec3 expectedTangent{ centerX > 0.5f ? -1.0f : 1.0f, 0.0f, 0.0f };
+
+        TEST_CHECK(AngleInDegrees(vertex.Tangent, expectedTangent) < MaxAngleError, "Corner ", corner, " got tangent of the other side of the seam");
+        TEST_CHECK(AngleInDegrees(vertex.Bitangent, glm::vec3{ 0.0f, 1.0f, 0.0f }) < MaxAngleError, "Mirroring in U must keep bitangent");
+    }
+}
+
+TEST_CASE(SphereFramesMatchSurfaceDerivatives)
+{
+    const uint32_t ringCount = 64;
+    Vertices vertices;
+    Indices indices;
+    MakeSphere(ringCount, 128, vertices, indices);
+
+    TangentSpaceGenerator{}.Generate(vertices, indices);
+
+    TEST_CHECK(HasOrthonormalFrames(vertices), "Frames must be orthonormal");
+
+    for (const Vertex1P1N1UV1T1BT& vertex : vertices)
+    {
+        // Rings next to poles and the UV seam average over fans that are not symmetric
+        if (vertex.UV.y < 2.5f / ringCount || vertex.UV.y > 1.0f - 2.5f / ringCount || vertex.UV.x == 0.0f || vertex.UV.x == 1.0f)
+        {
+            continue;
+        }
+
+        float phi = 2.0f * Pi * vertex.UV.x;
+        float theta = Pi * vertex.UV.y;
+        glm::vec3 dPdU{ -std::sin(phi), 0.0f, std::cos(phi) };
+        glm::vec3 dPdV{ std::cos(theta) * std::cos(phi), -std::sin(theta), std::cos(theta) * std::sin(phi) };
+
+        TEST_CHECK(AngleInDegrees(vertex.Tangent, dPdU) < 0.1f, "Tangent deviates from dP/du by ", AngleInDegrees(vertex.Tangent, dPdU), " degrees");
+        TEST_CHECK(AngleInDegrees(vertex.Bitangent, dPdV) < 0.1f, "Bitangent deviates from dP/dv by ", AngleInDegrees(vertex.Bitangent, dPdV), " degrees");
+    }
+}
+
+TEST_CASE(DegenerateTrianglesGetFiniteFrames)
+{
+    Vertices vertices;
+    Indices indices;
+    MakeGrid(4, vertices, indices);
+
+    uint32_t gridVertexCount = uint32_t(vertices.size());
+
+    // Coincident positions
+    indices.insert(indices.end(), { 0, 0, 1, 2, 2, 2 });
+
+    // Zero UV area, detached from the grid
+    vertices.push_back(MakeVertex(glm::vec3{ 2.0f, 0.0f, 0.0f }, glm::vec2{ 0.25f, 0.0f }, glm::vec3{ 0.0f, 0.0f, -1.0f }));
+    vertices.push_back(MakeVertex(glm::vec3{ 2.0f, 1.0f, 0.0f }, glm::vec2{ 0.25f, 0.0f }, glm::vec3{ 0.0f, 0.0f, -1.0f }));
+    indices.insert(indices.end(), { 1, gridVertexCount, gridVertexCount + 1 });
+
+    TangentSpaceGenerator{}.Generate(vertices, indices);
+
+    TEST_CHECK(HasOrthonormalFrames(vertices), "Degenerate triangles must not produce invalid frames");
+
+    for (uint32_t vertexIdx = 0; vertexIdx < gridVertexCount; ++vertexIdx)
+    {
+        TEST_CHECK(AngleInDegrees(vertices[vertexIdx].Tangent, glm::vec3{ 1.0f, 0.0f, 0.0f }) < MaxAngleError, "Degenerate triangles changed frame of grid vertex ", vertexIdx);
+    }
+}
+
+TEST_CASE(DegenerateUVTriangleOnOpenBorderJoinsFan)
+{
+    Vertices vertices;
+    Indices indices;
+    MakeGrid(4, vertices, indices);
+
+    uint32_t gridVertexCount = uint32_t(vertices.size());
+    uint64_t gridIndexCount = indices.size();
+
+    // Triangle below the bottom border shares edge 0-1 with the grid, with all UVs on one line.
+    // At vertex 0 it follows the grid triangle around the fan, at vertex 1 it precedes it.
+    vertices.push_back(MakeVertex(glm::vec3{ 0.125f, -0.25f, 0.0f }, glm::vec2{ 0.125f, 0.0f }, glm::vec3{ 0.0f, 0.0f, -1.0f }));
+    indices.insert(indices.end(), { 0, 1, gridVertexCount });
+
+    TangentSpaceGenerator{}.Generate(vertices, indices);
+
+    TEST_CHECK(indices[gridIndexCount] == 0 && indices[gridIndexCount + 1] == 1,
+        "Triangle without UV area must join the fan of border vertices from either side instead of splitting them");
+    TEST_CHECK(vertices.size() == gridVertexCount + 1, "No vertex must be split, got ", vertices.size() - gridVertexCount - 1, " new vertices");
+    TEST_CHECK(HasOrthonormalFrames(vertices), "Frames must be orthonormal");
+
+    for (uint32_t vertexIdx = 0; vertexIdx < gridVertexCount; ++vertexIdx)
+    {
+        TEST_CHECK(AngleInDegrees(vertices[vertexIdx].Tangent, glm::vec3{ 1.0f, 0.0f, 0.0f }) < MaxAngleError, "Triangle without UV area changed frame of grid vertex ", vertexIdx);
+    }
+}
+
+TEST_CASE(ParallelGenerationMatchesSerial)
+{
+    Vertices serialVertices;
+    Indices serialIndices;
+    MakeSphere(64, 128, serialVertices, serialIndices);
+
+    Vertices parallelVertices = serialVertices;
+    Indices parallelIndices = serialIndices;
+
+    Foundation::JobSystem jobSystem{ 4 };
+    TangentSpaceGenerator generator{ TangentSpaceGenerator::Settings{ 512 } };
+
+    generator.Generate(serialVertices, serialIndices);
+    generator.Generate(parallelVertices, parallelIndices, &jobSystem);
+
+    TEST_CHECK(serialIndices == parallelIndices && serialVertices.size() == parallelVertices.size(), "Parallel generation must split the same vertices");
+    TEST_CHECK(memcmp(serialVertices.data(), parallelVertices.data(), serialVertices.size() * sizeof(Vertex1P1N1UV1T1BT)) == 0,
+        "Parallel generation must produce bitwise identical frames");
+}
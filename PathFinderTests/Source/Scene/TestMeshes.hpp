@@ -0,0 +1,149 @@
+#pragma once
+
+#include <Scene/Vertices/Vertex1P1N1UV1T1BT.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Procedural meshes shared by mesh processing tests
+
+namespace TestMeshes
+{
+    using Vertices = std::vector<PathFinder::Vertex1P1N1UV1T1BT>;
+    using Indices = std::vector<uint32_t>;
+
+    constexpr float Pi = 3.14159265f;
+
+    struct SphereSettings
+    {
+        // Pole rings collapse into single points without triangles around them.
+        // Otherwise every ring is a full strip, with degenerate triangles at poles as in most exported UV spheres.
+        bool HasPointPoles = true;
+
+        // Vertex radii are randomly scaled by up to 1 +- Bumpiness, vertices on the UV seam keep sharing positions
+        float Bumpiness = 0.0f;
+    };
+
+    // Tangent frame is left empty for TangentSpaceGenerator
+    inline PathFinder::Vertex1P1N1UV1T1BT MakeVertex(const glm::vec3& position, const glm::vec2& uv, const glm::vec3& normal)
+    {
+        return PathFinder::Vertex1P1N1UV1T1BT{ glm::vec4{ position, 1.0f }, uv, normal, glm::vec3{ 0.0f }, glm::vec3{ 0.0f } };
+    }
+
+    // Vertex of a planar mesh in XY plane facing -Z, UV follows XY
+    inline PathFinder::Vertex1P1N1UV1T1BT MakeVertex(const glm::vec3& position)
+    {
+        return MakeVertex(position, glm::vec2{ position.x, position.y }, glm::vec3{ 0.0f, 0.0f, -1.0f });
+    }
+
+    // Unit grid of quads in XY plane facing -Z, rows of triangles in scanline order.
+    // UV follows XY or is mirrored in U past the middle.
+    inline void MakeGrid(uint32_t size, Vertices& vertices, Indices& indices, bool isMirrored = false)
+    {
+        for (uint32_t y = 0; y <= size; ++y)
+        {
+            for (uint32_t x = 0; x <= size; ++x)
+            {
+                glm::vec2 position{ float(x) / size, float(y) / size };
+                float u = isMirrored && position.x > 0.5f ? 1.0f - position.x : position.x;
+                vertices.push_back(MakeVertex(glm::vec3{ position, 0.0f }, glm::vec2{ u, position.y }, glm::vec3{ 0.0f, 0.0f, -1.0f }));
+            }
+        }
+
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                uint32_t corner = y * (size + 1) + x;
+                indices.insert(indices.end(), { corner, corner + size + 1, corner + 1, corner + 1, corner + size + 1, corner + size + 2 });
+            }
+        }
+    }
+
+    // Closed unit UV sphere with outward facing triangles, U goes around Y axis and V from top to bottom pole.
+    // First and last segment columns form the UV seam.
+    inline void MakeSphere(uint32_t ringCount, uint32_t segmentCount, Vertices& vertices, Indices& indices, const SphereSettings& settings = {})
+    {
+        std::mt19937 random{ 1 };
+        std::uniform_real_distribution<float> noise{ 1.0f - settings.Bumpiness, 1.0f + settings.Bumpiness };
+        std::vector<float> columnScales(segmentCount, 1.0f);
+
+        for (uint32_t ring = 0; ring <= ringCount; ++ring)
+        {
+            bool isPole = ring == 0 || ring == ringCount;
+
+            if (settings.Bumpiness > 0.0f)
+            {
+                std::generate(columnScales.begin(), columnScales.end(), [&] { return noise(random); });
+            }
+
+            for (uint32_t segment = 0; segment <= segmentCount; ++segment)
+            {
+                float theta = Pi * ring / ringCount;
+                float phi = 2.0f * Pi * (segment % segmentCount) / segmentCount;
+                glm::vec3 direction{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+
+                if (isPole && settings.HasPointPoles)
+                {
+                    direction = glm::vec3{ 0.0f, ring == 0 ? 1.0f : -1.0f, 0.0f };
+                }
+
+                float scale = isPole ? 1.0f : columnScales[segment % segmentCount];
+                vertices.push_back(MakeVertex(direction * scale, glm::vec2{ float(segment) / segmentCount, float(ring) / ringCount }, direction));
+            }
+        }
+
+        for (uint32_t ring = 0; ring < ringCount; ++ring)
+        {
+            for (uint32_t segment = 0; segment < segmentCount; ++segment)
+            {
+                uint32_t corner = ring * (segmentCount + 1) + segment;
+
+                if (ring > 0 || !settings.HasPointPoles) indices.insert(indices.end(), { corner, corner + segmentCount + 1, corner + 1 });
+                if (ring < ringCount - 1 || !settings.HasPointPoles) indices.insert(indices.end(), { corner + 1, corner + segmentCount + 1, corner + segmentCount + 2 });
+            }
+        }
+    }
+
+    // Same triangles in random order, as left by importers that don't optimize meshes
+    inline void ShuffleTriangles(Indices& indices, uint32_t seed)
+    {
+        std::vector<uint64_t> order(indices.size() / 3);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), std::mt19937{ seed });
+
+        Indices shuffled;
+
+        for (uint64_t triangle : order)
+        {
+            shuffled.insert(shuffled.end(), indices.begin() + triangle * 3, indices.begin() + triangle * 3 + 3);
+        }
+
+        indices = std::move(shuffled);
+    }
+
+    inline void ShuffleVertices(Vertices& vertices, Indices& indices, uint32_t seed)
+    {
+        std::vector<uint32_t> remap(vertices.size());
+        std::iota(remap.begin(), remap.end(), 0);
+        std::shuffle(remap.begin(), remap.end(), std::mt19937{ seed });
+
+        Vertices shuffled(vertices.size());
+
+        for (uint64_t vertexIdx = 0; vertexIdx < vertices.size(); ++vertexIdx)
+        {
+            shuffled[remap[vertexIdx]] = vertices[vertexIdx];
+        }
+
+        for (uint32_t& index : indices)
+        {
+            index = remap[index];
+        }
+
+        vertices = std::move(shuffled);
+    }
+}
@@ -0,0 +1,219 @@
+#include <TestFramework.hpp>
+
+#include <Scene/Vertices/CompressedVertex1P1N1UV1T1BT.hpp>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace PathFinder;
+
+    using CompressedVertex = CompressedVertex1P1N1UV1T1BT;
+    using Quantization = CompressedVertex::Quantization;
+
+    // Largest angle between a unit vector and its octahedral snorm16 encoding is about 1e-4 radians
+    constexpr float MaxDirectionError = 2e-4f;
+
+    constexpr float SnormStep = 1.0f / 32767.0f;
+
+    float Angle(const glm::vec3& a, const glm::vec3& b)
+    {
+        // More precise than acos of dot product for small angles
+        return std::atan2(glm::length(glm::cross(a, b)), glm::dot(a, b));
+    }
+
+    glm::vec3 RandomDirection(std::mt19937& random)
+    {
+        std::normal_distribution<float> component{ 0.0f, 1.0f };
+        glm::vec3 direction;
+
+        do
+        {
+            direction = glm::vec3{ component(random), component(random), component(random) };
+        } while (glm::length2(direction) < 1e-4f);
+
+        return glm::normalize(direction);
+    }
+
+    bool IsFinite(const glm::vec3& v)
+    {
+        return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+    }
+
+    bool IsOrthonormalBasis(const Vertex1P1N1UV1T1BT& vertex)
+    {
+        return IsFinite(vertex.Normal) && IsFinite(vertex.Tangent) && IsFinite(vertex.Bitangent) &&
+            std::abs(glm::length(vertex.Normal) - 1.0f) < 1e-5f &&
+            std::abs(glm::length(vertex.Tangent) - 1.0f) < 1e-5f &&
+            std::abs(glm::length(vertex.Bitangent) - 1.0f) < 1e-5f &&
+            std::abs(glm::dot(vertex.Normal, vertex.Tangent)) < 1e-5f &&
+            std::abs(glm::dot(vertex.Normal, vertex.Bitangent)) < 1e-5f &&
+            std::abs(glm::dot(vertex.Tangent, vertex.Bitangent)) < 1e-5f;
+    }
+
+    Vertex1P1N1UV1T1BT RoundTrip(const Vertex1P1N1UV1T1BT& vertex, const Quantization& quantization = Quantization{})
+    {
+        return CompressedVertex::Encode(vertex, quantization).Decode(quantization);
+    }
+
+    Vertex1P1N1UV1T1BT MakeVertex(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& tangent, const glm::vec3& bitangent)
+    {
+        return Vertex1P1N1UV1T1BT{ glm::vec4{ position, 1.0f }, glm::vec2{ 0.25f, 0.75f }, normal, tangent, bitangent };
+    }
+}
+
+TEST_CASE(PositionsAreWithinHalfQuantizationStep)
+{
+    std::mt19937 random{ 1 };
+
+    Geometry::AxisAlignedBox3D boundsList[] = {
+        { glm::vec3{ -1.0f }, glm::vec3{ 1.0f } },
+        { glm::vec3{ 1000.0f, -3.0f, 20.0f }, glm::vec3{ 1500.0f, -2.5f, 220.0f } },
+        { glm::vec3{ -0.01f, -250.0f, 0.0f }, glm::vec3{ 0.01f, 250.0f, 0.001f } }
+    };
+
+    for (const Geometry::AxisAlignedBox3D& bounds : boundsList)
+    {
+        Quantization quantization = Quantization::ForBounds(bounds);
+
+        std::vector<glm::vec3> positions{ bounds.Min, bounds.Max, (bounds.Min + bounds.Max) * 0.5f };
+        std::uniform_real_distribution<float> coordinate{ 0.0f, 1.0f };
+
+        for (uint64_t i = 0; i < 10000; ++i)
+        {
+            glm::vec3 t{ coordinate(random), coordinate(random), coordinate(random) };
+            positions.push_back(glm::clamp(bounds.Min + (bounds.Max - bounds.Min) * t, bounds.Min, bounds.Max));
+        }
+
+        for (const glm::vec3& position : positions)
+        {
+            glm::vec3 decoded{ RoundTrip(MakeVertex(position, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }), quantization).Position };
+
+            for (auto axis = 0u; axis < 3; ++axis)
+            {
+                // Half of a step plus float rounding of the encoding and decoding arithmetic
+                float maxError = quantization.Scale[axis] * SnormStep * 0.5f + (std::abs(position[axis]) + quantization.Scale[axis]) * 1e-6f;
+                float error = std::abs(decoded[axis] - position[axis]);
+
+                TEST_CHECK(error <= maxError, "Position ", position[axis], " on axis ", axis, " is off by ", error, ", allowed ", maxError);
+            }
+        }
+    }
+}
+
+TEST_CASE(FlatAxesDecodeExactly)
+{
+    // Planes and degenerate meshes have zero extent along some axes
+    Geometry::AxisAlignedBox3D boundsList[] = {
+        { glm::vec3{ -1.0f, 2.5f, -1.0f }, glm::vec3{ 1.0f, 2.5f, 1.0f } },
+        { glm::vec3{ 7.0f, -4.0f, 0.0f }, glm::vec3{ 7.0f, -4.0f, 3.0f } },
+        { glm::vec3{ -0.5f, 0.0f, 12.0f }, glm::vec3{ -0.5f, 0.0f, 12.0f } }
+    };
+
+    for (const Geometry::AxisAlignedBox3D& bounds : boundsList)
+    {
+        Quantization quantization = Quantization::ForBounds(bounds);
+
+        TEST_CHECK(std::abs(glm::determinant(quantization.DequantizationMatrix())) > 0.0f, "Dequantization matrix must stay invertible for ray tracing instances");
+
+        for (glm::vec3 position : { bounds.Min, bounds.Max, (bounds.Min + bounds.Max) * 0.5f })
+        {
+            glm::vec3 decoded{ RoundTrip(MakeVertex(position, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }), quantization).Position };
+
+            for (auto axis = 0u; axis < 3; ++axis)
+            {
+                if (bounds.Min[axis] != bounds.Max[axis])
+                {
+                    continue;
+                }
+
+                TEST_CHECK(quantization.Scale[axis] == 1.0f, "Flat axis ", axis, " must keep unit scale");
+                TEST_CHECK(decoded[axis] == position[axis], "Flat axis ", axis, " decoded to ", decoded[axis], " instead of ", position[axis]);
+            }
+        }
+    }
+}
+
+TEST_CASE(NormalsAndTangentsAreWithinAngleBounds)
+{
+    std::mt19937 random{ 2 };
+
+    float maxNormalError = 0.0f;
+    float maxTangentError = 0.0f;
+
+    for (uint64_t i = 0; i < 100000; ++i)
+    {
+        glm::vec3 normal = RandomDirection(random);
+        glm::vec3 tangent = glm::normalize(glm::cross(normal, RandomDirection(random)));
+        glm::vec3 bitangent = glm::cross(normal, tangent);
+
+        Vertex1P1N1UV1T1BT decoded = RoundTrip(MakeVertex(glm::vec3{ 0.0f }, normal, tangent, bitangent));
+
+        maxNormalError = std::max(maxNormalError, Angle(decoded.Normal, normal));
+        maxTangentError = std::max(maxTangentError, Angle(decoded.Tangent, tangent));
+
+        TEST_CHECK(IsOrthonormalBasis(decoded), "Decoded basis of vertex ", i, " is not orthonormal");
+    }
+
+    TEST_CHECK(maxNormalError <= MaxDirectionError, "Normals are off by up to ", maxNormalError, " radians");
+
+    // Orthogonalization against decoded normal adds up to normal error to tangent error
+    TEST_CHECK(maxTangentError <= MaxDirectionError * 2.0f, "Tangents are off by up to ", maxTangentError, " radians");
+}
+
+TEST_CASE(BitangentSignSurvivesMirroring)
+{
+    std::mt19937 random{ 3 };
+
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        glm::vec3 normal = RandomDirection(random);
+        glm::vec3 tangent = glm::normalize(glm::cross(normal, RandomDirection(random)));
+
+        // Mirrored UV islands have left handed frames
+        for (float handedness : { 1.0f, -1.0f })
+        {
+            glm::vec3 bitangent = glm::cross(normal, tangent) * handedness;
+            Vertex1P1N1UV1T1BT decoded = RoundTrip(MakeVertex(glm::vec3{ 0.0f }, normal, tangent, bitangent));
+
+            TEST_CHECK(Angle(decoded.Bitangent, bitangent) <= MaxDirectionError * 3.0f,
+                (handedness > 0.0f ? "Right" : "Left"), " handed frame ", i, " has bitangent off by ", Angle(decoded.Bitangent, bitangent), " radians");
+        }
+    }
+}
+
+TEST_CASE(SkewedAndMissingTangentsGetValidBasis)
+{
+    std::mt19937 random{ 4 };
+
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        glm::vec3 normal = RandomDirection(random);
+        glm::vec3 orthogonal = glm::normalize(glm::cross(normal, RandomDirection(random)));
+
+        // Interpolated or imported tangents are rarely orthogonal to normals
+        glm::vec3 skewed = orthogonal * 2.0f + normal * 1.5f;
+        Vertex1P1N1UV1T1BT decoded = RoundTrip(MakeVertex(glm::vec3{ 0.0f }, normal, skewed, glm::cross(normal, orthogonal)));
+
+        TEST_CHECK(IsOrthonormalBasis(decoded), "Skewed tangent ", i, " produced invalid basis");
+        TEST_CHECK(Angle(decoded.Tangent, orthogonal) <= MaxDirectionError * 2.0f, "Skewed tangent ", i, " must keep its component orthogonal to normal");
+
+        // Without a usable tangent direction any orthogonal one will do
+        for (glm::vec3 tangent : { glm::vec3{ 0.0f }, normal, -normal * 3.0f, normal + orthogonal * 1e-5f })
+        {
+            decoded = RoundTrip(MakeVertex(glm::vec3{ 0.0f }, normal, tangent, glm::vec3{ 0.0f }));
+            TEST_CHECK(IsOrthonormalBasis(decoded), "Degenerate tangent ", i, " produced invalid basis");
+        }
+    }
+
+    Vertex1P1N1UV1T1BT decoded = RoundTrip(MakeVertex(glm::vec3{ 0.0f }, glm::vec3{ 0.0f }, glm::vec3{ 0.0f }, glm::vec3{ 0.0f }));
+    TEST_CHECK(IsOrthonormalBasis(decoded), "Vertex without normal and tangent must still get a valid basis");
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+namespace Tests
+{
+
+    using TestFunction = void(*)();
+
+    struct TestCase
+    {
+        const char* Name;
+        const char* File;
+        TestFunction Function;
+        bool IsBenchmark = false;
+    };
+
+    // Thrown by failed checks to abort the rest of a test case
+    struct TestFailure
+    {
+        std::string Message;
+    };
+
+    std::vector<TestCase>& RegisteredTests();
+
+    struct TestRegistrar
+    {
+        TestRegistrar(const char* name, const char* file, TestFunction function, bool isBenchmark = false);
+    };
+
+    template <class... Args>
+    [[noreturn]] void FailCheck(const char* expression, const char* file, int line, Args&&... args)
+    {
+        std::stringstream ss;
+        ss.precision(10);
+        ss << file << "(" << line << "): " << expression << ": ";
+        (ss << ... << args);
+        throw TestFailure{ ss.str() };
+    }
+
+    // Prints a line of benchmark results
+    template <class... Args>
+    void Report(Args&&... args)
+    {
+        std::stringstream ss;
+        ss.precision(4);
+        ss << std::fixed;
+        (ss << ... << args);
+        printf("    %s\n", ss.str().c_str());
+    }
+
+    // Best of several runs filters out preemption and cold caches
+    template <class Function>
+    double MeasureBestMilliseconds(uint64_t runCount, Function&& function)
+    {
+        double best = std::numeric_limits<double>::max();
+
+        for (uint64_t run = 0; run < runCount; ++run)
+        {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+            best = std::min(best, duration.count());
+        }
+
+        return best;
+    }
+
+    // Number of global operator new calls since the test executable started
+    uint64_t AllocationCount();
+
+}
+
+#define TEST_CASE(NAME) \
+    static void NAME(); \
+    static Tests::TestRegistrar NAME##Registrar{ #NAME, __FILE__, &NAME }; \
+    static void NAME()
+
+// Benchmarks only run when requested on the command line. Checks are allowed and used to validate results.
+#define BENCHMARK(NAME) \
+    static void NAME(); \
+    static Tests::TestRegistrar NAME##Registrar{ #NAME, __FILE__, &NAME, true }; \
+    static void NAME()
+
+// Same convention as assert_format: a message is always required
+#define TEST_CHECK(EXPRESSION, ...) ((EXPRESSION) ? (void)0 : Tests::FailCheck(#EXPRESSION, __FILE__, __LINE__, __VA_ARGS__))
@@ -0,0 +1,106 @@
+#include "TestFramework.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> AllocationCounter{ 0 };
+}
+
+// Counting replacement of global allocation functions for allocation benchmarks.
+// Array and aligned forms are left to the standard library, which routes plain array new through here.
+void* operator new(std::size_t size)
+{
+    AllocationCounter.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace Tests
+{
+
+    uint64_t AllocationCount()
+    {
+        return AllocationCounter.load(std::memory_order_relaxed);
+    }
+
+    std::vector<TestCase>& RegisteredTests()
+    {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    TestRegistrar::TestRegistrar(const char* name, const char* file, TestFunction function, bool isBenchmark)
+    {
+        RegisteredTests().push_back(TestCase{ name, file, function, isBenchmark });
+    }
+
+}
+
+// Runs every registered test, or only ones whose names contain the filter argument.
+// With -benchmark runs benchmarks instead, which are only meaningful in Release configuration.
+int main(int argc, char** argv)
+{
+    bool runBenchmarks = argc > 1 && strcmp(argv[1], "-benchmark") == 0;
+    int filterArgIndex = runBenchmarks ? 2 : 1;
+    const char* filter = argc > filterArgIndex ? argv[filterArgIndex] : nullptr;
+    uint64_t runCount = 0;
+    uint64_t failureCount = 0;
+
+    for (const Tests::TestCase& test : Tests::RegisteredTests())
+    {
+        if (test.IsBenchmark != runBenchmarks || (filter && !strstr(test.Name, filter)))
+        {
+            continue;
+        }
+
+        ++runCount;
+
+        // Benchmark reports go below their name
+        if (test.IsBenchmark)
+        {
+            printf("[ BENCH] %s\n", test.Name);
+        }
+
+        try
+        {
+            test.Function();
+            printf("[  OK  ] %s\n", test.Name);
+        }
+        catch (const Tests::TestFailure& failure)
+        {
+            ++failureCount;
+            printf("[ FAIL ] %s\n    %s\n", test.Name, failure.Message.c_str());
+        }
+        catch (const std::exception& exception)
+        {
+            ++failureCount;
+            printf("[ FAIL ] %s\n    Unexpected exception: %s\n", test.Name, exception.what());
+        }
+    }
+
+    printf("%llu of %llu tests passed\n", (unsigned long long)(runCount - failureCount), (unsigned long long)runCount);
+
+    return failureCount > 0 ? 1 : 0;
+}